@@ -905,6 +905,26 @@ htt_set_checksum_result_hl(adf_nbuf_t msdu,
 #define htt_set_checksum_result_hl(msdu, rx_desc) /* no-op */
 #endif
 
+/**
+ * htt_set_flow_hash_ll() - pass the target's flow hash to the stack
+ * @msdu: rx netbuf
+ * @rx_desc: rx descriptor of @msdu
+ *
+ * The target reports a CRC of the flow tuple in the rx descriptor, so for
+ * non-fragmented TCP/UDP frames it can serve as the L4 hash and RPS does
+ * not have to dissect the frame again.
+ *
+ * Return: None
+ */
+static inline void
+htt_set_flow_hash_ll(adf_nbuf_t msdu, struct htt_host_rx_desc_base *rx_desc)
+{
+    struct rx_msdu_start *rx_msdu = &rx_desc->msdu_start;
+
+    if ((rx_msdu->tcp_proto || rx_msdu->udp_proto) && !rx_msdu->ip_frag)
+        adf_nbuf_set_l4_hash(msdu, rx_msdu->flow_id_crc);
+}
+
 #ifdef DEBUG_DMA_DONE
 void
 htt_rx_print_rx_indication(
@@ -1857,7 +1877,9 @@ htt_rx_amsdu_rx_in_order_pop_ll(
     HTT_RX_CHECK_MSDU_COUNT(msdu_count);
     peer_id = HTT_RX_IN_ORD_PADDR_IND_PEER_ID_GET(
                                  *(u_int32_t *)rx_ind_data);
+    adf_os_rcu_read_lock();
     peer = ol_txrx_peer_find_by_id(pdev->txrx_pdev, peer_id);
+    adf_os_rcu_read_unlock();
     if (!peer)
         adf_os_print(KERN_DEBUG "%s: invalid peer id %d and msdu count %d\n",
                      __func__, peer_id, msdu_count);
@@ -1924,8 +1946,13 @@ htt_rx_amsdu_rx_in_order_pop_ll(
         if (adf_os_unlikely((*((u_int8_t *) &rx_desc->fw_desc.u.val)) &
                     FW_RX_DESC_MIC_ERR_M))
             status = RX_PKT_FATE_FW_DROP_INVALID;
-        if (pdev->rx_pkt_dump_cb)
+        if (pdev->rx_pkt_dump_cb) {
+            /* peer is only valid inside the RCU read-side section */
+            adf_os_rcu_read_lock();
+            peer = ol_txrx_peer_find_by_id(pdev->txrx_pdev, peer_id);
             pdev->rx_pkt_dump_cb(msdu, peer, status);
+            adf_os_rcu_read_unlock();
+        }
 
         if (adf_os_unlikely((*((u_int8_t *) &rx_desc->fw_desc.u.val)) &
                              FW_RX_DESC_MIC_ERR_M)) {
@@ -1972,6 +1999,7 @@ htt_rx_amsdu_rx_in_order_pop_ll(
 
         /* Update checksum result */
         htt_set_checksum_result_ll(pdev, msdu, rx_desc);
+        htt_set_flow_hash_ll(msdu, rx_desc);
 
         /* check if this is the last msdu */
         if (msdu_count) {
@@ -460,8 +460,10 @@ htt_t2h_lp_msg_handler(void *context, adf_nbuf_t htt_t2h_msg )
                 u_int16_t peer_id =
                      HTT_RX_OFLD_PKT_ERR_MIC_ERR_PEER_ID_GET(*(msg_word + 1));
 
+                adf_os_rcu_read_lock();
                 peer = ol_txrx_peer_find_by_id(pdev->txrx_pdev, peer_id);
                 if (!peer) {
+                    adf_os_rcu_read_unlock();
                     adf_os_print("%s: invalid peer id %d\n", __FUNCTION__,
                                   peer_id);
                     break;
@@ -479,6 +481,7 @@ htt_t2h_lp_msg_handler(void *context, adf_nbuf_t htt_t2h_msg )
                                  OL_TXRX_MAC_ADDR_LEN);
                 adf_os_mem_copy(err_info.u.mic_err.ta,
                                 peer->mac_addr.raw, OL_TXRX_MAC_ADDR_LEN);
+                adf_os_rcu_read_unlock();
 
                 pn_ptr = (u_int8_t *)&err_info.u.mic_err.pn;
                 adf_os_mem_copy(pn_ptr, (u_int8_t *)(msg_word + 6), 4);
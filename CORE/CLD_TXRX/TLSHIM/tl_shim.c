@@ -550,6 +550,265 @@ end:
 	return should_drop;
 }
 
+#ifdef WLAN_FEATURE_MGMT_RX_BATCH
+/* Beacons and probe responses collected before a batch is posted to PE */
+static unsigned int tlshim_mgmt_rx_batch_size = 32;
+module_param(tlshim_mgmt_rx_batch_size, uint, 0644);
+
+/* Time(in ms) a frame may wait in a partial batch */
+static unsigned int tlshim_mgmt_rx_batch_ms = 20;
+module_param(tlshim_mgmt_rx_batch_ms, uint, 0644);
+
+/* Frames pending for PE above which beacons of untracked BSSes are dropped */
+static unsigned int tlshim_mgmt_rx_batch_backlog = 256;
+module_param(tlshim_mgmt_rx_batch_backlog, uint, 0644);
+
+static inline bool tlshim_mgmt_rx_is_bulk(u_int8_t type, u_int8_t subtype)
+{
+	return type == IEEE80211_FC0_TYPE_MGT &&
+	       (subtype == IEEE80211_FC0_SUBTYPE_BEACON ||
+		subtype == IEEE80211_FC0_SUBTYPE_PROBE_RESP);
+}
+
+/*
+ * @brief - A BSS is tracked when one of our vdevs is joining, connected
+ *          to or hosting it
+ * @param - wma - wma handle
+ * @param - bssid - BSSID of the received frame
+ */
+static bool tlshim_mgmt_bss_is_tracked(tp_wma_handle wma, u_int8_t *bssid)
+{
+	int i;
+
+	for (i = 0; i < wma->max_bssid; i++) {
+		if (wma->interfaces[i].handle &&
+		    vos_is_macaddr_equal(
+			(v_MACADDR_t *)wma->interfaces[i].bssid,
+			(v_MACADDR_t *)bssid) == VOS_TRUE)
+			return true;
+	}
+
+	return false;
+}
+
+static inline int tlshim_mgmt_rx_batch_bin(u_int32_t num_frames)
+{
+	int bin = 0;
+
+	while (num_frames >>= 1)
+		bin++;
+
+	return min(bin, TLSHIM_MGMT_RX_BATCH_HIST_BINS - 1);
+}
+
+vos_pkt_t *WLANTL_MgmtRxBatchNext(WLANTL_MgmtRxBatchType *batch)
+{
+	WLANTL_MgmtRxBatchChunkType *chunk;
+
+	while ((chunk = batch->first)) {
+		if (chunk->uHead < chunk->uCount)
+			return chunk->frames[chunk->uHead++];
+		batch->first = chunk->next;
+		vos_mem_free(chunk);
+	}
+	batch->last = NULL;
+
+	return NULL;
+}
+
+static void tlshim_mgmt_rx_batch_release(WLANTL_MgmtRxBatchType *batch)
+{
+	vos_pkt_t *rx_pkt;
+
+	while ((rx_pkt = WLANTL_MgmtRxBatchNext(batch)))
+		vos_pkt_return_packet(rx_pkt);
+	vos_mem_free(batch);
+}
+
+void WLANTL_MgmtRxBatchFree(WLANTL_MgmtRxBatchType *batch)
+{
+	void *vos_ctx = vos_get_global_context(VOS_MODULE_ID_TL, NULL);
+	struct txrx_tl_shim_ctx *tl_shim = vos_get_context(VOS_MODULE_ID_TL,
+							   vos_ctx);
+
+	if (!batch)
+		return;
+
+	if (tl_shim)
+		adf_os_atomic_sub(batch->uNumFrames,
+				  &tl_shim->batch_inflight);
+	tlshim_mgmt_rx_batch_release(batch);
+}
+
+/*
+ * Post the pending batch to PE. flush_cnt is the stats counter of the
+ * reason for this flush. The batch is posted with batch_lock held, so a
+ * caller that flushes before posting its own message to PE cannot be
+ * overtaken by a flush that took the batch on another CPU. Only the post
+ * is under the lock; a batch that could not be posted is released after
+ * dropping it.
+ *
+ * Returns the number of frames posted.
+ */
+static u_int32_t tlshim_mgmt_rx_batch_flush(struct txrx_tl_shim_ctx *tl_shim,
+					    void *vos_ctx, u_int32_t *flush_cnt)
+{
+	WLANTL_MgmtRxBatchType *batch;
+	WLANTL_MgmtFrmRxBatchCBType rx_batch;
+	u_int32_t num_frames;
+
+	adf_os_spin_lock_bh(&tl_shim->batch_lock);
+	batch = tl_shim->batch;
+	if (!batch) {
+		adf_os_spin_unlock_bh(&tl_shim->batch_lock);
+		return 0;
+	}
+	tl_shim->batch = NULL;
+	adf_os_timer_cancel(&tl_shim->batch_timer);
+	rx_batch = tl_shim->mgmt_rx_batch;
+
+	/* Left empty by a failed chunk allocation */
+	if (!batch->uNumFrames) {
+		adf_os_spin_unlock_bh(&tl_shim->batch_lock);
+		tlshim_mgmt_rx_batch_release(batch);
+		return 0;
+	}
+
+	num_frames = batch->uNumFrames;
+	(*flush_cnt)++;
+	tl_shim->batch_stats.batches++;
+	tl_shim->batch_stats.hist[tlshim_mgmt_rx_batch_bin(num_frames)]++;
+	adf_os_atomic_add(num_frames, &tl_shim->batch_inflight);
+
+	if (!rx_batch) {
+		adf_os_spin_unlock_bh(&tl_shim->batch_lock);
+		WLANTL_MgmtRxBatchFree(batch);
+		return 0;
+	}
+
+	/* The receiver only owns the batch once it has posted it */
+	if (rx_batch(vos_ctx, batch) != VOS_STATUS_SUCCESS) {
+		tl_shim->batch_stats.post_fail++;
+		adf_os_spin_unlock_bh(&tl_shim->batch_lock);
+		WLANTL_MgmtRxBatchFree(batch);
+		return 0;
+	}
+	adf_os_spin_unlock_bh(&tl_shim->batch_lock);
+
+	return num_frames;
+}
+
+u_int32_t WLANTL_MgmtRxBatchFlush(void *vos_ctx)
+{
+	struct txrx_tl_shim_ctx *tl_shim = vos_get_context(VOS_MODULE_ID_TL,
+							   vos_ctx);
+
+	if (!tl_shim)
+		return 0;
+
+	return tlshim_mgmt_rx_batch_flush(tl_shim, vos_ctx,
+					  &tl_shim->batch_stats.event_flush);
+}
+
+static void tlshim_mgmt_rx_batch_timeout(void *arg)
+{
+	struct txrx_tl_shim_ctx *tl_shim = arg;
+	void *vos_ctx = vos_get_global_context(VOS_MODULE_ID_TL, NULL);
+
+	tlshim_mgmt_rx_batch_flush(tl_shim, vos_ctx,
+				   &tl_shim->batch_stats.timer_flush);
+}
+
+/*
+ * Add a beacon or probe response to the pending batch. Once PE falls
+ * behind by tlshim_mgmt_rx_batch_backlog frames, beacons from BSSes that
+ * no vdev tracks are dropped here instead of queueing up for PE.
+ */
+static int tlshim_mgmt_rx_batch_queue(struct txrx_tl_shim_ctx *tl_shim,
+				      void *vos_ctx, tp_wma_handle wma_handle,
+				      vos_pkt_t *rx_pkt,
+				      struct ieee80211_frame *wh,
+				      u_int8_t mgt_subtype)
+{
+	WLANTL_MgmtRxBatchType *batch;
+	WLANTL_MgmtRxBatchChunkType *chunk;
+	u_int32_t backlog;
+	bool full;
+
+	adf_os_spin_lock_bh(&tl_shim->batch_lock);
+	batch = tl_shim->batch;
+	backlog = adf_os_atomic_read(&tl_shim->batch_inflight) +
+		  (batch ? batch->uNumFrames : 0);
+	if (backlog > tl_shim->batch_stats.max_backlog)
+		tl_shim->batch_stats.max_backlog = backlog;
+
+	if (backlog >= tlshim_mgmt_rx_batch_backlog &&
+	    mgt_subtype == IEEE80211_FC0_SUBTYPE_BEACON &&
+	    !tlshim_mgmt_bss_is_tracked(wma_handle, wh->i_addr3)) {
+		tl_shim->batch_stats.overload_drop++;
+		adf_os_spin_unlock_bh(&tl_shim->batch_lock);
+		vos_pkt_return_packet(rx_pkt);
+		return 0;
+	}
+
+	if (!batch) {
+		batch = vos_mem_malloc(sizeof(*batch));
+		if (!batch)
+			goto nomem;
+		vos_mem_zero(batch, sizeof(*batch));
+		tl_shim->batch = batch;
+		adf_os_timer_mod(&tl_shim->batch_timer,
+				 tlshim_mgmt_rx_batch_ms);
+	}
+
+	chunk = batch->last;
+	if (!chunk || chunk->uCount == WLANTL_MGMT_RX_BATCH_CHUNK_SIZE) {
+		chunk = vos_mem_malloc(sizeof(*chunk));
+		if (!chunk)
+			goto nomem;
+		vos_mem_zero(chunk, sizeof(*chunk));
+		if (batch->last)
+			batch->last->next = chunk;
+		else
+			batch->first = chunk;
+		batch->last = chunk;
+	}
+
+	chunk->frames[chunk->uCount++] = rx_pkt;
+	batch->uNumFrames++;
+	tl_shim->batch_stats.batched++;
+	full = batch->uNumFrames >= tlshim_mgmt_rx_batch_size;
+	adf_os_spin_unlock_bh(&tl_shim->batch_lock);
+
+	if (full)
+		tlshim_mgmt_rx_batch_flush(tl_shim, vos_ctx,
+					   &tl_shim->batch_stats.size_flush);
+	return 0;
+
+nomem:
+	tl_shim->batch_stats.nomem_drop++;
+	adf_os_spin_unlock_bh(&tl_shim->batch_lock);
+	vos_pkt_return_packet(rx_pkt);
+	return 0;
+}
+
+/* Drop the pending batch and stop batching, e.g. on PE deregistration */
+static void tlshim_mgmt_rx_batch_stop(struct txrx_tl_shim_ctx *tl_shim)
+{
+	WLANTL_MgmtRxBatchType *batch;
+
+	adf_os_spin_lock_bh(&tl_shim->batch_lock);
+	tl_shim->mgmt_rx_batch = NULL;
+	batch = tl_shim->batch;
+	tl_shim->batch = NULL;
+	adf_os_spin_unlock_bh(&tl_shim->batch_lock);
+
+	adf_os_timer_free(&tl_shim->batch_timer);
+	if (batch)
+		tlshim_mgmt_rx_batch_release(batch);
+}
+#endif /* WLAN_FEATURE_MGMT_RX_BATCH */
+
 static int tlshim_mgmt_rx_process(void *context, u_int8_t *data,
 				       u_int32_t data_len, bool saved_beacon, u_int32_t vdev_id)
 {
@@ -861,6 +1120,22 @@ static int tlshim_mgmt_rx_process(void *context, u_int8_t *data,
 		vos_pkt_return_packet(rx_pkt);
 		return -EINVAL;
 	}
+
+#ifdef WLAN_FEATURE_MGMT_RX_BATCH
+	if (tl_shim->mgmt_rx_batch && tlshim_mgmt_rx_batch_size) {
+		if (!saved_beacon && tlshim_mgmt_rx_is_bulk(mgt_type, mgt_subtype))
+			return tlshim_mgmt_rx_batch_queue(tl_shim, vos_ctx,
+							  wma_handle, rx_pkt,
+							  wh, mgt_subtype);
+		/*
+		 * Post the beacons received ahead of this frame first. LIM
+		 * can still defer single frames of the batch past it.
+		 */
+		tlshim_mgmt_rx_batch_flush(tl_shim, vos_ctx,
+					   &tl_shim->batch_stats.order_flush);
+		tl_shim->batch_stats.direct++;
+	}
+#endif
 	return tl_shim->mgmt_rx(vos_ctx, rx_pkt);
 }
 
@@ -1575,6 +1850,9 @@ VOS_STATUS WLANTL_DeRegisterMgmtFrmClient(void *vos_ctx)
 		TLSHIM_LOGE("Failed to Unregister rx mgmt handler with wmi");
 		return VOS_STATUS_E_FAILURE;
 	}
+#ifdef WLAN_FEATURE_MGMT_RX_BATCH
+	tlshim_mgmt_rx_batch_stop(tl_shim);
+#endif
 	tl_shim->mgmt_rx = NULL;
 	return VOS_STATUS_SUCCESS;
 }
@@ -1607,6 +1885,26 @@ VOS_STATUS WLANTL_RegisterMgmtFrmClient(void *vos_ctx,
 	return VOS_STATUS_SUCCESS;
 }
 
+#ifdef WLAN_FEATURE_MGMT_RX_BATCH
+VOS_STATUS WLANTL_RegisterMgmtFrmBatchClient(void *vos_ctx,
+				WLANTL_MgmtFrmRxBatchCBType mgmt_frm_rx_batch)
+{
+	struct txrx_tl_shim_ctx *tl_shim = vos_get_context(VOS_MODULE_ID_TL,
+							   vos_ctx);
+
+	if (!tl_shim) {
+		TLSHIM_LOGE("%s: Failed to get TLSHIM context", __func__);
+		return VOS_STATUS_E_FAILURE;
+	}
+
+	adf_os_spin_lock_bh(&tl_shim->batch_lock);
+	tl_shim->mgmt_rx_batch = mgmt_frm_rx_batch;
+	adf_os_spin_unlock_bh(&tl_shim->batch_lock);
+
+	return VOS_STATUS_SUCCESS;
+}
+#endif /* WLAN_FEATURE_MGMT_RX_BATCH */
+
 /*
  * Return the data rssi for the given peer.
  */
@@ -1952,6 +2250,9 @@ VOS_STATUS WLANTL_Close(void *vos_ctx)
 	adf_os_mem_free(tl_shim->vdev_active);
 #ifdef FEATURE_WLAN_ESE
 	vos_flush_work(&tl_shim->iapp_work.deferred_work);
+#endif
+#ifdef WLAN_FEATURE_MGMT_RX_BATCH
+	tlshim_mgmt_rx_batch_stop(tl_shim);
 #endif
 	vos_flush_work(&tl_shim->cache_flush_work);
 	for (i = 0; i < WLAN_MAX_STA_COUNT; i++) {
@@ -2023,6 +2324,14 @@ VOS_STATUS WLANTL_Open(void *vos_ctx, WLANTL_ConfigInfoType *tl_cfg)
 
 	vos_init_work(&tl_shim->cache_flush_work, tl_shim_cache_flush_work);
 
+#ifdef WLAN_FEATURE_MGMT_RX_BATCH
+	adf_os_spinlock_init(&tl_shim->batch_lock);
+	adf_os_atomic_init(&tl_shim->batch_inflight);
+	adf_os_timer_init(NULL, &tl_shim->batch_timer,
+			  tlshim_mgmt_rx_batch_timeout, tl_shim,
+			  ADF_NON_DEFERRABLE_TIMER);
+#endif
+
 #if defined(FEATURE_WLAN_ESE) && !defined(FEATURE_WLAN_ESE_UPLOAD)
 	vos_init_work(&(tl_shim->iapp_work.deferred_work),
 		tlshim_mgmt_over_data_rx_handler);
@@ -2762,6 +3071,69 @@ void WLANTL_clear_datapath_stats(void *vos_ctx, uint16_t bitmap)
 	return;
 }
 
+#ifdef WLAN_FEATURE_MGMT_RX_BATCH
+/**
+ * WLANTL_display_mgmt_rx_batch_stats() - display mgmt rx batching stats
+ * @vos_ctx: global vos context
+ *
+ * Return: none
+ */
+void WLANTL_display_mgmt_rx_batch_stats(void *vos_ctx)
+{
+	struct txrx_tl_shim_ctx *tl_shim;
+	struct tlshim_mgmt_rx_batch_stats stats;
+	int i;
+
+	tl_shim = vos_get_context(VOS_MODULE_ID_TL, vos_ctx);
+	if (!tl_shim) {
+		TLSHIM_LOGE("%s: Failed to get TLSHIM context", __func__);
+		return;
+	}
+
+	adf_os_spin_lock_bh(&tl_shim->batch_lock);
+	stats = tl_shim->batch_stats;
+	adf_os_spin_unlock_bh(&tl_shim->batch_lock);
+
+	pr_info("Mgmt rx batch: size %u timeout %u ms backlog limit %u\n",
+		tlshim_mgmt_rx_batch_size, tlshim_mgmt_rx_batch_ms,
+		tlshim_mgmt_rx_batch_backlog);
+	pr_info("Mgmt rx batch: batched %u direct %u pending in PE %d max backlog %u\n",
+		stats.batched, stats.direct,
+		adf_os_atomic_read(&tl_shim->batch_inflight),
+		stats.max_backlog);
+	pr_info("Mgmt rx batch: batches %u size flush %u timer flush %u order flush %u event flush %u post fail %u\n",
+		stats.batches, stats.size_flush, stats.timer_flush,
+		stats.order_flush, stats.event_flush, stats.post_fail);
+	pr_info("Mgmt rx batch: overload drop %u nomem drop %u\n",
+		stats.overload_drop, stats.nomem_drop);
+	for (i = 0; i < TLSHIM_MGMT_RX_BATCH_HIST_BINS - 1; i++)
+		pr_info("Mgmt rx batch: %u-%u frames: %u\n", 1 << i,
+			(2 << i) - 1, stats.hist[i]);
+	pr_info("Mgmt rx batch: %u+ frames: %u\n", 1 << i, stats.hist[i]);
+}
+
+/**
+ * WLANTL_clear_mgmt_rx_batch_stats() - clear mgmt rx batching stats
+ * @vos_ctx: global vos context
+ *
+ * Return: none
+ */
+void WLANTL_clear_mgmt_rx_batch_stats(void *vos_ctx)
+{
+	struct txrx_tl_shim_ctx *tl_shim;
+
+	tl_shim = vos_get_context(VOS_MODULE_ID_TL, vos_ctx);
+	if (!tl_shim) {
+		TLSHIM_LOGE("%s: Failed to get TLSHIM context", __func__);
+		return;
+	}
+
+	adf_os_spin_lock_bh(&tl_shim->batch_lock);
+	vos_mem_zero(&tl_shim->batch_stats, sizeof(tl_shim->batch_stats));
+	adf_os_spin_unlock_bh(&tl_shim->batch_lock);
+}
+#endif /* WLAN_FEATURE_MGMT_RX_BATCH */
+
 /**
  * tlshim_get_intra_bss_fwd_pkts_count() - to get the total tx and rx packets
  *    that have been forwarded from txrx layer without coming to upper layers.
@@ -32,6 +32,7 @@
 #include <ol_txrx_ctrl_api.h>
 #include <adf_os_lock.h>
 #include <adf_os_atomic.h>
+#include <adf_os_timer.h>
 #include <vos_sched.h>
 
 /* Time(in ms) to detect DOS attack */
@@ -79,6 +80,26 @@ struct tlshim_session_flow_Control {
 typedef void(*ipa_uc_fw_op_cb)(v_U8_t *op_msg, void *usr_ctxt);
 #endif /* IPA_UC_OFFLOAD */
 
+#ifdef WLAN_FEATURE_MGMT_RX_BATCH
+/* Batch size histogram bins: 1, 2-3, 4-7, ..., 64 and above */
+#define TLSHIM_MGMT_RX_BATCH_HIST_BINS 7
+
+struct tlshim_mgmt_rx_batch_stats {
+	u_int32_t batched;
+	u_int32_t direct;
+	u_int32_t batches;
+	u_int32_t size_flush;
+	u_int32_t timer_flush;
+	u_int32_t order_flush;
+	u_int32_t event_flush;
+	u_int32_t overload_drop;
+	u_int32_t nomem_drop;
+	u_int32_t post_fail;
+	u_int32_t max_backlog;
+	u_int32_t hist[TLSHIM_MGMT_RX_BATCH_HIST_BINS];
+};
+#endif /* WLAN_FEATURE_MGMT_RX_BATCH */
+
 struct txrx_tl_shim_ctx {
 	void *cfg_ctx;
 	ol_txrx_tx_fp tx;
@@ -112,6 +133,16 @@ struct deferred_iapp_work iapp_work;
 	ipa_uc_fw_op_cb fw_op_cb;
 	void *usr_ctxt;
 #endif /* IPA_UC_OFFLOAD */
+#ifdef WLAN_FEATURE_MGMT_RX_BATCH
+	WLANTL_MgmtFrmRxBatchCBType mgmt_rx_batch;
+	/* To protect the pending batch and its stats */
+	adf_os_spinlock_t batch_lock;
+	WLANTL_MgmtRxBatchType *batch;
+	adf_os_timer_t batch_timer;
+	/* Frames handed to PE and not yet released */
+	adf_os_atomic_t batch_inflight;
+	struct tlshim_mgmt_rx_batch_stats batch_stats;
+#endif /* WLAN_FEATURE_MGMT_RX_BATCH */
 };
 
 /*
@@ -246,6 +246,7 @@ ol_rx_indication_handler(
     a_bool_t ret;
 
     htt_pdev = pdev->htt_pdev;
+    adf_os_rcu_read_lock();
     peer = ol_txrx_peer_find_by_id(pdev, peer_id);
     if (!peer) {
         /* If we can't find a peer send this packet to OCB interface using
@@ -360,6 +361,7 @@ ol_rx_indication_handler(
 #ifdef HTT_RX_RESTORE
                 if (htt_pdev->rx_ring.rx_reset) {
                     ol_rx_trigger_restore(htt_pdev, head_msdu, tail_msdu);
+                    adf_os_rcu_read_unlock();
                     return;
                 }
 #endif
@@ -484,6 +486,7 @@ ol_rx_indication_handler(
 #ifdef HTT_RX_RESTORE
                 if (htt_pdev->rx_ring.rx_reset) {
                     ol_rx_trigger_restore(htt_pdev, msdu, tail_msdu);
+                    adf_os_rcu_read_unlock();
                     return;
                 }
 #endif
@@ -551,6 +554,7 @@ ol_rx_indication_handler(
     }
     OL_RX_REORDER_TIMEOUT_UPDATE(peer, tid);
     OL_RX_REORDER_TIMEOUT_MUTEX_UNLOCK(pdev);
+    adf_os_rcu_read_unlock();
 
     if (pdev->rx.flags.defrag_timeout_check) {
         ol_rx_defrag_waitlist_flush(pdev);
@@ -569,8 +573,10 @@ ol_rx_sec_ind_handler(
     struct ol_txrx_peer_t *peer;
     int sec_index, i;
 
+    adf_os_rcu_read_lock();
     peer = ol_txrx_peer_find_by_id(pdev, peer_id);
     if (! peer) {
+        adf_os_rcu_read_unlock();
         TXRX_PRINT(TXRX_PRINT_LEVEL_ERR,
             "Couldn't find peer from ID %d - skipping security inits\n",
             peer_id);
@@ -610,6 +616,7 @@ ol_rx_sec_ind_handler(
                 adf_os_cpu_to_le64(peer->tids_last_pn[i].pn128[0]);
         }
     }
+    adf_os_rcu_read_unlock();
 }
 
 #if defined(PERE_IP_HDR_ALIGNMENT_WAR)
@@ -751,6 +758,7 @@ ol_rx_offload_deliver_ind_handler(
         if (!htt_rx_offload_msdu_pop(
             htt_pdev, msg, &vdev_id, &peer_id,
             &tid, &fw_desc, &head_buf, &tail_buf)) {
+            adf_os_rcu_read_lock();
             peer = ol_txrx_peer_find_by_id(pdev, peer_id);
             if (peer && peer->vdev) {
                 vdev = peer->vdev;
@@ -758,7 +766,9 @@ ol_rx_offload_deliver_ind_handler(
                     ol_rx_fwd_check(vdev, peer, tid, head_buf);
                 else
                     OL_RX_OSIF_DELIVER(vdev, peer, head_buf);
+                adf_os_rcu_read_unlock();
             } else {
+                adf_os_rcu_read_unlock();
                 buf = head_buf;
                 while (1) {
                     adf_nbuf_t next;
@@ -1196,6 +1206,7 @@ ol_rx_in_order_indication_handler(
     adf_nbuf_t head_msdu, tail_msdu = NULL;
 
     if (pdev) {
+        adf_os_rcu_read_lock();
         peer = ol_txrx_peer_find_by_id(pdev, peer_id);
         if (VOS_MONITOR_MODE == vos_get_conparam())
             peer = pdev->self_peer;
@@ -1216,6 +1227,7 @@ ol_rx_in_order_indication_handler(
     if (adf_os_unlikely(0 == status)) {
         TXRX_PRINT(TXRX_PRINT_LEVEL_WARN,
                     "%s: Pop status is 0, returning here\n", __FUNCTION__);
+        adf_os_rcu_read_unlock();
         return;
     }
 
@@ -1246,10 +1258,12 @@ ol_rx_in_order_indication_handler(
             head_msdu = adf_nbuf_next(head_msdu);
             htt_rx_desc_frame_free(htt_pdev, msdu);
         }
+        adf_os_rcu_read_unlock();
         return;
     }
 
     peer->rx_opt_proc(vdev, peer, tid, head_msdu);
+    adf_os_rcu_read_unlock();
 }
 
 /**
@@ -1346,9 +1360,11 @@ void ol_rx_log_packet(htt_pdev_handle htt_pdev,
 {
     struct ol_txrx_peer_t *peer;
 
+    adf_os_rcu_read_lock();
     peer = ol_txrx_peer_find_by_id(htt_pdev->txrx_pdev, peer_id);
     if (peer)
         adf_dp_trace_log_pkt(peer->vdev->vdev_id, msdu, ADF_RX);
+    adf_os_rcu_read_unlock();
 }
 
 void
@@ -1369,6 +1385,7 @@ ol_rx_offload_paddr_deliver_ind_handler(
             htt_pdev, msg_word, msdu_iter, &vdev_id,
              &peer_id, &tid, &fw_desc, &head_buf, &tail_buf);
 
+        adf_os_rcu_read_lock();
         peer = ol_txrx_peer_find_by_id(htt_pdev->txrx_pdev, peer_id);
         if (peer && peer->vdev) {
             adf_dp_trace_set_track(head_buf, ADF_RX);
@@ -1381,7 +1398,9 @@ ol_rx_offload_paddr_deliver_ind_handler(
                     sizeof(adf_nbuf_data(head_buf)), ADF_RX));
             vdev = peer->vdev;
             OL_RX_OSIF_DELIVER(vdev, peer, head_buf);
+            adf_os_rcu_read_unlock();
         } else {
+            adf_os_rcu_read_unlock();
             buf = head_buf;
             while (1) {
                 adf_nbuf_t next;
@@ -1414,6 +1433,7 @@ ol_rx_mic_error_handler(
     struct ol_txrx_vdev_t *vdev = NULL;
 
     if (pdev) {
+        adf_os_rcu_read_lock();
         peer = ol_txrx_peer_find_by_id(pdev, peer_id);
         if (peer) {
             vdev = peer->vdev;
@@ -1428,6 +1448,7 @@ ol_rx_mic_error_handler(
                 }
             }
         }
+        adf_os_rcu_read_unlock();
     }
 }
 #if 0
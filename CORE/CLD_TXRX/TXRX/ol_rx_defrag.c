@@ -199,6 +199,7 @@ ol_rx_frag_indication_handler(
     void *rx_mpdu_desc;
 
     htt_pdev = pdev->htt_pdev;
+    adf_os_rcu_read_lock();
     peer = ol_txrx_peer_find_by_id(pdev, peer_id);
 
     /* In case of reorder offload, we will never get a flush indication */
@@ -233,6 +234,7 @@ ol_rx_frag_indication_handler(
         }
         htt_rx_desc_frame_free(htt_pdev, head_msdu);
     }
+    adf_os_rcu_read_unlock();
     /* request HTT to provide new rx MSDU buffers for the target to fill. */
     htt_rx_msdu_buff_replenish(htt_pdev);
 }
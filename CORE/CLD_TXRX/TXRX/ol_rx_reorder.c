@@ -496,13 +496,29 @@ ol_rx_addba_handler(
     u_int16_t start_seq_num,
     u_int8_t failed)
 {
-    u_int8_t round_pwr2_win_sz;
+    u_int8_t round_pwr2_win_sz = 0;
     unsigned array_size;
     struct ol_txrx_peer_t *peer;
     struct ol_rx_reorder_t *rx_reorder;
+    struct ol_rx_reorder_array_elem_t *array = NULL;
+
+    /* allocate before the peer is looked up, the RCU section can't sleep */
+    if (!failed) {
+        TXRX_ASSERT2(win_sz <= 64);
+        round_pwr2_win_sz = OL_RX_REORDER_ROUND_PWR2(win_sz);
+        array_size =
+            round_pwr2_win_sz * sizeof(struct ol_rx_reorder_array_elem_t);
+        array = adf_os_mem_alloc(pdev->osdev, array_size);
+        TXRX_ASSERT1(array);
+        adf_os_mem_set(array, 0x0, array_size);
+    }
 
+    adf_os_rcu_read_lock();
     peer = ol_txrx_peer_find_by_id(pdev, peer_id);
     if (peer == NULL) {
+        adf_os_rcu_read_unlock();
+        if (array)
+            adf_os_mem_free(array);
         return;
     }
 
@@ -511,25 +527,22 @@ ol_rx_addba_handler(
             pdev->ctrl_pdev, &peer->mac_addr.raw[0], tid, failed);
     }
     if (failed) {
+        adf_os_rcu_read_unlock();
         return;
     }
 
     peer->tids_last_seq[tid] = IEEE80211_SEQ_MAX; /* invalid */
     rx_reorder = &peer->tids_rx_reorder[tid];
 
-    TXRX_ASSERT2(win_sz <= 64);
     rx_reorder->win_sz = win_sz;
-    round_pwr2_win_sz = OL_RX_REORDER_ROUND_PWR2(win_sz);
-    array_size = round_pwr2_win_sz * sizeof(struct ol_rx_reorder_array_elem_t);
-    rx_reorder->array = adf_os_mem_alloc(pdev->osdev, array_size);
-    TXRX_ASSERT1(rx_reorder->array);
-    adf_os_mem_set(rx_reorder->array, 0x0, array_size);
+    rx_reorder->array = array;
 
     rx_reorder->win_sz_mask = round_pwr2_win_sz - 1;
     rx_reorder->num_mpdus = 0;
 
     peer->tids_next_rel_idx[tid] = OL_RX_REORDER_IDX_INIT(
         start_seq_num, rx_reorder->win_sz, rx_reorder->win_sz_mask);
+    adf_os_rcu_read_unlock();
 }
 
 void
@@ -541,8 +554,10 @@ ol_rx_delba_handler(
     struct ol_txrx_peer_t *peer;
     struct ol_rx_reorder_t *rx_reorder;
 
+    adf_os_rcu_read_lock();
     peer = ol_txrx_peer_find_by_id(pdev, peer_id);
     if (peer == NULL) {
+        adf_os_rcu_read_unlock();
         return;
     }
     peer->tids_next_rel_idx[tid] = 0xffff; /* invalid value */
@@ -565,6 +580,7 @@ ol_rx_delba_handler(
 
     /* set up the TID with default parameters (ARQ window size = 1) */
     ol_rx_reorder_init(rx_reorder, tid);
+    adf_os_rcu_read_unlock();
 }
 
 void
@@ -583,10 +599,12 @@ ol_rx_flush_handler(
     struct ol_rx_reorder_array_elem_t *rx_reorder_array_elem;
     htt_pdev_handle htt_pdev = pdev->htt_pdev;
 
+    adf_os_rcu_read_lock();
     peer = ol_txrx_peer_find_by_id(pdev, peer_id);
     if (peer) {
         vdev = peer->vdev;
     } else {
+        adf_os_rcu_read_unlock();
         return;
     }
 
@@ -604,6 +622,7 @@ ol_rx_flush_handler(
              * and for normal frames
              */
             OL_RX_REORDER_TIMEOUT_MUTEX_UNLOCK(pdev);
+            adf_os_rcu_read_unlock();
             return;
         }
     }
@@ -615,6 +634,7 @@ ol_rx_flush_handler(
      */
     OL_RX_REORDER_TIMEOUT_UPDATE(peer, tid);
     OL_RX_REORDER_TIMEOUT_MUTEX_UNLOCK(pdev);
+    adf_os_rcu_read_unlock();
 }
 
 void
@@ -637,6 +657,7 @@ ol_rx_pn_ind_handler(
     htt_pdev_handle htt_pdev = pdev->htt_pdev;
     int seq_num, i=0;
 
+    adf_os_rcu_read_lock();
     peer = ol_txrx_peer_find_by_id(pdev, peer_id);
 
     if (!peer) {
@@ -649,6 +670,7 @@ ol_rx_pn_ind_handler(
     if (peer) {
         vdev = peer->vdev;
     } else {
+        adf_os_rcu_read_unlock();
         return;
     }
 
@@ -742,6 +764,7 @@ ol_rx_pn_ind_handler(
         adf_nbuf_set_next(tail_msdu, NULL);
         peer->rx_opt_proc(vdev, peer, tid, head_msdu);
     }
+    adf_os_rcu_read_unlock();
 }
 
 #if defined(ENABLE_RX_REORDER_TRACE)
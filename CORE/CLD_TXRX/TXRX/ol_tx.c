@@ -29,6 +29,7 @@
 #include <adf_nbuf.h>         /* adf_nbuf_t, etc. */
 #include <adf_os_atomic.h>    /* adf_os_atomic_read, etc. */
 #include <adf_os_util.h>      /* adf_os_unlikely */
+#include <adf_os_time.h>      /* adf_os_get_monotonic_us */
 #include "adf_trace.h"
 
 /* APIs for other modules */
@@ -634,6 +635,155 @@ static void merge_ocb_tx_ctrl_hdr(struct ocb_tx_ctrl_hdr_t *tx_ctrl,
 	}
 }
 
+/**
+ * ol_tx_ocb_def_tx_ctrl() - look up the TX control defaults for a frame
+ * @vdev: The OCB vdev the frame is sent on.
+ * @chan_freq: The channel requested by the frame, 0 if none.
+ *
+ * Return: the defaults precomputed for @chan_freq if it is one of the
+ * scheduled channels, otherwise the vdev defaults (NULL if none are set).
+ */
+static inline struct ocb_tx_ctrl_hdr_t *
+ol_tx_ocb_def_tx_ctrl(struct ol_txrx_vdev_t *vdev, u_int16_t chan_freq)
+{
+    struct ol_txrx_ocb_chan_info *chan_info;
+    int i;
+
+    if (!vdev->ocb_def_tx_param)
+        return NULL;
+
+    if (chan_freq) {
+        for (i = 0; i < vdev->ocb_channel_count; i++) {
+            chan_info = &vdev->ocb_channel_info[i];
+            if (chan_info->chan_freq == chan_freq &&
+                chan_info->def_tx_ctrl.version == OCB_HEADER_VERSION)
+                return &chan_info->def_tx_ctrl;
+        }
+    }
+    return vdev->ocb_def_tx_param;
+}
+
+/**
+ * ol_tx_ocb_tx_ctrl_get() - build the TX control for an OCB data frame
+ * @vdev: The OCB vdev the frame is sent on.
+ * @msdu: The frame, with its TX control header (if any) still in front.
+ * @tx_ctrl: Filled in with the frame's TX control, defaults merged in.
+ *
+ * Return: false if the frame carries an invalid TX control header.
+ */
+static inline bool
+ol_tx_ocb_tx_ctrl_get(struct ol_txrx_vdev_t *vdev, adf_nbuf_t msdu,
+                      struct ocb_tx_ctrl_hdr_t *tx_ctrl)
+{
+    struct ocb_tx_ctrl_hdr_t *def_ctrl;
+    bool tx_ctrl_header_found = false;
+    u_int16_t chan_freq;
+
+    if (!parse_ocb_tx_header(msdu, tx_ctrl, &tx_ctrl_header_found))
+        return false;
+
+    /* If the TX control header was not found, just use the defaults */
+    if (!tx_ctrl_header_found) {
+        if (vdev->ocb_def_tx_param)
+            vos_mem_copy(tx_ctrl, vdev->ocb_def_tx_param, sizeof(*tx_ctrl));
+        return true;
+    }
+
+    def_ctrl = ol_tx_ocb_def_tx_ctrl(vdev, tx_ctrl->channel_freq);
+    if (!def_ctrl)
+        return true;
+
+    if (!tx_ctrl->all_flags) {
+        /* The frame only picks a channel, take its defaults as they are */
+        chan_freq = tx_ctrl->channel_freq;
+        vos_mem_copy(tx_ctrl, def_ctrl, sizeof(*tx_ctrl));
+        if (chan_freq)
+            tx_ctrl->channel_freq = chan_freq;
+    } else if (def_ctrl->all_flags & ~tx_ctrl->all_flags) {
+        merge_ocb_tx_ctrl_hdr(tx_ctrl, def_ctrl);
+    } else if (!tx_ctrl->channel_freq) {
+        tx_ctrl->channel_freq = def_ctrl->channel_freq;
+    }
+    return true;
+}
+
+#ifdef WLAN_FEATURE_DSRC
+/**
+ * ol_tx_ocb_fast_send() - download a high priority OCB frame right away
+ * @pdev: The physical device.
+ * @txq: The tx queue the frame was classified into.
+ * @tx_desc: The frame's tx descriptor, HTT descriptor already filled in.
+ * @tx_ctrl: The frame's TX control.
+ *
+ * If the queue is empty and not paused and the target has credit for
+ * the frame, hand it to HTT directly instead of enqueueing it and going
+ * through a scheduler pass. Frames already queued on @txq are never
+ * overtaken, so the order within the queue is kept. The scheduler's
+ * running state is taken for the download so that the credit check and
+ * the credit consumption cannot interleave with a scheduler pass; a
+ * pass requested meanwhile is run once the download is done.
+ *
+ * Return: true if the frame was sent, false if it has to be enqueued.
+ */
+static bool
+ol_tx_ocb_fast_send(struct ol_txrx_pdev_t *pdev,
+                    struct ol_tx_frms_queue_t *txq,
+                    struct ol_tx_desc_t *tx_desc,
+                    struct ocb_tx_ctrl_hdr_t *tx_ctrl)
+{
+    adf_nbuf_t msdu = tx_desc->netbuf;
+    u_int8_t tid;
+    int credit;
+    int rerun;
+
+    tid = tx_ctrl->valid_tid ? tx_ctrl->ext_tid : adf_nbuf_get_tid(msdu);
+    if (tid >= OL_TX_NUM_QOS_TIDS ||
+        TXRX_TID_TO_WMM_AC(tid) != TXRX_WMM_AC_VO)
+        return false;
+
+    credit = htt_tx_msdu_credit(msdu);
+    adf_os_spin_lock_bh(&pdev->tx_queue_spinlock);
+    if (pdev->tx_sched.tx_sched_status != ol_tx_scheduler_idle ||
+        txq->frms || txq->paused_count.total ||
+        adf_os_atomic_read(&pdev->target_tx_credit) < credit ||
+        OL_TX_TXQ_GROUP_CREDIT_LIMIT(pdev, txq, credit) < credit) {
+        adf_os_spin_unlock_bh(&pdev->tx_queue_spinlock);
+        pdev->ocb_tx_stats.fast_path_queued++;
+        return false;
+    }
+    pdev->tx_sched.tx_sched_status = ol_tx_scheduler_running;
+    OL_TX_TXQ_GROUP_CREDIT_UPDATE(pdev, txq, -credit, 0);
+    adf_os_spin_unlock_bh(&pdev->tx_queue_spinlock);
+
+    /* the completion may come back before ol_tx_send returns */
+    tx_desc->ocb_fast_path = 1;
+    pdev->ocb_tx_stats.fast_path++;
+    ol_tx_send(pdev, tx_desc, msdu, tx_desc->vdev->vdev_id);
+
+    adf_os_spin_lock_bh(&pdev->tx_queue_spinlock);
+    pdev->tx_sched.tx_sched_status = ol_tx_scheduler_idle;
+    rerun = pdev->tx_sched.rerun;
+    adf_os_spin_unlock_bh(&pdev->tx_queue_spinlock);
+
+    /*
+     * A credit update or enqueue that tried to run the scheduler during
+     * the download was turned away; run the pass it asked for now.
+     */
+    if (rerun)
+        ol_tx_sched(pdev);
+    return true;
+}
+
+#define OL_TX_OCB_TIMESTAMP_SET(tx_desc) \
+    (tx_desc)->ocb_enqueue_us = adf_os_get_monotonic_us()
+#define OL_TX_OCB_FAST_SEND(pdev, vdev, txq, tx_desc, tx_ctrl) \
+    ((vdev)->opmode == wlan_op_mode_ocb && \
+     ol_tx_ocb_fast_send(pdev, txq, tx_desc, tx_ctrl))
+#else
+#define OL_TX_OCB_TIMESTAMP_SET(tx_desc) /* no-op */
+#define OL_TX_OCB_FAST_SEND(pdev, vdev, txq, tx_desc, tx_ctrl) 0
+#endif /* WLAN_FEATURE_DSRC */
+
 static inline adf_nbuf_t
 ol_tx_hl_base(
     ol_txrx_vdev_handle vdev,
@@ -720,18 +870,11 @@ ol_tx_hl_base(
 
         /* If the vdev is in OCB mode, parse the tx control header. */
         if (vdev->opmode == wlan_op_mode_ocb) {
-            bool tx_ctrl_header_found = false;
-
-            if (!parse_ocb_tx_header(msdu, &tx_ctrl, &tx_ctrl_header_found)) {
+            OL_TX_OCB_TIMESTAMP_SET(tx_desc);
+            if (!ol_tx_ocb_tx_ctrl_get(vdev, msdu, &tx_ctrl)) {
                 /* There was an error parsing the header. Skip this packet. */
                 goto MSDU_LOOP_BOTTOM;
             }
-            /* If the TX control header was not found, just use the defaults */
-            if (!tx_ctrl_header_found && vdev->ocb_def_tx_param)
-                vos_mem_copy(&tx_ctrl, vdev->ocb_def_tx_param, sizeof(tx_ctrl));
-            /* If the TX control header was found, merge the defaults into it */
-            else if (tx_ctrl_header_found && vdev->ocb_def_tx_param)
-                merge_ocb_tx_ctrl_hdr(&tx_ctrl, vdev->ocb_def_tx_param);
         }
 
         txq = ol_tx_classify(vdev, tx_desc, msdu, &tx_msdu_info);
@@ -798,7 +941,8 @@ ol_tx_hl_base(
          */
         htt_tx_desc_display(tx_desc->htt_tx_desc);
 
-        ol_tx_enqueue(pdev, txq, tx_desc, &tx_msdu_info);
+        if (!OL_TX_OCB_FAST_SEND(pdev, vdev, txq, tx_desc, &tx_ctrl))
+            ol_tx_enqueue(pdev, txq, tx_desc, &tx_msdu_info);
         if (tx_msdu_info.peer) {
             OL_TX_PEER_STATS_UPDATE(tx_msdu_info.peer, msdu);
             /* remove the peer reference added above */
@@ -55,6 +55,18 @@ OL_TX_TIMESTAMP_SET(struct ol_tx_desc_t *tx_desc)
 #define OL_TX_TIMESTAMP_SET(tx_desc) /* no-op */
 #endif
 
+#ifdef WLAN_FEATURE_DSRC
+/* only OCB data frames get stamped, by ol_tx_hl_base */
+static inline void
+OL_TX_OCB_TIMESTAMP_CLEAR(struct ol_tx_desc_t *tx_desc)
+{
+    tx_desc->ocb_enqueue_us = 0;
+    tx_desc->ocb_fast_path = 0;
+}
+#else
+#define OL_TX_OCB_TIMESTAMP_CLEAR(tx_desc) /* no-op */
+#endif
+
 static inline struct ol_tx_desc_t *
 ol_tx_desc_alloc(struct ol_txrx_pdev_t *pdev, struct ol_txrx_vdev_t *vdev)
 {
@@ -92,6 +104,7 @@ ol_tx_desc_alloc(struct ol_txrx_pdev_t *pdev, struct ol_txrx_vdev_t *vdev)
 #endif
 
     OL_TX_TIMESTAMP_SET(tx_desc);
+    OL_TX_OCB_TIMESTAMP_CLEAR(tx_desc);
 
     return tx_desc;
 }
@@ -702,11 +702,13 @@ ol_txrx_peer_bal_add_limit_peer(struct ol_txrx_pdev_t *pdev,
 		pdev->tx_peer_bal.limit_list[peer_num].limit = peer_limit;
 		pdev->tx_peer_bal.peer_num++;
 
+		adf_os_rcu_read_lock();
 		peer = ol_txrx_peer_find_by_id(pdev, peer_id);
 		if (peer) {
 			peer->tx_limit_flag = TRUE;
 			peer->tx_limit = peer_limit;
 		}
+		adf_os_rcu_read_unlock();
 
 		TX_SCHED_DEBUG_PRINT_ALWAYS(
 			"Add one peer into limit queue, peer_id %d, cur peer num %d\n",
@@ -747,10 +749,12 @@ ol_txrx_peer_bal_remove_limit_peer(struct ol_txrx_pdev_t *pdev,
 				pdev->tx_peer_bal.limit_list[pdev->tx_peer_bal.peer_num - 1];
 			pdev->tx_peer_bal.peer_num--;
 
+			adf_os_rcu_read_lock();
 			peer = ol_txrx_peer_find_by_id(pdev, peer_id);
 			if (peer) {
 				peer->tx_limit_flag = FALSE;
 			}
+			adf_os_rcu_read_unlock();
 
 			TX_SCHED_DEBUG_PRINT(
 				"Remove one peer from limitq, peer_id %d, cur peer num %d\n",
@@ -881,6 +885,7 @@ ol_tx_pdev_peer_bal_timer(void *context)
 				pdev->tx_peer_bal.limit_list[i].limit;
 
 			struct ol_txrx_peer_t *peer = NULL;
+			adf_os_rcu_read_lock();
 			peer = ol_txrx_peer_find_by_id(pdev, peer_id);
 			TX_SCHED_DEBUG_PRINT("%s peer_id %d  peer = 0x%x tx limit %d\n",
 					__FUNCTION__, peer_id,
@@ -888,9 +893,10 @@ ol_tx_pdev_peer_bal_timer(void *context)
 
 			/* It is possible the peer limit is still not 0,
 			   but it is the scenario should not be cared */
-			if (peer) {
+			if (peer)
 				peer->tx_limit = tx_limit;
-			} else {
+			adf_os_rcu_read_unlock();
+			if (!peer) {
 				ol_txrx_peer_bal_remove_limit_peer(pdev,
 								peer_id);
 				TX_SCHED_DEBUG_PRINT_ALWAYS("No such a peer, peer id = %d\n",
@@ -1011,6 +1017,7 @@ ol_txrx_peer_link_status_handler(
 		adf_os_spin_lock_bh(&pdev->tx_peer_bal.mutex);
 
 		/* Update link status analysis for each peer */
+		adf_os_rcu_read_lock();
 		peer = ol_txrx_peer_find_by_id(pdev, peer_id);
 		if (peer) {
 			u_int32_t thresh, limit, phy;
@@ -1051,6 +1058,7 @@ ol_txrx_peer_link_status_handler(
 		} else if (unpause_flag) {
 			ol_txrx_peer_unpause_but_no_mgmt_q(peer);
 		}
+		adf_os_rcu_read_unlock();
 	}
 }
 #endif /* QCA_BAD_PEER_TX_FLOW_CL */
@@ -1531,6 +1539,7 @@ ol_tx_queue_log_record_display(struct ol_txrx_pdev_t *pdev, int offset)
             adf_os_spin_unlock_bh(&pdev->txq_log_spinlock);
 
             if (record.peer_id != 0xffff) {
+                adf_os_rcu_read_lock();
                 peer = ol_txrx_peer_find_by_id(pdev, record.peer_id);
                 if (peer != NULL)
                     VOS_TRACE(VOS_MODULE_ID_TXRX, VOS_TRACE_LEVEL_ERROR,
@@ -1545,6 +1554,7 @@ ol_tx_queue_log_record_display(struct ol_txrx_pdev_t *pdev, int offset)
                         "       Q: %6d  %5d  %3d  %4d",
                         record.num_frms, record.num_bytes,
                         record.tid, record.peer_id);
+                adf_os_rcu_read_unlock();
             } else {
                 VOS_TRACE(VOS_MODULE_ID_TXRX, VOS_TRACE_LEVEL_INFO,
                     "       Q: %6d  %5d  %3d  from vdev",
@@ -1561,6 +1571,7 @@ ol_tx_queue_log_record_display(struct ol_txrx_pdev_t *pdev, int offset)
             adf_os_spin_unlock_bh(&pdev->txq_log_spinlock);
 
             if (record.peer_id != 0xffff) {
+                adf_os_rcu_read_lock();
                 peer = ol_txrx_peer_find_by_id(pdev, record.peer_id);
                 if (peer != NULL)
                     VOS_TRACE(VOS_MODULE_ID_TXRX, VOS_TRACE_LEVEL_ERROR,
@@ -1575,6 +1586,7 @@ ol_tx_queue_log_record_display(struct ol_txrx_pdev_t *pdev, int offset)
                         "      DQ: %6d  %5d  %3d  %4d",
                         record.num_frms, record.num_bytes,
                         record.tid, record.peer_id);
+                adf_os_rcu_read_unlock();
             } else {
                 VOS_TRACE(VOS_MODULE_ID_TXRX, VOS_TRACE_LEVEL_INFO,
                     "      DQ: %6d  %5d  %3d  from vdev",
@@ -1591,6 +1603,7 @@ ol_tx_queue_log_record_display(struct ol_txrx_pdev_t *pdev, int offset)
             adf_os_spin_unlock_bh(&pdev->txq_log_spinlock);
 
             if (record.peer_id != 0xffff) {
+                adf_os_rcu_read_lock();
                 peer = ol_txrx_peer_find_by_id(pdev, record.peer_id);
                 if (peer != NULL)
                     VOS_TRACE(VOS_MODULE_ID_TXRX, VOS_TRACE_LEVEL_ERROR,
@@ -1605,6 +1618,7 @@ ol_tx_queue_log_record_display(struct ol_txrx_pdev_t *pdev, int offset)
                         "      F: %6d  %5d  %3d  %4d",
                         record.num_frms, record.num_bytes,
                         record.tid, record.peer_id);
+                adf_os_rcu_read_unlock();
             } else {
                 /* shouldn't happen */
                 VOS_TRACE(VOS_MODULE_ID_TXRX, VOS_TRACE_LEVEL_INFO,
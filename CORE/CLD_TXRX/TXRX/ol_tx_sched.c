@@ -1415,10 +1415,12 @@ ol_tx_sched(struct ol_txrx_pdev_t *pdev)
     TX_SCHED_DEBUG_PRINT("Enter %s\n", __func__);
     adf_os_spin_lock_bh(&pdev->tx_queue_spinlock);
     if (pdev->tx_sched.tx_sched_status != ol_tx_scheduler_idle) {
+        pdev->tx_sched.rerun = 1;
         adf_os_spin_unlock_bh(&pdev->tx_queue_spinlock);
         return;
     }
     pdev->tx_sched.tx_sched_status = ol_tx_scheduler_running;
+    pdev->tx_sched.rerun = 0;
 
     OL_TX_SCHED_LOG(pdev);
     //adf_os_print("BEFORE tx sched:\n");
@@ -1464,6 +1466,7 @@ ol_tx_sched_attach(
   struct ol_txrx_pdev_t *pdev)
 {
     pdev->tx_sched.tx_sched_status = ol_tx_scheduler_idle;
+    pdev->tx_sched.rerun = 0;
     return ol_tx_sched_init(pdev);
 }
 
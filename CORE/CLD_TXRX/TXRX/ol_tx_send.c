@@ -405,6 +405,48 @@ ol_tx_delay_compute(
 #define OL_TX_DELAY_COMPUTE(pdev, status, desc_ids, num_msdus) /* no-op */
 #endif /* QCA_COMPUTE_TX_DELAY */
 
+#ifdef WLAN_FEATURE_DSRC
+/**
+ * ol_tx_ocb_latency_update() - account an OCB frame's enqueue to completion time
+ * @pdev: The physical device.
+ * @tx_desc: The completed tx descriptor.
+ * @now_us: Completion time, read on first use and shared across a batch.
+ */
+static inline void
+ol_tx_ocb_latency_update(
+    struct ol_txrx_pdev_t *pdev,
+    struct ol_tx_desc_t *tx_desc,
+    u_int64_t *now_us)
+{
+    struct ol_tx_ocb_lat_stats *lat;
+    u_int64_t delta;
+    u_int32_t us, val;
+    int bin = 0;
+
+    if (!tx_desc->ocb_enqueue_us)
+        return;
+
+    if (!*now_us)
+        *now_us = adf_os_get_monotonic_us();
+    delta = *now_us - tx_desc->ocb_enqueue_us;
+    us = (delta > 0xffffffff) ? 0xffffffff : (u_int32_t)delta;
+
+    for (val = us; val && bin < OL_TX_OCB_LAT_HIST_BINS - 1; val >>= 1)
+        bin++;
+
+    lat = &pdev->ocb_tx_stats.lat[tx_desc->ocb_fast_path ? 1 : 0];
+    lat->frms++;
+    lat->total_us += us;
+    if (us > lat->max_us)
+        lat->max_us = us;
+    lat->hist[bin]++;
+    tx_desc->ocb_enqueue_us = 0;
+}
+#define OL_TX_OCB_LATENCY_UPDATE ol_tx_ocb_latency_update
+#else
+#define OL_TX_OCB_LATENCY_UPDATE(pdev, tx_desc, now_us) /* no-op */
+#endif /* WLAN_FEATURE_DSRC */
+
 #ifndef OL_TX_RESTORE_HDR
 #define OL_TX_RESTORE_HDR(__tx_desc, __msdu)
 #endif
@@ -546,6 +588,9 @@ ol_tx_completion_handler(
     union ol_tx_desc_list_elem_t *lcl_freelist = NULL;
     union ol_tx_desc_list_elem_t *tx_desc_last = NULL;
     ol_tx_desc_list tx_descs;
+#ifdef WLAN_FEATURE_DSRC
+    u_int64_t now_us = 0;
+#endif
     TAILQ_INIT(&tx_descs);
 
     OL_TX_DELAY_COMPUTE(pdev, status, desc_ids, num_msdus);
@@ -564,6 +609,7 @@ ol_tx_completion_handler(
                                  tx_desc->id, status));
         if (pdev->cfg.is_high_latency) {
             OL_TX_DESC_UPDATE_GROUP_CREDIT(pdev, tx_desc_id, 1, 0, status);
+            OL_TX_OCB_LATENCY_UPDATE(pdev, tx_desc, &now_us);
         }
 
         if (pdev->ol_tx_packetdump_cb)
@@ -736,6 +782,44 @@ void ol_tx_clear_group_credit_stats(ol_txrx_pdev_handle pdev)
 #endif
 #endif
 
+#ifdef WLAN_FEATURE_DSRC
+void
+ol_tx_ocb_latency_display(ol_txrx_pdev_handle pdev)
+{
+    static const char * const path_name[] = {"queued", "fast"};
+    struct ol_tx_ocb_lat_stats *lat;
+    int i, bin;
+
+    VOS_TRACE(VOS_MODULE_ID_TXRX, VOS_TRACE_LEVEL_ERROR,
+              "OCB tx: VO fast path %u, VO queued %u",
+              pdev->ocb_tx_stats.fast_path,
+              pdev->ocb_tx_stats.fast_path_queued);
+
+    for (i = 0; i < 2; i++) {
+        lat = &pdev->ocb_tx_stats.lat[i];
+        if (!lat->frms)
+            continue;
+        VOS_TRACE(VOS_MODULE_ID_TXRX, VOS_TRACE_LEVEL_ERROR,
+                  "OCB tx latency (%s): %u frms avg %llu us max %u us",
+                  path_name[i], lat->frms,
+                  (unsigned long long)(lat->total_us / lat->frms),
+                  lat->max_us);
+        for (bin = 0; bin < OL_TX_OCB_LAT_HIST_BINS; bin++) {
+            if (!lat->hist[bin])
+                continue;
+            VOS_TRACE(VOS_MODULE_ID_TXRX, VOS_TRACE_LEVEL_ERROR,
+                      "  < %6u us: %u", 1 << bin, lat->hist[bin]);
+        }
+    }
+}
+
+void
+ol_tx_ocb_latency_clear(ol_txrx_pdev_handle pdev)
+{
+    adf_os_mem_zero(&pdev->ocb_tx_stats, sizeof(pdev->ocb_tx_stats));
+}
+#endif /* WLAN_FEATURE_DSRC */
+
 /*
  * ol_tx_single_completion_handler performs the same tx completion
  * processing as ol_tx_completion_handler, but for a single frame.
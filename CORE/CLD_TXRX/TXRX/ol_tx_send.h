@@ -94,4 +94,24 @@ ol_tx_send_nonstd(
     struct ol_tx_desc_t *tx_desc,
     adf_nbuf_t msdu,
     enum htt_pkt_type pkt_type);
+#ifdef WLAN_FEATURE_DSRC
+/**
+ * @brief Print the OCB tx fast path counters and latency histograms.
+ */
+void
+ol_tx_ocb_latency_display(ol_txrx_pdev_handle pdev);
+
+/**
+ * @brief Reset the OCB tx fast path counters and latency histograms.
+ */
+void
+ol_tx_ocb_latency_clear(ol_txrx_pdev_handle pdev);
+
+#define OL_TX_OCB_LATENCY_DISPLAY ol_tx_ocb_latency_display
+#define OL_TX_OCB_LATENCY_CLEAR ol_tx_ocb_latency_clear
+#else
+#define OL_TX_OCB_LATENCY_DISPLAY(pdev) /* no-op */
+#define OL_TX_OCB_LATENCY_CLEAR(pdev) /* no-op */
+#endif /* WLAN_FEATURE_DSRC */
+
 #endif /* _OL_TX_SEND__H_ */
@@ -142,11 +142,11 @@ ol_txrx_find_peer_by_addr_and_vdev(ol_txrx_pdev_handle pdev,
 {
     struct ol_txrx_peer_t *peer;
 
-    peer = ol_txrx_peer_vdev_find_hash(pdev, vdev, peer_addr, 0, 1);
-    if (!peer)
-        return NULL;
-    *peer_id = peer->local_id;
-    adf_os_atomic_dec(&peer->ref_cnt);
+    adf_os_rcu_read_lock();
+    peer = ol_txrx_peer_find_hash_find_noref(pdev, vdev, peer_addr, 0, 1);
+    if (peer)
+        *peer_id = peer->local_id;
+    adf_os_rcu_read_unlock();
     return peer;
 }
 
@@ -156,11 +156,11 @@ ol_txrx_peer_handle ol_txrx_find_peer_by_addr(ol_txrx_pdev_handle pdev,
 {
 	struct ol_txrx_peer_t *peer;
 
-	peer = ol_txrx_peer_find_hash_find(pdev, peer_addr, 0, 1);
-	if (!peer)
-		return NULL;
-	*peer_id = peer->local_id;
-	adf_os_atomic_dec(&peer->ref_cnt);
+	adf_os_rcu_read_lock();
+	peer = ol_txrx_peer_find_hash_find_noref(pdev, NULL, peer_addr, 0, 1);
+	if (peer)
+		*peer_id = peer->local_id;
+	adf_os_rcu_read_unlock();
 	return peer;
 }
 
@@ -971,6 +971,8 @@ ol_txrx_pdev_detach(ol_txrx_pdev_handle pdev, int force)
 
     htt_detach(pdev->htt_pdev);
 
+    /* wait for deferred peer frees before the hash table goes away */
+    adf_os_rcu_barrier();
     ol_txrx_peer_find_detach(pdev);
 
     adf_os_spinlock_destroy(&pdev->tx_mutex);
@@ -1636,25 +1638,43 @@ ol_txrx_peer_uapsdmask_get(struct ol_txrx_pdev_t *txrx_pdev, u_int16_t peer_id)
 {
 
     struct ol_txrx_peer_t *peer;
+    u_int8_t uapsd_mask = 0;
+
+    adf_os_rcu_read_lock();
     peer = ol_txrx_peer_find_by_id(txrx_pdev, peer_id);
     if (peer) {
-        return peer->uapsd_mask;
+        uapsd_mask = peer->uapsd_mask;
     }
+    adf_os_rcu_read_unlock();
 
-    return 0;
+    return uapsd_mask;
 }
 
 u_int8_t
 ol_txrx_peer_qoscapable_get (struct ol_txrx_pdev_t * txrx_pdev, u_int16_t peer_id)
 {
 
-    struct ol_txrx_peer_t *peer_t  = ol_txrx_peer_find_by_id(txrx_pdev, peer_id);
+    struct ol_txrx_peer_t *peer_t;
+    u_int8_t qos_capable = 0;
+
+    adf_os_rcu_read_lock();
+    peer_t = ol_txrx_peer_find_by_id(txrx_pdev, peer_id);
     if (peer_t != NULL)
     {
-        return peer_t->qos_capable;
+        qos_capable = peer_t->qos_capable;
     }
+    adf_os_rcu_read_unlock();
 
-    return 0;
+    return qos_capable;
+}
+
+static void
+ol_txrx_peer_free_rcu(adf_os_rcu_head_t *head)
+{
+    struct ol_txrx_peer_t *peer =
+        container_of(head, struct ol_txrx_peer_t, rcu_head);
+
+    adf_os_mem_free(peer);
 }
 
 void
@@ -1798,7 +1818,11 @@ ol_txrx_peer_unref_delete(ol_txrx_peer_handle peer)
             }
         }
 
-        adf_os_mem_free(peer);
+        /*
+         * Lockless hash / peer ID lookups may still be looking at the
+         * peer, so only release its memory after an RCU grace period.
+         */
+        adf_os_call_rcu(&peer->rcu_head, ol_txrx_peer_free_rcu);
     } else {
         adf_os_spin_unlock_bh(&pdev->peer_ref_mutex);
     }
@@ -1853,13 +1877,10 @@ ol_txrx_peer_handle
 ol_txrx_peer_find_by_addr(struct ol_txrx_pdev_t *pdev, u_int8_t *peer_mac_addr)
 {
     struct ol_txrx_peer_t *peer;
-    peer = ol_txrx_peer_find_hash_find(pdev, peer_mac_addr, 0, 0);
-    if (peer) {
-        TXRX_PRINT(TXRX_PRINT_LEVEL_ERR,
-                  "%s: Delete extra reference %p\n", __func__, peer);
-        /* release the extra reference */
-        ol_txrx_peer_unref_delete(peer);
-    }
+
+    adf_os_rcu_read_lock();
+    peer = ol_txrx_peer_find_hash_find_noref(pdev, NULL, peer_mac_addr, 0, 0);
+    adf_os_rcu_read_unlock();
     return peer;
 }
 
@@ -2569,6 +2590,32 @@ exit:
 #define MAX_DATARATE    7
 #define OCB_HEADER_VERSION 1
 
+/**
+ * ol_txrx_ocb_update_def_tx_ctrl() - precompute the per-channel TX defaults
+ * @vdev: The OCB vdev whose channels or default TX parameters changed.
+ *
+ * Each scheduled channel gets a copy of the vdev defaults with its own
+ * frequency filled in, which the tx path uses as-is for frames that only
+ * select a channel.
+ */
+static void ol_txrx_ocb_update_def_tx_ctrl(ol_txrx_vdev_handle vdev)
+{
+	struct ol_txrx_ocb_chan_info *chan_info;
+	int i;
+
+	for (i = 0; i < vdev->ocb_channel_count; i++) {
+		chan_info = &vdev->ocb_channel_info[i];
+		if (!vdev->ocb_def_tx_param) {
+			vos_mem_zero(&chan_info->def_tx_ctrl,
+				     sizeof(chan_info->def_tx_ctrl));
+			continue;
+		}
+		vos_mem_copy(&chan_info->def_tx_ctrl, vdev->ocb_def_tx_param,
+			     sizeof(chan_info->def_tx_ctrl));
+		chan_info->def_tx_ctrl.channel_freq = chan_info->chan_freq;
+	}
+}
+
 /**
  * ol_txrx_set_ocb_def_tx_param() - Set the default OCB TX parameters
  * @vdev: The OCB vdev that will use these defaults.
@@ -2647,6 +2694,7 @@ bool ol_txrx_set_ocb_def_tx_param(ol_txrx_vdev_handle vdev,
 			vdev->ocb_def_tx_param = NULL;
 		}
 	}
+	ol_txrx_ocb_update_def_tx_ctrl(vdev);
 
 	return true;
 }
@@ -2738,9 +2786,11 @@ void ol_txrx_display_stats(struct ol_txrx_pdev_t *pdev, uint16_t value)
     {
         case WLAN_TXRX_STATS:
             ol_txrx_stats_display(pdev);
+            OL_TX_OCB_LATENCY_DISPLAY(pdev);
             break;
         case WLAN_TXRX_DESC_STATS:
             adf_nbuf_tx_desc_count_display();
+            adf_nbuf_sample_display();
             break;
 #ifdef CONFIG_HL_SUPPORT
         case WLAN_SCHEDULER_STATS:
@@ -2776,9 +2826,11 @@ void ol_txrx_clear_stats(struct ol_txrx_pdev_t *pdev, uint16_t value)
     {
         case WLAN_TXRX_STATS:
             ol_txrx_stats_clear(pdev);
+            OL_TX_OCB_LATENCY_CLEAR(pdev);
             break;
         case WLAN_TXRX_DESC_STATS:
             adf_nbuf_tx_desc_count_clear();
+            adf_nbuf_sample_clear();
             break;
 #ifdef CONFIG_HL_SUPPORT
         case WLAN_SCHEDULER_STATS:
@@ -30,6 +30,8 @@
 #include <osdep.h>        /* u_int32_t, etc. */
 #include <adf_os_mem.h>   /* adf_os_mem_alloc, etc. */
 #include <adf_os_types.h> /* adf_os_device_t, adf_os_print */
+#include <adf_os_lock.h>  /* adf_os_rcu_read_lock, etc. */
+#include <adf_os_atomic.h> /* adf_os_atomic_inc_not_zero */
 /* header files for utilities */
 #include <queue.h>        /* TAILQ */
 
@@ -109,6 +111,25 @@ ol_txrx_peer_find_add_id_to_obj(
 #define TXRX_PEER_HASH_LOAD_MULT  2
 #define TXRX_PEER_HASH_LOAD_SHIFT 0
 
+/*
+ * The hash bins are walked without peer_ref_mutex (under RCU instead),
+ * so a peer is only published into a bin once its own links are set up.
+ * TAILQ_REMOVE leaves the removed element's forward link intact, so a
+ * reader standing on a peer being removed can still move on; the peer
+ * itself is freed only after a grace period (ol_txrx_peer_unref_delete).
+ */
+#define OL_TXRX_PEER_HASH_INSERT_TAIL(head, elm, field) do {     \
+    TAILQ_NEXT((elm), field) = NULL;                             \
+    (elm)->field.tqe_prev = (head)->tqh_last;                    \
+    adf_os_rcu_assign_pointer(*(head)->tqh_last, (elm));         \
+    (head)->tqh_last = &TAILQ_NEXT((elm), field);                \
+} while (0)
+
+#define OL_TXRX_PEER_HASH_FOREACH(var, head, field)              \
+    for ((var) = adf_os_rcu_dereference(TAILQ_FIRST(head));      \
+         (var);                                                  \
+         (var) = adf_os_rcu_dereference(TAILQ_NEXT((var), field)))
+
 static int
 ol_txrx_peer_find_hash_attach(struct ol_txrx_pdev_t *pdev)
 {
@@ -175,10 +196,58 @@ ol_txrx_peer_find_hash_add(
      * the same MAC address are stored, the one added first will be
      * found first.
      */
-    TAILQ_INSERT_TAIL(&pdev->peer_hash.bins[index], peer, hash_list_elem);
+    OL_TXRX_PEER_HASH_INSERT_TAIL(
+        &pdev->peer_hash.bins[index], peer, hash_list_elem);
     adf_os_spin_unlock_bh(&pdev->peer_ref_mutex);
 }
 
+/*
+ * Walk a hash bin for a matching peer.
+ * Must be called inside an RCU read-side critical section.
+ * If take_ref is set, a peer whose ref count already dropped to zero
+ * (i.e. one that is being deleted) is skipped, so the returned peer is
+ * guaranteed to stay alive until the caller releases the reference.
+ */
+static struct ol_txrx_peer_t *
+ol_txrx_peer_find_hash_lookup(
+    struct ol_txrx_pdev_t *pdev,
+    struct ol_txrx_vdev_t *vdev,
+    union ol_txrx_align_mac_addr_t *mac_addr,
+    u_int8_t check_valid,
+    int take_ref)
+{
+    unsigned index;
+    struct ol_txrx_peer_t *peer;
+
+    index = ol_txrx_peer_find_hash_index(pdev, mac_addr);
+    OL_TXRX_PEER_HASH_FOREACH(peer, &pdev->peer_hash.bins[index],
+                              hash_list_elem) {
+        if (ol_txrx_peer_find_mac_addr_cmp(mac_addr, &peer->mac_addr) == 0
+            && (check_valid == 0 || peer->valid)
+            && (vdev == NULL || peer->vdev == vdev)) {
+            if (!take_ref || adf_os_atomic_inc_not_zero(&peer->ref_cnt)) {
+                return peer;
+            }
+        }
+    }
+    return NULL; /* failure */
+}
+
+static inline union ol_txrx_align_mac_addr_t *
+ol_txrx_peer_find_align_mac_addr(
+    u_int8_t *peer_mac_addr,
+    int mac_addr_is_aligned,
+    union ol_txrx_align_mac_addr_t *local_mac_addr_aligned)
+{
+    if (mac_addr_is_aligned) {
+        return (union ol_txrx_align_mac_addr_t *) peer_mac_addr;
+    }
+    adf_os_mem_copy(
+        &local_mac_addr_aligned->raw[0],
+        peer_mac_addr, OL_TXRX_MAC_ADDR_LEN);
+    return local_mac_addr_aligned;
+}
+
 struct ol_txrx_peer_t *
 ol_txrx_peer_vdev_find_hash(struct ol_txrx_pdev_t *pdev,
                             struct ol_txrx_vdev_t *vdev,
@@ -187,30 +256,15 @@ ol_txrx_peer_vdev_find_hash(struct ol_txrx_pdev_t *pdev,
                             u_int8_t check_valid)
 {
     union ol_txrx_align_mac_addr_t local_mac_addr_aligned, *mac_addr;
-    unsigned index;
     struct ol_txrx_peer_t *peer;
 
-    if (mac_addr_is_aligned) {
-        mac_addr = (union ol_txrx_align_mac_addr_t *) peer_mac_addr;
-    } else {
-        adf_os_mem_copy(
-            &local_mac_addr_aligned.raw[0],
-            peer_mac_addr, OL_TXRX_MAC_ADDR_LEN);
-        mac_addr = &local_mac_addr_aligned;
-    }
-    index = ol_txrx_peer_find_hash_index(pdev, mac_addr);
-    adf_os_spin_lock_bh(&pdev->peer_ref_mutex);
-    TAILQ_FOREACH(peer, &pdev->peer_hash.bins[index], hash_list_elem) {
-        if (ol_txrx_peer_find_mac_addr_cmp(mac_addr, &peer->mac_addr) == 0
-            && (check_valid == 0 || peer->valid) && peer->vdev == vdev )  {
-            /* found it - increment the ref count before releasing the lock */
-            adf_os_atomic_inc(&peer->ref_cnt);
-            adf_os_spin_unlock_bh(&pdev->peer_ref_mutex);
-            return peer;
-        }
-    }
-    adf_os_spin_unlock_bh(&pdev->peer_ref_mutex);
-    return NULL; /* failure */
+    mac_addr = ol_txrx_peer_find_align_mac_addr(
+        peer_mac_addr, mac_addr_is_aligned, &local_mac_addr_aligned);
+    adf_os_rcu_read_lock();
+    peer = ol_txrx_peer_find_hash_lookup(
+        pdev, vdev, mac_addr, check_valid, 1 /* take ref */);
+    adf_os_rcu_read_unlock();
+    return peer;
 }
 
 struct ol_txrx_peer_t *
@@ -221,30 +275,31 @@ ol_txrx_peer_find_hash_find(
     u_int8_t check_valid)
 {
     union ol_txrx_align_mac_addr_t local_mac_addr_aligned, *mac_addr;
-    unsigned index;
     struct ol_txrx_peer_t *peer;
 
-    if (mac_addr_is_aligned) {
-        mac_addr = (union ol_txrx_align_mac_addr_t *) peer_mac_addr;
-    } else {
-        adf_os_mem_copy(
-            &local_mac_addr_aligned.raw[0],
-            peer_mac_addr, OL_TXRX_MAC_ADDR_LEN);
-        mac_addr = &local_mac_addr_aligned;
-    }
-    index = ol_txrx_peer_find_hash_index(pdev, mac_addr);
-    adf_os_spin_lock_bh(&pdev->peer_ref_mutex);
-    TAILQ_FOREACH(peer, &pdev->peer_hash.bins[index], hash_list_elem) {
-        if (ol_txrx_peer_find_mac_addr_cmp(mac_addr, &peer->mac_addr) == 0
-            && (check_valid == 0 || peer->valid)) {
-            /* found it - increment the ref count before releasing the lock */
-            adf_os_atomic_inc(&peer->ref_cnt);
-            adf_os_spin_unlock_bh(&pdev->peer_ref_mutex);
-            return peer;
-        }
-    }
-    adf_os_spin_unlock_bh(&pdev->peer_ref_mutex);
-    return NULL; /* failure */
+    mac_addr = ol_txrx_peer_find_align_mac_addr(
+        peer_mac_addr, mac_addr_is_aligned, &local_mac_addr_aligned);
+    adf_os_rcu_read_lock();
+    peer = ol_txrx_peer_find_hash_lookup(
+        pdev, NULL, mac_addr, check_valid, 1 /* take ref */);
+    adf_os_rcu_read_unlock();
+    return peer;
+}
+
+struct ol_txrx_peer_t *
+ol_txrx_peer_find_hash_find_noref(
+    struct ol_txrx_pdev_t *pdev,
+    struct ol_txrx_vdev_t *vdev,
+    u_int8_t *peer_mac_addr,
+    int mac_addr_is_aligned,
+    u_int8_t check_valid)
+{
+    union ol_txrx_align_mac_addr_t local_mac_addr_aligned, *mac_addr;
+
+    mac_addr = ol_txrx_peer_find_align_mac_addr(
+        peer_mac_addr, mac_addr_is_aligned, &local_mac_addr_aligned);
+    return ol_txrx_peer_find_hash_lookup(
+        pdev, vdev, mac_addr, check_valid, 0 /* no ref */);
 }
 
 void
@@ -258,16 +313,11 @@ ol_txrx_peer_find_hash_remove(
     /*
      * DO NOT take the peer_ref_mutex lock here - it needs to be taken
      * by the caller.
-     * The caller needs to hold the lock from the time the peer object's
-     * reference count is decremented and tested up through the time the
-     * reference to the peer object is removed from the hash table, by
-     * this function.
-     * Holding the lock only while removing the peer object reference
-     * from the hash table keeps the hash table consistent, but does not
-     * protect against a new HL tx context starting to use the peer object
-     * if it looks up the peer object from its MAC address just after the
-     * peer ref count is decremented to zero, but just before the peer
-     * object reference is removed from the hash table.
+     * The lock serializes the writers of the hash table.
+     * Lookups don't take it: they walk the bins under RCU and only take
+     * a reference with adf_os_atomic_inc_not_zero, so a peer whose ref
+     * count has already dropped to zero, but which is not yet removed
+     * from the hash table, is never handed out to a new HL tx context.
      */
     //adf_os_spin_lock_bh(&pdev->peer_ref_mutex);
     TAILQ_REMOVE(&pdev->peer_hash.bins[index], peer, hash_list_elem);
@@ -359,7 +409,7 @@ ol_txrx_peer_find_add_id(
         "%s: peer %p ID %d\n", __func__, peer, peer_id);
     if (peer) {
         /* peer's ref count was already incremented by peer_find_hash_find */
-        pdev->peer_id_to_obj_map[peer_id] = peer;
+        adf_os_rcu_assign_pointer(pdev->peer_id_to_obj_map[peer_id], peer);
         /*
          * remove the reference added in ol_txrx_peer_find_hash_find.
          * the reference for the first peer id is already added in ol_txrx_peer_attach.
@@ -418,9 +468,11 @@ ol_rx_peer_map_handler(
     ol_txrx_peer_find_add_id(pdev, peer_mac_addr, peer_id);
     if (pdev->cfg.is_high_latency && !tx_ready) {
         struct ol_txrx_peer_t *peer;
+        adf_os_rcu_read_lock();
         peer = ol_txrx_peer_find_by_id(pdev, peer_id);
         if (!peer) {
             /* ol_txrx_peer_detach called before peer map arrived */
+            adf_os_rcu_read_unlock();
             return;
         }else {
             if (tx_ready) {
@@ -441,6 +493,7 @@ ol_rx_peer_map_handler(
                 ol_txrx_peer_tid_unpause(peer, HTT_TX_EXT_TID_MGMT);
             }
         }
+        adf_os_rcu_read_unlock();
     }
 }
 
@@ -449,6 +502,7 @@ ol_txrx_peer_tx_ready_handler(ol_txrx_pdev_handle pdev, u_int16_t peer_id)
 {
 #if defined(CONFIG_HL_SUPPORT)
     struct ol_txrx_peer_t *peer;
+    adf_os_rcu_read_lock();
     peer = ol_txrx_peer_find_by_id(pdev, peer_id);
     if (peer) {
         int i;
@@ -463,6 +517,7 @@ ol_txrx_peer_tx_ready_handler(ol_txrx_pdev_handle pdev, u_int16_t peer_id)
             ol_txrx_peer_tid_unpause(peer, i);
         }
     }
+    adf_os_rcu_read_unlock();
 #endif
 }
 
@@ -476,7 +531,7 @@ ol_rx_peer_unmap_handler(
         pdev->peer_id_to_obj_map[peer_id];
     TXRX_PRINT(TXRX_PRINT_LEVEL_INFO1,
         "%s: peer %p with ID %d to be unmapped.\n", __func__, peer, peer_id);
-    pdev->peer_id_to_obj_map[peer_id] = NULL;
+    adf_os_rcu_assign_pointer(pdev->peer_id_to_obj_map[peer_id], NULL);
     /*
      * Currently peer IDs are assigned for vdevs as well as peers.
      * If the peer ID is for a vdev, then the peer pointer stored
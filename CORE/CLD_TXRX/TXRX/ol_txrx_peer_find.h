@@ -35,6 +35,7 @@
 #include <htt.h>              /* HTT_INVALID_PEER */
 #include <ol_txrx_types.h>    /* ol_txrx_pdev_t, etc. */
 #include <ol_txrx_internal.h> /* TXRX_ASSERT */
+#include <adf_os_lock.h> /* adf_os_rcu_read_lock, etc. */
 
 int ol_txrx_peer_find_attach(struct ol_txrx_pdev_t *pdev);
 
@@ -67,8 +68,19 @@ ol_txrx_peer_find_by_id(
     u_int16_t peer_id)
 {
     struct ol_txrx_peer_t *peer;
-    peer = (peer_id > ol_cfg_max_peer_id(pdev->ctrl_pdev)) ? NULL :
-        pdev->peer_id_to_obj_map[peer_id];
+    /*
+     * No reference is taken: map entries are published with
+     * adf_os_rcu_assign_pointer and peers are freed through call_rcu, so
+     * the caller must hold adf_os_rcu_read_lock from before this lookup
+     * until its last use of the returned peer. Running in softirq context
+     * is not enough on its own: PREEMPT_RCU kernels before 4.20 do not
+     * treat bh-disabled regions as RCU readers.
+     */
+    if (peer_id > ol_cfg_max_peer_id(pdev->ctrl_pdev)) {
+        return NULL;
+    }
+    peer = adf_os_rcu_dereference_check(pdev->peer_id_to_obj_map[peer_id],
+                                        adf_os_rcu_read_lock_held());
     /*
      * Currently, peer IDs are assigned to vdevs as well as peers.
      * If the peer ID is for a vdev, the peer_id_to_obj_map entry
@@ -100,6 +112,20 @@ ol_txrx_peer_find_hash_find(
     int mac_addr_is_aligned,
     u_int8_t check_valid);
 
+/*
+ * Lookup without taking a peer reference.
+ * The caller must hold adf_os_rcu_read_lock
+ * for as long as it uses the returned peer.
+ * If vdev is non-NULL, only a peer of that vdev is returned.
+ */
+struct ol_txrx_peer_t *
+ol_txrx_peer_find_hash_find_noref(
+    struct ol_txrx_pdev_t *pdev,
+    struct ol_txrx_vdev_t *vdev,
+    u_int8_t *peer_mac_addr,
+    int mac_addr_is_aligned,
+    u_int8_t check_valid);
+
 struct
 ol_txrx_peer_t *
 ol_txrx_peer_vdev_find_hash(
@@ -173,6 +173,12 @@ struct ol_tx_desc_t {
 
 #ifdef QCA_COMPUTE_TX_DELAY
         u_int32_t entry_timestamp_ticks;
+#endif
+#ifdef WLAN_FEATURE_DSRC
+	/* host enqueue time of an OCB data frame in us, 0 if not tracked */
+	u_int64_t ocb_enqueue_us;
+	/* set if the frame was downloaded without going through a txq */
+	u_int8_t ocb_fast_path;
 #endif
 	/*
 	 * Allow tx descriptors to be stored in (doubly-linked) lists.
@@ -399,6 +405,21 @@ struct ol_tx_delay_data {
 
 #endif /* QCA_COMPUTE_TX_DELAY */
 
+#ifdef WLAN_FEATURE_DSRC
+/*
+ * OCB enqueue -> tx completion latency histogram: bin n counts frames
+ * that took [2^(n-1), 2^n) us, the last bin also holds everything slower.
+ */
+#define OL_TX_OCB_LAT_HIST_BINS 16
+
+struct ol_tx_ocb_lat_stats {
+	u_int32_t frms;
+	u_int32_t max_us;
+	u_int64_t total_us;
+	u_int32_t hist[OL_TX_OCB_LAT_HIST_BINS];
+};
+#endif /* WLAN_FEATURE_DSRC */
+
 /* Thermal Mitigation */
 
 typedef enum _throttle_level {
@@ -726,6 +747,8 @@ struct ol_txrx_pdev_t {
 	adf_os_spinlock_t tx_queue_spinlock;
 	struct {
 		enum ol_tx_scheduler_status tx_sched_status;
+		/* a pass was requested while the scheduler was busy */
+		int rerun;
 		ol_tx_sched_handle scheduler;
 		struct ol_tx_frms_queue_t *last_used_txq;
 	} tx_sched;
@@ -795,6 +818,17 @@ struct ol_txrx_pdev_t {
 
 #endif /* QCA_COMPUTE_TX_DELAY */
 
+#ifdef WLAN_FEATURE_DSRC
+	struct {
+		/* high priority OCB frames downloaded without being queued */
+		u_int32_t fast_path;
+		/* high priority OCB frames that still had to be queued */
+		u_int32_t fast_path_queued;
+		/* indexed by ol_tx_desc_t::ocb_fast_path */
+		struct ol_tx_ocb_lat_stats lat[2];
+	} ocb_tx_stats;
+#endif
+
 	struct {
 		adf_os_spinlock_t mutex;
 		/* timer used to monitor the throttle "on" phase and "off" phase */
@@ -858,6 +892,13 @@ struct ol_txrx_pdev_t {
 struct ol_txrx_ocb_chan_info {
 	uint32_t chan_freq;
 	uint16_t disable_rx_stats_hdr:1;
+	/*
+	 * Default tx control for frames sent on this channel, i.e. the vdev
+	 * defaults with channel_freq filled in. Rebuilt whenever the
+	 * defaults change so the tx path only has to overlay what each
+	 * frame specifies itself.
+	 */
+	struct ocb_tx_ctrl_hdr_t def_tx_ctrl;
 };
 
 struct ol_txrx_vdev_t {
@@ -1076,6 +1117,8 @@ struct ol_txrx_peer_t {
 	TAILQ_ENTRY(ol_txrx_peer_t) peer_list_elem;
 	/* node in the hash table bin's list of peers */
 	TAILQ_ENTRY(ol_txrx_peer_t) hash_list_elem;
+	/* lockless hash / peer ID readers are done before the peer is freed */
+	adf_os_rcu_head_t rcu_head;
 
 	/*
 	 * per TID info -
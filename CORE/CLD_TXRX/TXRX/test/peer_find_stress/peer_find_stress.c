@@ -0,0 +1,397 @@
+/*
+ * Copyright (c) 2016 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/*
+ * TXRX peer find stress harness
+ *
+ * Runs a userspace build of ol_txrx_peer_find.c with one control thread
+ * that keeps creating and deleting peers through the peer map / unmap
+ * handlers, while reader threads look the same peers up the way the
+ * datapath does: by peer ID and by MAC address without a reference under
+ * RCU, and by MAC address with a reference. Readers hold on to each peer
+ * for a short while and check that it was not released under them, and
+ * that a referenced peer never had a zero reference count.
+ *
+ * Peer memory is released through the RCU callback, poisoned and kept in
+ * a quarantine for a while before it is really freed, so a reader that
+ * still uses a released peer sees the poison. With -n the callback runs
+ * without waiting for a grace period, which must produce errors; it shows
+ * that the checks catch a missing grace period.
+ *
+ * Usage:
+ *   peer_find_stress [-v] [-n] [-t <readers>] -r <seed> <runs>
+ *
+ * <runs> is the number of peer create / delete operations. The result
+ * is printed on stdout and the exit status is 1 if any error was seen.
+ * The time taken and the lookup rate are reported on stderr.
+ */
+
+#include "txrx_stub.h"
+#include "ol_txrx_peer_find.h"
+#include <time.h>
+#include <unistd.h>
+
+#define STRESS_SLOTS       48
+#define STRESS_MAX_READERS 16
+#define STRESS_QUARANTINE  4096
+#define STRESS_PEER_MAGIC  0x50454552
+#define STRESS_PEER_FREED  0x6b6b6b6b
+
+void ol_rx_peer_map_handler(ol_txrx_pdev_handle pdev, u_int16_t peer_id,
+                            u_int8_t vdev_id, u_int8_t *peer_mac_addr,
+                            int tx_ready);
+void ol_rx_peer_unmap_handler(ol_txrx_pdev_handle pdev, u_int16_t peer_id);
+
+struct stress_slot {
+    union ol_txrx_align_mac_addr_t mac;
+    struct ol_txrx_peer_t *peer;  /* control thread only */
+    int busy;                     /* cleared once the peer is released */
+};
+
+struct stress_reader {
+    pthread_t thread;
+    struct stress_rcu_reader rcu;
+    u_int32_t rnd_state;
+    unsigned long lookups;
+    unsigned long hits;
+    unsigned long errors;
+};
+
+int stress_verbose;
+int stress_assert_count;
+__thread struct stress_rcu_reader *stress_rcu_self;
+__thread int stress_rcu_nesting;
+
+static struct ol_txrx_pdev_t pdev;
+static struct ol_txrx_vdev_t vdev;
+static struct stress_slot slots[STRESS_SLOTS];
+static struct stress_reader readers[STRESS_MAX_READERS];
+static struct stress_rcu_reader control_rcu;
+static struct stress_rcu_reader *rcu_readers[STRESS_MAX_READERS + 1];
+static int num_rcu_readers;
+static int num_readers = 4;
+static int no_grace_period;
+static int control_done;
+static unsigned long peers_freed;
+static pthread_mutex_t quarantine_lock = PTHREAD_MUTEX_INITIALIZER;
+static void *quarantine[STRESS_QUARANTINE];
+static int quarantine_next;
+
+static u_int32_t rnd(u_int32_t *state)
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return *state;
+}
+
+static void timespec_add_since(struct timespec *acc,
+                               const struct timespec *start)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    acc->tv_sec += now.tv_sec - start->tv_sec;
+    acc->tv_nsec += now.tv_nsec - start->tv_nsec;
+    if (acc->tv_nsec < 0) {
+        acc->tv_nsec += 1000000000L;
+        acc->tv_sec--;
+    } else if (acc->tv_nsec >= 1000000000L) {
+        acc->tv_nsec -= 1000000000L;
+        acc->tv_sec++;
+    }
+}
+
+int ol_cfg_max_peer_id(ol_pdev_handle ctrl_pdev)
+{
+    return STRESS_SLOTS - 1;
+}
+
+void ol_txrx_peer_tid_unpause(struct ol_txrx_peer_t *peer, int tid)
+{
+}
+
+void ol_tx_queue_decs_reinit(struct ol_txrx_peer_t *peer, u_int16_t peer_id)
+{
+}
+
+void stress_rcu_synchronize(void)
+{
+    unsigned long seq;
+    int i;
+
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    for (i = 0; i < num_rcu_readers; i++) {
+        seq = __atomic_load_n(&rcu_readers[i]->seq, __ATOMIC_ACQUIRE);
+        if (!(seq & 1))
+            continue;
+        while (__atomic_load_n(&rcu_readers[i]->seq, __ATOMIC_ACQUIRE) == seq)
+            sched_yield();
+    }
+}
+
+void stress_call_rcu(adf_os_rcu_head_t *head,
+                     void (*func)(adf_os_rcu_head_t *head))
+{
+    if (!no_grace_period)
+        stress_rcu_synchronize();
+    func(head);
+}
+
+/*
+ * Same steps as ol_txrx_peer_unref_delete() in ol_txrx.c, without the
+ * vdev and rx reorder teardown this harness does not set up.
+ */
+static void stress_peer_free_rcu(adf_os_rcu_head_t *head)
+{
+    struct ol_txrx_peer_t *peer =
+        container_of(head, struct ol_txrx_peer_t, rcu_head);
+    struct stress_slot *slot = peer->slot;
+    void *old;
+
+    /* keep the list links, a reader may still be walking through them */
+    peer->magic = STRESS_PEER_FREED;
+    memset(&peer->mac_addr, 0x6b, sizeof(peer->mac_addr));
+
+    pthread_mutex_lock(&quarantine_lock);
+    old = quarantine[quarantine_next];
+    quarantine[quarantine_next] = peer;
+    quarantine_next = (quarantine_next + 1) % STRESS_QUARANTINE;
+    peers_freed++;
+    pthread_mutex_unlock(&quarantine_lock);
+    free(old);
+
+    __atomic_store_n(&slot->busy, 0, __ATOMIC_RELEASE);
+}
+
+void ol_txrx_peer_unref_delete(ol_txrx_peer_handle peer)
+{
+    struct ol_txrx_pdev_t *pdev = peer->vdev->pdev;
+
+    if (0 == adf_os_atomic_read(&peer->ref_cnt)) {
+        adf_os_assert(0);
+        return;
+    }
+
+    adf_os_spin_lock_bh(&pdev->peer_ref_mutex);
+    if (adf_os_atomic_dec_and_test(&peer->ref_cnt)) {
+        ol_txrx_peer_find_hash_remove(pdev, peer);
+        adf_os_spin_unlock_bh(&pdev->peer_ref_mutex);
+        adf_os_call_rcu(&peer->rcu_head, stress_peer_free_rcu);
+    } else {
+        adf_os_spin_unlock_bh(&pdev->peer_ref_mutex);
+    }
+}
+
+/* check a peer a reader got for slot i, and keep it busy for a while */
+static void stress_use_peer(struct stress_reader *r, int i,
+                            struct ol_txrx_peer_t *peer, int referenced)
+{
+    int spin = rnd(&r->rnd_state) % 64;
+
+    r->hits++;
+    if (peer->magic != STRESS_PEER_MAGIC ||
+        memcmp(&peer->mac_addr, &slots[i].mac, OL_TXRX_MAC_ADDR_LEN)) {
+        r->errors++;
+        return;
+    }
+    if (referenced && adf_os_atomic_read(&peer->ref_cnt) < 1)
+        r->errors++;
+
+    while (spin--)
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+    if (peer->magic != STRESS_PEER_MAGIC)
+        r->errors++;
+}
+
+static void *stress_reader_thread(void *arg)
+{
+    struct stress_reader *r = arg;
+    struct ol_txrx_peer_t *peer;
+    int i;
+
+    stress_rcu_self = &r->rcu;
+    while (!__atomic_load_n(&control_done, __ATOMIC_ACQUIRE)) {
+        i = rnd(&r->rnd_state) % STRESS_SLOTS;
+        r->lookups++;
+        switch (rnd(&r->rnd_state) % 3) {
+        case 0:
+            /* rx / tx completion path */
+            adf_os_rcu_read_lock();
+            peer = ol_txrx_peer_find_by_id(&pdev, i);
+            if (peer)
+                stress_use_peer(r, i, peer, 0);
+            adf_os_rcu_read_unlock();
+            break;
+        case 1:
+            adf_os_rcu_read_lock();
+            peer = ol_txrx_peer_find_hash_find_noref(&pdev, NULL,
+                                                     slots[i].mac.raw, 1, 1);
+            if (peer)
+                stress_use_peer(r, i, peer, 0);
+            adf_os_rcu_read_unlock();
+            break;
+        default:
+            peer = ol_txrx_peer_find_hash_find(&pdev, slots[i].mac.raw, 1, 1);
+            if (peer) {
+                stress_use_peer(r, i, peer, 1);
+                ol_txrx_peer_unref_delete(peer);
+            }
+            break;
+        }
+    }
+    return NULL;
+}
+
+static void stress_peer_create(int i)
+{
+    struct ol_txrx_peer_t *peer;
+    int j;
+
+    peer = calloc(1, sizeof(*peer));
+    if (!peer) {
+        perror("calloc");
+        exit(2);
+    }
+    peer->vdev = &vdev;
+    peer->mac_addr = slots[i].mac;
+    peer->local_id = i;
+    peer->valid = 1;
+    peer->magic = STRESS_PEER_MAGIC;
+    peer->slot = &slots[i];
+    for (j = 0; j < MAX_NUM_PEER_ID_PER_PEER; j++)
+        peer->peer_ids[j] = HTT_INVALID_PEER;
+    adf_os_atomic_init(&peer->ref_cnt);
+    adf_os_atomic_inc(&peer->ref_cnt);
+
+    slots[i].busy = 1;
+    slots[i].peer = peer;
+    ol_txrx_peer_find_hash_add(&pdev, peer);
+    ol_rx_peer_map_handler(&pdev, i, 0, slots[i].mac.raw, 1);
+}
+
+static void stress_peer_delete(int i)
+{
+    slots[i].peer->valid = 0;
+    slots[i].peer = NULL;
+    ol_rx_peer_unmap_handler(&pdev, i);
+}
+
+int main(int argc, char **argv)
+{
+    struct timespec start, elapsed = { 0, 0 };
+    unsigned long lookups = 0, hits = 0, errors = 0;
+    unsigned long runs = 0, n;
+    u_int32_t seed = 0, state;
+    int i, opt;
+
+    while ((opt = getopt(argc, argv, "vnt:r:")) != -1) {
+        switch (opt) {
+        case 'v':
+            stress_verbose++;
+            break;
+        case 'n':
+            no_grace_period = 1;
+            break;
+        case 't':
+            num_readers = atoi(optarg);
+            break;
+        case 'r':
+            seed = strtoul(optarg, NULL, 0);
+            break;
+        default:
+            goto usage;
+        }
+    }
+    if (!seed || optind >= argc || num_readers < 1 ||
+        num_readers > STRESS_MAX_READERS)
+        goto usage;
+    runs = strtoul(argv[optind], NULL, 0);
+
+    pdev.ctrl_pdev = &pdev;
+    pthread_mutex_init(&pdev.peer_ref_mutex, NULL);
+    pthread_mutex_init(&pdev.last_real_peer_mutex, NULL);
+    vdev.pdev = &pdev;
+    if (ol_txrx_peer_find_attach(&pdev)) {
+        fprintf(stderr, "peer_find_stress: attach failed\n");
+        return 2;
+    }
+
+    /* a few distinct MAC addresses share each hash bin */
+    state = seed;
+    for (i = 0; i < STRESS_SLOTS; i++) {
+        slots[i].mac.raw[0] = 0x02;
+        slots[i].mac.raw[1] = rnd(&state) & 0x3;
+        slots[i].mac.raw[2] = i;
+        slots[i].mac.raw[3] = rnd(&state);
+        slots[i].mac.raw[4] = 0;
+        slots[i].mac.raw[5] = slots[i].mac.raw[3] ^ (i & 0xf0);
+    }
+
+    stress_rcu_self = &control_rcu;
+    rcu_readers[num_rcu_readers++] = &control_rcu;
+    for (i = 0; i < num_readers; i++) {
+        readers[i].rnd_state = seed + i + 1;
+        rcu_readers[num_rcu_readers++] = &readers[i].rcu;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (i = 0; i < num_readers; i++)
+        pthread_create(&readers[i].thread, NULL, stress_reader_thread,
+                       &readers[i]);
+
+    for (n = 0; n < runs; n++) {
+        i = rnd(&state) % STRESS_SLOTS;
+        if (slots[i].peer)
+            stress_peer_delete(i);
+        else if (!__atomic_load_n(&slots[i].busy, __ATOMIC_ACQUIRE))
+            stress_peer_create(i);
+    }
+
+    __atomic_store_n(&control_done, 1, __ATOMIC_RELEASE);
+    for (i = 0; i < num_readers; i++) {
+        pthread_join(readers[i].thread, NULL);
+        lookups += readers[i].lookups;
+        hits += readers[i].hits;
+        errors += readers[i].errors;
+    }
+    timespec_add_since(&elapsed, &start);
+
+    for (i = 0; i < STRESS_SLOTS; i++) {
+        if (slots[i].peer)
+            stress_peer_delete(i);
+    }
+    for (i = 0; i < STRESS_QUARANTINE; i++)
+        free(quarantine[i]);
+    ol_txrx_peer_find_detach(&pdev);
+
+    errors += stress_assert_count;
+    printf("%lu peer ops, %lu peers freed, %lu lookups, %lu hits, "
+           "%lu errors\n", runs, peers_freed, lookups, hits, errors);
+    fprintf(stderr, "%d readers: %ld.%03ld s, %.0f lookups/s\n",
+            num_readers, (long)elapsed.tv_sec, elapsed.tv_nsec / 1000000,
+            lookups / (elapsed.tv_sec + elapsed.tv_nsec / 1e9));
+    return errors ? 1 : 0;
+
+usage:
+    fprintf(stderr,
+            "usage: %s [-v] [-n] [-t <readers>] -r <seed> <runs>\n",
+            argv[0]);
+    return 2;
+}
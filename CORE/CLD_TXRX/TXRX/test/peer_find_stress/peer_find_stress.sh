@@ -0,0 +1,39 @@
+#!/bin/sh
+#
+# Build the peer find stress harness against ol_txrx_peer_find.c from the
+# working tree and run it: first with AddressSanitizer (when the compiler
+# supports it), which must finish without errors, then with the RCU grace
+# period disabled, which must report errors to show the checks work.
+#
+# usage: peer_find_stress.sh [<seed> [<runs> [<readers>]]]
+
+set -e
+
+HERE=$(cd "$(dirname "$0")" && pwd)
+TXRX=$HERE/../..
+CC=${CC:-cc}
+CFLAGS="-O2 -Wall -pthread"
+ARGS="-t ${3:-4} -r ${1:-1} ${2:-200000}"
+
+OUT=$(mktemp -d)
+trap 'rm -rf "$OUT"' EXIT
+
+build() {
+    $CC $CFLAGS "$@" -I"$HERE/stubs" -I"$TXRX" -I"$TXRX/../../SERVICES/COMMON" \
+        "$TXRX/ol_txrx_peer_find.c" "$HERE/peer_find_stress.c"
+}
+
+if echo 'int main(void){return 0;}' |
+        $CC -fsanitize=address -x c -o "$OUT/asan_check" - 2>/dev/null; then
+    build -g -fsanitize=address -o "$OUT/peer_find_stress_asan"
+    "$OUT/peer_find_stress_asan" $ARGS
+fi
+
+build -o "$OUT/peer_find_stress"
+"$OUT/peer_find_stress" $ARGS
+
+if "$OUT/peer_find_stress" -n $ARGS; then
+    echo "peer_find_stress: no errors without a grace period" >&2
+    exit 1
+fi
+echo "peer_find_stress: passed"
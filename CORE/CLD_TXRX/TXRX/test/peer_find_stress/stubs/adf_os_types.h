@@ -0,0 +1 @@
+#include "txrx_stub.h"
@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) 2016 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/*
+ * Userspace stand-ins for the OS, ADF and TXRX declarations that
+ * ol_txrx_peer_find.c uses. Every driver header it includes, other than
+ * ol_txrx_peer_find.h and queue.h, resolves to this file when building
+ * the peer find stress harness.
+ *
+ * RCU is emulated with one sequence counter per registered thread: it is
+ * odd while the thread is inside a read-side section, and a grace period
+ * waits for every counter that was odd at its start to move on.
+ */
+#ifndef __TXRX_STUB_H
+#define __TXRX_STUB_H
+
+#include <stdio.h>
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/types.h>
+#include "queue.h"
+
+#define OL_TXRX_MAC_ADDR_LEN     6
+#define MAX_NUM_PEER_ID_PER_PEER 8
+#define HTT_INVALID_PEER         0xffff
+#define HTT_INVALID_PEER_ID      0xffff
+#define HTT_TX_EXT_TID_MGMT      17
+#define ARRAY_LEN(arr) (sizeof(arr) / sizeof(arr[0]))
+
+#ifndef container_of
+#define container_of(ptr, type, member) \
+    ((type *)((char *)(ptr) - offsetof(type, member)))
+#endif
+
+/* ADF memory, lock and atomic primitives */
+#define adf_os_mem_alloc(osdev, size) malloc(size)
+#define adf_os_mem_free(p)            free(p)
+#define adf_os_mem_copy(d, s, n)      memcpy(d, s, n)
+#define adf_os_mem_set(p, v, n)       memset(p, v, n)
+
+typedef pthread_mutex_t adf_os_spinlock_t;
+#define adf_os_spin_lock_bh(l)   pthread_mutex_lock(l)
+#define adf_os_spin_unlock_bh(l) pthread_mutex_unlock(l)
+
+typedef int adf_os_atomic_t;
+#define adf_os_atomic_init(v)  __atomic_store_n(v, 0, __ATOMIC_SEQ_CST)
+#define adf_os_atomic_set(v, i) __atomic_store_n(v, i, __ATOMIC_SEQ_CST)
+#define adf_os_atomic_read(v)  __atomic_load_n(v, __ATOMIC_SEQ_CST)
+#define adf_os_atomic_inc(v)   __atomic_add_fetch(v, 1, __ATOMIC_SEQ_CST)
+#define adf_os_atomic_dec(v)   __atomic_sub_fetch(v, 1, __ATOMIC_SEQ_CST)
+#define adf_os_atomic_dec_and_test(v) \
+    (__atomic_sub_fetch(v, 1, __ATOMIC_SEQ_CST) == 0)
+
+static inline int adf_os_atomic_inc_not_zero(adf_os_atomic_t *v)
+{
+    int old = __atomic_load_n(v, __ATOMIC_SEQ_CST);
+
+    while (old) {
+        if (__atomic_compare_exchange_n(v, &old, old + 1, 0,
+                                        __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST))
+            return 1;
+    }
+    return 0;
+}
+
+/* Driver asserts and prints are counted as failures of the run */
+extern int stress_verbose;
+extern int stress_assert_count;
+#define adf_os_assert(expr) do {                                      \
+        if (!(expr)) {                                                \
+            __atomic_add_fetch(&stress_assert_count, 1, __ATOMIC_SEQ_CST); \
+            fprintf(stderr, "assert %s:%d\n", __FILE__, __LINE__);    \
+        }                                                             \
+    } while (0)
+#define TXRX_ASSERT2(expr) adf_os_assert(expr)
+#define TXRX_PRINT_LEVEL_ERR   1
+#define TXRX_PRINT_LEVEL_INFO1 2
+#define TXRX_PRINT(level, ...) \
+    do { if (stress_verbose >= (level)) fprintf(stderr, __VA_ARGS__); } while (0)
+
+/* RCU */
+typedef struct adf_os_rcu_head {
+    struct adf_os_rcu_head *next;
+} adf_os_rcu_head_t;
+
+struct stress_rcu_reader {
+    unsigned long seq;
+};
+
+extern __thread struct stress_rcu_reader *stress_rcu_self;
+extern __thread int stress_rcu_nesting;
+void stress_rcu_synchronize(void);
+void stress_call_rcu(adf_os_rcu_head_t *head,
+                     void (*func)(adf_os_rcu_head_t *head));
+
+static inline void adf_os_rcu_read_lock(void)
+{
+    if (stress_rcu_nesting++ == 0)
+        __atomic_add_fetch(&stress_rcu_self->seq, 1, __ATOMIC_SEQ_CST);
+}
+
+static inline void adf_os_rcu_read_unlock(void)
+{
+    if (--stress_rcu_nesting == 0)
+        __atomic_add_fetch(&stress_rcu_self->seq, 1, __ATOMIC_RELEASE);
+}
+
+#define adf_os_rcu_dereference(p) __atomic_load_n(&(p), __ATOMIC_ACQUIRE)
+#define adf_os_rcu_read_lock_held() (stress_rcu_nesting > 0)
+#define adf_os_rcu_dereference_check(p, c) \
+    (assert(c), adf_os_rcu_dereference(p))
+#define adf_os_rcu_assign_pointer(p, v) \
+    __atomic_store_n(&(p), (v), __ATOMIC_RELEASE)
+#define adf_os_call_rcu(head, func) stress_call_rcu(head, func)
+#define adf_os_rcu_barrier() do { } while (0)
+
+/* TXRX configuration and objects, only the fields peer find uses */
+typedef void *ol_pdev_handle;
+typedef void *adf_os_device_t;
+int ol_cfg_max_peer_id(ol_pdev_handle pdev);
+
+union ol_txrx_align_mac_addr_t {
+    u_int8_t raw[OL_TXRX_MAC_ADDR_LEN];
+    struct {
+        u_int16_t bytes_ab;
+        u_int16_t bytes_cd;
+        u_int16_t bytes_ef;
+    } align2;
+    struct {
+        u_int32_t bytes_abcd;
+        u_int16_t bytes_ef;
+    } align4;
+};
+
+struct stress_slot;
+
+struct ol_txrx_peer_t {
+    struct ol_txrx_vdev_t *vdev;
+    adf_os_atomic_t ref_cnt;
+    union ol_txrx_align_mac_addr_t mac_addr;
+    TAILQ_ENTRY(ol_txrx_peer_t) hash_list_elem;
+    adf_os_rcu_head_t rcu_head;
+    u_int16_t peer_ids[MAX_NUM_PEER_ID_PER_PEER];
+    u_int16_t local_id;
+    int valid;
+    /* harness only */
+    u_int32_t magic;
+    struct stress_slot *slot;
+};
+
+struct ol_txrx_vdev_t {
+    struct ol_txrx_pdev_t *pdev;
+    struct ol_txrx_peer_t *last_real_peer;
+};
+
+struct ol_txrx_pdev_t {
+    ol_pdev_handle ctrl_pdev;
+    adf_os_device_t osdev;
+    struct {
+        int is_high_latency;
+    } cfg;
+    struct ol_txrx_peer_t **peer_id_to_obj_map;
+    struct {
+        unsigned mask;
+        unsigned idx_bits;
+        TAILQ_HEAD(, ol_txrx_peer_t) *bins;
+    } peer_hash;
+    adf_os_spinlock_t peer_ref_mutex;
+    adf_os_spinlock_t last_real_peer_mutex;
+};
+
+typedef struct ol_txrx_pdev_t *ol_txrx_pdev_handle;
+typedef struct ol_txrx_vdev_t *ol_txrx_vdev_handle;
+typedef struct ol_txrx_peer_t *ol_txrx_peer_handle;
+
+void ol_txrx_peer_unref_delete(ol_txrx_peer_handle peer);
+void ol_txrx_peer_tid_unpause(struct ol_txrx_peer_t *peer, int tid);
+void ol_tx_queue_decs_reinit(struct ol_txrx_peer_t *peer, u_int16_t peer_id);
+
+#endif /* __TXRX_STUB_H */
@@ -66,6 +66,8 @@
 #include "if_usb.h"
 #elif defined(HIF_SDIO)
 #include "if_ath_sdio.h"
+#elif defined(HIF_SIM)
+#include "if_sim.h"
 #endif
 #include "epping_main.h"
 #include "epping_internal.h"
@@ -82,7 +84,7 @@
 #define MEMORY_DEBUG_STR ""
 #endif
 
-#if defined(HIF_PCI) || defined(HIF_USB)
+#if defined(HIF_PCI) || defined(HIF_USB) || defined(HIF_SIM)
 extern int hif_register_driver(void);
 extern void hif_unregister_driver(void);
 #endif
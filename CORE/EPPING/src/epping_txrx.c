@@ -422,6 +422,10 @@ int epping_connect_service(epping_context_t *pEpping_ctx)
    connect.EpCallbacks.EpSendFull = NULL /* provided by HIF */;
    /* disable flow control for hw flow control */
    connect.ConnectionFlags |= HTC_CONNECT_FLAGS_DISABLE_CREDIT_FLOW_CTRL;
+#elif defined(HIF_SIM)
+   connect.EpCallbacks.EpRecvRefill = NULL /* provided by HIF */;
+   connect.EpCallbacks.EpSendFull = NULL /* provided by HIF */;
+   /* keep credit flow control, the emulated target returns credits */
 #endif
 
    /* connect to service */
@@ -438,7 +442,7 @@ int epping_connect_service(epping_context_t *pEpping_ctx)
    }
    pEpping_ctx->EppingEndpoint[0] = response.Endpoint;
 
-#if defined(HIF_PCI) || defined(HIF_USB)
+#if defined(HIF_PCI) || defined(HIF_USB) || defined(HIF_SIM)
    connect.ServiceID = WMI_DATA_BK_SVC;
    status = HTCConnectService(pEpping_ctx->HTCHandle,
                               &connect, &response);
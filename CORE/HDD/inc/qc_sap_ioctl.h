@@ -268,6 +268,7 @@ enum {
     QCASAP_PARAM_RX_STBC,
     QCASAP_SET_RADAR_DBG,
     QCSAP_PARAM_CHAN_WIDTH,
+    QCSAP_GET_SYNC_TSF,
 };
 
 int iw_get_channel_list(struct net_device *dev,
@@ -1269,6 +1269,26 @@ enum
 #define CFG_RUNTIME_PM_AUTO_MIN                ( 100 )
 #define CFG_RUNTIME_PM_AUTO_MAX                ( 10000 )
 #define CFG_RUNTIME_PM_AUTO_DEFAULT            ( 500 )
+
+/*
+ * Let the driver pick the runtime PM inactivity delay between
+ * gRuntimePMDelayMin and gRuntimePMDelayMax (ms) from the recent
+ * traffic inter-arrival times, starting at gRuntimePMDelay.
+ */
+#define CFG_RUNTIME_PM_GOVERNOR_NAME           "gRuntimePMGovernor"
+#define CFG_RUNTIME_PM_GOVERNOR_MIN            ( 0 )
+#define CFG_RUNTIME_PM_GOVERNOR_MAX            ( 1 )
+#define CFG_RUNTIME_PM_GOVERNOR_DEFAULT        ( 0 )
+
+#define CFG_RUNTIME_PM_DELAY_MIN_NAME          "gRuntimePMDelayMin"
+#define CFG_RUNTIME_PM_DELAY_MIN_MIN           ( 20 )
+#define CFG_RUNTIME_PM_DELAY_MIN_MAX           ( 10000 )
+#define CFG_RUNTIME_PM_DELAY_MIN_DEFAULT       ( 100 )
+
+#define CFG_RUNTIME_PM_DELAY_MAX_NAME          "gRuntimePMDelayMax"
+#define CFG_RUNTIME_PM_DELAY_MAX_MIN           ( 20 )
+#define CFG_RUNTIME_PM_DELAY_MAX_MAX           ( 10000 )
+#define CFG_RUNTIME_PM_DELAY_MAX_DEFAULT       ( 2000 )
 #endif
 
 #ifdef FEATURE_SECURE_FIRMWARE
@@ -3583,6 +3603,26 @@ FG_BTC_BT_INTERVAL_PAGE_P2P_STA_DEFAULT
 #define TSF_GPIO_PIN_INVALID                       (255)
 #define CFG_SET_TSF_GPIO_PIN_DEFAULT               (TSF_GPIO_PIN_INVALID)
 
+/*
+ * Period in ms at which the TSF of each active vdev is sampled against
+ * the host monotonic clock to keep a TSF<->host time model, 0 disables
+ */
+#define CFG_TSF_SYNC_PERIOD_NAME                   "gTsfSyncPeriodMs"
+#define CFG_TSF_SYNC_PERIOD_MIN                    (0)
+#define CFG_TSF_SYNC_PERIOD_MAX                    (60000)
+#define CFG_TSF_SYNC_PERIOD_DEFAULT                (0)
+
+/*
+ * WMI event groups processed ahead of the other events, bitmap of
+ * 0x1 - roam synch and roam events
+ * 0x2 - vdev start response, stopped and delete response events
+ * 0 processes all WMI events in arrival order
+ */
+#define CFG_WMI_RX_EVENT_PRIO_NAME                 "gWmiRxEventPrio"
+#define CFG_WMI_RX_EVENT_PRIO_MIN                  (0x0)
+#define CFG_WMI_RX_EVENT_PRIO_MAX                  (0x3)
+#define CFG_WMI_RX_EVENT_PRIO_DEFAULT              (0x3)
+
 #define CFG_MULTICAST_HOST_FW_MSGS          "gMulticastHostFwMsgs"
 #define CFG_MULTICAST_HOST_FW_MSGS_MIN      (0)
 #define CFG_MULTICAST_HOST_FW_MSGS_MAX      (1)
@@ -3758,6 +3798,16 @@ FG_BTC_BT_INTERVAL_PAGE_P2P_STA_DEFAULT
 #define CFG_DBG_MAX_MGMT_TX_FAILURE_COUNT_MAX     (500)
 #define CFG_DBG_MAX_MGMT_TX_FAILURE_COUNT_DEFAULT (0)
 
+/*
+ * Period in ms at which the firmware pushes pdev/vdev/peer stats to the
+ * host without being asked; the result is kept in the WMA stats snapshot.
+ * Value set as 0 will disable the feature.
+ */
+#define CFG_FW_STATS_PUSH_PERIOD_NAME    "gFwStatsPushPeriod"
+#define CFG_FW_STATS_PUSH_PERIOD_MIN     (0)
+#define CFG_FW_STATS_PUSH_PERIOD_MAX     (60000)
+#define CFG_FW_STATS_PUSH_PERIOD_DEFAULT (0)
+
 /*
  * This parameter will configure the first scan bucket
  * threshold to the mentioned value and all the AP's which
@@ -4376,6 +4426,9 @@ struct hdd_config {
 #ifdef FEATURE_RUNTIME_PM
    v_BOOL_t                    runtime_pm;
    v_U32_t                     runtime_pm_delay;
+   v_BOOL_t                    runtime_pm_governor;
+   v_U32_t                     runtime_pm_delay_min;
+   v_U32_t                     runtime_pm_delay_max;
 #endif
 
 #ifdef FEATURE_WLAN_RA_FILTERING
@@ -4847,7 +4900,9 @@ struct hdd_config {
    uint8_t                     inform_bss_rssi_raw;
 #ifdef WLAN_FEATURE_TSF
    uint32_t                    tsf_gpio_pin;
+   uint32_t                    tsf_sync_period;
 #endif
+   uint32_t                    wmi_rx_event_prio;
    uint8_t                     multicast_host_fw_msgs;
    uint32_t                    fine_time_meas_cap;
 #ifdef FEATURE_SECURE_FIRMWARE
@@ -4876,6 +4931,7 @@ struct hdd_config {
    char                        response_payload[MAX_LEN_UDP_RESP_OFFLOAD];
 #endif
    uint16_t                    max_mgmt_tx_fail_count;
+   uint32_t                    fw_stats_push_period;
    int8_t                      first_scan_bucket_threshold;
 #ifdef WLAN_FEATURE_WOW_PULSE
    bool                        wow_pulse_support;
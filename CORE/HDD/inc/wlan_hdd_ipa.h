@@ -42,7 +42,11 @@
   Include files
   -------------------------------------------------------------------------*/
 #ifdef IPA_OFFLOAD
+#ifdef IPA_SIM
+#include "wlan_hdd_ipa_sim.h"
+#else
 #include <linux/ipa.h>
+#endif
 
 enum hdd_ipa_forward_type {
 	HDD_IPA_FORWARD_PKT_NONE = 0,
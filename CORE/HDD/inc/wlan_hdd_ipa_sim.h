@@ -0,0 +1,436 @@
+/*
+ * Copyright (c) 2016 The Linux Foundation. All rights reserved.
+ *
+ * Previously licensed under the ISC license by Qualcomm Atheros, Inc.
+ *
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/*
+ * This file was originally distributed by Qualcomm Atheros, Inc.
+ * under proprietary terms before Copyright ownership was assigned
+ * to the Linux Foundation.
+ */
+
+#ifndef HDD_IPA_SIM_H__
+#define HDD_IPA_SIM_H__
+
+/**===========================================================================
+
+  \file  wlan_hdd_ipa_sim.h
+
+  \brief Software IPA backend
+
+  Stand-in for the subset of the msm <linux/ipa.h> client API used by
+  wlan_hdd_ipa.c. With IPA_SIM the IPA offload path builds and runs on a
+  platform without IPA hardware: pipes, headers and RM resources are kept
+  in host memory and the data path loops packets back through the pipe
+  notify callbacks, so the HDD IPA state machines and rx exception path
+  can be exercised and profiled.
+
+  ==========================================================================*/
+
+#include <linux/types.h>
+#include <linux/list.h>
+#include <linux/skbuff.h>
+#include <linux/if_ether.h>
+
+#define IPA_RESOURCE_NAME_MAX	32
+#define IPA_MAC_ADDR_SIZE	6
+#define IPA_HDR_MAX_SIZE	64
+
+/* one BAM descriptor per 8 byte sps_iovec */
+#define IPA_NUM_OF_FIFO_DESC(x)	((x) / sizeof(struct sps_iovec))
+
+struct sps_iovec {
+	u32 addr;
+	u32 size:16;
+	u32 flags:16;
+};
+
+enum ipa_client_type {
+	IPA_CLIENT_WLAN1_PROD,
+	IPA_CLIENT_WLAN1_CONS,
+	IPA_CLIENT_WLAN2_CONS,
+	IPA_CLIENT_WLAN3_CONS,
+	IPA_CLIENT_WLAN4_CONS,
+	IPA_CLIENT_MAX
+};
+
+enum ipa_ip_type {
+	IPA_IP_v4,
+	IPA_IP_v6
+};
+
+enum ipa_nat_en_type {
+	IPA_BYPASS_NAT
+};
+
+enum ipa_mode_type {
+	IPA_BASIC
+};
+
+enum ipa_hdr_l2_type {
+	IPA_HDR_L2_ETHERNET_II
+};
+
+enum ipa_dp_evt_type {
+	IPA_RECEIVE,
+	IPA_WRITE_DONE
+};
+
+enum ipa_voltage_level {
+	IPA_VOLTAGE_SVS
+};
+
+#define IPA_FLT_META_DATA	(1ul << 17)
+
+enum ipa_wlan_event {
+	WLAN_CLIENT_CONNECT,
+	WLAN_CLIENT_DISCONNECT,
+	WLAN_CLIENT_POWER_SAVE_MODE,
+	WLAN_CLIENT_NORMAL_MODE,
+	SW_ROUTING_ENABLE,
+	SW_ROUTING_DISABLE,
+	WLAN_AP_CONNECT,
+	WLAN_AP_DISCONNECT,
+	WLAN_STA_CONNECT,
+	WLAN_STA_DISCONNECT,
+	WLAN_CLIENT_CONNECT_EX,
+	WLAN_SWITCH_TO_SCC,
+	WLAN_SWITCH_TO_MCC,
+	WLAN_WDI_ENABLE,
+	WLAN_WDI_DISABLE,
+	IPA_WLAN_EVENT_MAX
+};
+
+enum ipa_wlan_hdr_attrib_type {
+	WLAN_HDR_ATTRIB_MAC_ADDR
+};
+
+enum ipa_rm_resource_name {
+	IPA_RM_RESOURCE_WLAN_PROD,
+	IPA_RM_RESOURCE_WLAN_CONS,
+	IPA_RM_RESOURCE_APPS_CONS,
+	IPA_RM_RESOURCE_MAX
+};
+
+enum ipa_rm_event {
+	IPA_RM_RESOURCE_GRANTED,
+	IPA_RM_RESOURCE_RELEASED
+};
+
+typedef void (*ipa_notify_cb)(void *priv, enum ipa_dp_evt_type evt,
+		unsigned long data);
+typedef void (*ipa_msg_free_fn)(void *buff, u32 len, u32 type);
+typedef void (*ipa_rm_notify_cb)(void *user_data, enum ipa_rm_event event,
+		unsigned long data);
+typedef void (*ipa_uc_ready_cb)(void *priv);
+
+struct ipa_ep_cfg_nat {
+	enum ipa_nat_en_type nat_en;
+};
+
+struct ipa_ep_cfg_hdr {
+	u32 hdr_len;
+	u32 hdr_ofst_metadata_valid;
+	u32 hdr_additional_const_len;
+	u32 hdr_ofst_pkt_size_valid;
+	u32 hdr_ofst_pkt_size;
+	u32 hdr_metadata_reg_valid;
+};
+
+struct ipa_ep_cfg_hdr_ext {
+	bool hdr_little_endian;
+};
+
+struct ipa_ep_cfg_mode {
+	enum ipa_mode_type mode;
+};
+
+struct ipa_ep_cfg {
+	struct ipa_ep_cfg_nat nat;
+	struct ipa_ep_cfg_hdr hdr;
+	struct ipa_ep_cfg_hdr_ext hdr_ext;
+	struct ipa_ep_cfg_mode mode;
+};
+
+struct ipa_sys_connect_params {
+	struct ipa_ep_cfg ipa_ep_cfg;
+	enum ipa_client_type client;
+	u32 desc_fifo_sz;
+	void *priv;
+	ipa_notify_cb notify;
+	bool skip_ep_cfg;
+	bool keep_ipa_awake;
+};
+
+struct ipa_wdi_ul_params {
+	phys_addr_t rdy_ring_base_pa;
+	u32 rdy_ring_size;
+	phys_addr_t rdy_ring_rp_pa;
+};
+
+struct ipa_wdi_dl_params {
+	phys_addr_t comp_ring_base_pa;
+	u32 comp_ring_size;
+	phys_addr_t ce_ring_base_pa;
+	phys_addr_t ce_door_bell_pa;
+	u32 ce_ring_size;
+	u32 num_tx_buffers;
+};
+
+struct ipa_wdi_in_params {
+	struct ipa_sys_connect_params sys;
+	union {
+		struct ipa_wdi_ul_params ul;
+		struct ipa_wdi_dl_params dl;
+	} u;
+};
+
+struct ipa_wdi_out_params {
+	phys_addr_t uc_door_bell_pa;
+	u32 clnt_hdl;
+};
+
+struct ipa_wdi_db_params {
+	enum ipa_client_type client;
+	phys_addr_t uc_door_bell_pa;
+};
+
+struct ipa_wdi_uc_ready_params {
+	bool is_uC_ready;
+	void *priv;
+	ipa_uc_ready_cb notify;
+};
+
+struct IpaHwRingStats_t {
+	u32 ringFull;
+	u32 ringEmpty;
+	u32 ringUsageHigh;
+	u32 ringUsageLow;
+};
+
+struct IpaHwBamStats_t {
+	u32 bamFifoFull;
+	u32 bamFifoEmpty;
+	u32 bamFifoUsageHigh;
+	u32 bamFifoUsageLow;
+};
+
+struct IpaHwTxWdiStats_t {
+	u32 num_pkts_processed;
+	u32 copy_engine_doorbell_value;
+	u32 num_db_fired;
+	struct IpaHwRingStats_t tx_comp_ring_stats;
+	struct IpaHwBamStats_t bam_stats;
+	u32 num_db;
+	u32 num_unexpected_db;
+	u32 num_bam_int_handled;
+	u32 num_bam_int_in_non_runnning_state;
+	u32 num_qmb_int_handled;
+};
+
+struct IpaHwRxWdiStats_t {
+	u32 max_outstanding_pkts;
+	u32 num_pkts_processed;
+	u32 rx_ring_rp_value;
+	struct IpaHwRingStats_t rx_ind_ring_stats;
+	struct IpaHwBamStats_t bam_stats;
+	u32 num_bam_int_handled;
+	u32 num_db;
+	u32 num_unexpected_db;
+};
+
+struct IpaHwStatsWDIInfoData_t {
+	struct IpaHwRxWdiStats_t rx_ch_stats;
+	struct IpaHwTxWdiStats_t tx_ch_stats;
+};
+
+struct ipa_rx_data {
+	struct sk_buff *skb;
+	dma_addr_t dma_addr;
+};
+
+struct ipa_tx_data_desc {
+	struct list_head link;
+	void *priv;
+	void *pyld_buffer;
+	u16 pyld_len;
+};
+
+struct ipa_msg_meta {
+	u8 msg_type;
+	u16 msg_len;
+};
+
+struct ipa_wlan_msg {
+	char name[IPA_RESOURCE_NAME_MAX];
+	u8 mac_addr[IPA_MAC_ADDR_SIZE];
+};
+
+struct ipa_wlan_hdr_attrib_val {
+	enum ipa_wlan_hdr_attrib_type attrib_type;
+	u8 offset;
+	union {
+		u8 mac_addr[IPA_MAC_ADDR_SIZE];
+	} u;
+};
+
+struct ipa_wlan_msg_ex {
+	char name[IPA_RESOURCE_NAME_MAX];
+	u8 num_of_attribs;
+	struct ipa_wlan_hdr_attrib_val attribs[0];
+};
+
+struct ipa_rule_attrib {
+	u32 attrib_mask;
+	u32 meta_data;
+	u32 meta_data_mask;
+};
+
+struct ipa_ioc_tx_intf_prop {
+	enum ipa_ip_type ip;
+	struct ipa_rule_attrib attrib;
+	enum ipa_client_type dst_pipe;
+	enum ipa_client_type alt_dst_pipe;
+	char hdr_name[IPA_RESOURCE_NAME_MAX];
+	enum ipa_hdr_l2_type hdr_l2_type;
+};
+
+struct ipa_ioc_rx_intf_prop {
+	enum ipa_ip_type ip;
+	struct ipa_rule_attrib attrib;
+	enum ipa_client_type src_pipe;
+	enum ipa_hdr_l2_type hdr_l2_type;
+};
+
+struct ipa_tx_intf {
+	u32 num_props;
+	struct ipa_ioc_tx_intf_prop *prop;
+};
+
+struct ipa_rx_intf {
+	u32 num_props;
+	struct ipa_ioc_rx_intf_prop *prop;
+};
+
+struct ipa_hdr_add {
+	char name[IPA_RESOURCE_NAME_MAX];
+	u8 hdr[IPA_HDR_MAX_SIZE];
+	u8 hdr_len;
+	enum ipa_hdr_l2_type type;
+	u8 is_partial;
+	u32 hdr_hdl;
+	int status;
+	u8 is_eth2_ofst_valid;
+	u16 eth2_ofst;
+};
+
+struct ipa_ioc_add_hdr {
+	u8 commit;
+	u8 num_hdrs;
+	struct ipa_hdr_add hdr[0];
+};
+
+struct ipa_hdr_del {
+	u32 hdl;
+	int status;
+};
+
+struct ipa_ioc_del_hdr {
+	u8 commit;
+	u8 num_hdls;
+	struct ipa_hdr_del hdl[0];
+};
+
+struct ipa_ioc_get_hdr {
+	char name[IPA_RESOURCE_NAME_MAX];
+	u32 hdl;
+};
+
+struct ipa_rm_register_params {
+	void *user_data;
+	ipa_rm_notify_cb notify_cb;
+};
+
+struct ipa_rm_create_params {
+	enum ipa_rm_resource_name name;
+	enum ipa_voltage_level floor_voltage;
+	struct ipa_rm_register_params reg_params;
+	int (*request_resource)(void);
+	int (*release_resource)(void);
+};
+
+struct ipa_rm_perf_profile {
+	u32 max_supported_bandwidth_mbps;
+};
+
+/* Header table */
+int ipa_add_hdr(struct ipa_ioc_add_hdr *hdrs);
+int ipa_del_hdr(struct ipa_ioc_del_hdr *hdls);
+int ipa_get_hdr(struct ipa_ioc_get_hdr *lookup);
+
+/* Interface registration and messages */
+int ipa_register_intf(const char *name, const struct ipa_tx_intf *tx,
+		const struct ipa_rx_intf *rx);
+int ipa_deregister_intf(const char *name);
+int ipa_send_msg(struct ipa_msg_meta *meta, void *buff,
+		ipa_msg_free_fn callback);
+
+/* System pipes and data path */
+int ipa_setup_sys_pipe(struct ipa_sys_connect_params *sys_in, u32 *clnt_hdl);
+int ipa_teardown_sys_pipe(u32 clnt_hdl);
+int ipa_tx_dp_mul(enum ipa_client_type dst,
+		struct ipa_tx_data_desc *data_desc);
+void ipa_free_skb(struct ipa_rx_data *data);
+
+/* WDI pipes and micro controller */
+int ipa_connect_wdi_pipe(struct ipa_wdi_in_params *in,
+		struct ipa_wdi_out_params *out);
+int ipa_disconnect_wdi_pipe(u32 clnt_hdl);
+int ipa_enable_wdi_pipe(u32 clnt_hdl);
+int ipa_disable_wdi_pipe(u32 clnt_hdl);
+int ipa_resume_wdi_pipe(u32 clnt_hdl);
+int ipa_suspend_wdi_pipe(u32 clnt_hdl);
+int ipa_get_wdi_stats(struct IpaHwStatsWDIInfoData_t *stats);
+int ipa_uc_wdi_get_dbpa(struct ipa_wdi_db_params *out);
+int ipa_uc_reg_rdyCB(struct ipa_wdi_uc_ready_params *param);
+int ipa_uc_dereg_rdyCB(void);
+
+/* Resource manager */
+int ipa_rm_create_resource(struct ipa_rm_create_params *create_params);
+int ipa_rm_delete_resource(enum ipa_rm_resource_name resource_name);
+int ipa_rm_add_dependency(enum ipa_rm_resource_name resource_name,
+		enum ipa_rm_resource_name depends_on_name);
+int ipa_rm_request_resource(enum ipa_rm_resource_name resource_name);
+int ipa_rm_release_resource(enum ipa_rm_resource_name resource_name);
+int ipa_rm_notify_completion(enum ipa_rm_event event,
+		enum ipa_rm_resource_name resource_name);
+int ipa_rm_set_perf_profile(enum ipa_rm_resource_name resource_name,
+		struct ipa_rm_perf_profile *profile);
+int ipa_rm_inactivity_timer_init(enum ipa_rm_resource_name resource_name,
+		unsigned long msecs);
+int ipa_rm_inactivity_timer_destroy(enum ipa_rm_resource_name resource_name);
+int ipa_rm_inactivity_timer_request_resource(
+		enum ipa_rm_resource_name resource_name);
+int ipa_rm_inactivity_timer_release_resource(
+		enum ipa_rm_resource_name resource_name);
+
+/* Load generation hook, not part of the IPA client API */
+int ipa_sim_rx_exception(struct sk_buff *skb);
+
+#endif /* HDD_IPA_SIM_H__ */
@@ -51,6 +51,7 @@
 #include <wlan_hdd_wmm.h>
 #include <wlan_hdd_cfg.h>
 #include <linux/spinlock.h>
+#include <linux/seqlock.h>
 #include <wlan_hdd_ftm.h>
 #ifdef FEATURE_WLAN_TDLS
 #include "wlan_hdd_tdls.h"
@@ -985,6 +986,87 @@ struct hdd_netif_queue_history {
 	uint32_t pause_map;
 };
 
+#ifdef WLAN_FEATURE_TSF
+/* accepted TSF reads kept for the drift estimate */
+#define HDD_TSF_SYNC_SAMPLES 8
+/* log2 buckets of the model's prediction error in us */
+#define HDD_TSF_SYNC_ERR_HIST_BINS 12
+
+/**
+ * struct hdd_tsf_sync_sample - one accepted TSF read
+ * @host_us: host monotonic time of the read, midpoint of request/report
+ * @tsf: TSF reported by firmware
+ */
+struct hdd_tsf_sync_sample {
+	uint64_t host_us;
+	uint64_t tsf;
+};
+
+/**
+ * struct hdd_tsf_sync_stats - accuracy of the TSF<->host clock model
+ * @reads: TSF reads sent to firmware
+ * @samples: reads used to update the model
+ * @rejected_rtt: reads dropped because their round trip was too long
+ * @lost: reads that were never answered
+ * @resyncs: times the model was restarted because the TSF jumped
+ * @rtt_min_us: shortest request/report round trip
+ * @rtt_max_us: longest request/report round trip
+ * @rtt_total_us: sum of all round trips
+ * @last_err_us: TSF minus the model's prediction, for the last sample
+ * @max_err_us: largest absolute prediction error
+ * @abs_err_total_us: sum of absolute prediction errors
+ * @err_hist: prediction errors, bin n counts [2^(n-1), 2^n) us
+ */
+struct hdd_tsf_sync_stats {
+	uint32_t reads;
+	uint32_t samples;
+	uint32_t rejected_rtt;
+	uint32_t lost;
+	uint32_t resyncs;
+	uint32_t rtt_min_us;
+	uint32_t rtt_max_us;
+	uint64_t rtt_total_us;
+	int32_t last_err_us;
+	uint32_t max_err_us;
+	uint64_t abs_err_total_us;
+	uint32_t err_hist[HDD_TSF_SYNC_ERR_HIST_BINS];
+};
+
+/**
+ * struct hdd_tsf_sync - TSF<->host clock correlation of one adapter
+ * @lock: taken by writers only, conversions read the model lock-free
+ * @valid: the model can be used for conversions
+ * @ref_host_us: host time of the model's reference point
+ * @ref_tsf: TSF at @ref_host_us
+ * @drift_ppb: TSF rate relative to the host clock, parts per billion
+ * @initialized: @work has been set up
+ * @running: the vdev is up and @work rearms itself
+ * @work: periodic TSF read
+ * @read_pending: a read is outstanding
+ * @samples: ring of the last accepted reads
+ * @sample_idx: next slot of @samples to fill
+ * @sample_cnt: valid entries in @samples
+ * @rtt_floor_us: recent shortest round trip, the bar for new samples
+ * @stats: accuracy statistics
+ */
+struct hdd_tsf_sync {
+	seqlock_t lock;
+	bool valid;
+	uint64_t ref_host_us;
+	uint64_t ref_tsf;
+	int32_t drift_ppb;
+
+	bool initialized;
+	bool running;
+	struct delayed_work work;
+	bool read_pending;
+	struct hdd_tsf_sync_sample samples[HDD_TSF_SYNC_SAMPLES];
+	uint8_t sample_idx;
+	uint8_t sample_cnt;
+	uint32_t rtt_floor_us;
+	struct hdd_tsf_sync_stats stats;
+};
+#endif /* WLAN_FEATURE_TSF */
 
 struct hdd_adapter_s
 {
@@ -1144,6 +1226,7 @@ struct hdd_adapter_s
    uint32_t tsf_high;
    /* current in capture tsf state or not */
    enum hdd_tsf_capture_state tsf_state;
+   struct hdd_tsf_sync tsf_sync;
 #endif
 
    hdd_cfg80211_state_t cfg80211State;
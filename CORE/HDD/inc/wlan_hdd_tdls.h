@@ -96,7 +96,8 @@ should not be more than 2000 */
 #define TDLS_SEC_OFFCHAN_OFFSET_80       80
 #define TDLS_SEC_OFFCHAN_OFFSET_160      160
 
-#define TDLS_PEER_LIST_SIZE   256
+#define TDLS_PEER_HASH_BITS   8
+#define TDLS_PEER_LIST_SIZE   (1 << TDLS_PEER_HASH_BITS)
 
 #define MAX_TDLS_DISCOVERY_CYCLE_RETRIES      2
 #define MIN_TDLS_DISCOVERY_CYCLE_RETRY_TIME  (5 * 60 * 1000)    /* 5 minutes */
@@ -268,10 +269,26 @@ typedef struct {
     tANI_S8         ap_rssi;
     struct _hddTdlsPeer_t  *curr_candidate;
     v_U32_t            magic;
+    /* random seed of the peer hash, so peer MACs can't pick the bucket */
+    u32             hash_seed;
 } tdlsCtx_t;
 
+/**
+ * struct hdd_tdls_peer_traffic - per-CPU frame counters of a TDLS peer
+ * @tx_pkt: frames sent to the peer
+ * @rx_pkt: frames received from the peer
+ *
+ * Bumped lock-free from the data path; only ever summed, never reset.
+ */
+struct hdd_tdls_peer_traffic {
+    u32 tx_pkt;
+    u32 rx_pkt;
+};
+
 typedef struct _hddTdlsPeer_t {
+    /* bucket link, traversed under RCU by the data path */
     struct list_head node;
+    struct rcu_head rcu;
     tdlsCtx_t   *pHddTdlsCtx;
     tSirMacAddr peerMac;
     tANI_U16    staId ;
@@ -282,8 +299,15 @@ typedef struct _hddTdlsPeer_t {
     tANI_U8     is_responder;
     tANI_U8     discovery_processed;
     tANI_U16    discovery_attempt;
-    tANI_U16    tx_pkt;
-    tANI_U16    rx_pkt;
+    /* traffic over the last implicit TDLS period, see
+     * wlan_hdd_tdls_collect_traffic()
+     */
+    tANI_U32    tx_pkt;
+    tANI_U32    rx_pkt;
+    struct hdd_tdls_peer_traffic __percpu *traffic;
+    /* sums of @traffic at the last collection */
+    tANI_U32    tx_pkt_base;
+    tANI_U32    rx_pkt_base;
     tANI_U8     uapsdQueues;
     tANI_U8     maxSp;
     uint8_t     qos;
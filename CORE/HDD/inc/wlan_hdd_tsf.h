@@ -45,6 +45,18 @@
 void wlan_hdd_tsf_init(hdd_context_t *hdd_ctx);
 int hdd_capture_tsf(hdd_adapter_t *adapter, uint32_t *buf, int len);
 int hdd_indicate_tsf(hdd_adapter_t *adapter, uint32_t *buf, int len);
+void wlan_hdd_tsf_sync_init(hdd_adapter_t *adapter);
+void wlan_hdd_tsf_sync_deinit(hdd_adapter_t *adapter);
+void wlan_hdd_tsf_sync_start(hdd_adapter_t *adapter);
+void wlan_hdd_tsf_sync_stop(hdd_adapter_t *adapter);
+int hdd_tsf_host_to_tsf(hdd_adapter_t *adapter, uint64_t host_us,
+			uint64_t *tsf);
+int hdd_tsf_to_host(hdd_adapter_t *adapter, uint64_t tsf, uint64_t *host_us);
+int hdd_tsf32_to_host(hdd_adapter_t *adapter, uint32_t tsf32,
+		      uint64_t *host_us);
+int hdd_indicate_sync_tsf(hdd_adapter_t *adapter, uint32_t *buf, int len);
+void hdd_tsf_sync_display(hdd_adapter_t *adapter);
+void hdd_tsf_sync_clear(hdd_adapter_t *adapter);
 #else
 static inline void
 wlan_hdd_tsf_init(hdd_context_t *hdd_ctx)
@@ -63,6 +75,66 @@ hdd_capture_tsf(hdd_adapter_t *adapter, uint32_t *buf, int len)
 {
 	return -ENOTSUPP;
 }
+
+static inline void
+wlan_hdd_tsf_sync_init(hdd_adapter_t *adapter)
+{
+	return;
+}
+
+static inline void
+wlan_hdd_tsf_sync_deinit(hdd_adapter_t *adapter)
+{
+	return;
+}
+
+static inline void
+wlan_hdd_tsf_sync_start(hdd_adapter_t *adapter)
+{
+	return;
+}
+
+static inline void
+wlan_hdd_tsf_sync_stop(hdd_adapter_t *adapter)
+{
+	return;
+}
+
+static inline int
+hdd_tsf_host_to_tsf(hdd_adapter_t *adapter, uint64_t host_us, uint64_t *tsf)
+{
+	return -ENOTSUPP;
+}
+
+static inline int
+hdd_tsf_to_host(hdd_adapter_t *adapter, uint64_t tsf, uint64_t *host_us)
+{
+	return -ENOTSUPP;
+}
+
+static inline int
+hdd_tsf32_to_host(hdd_adapter_t *adapter, uint32_t tsf32, uint64_t *host_us)
+{
+	return -ENOTSUPP;
+}
+
+static inline int
+hdd_indicate_sync_tsf(hdd_adapter_t *adapter, uint32_t *buf, int len)
+{
+	return -ENOTSUPP;
+}
+
+static inline void
+hdd_tsf_sync_display(hdd_adapter_t *adapter)
+{
+	return;
+}
+
+static inline void
+hdd_tsf_sync_clear(hdd_adapter_t *adapter)
+{
+	return;
+}
 #endif
 
 #endif
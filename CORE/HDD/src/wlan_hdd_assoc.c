@@ -71,6 +71,7 @@
 #include <wlan_logging_sock_svc.h>
 #include "tl_shim.h"
 #include "wlan_hdd_oemdata.h"
+#include "wlan_hdd_tsf.h"
 
 struct ether_addr
 {
@@ -157,6 +158,12 @@ v_VOID_t hdd_connSetConnectionState( hdd_adapter_t *pAdapter,
                     pHddStaCtx->conn_info.connState, connState);
    pHddStaCtx->conn_info.connState = connState;
 
+   /* follow the TSF only while the station is associated */
+   if (connState == eConnectionState_Associated)
+      wlan_hdd_tsf_sync_start(pAdapter);
+   else
+      wlan_hdd_tsf_sync_stop(pAdapter);
+
    /* Check is pending ROC request or not when connection state changed */
    schedule_delayed_work(&pHddCtx->rocReqWork, 0);
 }
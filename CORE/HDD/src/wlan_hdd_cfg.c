@@ -59,6 +59,7 @@
 #include <csrApi.h>
 #include <pmcApi.h>
 #include <wlan_hdd_misc.h>
+#include <adf_os_time.h>
 
 #if  defined (WLAN_FEATURE_VOWIFI_11R) || defined (FEATURE_WLAN_ESE) || defined(FEATURE_WLAN_LFR)
 static void
@@ -1764,6 +1765,27 @@ REG_TABLE_ENTRY g_registry_table[] =
                  CFG_RUNTIME_PM_AUTO_DEFAULT,
                  CFG_RUNTIME_PM_AUTO_MIN,
                  CFG_RUNTIME_PM_AUTO_MAX ),
+
+   REG_VARIABLE( CFG_RUNTIME_PM_GOVERNOR_NAME, WLAN_PARAM_Integer,
+                 hdd_config_t, runtime_pm_governor,
+                 VAR_FLAGS_OPTIONAL | VAR_FLAGS_RANGE_CHECK_ASSUME_DEFAULT,
+                 CFG_RUNTIME_PM_GOVERNOR_DEFAULT,
+                 CFG_RUNTIME_PM_GOVERNOR_MIN,
+                 CFG_RUNTIME_PM_GOVERNOR_MAX ),
+
+   REG_VARIABLE( CFG_RUNTIME_PM_DELAY_MIN_NAME, WLAN_PARAM_Integer,
+                 hdd_config_t, runtime_pm_delay_min,
+                 VAR_FLAGS_OPTIONAL | VAR_FLAGS_RANGE_CHECK_ASSUME_DEFAULT,
+                 CFG_RUNTIME_PM_DELAY_MIN_DEFAULT,
+                 CFG_RUNTIME_PM_DELAY_MIN_MIN,
+                 CFG_RUNTIME_PM_DELAY_MIN_MAX ),
+
+   REG_VARIABLE( CFG_RUNTIME_PM_DELAY_MAX_NAME, WLAN_PARAM_Integer,
+                 hdd_config_t, runtime_pm_delay_max,
+                 VAR_FLAGS_OPTIONAL | VAR_FLAGS_RANGE_CHECK_ASSUME_DEFAULT,
+                 CFG_RUNTIME_PM_DELAY_MAX_DEFAULT,
+                 CFG_RUNTIME_PM_DELAY_MAX_MIN,
+                 CFG_RUNTIME_PM_DELAY_MAX_MAX ),
 #endif
 
 #ifdef FEATURE_SECURE_FIRMWARE
@@ -4295,7 +4317,21 @@ REG_TABLE_ENTRY g_registry_table[] =
                 CFG_SET_TSF_GPIO_PIN_DEFAULT,
                 CFG_SET_TSF_GPIO_PIN_MIN,
                 CFG_SET_TSF_GPIO_PIN_MAX),
+
+   REG_VARIABLE(CFG_TSF_SYNC_PERIOD_NAME, WLAN_PARAM_Integer,
+                hdd_config_t, tsf_sync_period,
+                VAR_FLAGS_OPTIONAL | VAR_FLAGS_RANGE_CHECK_ASSUME_DEFAULT,
+                CFG_TSF_SYNC_PERIOD_DEFAULT,
+                CFG_TSF_SYNC_PERIOD_MIN,
+                CFG_TSF_SYNC_PERIOD_MAX),
 #endif
+   REG_VARIABLE(CFG_WMI_RX_EVENT_PRIO_NAME, WLAN_PARAM_HexInteger,
+                hdd_config_t, wmi_rx_event_prio,
+                VAR_FLAGS_OPTIONAL | VAR_FLAGS_RANGE_CHECK_ASSUME_DEFAULT,
+                CFG_WMI_RX_EVENT_PRIO_DEFAULT,
+                CFG_WMI_RX_EVENT_PRIO_MIN,
+                CFG_WMI_RX_EVENT_PRIO_MAX),
+
    REG_VARIABLE(CFG_FINE_TIME_MEAS_CAPABILITY, WLAN_PARAM_HexInteger,
                 hdd_config_t, fine_time_meas_cap,
                 VAR_FLAGS_OPTIONAL | VAR_FLAGS_RANGE_CHECK_ASSUME_DEFAULT,
@@ -4463,6 +4499,13 @@ REG_TABLE_ENTRY g_registry_table[] =
                 CFG_DBG_MAX_MGMT_TX_FAILURE_COUNT_MIN,
                 CFG_DBG_MAX_MGMT_TX_FAILURE_COUNT_MAX),
 
+   REG_VARIABLE(CFG_FW_STATS_PUSH_PERIOD_NAME, WLAN_PARAM_Integer,
+                hdd_config_t, fw_stats_push_period,
+                VAR_FLAGS_OPTIONAL | VAR_FLAGS_RANGE_CHECK_ASSUME_DEFAULT,
+                CFG_FW_STATS_PUSH_PERIOD_DEFAULT,
+                CFG_FW_STATS_PUSH_PERIOD_MIN,
+                CFG_FW_STATS_PUSH_PERIOD_MAX),
+
    REG_VARIABLE(CFG_FIRST_SCAN_BUCKET_THRESHOLD_NAME, WLAN_PARAM_SignedInteger,
                 hdd_config_t, first_scan_bucket_threshold,
                 VAR_FLAGS_OPTIONAL | VAR_FLAGS_RANGE_CHECK_ASSUME_DEFAULT,
@@ -4950,6 +4993,8 @@ VOS_STATUS hdd_parse_config_ini(hdd_context_t* pHddCtx)
    /* cfgIniTable is static to avoid excess stack usage */
    static tCfgIniEntry cfgIniTable[MAX_CFG_INI_ITEMS];
    VOS_STATUS vos_status = VOS_STATUS_SUCCESS;
+   v_U64_t start_us = adf_os_get_monotonic_us();
+   v_U64_t parsed_us = 0;
 
    memset(cfgIniTable, 0, sizeof(cfgIniTable));
 
@@ -5026,12 +5071,18 @@ VOS_STATUS hdd_parse_config_ini(hdd_context_t* pHddCtx)
       buffer = line;
    }
 
+   parsed_us = adf_os_get_monotonic_us();
+
    //Loop through the registry table and apply all these configs
    vos_status = hdd_apply_cfg_ini(pHddCtx, cfgIniTable, i);
 
    if (VOS_MONITOR_MODE == hdd_get_conparam())
       hdd_override_all_ps(pHddCtx);
 
+   hddLog(VOS_TRACE_LEVEL_INFO_HIGH, "%s: %d items from %s, read+parse %llu us, apply %llu us",
+          __func__, i, WLAN_INI_FILE, parsed_us - start_us,
+          adf_os_get_monotonic_us() - parsed_us);
+
 config_exit:
    release_firmware(fw);
    vos_mem_free(pTemp);
@@ -5188,6 +5239,9 @@ void print_hdd_cfg(hdd_context_t *pHddCtx)
 #ifdef FEATURE_RUNTIME_PM
   VOS_TRACE(VOS_MODULE_ID_HDD, VOS_TRACE_LEVEL_INFO_HIGH, "Name = [runtime_pm] Value = [%u] ", pHddCtx->cfg_ini->runtime_pm);
   VOS_TRACE(VOS_MODULE_ID_HDD, VOS_TRACE_LEVEL_INFO_HIGH, "Name = [runtime_pm_delay] Value = [%u] ", pHddCtx->cfg_ini->runtime_pm_delay);
+  VOS_TRACE(VOS_MODULE_ID_HDD, VOS_TRACE_LEVEL_INFO_HIGH, "Name = [%s] Value = [%u] ", CFG_RUNTIME_PM_GOVERNOR_NAME, pHddCtx->cfg_ini->runtime_pm_governor);
+  VOS_TRACE(VOS_MODULE_ID_HDD, VOS_TRACE_LEVEL_INFO_HIGH, "Name = [%s] Value = [%u] ", CFG_RUNTIME_PM_DELAY_MIN_NAME, pHddCtx->cfg_ini->runtime_pm_delay_min);
+  VOS_TRACE(VOS_MODULE_ID_HDD, VOS_TRACE_LEVEL_INFO_HIGH, "Name = [%s] Value = [%u] ", CFG_RUNTIME_PM_DELAY_MAX_NAME, pHddCtx->cfg_ini->runtime_pm_delay_max);
 #endif
 #ifdef FEATURE_SECURE_FIRMWARE
   hddLog(LOG2, "Name = [enable_fw_hash_check] Value = [%u]",
@@ -5522,6 +5576,9 @@ void print_hdd_cfg(hdd_context_t *pHddCtx)
                    pHddCtx->cfg_ini->fine_time_meas_cap);
   hddLog(LOG2, "Name = [gmax_mgmt_tx_failure_count] Value = [%u]",
                    pHddCtx->cfg_ini->max_mgmt_tx_fail_count);
+  hddLog(LOG2, "Name = [%s] Value = [%u]",
+                 CFG_FW_STATS_PUSH_PERIOD_NAME,
+                 pHddCtx->cfg_ini->fw_stats_push_period);
   hddLog(LOG2, "Name = [%s] Value = [%d]",
                  CFG_FIRST_SCAN_BUCKET_THRESHOLD_NAME,
                  pHddCtx->cfg_ini->first_scan_bucket_threshold);
@@ -5753,22 +5810,71 @@ VOS_STATUS hdd_cfg_get_sap_dyn_config(hdd_adapter_t *pAdapter, char *pBuf,
 }
 #endif
 
-static VOS_STATUS find_cfg_item (tCfgIniEntry* iniTable, unsigned long entries,
-    char *name, char** value)
+/* Number of buckets of the registry name hash, must be a power of 2 */
+#define HDD_CFG_HASH_SIZE   1024
+#define HDD_CFG_HASH_END    0xFFFF
+
+/*
+ * Registry table index, hashed by RegName, used to match the ini file
+ * entries in a single pass. Static to avoid excess stack usage.
+ */
+static v_U16_t cfgRegHashHead[HDD_CFG_HASH_SIZE];
+static v_U16_t cfgRegHashNext[ARRAY_SIZE(g_registry_table)];
+/* Value read from the ini file for each registry table entry */
+static char *cfgRegValue[ARRAY_SIZE(g_registry_table)];
+
+static v_U32_t hdd_cfg_name_hash(const char *name)
+{
+   v_U32_t hash = 0;
+
+   while (*name)
+      hash = (hash * 31) + (v_U8_t)*name++;
+
+   return hash & (HDD_CFG_HASH_SIZE - 1);
+}
+
+/**
+ * hdd_cfg_match_ini_items() - match ini file entries to registry entries
+ * @iniTable: entries read from the ini file
+ * @entries: number of entries in @iniTable
+ *
+ * Hashes the registry table by name and makes one pass over the ini file
+ * entries, recording the value of every registry entry found in
+ * cfgRegValue. As with a linear search the first occurrence of a name in
+ * the ini file wins.
+ *
+ * Return: none
+ */
+static void hdd_cfg_match_ini_items(tCfgIniEntry *iniTable,
+                                    unsigned long entries)
 {
-   VOS_STATUS status = VOS_STATUS_E_FAILURE;
    unsigned long i;
+   v_U16_t idx;
+   v_U32_t hash;
+
+   for (i = 0; i < HDD_CFG_HASH_SIZE; i++)
+      cfgRegHashHead[i] = HDD_CFG_HASH_END;
+
+   /* Insert in reverse so that chains are in registry table order */
+   for (i = ARRAY_SIZE(g_registry_table); i-- > 0; ) {
+      hash = hdd_cfg_name_hash(g_registry_table[i].RegName);
+      cfgRegHashNext[i] = cfgRegHashHead[hash];
+      cfgRegHashHead[hash] = i;
+      cfgRegValue[i] = NULL;
+   }
 
    for (i = 0; i < entries; i++) {
-     if (strcmp(iniTable[i].name, name) == 0) {
-       *value = iniTable[i].value;
-       VOS_TRACE(VOS_MODULE_ID_HDD, VOS_TRACE_LEVEL_INFO_HIGH, "Found %s entry for Name=[%s] Value=[%s] ",
-           WLAN_INI_FILE, name, *value);
-       return VOS_STATUS_SUCCESS;
-     }
+      hash = hdd_cfg_name_hash(iniTable[i].name);
+      for (idx = cfgRegHashHead[hash]; idx != HDD_CFG_HASH_END;
+           idx = cfgRegHashNext[idx]) {
+         if (cfgRegValue[idx] == NULL &&
+             strcmp(g_registry_table[idx].RegName, iniTable[i].name) == 0) {
+            cfgRegValue[idx] = iniTable[i].value;
+            VOS_TRACE(VOS_MODULE_ID_HDD, VOS_TRACE_LEVEL_INFO_HIGH, "Found %s entry for Name=[%s] Value=[%s] ",
+                WLAN_INI_FILE, iniTable[i].name, iniTable[i].value);
+         }
+      }
    }
-
-   return status;
 }
 
 static int parseHexDigit(char c)
@@ -5924,12 +6030,15 @@ static VOS_STATUS hdd_apply_cfg_ini( hdd_context_t *pHddCtx, tCfgIniEntry* iniTa
       WARN_ON(1);
    }
 
+   hdd_cfg_match_ini_items(iniTable, entries);
+
    for ( idx = 0; idx < cRegTableEntries; idx++, pRegEntry++ )
    {
       //Calculate the address of the destination field in the structure.
       pField = ( (v_U8_t *)pStructBase )+ pRegEntry->VarOffset;
 
-      match_status = find_cfg_item(iniTable, entries, pRegEntry->RegName, &value_str);
+      value_str = cfgRegValue[idx];
+      match_status = value_str ? VOS_STATUS_SUCCESS : VOS_STATUS_E_FAILURE;
 
       if( (match_status != VOS_STATUS_SUCCESS) && ( pRegEntry->Flags & VAR_FLAGS_REQUIRED ) )
       {
@@ -29,10 +29,12 @@
 #include <wlan_hdd_includes.h>
 #include <wlan_hdd_wowl.h>
 #include <vos_sched.h>
+#include "wma_api.h"
 
 #define MAX_USER_COMMAND_SIZE_WOWL_ENABLE 8
 #define MAX_USER_COMMAND_SIZE_WOWL_PATTERN 512
 #define MAX_USER_COMMAND_SIZE_FRAME 4096
+#define FW_STATS_SNAPSHOT_BUF_SIZE 16384
 
 /**
  * __wcnss_wowenable_write() - write wow enable
@@ -534,6 +536,56 @@ static ssize_t wcnss_patterngen_write(struct file *file,
 	return ret;
 }
 
+/**
+ * __wcnss_fw_stats_read() - read the WMA stats snapshot
+ * @file: file pointer
+ * @buf: user buffer
+ * @count: count
+ * @ppos: position pointer
+ *
+ * Return: number of bytes read on success, error number otherwise
+ */
+static ssize_t __wcnss_fw_stats_read(struct file *file,
+				     char __user *buf, size_t count,
+				     loff_t *ppos)
+{
+	char *kbuf;
+	int len;
+	ssize_t ret;
+
+	kbuf = vos_mem_malloc(FW_STATS_SNAPSHOT_BUF_SIZE);
+	if (!kbuf)
+		return -ENOMEM;
+
+	len = wma_stats_snapshot_dump(kbuf, FW_STATS_SNAPSHOT_BUF_SIZE);
+	ret = simple_read_from_buffer(buf, count, ppos, kbuf, len);
+	vos_mem_free(kbuf);
+
+	return ret;
+}
+
+/**
+ * wcnss_fw_stats_read() - SSR wrapper for __wcnss_fw_stats_read
+ * @file: file pointer
+ * @buf: user buffer
+ * @count: count
+ * @ppos: position pointer
+ *
+ * Return: number of bytes read on success, error number otherwise
+ */
+static ssize_t wcnss_fw_stats_read(struct file *file,
+				   char __user *buf, size_t count,
+				   loff_t *ppos)
+{
+	ssize_t ret;
+
+	vos_ssr_protect(__func__);
+	ret = __wcnss_fw_stats_read(file, buf, count, ppos);
+	vos_ssr_unprotect(__func__);
+
+	return ret;
+}
+
 /**
  * __wcnss_debugfs_open() - open debugfs
  * @inode: inode pointer
@@ -608,6 +660,13 @@ static const struct file_operations fops_patterngen = {
     .llseek = default_llseek,
 };
 
+static const struct file_operations fops_fw_stats = {
+    .read = wcnss_fw_stats_read,
+    .open = wcnss_debugfs_open,
+    .owner = THIS_MODULE,
+    .llseek = default_llseek,
+};
+
 VOS_STATUS hdd_debugfs_init(hdd_adapter_t *pAdapter)
 {
     hdd_context_t *pHddCtx = WLAN_HDD_GET_CTX(pAdapter);
@@ -628,6 +687,10 @@ VOS_STATUS hdd_debugfs_init(hdd_adapter_t *pAdapter)
         pHddCtx->debugfs_phy, pAdapter, &fops_patterngen))
         return VOS_STATUS_E_FAILURE;
 
+    if (NULL == debugfs_create_file("fw_stats", S_IRUSR,
+        pHddCtx->debugfs_phy, pAdapter, &fops_fw_stats))
+        return VOS_STATUS_E_FAILURE;
+
     return VOS_STATUS_SUCCESS;
 }
 
@@ -96,6 +96,8 @@
 #include "if_usb.h"
 #elif defined(HIF_SDIO)
 #include "if_ath_sdio.h"
+#elif defined(HIF_SIM)
+#include "if_sim.h"
 #endif
 
 #include "ol_fw.h"
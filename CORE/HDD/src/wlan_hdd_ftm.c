@@ -85,6 +85,8 @@
 #include <linux/compat.h>
 #elif defined(HIF_SDIO)
 #include "if_ath_sdio.h"
+#elif defined(HIF_SIM)
+#include "if_sim.h"
 #endif
 #endif
 
@@ -1516,6 +1516,7 @@ VOS_STATUS hdd_hostapd_SAPEventCB( tpSap_Event pSapEvent, v_PVOID_t usrDataForCa
             wlan_hdd_auto_shutdown_enable(pHddCtx, VOS_TRUE);
 #endif
             pHddApCtx->operatingChannel = pSapEvent->sapevt.sapStartBssCompleteEvent.operatingChannel;
+            wlan_hdd_tsf_sync_start(pHostapdAdapter);
 
             hdd_hostapd_channel_prevent_suspend(pHostapdAdapter,
                     pHddApCtx->operatingChannel);
@@ -1628,6 +1629,7 @@ VOS_STATUS hdd_hostapd_SAPEventCB( tpSap_Event pSapEvent, v_PVOID_t usrDataForCa
                              "eSAP_STATUS_FAILURE" : "eSAP_STATUS_SUCCESS");
 
             hdd_set_sap_auth_offload(pHostapdAdapter, FALSE);
+            wlan_hdd_tsf_sync_stop(pHostapdAdapter);
 
             hdd_hostapd_channel_allow_suspend(pHostapdAdapter,
                     pHddApCtx->operatingChannel);
@@ -3566,6 +3568,18 @@ static __iw_softap_setparam(struct net_device *dev,
                 case WLAN_HDD_NETIF_OPER_HISTORY:
                     wlan_hdd_clear_netif_queue_history(hdd_ctx);
                     break;
+                case WLAN_VOS_MC_MQ_STATS:
+                    vos_mq_clear_mc_stats();
+                    break;
+                case WLAN_WMI_RX_EVENT_STATS:
+                    wma_clear_wmi_rx_event_stats();
+                    break;
+                case WLAN_TSF_SYNC_STATS:
+                    hdd_tsf_sync_clear(pHostapdAdapter);
+                    break;
+                case WLAN_MGMT_RX_BATCH_STATS:
+                    WLANTL_clear_mgmt_rx_batch_stats(hdd_ctx->pvosContext);
+                    break;
                 default:
                     WLANTL_clear_datapath_stats(hdd_ctx->pvosContext,
                                                              set_value);
@@ -3619,6 +3633,9 @@ static int __iw_softap_get_three(struct net_device *dev,
 	case QCSAP_GET_TSF:
 		ret = hdd_indicate_tsf(padapter, value, 3);
 		break;
+	case QCSAP_GET_SYNC_TSF:
+		ret = hdd_indicate_sync_tsf(padapter, value, 3);
+		break;
 	default:
 		hddLog(LOGE, FL("Invalid getparam command %d"), sub_cmd);
 		break;
@@ -6392,6 +6409,8 @@ static const struct iw_priv_args hostapd_private_args[] = {
 #ifdef WLAN_FEATURE_TSF
   { QCSAP_GET_TSF, 0,
       IW_PRIV_TYPE_INT | IW_PRIV_SIZE_FIXED | 3,    "get_tsf" },
+  { QCSAP_GET_SYNC_TSF, 0,
+      IW_PRIV_TYPE_INT | IW_PRIV_SIZE_FIXED | 3,    "get_sync_tsf" },
 #endif
   { QCASAP_TX_CHAINMASK_CMD, 0,
       IW_PRIV_TYPE_INT | IW_PRIV_SIZE_FIXED | 1,    "get_txchainmask" },
@@ -0,0 +1,969 @@
+/*
+ * Copyright (c) 2016 The Linux Foundation. All rights reserved.
+ *
+ * Previously licensed under the ISC license by Qualcomm Atheros, Inc.
+ *
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/*
+ * This file was originally distributed by Qualcomm Atheros, Inc.
+ * under proprietary terms before Copyright ownership was assigned
+ * to the Linux Foundation.
+ */
+
+/**========================================================================
+
+\file  wlan_hdd_ipa_sim.c
+
+\brief   Software IPA backend
+
+The IPA client API used by wlan_hdd_ipa.c, implemented in host memory.
+Pipes, headers and interfaces are plain tables, RM grants are delivered
+from a work item like the IPA driver does, and packets handed over with
+ipa_tx_dp_mul() come back through the WLAN1_PROD notify callback as
+IPA_WRITE_DONE followed by IPA_RECEIVE exceptions. There is no routing,
+filtering or uC firmware behind it; it exists so the HDD IPA state
+machines and the exception rx path can run without IPA hardware.
+
+========================================================================*/
+
+/*--------------------------------------------------------------------------
+Include Files
+------------------------------------------------------------------------*/
+#if defined(IPA_OFFLOAD) && defined(IPA_SIM)
+#include <linux/module.h>
+#include <linux/slab.h>
+#include <linux/spinlock.h>
+#include <linux/workqueue.h>
+#include <linux/skbuff.h>
+#include <linux/string.h>
+#include <linux/bottom_half.h>
+
+#include "vos_trace.h"
+#include "wlan_hdd_ipa_sim.h"
+
+#define IPA_SIM_LOG(LVL, fmt, args...) VOS_TRACE(VOS_MODULE_ID_HDD, LVL, \
+				"%s:%d: "fmt, __func__, __LINE__, ## args)
+
+#define IPA_SIM_MAX_PIPES	16
+#define IPA_SIM_MAX_HDRS	32
+#define IPA_SIM_MAX_INTF	8
+
+/* doorbells are never rung by the host, hand out recognisable addresses */
+#define IPA_SIM_UC_DB_PA_BASE	0x7e000000
+#define IPA_SIM_UC_DB_PA(_client)	(IPA_SIM_UC_DB_PA_BASE + (_client) * 4)
+
+/* percentage of ipa_tx_dp_mul() packets bounced back as exceptions */
+static unsigned int ipa_sim_excp_pct = 100;
+module_param(ipa_sim_excp_pct, uint, 0644);
+
+/* time between ipa_tx_dp_mul() and its IPA_WRITE_DONE */
+static unsigned int ipa_sim_dp_latency_us;
+module_param(ipa_sim_dp_latency_us, uint, 0644);
+
+/* time between an RM request and the IPA_RM_RESOURCE_GRANTED event */
+static unsigned int ipa_sim_rm_grant_ms;
+module_param(ipa_sim_rm_grant_ms, uint, 0644);
+
+/* report the uC as loaded this long after ipa_uc_reg_rdyCB(), 0 is ready */
+static unsigned int ipa_sim_uc_ready_ms;
+module_param(ipa_sim_uc_ready_ms, uint, 0644);
+
+struct ipa_sim_pipe {
+	bool valid;
+	bool wdi;
+	bool enabled;
+	bool resumed;
+	struct ipa_sys_connect_params sys;
+};
+
+struct ipa_sim_hdr {
+	bool valid;
+	struct ipa_hdr_add hdr;
+};
+
+struct ipa_sim_rm {
+	bool created;
+	bool granted;
+	bool grant_pending;
+	bool timer_valid;
+	bool has_dependency;
+	enum ipa_rm_resource_name depends_on;
+	unsigned long inactivity_msecs;
+	u32 bw_mbps;
+	struct ipa_rm_create_params params;
+	struct delayed_work grant_work;
+	struct delayed_work inactivity_work;
+};
+
+struct ipa_sim_batch {
+	struct list_head node;
+	struct ipa_tx_data_desc *head;
+};
+
+struct ipa_sim_ctx {
+	struct ipa_sim_pipe pipe[IPA_SIM_MAX_PIPES];
+	struct ipa_sim_hdr hdr[IPA_SIM_MAX_HDRS];
+	char intf[IPA_SIM_MAX_INTF][IPA_RESOURCE_NAME_MAX];
+	struct ipa_sim_rm rm[IPA_RM_RESOURCE_MAX];
+	struct ipa_wdi_uc_ready_params uc_ready;
+	struct IpaHwStatsWDIInfoData_t wdi_stats;
+	u32 dp_seq;
+};
+
+static struct ipa_sim_ctx ipa_sim;
+static DEFINE_SPINLOCK(ipa_sim_lock);
+static LIST_HEAD(ipa_sim_dp_q);
+
+static void ipa_sim_dp_work_fn(struct work_struct *work);
+static void ipa_sim_uc_ready_work_fn(struct work_struct *work);
+static DECLARE_DELAYED_WORK(ipa_sim_dp_work, ipa_sim_dp_work_fn);
+static DECLARE_DELAYED_WORK(ipa_sim_uc_ready_work, ipa_sim_uc_ready_work_fn);
+
+/*--------------------------------------------------------------------------
+Header table
+------------------------------------------------------------------------*/
+static int ipa_sim_find_hdr(const char *name)
+{
+	int i;
+
+	for (i = 0; i < IPA_SIM_MAX_HDRS; i++) {
+		if (ipa_sim.hdr[i].valid &&
+		    !strncmp(ipa_sim.hdr[i].hdr.name, name,
+			     IPA_RESOURCE_NAME_MAX))
+			return i;
+	}
+	return -1;
+}
+
+int ipa_add_hdr(struct ipa_ioc_add_hdr *hdrs)
+{
+	int i, slot, ret = 0;
+
+	if (!hdrs || !hdrs->num_hdrs)
+		return -EINVAL;
+
+	spin_lock_bh(&ipa_sim_lock);
+	for (i = 0; i < hdrs->num_hdrs; i++) {
+		struct ipa_hdr_add *hdr = &hdrs->hdr[i];
+
+		if (hdr->hdr_len > IPA_HDR_MAX_SIZE ||
+		    ipa_sim_find_hdr(hdr->name) >= 0) {
+			hdr->status = -EPERM;
+			ret = -EPERM;
+			continue;
+		}
+
+		for (slot = 0; slot < IPA_SIM_MAX_HDRS; slot++) {
+			if (!ipa_sim.hdr[slot].valid)
+				break;
+		}
+		if (slot == IPA_SIM_MAX_HDRS) {
+			hdr->status = -ENOMEM;
+			ret = -ENOMEM;
+			continue;
+		}
+
+		hdr->hdr_hdl = slot + 1;
+		hdr->status = 0;
+		ipa_sim.hdr[slot].hdr = *hdr;
+		ipa_sim.hdr[slot].valid = true;
+	}
+	spin_unlock_bh(&ipa_sim_lock);
+
+	return ret;
+}
+
+int ipa_del_hdr(struct ipa_ioc_del_hdr *hdls)
+{
+	int i, ret = 0;
+
+	if (!hdls || !hdls->num_hdls)
+		return -EINVAL;
+
+	spin_lock_bh(&ipa_sim_lock);
+	for (i = 0; i < hdls->num_hdls; i++) {
+		u32 hdl = hdls->hdl[i].hdl;
+
+		if (hdl == 0 || hdl > IPA_SIM_MAX_HDRS ||
+		    !ipa_sim.hdr[hdl - 1].valid) {
+			hdls->hdl[i].status = -EINVAL;
+			ret = -EINVAL;
+			continue;
+		}
+		ipa_sim.hdr[hdl - 1].valid = false;
+		hdls->hdl[i].status = 0;
+	}
+	spin_unlock_bh(&ipa_sim_lock);
+
+	return ret;
+}
+
+int ipa_get_hdr(struct ipa_ioc_get_hdr *lookup)
+{
+	int slot;
+
+	if (!lookup)
+		return -EINVAL;
+
+	spin_lock_bh(&ipa_sim_lock);
+	slot = ipa_sim_find_hdr(lookup->name);
+	if (slot >= 0)
+		lookup->hdl = ipa_sim.hdr[slot].hdr.hdr_hdl;
+	spin_unlock_bh(&ipa_sim_lock);
+
+	return slot >= 0 ? 0 : -EINVAL;
+}
+
+/*--------------------------------------------------------------------------
+Interfaces and messages
+------------------------------------------------------------------------*/
+int ipa_register_intf(const char *name, const struct ipa_tx_intf *tx,
+		const struct ipa_rx_intf *rx)
+{
+	int i, free_slot = -1;
+
+	if (!name || !tx)
+		return -EINVAL;
+
+	spin_lock_bh(&ipa_sim_lock);
+	for (i = 0; i < IPA_SIM_MAX_INTF; i++) {
+		if (!ipa_sim.intf[i][0]) {
+			if (free_slot < 0)
+				free_slot = i;
+		} else if (!strncmp(ipa_sim.intf[i], name,
+				    IPA_RESOURCE_NAME_MAX)) {
+			spin_unlock_bh(&ipa_sim_lock);
+			return -EEXIST;
+		}
+	}
+	if (free_slot >= 0)
+		strlcpy(ipa_sim.intf[free_slot], name, IPA_RESOURCE_NAME_MAX);
+	spin_unlock_bh(&ipa_sim_lock);
+
+	return free_slot >= 0 ? 0 : -ENOMEM;
+}
+
+int ipa_deregister_intf(const char *name)
+{
+	int i;
+
+	if (!name)
+		return -EINVAL;
+
+	spin_lock_bh(&ipa_sim_lock);
+	for (i = 0; i < IPA_SIM_MAX_INTF; i++) {
+		if (!strncmp(ipa_sim.intf[i], name, IPA_RESOURCE_NAME_MAX)) {
+			ipa_sim.intf[i][0] = '\0';
+			break;
+		}
+	}
+	spin_unlock_bh(&ipa_sim_lock);
+
+	return i < IPA_SIM_MAX_INTF ? 0 : -EINVAL;
+}
+
+int ipa_send_msg(struct ipa_msg_meta *meta, void *buff,
+		ipa_msg_free_fn callback)
+{
+	if (!meta || !buff || meta->msg_type >= IPA_WLAN_EVENT_MAX)
+		return -EINVAL;
+
+	/* nobody reads the message queue, consume it right away */
+	if (callback)
+		callback(buff, meta->msg_len, meta->msg_type);
+
+	return 0;
+}
+
+/*--------------------------------------------------------------------------
+Pipes
+------------------------------------------------------------------------*/
+static int ipa_sim_alloc_pipe(struct ipa_sys_connect_params *sys, bool wdi,
+		u32 *clnt_hdl)
+{
+	int i, slot = -1;
+
+	if (!sys || !clnt_hdl || sys->client >= IPA_CLIENT_MAX)
+		return -EINVAL;
+
+	spin_lock_bh(&ipa_sim_lock);
+	for (i = 0; i < IPA_SIM_MAX_PIPES; i++) {
+		if (!ipa_sim.pipe[i].valid) {
+			if (slot < 0)
+				slot = i;
+		} else if (ipa_sim.pipe[i].sys.client == sys->client) {
+			spin_unlock_bh(&ipa_sim_lock);
+			IPA_SIM_LOG(VOS_TRACE_LEVEL_ERROR,
+				    "client %d already connected", sys->client);
+			return -EBUSY;
+		}
+	}
+	if (slot >= 0) {
+		memset(&ipa_sim.pipe[slot], 0, sizeof(ipa_sim.pipe[slot]));
+		ipa_sim.pipe[slot].sys = *sys;
+		ipa_sim.pipe[slot].wdi = wdi;
+		ipa_sim.pipe[slot].valid = true;
+		*clnt_hdl = slot;
+	}
+	spin_unlock_bh(&ipa_sim_lock);
+
+	return slot >= 0 ? 0 : -ENOMEM;
+}
+
+static struct ipa_sim_pipe *ipa_sim_get_pipe(u32 clnt_hdl, bool wdi)
+{
+	if (clnt_hdl >= IPA_SIM_MAX_PIPES || !ipa_sim.pipe[clnt_hdl].valid ||
+	    ipa_sim.pipe[clnt_hdl].wdi != wdi)
+		return NULL;
+
+	return &ipa_sim.pipe[clnt_hdl];
+}
+
+static struct ipa_sim_pipe *ipa_sim_client_pipe(enum ipa_client_type client)
+{
+	int i;
+
+	for (i = 0; i < IPA_SIM_MAX_PIPES; i++) {
+		if (ipa_sim.pipe[i].valid && ipa_sim.pipe[i].sys.client == client)
+			return &ipa_sim.pipe[i];
+	}
+	return NULL;
+}
+
+int ipa_setup_sys_pipe(struct ipa_sys_connect_params *sys_in, u32 *clnt_hdl)
+{
+	if (sys_in && !sys_in->notify)
+		return -EINVAL;
+
+	return ipa_sim_alloc_pipe(sys_in, false, clnt_hdl);
+}
+
+int ipa_teardown_sys_pipe(u32 clnt_hdl)
+{
+	struct ipa_sim_pipe *pipe;
+
+	spin_lock_bh(&ipa_sim_lock);
+	pipe = ipa_sim_get_pipe(clnt_hdl, false);
+	if (pipe)
+		pipe->valid = false;
+	spin_unlock_bh(&ipa_sim_lock);
+
+	if (!pipe)
+		return -EINVAL;
+
+	/* no callbacks for the pipe may run after teardown returns */
+	flush_delayed_work(&ipa_sim_dp_work);
+	return 0;
+}
+
+int ipa_connect_wdi_pipe(struct ipa_wdi_in_params *in,
+		struct ipa_wdi_out_params *out)
+{
+	int ret;
+
+	if (!in || !out)
+		return -EINVAL;
+
+	ret = ipa_sim_alloc_pipe(&in->sys, true, &out->clnt_hdl);
+	if (ret)
+		return ret;
+
+	out->uc_door_bell_pa = IPA_SIM_UC_DB_PA(in->sys.client);
+	return 0;
+}
+
+int ipa_disconnect_wdi_pipe(u32 clnt_hdl)
+{
+	struct ipa_sim_pipe *pipe;
+	int ret = 0;
+
+	spin_lock_bh(&ipa_sim_lock);
+	pipe = ipa_sim_get_pipe(clnt_hdl, true);
+	if (!pipe)
+		ret = -EINVAL;
+	else if (pipe->enabled)
+		ret = -EFAULT;
+	else
+		pipe->valid = false;
+	spin_unlock_bh(&ipa_sim_lock);
+
+	if (ret)
+		IPA_SIM_LOG(VOS_TRACE_LEVEL_ERROR, "hdl %u: %d", clnt_hdl, ret);
+	return ret;
+}
+
+enum ipa_sim_wdi_op {
+	IPA_SIM_WDI_ENABLE,
+	IPA_SIM_WDI_DISABLE,
+	IPA_SIM_WDI_RESUME,
+	IPA_SIM_WDI_SUSPEND
+};
+
+/*
+ * WDI pipes go connect -> enable -> resume and back down through
+ * suspend -> disable -> disconnect, out of order calls fail like they
+ * do on the IPA driver so the HDD uC state machine is checked.
+ */
+static int ipa_sim_wdi_op(u32 clnt_hdl, enum ipa_sim_wdi_op op)
+{
+	struct ipa_sim_pipe *pipe;
+	int ret = 0;
+
+	spin_lock_bh(&ipa_sim_lock);
+	pipe = ipa_sim_get_pipe(clnt_hdl, true);
+	if (!pipe) {
+		ret = -EINVAL;
+		goto end;
+	}
+
+	switch (op) {
+	case IPA_SIM_WDI_ENABLE:
+		if (pipe->enabled)
+			ret = -EFAULT;
+		else
+			pipe->enabled = true;
+		break;
+	case IPA_SIM_WDI_DISABLE:
+		if (!pipe->enabled || pipe->resumed)
+			ret = -EFAULT;
+		else
+			pipe->enabled = false;
+		break;
+	case IPA_SIM_WDI_RESUME:
+		if (!pipe->enabled || pipe->resumed)
+			ret = -EFAULT;
+		else
+			pipe->resumed = true;
+		break;
+	case IPA_SIM_WDI_SUSPEND:
+		if (!pipe->resumed)
+			ret = -EFAULT;
+		else
+			pipe->resumed = false;
+		break;
+	}
+
+end:
+	spin_unlock_bh(&ipa_sim_lock);
+	if (ret)
+		IPA_SIM_LOG(VOS_TRACE_LEVEL_ERROR, "hdl %u op %d: %d",
+			    clnt_hdl, op, ret);
+	return ret;
+}
+
+int ipa_enable_wdi_pipe(u32 clnt_hdl)
+{
+	return ipa_sim_wdi_op(clnt_hdl, IPA_SIM_WDI_ENABLE);
+}
+
+int ipa_disable_wdi_pipe(u32 clnt_hdl)
+{
+	return ipa_sim_wdi_op(clnt_hdl, IPA_SIM_WDI_DISABLE);
+}
+
+int ipa_resume_wdi_pipe(u32 clnt_hdl)
+{
+	return ipa_sim_wdi_op(clnt_hdl, IPA_SIM_WDI_RESUME);
+}
+
+int ipa_suspend_wdi_pipe(u32 clnt_hdl)
+{
+	return ipa_sim_wdi_op(clnt_hdl, IPA_SIM_WDI_SUSPEND);
+}
+
+int ipa_get_wdi_stats(struct IpaHwStatsWDIInfoData_t *stats)
+{
+	if (!stats)
+		return -EINVAL;
+
+	spin_lock_bh(&ipa_sim_lock);
+	*stats = ipa_sim.wdi_stats;
+	spin_unlock_bh(&ipa_sim_lock);
+	return 0;
+}
+
+int ipa_uc_wdi_get_dbpa(struct ipa_wdi_db_params *out)
+{
+	if (!out || out->client >= IPA_CLIENT_MAX)
+		return -EINVAL;
+
+	out->uc_door_bell_pa = IPA_SIM_UC_DB_PA(out->client);
+	return 0;
+}
+
+static void ipa_sim_uc_ready_work_fn(struct work_struct *work)
+{
+	struct ipa_wdi_uc_ready_params uc_ready;
+
+	spin_lock_bh(&ipa_sim_lock);
+	uc_ready = ipa_sim.uc_ready;
+	ipa_sim.uc_ready.notify = NULL;
+	spin_unlock_bh(&ipa_sim_lock);
+
+	if (uc_ready.notify)
+		uc_ready.notify(uc_ready.priv);
+}
+
+int ipa_uc_reg_rdyCB(struct ipa_wdi_uc_ready_params *param)
+{
+	/* anything but -EPERM tells hdd_ipa_is_present() that IPA is here */
+	if (!param)
+		return -EINVAL;
+
+	if (!ipa_sim_uc_ready_ms) {
+		param->is_uC_ready = true;
+		return 0;
+	}
+
+	param->is_uC_ready = false;
+	spin_lock_bh(&ipa_sim_lock);
+	ipa_sim.uc_ready = *param;
+	spin_unlock_bh(&ipa_sim_lock);
+	schedule_delayed_work(&ipa_sim_uc_ready_work,
+			      msecs_to_jiffies(ipa_sim_uc_ready_ms));
+	return 0;
+}
+
+int ipa_uc_dereg_rdyCB(void)
+{
+	spin_lock_bh(&ipa_sim_lock);
+	ipa_sim.uc_ready.notify = NULL;
+	spin_unlock_bh(&ipa_sim_lock);
+	cancel_delayed_work_sync(&ipa_sim_uc_ready_work);
+	return 0;
+}
+
+/*--------------------------------------------------------------------------
+Data path
+------------------------------------------------------------------------*/
+static void ipa_sim_notify(struct ipa_sim_pipe *pipe,
+		enum ipa_dp_evt_type evt, unsigned long data)
+{
+	/* the IPA driver calls back from softirq context */
+	local_bh_disable();
+	pipe->sys.notify(pipe->sys.priv, evt, data);
+	local_bh_enable();
+}
+
+static void ipa_sim_dp_work_fn(struct work_struct *work)
+{
+	struct ipa_sim_batch *batch;
+	struct ipa_tx_data_desc *desc;
+	struct ipa_sim_pipe *prod;
+	struct sk_buff_head excp_q;
+	struct sk_buff *skb;
+	u32 cnt;
+
+	skb_queue_head_init(&excp_q);
+
+	for (;;) {
+		spin_lock_bh(&ipa_sim_lock);
+		batch = list_first_entry_or_null(&ipa_sim_dp_q,
+				struct ipa_sim_batch, node);
+		if (batch)
+			list_del(&batch->node);
+		prod = ipa_sim_client_pipe(IPA_CLIENT_WLAN1_PROD);
+		spin_unlock_bh(&ipa_sim_lock);
+
+		if (!batch)
+			break;
+
+		cnt = 0;
+		list_for_each_entry(desc, &batch->head->link, link) {
+			cnt++;
+			if ((ipa_sim.dp_seq++ % 100) >= ipa_sim_excp_pct)
+				continue;
+			skb = skb_clone(desc->priv, GFP_KERNEL);
+			if (skb)
+				__skb_queue_tail(&excp_q, skb);
+		}
+
+		spin_lock_bh(&ipa_sim_lock);
+		ipa_sim.wdi_stats.rx_ch_stats.num_pkts_processed += cnt;
+		if (cnt > ipa_sim.wdi_stats.rx_ch_stats.max_outstanding_pkts)
+			ipa_sim.wdi_stats.rx_ch_stats.max_outstanding_pkts = cnt;
+		spin_unlock_bh(&ipa_sim_lock);
+
+		/* the descriptors were consumed, hand them back first */
+		if (prod)
+			ipa_sim_notify(prod, IPA_WRITE_DONE,
+				       (unsigned long)batch->head);
+		kfree(batch);
+
+		while ((skb = __skb_dequeue(&excp_q)) != NULL) {
+			if (prod)
+				ipa_sim_notify(prod, IPA_RECEIVE,
+					       (unsigned long)skb);
+			else
+				dev_kfree_skb_any(skb);
+		}
+	}
+}
+
+int ipa_tx_dp_mul(enum ipa_client_type dst,
+		struct ipa_tx_data_desc *data_desc)
+{
+	struct ipa_sim_batch *batch;
+	struct ipa_sim_rm *rm = &ipa_sim.rm[IPA_RM_RESOURCE_WLAN_PROD];
+
+	if (!data_desc || dst != IPA_CLIENT_WLAN1_PROD)
+		return -EINVAL;
+
+	batch = kmalloc(sizeof(*batch), GFP_ATOMIC);
+	if (!batch)
+		return -ENOMEM;
+	batch->head = data_desc;
+
+	spin_lock_bh(&ipa_sim_lock);
+	if (!ipa_sim_client_pipe(dst)) {
+		spin_unlock_bh(&ipa_sim_lock);
+		kfree(batch);
+		return -EINVAL;
+	}
+	/*
+	 * The hardware would sit on the data until the grant arrives, count
+	 * it where the uC reports doorbells it did not expect.
+	 */
+	if (rm->created && !rm->granted)
+		ipa_sim.wdi_stats.rx_ch_stats.num_unexpected_db++;
+	list_add_tail(&batch->node, &ipa_sim_dp_q);
+	spin_unlock_bh(&ipa_sim_lock);
+
+	schedule_delayed_work(&ipa_sim_dp_work,
+			      usecs_to_jiffies(ipa_sim_dp_latency_us));
+	return 0;
+}
+
+void ipa_free_skb(struct ipa_rx_data *data)
+{
+	if (!data)
+		return;
+
+	dev_kfree_skb_any(data->skb);
+	kfree(data);
+}
+
+/**
+ * ipa_sim_rx_exception() - inject an exception packet
+ * @skb: packet laid out as IPA would deliver it on the WLAN1_PROD pipe
+ *
+ * With the uC data path the rx packets never go through ipa_tx_dp_mul(),
+ * load generators use this to drive the exception path instead.
+ *
+ * Return: 0 on success, skb is consumed either way
+ */
+int ipa_sim_rx_exception(struct sk_buff *skb)
+{
+	struct ipa_sim_pipe *prod;
+
+	spin_lock_bh(&ipa_sim_lock);
+	prod = ipa_sim_client_pipe(IPA_CLIENT_WLAN1_PROD);
+	spin_unlock_bh(&ipa_sim_lock);
+
+	if (!prod) {
+		dev_kfree_skb_any(skb);
+		return -ENODEV;
+	}
+
+	ipa_sim_notify(prod, IPA_RECEIVE, (unsigned long)skb);
+	return 0;
+}
+
+/*--------------------------------------------------------------------------
+Resource manager
+------------------------------------------------------------------------*/
+static void ipa_sim_rm_notify(enum ipa_rm_resource_name name,
+		enum ipa_rm_event event)
+{
+	struct ipa_rm_register_params reg;
+
+	spin_lock_bh(&ipa_sim_lock);
+	reg = ipa_sim.rm[name].params.reg_params;
+	spin_unlock_bh(&ipa_sim_lock);
+
+	if (reg.notify_cb)
+		reg.notify_cb(reg.user_data, event, 0);
+}
+
+/*
+ * Producer grants wait for the consumer they depend on. Consumers owned by
+ * other subsystems are not modelled and always available, consumers with a
+ * request_resource callback are asked and may finish later through
+ * ipa_rm_notify_completion().
+ */
+static void ipa_sim_rm_grant_work_fn(struct work_struct *work)
+{
+	struct ipa_sim_rm *rm = container_of(to_delayed_work(work),
+			struct ipa_sim_rm, grant_work);
+	enum ipa_rm_resource_name name = rm - ipa_sim.rm;
+	struct ipa_sim_rm *dep = NULL;
+	int ret = 0;
+
+	spin_lock_bh(&ipa_sim_lock);
+	if (!rm->grant_pending) {
+		spin_unlock_bh(&ipa_sim_lock);
+		return;
+	}
+	if (rm->has_dependency && ipa_sim.rm[rm->depends_on].created)
+		dep = &ipa_sim.rm[rm->depends_on];
+	spin_unlock_bh(&ipa_sim_lock);
+
+	if (dep && !dep->granted && dep->params.request_resource) {
+		ret = dep->params.request_resource();
+		if (ret == -EINPROGRESS)
+			return;
+		if (ret) {
+			IPA_SIM_LOG(VOS_TRACE_LEVEL_ERROR,
+				    "rm %d dependency %d failed: %d",
+				    name, rm->depends_on, ret);
+			spin_lock_bh(&ipa_sim_lock);
+			rm->grant_pending = false;
+			spin_unlock_bh(&ipa_sim_lock);
+			return;
+		}
+		spin_lock_bh(&ipa_sim_lock);
+		dep->granted = true;
+		spin_unlock_bh(&ipa_sim_lock);
+	}
+
+	spin_lock_bh(&ipa_sim_lock);
+	rm->grant_pending = false;
+	rm->granted = true;
+	spin_unlock_bh(&ipa_sim_lock);
+
+	ipa_sim_rm_notify(name, IPA_RM_RESOURCE_GRANTED);
+}
+
+static void ipa_sim_rm_inactivity_work_fn(struct work_struct *work)
+{
+	struct ipa_sim_rm *rm = container_of(to_delayed_work(work),
+			struct ipa_sim_rm, inactivity_work);
+
+	ipa_rm_release_resource(rm - ipa_sim.rm);
+}
+
+int ipa_rm_create_resource(struct ipa_rm_create_params *create_params)
+{
+	struct ipa_sim_rm *rm;
+
+	if (!create_params || create_params->name >= IPA_RM_RESOURCE_MAX)
+		return -EINVAL;
+
+	rm = &ipa_sim.rm[create_params->name];
+
+	spin_lock_bh(&ipa_sim_lock);
+	if (rm->created) {
+		spin_unlock_bh(&ipa_sim_lock);
+		return -EEXIST;
+	}
+	memset(rm, 0, sizeof(*rm));
+	rm->params = *create_params;
+	INIT_DELAYED_WORK(&rm->grant_work, ipa_sim_rm_grant_work_fn);
+	INIT_DELAYED_WORK(&rm->inactivity_work, ipa_sim_rm_inactivity_work_fn);
+	rm->created = true;
+	spin_unlock_bh(&ipa_sim_lock);
+
+	return 0;
+}
+
+int ipa_rm_delete_resource(enum ipa_rm_resource_name resource_name)
+{
+	struct ipa_sim_rm *rm;
+
+	if (resource_name >= IPA_RM_RESOURCE_MAX ||
+	    !ipa_sim.rm[resource_name].created)
+		return -EINVAL;
+
+	rm = &ipa_sim.rm[resource_name];
+	cancel_delayed_work_sync(&rm->inactivity_work);
+	cancel_delayed_work_sync(&rm->grant_work);
+
+	spin_lock_bh(&ipa_sim_lock);
+	rm->created = false;
+	rm->granted = false;
+	rm->grant_pending = false;
+	spin_unlock_bh(&ipa_sim_lock);
+
+	return 0;
+}
+
+int ipa_rm_add_dependency(enum ipa_rm_resource_name resource_name,
+		enum ipa_rm_resource_name depends_on_name)
+{
+	if (resource_name >= IPA_RM_RESOURCE_MAX ||
+	    depends_on_name >= IPA_RM_RESOURCE_MAX ||
+	    !ipa_sim.rm[resource_name].created)
+		return -EINVAL;
+
+	spin_lock_bh(&ipa_sim_lock);
+	ipa_sim.rm[resource_name].depends_on = depends_on_name;
+	ipa_sim.rm[resource_name].has_dependency = true;
+	spin_unlock_bh(&ipa_sim_lock);
+
+	return 0;
+}
+
+int ipa_rm_request_resource(enum ipa_rm_resource_name resource_name)
+{
+	struct ipa_sim_rm *rm;
+	bool start_grant = false;
+	int ret = -EINPROGRESS;
+
+	if (resource_name >= IPA_RM_RESOURCE_MAX)
+		return -EINVAL;
+
+	rm = &ipa_sim.rm[resource_name];
+
+	spin_lock_bh(&ipa_sim_lock);
+	if (!rm->created) {
+		ret = -EINVAL;
+	} else if (rm->granted) {
+		ret = 0;
+	} else if (!rm->grant_pending) {
+		rm->grant_pending = true;
+		start_grant = true;
+	}
+	spin_unlock_bh(&ipa_sim_lock);
+
+	if (start_grant)
+		schedule_delayed_work(&rm->grant_work,
+				      msecs_to_jiffies(ipa_sim_rm_grant_ms));
+	return ret;
+}
+
+int ipa_rm_release_resource(enum ipa_rm_resource_name resource_name)
+{
+	struct ipa_sim_rm *rm;
+	bool was_granted;
+
+	if (resource_name >= IPA_RM_RESOURCE_MAX ||
+	    !ipa_sim.rm[resource_name].created)
+		return -EINVAL;
+
+	rm = &ipa_sim.rm[resource_name];
+
+	spin_lock_bh(&ipa_sim_lock);
+	was_granted = rm->granted;
+	rm->granted = false;
+	rm->grant_pending = false;
+	spin_unlock_bh(&ipa_sim_lock);
+
+	if (was_granted)
+		ipa_sim_rm_notify(resource_name, IPA_RM_RESOURCE_RELEASED);
+	return 0;
+}
+
+int ipa_rm_notify_completion(enum ipa_rm_event event,
+		enum ipa_rm_resource_name resource_name)
+{
+	int i;
+
+	if (resource_name >= IPA_RM_RESOURCE_MAX ||
+	    !ipa_sim.rm[resource_name].created)
+		return -EINVAL;
+
+	spin_lock_bh(&ipa_sim_lock);
+	ipa_sim.rm[resource_name].granted = (event == IPA_RM_RESOURCE_GRANTED);
+	spin_unlock_bh(&ipa_sim_lock);
+
+	if (event != IPA_RM_RESOURCE_GRANTED)
+		return 0;
+
+	/* let the producers that waited on this consumer finish their grant */
+	for (i = 0; i < IPA_RM_RESOURCE_MAX; i++) {
+		struct ipa_sim_rm *rm = &ipa_sim.rm[i];
+
+		if (rm->created && rm->grant_pending && rm->has_dependency &&
+		    rm->depends_on == resource_name)
+			schedule_delayed_work(&rm->grant_work, 0);
+	}
+	return 0;
+}
+
+int ipa_rm_set_perf_profile(enum ipa_rm_resource_name resource_name,
+		struct ipa_rm_perf_profile *profile)
+{
+	if (resource_name >= IPA_RM_RESOURCE_MAX || !profile)
+		return -EINVAL;
+
+	spin_lock_bh(&ipa_sim_lock);
+	ipa_sim.rm[resource_name].bw_mbps =
+		profile->max_supported_bandwidth_mbps;
+	spin_unlock_bh(&ipa_sim_lock);
+
+	return 0;
+}
+
+int ipa_rm_inactivity_timer_init(enum ipa_rm_resource_name resource_name,
+		unsigned long msecs)
+{
+	if (resource_name >= IPA_RM_RESOURCE_MAX ||
+	    !ipa_sim.rm[resource_name].created)
+		return -EINVAL;
+
+	spin_lock_bh(&ipa_sim_lock);
+	ipa_sim.rm[resource_name].inactivity_msecs = msecs;
+	ipa_sim.rm[resource_name].timer_valid = true;
+	spin_unlock_bh(&ipa_sim_lock);
+
+	return 0;
+}
+
+int ipa_rm_inactivity_timer_destroy(enum ipa_rm_resource_name resource_name)
+{
+	if (resource_name >= IPA_RM_RESOURCE_MAX ||
+	    !ipa_sim.rm[resource_name].timer_valid)
+		return -EINVAL;
+
+	cancel_delayed_work_sync(&ipa_sim.rm[resource_name].inactivity_work);
+
+	spin_lock_bh(&ipa_sim_lock);
+	ipa_sim.rm[resource_name].timer_valid = false;
+	spin_unlock_bh(&ipa_sim_lock);
+
+	return 0;
+}
+
+int ipa_rm_inactivity_timer_request_resource(
+		enum ipa_rm_resource_name resource_name)
+{
+	if (resource_name >= IPA_RM_RESOURCE_MAX ||
+	    !ipa_sim.rm[resource_name].timer_valid)
+		return -EINVAL;
+
+	/* a request inside the inactivity window keeps the grant */
+	cancel_delayed_work(&ipa_sim.rm[resource_name].inactivity_work);
+
+	return ipa_rm_request_resource(resource_name);
+}
+
+int ipa_rm_inactivity_timer_release_resource(
+		enum ipa_rm_resource_name resource_name)
+{
+	struct ipa_sim_rm *rm;
+
+	if (resource_name >= IPA_RM_RESOURCE_MAX ||
+	    !ipa_sim.rm[resource_name].timer_valid)
+		return -EINVAL;
+
+	rm = &ipa_sim.rm[resource_name];
+	mod_delayed_work(system_wq, &rm->inactivity_work,
+			 msecs_to_jiffies(rm->inactivity_msecs));
+	return 0;
+}
+#endif /* IPA_OFFLOAD && IPA_SIM */
@@ -126,6 +126,8 @@ extern int hdd_hostapd_stop (struct net_device *dev);
 #include "if_usb.h"
 #elif defined(HIF_SDIO)
 #include "if_ath_sdio.h"
+#elif defined(HIF_SIM)
+#include "if_sim.h"
 #endif
 #include "wma.h"
 #include "ol_fw.h"
@@ -10685,6 +10687,7 @@ void hdd_cleanup_adapter(hdd_context_t *pHddCtx, hdd_adapter_t *pAdapter,
    }
 
     hdd_adapter_runtime_suspend_denit(pAdapter);
+    wlan_hdd_tsf_sync_deinit(pAdapter);
    /* The adapter is marked as closed. When hdd_wlan_exit() call returns,
     * the driver is almost closed and cannot handle either control
     * messages or data. However, unregister_netdevice() call above will
@@ -11229,6 +11232,7 @@ hdd_adapter_t* hdd_open_adapter( hdd_context_t *pHddCtx, tANI_U8 session_type,
 
       /* Adapter successfully added. Increment the vdev count  */
       pHddCtx->current_intf_count++;
+      wlan_hdd_tsf_sync_init(pAdapter);
 
       hddLog(VOS_TRACE_LEVEL_DEBUG,"%s: current_intf_count=%d", __func__,
                                     pHddCtx->current_intf_count);
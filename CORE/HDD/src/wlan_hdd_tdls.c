@@ -40,6 +40,10 @@
 #include <linux/netdevice.h>
 #include <linux/skbuff.h>
 #include <linux/list.h>
+#include <linux/rculist.h>
+#include <linux/percpu.h>
+#include <linux/jhash.h>
+#include <linux/random.h>
 #include <linux/etherdevice.h>
 #include <net/ieee80211_radiotap.h>
 #include "wlan_hdd_tdls.h"
@@ -82,15 +86,70 @@ static void wlan_hdd_tdls_determine_channel_opclass(hdd_context_t *hddctx,
 	}
 }
 
-static u8 wlan_hdd_tdls_hash_key (const u8 *mac)
+static u32 wlan_hdd_tdls_hash_key(tdlsCtx_t *pHddTdlsCtx, const u8 *mac)
 {
-    int i;
-    u8 key = 0;
+    return jhash(mac, VOS_MAC_ADDR_SIZE, pHddTdlsCtx->hash_seed) &
+           (TDLS_PEER_LIST_SIZE - 1);
+}
+
+static void wlan_hdd_tdls_peer_free_rcu(struct rcu_head *rcu)
+{
+    hddTdlsPeer_t *peer = container_of(rcu, hddTdlsPeer_t, rcu);
+
+    free_percpu(peer->traffic);
+    vos_mem_free(peer);
+}
+
+/* Caller has to take the lock; the data path may still be looking at the
+ * peer, so it is only freed after an RCU grace period
+ */
+static void wlan_hdd_tdls_peer_del(hddTdlsPeer_t *peer)
+{
+    list_del_rcu(&peer->node);
+    call_rcu(&peer->rcu, wlan_hdd_tdls_peer_free_rcu);
+}
+
+/* Caller has to take the lock before calling this function */
+static void wlan_hdd_tdls_peer_traffic_sum(hddTdlsPeer_t *peer,
+                                           u32 *tx_pkt, u32 *rx_pkt)
+{
+    struct hdd_tdls_peer_traffic *traffic;
+    int cpu;
+
+    *tx_pkt = 0;
+    *rx_pkt = 0;
+    for_each_possible_cpu(cpu) {
+        traffic = per_cpu_ptr(peer->traffic, cpu);
+        *tx_pkt += traffic->tx_pkt;
+        *rx_pkt += traffic->rx_pkt;
+    }
+}
 
-    for (i = 0; i < 6; i++)
-       key ^= mac[i];
+/**
+ * wlan_hdd_tdls_collect_traffic() - sum up peer traffic of the last period
+ * @pHddTdlsCtx: TDLS context
+ *
+ * Folds the per-CPU counters of every peer into tx_pkt/rx_pkt, which then
+ * hold the frames seen since the previous collection. Caller has to take
+ * the lock before calling this function.
+ *
+ * Return: none
+ */
+static void wlan_hdd_tdls_collect_traffic(tdlsCtx_t *pHddTdlsCtx)
+{
+    int i;
+    hddTdlsPeer_t *tmp;
+    u32 tx_pkt, rx_pkt;
 
-    return key;
+    for (i = 0; i < TDLS_PEER_LIST_SIZE; i++) {
+        list_for_each_entry(tmp, &pHddTdlsCtx->peer_list[i], node) {
+            wlan_hdd_tdls_peer_traffic_sum(tmp, &tx_pkt, &rx_pkt);
+            tmp->tx_pkt = tx_pkt - tmp->tx_pkt_base;
+            tmp->rx_pkt = rx_pkt - tmp->rx_pkt_base;
+            tmp->tx_pkt_base = tx_pkt;
+            tmp->rx_pkt_base = rx_pkt;
+        }
+    }
 }
 
 #ifdef FEATURE_WLAN_DIAG_SUPPORT
@@ -385,6 +444,8 @@ static v_VOID_t wlan_hdd_tdls_discovery_timeout_peer_cb(v_PVOID_t userData)
 
     mutex_lock(&pHddCtx->tdls_lock);
 
+    wlan_hdd_tdls_collect_traffic(pHddTdlsCtx);
+
     for (i = 0; i < TDLS_PEER_LIST_SIZE; i++) {
         head = &pHddTdlsCtx->peer_list[i];
         list_for_each_safe (pos, q, head) {
@@ -442,8 +503,7 @@ static void wlan_hdd_tdls_free_list(tdlsCtx_t *pHddTdlsCtx,
             /* Don't delete TDLS forced peers during STA disconnection */
             if (!del_forced_peer && tmp->isForcedPeer)
                 continue;
-            list_del(pos);
-            vos_mem_free(tmp);
+            wlan_hdd_tdls_peer_del(tmp);
             tmp = NULL;
         }
     }
@@ -546,6 +606,8 @@ int wlan_hdd_tdls_init(hdd_adapter_t *pAdapter)
         }
         /* initialize TDLS pAdater context */
         vos_mem_zero(pHddTdlsCtx, sizeof(tdlsCtx_t));
+        get_random_bytes(&pHddTdlsCtx->hash_seed,
+                         sizeof(pHddTdlsCtx->hash_seed));
 
         vos_timer_init(&pHddTdlsCtx->peerDiscoveryTimeoutTimer,
                 VOS_TIMER_TYPE_WAKE_APPS,
@@ -571,8 +633,7 @@ int wlan_hdd_tdls_init(hdd_adapter_t *pAdapter)
             list_for_each_safe(pos, q, head) {
                 tmp = list_entry(pos, hddTdlsPeer_t, node);
                 if (FALSE == tmp->isForcedPeer) {
-                    list_del(pos);
-                    vos_mem_free(tmp);
+                    wlan_hdd_tdls_peer_del(tmp);
                     tmp = NULL;
                 } else {
                     tmp->link_status = eTDLS_LINK_IDLE;
@@ -916,12 +977,18 @@ void wlan_hdd_tdls_exit(hdd_adapter_t *pAdapter)
     pHddTdlsCtx->magic = 0;
     pHddTdlsCtx->pAdapter = NULL;
 
-    vos_mem_free(pHddTdlsCtx);
     pAdapter->sessionCtx.station.pHddTdlsCtx = NULL;
-    pHddTdlsCtx = NULL;
 
     mutex_unlock(&pHddCtx->tdls_lock);
 
+    /* wait out data path readers of the context, and the peer frees
+     * queued by wlan_hdd_tdls_free_list()
+     */
+    synchronize_rcu();
+    rcu_barrier();
+    vos_mem_free(pHddTdlsCtx);
+    pHddTdlsCtx = NULL;
+
 done:
     clear_bit(TDLS_INIT_DONE, &pAdapter->event_flags);
 }
@@ -934,7 +1001,7 @@ hddTdlsPeer_t *wlan_hdd_tdls_get_peer(hdd_adapter_t *pAdapter, const u8 *mac)
 {
     struct list_head *head;
     hddTdlsPeer_t *peer;
-    u8 key;
+    u32 key;
     tdlsCtx_t *pHddTdlsCtx;
     hdd_context_t *pHddCtx = WLAN_HDD_GET_CTX(pAdapter);
 
@@ -954,22 +1021,31 @@ hddTdlsPeer_t *wlan_hdd_tdls_get_peer(hdd_adapter_t *pAdapter, const u8 *mac)
         hddLog(VOS_TRACE_LEVEL_ERROR, "%s peer malloc failed!", __func__);
         return NULL;
     }
+    vos_mem_zero(peer, sizeof(hddTdlsPeer_t));
+
+    peer->traffic = alloc_percpu(struct hdd_tdls_peer_traffic);
+    if (NULL == peer->traffic) {
+        vos_mem_free(peer);
+        hddLog(VOS_TRACE_LEVEL_ERROR, "%s peer traffic alloc failed!",
+               __func__);
+        return NULL;
+    }
 
     mutex_lock(&pHddCtx->tdls_lock);
 
     pHddTdlsCtx = WLAN_HDD_GET_TDLS_CTX_PTR(pAdapter);
 
     if (NULL == pHddTdlsCtx) {
+        free_percpu(peer->traffic);
         vos_mem_free(peer);
         mutex_unlock(&pHddCtx->tdls_lock);
         hddLog(LOG1, FL("pHddTdlsCtx is NULL"));
         return NULL;
     }
 
-    key = wlan_hdd_tdls_hash_key(mac);
+    key = wlan_hdd_tdls_hash_key(pHddTdlsCtx, mac);
     head = &pHddTdlsCtx->peer_list[key];
 
-    vos_mem_zero(peer, sizeof(hddTdlsPeer_t));
     vos_mem_copy(peer->peerMac, mac, sizeof(peer->peerMac));
     peer->pHddTdlsCtx = pHddTdlsCtx;
     peer->pref_off_chan_num = pHddCtx->cfg_ini->fTDLSPrefOffChanNum;
@@ -977,7 +1053,7 @@ hddTdlsPeer_t *wlan_hdd_tdls_get_peer(hdd_adapter_t *pAdapter, const u8 *mac)
           wlan_hdd_find_opclass(pHddCtx->hHal, peer->pref_off_chan_num,
                                 pHddCtx->cfg_ini->fTDLSPrefOffChanBandwidth);
 
-    list_add_tail(&peer->node, head);
+    list_add_tail_rcu(&peer->node, head);
     mutex_unlock(&pHddCtx->tdls_lock);
     return peer;
 }
@@ -1366,28 +1442,52 @@ void wlan_hdd_tdls_extract_sa(struct sk_buff *skb, u8 *mac)
     memcpy(mac, skb->data+6, 6);
 }
 
+/**
+ * wlan_hdd_tdls_increment_pkt_count() - count a data frame of a TDLS peer
+ * @pAdapter: HDD adapter
+ * @mac: peer MAC address
+ * @tx: frame was sent to the peer rather than received from it
+ *
+ * Called from hdd_hard_start_xmit() and hdd_rx_packet_cbk() for every
+ * unicast frame, so it neither takes tdls_lock nor creates peers: the
+ * lookup runs under RCU and only bumps this CPU's counter. The counters
+ * are summed by wlan_hdd_tdls_collect_traffic() when the implicit TDLS
+ * timer fires.
+ *
+ * Return: 0 if the peer is known, -1 otherwise
+ */
 int wlan_hdd_tdls_increment_pkt_count(hdd_adapter_t *pAdapter, const u8 *mac,
                                       u8 tx)
 {
     hddTdlsPeer_t *curr_peer;
+    tdlsCtx_t *pHddTdlsCtx;
     hdd_context_t *pHddCtx = WLAN_HDD_GET_CTX(pAdapter);
+    int ret = -1;
 
     if (eTDLS_SUPPORT_ENABLED != pHddCtx->tdls_mode &&
         eTDLS_SUPPORT_EXTERNAL_CONTROL != pHddCtx->tdls_mode)
         return -1;
 
-    curr_peer = wlan_hdd_tdls_get_peer(pAdapter, mac);
-    if (curr_peer == NULL) {
-        hddLog(LOG1, FL("curr_peer is NULL"));
-        return -1;
+    rcu_read_lock();
+    pHddTdlsCtx = WLAN_HDD_GET_TDLS_CTX_PTR(pAdapter);
+    if (NULL == pHddTdlsCtx)
+        goto out;
+
+    list_for_each_entry_rcu(curr_peer,
+            &pHddTdlsCtx->peer_list[wlan_hdd_tdls_hash_key(pHddTdlsCtx, mac)],
+            node) {
+        if (memcmp(mac, curr_peer->peerMac, VOS_MAC_ADDR_SIZE))
+            continue;
+        if (tx)
+            this_cpu_inc(curr_peer->traffic->tx_pkt);
+        else
+            this_cpu_inc(curr_peer->traffic->rx_pkt);
+        ret = 0;
+        break;
     }
-
-    if (tx)
-        curr_peer->tx_pkt++;
-    else
-        curr_peer->rx_pkt++;
-
-    return 0;
+out:
+    rcu_read_unlock();
+    return ret;
 }
 
 static int wlan_hdd_tdls_check_config(tdls_config_params_t *config)
@@ -1523,6 +1623,9 @@ static void wlan_tdd_tdls_reset_tx_rx(tdlsCtx_t *pHddTdlsCtx)
         head = &pHddTdlsCtx->peer_list[i];
         list_for_each_safe (pos, q, head) {
             tmp = list_entry(pos, hddTdlsPeer_t, node);
+            /* the per-CPU counters only grow, restart from their sums */
+            wlan_hdd_tdls_peer_traffic_sum(tmp, &tmp->tx_pkt_base,
+                                           &tmp->rx_pkt_base);
             tmp->tx_pkt = 0;
             tmp->rx_pkt = 0;
         }
@@ -2026,7 +2129,7 @@ hddTdlsPeer_t *wlan_hdd_tdls_find_peer(hdd_adapter_t *pAdapter,
                                        const u8 *mac,
                                        tANI_BOOLEAN mutexLock)
 {
-    u8 key;
+    u32 key;
     struct list_head *pos;
     struct list_head *head;
     hddTdlsPeer_t *curr_peer;
@@ -2050,7 +2153,7 @@ hddTdlsPeer_t *wlan_hdd_tdls_find_peer(hdd_adapter_t *pAdapter,
         return NULL;
     }
 
-    key = wlan_hdd_tdls_hash_key(mac);
+    key = wlan_hdd_tdls_hash_key(pHddTdlsCtx, mac);
 
     head = &pHddTdlsCtx->peer_list[key];
 
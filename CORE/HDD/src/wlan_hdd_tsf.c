@@ -29,8 +29,21 @@
  * wlan_hdd_tsf.c - WLAN Host Device Driver tsf related implementation
  */
 
+#include <linux/math64.h>
 #include "wlan_hdd_main.h"
+#include "wlan_hdd_tsf.h"
 #include "wma_api.h"
+#include "adf_os_time.h"
+
+/* a read whose round trip exceeds twice the floor plus this is dropped */
+#define HDD_TSF_SYNC_RTT_SLACK_US 200
+/* a prediction error above this means the TSF jumped, restart the model */
+#define HDD_TSF_SYNC_RESYNC_US 1000
+/* shortest span of samples the drift is estimated over */
+#define HDD_TSF_SYNC_MIN_SPAN_US 500000
+/* crystals are within a few tens of ppm, clamp anything beyond 200 ppm */
+#define HDD_TSF_SYNC_MAX_DRIFT_PPB 200000
+#define HDD_TSF_SYNC_NSEC_PER_SEC 1000000000LL
 
 /**
  * hdd_capture_tsf() - capture tsf
@@ -177,6 +190,534 @@ int hdd_indicate_tsf(hdd_adapter_t *adapter, uint32_t *buf, int len)
 	return ret;
 }
 
+
+/**
+ * hdd_tsf_sync_available() - whether the adapter has a TSF to follow
+ * @adapter: pointer to adapter
+ *
+ * Return: true if the vdev is associated or beaconing
+ */
+static bool hdd_tsf_sync_available(hdd_adapter_t *adapter)
+{
+	hdd_station_ctx_t *hdd_sta_ctx;
+
+	if (adapter->device_mode == WLAN_HDD_INFRA_STATION ||
+		adapter->device_mode == WLAN_HDD_P2P_CLIENT) {
+		hdd_sta_ctx = WLAN_HDD_GET_STATION_CTX_PTR(adapter);
+		return hdd_sta_ctx->conn_info.connState ==
+			eConnectionState_Associated;
+	}
+	if (adapter->device_mode == WLAN_HDD_SOFTAP ||
+		adapter->device_mode == WLAN_HDD_P2P_GO)
+		return test_bit(SOFTAP_BSS_STARTED, &adapter->event_flags);
+
+	return false;
+}
+
+/* caller holds the write side of tsf_sync->lock */
+static void hdd_tsf_sync_reset_model(struct hdd_tsf_sync *tsf_sync)
+{
+	tsf_sync->valid = false;
+	tsf_sync->drift_ppb = 0;
+	tsf_sync->sample_idx = 0;
+	tsf_sync->sample_cnt = 0;
+	tsf_sync->rtt_floor_us = 0;
+}
+
+/* caller is inside a read or write section of tsf_sync->lock */
+static uint64_t hdd_tsf_sync_predict(struct hdd_tsf_sync *tsf_sync,
+				     uint64_t host_us)
+{
+	int64_t dt = (int64_t)(host_us - tsf_sync->ref_host_us);
+
+	return tsf_sync->ref_tsf + dt +
+		div_s64(dt * tsf_sync->drift_ppb, HDD_TSF_SYNC_NSEC_PER_SEC);
+}
+
+/**
+ * hdd_tsf_sync_update_drift() - re-estimate the drift from a new sample
+ * @tsf_sync: clock model of the adapter
+ * @host_us: host time of the new sample
+ * @tsf: TSF of the new sample
+ *
+ * The rate is measured against the oldest sample in the ring so a single
+ * noisy read moves the estimate by little, and it is then smoothed.
+ *
+ * Return: none
+ */
+static void hdd_tsf_sync_update_drift(struct hdd_tsf_sync *tsf_sync,
+				      uint64_t host_us, uint64_t tsf)
+{
+	struct hdd_tsf_sync_sample *oldest;
+	int64_t dhost, dtsf, ppb;
+
+	if (!tsf_sync->sample_cnt)
+		return;
+
+	if (tsf_sync->sample_cnt < HDD_TSF_SYNC_SAMPLES)
+		oldest = &tsf_sync->samples[0];
+	else
+		oldest = &tsf_sync->samples[tsf_sync->sample_idx];
+
+	dhost = (int64_t)(host_us - oldest->host_us);
+	if (dhost < HDD_TSF_SYNC_MIN_SPAN_US)
+		return;
+	dtsf = (int64_t)(tsf - oldest->tsf);
+
+	ppb = div64_s64((dtsf - dhost) * HDD_TSF_SYNC_NSEC_PER_SEC, dhost);
+	if (ppb > HDD_TSF_SYNC_MAX_DRIFT_PPB)
+		ppb = HDD_TSF_SYNC_MAX_DRIFT_PPB;
+	else if (ppb < -HDD_TSF_SYNC_MAX_DRIFT_PPB)
+		ppb = -HDD_TSF_SYNC_MAX_DRIFT_PPB;
+
+	tsf_sync->drift_ppb += (int32_t)(ppb - tsf_sync->drift_ppb) / 4;
+}
+
+/**
+ * hdd_tsf_sync_sample() - feed one TSF read into the clock model
+ * @adapter: pointer to adapter
+ * @ptsf: report of the read, with the host times around it
+ *
+ * The read is taken to have happened halfway through its round trip, so
+ * reads with a long round trip are dropped as too uncertain. The model
+ * is pulled a quarter of the way towards each accepted sample.
+ *
+ * Return: none
+ */
+static void hdd_tsf_sync_sample(hdd_adapter_t *adapter, struct stsf *ptsf)
+{
+	struct hdd_tsf_sync *tsf_sync = &adapter->tsf_sync;
+	struct hdd_tsf_sync_stats *stats = &tsf_sync->stats;
+	uint64_t tsf = ((uint64_t)ptsf->tsf_high << 32) | ptsf->tsf_low;
+	uint64_t host_us, pred;
+	uint32_t rtt, abs_err;
+	int64_t err;
+	int bin;
+
+	if (ptsf->host_rsp_us < ptsf->host_req_us)
+		return;
+	rtt = (uint32_t)(ptsf->host_rsp_us - ptsf->host_req_us);
+	host_us = ptsf->host_req_us + rtt / 2;
+
+	write_seqlock_bh(&tsf_sync->lock);
+	tsf_sync->read_pending = false;
+
+	if (!stats->rtt_min_us || rtt < stats->rtt_min_us)
+		stats->rtt_min_us = rtt;
+	if (rtt > stats->rtt_max_us)
+		stats->rtt_max_us = rtt;
+	stats->rtt_total_us += rtt;
+
+	if (!tsf_sync->rtt_floor_us || rtt < tsf_sync->rtt_floor_us) {
+		tsf_sync->rtt_floor_us = rtt;
+	} else if (rtt > 2 * tsf_sync->rtt_floor_us +
+		   HDD_TSF_SYNC_RTT_SLACK_US) {
+		/* let the floor follow a lasting rise of the bus latency */
+		tsf_sync->rtt_floor_us += tsf_sync->rtt_floor_us / 8 + 1;
+		stats->rejected_rtt++;
+		goto out;
+	}
+
+	if (tsf_sync->valid) {
+		pred = hdd_tsf_sync_predict(tsf_sync, host_us);
+		err = (int64_t)(tsf - pred);
+		abs_err = err < 0 ? (uint32_t)min_t(uint64_t, -err, U32_MAX) :
+				    (uint32_t)min_t(uint64_t, err, U32_MAX);
+
+		if (abs_err > HDD_TSF_SYNC_RESYNC_US) {
+			stats->resyncs++;
+			hdd_tsf_sync_reset_model(tsf_sync);
+			tsf_sync->rtt_floor_us = rtt;
+		} else {
+			stats->last_err_us = (int32_t)err;
+			if (abs_err > stats->max_err_us)
+				stats->max_err_us = abs_err;
+			stats->abs_err_total_us += abs_err;
+			bin = fls(abs_err);
+			if (bin >= HDD_TSF_SYNC_ERR_HIST_BINS)
+				bin = HDD_TSF_SYNC_ERR_HIST_BINS - 1;
+			stats->err_hist[bin]++;
+
+			hdd_tsf_sync_update_drift(tsf_sync, host_us, tsf);
+			tsf_sync->ref_tsf = pred + err / 4;
+			tsf_sync->ref_host_us = host_us;
+		}
+	}
+
+	if (!tsf_sync->valid) {
+		tsf_sync->ref_tsf = tsf;
+		tsf_sync->ref_host_us = host_us;
+		tsf_sync->valid = true;
+	}
+
+	tsf_sync->samples[tsf_sync->sample_idx].host_us = host_us;
+	tsf_sync->samples[tsf_sync->sample_idx].tsf = tsf;
+	tsf_sync->sample_idx = (tsf_sync->sample_idx + 1) %
+		HDD_TSF_SYNC_SAMPLES;
+	if (tsf_sync->sample_cnt < HDD_TSF_SYNC_SAMPLES)
+		tsf_sync->sample_cnt++;
+	stats->samples++;
+out:
+	write_sequnlock_bh(&tsf_sync->lock);
+}
+
+/**
+ * hdd_tsf_sync_work() - periodic TSF read of one adapter
+ * @work: tsf_sync.work of the adapter
+ *
+ * Return: none
+ */
+static void hdd_tsf_sync_work(struct work_struct *work)
+{
+	struct hdd_tsf_sync *tsf_sync = container_of(to_delayed_work(work),
+						     struct hdd_tsf_sync, work);
+	hdd_adapter_t *adapter = container_of(tsf_sync, hdd_adapter_t,
+					      tsf_sync);
+	hdd_context_t *hdd_ctx = WLAN_HDD_GET_CTX(adapter);
+	int ret;
+
+	if (hdd_ctx->isUnloadInProgress)
+		return;
+	if (hdd_ctx->isLogpInProgress || hdd_ctx->isLoadInProgress)
+		goto resched;
+
+	/* BSS start completes before SOFTAP_BSS_STARTED is set */
+	if (!hdd_tsf_sync_available(adapter))
+		goto resched;
+
+	write_seqlock_bh(&tsf_sync->lock);
+	if (tsf_sync->read_pending)
+		tsf_sync->stats.lost++;
+	tsf_sync->read_pending = true;
+	tsf_sync->stats.reads++;
+	write_sequnlock_bh(&tsf_sync->lock);
+
+	ret = process_wma_set_command((int)adapter->sessionId,
+			(int)GEN_PARAM_READ_TSF,
+			adapter->sessionId,
+			GEN_CMD);
+	if (ret) {
+		hddLog(VOS_TRACE_LEVEL_ERROR, FL("read tsf fail, ret = %d"),
+			ret);
+		write_seqlock_bh(&tsf_sync->lock);
+		tsf_sync->read_pending = false;
+		write_sequnlock_bh(&tsf_sync->lock);
+	}
+
+resched:
+	write_seqlock_bh(&tsf_sync->lock);
+	if (tsf_sync->running)
+		schedule_delayed_work(&tsf_sync->work,
+			msecs_to_jiffies(hdd_ctx->cfg_ini->tsf_sync_period));
+	write_sequnlock_bh(&tsf_sync->lock);
+}
+
+/**
+ * wlan_hdd_tsf_sync_init() - set up the TSF clock model of an adapter
+ * @adapter: pointer to adapter
+ *
+ * Does nothing unless gTsfSyncPeriodMs is set. The periodic read only
+ * runs between wlan_hdd_tsf_sync_start() and wlan_hdd_tsf_sync_stop().
+ *
+ * Return: none
+ */
+void wlan_hdd_tsf_sync_init(hdd_adapter_t *adapter)
+{
+	hdd_context_t *hdd_ctx = WLAN_HDD_GET_CTX(adapter);
+	struct hdd_tsf_sync *tsf_sync = &adapter->tsf_sync;
+
+	if (!hdd_ctx->cfg_ini->tsf_sync_period || tsf_sync->initialized)
+		return;
+
+	vos_mem_zero(tsf_sync, sizeof(*tsf_sync));
+	seqlock_init(&tsf_sync->lock);
+	INIT_DELAYED_WORK(&tsf_sync->work, hdd_tsf_sync_work);
+	tsf_sync->initialized = true;
+}
+
+/**
+ * wlan_hdd_tsf_sync_start() - start the periodic TSF read of an adapter
+ * @adapter: pointer to adapter
+ *
+ * Called once the station is associated or the BSS has started. The
+ * model starts over from the first read.
+ *
+ * Return: none
+ */
+void wlan_hdd_tsf_sync_start(hdd_adapter_t *adapter)
+{
+	hdd_context_t *hdd_ctx = WLAN_HDD_GET_CTX(adapter);
+	struct hdd_tsf_sync *tsf_sync = &adapter->tsf_sync;
+
+	if (!tsf_sync->initialized)
+		return;
+
+	write_seqlock_bh(&tsf_sync->lock);
+	if (!tsf_sync->running) {
+		hdd_tsf_sync_reset_model(tsf_sync);
+		tsf_sync->read_pending = false;
+		tsf_sync->running = true;
+		schedule_delayed_work(&tsf_sync->work,
+			msecs_to_jiffies(hdd_ctx->cfg_ini->tsf_sync_period));
+	}
+	write_sequnlock_bh(&tsf_sync->lock);
+}
+
+/**
+ * wlan_hdd_tsf_sync_stop() - stop the periodic TSF read of an adapter
+ * @adapter: pointer to adapter
+ *
+ * Called on disconnect or BSS stop. Does not wait for a read that is
+ * already running, that one sees the model stopped and does not
+ * reschedule itself.
+ *
+ * Return: none
+ */
+void wlan_hdd_tsf_sync_stop(hdd_adapter_t *adapter)
+{
+	struct hdd_tsf_sync *tsf_sync = &adapter->tsf_sync;
+
+	if (!tsf_sync->initialized)
+		return;
+
+	write_seqlock_bh(&tsf_sync->lock);
+	if (tsf_sync->running) {
+		tsf_sync->running = false;
+		cancel_delayed_work(&tsf_sync->work);
+		hdd_tsf_sync_reset_model(tsf_sync);
+		tsf_sync->read_pending = false;
+	}
+	write_sequnlock_bh(&tsf_sync->lock);
+}
+
+/**
+ * wlan_hdd_tsf_sync_deinit() - stop following the TSF of an adapter
+ * @adapter: pointer to adapter
+ *
+ * Return: none
+ */
+void wlan_hdd_tsf_sync_deinit(hdd_adapter_t *adapter)
+{
+	struct hdd_tsf_sync *tsf_sync = &adapter->tsf_sync;
+
+	if (!tsf_sync->initialized)
+		return;
+
+	write_seqlock_bh(&tsf_sync->lock);
+	tsf_sync->running = false;
+	write_sequnlock_bh(&tsf_sync->lock);
+	cancel_delayed_work_sync(&tsf_sync->work);
+	write_seqlock_bh(&tsf_sync->lock);
+	hdd_tsf_sync_reset_model(tsf_sync);
+	tsf_sync->read_pending = false;
+	write_sequnlock_bh(&tsf_sync->lock);
+	tsf_sync->initialized = false;
+}
+
+/**
+ * hdd_tsf_host_to_tsf() - convert a host time to the TSF of an adapter
+ * @adapter: pointer to adapter
+ * @host_us: host monotonic time in us, as from adf_os_get_monotonic_us()
+ * @tsf: filled with the TSF at @host_us
+ *
+ * Lock-free, callable from process or softirq context.
+ *
+ * Return: 0 on success, -EAGAIN if there is no model yet
+ */
+int hdd_tsf_host_to_tsf(hdd_adapter_t *adapter, uint64_t host_us,
+			uint64_t *tsf)
+{
+	struct hdd_tsf_sync *tsf_sync = &adapter->tsf_sync;
+	unsigned int seq;
+	bool valid;
+
+	if (!tsf_sync->initialized)
+		return -EAGAIN;
+
+	do {
+		seq = read_seqbegin(&tsf_sync->lock);
+		valid = tsf_sync->valid;
+		if (valid)
+			*tsf = hdd_tsf_sync_predict(tsf_sync, host_us);
+	} while (read_seqretry(&tsf_sync->lock, seq));
+
+	return valid ? 0 : -EAGAIN;
+}
+
+/**
+ * hdd_tsf_to_host() - convert a TSF of an adapter to host time
+ * @adapter: pointer to adapter
+ * @tsf: TSF value
+ * @host_us: filled with the host monotonic time in us at @tsf
+ *
+ * Lock-free, callable from process or softirq context.
+ *
+ * Return: 0 on success, -EAGAIN if there is no model yet
+ */
+int hdd_tsf_to_host(hdd_adapter_t *adapter, uint64_t tsf, uint64_t *host_us)
+{
+	struct hdd_tsf_sync *tsf_sync = &adapter->tsf_sync;
+	unsigned int seq;
+	bool valid;
+	int64_t dt;
+
+	if (!tsf_sync->initialized)
+		return -EAGAIN;
+
+	do {
+		seq = read_seqbegin(&tsf_sync->lock);
+		valid = tsf_sync->valid;
+		if (valid) {
+			dt = (int64_t)(tsf - tsf_sync->ref_tsf);
+			*host_us = tsf_sync->ref_host_us + dt -
+				div_s64(dt * tsf_sync->drift_ppb,
+					HDD_TSF_SYNC_NSEC_PER_SEC);
+		}
+	} while (read_seqretry(&tsf_sync->lock, seq));
+
+	return valid ? 0 : -EAGAIN;
+}
+
+/**
+ * hdd_tsf32_to_host() - convert the low 32 bits of a recent TSF to host time
+ * @adapter: pointer to adapter
+ * @tsf32: low 32 bits of the TSF, as carried in rx/tx descriptors
+ * @host_us: filled with the host monotonic time in us at @tsf32
+ *
+ * The upper bits are taken from the model's current TSF, so @tsf32 must
+ * be within about 35 minutes of now.
+ *
+ * Return: 0 on success, -EAGAIN if there is no model yet
+ */
+int hdd_tsf32_to_host(hdd_adapter_t *adapter, uint32_t tsf32,
+		      uint64_t *host_us)
+{
+	uint64_t now_tsf, tsf;
+	int ret;
+
+	ret = hdd_tsf_host_to_tsf(adapter, adf_os_get_monotonic_us(),
+				  &now_tsf);
+	if (ret)
+		return ret;
+
+	tsf = (now_tsf & ~0xffffffffULL) | tsf32;
+	if (tsf > now_tsf + 0x80000000ULL && tsf >= 0x100000000ULL)
+		tsf -= 0x100000000ULL;
+	else if (tsf + 0x80000000ULL < now_tsf)
+		tsf += 0x100000000ULL;
+
+	return hdd_tsf_to_host(adapter, tsf, host_us);
+}
+
+/**
+ * hdd_indicate_sync_tsf() - return the current tsf from the clock model
+ *
+ * @adapter: pointer to adapter
+ * @buf: pointer to uplayer buf
+ * @len : the length of buf
+ *
+ * Unlike hdd_indicate_tsf() this needs no capture beforehand and does not
+ * wait for firmware.
+ *
+ * Return: Describe the execute result of this routine
+ */
+int hdd_indicate_sync_tsf(hdd_adapter_t *adapter, uint32_t *buf, int len)
+{
+	uint64_t tsf;
+
+	if (adapter == NULL || buf == NULL) {
+		hddLog(VOS_TRACE_LEVEL_ERROR,
+			FL("invalid pointer"));
+		return -EINVAL;
+	}
+
+	if (len != 3)
+		return -EINVAL;
+
+	buf[1] = 0;
+	buf[2] = 0;
+	if (hdd_tsf_host_to_tsf(adapter, adf_os_get_monotonic_us(), &tsf)) {
+		hddLog(VOS_TRACE_LEVEL_INFO, FL("no synced tsf"));
+		buf[0] = TSF_NOT_RETURNED_BY_FW;
+		return 0;
+	}
+
+	buf[0] = TSF_RETURN;
+	buf[1] = (uint32_t)tsf;
+	buf[2] = (uint32_t)(tsf >> 32);
+	return 0;
+}
+
+/**
+ * hdd_tsf_sync_display() - print the accuracy of the clock model
+ * @adapter: pointer to adapter
+ *
+ * Return: none
+ */
+void hdd_tsf_sync_display(hdd_adapter_t *adapter)
+{
+	struct hdd_tsf_sync *tsf_sync = &adapter->tsf_sync;
+	struct hdd_tsf_sync_stats stats;
+	uint64_t ref_host_us = 0, ref_tsf = 0;
+	int32_t drift_ppb = 0;
+	uint32_t rtt_floor_us = 0;
+	bool valid = false;
+	unsigned int seq;
+	int i;
+
+	if (!tsf_sync->initialized) {
+		hddLog(VOS_TRACE_LEVEL_ERROR, FL("tsf sync is not enabled"));
+		return;
+	}
+
+	do {
+		seq = read_seqbegin(&tsf_sync->lock);
+		valid = tsf_sync->valid;
+		ref_host_us = tsf_sync->ref_host_us;
+		ref_tsf = tsf_sync->ref_tsf;
+		drift_ppb = tsf_sync->drift_ppb;
+		rtt_floor_us = tsf_sync->rtt_floor_us;
+		stats = tsf_sync->stats;
+	} while (read_seqretry(&tsf_sync->lock, seq));
+
+	hddLog(LOGE, "TSF sync vdev %u: valid %d ref_host %llu us ref_tsf %llu drift %d ppb",
+		adapter->sessionId, valid, ref_host_us, ref_tsf, drift_ppb);
+	hddLog(LOGE, "reads %u samples %u rejected(rtt) %u lost %u resyncs %u",
+		stats.reads, stats.samples, stats.rejected_rtt, stats.lost,
+		stats.resyncs);
+	hddLog(LOGE, "rtt min %u max %u avg %llu floor %u us",
+		stats.rtt_min_us, stats.rtt_max_us,
+		stats.samples + stats.rejected_rtt ?
+		div_u64(stats.rtt_total_us,
+			stats.samples + stats.rejected_rtt) : 0,
+		rtt_floor_us);
+	hddLog(LOGE, "err last %d max %u avg %llu us",
+		stats.last_err_us, stats.max_err_us,
+		stats.samples ?
+		div_u64(stats.abs_err_total_us, stats.samples) : 0);
+	for (i = 0; i < HDD_TSF_SYNC_ERR_HIST_BINS; i++)
+		hddLog(LOGE, "err < %u us: %u",
+			1 << i, stats.err_hist[i]);
+}
+
+/**
+ * hdd_tsf_sync_clear() - clear the accuracy statistics of the clock model
+ * @adapter: pointer to adapter
+ *
+ * Return: none
+ */
+void hdd_tsf_sync_clear(hdd_adapter_t *adapter)
+{
+	struct hdd_tsf_sync *tsf_sync = &adapter->tsf_sync;
+
+	if (!tsf_sync->initialized)
+		return;
+
+	write_seqlock_bh(&tsf_sync->lock);
+	vos_mem_zero(&tsf_sync->stats, sizeof(tsf_sync->stats));
+	write_sequnlock_bh(&tsf_sync->lock);
+}
+
 /**
  * hdd_get_tsf_cb() - handle tsf callback
  *
@@ -219,6 +760,13 @@ static int hdd_get_tsf_cb(void *pcb_cxt, struct stsf *ptsf)
 		FL("tsf cb handle event, device_mode is %d"),
 		adapter->device_mode);
 
+	/* periodic reads feed the clock model, only captures are kept */
+	if (ptsf->req_type == TSF_REQ_READ) {
+		if (adapter->tsf_sync.initialized)
+			hdd_tsf_sync_sample(adapter, ptsf);
+		return 0;
+	}
+
 	adapter->tsf_low = ptsf->tsf_low;
 	adapter->tsf_high = ptsf->tsf_high;
 
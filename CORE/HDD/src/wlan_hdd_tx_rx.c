@@ -532,6 +532,13 @@ int __hdd_hard_start_xmit(struct sk_buff *skb, struct net_device *dev)
 
        vdev_handle = vdev_temp;
 
+#ifdef FEATURE_WLAN_TDLS
+       /* traffic towards a TDLS peer feeds the implicit setup */
+       if (!vos_is_macaddr_group(pDestMacAddress))
+           wlan_hdd_tdls_increment_pkt_count(pAdapter,
+                                             pDestMacAddress->bytes, 1);
+#endif
+
 #ifdef QCA_LL_TX_FLOW_CT
        if ((pAdapter->hdd_stats.hddTxRxStats.is_txflow_paused != TRUE) &&
             VOS_FALSE ==
@@ -1217,6 +1224,9 @@ VOS_STATUS hdd_rx_packet_cbk(v_VOID_t *vosContext,
 #ifdef QCA_PKT_PROTO_TRACE
    v_U8_t proto_type;
 #endif /* QCA_PKT_PROTO_TRACE */
+#ifdef FEATURE_WLAN_TDLS
+   u8 mac[VOS_MAC_ADDR_SIZE];
+#endif
    hdd_station_ctx_t *pHddStaCtx = NULL;
 
    //Sanity check on inputs
@@ -1299,6 +1309,12 @@ VOS_STATUS hdd_rx_packet_cbk(v_VOID_t *vosContext,
       }
 #endif /* QCA_PKT_PROTO_TRACE */
 
+#ifdef FEATURE_WLAN_TDLS
+      wlan_hdd_tdls_extract_sa(skb, mac);
+      if (!vos_is_macaddr_group((v_MACADDR_t *)mac))
+         wlan_hdd_tdls_increment_pkt_count(pAdapter, mac, 0);
+#endif
+
       skb->dev = pAdapter->dev;
       skb->protocol = eth_type_trans(skb, skb->dev);
 
@@ -73,6 +73,7 @@
 #include "ol_if_athvar.h"
 #include "dbglog_host.h"
 #include "wma.h"
+#include "wma_api.h"
 
 #ifdef CONFIG_HAS_EARLYSUSPEND
 #include <linux/earlysuspend.h>
@@ -410,6 +411,7 @@ static const hdd_freq_chan_map_t freq_chan_map[] = { {2412, 1}, {2417, 2},
 
 #define WLAN_PRIV_SET_NONE_GET_THREE_INT   (SIOCIWFIRSTPRIV + 15)
 #define WE_GET_TSF      1
+#define WE_GET_SYNC_TSF 2
 
 /* (SIOCIWFIRSTPRIV + 17) is currently unused */
 /* (SIOCIWFIRSTPRIV + 19) is currently unused */
@@ -818,6 +820,18 @@ void hdd_wlan_dump_stats(hdd_adapter_t *pAdapter, int value)
         case WLAN_HDD_NETIF_OPER_HISTORY:
             wlan_hdd_display_netif_queue_history(hdd_ctx);
             break;
+        case WLAN_VOS_MC_MQ_STATS:
+            vos_mq_dump_mc_stats();
+            break;
+        case WLAN_WMI_RX_EVENT_STATS:
+            wma_display_wmi_rx_event_stats();
+            break;
+        case WLAN_TSF_SYNC_STATS:
+            hdd_tsf_sync_display(pAdapter);
+            break;
+        case WLAN_MGMT_RX_BATCH_STATS:
+            WLANTL_display_mgmt_rx_batch_stats(hdd_ctx->pvosContext);
+            break;
         default:
             WLANTL_display_datapath_stats(hdd_ctx->pvosContext, value);
             break;
@@ -6719,6 +6733,18 @@ static int __iw_setint_getnone(struct net_device *dev,
              case WLAN_HDD_NETIF_OPER_HISTORY:
                  wlan_hdd_clear_netif_queue_history(hdd_ctx);
                  break;
+             case WLAN_VOS_MC_MQ_STATS:
+                 vos_mq_clear_mc_stats();
+                 break;
+             case WLAN_WMI_RX_EVENT_STATS:
+                 wma_clear_wmi_rx_event_stats();
+                 break;
+             case WLAN_TSF_SYNC_STATS:
+                 hdd_tsf_sync_clear(pAdapter);
+                 break;
+             case WLAN_MGMT_RX_BATCH_STATS:
+                 WLANTL_clear_mgmt_rx_batch_stats(hdd_ctx->pvosContext);
+                 break;
              default:
                  WLANTL_clear_datapath_stats(hdd_ctx->pvosContext, set_value);
                  break;
@@ -7250,6 +7276,9 @@ static int __iw_setnone_get_threeint(struct net_device *dev,
 	case WE_GET_TSF:
 		ret = hdd_indicate_tsf(adapter, value, 3);
 		break;
+	case WE_GET_SYNC_TSF:
+		ret = hdd_indicate_sync_tsf(adapter, value, 3);
+		break;
 	default:
 		hddLog(VOS_TRACE_LEVEL_ERROR,
 			FL("Invalid IOCTL get_value command %d"),
@@ -11974,6 +12003,10 @@ static const struct iw_priv_args we_private_args[] = {
         0,
         IW_PRIV_TYPE_INT | IW_PRIV_SIZE_FIXED | 3,
         "get_tsf" },
+    {   WE_GET_SYNC_TSF,
+        0,
+        IW_PRIV_TYPE_INT | IW_PRIV_SIZE_FIXED | 3,
+        "get_sync_tsf" },
 #endif
     /* handlers for main ioctl */
     {   WLAN_PRIV_GET_CHAR_SET_NONE,
@@ -1140,6 +1140,8 @@ typedef struct sMacOpenParameters
     bool is_nan_enabled;
 #endif
     uint16_t  max_mgmt_tx_fail_count;
+    uint32_t  fw_stats_push_period;
+    uint32_t  wmi_rx_event_prio;
     bool force_target_assert_enabled;
     uint16_t pkt_bundle_timer_value;
     uint16_t pkt_bundle_size;
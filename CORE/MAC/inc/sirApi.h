@@ -6384,12 +6384,28 @@ struct sblock_info {
 	uint32_t block_duration;
 };
 
+/**
+ * enum stsf_req_type - the request a tsf report answers
+ * @TSF_REQ_UNKNOWN: no outstanding request was found for the report
+ * @TSF_REQ_CAPTURE: GPIO capture
+ * @TSF_REQ_READ: plain read, as sent by the TSF sync
+ */
+enum stsf_req_type {
+	TSF_REQ_UNKNOWN,
+	TSF_REQ_CAPTURE,
+	TSF_REQ_READ,
+};
+
 /**
  * struct stsf - the basic stsf structure
  *
  * @vdev_id: vdev id
  * @tsf_low: low 32bits of tsf
  * @tsf_high: high 32bits of tsf
+ * @req_type: enum stsf_req_type of the request the report answers
+ * @host_req_us: host monotonic time the request was sent at, 0 if
+ *	@req_type is TSF_REQ_UNKNOWN
+ * @host_rsp_us: host monotonic time the event was received at
  *
  * driver use this struct to store the tsf info
  */
@@ -6397,6 +6413,9 @@ struct stsf {
 	uint32_t vdev_id;
 	uint32_t tsf_low;
 	uint32_t tsf_high;
+	uint8_t req_type;
+	uint64_t host_req_us;
+	uint64_t host_rsp_us;
 };
 
 /**
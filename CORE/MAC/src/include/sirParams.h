@@ -804,7 +804,8 @@ typedef struct sSirMbMsgP2p
 #define SIR_LIM_RETRY_INTERRUPT_MSG        (SIR_LIM_ITC_MSG_TYPES_BEGIN + 3)
 // Message from BB Transport
 #define SIR_BB_XPORT_MGMT_MSG              (SIR_LIM_ITC_MSG_TYPES_BEGIN + 4)
-// UNUSED                                  SIR_LIM_ITC_MSG_TYPES_BEGIN + 6
+// Batch of management frames from BB Transport
+#define SIR_BB_XPORT_MGMT_BATCH_MSG        (SIR_LIM_ITC_MSG_TYPES_BEGIN + 6)
 // Message from ISR upon SP's Invalid session key interrupt
 #define SIR_LIM_INV_KEY_INTERRUPT_MSG      (SIR_LIM_ITC_MSG_TYPES_BEGIN + 7)
 // Message from ISR upon SP's Invalid key ID interrupt
@@ -257,6 +257,11 @@ tSirRetStatus peProcessMessages(tpAniSirGlobal pMac, tSirMsgQ* pMsg);
 -----------------------------------------------------------------*/
 v_VOID_t peFreeMsg( tpAniSirGlobal pMac, tSirMsgQ* pMsg);
 
+#ifdef WLAN_FEATURE_MGMT_RX_BATCH
+/* Process a SIR_BB_XPORT_MGMT_BATCH_MSG from TL one frame at a time */
+void peProcessMgmtFrameBatch(tpAniSirGlobal pMac, tpSirMsgQ pMsg);
+#endif
+
 /*--------------------------------------------------------------------------
 
   \brief limRemainOnChnRsp() - API for sending remain on channel response.
@@ -1093,6 +1093,13 @@ v_VOID_t peFreeMsg( tpAniSirGlobal pMac, tSirMsgQ* pMsg)
             {
                 vos_pkt_return_packet((vos_pkt_t *)pMsg->bodyptr);
             }
+#ifdef WLAN_FEATURE_MGMT_RX_BATCH
+            else if (SIR_BB_XPORT_MGMT_BATCH_MSG == pMsg->type)
+            {
+                WLANTL_MgmtRxBatchFree(
+                        (WLANTL_MgmtRxBatchType *)pMsg->bodyptr);
+            }
+#endif
             else
             {
                 vos_mem_free((v_VOID_t*)pMsg->bodyptr);
@@ -1277,45 +1284,35 @@ tSirRetStatus peProcessMessages(tpAniSirGlobal pMac, tSirMsgQ* pMsg)
 
 // ---------------------------------------------------------------------------
 /**
- * peHandleMgmtFrame
+ * peRxMgmtFrame
  *
  * FUNCTION:
- *    Process the Management frames from TL
+ *    Hand one Management frame from TL over to MAC
  *
  * LOGIC:
+ *    Frames delivered one at a time are posted to the PE queue. Frames of
+ *    a batch are already being processed from the PE queue and go to LIM
+ *    directly.
  *
- * ASSUMPTIONS: TL sends the packet along with the VOS GlobalContext
+ * ASSUMPTIONS:
  *
  * NOTE:
+ *    The packet is returned on failure
  *
- * @param pvosGCtx  Global Vos Context
- * @param vossBuff  Packet
+ * @param pMac      Pointer to Global MAC structure
+ * @param pVosPkt   Packet
+ * @param inPeCtx   Frame comes from a batch processed in PE context
  * @return None
  */
 
-VOS_STATUS peHandleMgmtFrame( v_PVOID_t pvosGCtx, v_PVOID_t vosBuff)
+static VOS_STATUS peRxMgmtFrame(tpAniSirGlobal pMac, vos_pkt_t *pVosPkt,
+                                tANI_BOOLEAN inPeCtx)
 {
-    tpAniSirGlobal  pMac;
     tpSirMacMgmtHdr mHdr;
     tSirMsgQ        msg;
-    vos_pkt_t      *pVosPkt;
     VOS_STATUS      vosStatus;
     v_U8_t         *pRxPacketInfo;
-
-    pVosPkt = (vos_pkt_t *)vosBuff;
-    if (NULL == pVosPkt)
-    {
-        return VOS_STATUS_E_FAILURE;
-    }
-
-    pMac = (tpAniSirGlobal)vos_get_context(VOS_MODULE_ID_PE, pvosGCtx);
-    if (NULL == pMac)
-    {
-        // cannot log a failure without a valid pMac
-        vos_pkt_return_packet(pVosPkt);
-        pVosPkt = NULL;
-        return VOS_STATUS_E_FAILURE;
-    }
+    tSirRetStatus   ret;
 
     vosStatus = WDA_DS_PeekRxPacketInfo( pVosPkt, (void *)&pRxPacketInfo, VOS_FALSE );
 
@@ -1358,13 +1355,18 @@ VOS_STATUS peHandleMgmtFrame( v_PVOID_t pvosGCtx, v_PVOID_t vosBuff)
 
     // Forward to MAC via mesg = SIR_BB_XPORT_MGMT_MSG
     msg.type = SIR_BB_XPORT_MGMT_MSG;
-    msg.bodyptr = vosBuff;
+    msg.bodyptr = pVosPkt;
     msg.bodyval = 0;
 
-    if( eSIR_SUCCESS != sysBbtProcessMessageCore( pMac,
-                                                  &msg,
-                                                  mHdr->fc.type,
-                                                  mHdr->fc.subType ))
+#ifdef WLAN_FEATURE_MGMT_RX_BATCH
+    if (inPeCtx)
+        ret = sysBbtProcessBatchedFrame(pMac, &msg, mHdr->fc.type,
+                                        mHdr->fc.subType);
+    else
+#endif
+        ret = sysBbtProcessMessageCore(pMac, &msg, mHdr->fc.type,
+                                       mHdr->fc.subType);
+    if (eSIR_SUCCESS != ret)
     {
         vos_pkt_return_packet(pVosPkt);
         pVosPkt = NULL;
@@ -1374,6 +1376,109 @@ VOS_STATUS peHandleMgmtFrame( v_PVOID_t pvosGCtx, v_PVOID_t vosBuff)
     return  VOS_STATUS_SUCCESS;
 }
 
+// ---------------------------------------------------------------------------
+/**
+ * peHandleMgmtFrame
+ *
+ * FUNCTION:
+ *    Process the Management frames from TL
+ *
+ * LOGIC:
+ *
+ * ASSUMPTIONS: TL sends the packet along with the VOS GlobalContext
+ *
+ * NOTE:
+ *
+ * @param pvosGCtx  Global Vos Context
+ * @param vossBuff  Packet
+ * @return None
+ */
+
+VOS_STATUS peHandleMgmtFrame( v_PVOID_t pvosGCtx, v_PVOID_t vosBuff)
+{
+    tpAniSirGlobal  pMac;
+    vos_pkt_t      *pVosPkt;
+
+    pVosPkt = (vos_pkt_t *)vosBuff;
+    if (NULL == pVosPkt)
+    {
+        return VOS_STATUS_E_FAILURE;
+    }
+
+    pMac = (tpAniSirGlobal)vos_get_context(VOS_MODULE_ID_PE, pvosGCtx);
+    if (NULL == pMac)
+    {
+        // cannot log a failure without a valid pMac
+        vos_pkt_return_packet(pVosPkt);
+        pVosPkt = NULL;
+        return VOS_STATUS_E_FAILURE;
+    }
+
+    return peRxMgmtFrame(pMac, pVosPkt, eANI_BOOLEAN_FALSE);
+}
+
+#ifdef WLAN_FEATURE_MGMT_RX_BATCH
+/**
+ * peHandleMgmtFrameBatch() - queue a batch of management frames from TL
+ * @pvosGCtx: global vos context
+ * @pBatch: batch of received beacons and probe responses
+ *
+ * The whole batch is posted to the PE queue as one message, so a burst of
+ * scan results costs one message wrapper instead of one per frame. If the
+ * batch cannot be posted it is left to TL to free.
+ *
+ * Return: VOS_STATUS_SUCCESS if the batch was posted
+ */
+static VOS_STATUS peHandleMgmtFrameBatch(v_PVOID_t pvosGCtx,
+                                         WLANTL_MgmtRxBatchType *pBatch)
+{
+    tpAniSirGlobal pMac;
+    tSirMsgQ       msg;
+
+    pMac = (tpAniSirGlobal)vos_get_context(VOS_MODULE_ID_PE, pvosGCtx);
+    if (NULL == pMac)
+        return VOS_STATUS_E_FAILURE;
+
+    msg.type = SIR_BB_XPORT_MGMT_BATCH_MSG;
+    msg.bodyptr = pBatch;
+    msg.bodyval = 0;
+
+    if (eSIR_SUCCESS != limPostMsgApi(pMac, &msg))
+    {
+        limLog(pMac, LOGE, FL("posting batch of %u frames failed"),
+               pBatch->uNumFrames);
+        return VOS_STATUS_E_FAILURE;
+    }
+
+    return VOS_STATUS_SUCCESS;
+}
+
+/**
+ * peProcessMgmtFrameBatch() - process a batch of management frames
+ * @pMac: Pointer to Global MAC structure
+ * @pMsg: SIR_BB_XPORT_MGMT_BATCH_MSG message
+ *
+ * Each frame of the batch goes through the same checks and LIM handling,
+ * deferral included, as a frame delivered on its own.
+ *
+ * Return: None
+ */
+void peProcessMgmtFrameBatch(tpAniSirGlobal pMac, tpSirMsgQ pMsg)
+{
+    WLANTL_MgmtRxBatchType *pBatch = pMsg->bodyptr;
+    vos_pkt_t              *pVosPkt;
+
+    pMsg->bodyptr = NULL;
+    if (NULL == pBatch)
+        return;
+
+    while ((pVosPkt = WLANTL_MgmtRxBatchNext(pBatch)) != NULL)
+        peRxMgmtFrame(pMac, pVosPkt, eANI_BOOLEAN_TRUE);
+
+    WLANTL_MgmtRxBatchFree(pBatch);
+}
+#endif /* WLAN_FEATURE_MGMT_RX_BATCH */
+
 // ---------------------------------------------------------------------------
 /**
  * peRegisterTLHandle
@@ -1401,6 +1506,11 @@ void peRegisterTLHandle(tpAniSirGlobal pMac)
 
     if (retStatus != VOS_STATUS_SUCCESS)
         limLog( pMac, LOGP, FL("Registering the PE Handle with TL has failed bailing out..."));
+#ifdef WLAN_FEATURE_MGMT_RX_BATCH
+    else if (WLANTL_RegisterMgmtFrmBatchClient(pvosGCTx,
+                                  peHandleMgmtFrameBatch) != VOS_STATUS_SUCCESS)
+        limLog(pMac, LOGE, FL("Batched mgmt frame delivery not available"));
+#endif
 
 }
 
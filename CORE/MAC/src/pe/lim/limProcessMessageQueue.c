@@ -1101,6 +1101,15 @@ void limMessageProcessor(tpAniSirGlobal pMac, tpSirMsgQ limMsg)
         return;
     }
 
+#ifdef WLAN_FEATURE_MGMT_RX_BATCH
+    /* Frames of a batch are deferred one by one, never the whole batch */
+    if (SIR_BB_XPORT_MGMT_BATCH_MSG == limMsg->type)
+    {
+        peProcessMgmtFrameBatch(pMac, limMsg);
+        return;
+    }
+#endif
+
     if (!defMsgDecision(pMac, limMsg))
     {
         limProcessMessages(pMac, limMsg);
@@ -562,6 +562,97 @@ v_U8_t sapSelectPreferredChannelFromChannelList(v_U8_t bestChNum,
 }
 
 
+/**
+ * sap_build_ch_idx() - build the channel number to spectrum index map
+ * @spect_info: spectrum info whose pSpectCh array has been filled
+ *
+ * The map keeps first-match semantics, i.e. it returns the same entry a
+ * linear walk of pSpectCh would, including for the zeroed slots of
+ * channels that were not considered for ACS. It must be rebuilt every
+ * time the pSpectCh array is reordered.
+ *
+ * Return: none
+ */
+static void sap_build_ch_idx(tSapChSelSpectInfo *spect_info)
+{
+    int i;
+
+    vos_mem_set(spect_info->chIdx, sizeof(spect_info->chIdx),
+                SAP_CH_IDX_INVALID);
+    for (i = spect_info->numSpectChans - 1; i >= 0; i--) {
+        if (spect_info->pSpectCh[i].chNum < SAP_CH_IDX_TBL_SIZE)
+            spect_info->chIdx[spect_info->pSpectCh[i].chNum] = i;
+    }
+}
+
+/**
+ * sap_get_spect_ch_idx() - look up a channel in the spectrum array
+ * @spect_info: spectrum info
+ * @ch_num: channel number to look up
+ *
+ * Return: index of @ch_num in pSpectCh, or numSpectChans if not present
+ */
+static inline v_U8_t sap_get_spect_ch_idx(tSapChSelSpectInfo *spect_info,
+                                          v_U16_t ch_num)
+{
+    if (ch_num >= SAP_CH_IDX_TBL_SIZE ||
+        spect_info->chIdx[ch_num] == SAP_CH_IDX_INVALID)
+        return spect_info->numSpectChans;
+
+    return spect_info->chIdx[ch_num];
+}
+
+/**
+ * sap_get_bss_chan_width() - get the operating width of a scanned BSS
+ * @mac_ctx: mac global context
+ * @bss_desc: BSS descriptor from the ACS scan result
+ * @ch_width: filled with the BSS channel width
+ * @sec_ch_offset: filled with the HT secondary channel offset
+ * @center_freq: filled with the VHT80 center channel, 0 otherwise
+ *
+ * ACS only needs three fields out of the beacon, so locate the HT
+ * capabilities, HT operation and VHT operation IEs directly instead of
+ * unpacking every IE into a tSirProbeRespBeacon for each scan result.
+ * The output matches what sirParseBeaconIE() based decoding produced
+ * for well formed IEs; outputs are left untouched otherwise.
+ *
+ * Return: none
+ */
+static void sap_get_bss_chan_width(tpAniSirGlobal mac_ctx,
+                                   tSirBssDescription *bss_desc,
+                                   v_U16_t *ch_width,
+                                   v_U16_t *sec_ch_offset,
+                                   v_U16_t *center_freq)
+{
+    v_U8_t *ies = (v_U8_t *)bss_desc->ieFields;
+    v_U32_t ie_len;
+    v_U8_t *ht_cap, *ht_info, *vht_op;
+
+    ie_len = bss_desc->length + sizeof(tANI_U16) + sizeof(tANI_U32) -
+             sizeof(tSirBssDescription);
+
+    ht_cap = limGetIEPtr(mac_ctx, ies, ie_len, DOT11F_EID_HTCAPS, ONE_BYTE);
+    if (!ht_cap || ht_cap[1] < DOT11F_IE_HTCAPS_MIN_LEN)
+        return;
+    ht_info = limGetIEPtr(mac_ctx, ies, ie_len, DOT11F_EID_HTINFO, ONE_BYTE);
+    if (!ht_info || ht_info[1] < DOT11F_IE_HTINFO_MIN_LEN)
+        return;
+
+    /* HT capability info bit 1 and HT operation info byte 1 bits 0-1 */
+    *ch_width = (ht_cap[2] >> 1) & 0x1;
+    *sec_ch_offset = ht_info[3] & 0x3;
+
+    vht_op = limGetIEPtr(mac_ctx, ies, ie_len, DOT11F_EID_VHTOPERATION,
+                         ONE_BYTE);
+    if (!vht_op || vht_op[1] < DOT11F_IE_VHTOPERATION_MIN_LEN)
+        return;
+
+    if (vht_op[2] > WNI_CFG_VHT_CHANNEL_WIDTH_20_40MHZ) {
+        *ch_width = eHT_CHANNEL_WIDTH_80MHZ;
+        *center_freq = vht_op[3];
+    }
+}
+
 /*==========================================================================
   FUNCTION    sapChanSelInit
 
@@ -686,6 +777,7 @@ v_BOOL_t sapChanSelInit(tHalHandle halHandle,
             pSpectCh->channelWidth = SOFTAP_HT20_CHANNELWIDTH; // Initialise 20MHz for all the Channels
         }
     }
+    sap_build_ch_idx(pSpectInfoParams);
     return eSAP_TRUE;
 }
 
@@ -1628,21 +1720,11 @@ void sapComputeSpectWeight( tSapChSelSpectInfo* pSpectInfoParams,
     v_U16_t channelWidth;
     v_U16_t secondaryChannelOffset;
     v_U16_t centerFreq;
-    v_U16_t vhtSupport;
-    v_U32_t ieLen = 0;
-    tSirProbeRespBeacon *pBeaconStruct;
     tpAniSirGlobal  pMac = (tpAniSirGlobal) halHandle;
     tSapSpectChInfo *pSpectChStartAddr = pSpectInfoParams->pSpectCh;
     tSapSpectChInfo *pSpectChEndAddr =
                     pSpectInfoParams->pSpectCh + pSpectInfoParams->numSpectChans;
 
-    pBeaconStruct = vos_mem_malloc(sizeof(tSirProbeRespBeacon));
-    if ( NULL == pBeaconStruct )
-    {
-        VOS_TRACE(VOS_MODULE_ID_SAP, VOS_TRACE_LEVEL_INFO_HIGH,
-                   "Unable to allocate memory in sapComputeSpectWeight");
-        return;
-    }
     VOS_TRACE( VOS_MODULE_ID_SAP, VOS_TRACE_LEVEL_INFO_HIGH, "In %s, Computing spectral weight", __func__);
 
     /**
@@ -1653,106 +1735,49 @@ void sapComputeSpectWeight( tSapChSelSpectInfo* pSpectInfoParams,
     pScanResult = sme_ScanResultGetFirst(halHandle, pResult);
 
     while (pScanResult) {
-        pSpectCh = pSpectInfoParams->pSpectCh;
         // Defining the default values, so that any value will hold the default values
         channelWidth = eHT_CHANNEL_WIDTH_20MHZ;
         secondaryChannelOffset = PHY_SINGLE_CHANNEL_CENTERED;
-        vhtSupport = 0;
         centerFreq = 0;
 
-        ieLen = (pScanResult->BssDescriptor.length + sizeof(tANI_U16) + sizeof(tANI_U32) - sizeof(tSirBssDescription));
-        vos_mem_set((tANI_U8 *) pBeaconStruct, sizeof(tSirProbeRespBeacon), 0);
+        sap_get_bss_chan_width(pMac, &pScanResult->BssDescriptor,
+                               &channelWidth, &secondaryChannelOffset,
+                               &centerFreq);
 
-        if ((sirParseBeaconIE(pMac, pBeaconStruct,(tANI_U8 *)( pScanResult->BssDescriptor.ieFields), ieLen)) == eSIR_SUCCESS)
-        {
-            if (pBeaconStruct->HTCaps.present && pBeaconStruct->HTInfo.present)
-            {
-                channelWidth = pBeaconStruct->HTCaps.supportedChannelWidthSet;
-                secondaryChannelOffset = pBeaconStruct->HTInfo.secondaryChannelOffset;
-                if(pBeaconStruct->VHTOperation.present)
-                {
-                    vhtSupport = pBeaconStruct->VHTOperation.present;
-                    if(pBeaconStruct->VHTOperation.chanWidth > WNI_CFG_VHT_CHANNEL_WIDTH_20_40MHZ)
-                    {
-                        channelWidth = eHT_CHANNEL_WIDTH_80MHZ;
-                        centerFreq = pBeaconStruct->VHTOperation.chanCenterFreqSeg1;
-                    }
-                }
-            }
-        }
-        // Processing for each tCsrScanResultInfo in the tCsrScanResult DLink list
-        for (chn_num = 0; chn_num < pSpectInfoParams->numSpectChans; chn_num++) {
-
-            /*
-             *  if the Beacon has channel ID, use it other wise we will
-             *  rely on the channelIdSelf
-             */
-            if(pScanResult->BssDescriptor.channelId == 0)
-                channel_id = pScanResult->BssDescriptor.channelIdSelf;
-            else
-                channel_id = pScanResult->BssDescriptor.channelId;
-
-            if (pSpectCh && (channel_id == pSpectCh->chNum)) {
-                if (pSpectCh->rssiAgr < pScanResult->BssDescriptor.rssi)
-                    pSpectCh->rssiAgr = pScanResult->BssDescriptor.rssi;
-
-                ++pSpectCh->bssCount; // Increment the count of BSS
-
-                if(operatingBand) // Connsidering the Extension Channel only in a channels
-                {
-                    /* Updating the received ChannelWidth */
-                    if (pSpectCh->channelWidth != channelWidth)
-                        pSpectCh->channelWidth = channelWidth;
-                    /* If received ChannelWidth is other than HT20, we need to update the extension channel Params as well */
-                    /* channelWidth == 0, HT20 */
-                    /* channelWidth == 1, HT40 */
-                    /* channelWidth == 2, VHT80*/
-                    switch(pSpectCh->channelWidth)
-                    {
-                        case eHT_CHANNEL_WIDTH_40MHZ: //HT40
-                            switch( secondaryChannelOffset)
-                            {
-                                tSapSpectChInfo *pExtSpectCh = NULL;
-                                case PHY_DOUBLE_CHANNEL_LOW_PRIMARY: // Above the Primary Channel
-                                    pExtSpectCh = (pSpectCh + 1);
-                                    if( pExtSpectCh != NULL &&
-                                       (pExtSpectCh >= pSpectChStartAddr &&
-                                        pExtSpectCh < pSpectChEndAddr))
-                                    {
-                                        ++pExtSpectCh->bssCount;
-                                        rssi = pSpectCh->rssiAgr + SAP_SUBBAND1_RSSI_EFFECT_PRIMARY;
-                                        // REducing the rssi by -20 and assigning it to Extension channel
-                                        if (IS_RSSI_VALID(pExtSpectCh->rssiAgr, rssi))
-                                        {
-                                            pExtSpectCh->rssiAgr = rssi;
-                                        }
-                                        if(pExtSpectCh->rssiAgr < SOFTAP_MIN_RSSI)
-                                            pExtSpectCh->rssiAgr = SOFTAP_MIN_RSSI;
-                                    }
-                                break;
+        /*
+         *  if the Beacon has channel ID, use it other wise we will
+         *  rely on the channelIdSelf
+         */
+        if(pScanResult->BssDescriptor.channelId == 0)
+            channel_id = pScanResult->BssDescriptor.channelIdSelf;
+        else
+            channel_id = pScanResult->BssDescriptor.channelId;
 
-                                case PHY_DOUBLE_CHANNEL_HIGH_PRIMARY: // Below the Primary channel
-                                    pExtSpectCh = (pSpectCh - 1);
-                                    if( pExtSpectCh != NULL &&
-                                       (pExtSpectCh >= pSpectChStartAddr &&
-                                        pExtSpectCh < pSpectChEndAddr))
-                                    {
-                                        rssi = pSpectCh->rssiAgr + SAP_SUBBAND1_RSSI_EFFECT_PRIMARY;
-                                        if (IS_RSSI_VALID(pExtSpectCh->rssiAgr, rssi))
-                                        {
-                                            pExtSpectCh->rssiAgr = rssi;
-                                        }
-                                        if(pExtSpectCh->rssiAgr < SOFTAP_MIN_RSSI)
-                                            pExtSpectCh->rssiAgr = SOFTAP_MIN_RSSI;
-                                        ++pExtSpectCh->bssCount;
-                                    }
-                                break;
-                            }
-                        break;
-                        case eHT_CHANNEL_WIDTH_80MHZ: // VHT80
-                            if((centerFreq - channel_id) == 6)
-                            {
-                                tSapSpectChInfo *pExtSpectCh = NULL;
+        // Processing for each tCsrScanResultInfo in the tCsrScanResult DLink list
+        chn_num = sap_get_spect_ch_idx(pSpectInfoParams, channel_id);
+        if (chn_num < pSpectInfoParams->numSpectChans) {
+            pSpectCh = pSpectInfoParams->pSpectCh + chn_num;
+            if (pSpectCh->rssiAgr < pScanResult->BssDescriptor.rssi)
+                pSpectCh->rssiAgr = pScanResult->BssDescriptor.rssi;
+
+            ++pSpectCh->bssCount; // Increment the count of BSS
+
+            if(operatingBand) // Connsidering the Extension Channel only in a channels
+            {
+                /* Updating the received ChannelWidth */
+                if (pSpectCh->channelWidth != channelWidth)
+                    pSpectCh->channelWidth = channelWidth;
+                /* If received ChannelWidth is other than HT20, we need to update the extension channel Params as well */
+                /* channelWidth == 0, HT20 */
+                /* channelWidth == 1, HT40 */
+                /* channelWidth == 2, VHT80*/
+                switch(pSpectCh->channelWidth)
+                {
+                    case eHT_CHANNEL_WIDTH_40MHZ: //HT40
+                        switch( secondaryChannelOffset)
+                        {
+                            tSapSpectChInfo *pExtSpectCh = NULL;
+                            case PHY_DOUBLE_CHANNEL_LOW_PRIMARY: // Above the Primary Channel
                                 pExtSpectCh = (pSpectCh + 1);
                                 if( pExtSpectCh != NULL &&
                                    (pExtSpectCh >= pSpectChStartAddr &&
@@ -1760,202 +1785,235 @@ void sapComputeSpectWeight( tSapChSelSpectInfo* pSpectInfoParams,
                                 {
                                     ++pExtSpectCh->bssCount;
                                     rssi = pSpectCh->rssiAgr + SAP_SUBBAND1_RSSI_EFFECT_PRIMARY;
+                                    // REducing the rssi by -20 and assigning it to Extension channel
                                     if (IS_RSSI_VALID(pExtSpectCh->rssiAgr, rssi))
                                     {
-                                        pExtSpectCh->rssiAgr = rssi; // Reducing the rssi by -20 and assigning it to Subband 1
+                                        pExtSpectCh->rssiAgr = rssi;
                                     }
                                     if(pExtSpectCh->rssiAgr < SOFTAP_MIN_RSSI)
                                         pExtSpectCh->rssiAgr = SOFTAP_MIN_RSSI;
                                 }
-                                pExtSpectCh = (pSpectCh + 2);
+                            break;
+
+                            case PHY_DOUBLE_CHANNEL_HIGH_PRIMARY: // Below the Primary channel
+                                pExtSpectCh = (pSpectCh - 1);
                                 if( pExtSpectCh != NULL &&
                                    (pExtSpectCh >= pSpectChStartAddr &&
                                     pExtSpectCh < pSpectChEndAddr))
                                 {
-                                    ++pExtSpectCh->bssCount;
-                                    rssi = pSpectCh->rssiAgr + SAP_SUBBAND2_RSSI_EFFECT_PRIMARY;
+                                    rssi = pSpectCh->rssiAgr + SAP_SUBBAND1_RSSI_EFFECT_PRIMARY;
                                     if (IS_RSSI_VALID(pExtSpectCh->rssiAgr, rssi))
                                     {
-                                        pExtSpectCh->rssiAgr = rssi; // Reducing the rssi by -30 and assigning it to Subband 2
+                                        pExtSpectCh->rssiAgr = rssi;
                                     }
                                     if(pExtSpectCh->rssiAgr < SOFTAP_MIN_RSSI)
                                         pExtSpectCh->rssiAgr = SOFTAP_MIN_RSSI;
+                                    ++pExtSpectCh->bssCount;
                                 }
-                                pExtSpectCh = (pSpectCh + 3);
-                                if( pExtSpectCh != NULL &&
-                                   (pExtSpectCh >= pSpectChStartAddr &&
-                                    pExtSpectCh < pSpectChEndAddr))
+                            break;
+                        }
+                    break;
+                    case eHT_CHANNEL_WIDTH_80MHZ: // VHT80
+                        if((centerFreq - channel_id) == 6)
+                        {
+                            tSapSpectChInfo *pExtSpectCh = NULL;
+                            pExtSpectCh = (pSpectCh + 1);
+                            if( pExtSpectCh != NULL &&
+                               (pExtSpectCh >= pSpectChStartAddr &&
+                                pExtSpectCh < pSpectChEndAddr))
+                            {
+                                ++pExtSpectCh->bssCount;
+                                rssi = pSpectCh->rssiAgr + SAP_SUBBAND1_RSSI_EFFECT_PRIMARY;
+                                if (IS_RSSI_VALID(pExtSpectCh->rssiAgr, rssi))
                                 {
-                                    ++pExtSpectCh->bssCount;
-                                    rssi = pSpectCh->rssiAgr + SAP_SUBBAND3_RSSI_EFFECT_PRIMARY;
-                                    if (IS_RSSI_VALID(pExtSpectCh->rssiAgr, rssi))
-                                    {
-                                        pExtSpectCh->rssiAgr = rssi; // Reducing the rssi by -40 and assigning it to Subband 3
-                                    }
-                                    if(pExtSpectCh->rssiAgr < SOFTAP_MIN_RSSI)
-                                        pExtSpectCh->rssiAgr = SOFTAP_MIN_RSSI;
+                                    pExtSpectCh->rssiAgr = rssi; // Reducing the rssi by -20 and assigning it to Subband 1
                                 }
+                                if(pExtSpectCh->rssiAgr < SOFTAP_MIN_RSSI)
+                                    pExtSpectCh->rssiAgr = SOFTAP_MIN_RSSI;
                             }
-                            else if((centerFreq - channel_id) == 2)
+                            pExtSpectCh = (pSpectCh + 2);
+                            if( pExtSpectCh != NULL &&
+                               (pExtSpectCh >= pSpectChStartAddr &&
+                                pExtSpectCh < pSpectChEndAddr))
                             {
-                                tSapSpectChInfo *pExtSpectCh = NULL;
-                                pExtSpectCh = (pSpectCh - 1 );
-                                if( pExtSpectCh != NULL &&
-                                   (pExtSpectCh >= pSpectChStartAddr &&
-                                    pExtSpectCh < pSpectChEndAddr))
+                                ++pExtSpectCh->bssCount;
+                                rssi = pSpectCh->rssiAgr + SAP_SUBBAND2_RSSI_EFFECT_PRIMARY;
+                                if (IS_RSSI_VALID(pExtSpectCh->rssiAgr, rssi))
                                 {
-                                    ++pExtSpectCh->bssCount;
-                                    rssi = pSpectCh->rssiAgr + SAP_SUBBAND1_RSSI_EFFECT_PRIMARY;
-                                    if (IS_RSSI_VALID(pExtSpectCh->rssiAgr, rssi))
-                                    {
-                                        pExtSpectCh->rssiAgr = rssi;
-                                    }
-                                    if(pExtSpectCh->rssiAgr < SOFTAP_MIN_RSSI)
-                                        pExtSpectCh->rssiAgr = SOFTAP_MIN_RSSI;
+                                    pExtSpectCh->rssiAgr = rssi; // Reducing the rssi by -30 and assigning it to Subband 2
                                 }
-                                pExtSpectCh = (pSpectCh + 1);
-                                if( pExtSpectCh != NULL &&
-                                   (pExtSpectCh >= pSpectChStartAddr &&
-                                    pExtSpectCh < pSpectChEndAddr))
+                                if(pExtSpectCh->rssiAgr < SOFTAP_MIN_RSSI)
+                                    pExtSpectCh->rssiAgr = SOFTAP_MIN_RSSI;
+                            }
+                            pExtSpectCh = (pSpectCh + 3);
+                            if( pExtSpectCh != NULL &&
+                               (pExtSpectCh >= pSpectChStartAddr &&
+                                pExtSpectCh < pSpectChEndAddr))
+                            {
+                                ++pExtSpectCh->bssCount;
+                                rssi = pSpectCh->rssiAgr + SAP_SUBBAND3_RSSI_EFFECT_PRIMARY;
+                                if (IS_RSSI_VALID(pExtSpectCh->rssiAgr, rssi))
                                 {
-                                    ++pExtSpectCh->bssCount;
-                                    rssi = pSpectCh->rssiAgr + SAP_SUBBAND1_RSSI_EFFECT_PRIMARY;
-                                    if (IS_RSSI_VALID(pExtSpectCh->rssiAgr, rssi))
-                                    {
-                                        pExtSpectCh->rssiAgr = rssi;
-                                    }
-                                    if(pExtSpectCh->rssiAgr < SOFTAP_MIN_RSSI)
-                                        pExtSpectCh->rssiAgr = SOFTAP_MIN_RSSI;
+                                    pExtSpectCh->rssiAgr = rssi; // Reducing the rssi by -40 and assigning it to Subband 3
                                 }
-                                pExtSpectCh = (pSpectCh + 2);
-                                if( pExtSpectCh != NULL &&
-                                   (pExtSpectCh >= pSpectChStartAddr &&
-                                    pExtSpectCh < pSpectChEndAddr))
+                                if(pExtSpectCh->rssiAgr < SOFTAP_MIN_RSSI)
+                                    pExtSpectCh->rssiAgr = SOFTAP_MIN_RSSI;
+                            }
+                        }
+                        else if((centerFreq - channel_id) == 2)
+                        {
+                            tSapSpectChInfo *pExtSpectCh = NULL;
+                            pExtSpectCh = (pSpectCh - 1 );
+                            if( pExtSpectCh != NULL &&
+                               (pExtSpectCh >= pSpectChStartAddr &&
+                                pExtSpectCh < pSpectChEndAddr))
+                            {
+                                ++pExtSpectCh->bssCount;
+                                rssi = pSpectCh->rssiAgr + SAP_SUBBAND1_RSSI_EFFECT_PRIMARY;
+                                if (IS_RSSI_VALID(pExtSpectCh->rssiAgr, rssi))
                                 {
-                                    ++pExtSpectCh->bssCount;
-                                    rssi = pSpectCh->rssiAgr + SAP_SUBBAND2_RSSI_EFFECT_PRIMARY;
-                                    if (IS_RSSI_VALID(pExtSpectCh->rssiAgr, rssi))
-                                    {
-                                        pExtSpectCh->rssiAgr = rssi;
-                                    }
-                                    if(pExtSpectCh->rssiAgr < SOFTAP_MIN_RSSI)
-                                        pExtSpectCh->rssiAgr = SOFTAP_MIN_RSSI;
+                                    pExtSpectCh->rssiAgr = rssi;
                                 }
+                                if(pExtSpectCh->rssiAgr < SOFTAP_MIN_RSSI)
+                                    pExtSpectCh->rssiAgr = SOFTAP_MIN_RSSI;
                             }
-                            else if((centerFreq - channel_id) == -2)
+                            pExtSpectCh = (pSpectCh + 1);
+                            if( pExtSpectCh != NULL &&
+                               (pExtSpectCh >= pSpectChStartAddr &&
+                                pExtSpectCh < pSpectChEndAddr))
                             {
-                                tSapSpectChInfo *pExtSpectCh = NULL;
-                                pExtSpectCh = (pSpectCh - 1 );
-                                if( pExtSpectCh != NULL &&
-                                   (pExtSpectCh >= pSpectChStartAddr &&
-                                    pExtSpectCh < pSpectChEndAddr))
+                                ++pExtSpectCh->bssCount;
+                                rssi = pSpectCh->rssiAgr + SAP_SUBBAND1_RSSI_EFFECT_PRIMARY;
+                                if (IS_RSSI_VALID(pExtSpectCh->rssiAgr, rssi))
                                 {
-                                    ++pExtSpectCh->bssCount;
-                                    rssi = pSpectCh->rssiAgr + SAP_SUBBAND1_RSSI_EFFECT_PRIMARY;
-                                    if (IS_RSSI_VALID(pExtSpectCh->rssiAgr, rssi))
-                                    {
-                                        pExtSpectCh->rssiAgr = rssi;
-                                    }
-                                    if(pExtSpectCh->rssiAgr < SOFTAP_MIN_RSSI)
-                                        pExtSpectCh->rssiAgr = SOFTAP_MIN_RSSI;
+                                    pExtSpectCh->rssiAgr = rssi;
                                 }
-                                pExtSpectCh = (pSpectCh - 2);
-                                if( pExtSpectCh != NULL &&
-                                   (pExtSpectCh >= pSpectChStartAddr &&
-                                    pExtSpectCh < pSpectChEndAddr))
+                                if(pExtSpectCh->rssiAgr < SOFTAP_MIN_RSSI)
+                                    pExtSpectCh->rssiAgr = SOFTAP_MIN_RSSI;
+                            }
+                            pExtSpectCh = (pSpectCh + 2);
+                            if( pExtSpectCh != NULL &&
+                               (pExtSpectCh >= pSpectChStartAddr &&
+                                pExtSpectCh < pSpectChEndAddr))
+                            {
+                                ++pExtSpectCh->bssCount;
+                                rssi = pSpectCh->rssiAgr + SAP_SUBBAND2_RSSI_EFFECT_PRIMARY;
+                                if (IS_RSSI_VALID(pExtSpectCh->rssiAgr, rssi))
                                 {
-                                    ++pExtSpectCh->bssCount;
-                                    rssi = pSpectCh->rssiAgr + SAP_SUBBAND2_RSSI_EFFECT_PRIMARY;
-                                    if (IS_RSSI_VALID(pExtSpectCh->rssiAgr, rssi))
-                                    {
-                                        pExtSpectCh->rssiAgr = rssi;
-                                    }
-                                    if(pExtSpectCh->rssiAgr < SOFTAP_MIN_RSSI)
-                                        pExtSpectCh->rssiAgr = SOFTAP_MIN_RSSI;
+                                    pExtSpectCh->rssiAgr = rssi;
                                 }
-                                pExtSpectCh = (pSpectCh + 1);
-                                if( pExtSpectCh != NULL &&
-                                   (pExtSpectCh >= pSpectChStartAddr &&
-                                    pExtSpectCh < pSpectChEndAddr))
+                                if(pExtSpectCh->rssiAgr < SOFTAP_MIN_RSSI)
+                                    pExtSpectCh->rssiAgr = SOFTAP_MIN_RSSI;
+                            }
+                        }
+                        else if((centerFreq - channel_id) == -2)
+                        {
+                            tSapSpectChInfo *pExtSpectCh = NULL;
+                            pExtSpectCh = (pSpectCh - 1 );
+                            if( pExtSpectCh != NULL &&
+                               (pExtSpectCh >= pSpectChStartAddr &&
+                                pExtSpectCh < pSpectChEndAddr))
+                            {
+                                ++pExtSpectCh->bssCount;
+                                rssi = pSpectCh->rssiAgr + SAP_SUBBAND1_RSSI_EFFECT_PRIMARY;
+                                if (IS_RSSI_VALID(pExtSpectCh->rssiAgr, rssi))
                                 {
-                                    ++pExtSpectCh->bssCount;
-                                    rssi = pSpectCh->rssiAgr + SAP_SUBBAND1_RSSI_EFFECT_PRIMARY;
-                                    if (IS_RSSI_VALID(pExtSpectCh->rssiAgr, rssi))
-                                    {
-                                        pExtSpectCh->rssiAgr = rssi;
-                                    }
-                                    if(pExtSpectCh->rssiAgr < SOFTAP_MIN_RSSI)
-                                        pExtSpectCh->rssiAgr = SOFTAP_MIN_RSSI;
+                                    pExtSpectCh->rssiAgr = rssi;
                                 }
+                                if(pExtSpectCh->rssiAgr < SOFTAP_MIN_RSSI)
+                                    pExtSpectCh->rssiAgr = SOFTAP_MIN_RSSI;
                             }
-                            else if((centerFreq - channel_id) == -6)
+                            pExtSpectCh = (pSpectCh - 2);
+                            if( pExtSpectCh != NULL &&
+                               (pExtSpectCh >= pSpectChStartAddr &&
+                                pExtSpectCh < pSpectChEndAddr))
                             {
-                                tSapSpectChInfo *pExtSpectCh = NULL;
-                                pExtSpectCh = (pSpectCh - 1 );
-                                if( pExtSpectCh != NULL &&
-                                   (pExtSpectCh >= pSpectChStartAddr &&
-                                    pExtSpectCh < pSpectChEndAddr))
+                                ++pExtSpectCh->bssCount;
+                                rssi = pSpectCh->rssiAgr + SAP_SUBBAND2_RSSI_EFFECT_PRIMARY;
+                                if (IS_RSSI_VALID(pExtSpectCh->rssiAgr, rssi))
                                 {
-                                    ++pExtSpectCh->bssCount;
-                                    rssi = pSpectCh->rssiAgr + SAP_SUBBAND1_RSSI_EFFECT_PRIMARY;
-                                    if (IS_RSSI_VALID(pExtSpectCh->rssiAgr, rssi))
-                                    {
-                                        pExtSpectCh->rssiAgr = rssi;
-                                    }
-                                    if(pExtSpectCh->rssiAgr < SOFTAP_MIN_RSSI)
-                                        pExtSpectCh->rssiAgr = SOFTAP_MIN_RSSI;
+                                    pExtSpectCh->rssiAgr = rssi;
                                 }
-                                pExtSpectCh = (pSpectCh - 2);
-                                if( pExtSpectCh != NULL &&
-                                   (pExtSpectCh >= pSpectChStartAddr &&
-                                    pExtSpectCh < pSpectChEndAddr))
+                                if(pExtSpectCh->rssiAgr < SOFTAP_MIN_RSSI)
+                                    pExtSpectCh->rssiAgr = SOFTAP_MIN_RSSI;
+                            }
+                            pExtSpectCh = (pSpectCh + 1);
+                            if( pExtSpectCh != NULL &&
+                               (pExtSpectCh >= pSpectChStartAddr &&
+                                pExtSpectCh < pSpectChEndAddr))
+                            {
+                                ++pExtSpectCh->bssCount;
+                                rssi = pSpectCh->rssiAgr + SAP_SUBBAND1_RSSI_EFFECT_PRIMARY;
+                                if (IS_RSSI_VALID(pExtSpectCh->rssiAgr, rssi))
                                 {
-                                    ++pExtSpectCh->bssCount;
-                                    rssi = pSpectCh->rssiAgr + SAP_SUBBAND2_RSSI_EFFECT_PRIMARY;
-                                    if (IS_RSSI_VALID(pExtSpectCh->rssiAgr, rssi))
-                                    {
-                                        pExtSpectCh->rssiAgr = rssi;
-                                    }
-                                    if(pExtSpectCh->rssiAgr < SOFTAP_MIN_RSSI)
-                                        pExtSpectCh->rssiAgr = SOFTAP_MIN_RSSI;
+                                    pExtSpectCh->rssiAgr = rssi;
                                 }
-                                pExtSpectCh = (pSpectCh - 3);
-                                if( pExtSpectCh != NULL &&
-                                   (pExtSpectCh >= pSpectChStartAddr &&
-                                    pExtSpectCh < pSpectChEndAddr))
+                                if(pExtSpectCh->rssiAgr < SOFTAP_MIN_RSSI)
+                                    pExtSpectCh->rssiAgr = SOFTAP_MIN_RSSI;
+                            }
+                        }
+                        else if((centerFreq - channel_id) == -6)
+                        {
+                            tSapSpectChInfo *pExtSpectCh = NULL;
+                            pExtSpectCh = (pSpectCh - 1 );
+                            if( pExtSpectCh != NULL &&
+                               (pExtSpectCh >= pSpectChStartAddr &&
+                                pExtSpectCh < pSpectChEndAddr))
+                            {
+                                ++pExtSpectCh->bssCount;
+                                rssi = pSpectCh->rssiAgr + SAP_SUBBAND1_RSSI_EFFECT_PRIMARY;
+                                if (IS_RSSI_VALID(pExtSpectCh->rssiAgr, rssi))
                                 {
-                                    ++pExtSpectCh->bssCount;
-                                    rssi = pSpectCh->rssiAgr + SAP_SUBBAND3_RSSI_EFFECT_PRIMARY;
-                                    if (IS_RSSI_VALID(pExtSpectCh->rssiAgr, rssi))
-                                    {
-                                        pExtSpectCh->rssiAgr = rssi;
-                                    }
-                                    if(pExtSpectCh->rssiAgr < SOFTAP_MIN_RSSI)
-                                        pExtSpectCh->rssiAgr = SOFTAP_MIN_RSSI;
+                                    pExtSpectCh->rssiAgr = rssi;
                                 }
+                                if(pExtSpectCh->rssiAgr < SOFTAP_MIN_RSSI)
+                                    pExtSpectCh->rssiAgr = SOFTAP_MIN_RSSI;
                             }
-                        break;
-                    }
+                            pExtSpectCh = (pSpectCh - 2);
+                            if( pExtSpectCh != NULL &&
+                               (pExtSpectCh >= pSpectChStartAddr &&
+                                pExtSpectCh < pSpectChEndAddr))
+                            {
+                                ++pExtSpectCh->bssCount;
+                                rssi = pSpectCh->rssiAgr + SAP_SUBBAND2_RSSI_EFFECT_PRIMARY;
+                                if (IS_RSSI_VALID(pExtSpectCh->rssiAgr, rssi))
+                                {
+                                    pExtSpectCh->rssiAgr = rssi;
+                                }
+                                if(pExtSpectCh->rssiAgr < SOFTAP_MIN_RSSI)
+                                    pExtSpectCh->rssiAgr = SOFTAP_MIN_RSSI;
+                            }
+                            pExtSpectCh = (pSpectCh - 3);
+                            if( pExtSpectCh != NULL &&
+                               (pExtSpectCh >= pSpectChStartAddr &&
+                                pExtSpectCh < pSpectChEndAddr))
+                            {
+                                ++pExtSpectCh->bssCount;
+                                rssi = pSpectCh->rssiAgr + SAP_SUBBAND3_RSSI_EFFECT_PRIMARY;
+                                if (IS_RSSI_VALID(pExtSpectCh->rssiAgr, rssi))
+                                {
+                                    pExtSpectCh->rssiAgr = rssi;
+                                }
+                                if(pExtSpectCh->rssiAgr < SOFTAP_MIN_RSSI)
+                                    pExtSpectCh->rssiAgr = SOFTAP_MIN_RSSI;
+                            }
+                        }
+                    break;
                 }
+            }
 
-                if(operatingBand == eCSR_DOT11_MODE_11g)
-                {
-                     sapInterferenceRssiCount(pSpectCh);
-                }
+            if(operatingBand == eCSR_DOT11_MODE_11g)
+            {
+                 sapInterferenceRssiCount(pSpectCh);
+            }
 
-                VOS_TRACE(VOS_MODULE_ID_SAP, VOS_TRACE_LEVEL_INFO_HIGH,
-                   "In %s, bssdes.ch_self=%d, bssdes.ch_ID=%d, bssdes.rssi=%d, SpectCh.bssCount=%d, pScanResult=%p, ChannelWidth %d, secondaryChanOffset %d, center frequency %d",
-                  __func__, pScanResult->BssDescriptor.channelIdSelf,
-                 pScanResult->BssDescriptor.channelId,
-                 pScanResult->BssDescriptor.rssi, pSpectCh->bssCount,
-                 pScanResult, pSpectCh->channelWidth,
-                 secondaryChannelOffset, centerFreq);
-
-                 pSpectCh++;
-                 break;
-           } else {
-             pSpectCh++;
-           }
+            VOS_TRACE(VOS_MODULE_ID_SAP, VOS_TRACE_LEVEL_INFO_HIGH,
+               "In %s, bssdes.ch_self=%d, bssdes.ch_ID=%d, bssdes.rssi=%d, SpectCh.bssCount=%d, pScanResult=%p, ChannelWidth %d, secondaryChanOffset %d, center frequency %d",
+              __func__, pScanResult->BssDescriptor.channelIdSelf,
+             pScanResult->BssDescriptor.channelId,
+             pScanResult->BssDescriptor.rssi, pSpectCh->bssCount,
+             pScanResult, pSpectCh->channelWidth,
+             secondaryChannelOffset, centerFreq);
         }
 
         pScanResult = sme_ScanResultGetNext(halHandle, pResult);
@@ -1990,7 +2048,6 @@ void sapComputeSpectWeight( tSapChSelSpectInfo* pSpectInfoParams,
         pSpectCh++;
     }
     sap_clear_channel_status(pMac);
-    vos_mem_free(pBeaconStruct);
 }
 
 /*==========================================================================
@@ -2059,6 +2116,7 @@ void sapSortChlWeight(tSapChSelSpectInfo *pSpectInfoParams)
             vos_mem_copy(&pSpectCh[i], &temp, sizeof(*pSpectCh));
         }
     }
+    sap_build_ch_idx(pSpectInfoParams);
 }
 
 /*==========================================================================
@@ -2091,11 +2149,8 @@ void sapSortChlWeightHT80(tSapChSelSpectInfo *pSpectInfoParams)
        four 20MHz weight */
     for (i = 0; i < ARRAY_SIZE(acsHT80Channels); i++)
     {
-        for (j = 0; j < pSpectInfoParams->numSpectChans; j++)
-        {
-            if ( pSpectInfo[j].chNum == acsHT80Channels[i].chStartNum )
-                break;
-        }
+        j = sap_get_spect_ch_idx(pSpectInfoParams,
+                                 acsHT80Channels[i].chStartNum);
         if (j == pSpectInfoParams->numSpectChans)
             continue;
         /* found the channel, add the 4 adjacent channels' weight.
@@ -2154,15 +2209,9 @@ void sapSortChlWeightHT80(tSapChSelSpectInfo *pSpectInfoParams)
         }
     }
 
-    pSpectInfo = pSpectInfoParams->pSpectCh;
-    for (j = 0; j < pSpectInfoParams->numSpectChans; j++)
-    {
-        if ( CHANNEL_165 == pSpectInfo[j].chNum )
-        {
-            pSpectInfo[j].weight = ACS_WEIGHT_MAX * 4;
-            break;
-        }
-    }
+    j = sap_get_spect_ch_idx(pSpectInfoParams, CHANNEL_165);
+    if (j < pSpectInfoParams->numSpectChans)
+        pSpectInfo[j].weight = ACS_WEIGHT_MAX * 4;
 
     pSpectInfo = pSpectInfoParams->pSpectCh;
     for (j = 0; j < (pSpectInfoParams->numSpectChans); j++) {
@@ -2206,11 +2255,8 @@ void sapSortChlWeightHT40_24G(tSapChSelSpectInfo *pSpectInfoParams)
       two 20MHz weight */
     for (i = 0; i < ARRAY_SIZE(acsHT40Channels24G); i++)
     {
-        for (j = 0; j < pSpectInfoParams->numSpectChans; j++)
-        {
-            if (pSpectInfo[j].chNum == acsHT40Channels24G[i].chStartNum)
-                break;
-        }
+        j = sap_get_spect_ch_idx(pSpectInfoParams,
+                                 acsHT40Channels24G[i].chStartNum);
         if (j == pSpectInfoParams->numSpectChans)
             continue;
 
@@ -2310,11 +2356,8 @@ void sapSortChlWeightHT40_5G(tSapChSelSpectInfo *pSpectInfoParams)
       two 20MHz weight */
     for (i = 0; i < ARRAY_SIZE(acsHT40Channels5G); i++)
     {
-        for (j = 0; j < pSpectInfoParams->numSpectChans; j++)
-        {
-            if (pSpectInfo[j].chNum == acsHT40Channels5G[i].chStartNum)
-                break;
-        }
+        j = sap_get_spect_ch_idx(pSpectInfoParams,
+                                 acsHT40Channels5G[i].chStartNum);
         if (j == pSpectInfoParams->numSpectChans)
             continue;
 
@@ -2346,15 +2389,9 @@ void sapSortChlWeightHT40_5G(tSapChSelSpectInfo *pSpectInfoParams)
     }
 
     /* avoid channel 165 by setting its weight to max */
-    pSpectInfo = pSpectInfoParams->pSpectCh;
-    for (j = 0; j < pSpectInfoParams->numSpectChans; j++)
-    {
-        if ( CHANNEL_165  == pSpectInfo[j].chNum )
-        {
-            pSpectInfo[j].weight = ACS_WEIGHT_MAX * 2;
-            break;
-        }
-    }
+    j = sap_get_spect_ch_idx(pSpectInfoParams, CHANNEL_165);
+    if (j < pSpectInfoParams->numSpectChans)
+        pSpectInfo[j].weight = ACS_WEIGHT_MAX * 2;
 
     pSpectInfo = pSpectInfoParams->pSpectCh;
     for (j = 0; j < (pSpectInfoParams->numSpectChans); j++) {
@@ -100,6 +100,8 @@
 #define SAP_CHANNEL_NOT_SELECTED (0)
 
 #define SOFTAP_HT20_CHANNELWIDTH 0
+#define SAP_CH_IDX_TBL_SIZE      (256) // One slot per possible 8-bit channel number
+#define SAP_CH_IDX_INVALID       (0xFF) // Channel not present in pSpectCh
 #define SAP_SUBBAND1_RSSI_EFFECT_PRIMARY  (-20) // In HT40/VHT80, Effect of primary Channel RSSi on Subband1
 #define SAP_SUBBAND2_RSSI_EFFECT_PRIMARY  (-30) // In VHT80, Effect of primary Channel RSSI on Subband2
 #define SAP_SUBBAND3_RSSI_EFFECT_PRIMARY  (-40) // In VHT80, Effect of Primary Channel RSSI on Subband3
@@ -184,6 +186,7 @@ typedef struct {
 typedef struct {
     tSapSpectChInfo *pSpectCh;//tDfsSpectChInfo *pSpectCh;  // Ptr to the channels in the entire spectrum band
     v_U8_t numSpectChans;      // Total num of channels in the spectrum
+    v_U8_t chIdx[SAP_CH_IDX_TBL_SIZE]; // Channel number to pSpectCh index map
 } tSapChSelSpectInfo;//tDfsChSelParams;
 
 /**
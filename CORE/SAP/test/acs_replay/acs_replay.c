@@ -0,0 +1,398 @@
+/*
+ * Copyright (c) 2016 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/*
+ * ACS replay harness
+ *
+ * Feeds scan results to sapSelectChannel() from a userspace build of
+ * sapChSelect.c and prints the selected channel for each ACS run, so two
+ * revisions of the channel selection code can be compared. See
+ * acs_replay.sh, which builds the working tree and a git revision and
+ * diffs their output.
+ *
+ * Usage:
+ *   acs_replay [-v] -r <seed> <runs>   replay generated scan results
+ *   acs_replay [-v] -f <capture>       replay a captured scan
+ *
+ * A capture holds one ACS run per "acs" line followed by its scan
+ * results, e.g. from the "bssdes" SAP traces and a beacon IE dump:
+ *
+ *   acs <start_ch> <end_ch> <ch_width 0|1|2>
+ *   bss <channel> <rssi> <beacon IEs in hex>
+ */
+
+#include "acs_stub.h"
+#include <time.h>
+
+#define ACS_MAX_BSS 256
+#define ACS_MAX_IE_LEN 64
+
+int acs_verbose;
+
+const tRfChannelProps rfChannels[NUM_RF_CHANNELS] = {
+    {2412, 1}, {2417, 2}, {2422, 3}, {2427, 4}, {2432, 5}, {2437, 6},
+    {2442, 7}, {2447, 8}, {2452, 9}, {2457, 10}, {2462, 11}, {2467, 12},
+    {2472, 13}, {2484, 14}, {5180, 36}, {5200, 40}, {5220, 44},
+    {5240, 48}, {5260, 52}, {5280, 56}, {5300, 60}, {5320, 64},
+    {5500, 100}, {5520, 104}, {5540, 108}, {5560, 112}, {5580, 116},
+    {5600, 120}, {5620, 124}, {5640, 128}, {5660, 132}, {5680, 136},
+    {5700, 140}, {5720, 144}, {5745, 149}, {5765, 153}, {5785, 157},
+    {5805, 161}, {5825, 165},
+};
+
+struct acs_bss {
+    tCsrScanResultInfo info;
+    /* backs BssDescriptor.ieFields */
+    tANI_U8 ies[ACS_MAX_IE_LEN];
+};
+
+struct acs_run {
+    struct sap_acs_cfg cfg;
+    v_U32_t dfs_mode;
+    v_U32_t dfs_master;
+    v_BOOL_t have_status;
+    struct lim_channel_status status[NUM_RF_CHANNELS];
+    int num_bss;
+    struct acs_bss bss[ACS_MAX_BSS];
+};
+
+static struct acs_run run;
+static tAniSirGlobal mac;
+static struct hdd_context_s hdd;
+static int scan_pos;
+
+eNVChannelEnabledType vos_nv_getChannelEnabledState(v_U32_t ch)
+{
+    if (ch >= 52 && ch <= 144)
+        return NV_CHANNEL_DFS;
+    return NV_CHANNEL_ENABLE;
+}
+
+int ccmCfgGetInt(tHalHandle hal, v_U16_t cfg, v_U32_t *val)
+{
+    *val = mac.dfs_master;
+    return 0;
+}
+
+tCsrScanResultInfo *sme_ScanResultGetFirst(tHalHandle hal,
+                                           tScanResultHandle res)
+{
+    scan_pos = 0;
+    return run.num_bss ? &run.bss[0].info : NULL;
+}
+
+tCsrScanResultInfo *sme_ScanResultGetNext(tHalHandle hal,
+                                          tScanResultHandle res)
+{
+    if (++scan_pos >= run.num_bss)
+        return NULL;
+    return &run.bss[scan_pos].info;
+}
+
+/* Same walk as limGetIEPtr() in limUtils.c */
+v_U8_t *limGetIEPtr(tpAniSirGlobal pMac, v_U8_t *pIes, int length,
+                    v_U8_t eid, eSizeOfLenField size_of_len_field)
+{
+    int left = length;
+    v_U8_t *ptr = pIes;
+    v_U16_t elem_len;
+
+    while (left >= (size_of_len_field + 1)) {
+        if (size_of_len_field == TWO_BYTE)
+            elem_len = ((v_U16_t)ptr[1]) | (ptr[2] << 8);
+        else
+            elem_len = ptr[1];
+        left -= (size_of_len_field + 1);
+        if (elem_len > left)
+            return NULL;
+        if (ptr[0] == eid)
+            return ptr;
+        left -= elem_len;
+        ptr += (elem_len + (size_of_len_field + 1));
+    }
+    return NULL;
+}
+
+/* The fields of the dot11f beacon unpack the old ACS code looked at */
+int sirParseBeaconIE(tpAniSirGlobal pMac, tSirProbeRespBeacon *bcn,
+                     tANI_U8 *ies, tANI_U32 len)
+{
+    v_U8_t *ie;
+
+    ie = limGetIEPtr(pMac, ies, len, DOT11F_EID_HTCAPS, ONE_BYTE);
+    if (ie && ie[1] >= DOT11F_IE_HTCAPS_MIN_LEN) {
+        bcn->HTCaps.present = 1;
+        bcn->HTCaps.supportedChannelWidthSet = (ie[2] >> 1) & 0x1;
+    }
+    ie = limGetIEPtr(pMac, ies, len, DOT11F_EID_HTINFO, ONE_BYTE);
+    if (ie && ie[1] >= DOT11F_IE_HTINFO_MIN_LEN) {
+        bcn->HTInfo.present = 1;
+        bcn->HTInfo.secondaryChannelOffset = ie[3] & 0x3;
+    }
+    ie = limGetIEPtr(pMac, ies, len, DOT11F_EID_VHTOPERATION, ONE_BYTE);
+    if (ie && ie[1] >= DOT11F_IE_VHTOPERATION_MIN_LEN) {
+        bcn->VHTOperation.present = 1;
+        bcn->VHTOperation.chanWidth = ie[2];
+        bcn->VHTOperation.chanCenterFreqSeg1 = ie[3];
+    }
+    return eSIR_SUCCESS;
+}
+
+struct lim_channel_status *csr_get_channel_status(tpAniSirGlobal m,
+                                                  uint32_t ch)
+{
+    int i;
+
+    if (!run.have_status)
+        return NULL;
+    for (i = 0; i < NUM_RF_CHANNELS; i++)
+        if (rfChannels[i].channelNum == ch)
+            return &run.status[i];
+    return NULL;
+}
+
+void csr_clear_channel_status(tpAniSirGlobal m)
+{
+}
+
+v_PVOID_t vos_get_global_context(int mod, v_PVOID_t ctx)
+{
+    return &mac;
+}
+
+v_PVOID_t vos_get_context(int mod, v_PVOID_t ctx)
+{
+    return &hdd;
+}
+
+int sapDfsIsChannelInNolList(ptSapContext sap, v_U8_t ch, int bond)
+{
+    return 0;
+}
+
+static void acs_set_bss(struct acs_bss *bss, int ch, int rssi,
+                        const tANI_U8 *ies, int ie_len)
+{
+    tSirBssDescription *desc = &bss->info.BssDescriptor;
+
+    memset(bss, 0, sizeof(*bss));
+    desc->channelId = ch;
+    desc->channelIdSelf = ch;
+    desc->rssi = rssi;
+    memcpy(desc->ieFields, ies, ie_len);
+    desc->length = sizeof(*desc) - sizeof(tANI_U16) - sizeof(tANI_U32) +
+                   ie_len;
+}
+
+/* Beacon IEs of a BSS of the given width, 0 for a legacy BSS */
+static int acs_build_ies(tANI_U8 *ies, int width, int sec_off, int center)
+{
+    int len = 0;
+
+    if (width < 0)
+        return 0;
+
+    ies[len] = DOT11F_EID_HTCAPS;
+    ies[len + 1] = DOT11F_IE_HTCAPS_MIN_LEN;
+    memset(&ies[len + 2], 0, DOT11F_IE_HTCAPS_MIN_LEN);
+    ies[len + 2] = width ? 0x2 : 0;
+    len += 2 + DOT11F_IE_HTCAPS_MIN_LEN;
+
+    ies[len] = DOT11F_EID_HTINFO;
+    ies[len + 1] = DOT11F_IE_HTINFO_MIN_LEN;
+    memset(&ies[len + 2], 0, DOT11F_IE_HTINFO_MIN_LEN);
+    ies[len + 3] = sec_off;
+    len += 2 + DOT11F_IE_HTINFO_MIN_LEN;
+
+    if (width == eHT_CHANNEL_WIDTH_80MHZ) {
+        ies[len] = DOT11F_EID_VHTOPERATION;
+        ies[len + 1] = DOT11F_IE_VHTOPERATION_MIN_LEN;
+        memset(&ies[len + 2], 0, DOT11F_IE_VHTOPERATION_MIN_LEN);
+        ies[len + 2] = 1;
+        ies[len + 3] = center;
+        len += 2 + DOT11F_IE_VHTOPERATION_MIN_LEN;
+    }
+    return len;
+}
+
+static void acs_random_run(void)
+{
+    static const v_U8_t vht80_start[] = {36, 52, 100, 116, 132, 149};
+    tANI_U8 ies[ACS_MAX_IE_LEN];
+    int i, ch, width, sec_off, center, band;
+
+    memset(&run, 0, sizeof(run));
+    band = rand() % 3;
+    if (band == 0) {
+        run.cfg.start_ch = 1 + rand() % 3;
+        run.cfg.end_ch = 11 + rand() % 4;
+        run.cfg.ch_width = rand() % 2;
+    } else {
+        run.cfg.start_ch = band == 1 ? 36 : 1;
+        run.cfg.end_ch = 36 + 4 * (rand() % 33);
+        run.cfg.ch_width = rand() % 3;
+    }
+    run.dfs_mode = rand() % 3;
+    run.dfs_master = rand() % 2;
+    run.have_status = rand() % 2;
+    for (i = 0; run.have_status && i < NUM_RF_CHANNELS; i++) {
+        run.status[i].channelfreq = rfChannels[i].targetFreq;
+        run.status[i].channel_id = rfChannels[i].channelNum;
+        run.status[i].noise_floor = rand() % 3 ? 0 : 80 + rand() % 30;
+        run.status[i].cycle_count = 1 + rand() % 4;
+        run.status[i].rx_clear_count = rand() % 8;
+        run.status[i].chan_tx_pwr_range = rand() % 30;
+        run.status[i].chan_tx_pwr_throughput = rand() % 30;
+    }
+
+    run.num_bss = rand() % 80;
+    for (i = 0; i < run.num_bss; i++) {
+        ch = mac.scan.base20MHzChannels.channelList[
+                 rand() % mac.scan.base20MHzChannels.numChannels];
+        width = (rand() % 4) - 1;
+        sec_off = PHY_SINGLE_CHANNEL_CENTERED;
+        center = 0;
+        if (ch > 14 && width == eHT_CHANNEL_WIDTH_80MHZ) {
+            /* place the BSS inside a real 80MHz segment */
+            int seg = vht80_start[rand() % ARRAY_SIZE(vht80_start)];
+
+            ch = seg + 4 * (rand() % 4);
+            center = seg + 6;
+        } else if (width == eHT_CHANNEL_WIDTH_80MHZ) {
+            width = eHT_CHANNEL_WIDTH_40MHZ;
+        }
+        if (width >= eHT_CHANNEL_WIDTH_40MHZ)
+            sec_off = rand() % 2 ? PHY_DOUBLE_CHANNEL_LOW_PRIMARY :
+                                   PHY_DOUBLE_CHANNEL_HIGH_PRIMARY;
+        acs_set_bss(&run.bss[i], ch, -95 + rand() % 70, ies,
+                    acs_build_ies(ies, width, sec_off, center));
+    }
+}
+
+static int acs_hex_ies(const char *hex, tANI_U8 *ies)
+{
+    int len = 0;
+    unsigned int byte;
+
+    while (len < ACS_MAX_IE_LEN && sscanf(hex, "%2x", &byte) == 1) {
+        ies[len++] = byte;
+        hex += 2;
+    }
+    return len;
+}
+
+static void acs_setup_mac(void)
+{
+    int i;
+
+    memset(&mac, 0, sizeof(mac));
+    for (i = 0; i < NUM_RF_CHANNELS; i++)
+        mac.scan.base20MHzChannels.channelList[i] = rfChannels[i].channelNum;
+    mac.scan.base20MHzChannels.numChannels = NUM_RF_CHANNELS;
+}
+
+static void acs_select(unsigned int id)
+{
+    tSapContext sap;
+    struct sap_acs_cfg cfg = run.cfg;
+    v_U8_t ch;
+
+    memset(&sap, 0, sizeof(sap));
+    sap.acs_cfg = &cfg;
+    sap.dfs_mode = run.dfs_mode;
+    sap.csrRoamProfile.phyMode = eCSR_DOT11_MODE_11g;
+    sap.scanBandPreference = eCSR_BAND_ALL;
+    sap.acsBandSwitchThreshold = CFG_ACS_BAND_SWITCH_THRESHOLD_MAX;
+    mac.dfs_master = run.dfs_master;
+
+    ch = sapSelectChannel(&mac, &sap, &run);
+    printf("run %u: %d-%d w%d bss %d -> ch %d sec %d\n", id,
+           cfg.start_ch, cfg.end_ch, cfg.ch_width, run.num_bss, ch,
+           cfg.ht_sec_ch);
+}
+
+static int acs_replay_file(const char *path)
+{
+    FILE *fp = fopen(path, "r");
+    char line[512], hex[256];
+    tANI_U8 ies[ACS_MAX_IE_LEN];
+    unsigned int id = 0;
+    int start, end, width, ch, rssi, pending = 0;
+
+    if (!fp) {
+        perror(path);
+        return 1;
+    }
+    while (fgets(line, sizeof(line), fp)) {
+        if (sscanf(line, "acs %d %d %d", &start, &end, &width) == 3) {
+            if (pending)
+                acs_select(id++);
+            memset(&run, 0, sizeof(run));
+            run.cfg.start_ch = start;
+            run.cfg.end_ch = end;
+            run.cfg.ch_width = width;
+            run.dfs_master = 1;
+            pending = 1;
+        } else if (pending && run.num_bss < ACS_MAX_BSS) {
+            hex[0] = '\0';
+            if (sscanf(line, "bss %d %d %255s", &ch, &rssi, hex) < 2)
+                continue;
+            acs_set_bss(&run.bss[run.num_bss++], ch, rssi, ies,
+                        acs_hex_ies(hex, ies));
+        }
+    }
+    if (pending)
+        acs_select(id);
+    fclose(fp);
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    unsigned int i, runs;
+    int arg = 1;
+    struct timespec t0, t1;
+
+    if (arg < argc && !strcmp(argv[arg], "-v")) {
+        acs_verbose = 1;
+        arg++;
+    }
+    acs_setup_mac();
+
+    if (arg + 1 < argc && !strcmp(argv[arg], "-f"))
+        return acs_replay_file(argv[arg + 1]);
+
+    if (arg + 2 >= argc || strcmp(argv[arg], "-r")) {
+        fprintf(stderr, "usage: %s [-v] -r <seed> <runs> | -f <capture>\n",
+                argv[0]);
+        return 1;
+    }
+
+    srand(strtoul(argv[arg + 1], NULL, 0));
+    runs = strtoul(argv[arg + 2], NULL, 0);
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (i = 0; i < runs; i++) {
+        acs_random_run();
+        acs_select(i);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    fprintf(stderr, "%u runs in %ld us\n", runs,
+            (t1.tv_sec - t0.tv_sec) * 1000000L +
+            (t1.tv_nsec - t0.tv_nsec) / 1000);
+    return 0;
+}
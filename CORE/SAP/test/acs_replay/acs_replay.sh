@@ -0,0 +1,47 @@
+#!/bin/sh
+#
+# Build the ACS replay harness against sapChSelect.c from the working
+# tree and from a git revision, replay the same scan results through
+# both and fail if any run selects a different channel.
+#
+# usage: acs_replay.sh [<rev> [<seed> [<runs>]]]
+#        acs_replay.sh -f <capture> [<rev>]
+
+set -e
+
+HERE=$(cd "$(dirname "$0")" && pwd)
+SRC=$HERE/../../src
+CC=${CC:-cc}
+CFLAGS="-O2 -Wall -Wno-unused-variable -Wno-unused-but-set-variable -Wno-switch-unreachable \
+        -DSOFTAP_CHANNEL_RANGE -DFEATURE_WLAN_CH_AVOID \
+        -DFEATURE_WLAN_STA_AP_MODE_DFS_DISABLE -DFEATURE_WLAN_CH144"
+
+if [ "$1" = "-f" ]; then
+    ARGS="-f $2"
+    REV=${3:-HEAD}
+else
+    REV=${1:-HEAD}
+    ARGS="-r ${2:-1} ${3:-20000}"
+fi
+
+OUT=$(mktemp -d)
+trap 'rm -rf "$OUT"' EXIT
+
+# sapChSelect.c includes its headers relative to its own directory, so
+# build from copies to make the stubs win over the real SAP headers.
+mkdir "$OUT/new" "$OUT/old"
+cp "$SRC/sapChSelect.c" "$SRC/sapChSelect.h" "$OUT/new/"
+(cd "$SRC" && git show "$REV:./sapChSelect.c" > "$OUT/old/sapChSelect.c" &&
+              git show "$REV:./sapChSelect.h" > "$OUT/old/sapChSelect.h")
+
+for t in old new; do
+    $CC $CFLAGS -I"$OUT/$t" -I"$HERE/stubs" -o "$OUT/$t/acs_replay" \
+        "$OUT/$t/sapChSelect.c" "$HERE/acs_replay.c"
+    "$OUT/$t/acs_replay" $ARGS > "$OUT/$t.txt"
+done
+
+if ! diff -u "$OUT/old.txt" "$OUT/new.txt"; then
+    echo "acs_replay: selected channels differ from $REV" >&2
+    exit 1
+fi
+echo "acs_replay: $(wc -l < "$OUT/new.txt") runs match $REV"
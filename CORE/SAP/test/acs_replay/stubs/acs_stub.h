@@ -0,0 +1,230 @@
+/*
+ * Copyright (c) 2016 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/*
+ * Userspace stand-ins for the SAP, CSR, VOS and MAC declarations that
+ * sapChSelect.c uses. Every header sapChSelect.c includes resolves to
+ * this file when building the ACS replay harness.
+ */
+#ifndef __ACS_STUB_H
+#define __ACS_STUB_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef uint8_t v_U8_t;
+typedef uint16_t v_U16_t;
+typedef uint32_t v_U32_t;
+typedef int8_t v_S7_t;
+typedef int32_t v_S31_t;
+typedef uint8_t v_BOOL_t;
+typedef void *v_PVOID_t;
+typedef uint8_t tANI_U8;
+typedef uint16_t tANI_U16;
+typedef uint32_t tANI_U32;
+typedef int8_t tANI_S8;
+typedef uint8_t tANI_BOOLEAN;
+
+#define VOS_TRUE 1
+#define VOS_FALSE 0
+#define eANI_BOOLEAN_TRUE 1
+#define eANI_BOOLEAN_FALSE 0
+#define eSAP_TRUE 1
+#define eSAP_FALSE 0
+
+#ifndef ARRAY_SIZE
+#define ARRAY_SIZE(a) (sizeof(a) / sizeof((a)[0]))
+#endif
+
+extern int acs_verbose;
+#define VOS_TRACE(mod, lvl, ...) \
+    do { if (acs_verbose) { printf(__VA_ARGS__); printf("\n"); } } while (0)
+
+#define vos_mem_malloc(sz) malloc(sz)
+#define vos_mem_free(p) free(p)
+#define vos_mem_zero(p, sz) memset((p), 0, (sz))
+#define vos_mem_set(p, sz, c) memset((p), (c), (sz))
+#define vos_mem_copy(d, s, sz) memcpy((d), (s), (sz))
+
+enum { RF_CHAN_1 = 0, RF_CHAN_14 = 13, RF_CHAN_36 = 14, RF_CHAN_140 = 32,
+       RF_CHAN_144 = 33, RF_CHAN_165 = 38, NUM_RF_CHANNELS };
+#define NUM_20MHZ_RF_CHANNELS NUM_RF_CHANNELS
+
+typedef struct {
+    v_U32_t targetFreq;
+    v_U16_t channelNum;
+} tRfChannelProps;
+extern const tRfChannelProps rfChannels[NUM_RF_CHANNELS];
+
+typedef enum {
+    NV_CHANNEL_DISABLE,
+    NV_CHANNEL_ENABLE,
+    NV_CHANNEL_DFS,
+    NV_CHANNEL_INVALID
+} eNVChannelEnabledType;
+eNVChannelEnabledType vos_nv_getChannelEnabledState(v_U32_t ch);
+#define VOS_IS_DFS_CH(channel) (vos_nv_getChannelEnabledState((channel)) == \
+                                   NV_CHANNEL_DFS)
+#define vos_chan_to_freq(ch) ((ch) <= 14 ? 2407 + (ch) * 5 : 5000 + (ch) * 5)
+#define vos_is_dsrc_channel(freq) ((freq) >= 5850 && (freq) <= 5925)
+
+typedef struct {
+    v_U16_t channelNumber;
+    v_BOOL_t isSafe;
+} sapSafeChannelType;
+
+enum {
+    eCSR_DOT11_MODE_11a = 1,
+    eCSR_DOT11_MODE_11b,
+    eCSR_DOT11_MODE_11g,
+};
+enum { eCSR_BAND_ALL, eCSR_BAND_24, eCSR_BAND_5G };
+enum {
+    eHT_CHANNEL_WIDTH_20MHZ = 0,
+    eHT_CHANNEL_WIDTH_40MHZ = 1,
+    eHT_CHANNEL_WIDTH_80MHZ = 2,
+};
+enum {
+    PHY_SINGLE_CHANNEL_CENTERED = 0,
+    PHY_DOUBLE_CHANNEL_LOW_PRIMARY = 1,
+    PHY_DOUBLE_CHANNEL_HIGH_PRIMARY = 3,
+};
+enum { ACS_DFS_MODE_NONE, ACS_DFS_MODE_ENABLE, ACS_DFS_MODE_DISABLE };
+#define CFG_ACS_BAND_SWITCH_THRESHOLD_MAX (4444)
+#define WNI_CFG_VHT_CHANNEL_WIDTH_20_40MHZ 0
+#define WNI_CFG_DFS_MASTER_ENABLED 1
+
+#define DOT11F_EID_VHTOPERATION ( 192 )
+#define DOT11F_IE_VHTOPERATION_MIN_LEN ( 5 )
+#define DOT11F_EID_HTCAPS ( 45 )
+#define DOT11F_IE_HTCAPS_MIN_LEN ( 26 )
+#define DOT11F_EID_HTINFO ( 61 )
+#define DOT11F_IE_HTINFO_MIN_LEN ( 22 )
+
+typedef enum { ONE_BYTE = 1, TWO_BYTE = 2 } eSizeOfLenField;
+
+struct sap_acs_scan_list {
+    v_U16_t numChannels;
+    v_U8_t channelList[NUM_RF_CHANNELS];
+};
+
+typedef struct sAniSirGlobal {
+    struct {
+        struct sap_acs_scan_list base20MHzChannels;
+    } scan;
+    v_U32_t dfs_master;
+} tAniSirGlobal, *tpAniSirGlobal;
+typedef void *tHalHandle;
+#define PMAC_STRUCT(h) ((tpAniSirGlobal)(h))
+int ccmCfgGetInt(tHalHandle hal, v_U16_t cfg, v_U32_t *val);
+
+typedef struct sSirBssDescription {
+    tANI_U16 length;
+    tANI_S8 rssi;
+    tANI_U8 channelId;
+    tANI_U8 channelIdSelf;
+    tANI_U32 ieFields[1];
+} tSirBssDescription;
+
+typedef struct {
+    tSirBssDescription BssDescriptor;
+} tCsrScanResultInfo;
+typedef void *tScanResultHandle;
+tCsrScanResultInfo *sme_ScanResultGetFirst(tHalHandle hal,
+                                           tScanResultHandle res);
+tCsrScanResultInfo *sme_ScanResultGetNext(tHalHandle hal,
+                                          tScanResultHandle res);
+
+v_U8_t *limGetIEPtr(tpAniSirGlobal pMac, v_U8_t *pIes, int length,
+                    v_U8_t eid, eSizeOfLenField size_of_len_field);
+
+/* What the pre-limGetIEPtr() sapComputeSpectWeight() read from the IEs */
+typedef struct {
+    struct { v_U8_t present, supportedChannelWidthSet; } HTCaps;
+    struct { v_U8_t present, secondaryChannelOffset; } HTInfo;
+    struct { v_U8_t present, chanWidth, chanCenterFreqSeg1; } VHTOperation;
+} tSirProbeRespBeacon;
+enum { eSIR_SUCCESS, eSIR_FAILURE };
+int sirParseBeaconIE(tpAniSirGlobal pMac, tSirProbeRespBeacon *bcn,
+                     tANI_U8 *ies, tANI_U32 len);
+
+struct lim_channel_status {
+    v_U32_t channelfreq;
+    v_U32_t noise_floor;
+    v_U32_t rx_clear_count;
+    v_U32_t cycle_count;
+    v_U32_t chan_tx_pwr_range;
+    v_U32_t chan_tx_pwr_throughput;
+    v_U32_t channel_id;
+};
+struct lim_channel_status *csr_get_channel_status(tpAniSirGlobal mac,
+                                                  uint32_t ch);
+void csr_clear_channel_status(tpAniSirGlobal mac);
+
+typedef struct {
+    v_U8_t numChannel;
+    v_U8_t *channelList;
+} tSapStubChList;
+
+struct sap_acs_cfg {
+    v_U8_t start_ch;
+    v_U8_t end_ch;
+    v_U8_t *ch_list;
+    v_U8_t ch_list_count;
+    v_U16_t ch_width;
+    v_U8_t pri_ch;
+    v_U8_t ht_sec_ch;
+    v_U8_t vht_seg0_center_ch;
+    v_U8_t vht_seg1_center_ch;
+};
+
+typedef struct sSapContext {
+    v_BOOL_t dfs_ch_disable;
+    v_U32_t dfs_mode;
+    struct { v_U32_t phyMode; } csrRoamProfile;
+    struct sap_acs_cfg *acs_cfg;
+    v_U32_t scanBandPreference;
+    v_U32_t currentPreferredBand;
+    struct { v_U8_t channelNum; v_U32_t weight; } acsBestChannelInfo;
+    v_U32_t acsBandSwitchThreshold;
+    v_BOOL_t allBandScanned;
+    v_BOOL_t enableOverLapCh;
+    v_U8_t secondary_ch;
+    tSapStubChList SapChnlList;
+    tSapStubChList SapAllChnlList;
+} tSapContext, *ptSapContext;
+#define VOS_GET_SAP_CB(ctx) ((ptSapContext)(ctx))
+
+enum { VOS_MODULE_ID_SAP, VOS_MODULE_ID_HDD };
+enum { VOS_TRACE_LEVEL_FATAL, VOS_TRACE_LEVEL_ERROR, VOS_TRACE_LEVEL_INFO,
+       VOS_TRACE_LEVEL_INFO_HIGH };
+struct hdd_context_s {
+    v_U16_t unsafe_channel_count;
+    v_U16_t unsafe_channel_list[NUM_20MHZ_RF_CHANNELS];
+};
+v_PVOID_t vos_get_global_context(int mod, v_PVOID_t ctx);
+v_PVOID_t vos_get_context(int mod, v_PVOID_t ctx);
+
+int sapDfsIsChannelInNolList(ptSapContext sap, v_U8_t ch, int bond);
+
+v_U8_t sapSelectChannel(tHalHandle halHandle, ptSapContext pSapCtx,
+                        tScanResultHandle pScanResult);
+
+#endif /* __ACS_STUB_H */
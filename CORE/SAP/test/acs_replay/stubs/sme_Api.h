@@ -0,0 +1 @@
+#include "acs_stub.h"
@@ -225,9 +225,15 @@ BMIDone(HIF_DEVICE *device, struct ol_softc *scn)
 
 A_STATUS bmi_done(struct ol_softc *scn)
 {
+    A_STATUS status;
+
     HIFClaimDevice(scn->hif_hdl, scn);
 
-    if (BMIDone(scn->hif_hdl, scn) != A_OK)
+    ol_boot_phase_start(scn, OL_BOOT_PHASE_BMI_DONE);
+    status = BMIDone(scn->hif_hdl, scn);
+    ol_boot_phase_end(scn, OL_BOOT_PHASE_BMI_DONE);
+
+    if (status != A_OK)
 	    return -1;
 
     return 0;
@@ -293,6 +299,7 @@ BMIGetTargetInfo(HIF_DEVICE *device, struct bmi_target_info *targ_info, struct o
 A_STATUS bmi_download_firmware(struct ol_softc *scn)
 {
 	struct bmi_target_info targ_info;
+	A_STATUS status = A_OK;
 	OS_MEMZERO(&targ_info, sizeof(targ_info));
 
 	if (!scn){
@@ -302,28 +309,39 @@ A_STATUS bmi_download_firmware(struct ol_softc *scn)
 	}
 
 	/* Initialize BMI */
+	ol_boot_phase_start(scn, OL_BOOT_PHASE_BMI_INIT);
 	BMIInit(scn);
 
 	if (scn->pBMICmdBuf == NULL || scn->pBMIRspBuf == NULL) {
 		AR_DEBUG_PRINTF(ATH_DEBUG_ERR, ("BMIInit failed!\n"));
-		return -1;
+		status = -1;
+		goto end_bmi_init;
 	}
 
 	/* Get target information */
-	if (BMIGetTargetInfo(scn->hif_hdl, &targ_info, scn) != A_OK)
-		return -1;
+	if (BMIGetTargetInfo(scn->hif_hdl, &targ_info, scn) != A_OK) {
+		status = -1;
+		goto end_bmi_init;
+	}
 
 	scn->target_type = targ_info.target_type;
 	scn->target_version = targ_info.target_ver;
 
 	/* Configure target */
 	if (ol_configure_target(scn) != A_OK)
-		return -1;
+		status = -1;
+
+end_bmi_init:
+	ol_boot_phase_end(scn, OL_BOOT_PHASE_BMI_INIT);
+	if (status != A_OK)
+		return status;
 
+	ol_boot_phase_start(scn, OL_BOOT_PHASE_FW_DOWNLOAD);
 	if (ol_download_firmware(scn) != EOK)
-		return -EIO;
+		status = -EIO;
+	ol_boot_phase_end(scn, OL_BOOT_PHASE_FW_DOWNLOAD);
 
-	return 0;
+	return status;
 }
 
 A_STATUS
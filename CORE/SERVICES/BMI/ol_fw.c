@@ -26,6 +26,8 @@
  */
 
 #include <linux/firmware.h>
+#include <linux/debugfs.h>
+#include <linux/uaccess.h>
 #include "ol_if_athvar.h"
 #include "ol_fw.h"
 #include "targaddrs.h"
@@ -38,6 +40,8 @@
 #include "if_pci.h"
 #elif defined(HIF_USB)
 #include "if_usb.h"
+#elif defined(HIF_SIM)
+#include "if_sim.h"
 #else
 #include "if_ath_sdio.h"
 #include "regtable.h"
@@ -57,6 +61,7 @@
 #endif
 
 #include "qwlan_version.h"
+#include "adf_os_time.h"
 
 #ifdef FEATURE_SECURE_FIRMWARE
 static struct hash_fw fw_hash;
@@ -463,6 +468,7 @@ static int ol_check_fw_hash(const u8* data, u32 fw_size, ATH_BIN_FILE file)
 end:
 	return ret;
 }
+
 #endif
 
 /**
@@ -565,6 +571,7 @@ static int __ol_transfer_bin_file(struct ol_softc *scn, ATH_BIN_FILE file,
 #endif
 	int ret;
 	char *bd_id_filename = NULL;
+	u_int64_t xfer_start_us, xfer_us;
 
 	if (scn->enablesinglebinary && file != ATH_BOARD_DATA_FILE) {
 		/*
@@ -724,8 +731,10 @@ static int __ol_transfer_bin_file(struct ol_softc *scn, ATH_BIN_FILE file,
 
 	fw_entry_size = fw_entry->size;
 	tempEeprom = NULL;
+	xfer_start_us = adf_os_get_monotonic_us();
 
 #ifdef FEATURE_SECURE_FIRMWARE
+	/* nothing of the file may reach the target before it is verified */
 	if (scn->enable_fw_hash_check &&
 	    ol_check_fw_hash(fw_entry->data, fw_entry_size, file)) {
 		pr_err("Hash Check failed for file:%s\n", filename);
@@ -743,7 +752,7 @@ static int __ol_transfer_bin_file(struct ol_softc *scn, ATH_BIN_FILE file,
 		if (!tempEeprom) {
 			pr_err("%s: Memory allocation failed\n", __func__);
 			status = A_NO_MEMORY;
-			goto release_fw;
+			goto end;
 		}
 
 		OS_MEMCPY(tempEeprom, (u_int8_t *)fw_entry->data, fw_entry_size);
@@ -904,9 +913,15 @@ end:
 		goto release_fw;
 	}
 
+	xfer_us = adf_os_get_monotonic_us() - xfer_start_us;
+	scn->boot_timing.xfer_us += xfer_us;
+	scn->boot_timing.xfer_bytes += fw_entry_size;
+	scn->boot_timing.xfer_files++;
+
 	VOS_TRACE(VOS_MODULE_ID_VOSS, VOS_TRACE_LEVEL_ERROR,
-		"%s: transferring file: %s size %d bytes done!", __func__,
-		(filename!=NULL)?filename:"", fw_entry_size);
+		"%s: transferring file: %s size %d bytes done in %llu us!",
+		__func__, (filename!=NULL)?filename:"", fw_entry_size,
+		(unsigned long long)xfer_us);
 
 release_fw:
 	release_firmware(fw_entry);
@@ -1078,6 +1093,16 @@ static void ramdump_work_handler(struct work_struct *ramdump)
 	printk("FW Assertion at PC: 0x%08x BadVA: 0x%08x TargetID: 0x%08x\n",
 		dram_dump_values[2], dram_dump_values[3], dram_dump_values[0]);
 
+#ifdef WLAN_RAMDUMP_STREAM
+	/* Without reserved ramdump memory a collector drains the target */
+	if (!ramdump_scn->ramdump_base && ol_ramdump_stream_enabled() &&
+	    !ramdump_scn->enableFwSelfRecovery) {
+		if (ol_ramdump_stream_collect(ramdump_scn))
+			goto out_fail;
+		goto out_streamed;
+	}
+#endif
+
 #ifdef TARGET_DUMP_FOR_NON_QC_PLATFORM
 	/* Allocate memory to save ramdump */
 	if (ramdump_scn->enableFwSelfRecovery) {
@@ -1124,6 +1149,22 @@ static void ramdump_work_handler(struct work_struct *ramdump)
 #endif
 	return;
 
+#ifdef WLAN_RAMDUMP_STREAM
+out_streamed:
+	printk("%s: RAM dump streaming completed!\n", __func__);
+
+#if defined(HIF_SDIO) && !defined(CONFIG_CNSS)
+	/* The dump is already out, no need to panic to preserve it */
+	vos_set_logp_in_progress(VOS_MODULE_ID_VOSS, FALSE);
+#if defined(WLAN_OPEN_SOURCE)
+	kobject_uevent(&ramdump_scn->adf_dev->dev->kobj, KOBJ_OFFLINE);
+#endif
+#else
+	vos_device_crashed(dev);
+#endif
+	return;
+#endif
+
 out_fail:
 	/* Silent SSR on dump failure */
 #if defined(CNSS_SELF_RECOVERY) || defined(TARGET_DUMP_FOR_NON_QC_PLATFORM)
@@ -1148,7 +1189,7 @@ static DECLARE_WORK(ramdump_work, ramdump_work_handler);
 void ol_schedule_ramdump_work(struct ol_softc *scn)
 {
 	ramdump_scn = scn;
-	schedule_work(&ramdump_work);
+	ol_ramdump_stream_queue_work(&ramdump_work);
 }
 
 static void fw_indication_work_handler(struct work_struct *fw_indication)
@@ -1174,7 +1215,7 @@ void ol_schedule_fw_indication_work(struct ol_softc *scn)
 	ramdump_scn = scn;
 	schedule_work(&fw_indication_work);
 }
-#elif defined(HIF_USB)
+#elif defined(HIF_USB) || defined(HIF_SIM)
 void ol_schedule_fw_indication_work(struct ol_softc *scn)
 {
 }
@@ -1763,6 +1804,8 @@ A_STATUS ol_patch_pll_switch(struct ol_softc * scn)
 	struct hif_usb_softc *sc = scn->hif_sc;
 #elif defined HIF_PCI
 	struct hif_pci_softc *sc = scn->hif_sc;
+#elif defined(HIF_SIM)
+	struct hif_sim_softc *sc = scn->hif_sc;
 #else
     struct ath_hif_sdio_softc *sc = scn->hif_sc;
 #endif
@@ -2077,6 +2120,108 @@ void ol_transfer_codeswap_struct(struct ol_softc *scn) {
 }
 #endif
 
+static const char *ol_boot_phase_name[OL_BOOT_PHASE_MAX] = {
+	"bmi init",
+	"fw download",
+	"bmi done",
+	"htc ready",
+	"wmi ready",
+};
+
+/**
+ * ol_boot_phase_start() - record the start of a driver start phase
+ * @scn: ol_softc context
+ * @phase: phase being started
+ *
+ * Starting OL_BOOT_PHASE_BMI_INIT clears the timing of any earlier start,
+ * so that a re-probe or SSR only reports its own boot sequence.
+ *
+ * Return: None
+ */
+void ol_boot_phase_start(struct ol_softc *scn, enum ol_boot_phase phase)
+{
+	struct ol_boot_timing *timing = &scn->boot_timing;
+	u_int64_t now = adf_os_get_monotonic_us();
+
+	if (phase >= OL_BOOT_PHASE_MAX)
+		return;
+
+	if (phase == OL_BOOT_PHASE_BMI_INIT) {
+		OS_MEMZERO(timing, sizeof(*timing));
+		timing->start_us = now;
+	}
+	timing->phase_start_us[phase] = now;
+}
+
+/**
+ * ol_boot_phase_end() - record the end of a driver start phase
+ * @scn: ol_softc context
+ * @phase: phase started by ol_boot_phase_start()
+ *
+ * Return: None
+ */
+void ol_boot_phase_end(struct ol_softc *scn, enum ol_boot_phase phase)
+{
+	struct ol_boot_timing *timing = &scn->boot_timing;
+
+	if (phase >= OL_BOOT_PHASE_MAX || !timing->phase_start_us[phase])
+		return;
+
+	timing->phase_us[phase] = adf_os_get_monotonic_us() -
+					timing->phase_start_us[phase];
+}
+
+/**
+ * ol_boot_timing_report() - log where the driver start time went
+ * @scn: ol_softc context
+ *
+ * Logs the duration of each boot phase, the firmware file transfer totals
+ * and the host time spent between the phases since BMI init.
+ *
+ * Return: None
+ */
+void ol_boot_timing_report(struct ol_softc *scn)
+{
+	struct ol_boot_timing *timing = &scn->boot_timing;
+	u_int64_t total_us, phases_us = 0;
+	int i;
+
+	if (!timing->start_us)
+		return;
+
+	total_us = adf_os_get_monotonic_us() - timing->start_us;
+
+	for (i = 0; i < OL_BOOT_PHASE_MAX; i++) {
+		phases_us += timing->phase_us[i];
+		pr_info("%s: %-12s %llu us\n", __func__, ol_boot_phase_name[i],
+			(unsigned long long)timing->phase_us[i]);
+	}
+	pr_info("%s: %u files, %u bytes transferred in %llu us\n", __func__,
+		timing->xfer_files, timing->xfer_bytes,
+		(unsigned long long)timing->xfer_us);
+	pr_info("%s: total %llu us, host init between phases %llu us\n",
+		__func__, (unsigned long long)total_us,
+		(unsigned long long)(total_us - phases_us));
+}
+
+/**
+ * ol_wait_for_htc_target() - wait for the target HTC ready message
+ * @scn: ol_softc context
+ * @htc_handle: HTC handle
+ *
+ * Return: 0 on success, error otherwise
+ */
+int ol_wait_for_htc_target(struct ol_softc *scn, void *htc_handle)
+{
+	A_STATUS status;
+
+	ol_boot_phase_start(scn, OL_BOOT_PHASE_HTC_READY);
+	status = HTCWaitTarget(htc_handle);
+	ol_boot_phase_end(scn, OL_BOOT_PHASE_HTC_READY);
+
+	return status == A_OK ? 0 : -EIO;
+}
+
 int ol_download_firmware(struct ol_softc *scn)
 {
 	uint32_t param, address = 0;
@@ -2619,6 +2764,56 @@ static int ol_dump_fail_debug_info(struct ol_softc *scn, void *ptr)
 }
 #endif
 
+/**
+ * ol_get_dump_section() - get the target location of a ramdump section
+ * @scn: ol_softc handler
+ * @section: section index, below ol_get_max_section_count()
+ * @pos: o/p target address of the section
+ * @len: o/p section length, 0 for the register section
+ *
+ * Selecting an IRAM section also switches the target RAM window to it, so
+ * the section has to be read before the next one is selected.
+ *
+ * Return: 0 on success, error otherwise
+ */
+static int ol_get_dump_section(struct ol_softc *scn, uint32_t section,
+			       uint32_t *pos, uint32_t *len)
+{
+	int ret;
+
+	switch (section) {
+	case 0:
+		*pos = DRAM_LOCATION;
+		*len = DRAM_SIZE;
+		pr_err("%s: Dumping DRAM section...\n", __func__);
+		break;
+	case 1:
+		*pos = AXI_LOCATION;
+		*len = AXI_SIZE;
+		pr_err("%s: Dumping AXI section...\n", __func__);
+		break;
+	case 2:
+		*pos = REGISTER_LOCATION;
+		*len = 0;
+		pr_err("%s: Dumping Register section...\n", __func__);
+		break;
+	case 3:
+	case 4:
+		ret = ol_get_iram_len_and_pos(scn, pos, len, section);
+		if (ret) {
+			pr_err("%s: Fail to Dump IRAM Section ret:%d\n",
+			       __func__, ret);
+			return ret;
+		}
+		break;
+	default:
+		pr_err("%s: INVALID SECTION_:%d\n", __func__, section);
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
 /**---------------------------------------------------------------------------
  *   \brief  ol_target_coredump
  *
@@ -2643,37 +2838,9 @@ int ol_target_coredump(void *inst, void *memoryBlock, u_int32_t blockLength)
 	uint32_t max_count = ol_get_max_section_count(scn);
 
 	while ((sectionCount < max_count) && (amountRead < blockLength)) {
-		switch (sectionCount) {
-		case 0:
-			pos = DRAM_LOCATION;
-			readLen = DRAM_SIZE;
-			pr_err("%s: Dumping DRAM section...\n", __func__);
-			break;
-		case 1:
-			pos = AXI_LOCATION;
-			readLen = AXI_SIZE;
-			pr_err("%s: Dumping AXI section...\n", __func__);
-			break;
-		case 2:
-			pos = REGISTER_LOCATION;
-			readLen = 0;
-			pr_err("%s: Dumping Register section...\n", __func__);
-			break;
-		case 3:
-		case 4:
-			ret = ol_get_iram_len_and_pos(scn, &pos, &readLen,
-						      sectionCount);
-			if (ret) {
-				pr_err("%s: Fail to Dump IRAM Section ret:%d\n",
-				       __func__, ret);
-				return ret;
-			}
-			break;
-		default:
-			pr_err("%s: INVALID SECTION_:%d\n", __func__,
-			       sectionCount);
-			return 0;
-		}
+		ret = ol_get_dump_section(scn, sectionCount, &pos, &readLen);
+		if (ret)
+			return ret;
 
 		if (blockLength - amountRead < readLen) {
 			pr_err("%s: No memory to dump section:%d buffer!\n",
@@ -2699,6 +2866,484 @@ int ol_target_coredump(void *inst, void *memoryBlock, u_int32_t blockLength)
 
 	return ret;
 }
+
+#ifdef WLAN_RAMDUMP_STREAM
+#ifdef MULTI_IF_NAME
+#define OL_RAMDUMP_DEBUGFS_DIR		"cld_ramdump" MULTI_IF_NAME
+#else
+#define OL_RAMDUMP_DEBUGFS_DIR		"cld_ramdump"
+#endif
+#define OL_RAMDUMP_STREAM_CHUNK		(16 * 1024)
+/* time a collector gets to attach to the stream and to drain all of it */
+#define OL_RAMDUMP_STREAM_OPEN_TIMEOUT	5000
+#define OL_RAMDUMP_STREAM_DRAIN_TIMEOUT	60000
+#define OL_RAMDUMP_STREAM_MAX_SECTIONS	5
+
+enum ol_ramdump_stream_state {
+	OL_RAMDUMP_STREAM_IDLE,
+	OL_RAMDUMP_STREAM_ACTIVE,
+	OL_RAMDUMP_STREAM_DONE,
+};
+
+/*
+ * Target memory is read on demand by the collector, one chunk at a time,
+ * in the same section order and layout ol_target_coredump() produces.
+ */
+struct ol_ramdump_stream {
+	struct dentry *dir;
+	struct workqueue_struct *wq;    /* crash handler, may wait on drain */
+	struct mutex lock;
+	wait_queue_head_t wait;         /* collectors waiting for a dump */
+	wait_queue_head_t collect_wait; /* crash handler waiting for drain */
+	u_int32_t readers;
+	u_int32_t generation;           /* dumps started so far */
+	struct ol_softc *scn;
+	enum ol_ramdump_stream_state state;
+	u_int8_t *chunk;
+	u_int32_t max_section;
+	u_int32_t section;
+	u_int32_t section_pos;
+	u_int32_t section_len;
+	u_int32_t section_offset;
+	u_int32_t section_bytes[OL_RAMDUMP_STREAM_MAX_SECTIONS];
+	u_int64_t section_start_us;
+	u_int64_t start_us;
+	u_int64_t total_bytes;
+	int error;
+};
+
+/* one open of the stream, bound to the dump that is current or next */
+struct ol_ramdump_reader {
+	struct ol_ramdump_stream *stream;
+	u_int32_t generation;
+};
+
+static struct ol_ramdump_stream ramdump_stream;
+
+static const char *ol_ramdump_section_name[OL_RAMDUMP_STREAM_MAX_SECTIONS] = {
+	"DRAM", "AXI", "Register", "IRAM", "IRAM2",
+};
+
+/**
+ * ol_ramdump_stream_read_reg() - read part of the register section
+ * @scn: ol_softc handler
+ * @buf: buffer of @len bytes
+ * @offset: offset in the register section
+ * @len: bytes to read
+ *
+ * The register section covers the target range from the first register
+ * table entry, with the gaps between entries left zero as in
+ * ol_diag_read_reg_loc().
+ *
+ * Return: @len on success, -EIO otherwise
+ */
+static int ol_ramdump_stream_read_reg(struct ol_softc *scn, u_int8_t *buf,
+				      u_int32_t offset, u_int32_t len)
+{
+	tgt_reg_table reg_table;
+	u_int32_t addr, end, start_addr, end_addr;
+	int i;
+
+	ol_ath_get_reg_table(scn->target_version, &reg_table);
+	if (!reg_table.section || !reg_table.section_size)
+		return -EIO;
+
+	addr = reg_table.section[0].start_addr + offset;
+	end = addr + len;
+	OS_MEMZERO(buf, len);
+
+	for (i = 0; i < reg_table.section_size; i++) {
+		start_addr = max(reg_table.section[i].start_addr, addr);
+		end_addr = min(reg_table.section[i].end_addr, end);
+		if (start_addr >= end_addr)
+			continue;
+
+		if (ol_diag_read(scn, buf + (start_addr - addr), start_addr,
+				 end_addr - start_addr) == -EIO)
+			return -EIO;
+	}
+
+	return len;
+}
+
+/**
+ * ol_ramdump_stream_next_section() - select the next non-empty section
+ * @stream: ramdump stream
+ *
+ * Return: 0 on success or when all sections are done, error otherwise
+ */
+static int ol_ramdump_stream_next_section(struct ol_ramdump_stream *stream)
+{
+	tgt_reg_table reg_table;
+	int ret;
+
+	while (stream->section < stream->max_section) {
+		ret = ol_get_dump_section(stream->scn, stream->section,
+					  &stream->section_pos,
+					  &stream->section_len);
+		if (ret)
+			return ret;
+
+		if (stream->section_pos == REGISTER_LOCATION)
+			stream->section_len = ol_ath_get_reg_table(
+					stream->scn->target_version,
+					&reg_table);
+
+		stream->section_offset = 0;
+		stream->section_start_us = adf_os_get_monotonic_us();
+		if (stream->section_len)
+			return 0;
+
+		stream->section++;
+	}
+
+	return 0;
+}
+
+/**
+ * ol_ramdump_stream_finish() - end the stream and wake up the crash handler
+ * @stream: ramdump stream
+ * @error: 0 if all sections were read, error otherwise
+ *
+ * Context: called with the stream lock held
+ * Return: None
+ */
+static void ol_ramdump_stream_finish(struct ol_ramdump_stream *stream,
+				     int error)
+{
+	stream->error = error;
+	stream->state = OL_RAMDUMP_STREAM_DONE;
+
+	pr_info("%s: %llu bytes streamed in %llu us, status %d\n", __func__,
+		(unsigned long long)stream->total_bytes,
+		(unsigned long long)(adf_os_get_monotonic_us() -
+				     stream->start_us), error);
+
+	wake_up(&stream->collect_wait);
+}
+
+static int ol_ramdump_stream_open(struct inode *inode, struct file *file)
+{
+	struct ol_ramdump_stream *stream = inode->i_private;
+	struct ol_ramdump_reader *reader;
+
+	reader = vos_mem_malloc(sizeof(*reader));
+	if (!reader)
+		return -ENOMEM;
+
+	mutex_lock(&stream->lock);
+	reader->stream = stream;
+	reader->generation = stream->generation;
+	if (stream->state != OL_RAMDUMP_STREAM_ACTIVE)
+		reader->generation++;
+	stream->readers++;
+	mutex_unlock(&stream->lock);
+
+	file->private_data = reader;
+	wake_up(&stream->collect_wait);
+
+	return nonseekable_open(inode, file);
+}
+
+static int ol_ramdump_stream_release(struct inode *inode, struct file *file)
+{
+	struct ol_ramdump_reader *reader = file->private_data;
+	struct ol_ramdump_stream *stream = reader->stream;
+
+	mutex_lock(&stream->lock);
+	stream->readers--;
+	mutex_unlock(&stream->lock);
+
+	vos_mem_free(reader);
+
+	return 0;
+}
+
+static ssize_t ol_ramdump_stream_read(struct file *file, char __user *user_buf,
+				      size_t count, loff_t *ppos)
+{
+	struct ol_ramdump_reader *reader = file->private_data;
+	struct ol_ramdump_stream *stream = reader->stream;
+	u_int32_t len;
+	ssize_t ret;
+	int result;
+
+	/* block until the dump this reader is bound to has started */
+	ret = wait_event_interruptible(stream->wait,
+			(int)(stream->generation - reader->generation) >= 0);
+	if (ret)
+		return ret;
+
+	mutex_lock(&stream->lock);
+
+	if (stream->generation != reader->generation) {
+		/* the dump was replaced by a later one, end this read out */
+		ret = 0;
+		goto out;
+	}
+
+	if (stream->state != OL_RAMDUMP_STREAM_ACTIVE) {
+		ret = stream->error;
+		goto out;
+	}
+
+	len = min_t(u_int32_t, count, OL_RAMDUMP_STREAM_CHUNK);
+	len = min(len, stream->section_len - stream->section_offset);
+
+	if (stream->section_pos == REGISTER_LOCATION)
+		result = ol_ramdump_stream_read_reg(stream->scn, stream->chunk,
+						    stream->section_offset, len);
+	else
+		result = ol_diag_read(stream->scn, stream->chunk,
+				      stream->section_pos +
+				      stream->section_offset, len);
+	if (result == -EIO) {
+		pr_err("%s: Fail to read %s section at offset 0x%x\n",
+		       __func__, ol_ramdump_section_name[stream->section],
+		       stream->section_offset);
+		ol_ramdump_stream_finish(stream, -EIO);
+		ret = -EIO;
+		goto out;
+	}
+
+	if (copy_to_user(user_buf, stream->chunk, len)) {
+		ret = -EFAULT;
+		goto out;
+	}
+
+	*ppos += len;
+	stream->section_offset += len;
+	stream->section_bytes[stream->section] += len;
+	stream->total_bytes += len;
+	ret = len;
+
+	if (stream->section_offset < stream->section_len)
+		goto out;
+
+	pr_info("%s: Section:%s Bytes Read:%0x in %llu us\n", __func__,
+		ol_ramdump_section_name[stream->section],
+		stream->section_len,
+		(unsigned long long)(adf_os_get_monotonic_us() -
+				     stream->section_start_us));
+
+	stream->section++;
+	result = ol_ramdump_stream_next_section(stream);
+	if (result || stream->section >= stream->max_section)
+		ol_ramdump_stream_finish(stream, result);
+
+out:
+	mutex_unlock(&stream->lock);
+	return ret;
+}
+
+static const struct file_operations fops_ramdump_stream = {
+	.open = ol_ramdump_stream_open,
+	.release = ol_ramdump_stream_release,
+	.read = ol_ramdump_stream_read,
+	.owner = THIS_MODULE,
+	.llseek = no_llseek,
+};
+
+static ssize_t ol_ramdump_stats_read(struct file *file, char __user *user_buf,
+				     size_t count, loff_t *ppos)
+{
+	struct ol_ramdump_stream *stream = file->private_data;
+	static const char * const state_name[] = {"idle", "active", "done"};
+	char buf[256];
+	int len, i;
+
+	mutex_lock(&stream->lock);
+	len = scnprintf(buf, sizeof(buf), "state: %s\nerror: %d\ntotal: %llu\n",
+			state_name[stream->state], stream->error,
+			(unsigned long long)stream->total_bytes);
+	for (i = 0; i < stream->max_section; i++)
+		len += scnprintf(buf + len, sizeof(buf) - len, "%s: %u\n",
+				 ol_ramdump_section_name[i],
+				 stream->section_bytes[i]);
+	if (stream->state == OL_RAMDUMP_STREAM_ACTIVE)
+		len += scnprintf(buf + len, sizeof(buf) - len,
+				 "current: %s 0x%x/0x%x\n",
+				 ol_ramdump_section_name[stream->section],
+				 stream->section_offset, stream->section_len);
+	mutex_unlock(&stream->lock);
+
+	return simple_read_from_buffer(user_buf, count, ppos, buf, len);
+}
+
+static const struct file_operations fops_ramdump_stats = {
+	.open = simple_open,
+	.read = ol_ramdump_stats_read,
+	.owner = THIS_MODULE,
+	.llseek = default_llseek,
+};
+
+/**
+ * ol_ramdump_stream_init() - create the ramdump stream debugfs files
+ *
+ * Creates <debugfs>/cld_ramdump/ramdump, which a collector reads to drain
+ * the target memory after a firmware crash, and ramdump_stats, which shows
+ * the per-section progress of the current dump.
+ *
+ * Return: 0 on success, error otherwise
+ */
+int ol_ramdump_stream_init(void)
+{
+	struct ol_ramdump_stream *stream = &ramdump_stream;
+
+	if (stream->dir)
+		return 0;
+
+	OS_MEMZERO(stream, sizeof(*stream));
+	mutex_init(&stream->lock);
+	init_waitqueue_head(&stream->wait);
+	init_waitqueue_head(&stream->collect_wait);
+
+	stream->wq = alloc_ordered_workqueue("cld_ramdump", 0);
+	if (!stream->wq)
+		return -ENOMEM;
+
+	stream->dir = debugfs_create_dir(OL_RAMDUMP_DEBUGFS_DIR, NULL);
+	if (!stream->dir) {
+		destroy_workqueue(stream->wq);
+		stream->wq = NULL;
+		return -ENOMEM;
+	}
+
+	debugfs_create_file("ramdump", S_IRUSR, stream->dir, stream,
+			    &fops_ramdump_stream);
+	debugfs_create_file("ramdump_stats", S_IRUSR, stream->dir, stream,
+			    &fops_ramdump_stats);
+
+	return 0;
+}
+
+/**
+ * ol_ramdump_stream_deinit() - remove the ramdump stream debugfs files
+ *
+ * Return: None
+ */
+void ol_ramdump_stream_deinit(void)
+{
+	struct ol_ramdump_stream *stream = &ramdump_stream;
+
+	if (!stream->dir)
+		return;
+
+	debugfs_remove_recursive(stream->dir);
+	stream->dir = NULL;
+	destroy_workqueue(stream->wq);
+	stream->wq = NULL;
+}
+
+/**
+ * ol_ramdump_stream_enabled() - check if crash dumps can be streamed
+ *
+ * Return: true if the ramdump stream is set up
+ */
+bool ol_ramdump_stream_enabled(void)
+{
+	return ramdump_stream.dir != NULL;
+}
+
+/**
+ * ol_ramdump_stream_queue_work() - queue the crash handler
+ * @work: ramdump work
+ *
+ * A streamed dump waits up to a minute for the collector, so the crash
+ * handler runs on the stream workqueue instead of the system one.
+ *
+ * Return: None
+ */
+void ol_ramdump_stream_queue_work(struct work_struct *work)
+{
+	if (ramdump_stream.wq)
+		queue_work(ramdump_stream.wq, work);
+	else
+		schedule_work(work);
+}
+
+/**
+ * ol_ramdump_stream_collect() - stream the target memory to a collector
+ * @scn: ol_softc handler
+ *
+ * Used instead of ol_copy_ramdump() when no ramdump memory is reserved.
+ * Only one chunk of host memory is needed, since the collector pulls the
+ * target memory section by section. A collector may already be blocked in
+ * read() when the crash happens. Gives up when no collector attaches or
+ * drains the stream in time, so that recovery is not held off forever.
+ *
+ * Return: 0 when the whole dump was drained, error otherwise
+ */
+int ol_ramdump_stream_collect(struct ol_softc *scn)
+{
+	struct ol_ramdump_stream *stream = &ramdump_stream;
+	int ret;
+
+	if (!vos_is_ssr_fw_dump_required())
+		return 0;
+
+	if (!stream->dir) {
+		pr_err("%s: ramdump stream is not initialized\n", __func__);
+		return -ENODEV;
+	}
+
+	stream->chunk = vos_mem_malloc(OL_RAMDUMP_STREAM_CHUNK);
+	if (!stream->chunk) {
+		pr_err("%s: fail to alloc ramdump stream chunk\n", __func__);
+		return -ENOMEM;
+	}
+
+	mutex_lock(&stream->lock);
+	stream->scn = scn;
+	stream->max_section = min_t(u_int32_t, ol_get_max_section_count(scn),
+				    OL_RAMDUMP_STREAM_MAX_SECTIONS);
+	stream->section = 0;
+	stream->total_bytes = 0;
+	stream->error = 0;
+	OS_MEMZERO(stream->section_bytes, sizeof(stream->section_bytes));
+	stream->start_us = adf_os_get_monotonic_us();
+	stream->generation++;
+
+	ret = ol_ramdump_stream_next_section(stream);
+	if (ret) {
+		stream->state = OL_RAMDUMP_STREAM_DONE;
+		stream->error = ret;
+		mutex_unlock(&stream->lock);
+		wake_up_interruptible(&stream->wait);
+		goto out;
+	}
+	stream->state = OL_RAMDUMP_STREAM_ACTIVE;
+	mutex_unlock(&stream->lock);
+
+	wake_up_interruptible(&stream->wait);
+	pr_info("%s: waiting for collector on %s/ramdump\n", __func__,
+		OL_RAMDUMP_DEBUGFS_DIR);
+
+	if (!wait_event_timeout(stream->collect_wait,
+			stream->readers ||
+			stream->state != OL_RAMDUMP_STREAM_ACTIVE,
+			msecs_to_jiffies(OL_RAMDUMP_STREAM_OPEN_TIMEOUT)) ||
+	    !wait_event_timeout(stream->collect_wait,
+			stream->state != OL_RAMDUMP_STREAM_ACTIVE,
+			msecs_to_jiffies(OL_RAMDUMP_STREAM_DRAIN_TIMEOUT)))
+		pr_err("%s: ramdump stream timed out\n", __func__);
+
+	mutex_lock(&stream->lock);
+	if (stream->state == OL_RAMDUMP_STREAM_ACTIVE)
+		ol_ramdump_stream_finish(stream, -ETIMEDOUT);
+	ret = stream->error;
+	mutex_unlock(&stream->lock);
+
+out:
+	mutex_lock(&stream->lock);
+	vos_mem_free(stream->chunk);
+	stream->chunk = NULL;
+	stream->scn = NULL;
+	mutex_unlock(&stream->lock);
+
+	return ret;
+}
+#endif /* WLAN_RAMDUMP_STREAM */
 #endif
 
 u_int8_t ol_get_number_of_peers_supported(struct ol_softc *scn)
@@ -28,6 +28,9 @@
 #ifndef _OL_FW_H_
 #define _OL_FW_H_
 
+#include <linux/workqueue.h>
+#include "ol_if_athvar.h"
+
 #ifdef QCA_WIFI_FTM
 #include "vos_types.h"
 #endif
@@ -147,11 +150,46 @@ int ol_diag_read(struct ol_softc *scn, u_int8_t* buffer,
 void ol_schedule_ramdump_work(struct ol_softc *scn);
 void ol_schedule_fw_indication_work(struct ol_softc *scn);
 int ol_copy_ramdump(struct ol_softc *scn);
+#ifdef WLAN_RAMDUMP_STREAM
+int ol_ramdump_stream_init(void);
+void ol_ramdump_stream_deinit(void);
+int ol_ramdump_stream_collect(struct ol_softc *scn);
+bool ol_ramdump_stream_enabled(void);
+void ol_ramdump_stream_queue_work(struct work_struct *work);
+#else
+static inline int ol_ramdump_stream_init(void)
+{
+	return 0;
+}
+
+static inline void ol_ramdump_stream_deinit(void)
+{
+}
+
+static inline int ol_ramdump_stream_collect(struct ol_softc *scn)
+{
+	return -ENOTSUPP;
+}
+
+static inline bool ol_ramdump_stream_enabled(void)
+{
+	return false;
+}
+
+static inline void ol_ramdump_stream_queue_work(struct work_struct *work)
+{
+	schedule_work(work);
+}
+#endif
 int dump_CE_register(struct ol_softc *scn);
 int ol_download_firmware(struct ol_softc *scn);
 int ol_configure_target(struct ol_softc *scn);
 void ol_target_failure(void *instance, A_STATUS status);
 u_int8_t ol_get_number_of_peers_supported(struct ol_softc *scn);
+void ol_boot_phase_start(struct ol_softc *scn, enum ol_boot_phase phase);
+void ol_boot_phase_end(struct ol_softc *scn, enum ol_boot_phase phase);
+int ol_wait_for_htc_target(struct ol_softc *scn, void *htc_handle);
+void ol_boot_timing_report(struct ol_softc *scn);
 
 #ifdef REMOVE_PKT_LOG
 static inline void ol_pktlog_init(void *)
@@ -29,7 +29,15 @@
 #include <linux/kernel.h>
 #include <linux/version.h>
 #include <linux/skbuff.h>
+#include <linux/etherdevice.h>
+#include <linux/if_vlan.h>
+#include <linux/ip.h>
+#include <linux/ipv6.h>
+#include <linux/udp.h>
 #include <linux/module.h>
+#include <linux/ktime.h>
+#include <linux/percpu.h>
+#include <linux/slab.h>
 #include <adf_os_types.h>
 #include <adf_nbuf.h>
 #include <adf_os_io.h>
@@ -122,6 +130,315 @@ void adf_nbuf_tx_desc_count_clear(void)
 	memset(nbuf_tx_data, 0, sizeof(nbuf_tx_data));
 }
 
+#ifdef NBUF_SAMPLED_TRACK
+/*
+ * Sampled nbuf tracking
+ *
+ * One nbuf in adf_nbuf_sample_rate is followed from allocation (or from
+ * entering HDD on tx) to free. Each adf_nbuf_set_state() handoff adds the
+ * time spent in the previous layer to a per-cpu log2 histogram, and each
+ * allocation site keeps a per-cpu count of sampled nbufs still alive.
+ * In-flight samples live in a small table indexed by nbuf address; the
+ * sampled bit in the cb keeps the unsampled fast path to a bit test.
+ */
+#define ADF_NBUF_SAMPLE_SLOTS       1024
+#define ADF_NBUF_SAMPLE_SITES       64
+#define ADF_NBUF_SAMPLE_HIST_BINS   16
+
+/* NBUF_TX_PKT_INVALID doubles as "allocated, not handed to a layer yet" */
+#define ADF_NBUF_SAMPLE_ALLOC       NBUF_TX_PKT_INVALID
+
+/* 0 disables sampling, otherwise one nbuf in this many is tracked */
+unsigned int adf_nbuf_sample_rate;
+module_param(adf_nbuf_sample_rate, uint, 0644);
+
+struct adf_nbuf_sample {
+	adf_nbuf_t nbuf;
+	uint64_t stamp_ns;
+	uint64_t alloc_ns;
+	uint8_t state;
+	uint8_t site;
+};
+
+struct adf_nbuf_sample_stats {
+	uint32_t sampled;
+	uint32_t slot_busy;
+	uint32_t site_full;
+	uint32_t hist[NBUF_TX_PKT_STATE_MAX][ADF_NBUF_SAMPLE_HIST_BINS];
+	int32_t outstanding[ADF_NBUF_SAMPLE_SITES];
+};
+
+static struct adf_nbuf_sample adf_nbuf_samples[ADF_NBUF_SAMPLE_SLOTS];
+static unsigned long adf_nbuf_sample_sites[ADF_NBUF_SAMPLE_SITES];
+static DEFINE_PER_CPU(struct adf_nbuf_sample_stats, adf_nbuf_sample_stats);
+static DEFINE_PER_CPU(uint32_t, adf_nbuf_sample_seq);
+
+static const char *adf_nbuf_sample_state_str[NBUF_TX_PKT_STATE_MAX] = {
+	"ALLOC", "HDD", "TXRX_Q", "TXRX_DQ", "TXRX",
+	"HTT", "HTC", "HIF", "CE", "FREE"
+};
+
+static inline struct adf_nbuf_sample *adf_nbuf_sample_slot(adf_nbuf_t nbuf)
+{
+	uint32_t i;
+
+	i = (uint32_t) (((uintptr_t) nbuf) >> 8);
+	i ^= (uint32_t) (((uintptr_t) nbuf) >> 18);
+
+	return &adf_nbuf_samples[i & (ADF_NBUF_SAMPLE_SLOTS - 1)];
+}
+
+/**
+ * adf_nbuf_sample_site() - find or register an allocation site
+ * @site: code address of the allocation
+ *
+ * Only sampled allocations get here, so the linear search is cheap.
+ *
+ * Return: site index, or ADF_NBUF_SAMPLE_SITES if the table is full
+ */
+static uint8_t adf_nbuf_sample_site(unsigned long site)
+{
+	uint8_t i;
+
+	for (i = 0; i < ADF_NBUF_SAMPLE_SITES; i++) {
+		unsigned long cur = ACCESS_ONCE(adf_nbuf_sample_sites[i]);
+
+		if (!cur)
+			cur = cmpxchg(&adf_nbuf_sample_sites[i], 0, site) ?: site;
+		if (cur == site)
+			return i;
+	}
+	return ADF_NBUF_SAMPLE_SITES;
+}
+
+/**
+ * adf_nbuf_sample_account() - close the residency of the current layer
+ * @sample: in-flight sample
+ * @now_ns: time of the handoff
+ *
+ * Return: none
+ */
+static void adf_nbuf_sample_account(struct adf_nbuf_sample *sample,
+				    uint64_t now_ns)
+{
+	struct adf_nbuf_sample_stats *stats;
+	uint64_t delta_us = 0;
+	uint32_t bin;
+
+	if (now_ns > sample->stamp_ns)
+		delta_us = div_u64(now_ns - sample->stamp_ns, NSEC_PER_USEC);
+	bin = delta_us > 0xffffffff ? 32 : fls((uint32_t)delta_us);
+	if (bin >= ADF_NBUF_SAMPLE_HIST_BINS)
+		bin = ADF_NBUF_SAMPLE_HIST_BINS - 1;
+
+	stats = &get_cpu_var(adf_nbuf_sample_stats);
+	stats->hist[sample->state][bin]++;
+	put_cpu_var(adf_nbuf_sample_stats);
+}
+
+/**
+ * adf_nbuf_sample_start() - start following an nbuf if its turn came up
+ * @nbuf: nbuf entering the driver
+ * @site: code address where it entered
+ * @state: layer it entered at
+ *
+ * Return: none
+ */
+static void adf_nbuf_sample_start(adf_nbuf_t nbuf, unsigned long site,
+				  uint8_t state)
+{
+	struct adf_nbuf_sample_stats *stats;
+	struct adf_nbuf_sample *sample;
+	uint32_t rate = ACCESS_ONCE(adf_nbuf_sample_rate);
+	uint8_t site_id;
+
+	if (!rate || (this_cpu_inc_return(adf_nbuf_sample_seq) % rate))
+		return;
+
+	stats = &get_cpu_var(adf_nbuf_sample_stats);
+	sample = adf_nbuf_sample_slot(nbuf);
+	site_id = adf_nbuf_sample_site(site);
+	if (site_id == ADF_NBUF_SAMPLE_SITES) {
+		stats->site_full++;
+	} else if (cmpxchg(&sample->nbuf, NULL, nbuf)) {
+		stats->slot_busy++;
+	} else {
+		sample->alloc_ns = ktime_to_ns(ktime_get());
+		sample->stamp_ns = sample->alloc_ns;
+		sample->state = state;
+		sample->site = site_id;
+		ADF_NBUF_CB_SAMPLED(nbuf) = 1;
+		stats->sampled++;
+		stats->outstanding[site_id]++;
+	}
+	put_cpu_var(adf_nbuf_sample_stats);
+}
+
+void __adf_nbuf_sample_alloc(adf_nbuf_t nbuf, unsigned long site)
+{
+	adf_nbuf_sample_start(nbuf, site, ADF_NBUF_SAMPLE_ALLOC);
+}
+
+void __adf_nbuf_sample_free(adf_nbuf_t nbuf)
+{
+	struct adf_nbuf_sample *sample = adf_nbuf_sample_slot(nbuf);
+	uint8_t site_id;
+
+	ADF_NBUF_CB_SAMPLED(nbuf) = 0;
+	if (sample->nbuf != nbuf)
+		return;
+
+	adf_nbuf_sample_account(sample, ktime_to_ns(ktime_get()));
+	site_id = sample->site;
+	/* the slot may be reused as soon as nbuf is cleared */
+	smp_wmb();
+	ACCESS_ONCE(sample->nbuf) = NULL;
+
+	this_cpu_dec(adf_nbuf_sample_stats.outstanding[site_id]);
+}
+
+/**
+ * adf_nbuf_sample_handoff() - record an nbuf moving to another layer
+ * @nbuf: network buffer
+ * @state: layer taking the nbuf
+ * @site: caller of adf_nbuf_set_state()
+ *
+ * Return: none
+ */
+static inline void adf_nbuf_sample_handoff(adf_nbuf_t nbuf, uint8_t state,
+					   unsigned long site)
+{
+	struct adf_nbuf_sample *sample;
+	uint64_t now_ns;
+
+	if (adf_os_likely(!adf_nbuf_sample_rate))
+		return;
+
+	if (!ADF_NBUF_CB_SAMPLED(nbuf)) {
+		/* tx frames from the stack enter the driver here */
+		if (state == NBUF_TX_PKT_HDD)
+			adf_nbuf_sample_start(nbuf, site, state);
+		return;
+	}
+
+	sample = adf_nbuf_sample_slot(nbuf);
+	if (sample->nbuf != nbuf) {
+		/* stale bit left by the stack, maybe sample it now */
+		ADF_NBUF_CB_SAMPLED(nbuf) = 0;
+		if (state == NBUF_TX_PKT_HDD)
+			adf_nbuf_sample_start(nbuf, site, state);
+		return;
+	}
+
+	now_ns = ktime_to_ns(ktime_get());
+	adf_nbuf_sample_account(sample, now_ns);
+	sample->state = state;
+	sample->stamp_ns = now_ns;
+}
+
+/**
+ * adf_nbuf_sample_display() - dump residency histograms and live samples
+ *
+ * Histogram bin n counts residencies below 2^n us, the last bin is open.
+ * Outstanding counts are sampled nbufs still alive per allocation site;
+ * multiply by adf_nbuf_sample_rate for an estimate of all nbufs.
+ *
+ * Return: none
+ */
+void adf_nbuf_sample_display(void)
+{
+	struct adf_nbuf_sample_stats *sum;
+	uint64_t oldest_ns[ADF_NBUF_SAMPLE_SITES] = {0};
+	uint64_t now_ns = ktime_to_ns(ktime_get());
+	int cpu, i, j, k;
+
+	sum = kzalloc(sizeof(*sum), GFP_ATOMIC);
+	if (!sum)
+		return;
+
+	for_each_possible_cpu(cpu) {
+		struct adf_nbuf_sample_stats *stats =
+			&per_cpu(adf_nbuf_sample_stats, cpu);
+
+		sum->sampled += stats->sampled;
+		sum->slot_busy += stats->slot_busy;
+		sum->site_full += stats->site_full;
+		for (i = 0; i < NBUF_TX_PKT_STATE_MAX; i++)
+			for (j = 0; j < ADF_NBUF_SAMPLE_HIST_BINS; j++)
+				sum->hist[i][j] += stats->hist[i][j];
+		for (i = 0; i < ADF_NBUF_SAMPLE_SITES; i++)
+			sum->outstanding[i] += stats->outstanding[i];
+	}
+
+	for (i = 0; i < ADF_NBUF_SAMPLE_SLOTS; i++) {
+		struct adf_nbuf_sample *sample = &adf_nbuf_samples[i];
+		uint64_t age_ns;
+
+		if (!ACCESS_ONCE(sample->nbuf))
+			continue;
+		age_ns = now_ns - sample->alloc_ns;
+		if (age_ns > oldest_ns[sample->site])
+			oldest_ns[sample->site] = age_ns;
+	}
+
+	adf_os_print("nbuf sampling 1/%u: sampled %u slot busy %u site full %u\n",
+		     adf_nbuf_sample_rate, sum->sampled, sum->slot_busy,
+		     sum->site_full);
+
+	adf_os_print("Layer residency (log2 us bins):\n");
+	for (i = 0; i < NBUF_TX_PKT_STATE_MAX; i++) {
+		char buf[ADF_NBUF_SAMPLE_HIST_BINS * 11 + 1];
+		int len = 0;
+
+		for (j = ADF_NBUF_SAMPLE_HIST_BINS; j > 0; j--)
+			if (sum->hist[i][j - 1])
+				break;
+		if (!j)
+			continue;
+		for (k = 0; k < j; k++)
+			len += scnprintf(buf + len, sizeof(buf) - len, " %u",
+					 sum->hist[i][k]);
+		adf_os_print("%-8s%s\n", adf_nbuf_sample_state_str[i], buf);
+	}
+
+	adf_os_print("Outstanding by allocation site:\n");
+	for (i = 0; i < ADF_NBUF_SAMPLE_SITES; i++) {
+		if (!adf_nbuf_sample_sites[i] || sum->outstanding[i] <= 0)
+			continue;
+		adf_os_print("%pS: %d outstanding, oldest %llu ms\n",
+			     (void *)adf_nbuf_sample_sites[i],
+			     sum->outstanding[i],
+			     div_u64(oldest_ns[i], NSEC_PER_MSEC));
+	}
+
+	kfree(sum);
+}
+
+/**
+ * adf_nbuf_sample_clear() - reset histograms and forget in-flight samples
+ *
+ * nbufs still carrying the sampled bit are simply not found any more.
+ *
+ * Return: none
+ */
+void adf_nbuf_sample_clear(void)
+{
+	int cpu, i;
+
+	for (i = 0; i < ADF_NBUF_SAMPLE_SLOTS; i++)
+		ACCESS_ONCE(adf_nbuf_samples[i].nbuf) = NULL;
+
+	for_each_possible_cpu(cpu)
+		memset(&per_cpu(adf_nbuf_sample_stats, cpu), 0,
+		       sizeof(struct adf_nbuf_sample_stats));
+}
+#else
+static inline void adf_nbuf_sample_handoff(adf_nbuf_t nbuf, uint8_t state,
+					   unsigned long site)
+{
+}
+#endif /* NBUF_SAMPLED_TRACK */
+
 /**
  * adf_nbuf_set_state() - Updates the packet state
  * @nbuf:            network buffer
@@ -140,6 +457,8 @@ void adf_nbuf_set_state(adf_nbuf_t nbuf, uint8_t current_state)
 	 */
 	uint8_t packet_type;
 
+	adf_nbuf_sample_handoff(nbuf, current_state, _RET_IP_);
+
 	packet_type = NBUF_GET_PACKET_TRACK(nbuf);
 
 	if ((packet_type != NBUF_TX_PKT_DATA_TRACK) &&
@@ -1669,6 +1988,7 @@ void adf_net_buf_debug_release_skb(adf_nbuf_t net_buf)
 		ext_list = next;
 	}
 	adf_net_buf_debug_delete_node(net_buf);
+	adf_nbuf_sample_free(net_buf);
 }
 #endif /*MEMORY_DEBUG */
 
@@ -411,6 +411,56 @@ adf_nbuf_dmamap_info(adf_os_dma_map_t bmap, adf_os_dmamap_info_t *sg)
     __adf_nbuf_dmamap_info(bmap, sg);
 }
 
+#ifdef NBUF_SAMPLED_TRACK
+extern unsigned int adf_nbuf_sample_rate;
+
+void __adf_nbuf_sample_alloc(adf_nbuf_t nbuf, unsigned long site);
+void __adf_nbuf_sample_free(adf_nbuf_t nbuf);
+void adf_nbuf_sample_display(void);
+void adf_nbuf_sample_clear(void);
+
+/**
+ * adf_nbuf_sample_alloc() - offer a new nbuf to the sampled tracker
+ * @nbuf: freshly allocated nbuf, may be NULL
+ * @site: code address of the allocation
+ *
+ * Return: none
+ */
+static inline void adf_nbuf_sample_alloc(adf_nbuf_t nbuf, unsigned long site)
+{
+	if (adf_os_unlikely(adf_nbuf_sample_rate) && adf_os_likely(nbuf))
+		__adf_nbuf_sample_alloc(nbuf, site);
+}
+
+/**
+ * adf_nbuf_sample_free() - stop tracking an nbuf leaving the driver
+ * @nbuf: nbuf being freed or handed to the network stack
+ *
+ * Return: none
+ */
+static inline void adf_nbuf_sample_free(adf_nbuf_t nbuf)
+{
+	if (adf_os_unlikely(nbuf && ADF_NBUF_CB_SAMPLED(nbuf)))
+		__adf_nbuf_sample_free(nbuf);
+}
+#else
+static inline void adf_nbuf_sample_alloc(adf_nbuf_t nbuf, unsigned long site)
+{
+}
+
+static inline void adf_nbuf_sample_free(adf_nbuf_t nbuf)
+{
+}
+
+static inline void adf_nbuf_sample_display(void)
+{
+}
+
+static inline void adf_nbuf_sample_clear(void)
+{
+}
+#endif /* NBUF_SAMPLED_TRACK */
+
 #ifdef MEMORY_DEBUG
 void adf_net_buf_debug_init(void);
 void adf_net_buf_debug_exit(void);
@@ -435,6 +485,7 @@ adf_nbuf_alloc_debug(adf_os_device_t osdev, adf_os_size_t size, int reserve,
 	/* Store SKB in internal ADF tracking table */
 	if (adf_os_likely(net_buf))
 		adf_net_buf_debug_add_node(net_buf, size, file_name, line_num);
+	adf_nbuf_sample_alloc(net_buf, _THIS_IP_);
 
 	return net_buf;
 }
@@ -444,6 +495,7 @@ static inline void adf_nbuf_free(adf_nbuf_t net_buf)
 	/* Remove SKB from internal ADF tracking table */
 	if (adf_os_likely(net_buf))
 		adf_net_buf_debug_delete_node(net_buf);
+	adf_nbuf_sample_free(net_buf);
 
 	__adf_nbuf_free(net_buf);
 }
@@ -452,7 +504,7 @@ static inline void adf_nbuf_free(adf_nbuf_t net_buf)
 
 static inline void adf_net_buf_debug_release_skb(adf_nbuf_t net_buf)
 {
-	return;
+	adf_nbuf_sample_free(net_buf);
 }
 
 /*
@@ -482,7 +534,10 @@ adf_nbuf_alloc(adf_os_device_t      osdev,
                int                  align,
                int                  prio)
 {
-    return __adf_nbuf_alloc(osdev, size, reserve,align, prio);
+    adf_nbuf_t nbuf = __adf_nbuf_alloc(osdev, size, reserve, align, prio);
+
+    adf_nbuf_sample_alloc(nbuf, _THIS_IP_);
+    return nbuf;
 }
 
 #ifdef QCA_ARP_SPOOFING_WAR
@@ -508,7 +563,10 @@ adf_rx_nbuf_alloc(adf_os_device_t      osdev,
                int                  align,
                int                  prio)
 {
-    return __adf_rx_nbuf_alloc(osdev, size, reserve,align, prio);
+    adf_nbuf_t nbuf = __adf_rx_nbuf_alloc(osdev, size, reserve, align, prio);
+
+    adf_nbuf_sample_alloc(nbuf, _THIS_IP_);
+    return nbuf;
 }
 #endif
 
@@ -520,6 +578,7 @@ adf_rx_nbuf_alloc(adf_os_device_t      osdev,
 static inline void
 adf_nbuf_free(adf_nbuf_t buf)
 {
+    adf_nbuf_sample_free(buf);
     __adf_nbuf_free(buf);
 }
 
@@ -2048,6 +2107,45 @@ static inline bool adf_nbuf_is_bcast_pkt(struct sk_buff *skb)
 	return __adf_nbuf_is_bcast_pkt(skb->data);
 }
 
+/**
+ * adf_nbuf_set_l4_hash() - hand a flow hash for the L4 tuple to the stack
+ * @buf: rx frame
+ * @hash: flow hash of the frame's TCP/UDP tuple
+ *
+ * Lets RPS/RFS steer the frame without dissecting its headers again.
+ *
+ * Return: None
+ */
+static inline void adf_nbuf_set_l4_hash(adf_nbuf_t buf, u_int32_t hash)
+{
+	__adf_nbuf_set_l4_hash(buf, hash);
+}
+
+/**
+ * adf_nbuf_set_timestamp() - record the time a buffer is queued at
+ * @buf: control path buffer, e.g. a WMI event
+ *
+ * The time is kept in the skb timestamp, so it must only be used on
+ * buffers that are not handed to the network stack.
+ *
+ * Return: none
+ */
+static inline void adf_nbuf_set_timestamp(adf_nbuf_t buf)
+{
+	__adf_nbuf_set_timestamp(buf);
+}
+
+/**
+ * adf_nbuf_get_timedelta_us() - time since adf_nbuf_set_timestamp()
+ * @buf: buffer stamped with adf_nbuf_set_timestamp()
+ *
+ * Return: elapsed time in microseconds
+ */
+static inline u_int32_t adf_nbuf_get_timedelta_us(adf_nbuf_t buf)
+{
+	return __adf_nbuf_get_timedelta_us(buf);
+}
+
 
 
 
@@ -139,6 +139,18 @@ adf_os_atomic_inc_return(adf_os_atomic_t *v)
 	return __adf_os_atomic_inc_return(v);
 }
 
+/**
+ * adf_os_atomic_inc_not_zero() - Increment an atomic variable unless zero
+ * @v: a pointer to an opaque atomic variable
+ *
+ * Return: non-zero if the variable was incremented, 0 if it was zero
+ */
+static inline int32_t
+adf_os_atomic_inc_not_zero(adf_os_atomic_t *v)
+{
+	return __adf_os_atomic_inc_not_zero(v);
+}
+
 /**
  * @brief Set a value to the value of an atomic variable.
  * @param v a pointer to an opaque atomic variable
@@ -174,4 +174,55 @@ adf_os_spinlock_irq_exec(adf_os_handle_t           hdl,
 
 #define adf_os_in_softirq() __adf_os_in_softirq()
 
+/**
+ * @brief Platform RCU callback head, embedded in RCU protected objects
+ */
+typedef __adf_os_rcu_head_t adf_os_rcu_head_t;
+
+/**
+ * @brief Enter / leave an RCU read-side critical section
+ */
+#define adf_os_rcu_read_lock()   __adf_os_rcu_read_lock()
+#define adf_os_rcu_read_unlock() __adf_os_rcu_read_unlock()
+
+/**
+ * @brief Fetch / publish an RCU protected pointer
+ */
+#define adf_os_rcu_dereference(_p)        __adf_os_rcu_dereference(_p)
+#define adf_os_rcu_assign_pointer(_p, _v) __adf_os_rcu_assign_pointer(_p, _v)
+
+/**
+ * @brief Fetch an RCU protected pointer, complaining (with lockdep RCU
+ *        checking enabled) when the condition does not hold
+ */
+#define adf_os_rcu_dereference_check(_p, _c) \
+    __adf_os_rcu_dereference_check(_p, _c)
+
+/**
+ * @brief Whether the caller is inside adf_os_rcu_read_lock, for use as
+ *        an adf_os_rcu_dereference_check condition
+ */
+#define adf_os_rcu_read_lock_held() __adf_os_rcu_read_lock_held()
+
+/**
+ * @brief Invoke a callback once all current RCU readers are done
+ *
+ * @param[in] head  callback head embedded in the object to be released
+ * @param[in] func  callback, called from softirq context
+ */
+static inline void
+adf_os_call_rcu(adf_os_rcu_head_t *head, void (*func)(adf_os_rcu_head_t *head))
+{
+    __adf_os_call_rcu(head, func);
+}
+
+/**
+ * @brief Wait for all pending adf_os_call_rcu callbacks to complete
+ */
+static inline void
+adf_os_rcu_barrier(void)
+{
+    __adf_os_rcu_barrier();
+}
+
 #endif
@@ -94,6 +94,16 @@ adf_os_gettimestamp(void)
     return (__adf_os_gettimestamp());
 }
 
+/**
+ * @brief Return a monotonic timestamp with microsecond resolution,
+ *        suitable for measuring short latencies.
+ */
+static inline a_uint64_t
+adf_os_get_monotonic_us(void)
+{
+    return (__adf_os_get_monotonic_us());
+}
+
 /**
  * @brief Delay in microseconds
  *
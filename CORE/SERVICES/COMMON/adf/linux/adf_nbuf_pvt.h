@@ -151,7 +151,8 @@ struct cvg_nbuf_cb {
         uint8_t is_wapi: 1;
         uint8_t is_mcast: 1;
         uint8_t is_bcast: 1;
-        uint8_t reserved: 2;
+        uint8_t sampled: 1;
+        uint8_t reserved: 1;
     } packet_type;
 } __packed;
 
@@ -256,6 +257,10 @@ struct cvg_nbuf_cb {
 #define NBUF_GET_PACKET_TRACK(skb) \
     (((struct cvg_nbuf_cb *)((skb)->cb))->trace.packet_track)
 
+/* hint only, skbs from the stack may carry a stale bit */
+#define ADF_NBUF_CB_SAMPLED(skb) \
+    (((struct cvg_nbuf_cb *)((skb)->cb))->packet_type.sampled)
+
 #define NBUF_UPDATE_TX_PKT_COUNT(skb, PACKET_STATE) \
     adf_nbuf_set_state(skb, PACKET_STATE)
 
@@ -1389,4 +1394,24 @@ __adf_nbuf_update_skb_mark(__adf_nbuf_t skb, uint32_t mask)
 	skb->mark |= mask;
 }
 
+static inline void
+__adf_nbuf_set_l4_hash(__adf_nbuf_t skb, uint32_t hash)
+{
+#if (LINUX_VERSION_CODE >= KERNEL_VERSION(3, 14, 0))
+	skb_set_hash(skb, hash, PKT_HASH_TYPE_L4);
+#endif
+}
+
+static inline void
+__adf_nbuf_set_timestamp(__adf_nbuf_t skb)
+{
+	skb->tstamp = ktime_get();
+}
+
+static inline u_int32_t
+__adf_nbuf_get_timedelta_us(__adf_nbuf_t skb)
+{
+	return (u_int32_t)ktime_us_delta(ktime_get(), skb->tstamp);
+}
+
 #endif /*_adf_nbuf_PVT_H */
@@ -100,6 +100,12 @@ __adf_os_atomic_inc_return(__adf_os_atomic_t *v)
 	return atomic_inc_return(v);
 }
 
+static inline int32_t
+__adf_os_atomic_inc_not_zero(__adf_os_atomic_t *v)
+{
+	return atomic_inc_not_zero(v);
+}
+
 static inline void
  __adf_os_atomic_set(__adf_os_atomic_t *v, int i)
 {
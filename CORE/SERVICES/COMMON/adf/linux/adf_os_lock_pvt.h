@@ -32,6 +32,7 @@
 #include <linux/semaphore.h>
 #include <linux/interrupt.h>
 #include <linux/spinlock.h>
+#include <linux/rcupdate.h>
 #include <adf_os_types.h>
 
 typedef struct __adf_os_linux_spinlock {
@@ -187,4 +188,26 @@ __adf_os_in_softirq(void)
 {
     return (in_softirq());
 }
+
+typedef struct rcu_head __adf_os_rcu_head_t;
+
+#define __adf_os_rcu_read_lock()            rcu_read_lock()
+#define __adf_os_rcu_read_unlock()          rcu_read_unlock()
+#define __adf_os_rcu_dereference(_p)        rcu_dereference(_p)
+#define __adf_os_rcu_dereference_check(_p, _c) rcu_dereference_check(_p, _c)
+#define __adf_os_rcu_read_lock_held()       rcu_read_lock_held()
+#define __adf_os_rcu_assign_pointer(_p, _v) rcu_assign_pointer(_p, _v)
+
+static inline void
+__adf_os_call_rcu(__adf_os_rcu_head_t *head,
+                  void (*func)(__adf_os_rcu_head_t *head))
+{
+    call_rcu(head, func);
+}
+
+static inline void
+__adf_os_rcu_barrier(void)
+{
+    rcu_barrier();
+}
 #endif /*_ADF_CMN_OS_LOCK_PVT_H*/
@@ -31,6 +31,7 @@
 
 #include <linux/jiffies.h>
 #include <linux/delay.h>
+#include <linux/ktime.h>
 
 typedef unsigned long __adf_time_t;
 
@@ -61,6 +62,12 @@ __adf_os_gettimestamp(void)
     return ((jiffies / HZ) * 1000) + (jiffies % HZ) * (1000 / HZ);
 }
 
+static inline a_uint64_t
+__adf_os_get_monotonic_us(void)
+{
+    return ktime_to_us(ktime_get());
+}
+
 static inline void
 __adf_os_udelay(a_uint32_t usecs)
 {
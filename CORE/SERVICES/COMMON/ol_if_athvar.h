@@ -149,6 +149,26 @@ struct fw_ramdump {
 };
 #endif
 
+/* Driver start phases, timed from BMI init to the WMI ready event */
+enum ol_boot_phase {
+    OL_BOOT_PHASE_BMI_INIT,     /* BMI init, target info and configuration */
+    OL_BOOT_PHASE_FW_DOWNLOAD,  /* board data, OTP and firmware transfer */
+    OL_BOOT_PHASE_BMI_DONE,
+    OL_BOOT_PHASE_HTC_READY,
+    OL_BOOT_PHASE_WMI_READY,
+    OL_BOOT_PHASE_MAX
+};
+
+/* structure to save per-phase driver start timing, in microseconds */
+struct ol_boot_timing {
+    u_int64_t start_us;                        /* first phase start */
+    u_int64_t phase_start_us[OL_BOOT_PHASE_MAX];
+    u_int64_t phase_us[OL_BOOT_PHASE_MAX];     /* phase durations */
+    u_int64_t xfer_us;                         /* time spent in file xfer */
+    u_int32_t xfer_bytes;                      /* bytes of all files */
+    u_int32_t xfer_files;
+};
+
 struct ol_softc {
     /*
      * handle for code that uses the osdep.h version of OS
@@ -203,6 +223,8 @@ struct ol_softc {
     struct hif_pci_softc    *hif_sc;
 #elif defined(HIF_USB)
     struct hif_usb_softc    *hif_sc;
+#elif defined(HIF_SIM)
+    struct hif_sim_softc    *hif_sc;
 #else
     struct ath_hif_sdio_softc    *hif_sc;
 #endif
@@ -292,11 +314,15 @@ struct ol_softc {
 #ifdef FEATURE_RUNTIME_PM
     bool enable_runtime_pm;
     u_int32_t runtime_pm_delay;
+    bool runtime_pm_governor;
+    u_int32_t runtime_pm_delay_min;
+    u_int32_t runtime_pm_delay_max;
 #endif
 #ifdef FEATURE_SECURE_FIRMWARE
     bool enable_fw_hash_check;
 #endif
     uint16_t board_id;
+    struct ol_boot_timing boot_timing;
 };
 
 #ifdef PERE_IP_HDR_ALIGNMENT_WAR
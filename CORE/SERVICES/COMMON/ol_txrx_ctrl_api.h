@@ -110,6 +110,10 @@ enum netif_reason_type {
 #define WLAN_TXRX_HIST_STATS         2
 #define WLAN_TXRX_DESC_STATS         3
 #define WLAN_HDD_NETIF_OPER_HISTORY  4
+#define WLAN_VOS_MC_MQ_STATS         5
+#define WLAN_WMI_RX_EVENT_STATS      6
+#define WLAN_TSF_SYNC_STATS          7
+#define WLAN_MGMT_RX_BATCH_STATS     8
 #ifdef CONFIG_HL_SUPPORT
 #define WLAN_SCHEDULER_STATS        21
 #define WLAN_TX_QUEUE_STATS         22
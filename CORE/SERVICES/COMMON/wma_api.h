@@ -79,6 +79,7 @@ typedef enum {
     GEN_PARAM_MODULATED_DTIM,
     GEN_PARAM_CAPTURE_TSF,
     GEN_PARAM_RESET_TSF_GPIO,
+    GEN_PARAM_READ_TSF,
 } GEN_PARAM;
 
 #define VDEV_CMD 1
@@ -180,4 +181,8 @@ VOS_STATUS wma_set_tx_power_scale_decr_db(uint8_t vdev_id, int value);
 
 void wma_tx_failure_cb(void *ctx, uint32_t num_msdu,
 		       uint8_t tid, uint32_t status);
+
+void wma_display_wmi_rx_event_stats(void);
+void wma_clear_wmi_rx_event_stats(void);
+int wma_stats_snapshot_dump(char *buf, int len);
 #endif
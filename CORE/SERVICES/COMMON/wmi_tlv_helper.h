@@ -131,6 +131,17 @@ int
 wmitlv_check_and_pad_event_tlvs(
     void *os_ctx, void *param_struc_ptr, A_UINT32 param_buf_len, A_UINT32 wmi_cmd_event_id, void **wmi_cmd_struct_ptr);
 
+int
+wmitlv_check_and_pad_event_tlvs_prealloc(
+    void *os_ctx, void *param_struc_ptr, A_UINT32 param_buf_len, A_UINT32 wmi_cmd_event_id,
+    void *param_tlv_buf, A_UINT32 param_tlv_buf_len, A_UINT32 *num_allocs, void **wmi_cmd_struct_ptr);
+
+void
+wmitlv_free_prealloc_event_tlvs(
+    A_UINT32 event_id,
+    void *param_tlv_buf,
+    void **wmi_cmd_struct_ptr);
+
 /** This structure is the element for the Version WhiteList
  *  table. */
 typedef struct {
@@ -41,6 +41,20 @@ typedef adf_nbuf_t wmi_buf_t;
 #define wmi_buf_free(_buf) adf_nbuf_free(_buf)
 #define wmi_buf_data(_buf) adf_nbuf_data(_buf)
 
+/*
+ * Priority classes of the WMI events processed by the WMI rx work. Queued
+ * events of a higher class (lower value) are always processed first.
+ */
+enum wmi_rx_event_class {
+	WMI_RX_EVENT_CLASS_HIGH,
+	WMI_RX_EVENT_CLASS_NORMAL,
+	WMI_RX_EVENT_CLASS_MAX,
+};
+
+/* Event groups wmi_unified_set_event_prio() can move to the high class */
+#define WMI_RX_EVENT_PRIO_ROAM	0x1	/* roam synch and roam events */
+#define WMI_RX_EVENT_PRIO_VDEV	0x2	/* vdev start/stop/delete responses */
+
 /**
  * attach for unified WMI
  *
@@ -105,6 +119,45 @@ wmi_unified_register_event_handler(wmi_unified_t wmi_handle, WMI_EVT_ID event_id
 int
 wmi_unified_unregister_event_handler(wmi_unified_t wmi_handle, WMI_EVT_ID event_id);
 
+/**
+ * WMI function to set the priority class an event is processed with
+ *
+ *  @param wmi_handle      : handle to WMI.
+ *  @param event_id        : WMI event ID
+ *  @param evt_class       : priority class of the event
+ *  @return 0  on success and -ve on failure.
+ */
+int
+wmi_unified_set_event_class(wmi_unified_t wmi_handle, WMI_EVT_ID event_id,
+			    enum wmi_rx_event_class evt_class);
+
+/**
+ * WMI function to select the event groups processed with high priority
+ *
+ * Events of the vdev state group (start response, stopped, delete
+ * response) always share one class so their order is kept per vdev.
+ *
+ *  @param wmi_handle      : handle to WMI.
+ *  @param groups          : bitmap of WMI_RX_EVENT_PRIO_*, 0 keeps a
+ *                           single FIFO for all events
+ *  @return void
+ */
+void
+wmi_unified_set_event_prio(wmi_unified_t wmi_handle, u_int32_t groups);
+
+/**
+ * WMI functions to display/clear the per class rx event queue statistics
+ * and the hit/miss counts of the preallocated event param buffers
+ *
+ *  @param wmi_handle      : handle to WMI.
+ *  @return void
+ */
+void
+wmi_unified_display_rx_event_stats(wmi_unified_t wmi_handle);
+
+void
+wmi_unified_clear_rx_event_stats(wmi_unified_t wmi_handle);
+
 
 /**
  * request wmi to connet its htc service.
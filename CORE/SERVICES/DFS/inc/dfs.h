@@ -347,6 +347,7 @@ struct dfs_delayline {
    u_int32_t   dl_firstelem;     /* Index of the first element */
    u_int32_t   dl_lastelem;      /* Index of the last element */
    u_int32_t   dl_numelems;      /* Number of elements in the delay line */
+   u_int8_t    dl_dirty;         /* dl_elems written since the last reset */
 } adf_os_packed;
 #ifdef WIN32
 #pragma pack(pop, dfs_delayline)
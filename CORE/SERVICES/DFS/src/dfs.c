@@ -239,6 +239,8 @@ static int dfs_alloc_mem_filter(struct dfs_filtertype *radarf)
 			status = 1;
 			goto error;
 		}
+		/* delay line resets rely on dl_dirty being accurate */
+		vos_mem_zero(radarf->ft_filters[i], sizeof(struct dfs_filter));
 	}
 
 	return status;
@@ -160,6 +160,7 @@ dfs_add_pulse(struct ath_dfs *dfs, struct dfs_filter *rf, struct dfs_event *re,
    else
       dl->dl_numelems++;
    dl->dl_lastelem = index;
+   dl->dl_dirty = 1;
    dl->dl_elems[index].de_time = deltaT;
    dl->dl_elems[index].de_ts = this_ts;
         window = deltaT;
@@ -400,6 +401,7 @@ dfs_bin_pri_check(struct ath_dfs *dfs, struct dfs_filter *rf,
                          */
                         dindex = (delayindex+1)& DFS_MAX_DL_MASK;
                         dl->dl_elems[dindex].de_time -=  refpri;
+                        dl->dl_dirty = 1;
                         searchpri = refpri;
                 }
                 searchdur = dl->dl_elems[delayindex].de_dur;
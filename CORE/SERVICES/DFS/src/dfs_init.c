@@ -140,11 +140,18 @@ void dfs_reset_alldelaylines(struct ath_dfs *dfs)
 }
 /*
  * Clear only a single delay line
+ *
+ * Every pulse resets the delay lines of all filters whose duration window
+ * it falls outside of, so skip clearing element storage that has not been
+ * written since the last reset; the resulting state is identical.
  */
 
 void dfs_reset_delayline(struct dfs_delayline *dl)
 {
-   OS_MEMZERO(&(dl->dl_elems[0]), sizeof(dl->dl_elems));
+   if (dl->dl_dirty) {
+      OS_MEMZERO(&(dl->dl_elems[0]), sizeof(dl->dl_elems));
+      dl->dl_dirty = 0;
+   }
    dl->dl_lastelem = (0xFFFFFFFF)&DFS_MAX_DL_MASK;
 }
 
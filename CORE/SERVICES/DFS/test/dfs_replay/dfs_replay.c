@@ -0,0 +1,536 @@
+/*
+ * Copyright (c) 2016 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/*
+ * DFS replay harness
+ *
+ * Feeds radar pulse summary PHY errors through dfs_process_phyerr() and
+ * the radar task of a userspace build of the DFS module, and prints for
+ * each run where radar was found along with a digest of the filter and
+ * delay line state, so two revisions of the pattern matching code can be
+ * compared. See dfs_replay.sh, which builds the working tree and a git
+ * revision and diffs their output.
+ *
+ * Usage:
+ *   dfs_replay [-v] -r <seed> <runs>   replay generated pulse trains
+ *   dfs_replay [-v] -f <capture>       replay a captured pulse train
+ *
+ * A capture holds one run per "run" line followed by its pulses, e.g.
+ * from the radar_summary_print() traces or a WMI_PHYERR_EVENTID dump.
+ * The radar task runs at every "task" line and at the end of each run:
+ *
+ *   run <fcc|etsi|mkk4> <freq>
+ *   pulse <tsf> <dur> <rssi> <sidx> <is_chirp>
+ *   pe <tsf> <rssi> <phyerr buffer in hex>
+ *   task
+ *
+ * Time spent parsing PHY errors and matching pulses is reported on
+ * stderr.
+ */
+
+#include "dfs.h"
+#include "dfs_phyerr_tlv.h"
+#include "radar_filters.h"
+#include <time.h>
+
+#define DFS_REPLAY_MAX_PULSES 4096
+#define DFS_REPLAY_MAX_PE_LEN 256
+#define DFS_REPLAY_N(a) ((int)(sizeof(a) / sizeof((a)[0])))
+
+int dfs_replay_verbose;
+
+struct dfs_replay_pulse {
+    u_int64_t tsf;
+    u_int32_t dur;
+    u_int32_t rssi;
+    int32_t sidx;
+    u_int32_t is_chirp;
+};
+
+static struct ieee80211com ic;
+static struct ieee80211_channel curchan;
+static u_int32_t rnd_state;
+static int run_pulses;
+static int run_detect;
+static struct timespec parse_time, match_time;
+
+static u_int32_t rnd(void)
+{
+    rnd_state ^= rnd_state << 13;
+    rnd_state ^= rnd_state >> 17;
+    rnd_state ^= rnd_state << 5;
+    return rnd_state;
+}
+
+/* dfs_get_random_bin5_dur() only runs for pre-TLV chips. */
+void get_random_bytes(void *buf, int len)
+{
+    u_int8_t *p = buf;
+
+    while (len--)
+        *p++ = (u_int8_t)rnd();
+}
+
+static void timespec_add_since(struct timespec *acc,
+                               const struct timespec *start)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    acc->tv_sec += now.tv_sec - start->tv_sec;
+    acc->tv_nsec += now.tv_nsec - start->tv_nsec;
+    if (acc->tv_nsec < 0) {
+        acc->tv_nsec += 1000000000L;
+        acc->tv_sec--;
+    } else if (acc->tv_nsec >= 1000000000L) {
+        acc->tv_nsec -= 1000000000L;
+        acc->tv_sec++;
+    }
+}
+
+static int replay_dfs_attach(struct ieee80211com *ic, void *pcap,
+                             void *radar_info)
+{
+    struct ath_dfs_caps *caps = pcap;
+
+    caps->ath_chip_is_bb_tlv = 1;
+    return 0;
+}
+
+static int replay_dfs_enable(struct ieee80211com *ic, int *is_fastclk,
+                             void *pe)
+{
+    *is_fastclk = 1;
+    return 0;
+}
+
+static int replay_dfs_disable(struct ieee80211com *ic)
+{
+    return 0;
+}
+
+/* Both are place holders in the driver as well, see wma_dfs_interface.c */
+static u_int64_t replay_get_tsf64(struct ieee80211com *ic)
+{
+    return 0;
+}
+
+static int replay_get_ext_busy(struct ieee80211com *ic)
+{
+    return 0;
+}
+
+static void replay_notify_radar(struct ieee80211com *ic,
+                                struct ieee80211_channel *chan)
+{
+    if (run_detect < 0)
+        run_detect = run_pulses;
+}
+
+static struct ieee80211_channel *
+replay_find_channel(struct ieee80211com *ic, int freq, u_int32_t flags)
+{
+    return NULL;
+}
+
+static void replay_get_ext_chan_info(struct ieee80211com *ic,
+                                     struct ieee80211_channel_list *chan)
+{
+    chan->cl_nchans = 1;
+    chan->cl_channels[0] = ic->ic_curchan;
+}
+
+/* Run the deferred radar task the way its timer would. */
+static void run_task(void)
+{
+    struct ath_dfs *dfs = ic.ic_dfs;
+    struct timespec start;
+
+    if (!dfs->ath_dfs_task_timer.pending)
+        return;
+    dfs->ath_dfs_task_timer.pending = 0;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    dfs->ath_dfs_task_timer.fn(dfs->ath_dfs_task_timer.arg);
+    timespec_add_since(&match_time, &start);
+}
+
+static void send_phyerr(void *buf, u_int16_t len, u_int8_t rssi,
+                        u_int64_t tsf)
+{
+    struct timespec start;
+
+    /* Radar was reported; the driver stops queueing pulses on the channel */
+    if (run_detect >= 0)
+        return;
+    run_pulses++;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    dfs_process_phyerr(&ic, buf, len, rssi, rssi, (u_int32_t)tsf, tsf, 0);
+    timespec_add_since(&parse_time, &start);
+}
+
+/*
+ * Encode a pulse as the firmware reports it: a radar pulse summary TLV
+ * followed by a trailing DWORD, since tlv_parse_frame() treats a TLV
+ * ending exactly at the end of the buffer as oversize.
+ */
+static void send_pulse(const struct dfs_replay_pulse *p)
+{
+    u_int32_t buf[4];
+
+    buf[0] = SM(2 * sizeof(u_int32_t), TLV_LEN) |
+             SM(TAG_ID_RADAR_PULSE_SUMMARY, TLV_SIG);
+    buf[1] = SM(p->sidx & 0x3ff, RADAR_REPORT_PULSE_SIDX) |
+             SM(p->is_chirp, RADAR_REPORT_PULSE_IS_CHIRP);
+    buf[2] = SM(p->dur, RADAR_REPORT_PULSE_DUR);
+    buf[3] = 0;
+    send_phyerr(buf, sizeof(buf), p->rssi, p->tsf);
+}
+
+static int start_run(const char *domain, u_int32_t freq)
+{
+    struct ath_dfs_radar_tab_info rinfo;
+
+    if (ic.ic_dfs)
+        dfs_detach(&ic);
+
+    OS_MEMZERO(&curchan, sizeof(curchan));
+    curchan.ic_freq = freq;
+    curchan.ic_ieee = (freq - 5000) / 5;
+    curchan.ic_flags = IEEE80211_CHAN_5GHZ | IEEE80211_CHAN_OFDM |
+                       IEEE80211_CHAN_HT20;
+    curchan.ic_flagext = IEEE80211_CHAN_DFS;
+
+    OS_MEMZERO(&ic, sizeof(ic));
+    ic.ic_opmode = IEEE80211_M_HOSTAP;
+    ic.ic_curchan = &curchan;
+    ic.ic_dfs_attach = replay_dfs_attach;
+    ic.ic_dfs_enable = replay_dfs_enable;
+    ic.ic_dfs_disable = replay_dfs_disable;
+    ic.ic_get_TSF64 = replay_get_tsf64;
+    ic.ic_get_ext_busy = replay_get_ext_busy;
+    ic.ic_dfs_notify_radar = replay_notify_radar;
+    ic.ic_find_channel = replay_find_channel;
+    ic.ic_get_ext_chan_info = replay_get_ext_chan_info;
+
+    OS_MEMZERO(&rinfo, sizeof(rinfo));
+    if (!strcmp(domain, "fcc")) {
+        rinfo.dfsdomain = DFS_FCC_DOMAIN;
+        rinfo.dfs_radars = dfs_fcc_radars;
+        rinfo.numradars = DFS_REPLAY_N(dfs_fcc_radars);
+        rinfo.b5pulses = dfs_fcc_bin5pulses;
+        rinfo.numb5radars = DFS_REPLAY_N(dfs_fcc_bin5pulses);
+    } else if (!strcmp(domain, "etsi")) {
+        rinfo.dfsdomain = DFS_ETSI_DOMAIN;
+        rinfo.dfs_radars = dfs_etsi_radars;
+        rinfo.numradars = DFS_REPLAY_N(dfs_etsi_radars);
+    } else if (!strcmp(domain, "mkk4")) {
+        rinfo.dfsdomain = DFS_MKK4_DOMAIN;
+        rinfo.dfs_radars = dfs_mkk4_radars;
+        rinfo.numradars = DFS_REPLAY_N(dfs_mkk4_radars);
+        rinfo.b5pulses = dfs_jpn_bin5pulses;
+        rinfo.numb5radars = DFS_REPLAY_N(dfs_jpn_bin5pulses);
+    } else {
+        fprintf(stderr, "unknown DFS domain %s\n", domain);
+        return -1;
+    }
+    ic.current_dfs_regdomain = rinfo.dfsdomain;
+
+    if (dfs_attach(&ic) || dfs_radar_enable(&ic, &rinfo)) {
+        fprintf(stderr, "DFS attach failed\n");
+        return -1;
+    }
+    run_pulses = 0;
+    run_detect = -1;
+    return 0;
+}
+
+static u_int32_t digest_add(u_int32_t h, u_int64_t v)
+{
+    int i;
+
+    for (i = 0; i < 8; i++) {
+        h ^= (u_int8_t)(v >> (8 * i));
+        h *= 16777619;
+    }
+    return h;
+}
+
+static u_int32_t digest_filtertype(u_int32_t h, struct dfs_filtertype *ft)
+{
+    struct dfs_filter *rf;
+    u_int32_t j;
+
+    if (ft == NULL)
+        return h;
+    h = digest_add(h, ft->ft_last_ts);
+    for (j = 0; j < ft->ft_numfilters; j++) {
+        rf = ft->ft_filters[j];
+        h = digest_add(h, rf->rf_dl.dl_last_ts);
+        h = digest_add(h, rf->rf_dl.dl_numelems);
+        h = digest_add(h, rf->rf_dl.dl_firstelem);
+        h = digest_add(h, rf->rf_dl.dl_lastelem);
+    }
+    return h;
+}
+
+/*
+ * Digest of the matching state carried from one run of the radar task
+ * to the next, so a change that finds the same radars but leaves the
+ * filters in a different state still shows up as a difference.
+ */
+static u_int32_t state_digest(void)
+{
+    struct ath_dfs *dfs = ic.ic_dfs;
+    u_int32_t h = 2166136261U;
+    int i;
+
+    for (i = 0; i < DFS_MAX_RADAR_TYPES; i++) {
+        h = digest_filtertype(h, dfs->dfs_radarf[i]);
+        h = digest_filtertype(h, dfs->dfs_dc_radarf[i]);
+    }
+    for (i = 0; i < (int)dfs->dfs_rinfo.rn_numbin5radars; i++)
+        h = digest_add(h, dfs->dfs_b5radars[i].br_numelems);
+    h = digest_add(h, dfs->pulses->pl_numelems);
+    h = digest_add(h, dfs->pulses->pl_lastelem);
+    h = digest_add(h, dfs->dfs_rinfo.rn_ts_prefix);
+    h = digest_add(h, dfs->dfs_rinfo.rn_lastfull_ts);
+    h = digest_add(h, dfs->dfs_rinfo.rn_last_ts);
+    h = digest_add(h, dfs->dfs_rinfo.rn_last_unique_ts);
+    h = digest_add(h, dfs->dfs_rinfo.dfs_bin5_chirp_ts);
+    h = digest_add(h, dfs->dfs_rinfo.dfs_last_bin5_dur);
+    return h;
+}
+
+static void end_run(int n, const char *domain)
+{
+    struct ath_dfs *dfs = ic.ic_dfs;
+
+    run_task();
+    printf("run %d %s pulses %d queued %u detect %d state %08x\n",
+           n, domain, run_pulses, dfs->dfs_phyerr_queued_count,
+           run_detect, state_digest());
+}
+
+static int pulse_cmp(const void *a, const void *b)
+{
+    const struct dfs_replay_pulse *pa = a, *pb = b;
+
+    if (pa->tsf != pb->tsf)
+        return pa->tsf < pb->tsf ? -1 : 1;
+    /* Keep generation order for equal timestamps */
+    return pa < pb ? -1 : 1;
+}
+
+static int gen_radar(struct dfs_replay_pulse *p, int max, u_int64_t t,
+                     struct dfs_pulse *radars, int numradars,
+                     struct dfs_bin5pulse *b5)
+{
+    struct dfs_pulse *rp;
+    u_int32_t pri[3], freq, span;
+    int i, n, npri;
+
+    if (b5 && rnd() % (numradars + 1) == 0) {
+        /* A handful of chirps spread over the bin5 time window */
+        n = b5->b5_threshold + rnd() % 3;
+        span = b5->b5_timewindow * 1000000 / (n + 1);
+        for (i = 0; i < n && i < max; i++) {
+            t += span / 2 + rnd() % span;
+            p[i].tsf = t;
+            p[i].dur = b5->b5_mindur + rnd() % (b5->b5_maxdur - b5->b5_mindur);
+            p[i].rssi = b5->b5_rssithresh + 2 + rnd() % 10;
+            p[i].sidx = (int32_t)(rnd() % 41) - 20;
+            p[i].is_chirp = 1;
+        }
+        return i;
+    }
+
+    rp = &radars[rnd() % numradars];
+    npri = rp->rp_patterntype == 2 ? 2 + rnd() % 2 : 1;
+    for (i = 0; i < npri; i++) {
+        freq = rp->rp_pulsefreq;
+        if (rp->rp_max_pulsefreq > freq)
+            freq += rnd() % (rp->rp_max_pulsefreq - freq + 1);
+        pri[i] = 1000000 / freq;
+    }
+    n = rp->rp_numpulses - 2 + rnd() % 5;
+    for (i = 0; i < n && i < max; i++) {
+        t += pri[i % npri] + rnd() % 3 - 1;
+        p[i].tsf = t;
+        p[i].dur = rp->rp_mindur;
+        if (rp->rp_maxdur > rp->rp_mindur)
+            p[i].dur += rnd() % (rp->rp_maxdur - rp->rp_mindur + 1);
+        p[i].rssi = rp->rp_rssithresh + 3 + rnd() % 15;
+        p[i].sidx = (int32_t)(rnd() % 5) - 2;
+        p[i].is_chirp = 0;
+    }
+    return i;
+}
+
+/*
+ * Noise pulses with a radar burst from the domain's own filter table
+ * mixed in for most runs, delivered to the radar task in random size
+ * groups. Some runs start close to a 32 bit TSF wrap.
+ */
+static int replay_random(u_int32_t seed, int runs)
+{
+    static const char *domains[] = { "fcc", "etsi", "mkk4" };
+    static struct dfs_replay_pulse p[DFS_REPLAY_MAX_PULSES];
+    struct dfs_pulse *radars;
+    struct dfs_bin5pulse *b5;
+    const char *domain;
+    u_int64_t t;
+    int r, i, n, numradars, group, detected = 0;
+
+    rnd_state = seed ? seed : 1;
+    for (r = 0; r < runs; r++) {
+        domain = domains[rnd() % DFS_REPLAY_N(domains)];
+        if (start_run(domain, 5260 + 20 * (rnd() % 4)))
+            return 1;
+        if (!strcmp(domain, "fcc")) {
+            radars = dfs_fcc_radars;
+            numradars = DFS_REPLAY_N(dfs_fcc_radars);
+            b5 = dfs_fcc_bin5pulses;
+        } else if (!strcmp(domain, "etsi")) {
+            radars = dfs_etsi_radars;
+            numradars = DFS_REPLAY_N(dfs_etsi_radars);
+            b5 = NULL;
+        } else {
+            radars = dfs_mkk4_radars;
+            numradars = DFS_REPLAY_N(dfs_mkk4_radars);
+            b5 = dfs_jpn_bin5pulses;
+        }
+
+        t = rnd() % 4 ? rnd() % 100000 : 0xFFFFFFFFULL - rnd() % 2000000;
+        n = 20 + rnd() % 400;
+        for (i = 0; i < n; i++) {
+            t += 20 + rnd() % (rnd() % 2 ? 3000 : 40000);
+            p[i].tsf = t;
+            p[i].dur = 1 + rnd() % (rnd() % 4 ? 30 : 120);
+            p[i].rssi = rnd() % 45;
+            p[i].sidx = (int32_t)(rnd() % 201) - 100;
+            p[i].is_chirp = rnd() % 10 == 0;
+        }
+        if (rnd() % 4) {
+            t = p[rnd() % n].tsf;
+            n += gen_radar(&p[n], DFS_REPLAY_MAX_PULSES - n, t,
+                           radars, numradars, b5);
+        }
+        qsort(p, n, sizeof(p[0]), pulse_cmp);
+
+        group = 1 + rnd() % 48;
+        for (i = 0; i < n; i++) {
+            send_pulse(&p[i]);
+            if (--group == 0) {
+                run_task();
+                group = 1 + rnd() % 48;
+            }
+        }
+        end_run(r, domain);
+        if (run_detect >= 0)
+            detected++;
+    }
+    fprintf(stderr, "dfs_replay: %d of %d runs found radar\n",
+            detected, runs);
+    return 0;
+}
+
+static int hex_decode(const char *s, u_int8_t *buf, int max)
+{
+    unsigned int v;
+    int n = 0;
+
+    while (*s && n < max) {
+        if (sscanf(s, "%2x", &v) != 1)
+            break;
+        buf[n++] = (u_int8_t)v;
+        s += 2;
+    }
+    return n;
+}
+
+static int replay_capture(const char *path)
+{
+    FILE *f = fopen(path, "r");
+    char line[1024], domain[16] = "", next[16], hex[2 * DFS_REPLAY_MAX_PE_LEN + 1];
+    u_int8_t pe[DFS_REPLAY_MAX_PE_LEN];
+    struct dfs_replay_pulse p;
+    unsigned long long tsf;
+    unsigned int dur, rssi, chirp, freq;
+    int sidx, len, run = -1;
+
+    if (f == NULL) {
+        perror(path);
+        return 1;
+    }
+    while (fgets(line, sizeof(line), f)) {
+        if (sscanf(line, "run %15s %u", next, &freq) == 2) {
+            if (run >= 0)
+                end_run(run, domain);
+            strcpy(domain, next);
+            if (start_run(domain, freq))
+                break;
+            run++;
+        } else if (run < 0) {
+            continue;
+        } else if (sscanf(line, "pulse %llu %u %u %d %u",
+                          &tsf, &dur, &rssi, &sidx, &chirp) == 5) {
+            p.tsf = tsf;
+            p.dur = dur;
+            p.rssi = rssi;
+            p.sidx = sidx;
+            p.is_chirp = !!chirp;
+            send_pulse(&p);
+        } else if (sscanf(line, "pe %llu %u %512s", &tsf, &rssi, hex) == 3) {
+            len = hex_decode(hex, pe, sizeof(pe));
+            send_phyerr(pe, len, rssi, tsf);
+        } else if (!strncmp(line, "task", 4)) {
+            run_task();
+        }
+    }
+    if (run >= 0)
+        end_run(run, domain);
+    fclose(f);
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    int ret;
+
+    if (argc > 1 && !strcmp(argv[1], "-v")) {
+        dfs_replay_verbose = 1;
+        argc--;
+        argv++;
+    }
+    if (argc == 4 && !strcmp(argv[1], "-r"))
+        ret = replay_random(strtoul(argv[2], NULL, 0), atoi(argv[3]));
+    else if (argc == 3 && !strcmp(argv[1], "-f"))
+        ret = replay_capture(argv[2]);
+    else {
+        fprintf(stderr, "usage: dfs_replay [-v] -r <seed> <runs>\n"
+                        "       dfs_replay [-v] -f <capture>\n");
+        return 2;
+    }
+    if (ic.ic_dfs)
+        dfs_detach(&ic);
+
+    fprintf(stderr, "dfs_replay: parse %ld.%06ld s, match %ld.%06ld s\n",
+            (long)parse_time.tv_sec, parse_time.tv_nsec / 1000,
+            (long)match_time.tv_sec, match_time.tv_nsec / 1000);
+    return ret;
+}
@@ -0,0 +1 @@
+#include "dfs_stub.h"
@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2016 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/*
+ * Userspace stand-ins for the ADF, VOS and OS declarations the DFS
+ * sources use. Every external header the DFS module includes resolves
+ * to this file when building the DFS replay harness.
+ */
+#ifndef __DFS_STUB_H
+#define __DFS_STUB_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <sys/queue.h>
+
+typedef uint8_t u_int8_t;
+typedef uint16_t u_int16_t;
+typedef uint32_t u_int32_t;
+typedef uint64_t u_int64_t;
+typedef uint8_t u8;
+typedef uint16_t u16;
+typedef uint32_t u32;
+typedef uint64_t u64;
+typedef int8_t s8;
+typedef int32_t s32;
+typedef uint8_t a_uint8_t;
+typedef uint16_t a_uint16_t;
+typedef uint32_t a_uint32_t;
+typedef uint64_t a_uint64_t;
+typedef int32_t a_int32_t;
+typedef int a_status_t;
+typedef uint8_t v_U8_t;
+typedef uint16_t v_U16_t;
+typedef uint32_t v_U32_t;
+typedef void *v_PVOID_t;
+typedef uint8_t v_BOOL_t;
+typedef uint8_t tANI_U8;
+typedef uint16_t tANI_U16;
+typedef uint32_t tANI_U32;
+typedef int32_t tANI_S32;
+
+#define VOS_TRUE 1
+#define VOS_FALSE 0
+
+#define adf_os_packed __attribute__((packed))
+#define __iomem
+#define INLINE inline
+#define HZ 100
+#define KERN_INFO ""
+#define KERN_ERR ""
+#define GFP_ATOMIC 0
+#define GFP_KERNEL 0
+
+extern int dfs_replay_verbose;
+#define VOS_TRACE(mod, lvl, ...) \
+    do { if (dfs_replay_verbose) { printf(__VA_ARGS__); printf("\n"); } } while (0)
+#define printk(...) \
+    do { if (dfs_replay_verbose) printf(__VA_ARGS__); } while (0)
+#define FL(x) "%s: %d: " x, __func__, __LINE__
+
+typedef struct { int unused; } adf_os_spinlock_t;
+#define adf_os_spinlock_init(l) do { (void)(l); } while (0)
+#define adf_os_spin_lock_bh(l) do { (void)(l); } while (0)
+#define adf_os_spin_unlock_bh(l) do { (void)(l); } while (0)
+#define spin_lock_dpc(l) do { (void)(l); } while (0)
+#define spin_unlock_dpc(l) do { (void)(l); } while (0)
+#define spin_lock_init(l) do { (void)(l); } while (0)
+typedef adf_os_spinlock_t vos_spin_lock_t;
+
+#define adf_os_assert(x) do { if (!(x)) abort(); } while (0)
+#define __adf_os_abs(x) abs(x)
+
+#define OS_MALLOC(h, sz, f) malloc(sz)
+#define OS_FREE(p) free(p)
+#define OS_MEMZERO(p, sz) memset((p), 0, (sz))
+#define OS_MEMSET(p, v, sz) memset((p), (v), (sz))
+#define OS_MEMCPY(d, s, sz) memcpy((d), (s), (sz))
+#define adf_os_mem_copy(d, s, sz) memcpy((d), (s), (sz))
+#define vos_mem_zero(p, sz) memset((p), 0, (sz))
+#define vos_mem_malloc(sz) malloc(sz)
+#define vos_mem_free(p) free(p)
+#define vos_round_div(a, b) (((a) + (b) / 2) / (b))
+
+/*
+ * Timers never fire on their own; the replay driver runs the radar
+ * task itself, the way the deferred timer would.
+ */
+typedef void (*os_timer_func_t)(void *);
+typedef struct {
+    os_timer_func_t fn;
+    void *arg;
+    int pending;
+} os_timer_t;
+#define ADF_DEFERRABLE_TIMER 0
+#define OS_TIMER_FUNC(_fn) void _fn(void *timer_arg)
+#define OS_GET_TIMER_ARG(_arg, _type) (_arg) = (_type)(timer_arg)
+#define OS_INIT_TIMER(h, t, f, a, ty) \
+    do { (t)->fn = (os_timer_func_t)(f); (t)->arg = (a); (t)->pending = 0; } while (0)
+#define OS_SET_TIMER(t, ms) do { (t)->pending = 1; } while (0)
+#define OS_CANCEL_TIMER(t) do { (t)->pending = 0; } while (0)
+#define OS_FREE_TIMER(t) do { (t)->pending = 0; } while (0)
+
+typedef unsigned long adf_os_time_t;
+#define adf_os_ticks() 0UL
+#define adf_os_ticks_to_msecs(t) ((t) * 10)
+#define adf_os_time_after(a, b) ((long)(b) - (long)(a) < 0)
+
+void get_random_bytes(void *buf, int len);
+
+#endif /* __DFS_STUB_H */
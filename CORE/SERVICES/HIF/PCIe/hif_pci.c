@@ -3180,6 +3180,8 @@ int hif_pm_runtime_get(HIF_DEVICE *hif_device)
 	int ret = 0;
 	int pm_state = adf_os_atomic_read(&sc->pm_state);
 
+	hif_pci_pm_governor_tx(sc);
+
 	if (pm_state  == HIF_PM_RUNTIME_STATE_ON ||
 			pm_state == HIF_PM_RUNTIME_STATE_NONE) {
 		sc->pm_stats.runtime_get++;
@@ -47,6 +47,7 @@
 #include "vos_sched.h"
 #include "wma_api.h"
 #include "adf_os_atomic.h"
+#include "adf_os_time.h"
 #include "wlan_hdd_power.h"
 #include "wlan_hdd_main.h"
 #include "vos_cnss.h"
@@ -889,7 +890,164 @@ static void hif_pci_pm_work(struct work_struct *work)
 	msg_callbacks->txResumeAllHandler(msg_callbacks->Context);
 }
 
+/**
+ * hif_pci_pm_hist_add() - add a sample to a runtime PM histogram
+ * @hist: histogram, HIF_PM_HIST_BINS entries
+ * @val: sample
+ * @shift: log2 of the upper bound of bin 0
+ *
+ * Return: void
+ */
+static void hif_pci_pm_hist_add(u32 *hist, u64 val, int shift)
+{
+	int bin = 0;
+
+	val >>= shift;
+	while (val && bin < HIF_PM_HIST_BINS - 1) {
+		val >>= 1;
+		bin++;
+	}
+	hist[bin]++;
+}
+
+/**
+ * hif_pci_pm_governor_init() - set up the runtime PM delay governor
+ * @sc: hif pci context
+ *
+ * Return: void
+ */
+static void hif_pci_pm_governor_init(struct hif_pci_softc *sc)
+{
+	struct ol_softc *ol_sc = sc->ol_sc;
+	struct hif_pm_governor *gov = &sc->pm_gov;
+
+	memset(gov, 0, sizeof(*gov));
+	gov->enabled = ol_sc->runtime_pm_governor;
+	gov->min_delay = ol_sc->runtime_pm_delay_min;
+	gov->max_delay = ol_sc->runtime_pm_delay_max;
+	if (gov->max_delay < gov->min_delay)
+		gov->max_delay = gov->min_delay;
+	gov->cur_delay = ol_sc->runtime_pm_delay;
+	if (gov->cur_delay < gov->min_delay)
+		gov->cur_delay = gov->min_delay;
+	if (gov->cur_delay > gov->max_delay)
+		gov->cur_delay = gov->max_delay;
+	gov->last_tx_jiffies = jiffies;
+	gov->window_start = gov->last_tx_jiffies;
+	atomic_set(&gov->bursts, 0);
+
+	if (gov->enabled)
+		pr_info("%s: runtime PM governor on, delay %u ms (%u - %u)\n",
+			__func__, gov->cur_delay, gov->min_delay,
+			gov->max_delay);
+}
+
+/**
+ * hif_pci_pm_governor_sample() - fold the last busy window into the average
+ * @sc: hif pci context
+ *
+ * Called when the bus autosuspends. The accesses counted since the last
+ * resume are spread over the time from that resume to the last access,
+ * giving one inter-arrival sample for the 1/8 weighted moving average.
+ *
+ * Return: void
+ */
+static void hif_pci_pm_governor_sample(struct hif_pci_softc *sc)
+{
+	struct hif_pm_governor *gov = &sc->pm_gov;
+	unsigned long last = ACCESS_ONCE(gov->last_tx_jiffies);
+	u32 bursts, gap;
+
+	if (!gov->enabled)
+		return;
+
+	bursts = atomic_xchg(&gov->bursts, 0);
+	if (!bursts || time_before(last, gov->window_start))
+		return;
+
+	gap = jiffies_to_msecs(last - gov->window_start) / bursts;
+	if (!gap)
+		return;
+	if (gap > HIF_PM_GOV_MAX_GAP_MS)
+		gap = HIF_PM_GOV_MAX_GAP_MS;
+	gov->avg_gap_ms = gov->avg_gap_ms ?
+		(gov->avg_gap_ms * 7 + gap) / 8 : gap;
+}
+
+/**
+ * hif_pci_pm_governor_update() - pick the next runtime PM inactivity delay
+ * @sc: hif pci context
+ * @suspended_ms: how long the bus stayed suspended before this resume
+ *
+ * A wakeup that comes within the current delay of the suspend means the
+ * suspend cost a resume without saving more idle time than was already
+ * spent waiting, so the delay is doubled right away. Otherwise the delay
+ * moves half way towards twice the average access gap, so the bus stays
+ * up across the gaps of bursty traffic, or towards the minimum delay when
+ * the traffic is too sparse for that to pay off.
+ *
+ * Return: void
+ */
+static void hif_pci_pm_governor_update(struct hif_pci_softc *sc,
+				       u32 suspended_ms)
+{
+	struct hif_pm_governor *gov = &sc->pm_gov;
+	u32 target, delay;
+
+	if (!gov->enabled)
+		return;
+
+	/* start the next sampling window at this resume */
+	gov->window_start = jiffies;
+	atomic_set(&gov->bursts, 0);
+
+	if (suspended_ms < gov->cur_delay) {
+		gov->early_wake++;
+		delay = gov->cur_delay * 2;
+	} else {
+		if (gov->avg_gap_ms && gov->avg_gap_ms * 2 <= gov->max_delay)
+			target = gov->avg_gap_ms * 2;
+		else
+			target = gov->min_delay;
+		delay = (gov->cur_delay + target) / 2;
+	}
+
+	if (delay < gov->min_delay)
+		delay = gov->min_delay;
+	if (delay > gov->max_delay)
+		delay = gov->max_delay;
+
+	if (delay == gov->cur_delay)
+		return;
+
+	gov->cur_delay = delay;
+	gov->updates++;
+
+	vos_runtime_set_autosuspend_delay(sc->dev, delay);
+}
+
 #ifdef WLAN_OPEN_SOURCE
+/**
+ * hif_pci_autopm_hist_show() - print one runtime PM histogram
+ * @s: seq file
+ * @name: histogram name
+ * @hist: histogram, HIF_PM_HIST_BINS entries
+ * @shift: log2 of the upper bound of bin 0
+ * @unit: unit of the samples
+ *
+ * Return: void
+ */
+static void hif_pci_autopm_hist_show(struct seq_file *s, const char *name,
+				     u32 *hist, int shift, const char *unit)
+{
+	int i;
+
+	seq_printf(s, "%30s:", name);
+	for (i = 0; i < HIF_PM_HIST_BINS - 1; i++)
+		seq_printf(s, " <%u%s:%u", 1U << (shift + i), unit, hist[i]);
+	seq_printf(s, " >=%u%s:%u\n", 1U << (shift + i - 1), unit, hist[i]);
+}
+
 static int hif_pci_autopm_debugfs_show(struct seq_file *s, void *data)
 {
 #define HIF_PCI_AUTOPM_STATS(_s, _sc, _name) \
@@ -930,6 +1088,22 @@ static int hif_pci_autopm_debugfs_show(struct seq_file *s, void *data)
 	HIF_PCI_AUTOPM_STATS(s, sc, prevent_suspend_timeout);
 	HIF_PCI_AUTOPM_STATS(s, sc, allow_suspend_timeout);
 	HIF_PCI_AUTOPM_STATS(s, sc, runtime_get_err);
+	hif_pci_autopm_hist_show(s, "suspend_time", sc->pm_stats.suspend_hist,
+				 HIF_PM_HIST_DURATION_SHIFT, "us");
+	hif_pci_autopm_hist_show(s, "resume_time", sc->pm_stats.resume_hist,
+				 HIF_PM_HIST_DURATION_SHIFT, "us");
+	hif_pci_autopm_hist_show(s, "woken_after", sc->pm_stats.wake_hist,
+				 HIF_PM_HIST_WAKE_SHIFT, "ms");
+	if (sc->pm_gov.enabled) {
+		seq_printf(s, "%30s: %u ms\n", "Governor delay",
+			   sc->pm_gov.cur_delay);
+		seq_printf(s, "%30s: %u ms\n", "Governor avg gap",
+			   sc->pm_gov.avg_gap_ms);
+		seq_printf(s, "%30s: %u\n", "Governor early wake",
+			   sc->pm_gov.early_wake);
+		seq_printf(s, "%30s: %u\n", "Governor updates",
+			   sc->pm_gov.updates);
+	}
 	timer_expires = sc->runtime_timer_expires;
 	if (timer_expires > 0) {
 		msecs_age = jiffies_to_msecs(timer_expires - jiffies);
@@ -1208,6 +1382,7 @@ static int __hif_pci_runtime_suspend(struct pci_dev *pdev)
 	v_VOID_t *temp_module;
 	ol_txrx_pdev_handle txrx_pdev;
 	int ret = -EBUSY, test = 0;
+	u64 start_us = adf_os_get_monotonic_us();
 
 	if (vos_is_load_unload_in_progress(VOS_MODULE_ID_HIF, NULL)) {
 		pr_err("%s: Load/Unload in Progress\n", __func__);
@@ -1285,6 +1460,11 @@ static int __hif_pci_runtime_suspend(struct pci_dev *pdev)
 	adf_os_atomic_set(&sc->pm_state, HIF_PM_RUNTIME_STATE_SUSPENDED);
 	sc->pm_stats.suspended++;
 	sc->pm_stats.suspend_jiffies = jiffies;
+	sc->pm_stats.suspend_us = adf_os_get_monotonic_us();
+	hif_pci_pm_hist_add(sc->pm_stats.suspend_hist,
+			    sc->pm_stats.suspend_us - start_us,
+			    HIF_PM_HIST_DURATION_SHIFT);
+	hif_pci_pm_governor_sample(sc);
 
 	return 0;
 
@@ -1315,6 +1495,8 @@ static int __hif_pci_runtime_resume(struct pci_dev *pdev)
 	void *vos_context = vos_get_global_context(VOS_MODULE_ID_HIF, NULL);
 	int ret = 0;
 	v_VOID_t * temp_module;
+	u64 start_us = adf_os_get_monotonic_us();
+	u32 suspended_ms;
 
 	adf_os_atomic_set(&sc->pm_state, HIF_PM_RUNTIME_STATE_INPROGRESS);
 
@@ -1356,6 +1538,14 @@ static int __hif_pci_runtime_resume(struct pci_dev *pdev)
 	hif_pm_runtime_mark_last_busy(sc->dev);
 	sc->pm_stats.resumed++;
 
+	suspended_ms = div_u64(start_us - sc->pm_stats.suspend_us, 1000);
+	hif_pci_pm_hist_add(sc->pm_stats.resume_hist,
+			    adf_os_get_monotonic_us() - start_us,
+			    HIF_PM_HIST_DURATION_SHIFT);
+	hif_pci_pm_hist_add(sc->pm_stats.wake_hist, suspended_ms,
+			    HIF_PM_HIST_WAKE_SHIFT);
+	hif_pci_pm_governor_update(sc, suspended_ms);
+
 	schedule_work(&sc->pm_work);
 
 	return 0;
@@ -1459,7 +1649,9 @@ static void hif_pci_pm_runtime_init(struct hif_pci_softc *sc)
 			ol_sc->runtime_pm_delay);
 
 	vos_init_work(&sc->pm_work, hif_pci_pm_work);
-	vos_runtime_init(sc->dev, ol_sc->runtime_pm_delay);
+	hif_pci_pm_governor_init(sc);
+	vos_runtime_init(sc->dev, sc->pm_gov.enabled ?
+			 sc->pm_gov.cur_delay : ol_sc->runtime_pm_delay);
 	adf_os_atomic_set(&sc->pm_state, HIF_PM_RUNTIME_STATE_ON);
 	hif_pci_pm_debugfs(sc, true);
 }
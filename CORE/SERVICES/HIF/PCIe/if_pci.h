@@ -62,6 +62,17 @@ enum hif_pm_runtime_state {
 	HIF_PM_RUNTIME_STATE_SUSPENDED,
 };
 
+/*
+ * Runtime PM histograms use power of two bins: bin 0 counts samples
+ * below 1 << shift, bin i samples below 1 << (shift + i) and the last
+ * bin everything above.
+ */
+#define HIF_PM_HIST_BINS                8
+/* suspend / resume duration, in us: 1 ms .. 64 ms */
+#define HIF_PM_HIST_DURATION_SHIFT      10
+/* time spent suspended before the next wakeup, in ms: 16 ms .. 1 s */
+#define HIF_PM_HIST_WAKE_SHIFT          4
+
 /* Debugging stats for Runtime PM */
 struct hif_pci_pm_stats {
 	u32 suspended;
@@ -77,6 +88,40 @@ struct hif_pci_pm_stats {
 	u32 runtime_get_err;
 	void *last_resume_caller;
 	unsigned long suspend_jiffies;
+	u64 suspend_us;
+	u32 suspend_hist[HIF_PM_HIST_BINS];
+	u32 resume_hist[HIF_PM_HIST_BINS];
+	u32 wake_hist[HIF_PM_HIST_BINS];
+};
+
+/**
+ * struct hif_pm_governor - adaptive runtime PM inactivity delay
+ * @enabled: governor picks the autosuspend delay
+ * @min_delay: lower bound of the delay, ms
+ * @max_delay: upper bound of the delay, ms
+ * @cur_delay: autosuspend delay currently programmed, ms
+ * @last_tx_jiffies: jiffy of the last bus access request
+ * @window_start: jiffy the current sampling window started at
+ * @bursts: jiffies with at least one bus access in the current window
+ * @avg_gap_ms: moving average of the bus access inter-arrival time
+ * @early_wake: wakeups that came within @cur_delay of the suspend
+ * @updates: number of times the delay was changed
+ *
+ * Only @last_tx_jiffies and @bursts are touched on the tx path; the rest
+ * is updated from the runtime suspend and resume callbacks, which the PM
+ * core never runs concurrently.
+ */
+struct hif_pm_governor {
+	bool enabled;
+	u32 min_delay;
+	u32 max_delay;
+	u32 cur_delay;
+	unsigned long last_tx_jiffies;
+	unsigned long window_start;
+	atomic_t bursts;
+	u32 avg_gap_ms;
+	u32 early_wake;
+	u32 updates;
 };
 #endif
 struct hif_pci_softc {
@@ -124,6 +169,7 @@ struct hif_pci_softc {
     atomic_t pm_state;
     uint32_t prevent_suspend_cnt;
     struct hif_pci_pm_stats pm_stats;
+    struct hif_pm_governor pm_gov;
     struct work_struct pm_work;
     struct spinlock runtime_lock;
     struct timer_list runtime_timer;
@@ -137,6 +183,35 @@ struct hif_pci_softc {
 #endif /*WLAN_OPEN_SOURCE*/
 #endif /*FEATURE_RUNTIME_PM*/
 };
+#ifdef FEATURE_RUNTIME_PM
+/* cap on a single inter-arrival sample fed to the governor, ms */
+#define HIF_PM_GOV_MAX_GAP_MS 600000
+
+/**
+ * hif_pci_pm_governor_tx() - account a bus access request for the governor
+ * @sc: hif pci context
+ *
+ * Called for every runtime PM get, so it takes no lock: it only counts
+ * the jiffies that saw an access. Accesses within the same jiffy belong
+ * to one burst; two CPUs racing into a new jiffy may count it twice,
+ * which the average tolerates. hif_pci_pm_governor_sample() turns the
+ * count into the average gap when the bus autosuspends.
+ *
+ * Return: none
+ */
+static inline void hif_pci_pm_governor_tx(struct hif_pci_softc *sc)
+{
+	struct hif_pm_governor *gov = &sc->pm_gov;
+	unsigned long now = jiffies;
+
+	if (!gov->enabled || ACCESS_ONCE(gov->last_tx_jiffies) == now)
+		return;
+
+	ACCESS_ONCE(gov->last_tx_jiffies) = now;
+	atomic_inc(&gov->bursts);
+}
+#endif
+
 #define TARGID(sc) ((A_target_id_t)(&(sc)->mem))
 #define TARGID_TO_HIF(targid) (((struct hif_pci_softc *)((char *)(targid) - (char *)&(((struct hif_pci_softc *)0)->mem)))->hif_device)
 
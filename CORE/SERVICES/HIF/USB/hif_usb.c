@@ -884,6 +884,7 @@ void HIFDumpInfo(HIF_DEVICE *hif)
 	HIF_USB_PIPE *pipe = NULL;
 	struct usb_host_interface *iface_desc = NULL;
 	struct usb_endpoint_descriptor *ep_desc;
+	struct hif_usb_rx_bundle_stats *stats = &device->rx_bundle_stats;
 	A_UINT8 i = 0;
 	for (i = 0; i < HIF_USB_PIPE_MAX; i++) {
 		pipe = &device->pipes[i];
@@ -901,6 +902,14 @@ void HIFDumpInfo(HIF_DEVICE *hif)
 			pr_info("Pipe Type control\n");
 	}
 
+	pr_info("rx bundle: bundles %u frames %u\n",
+		stats->bundles, stats->frames);
+	for (i = 0; i < HIF_USB_RX_BUNDLE_FILL_BINS; i++)
+		pr_info("rx bundle fill %3d-%3d%%: %u\n",
+			i * 100 / HIF_USB_RX_BUNDLE_FILL_BINS,
+			(i + 1) * 100 / HIF_USB_RX_BUNDLE_FILL_BINS,
+			stats->fill[i]);
+
 	for (i = 0; i < iface_desc->desc.bNumEndpoints; i++) {
 		ep_desc = &iface_desc->endpoint[i].desc;
 		if (ep_desc) {
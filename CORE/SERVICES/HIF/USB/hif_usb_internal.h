@@ -43,6 +43,8 @@
 
 #define HIF_USB_RX_BUFFER_SIZE  (1792 + 8)
 #define HIF_USB_RX_BUNDLE_ONE_PKT_SIZE  (1792 + 8)
+/* bins of the rx bundle fill level histogram, each 1/n of the buffer */
+#define HIF_USB_RX_BUNDLE_FILL_BINS     10
 
 /* USB Endpoint definition */
 typedef enum {
@@ -113,6 +115,12 @@ typedef struct _HIF_USB_PIPE {
 	A_INT32 urb_prestart_cnt;
 } HIF_USB_PIPE;
 
+struct hif_usb_rx_bundle_stats {
+	A_UINT32 bundles;
+	A_UINT32 frames;
+	A_UINT32 fill[HIF_USB_RX_BUNDLE_FILL_BINS];
+};
+
 typedef struct _HIF_DEVICE_USB {
 	spinlock_t cs_lock;
 	spinlock_t tx_lock;
@@ -130,6 +138,7 @@ typedef struct _HIF_DEVICE_USB {
 	A_BOOL is_bundle_enabled;
 	A_UINT16 rx_bundle_cnt;
 	A_UINT32 rx_bundle_buf_len;
+	struct hif_usb_rx_bundle_stats rx_bundle_stats;
 } HIF_DEVICE_USB;
 extern unsigned int hif_usb_disable_rxdata2;
 
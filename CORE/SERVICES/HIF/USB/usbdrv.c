@@ -617,6 +617,8 @@ static void usb_hif_usb_recv_bundle_complete(struct urb *urb)
 	HTC_FRAME_HDR *HtcHdr;
 	A_UINT16 payloadLen;
 	adf_nbuf_t new_skb = NULL;
+	struct hif_usb_rx_bundle_stats *stats = &pipe->device->rx_bundle_stats;
+	A_UINT32 fill;
 
 	AR_DEBUG_PRINTF(USB_HIF_DEBUG_BULK_IN, (
 			 "+%s: recv pipe: %d, stat:%d,len:%d urb:0x%p\n",
@@ -669,6 +671,13 @@ static void usb_hif_usb_recv_bundle_complete(struct urb *urb)
 		adf_nbuf_peek_header(buf, &netdata, &netlen);
 		netlen = urb->actual_length;
 
+		stats->bundles++;
+		fill = (urb->actual_length * HIF_USB_RX_BUNDLE_FILL_BINS) /
+			pipe->device->rx_bundle_buf_len;
+		if (fill >= HIF_USB_RX_BUNDLE_FILL_BINS)
+			fill = HIF_USB_RX_BUNDLE_FILL_BINS - 1;
+		stats->fill[fill]++;
+
 		do {
 			A_UINT16 frame_len;
 
@@ -715,6 +724,7 @@ static void usb_hif_usb_recv_bundle_complete(struct urb *urb)
 				adf_nbuf_put_tail(new_skb, frame_len);
 				skb_queue_tail(&pipe->io_comp_queue, new_skb);
 				new_skb = NULL;
+				stats->frames++;
 
 				netdata += frame_len;
 				netlen -= frame_len;
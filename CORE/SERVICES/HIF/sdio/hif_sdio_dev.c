@@ -402,6 +402,22 @@ A_STATUS HIFDevSetup(HIF_SDIO_DEVICE *pDev)
         break;
     }
 
+    /* see if the HIF layer can scatter a bundled read straight into the
+     * per-message rx buffers, the scatter engine works in HIF_MBOX_BLOCK_SIZE
+     * blocks so the mailbox block size has to agree with it */
+    pDev->RxScatterEnabled = FALSE;
+    if ((pDev->BlockSize == HIF_MBOX_BLOCK_SIZE) &&
+        (HIFConfigureDevice(hif_device,
+                HIF_CONFIGURE_QUERY_SCATTER_REQUEST_SUPPORT,
+                &pDev->RxScatterInfo,
+                sizeof(pDev->RxScatterInfo)) == A_OK)) {
+        AR_DEBUG_PRINTF(ATH_DEBUG_TRC,
+                ("HIF scatter rx enabled, max entries: %d max length: %d\n",
+                 pDev->RxScatterInfo.MaxScatterEntries,
+                 pDev->RxScatterInfo.MaxTransferSizePerScatterReq));
+        pDev->RxScatterEnabled = TRUE;
+    }
+
     pDev->HifMaskUmaskRecvEvent = NULL;
 
     /* see if the HIF layer implements the mask/unmask recv events function  */
@@ -92,6 +92,17 @@ typedef PREPACK struct _MBOX_COUNTER_REGISTERS {
 #define SDIO_NUM_DATA_RX_BUFFERS  64
 #define SDIO_DATA_RX_SIZE         1664
 
+/*
+ * Bounds on how many rx bundles one pass of the pending handler may pull
+ * before it hands back to the DSR, which re-reads the interrupt status and
+ * services the other sources. The budget scales between the two with the
+ * running average of the lookahead depth reported by the target.
+ */
+#define HIF_SDIO_RX_BUNDLES_PER_IRQ_MIN   2
+#define HIF_SDIO_RX_BUNDLES_PER_IRQ_MAX   16
+/* lookahead depth average is kept in 1/16th of a message */
+#define HIF_SDIO_RX_DEPTH_AVG_SHIFT       4
+
 struct TAG_HIF_SDIO_DEVICE {
     HIF_DEVICE *HIFDevice;
     A_MUTEX_T Lock;
@@ -112,6 +123,10 @@ struct TAG_HIF_SDIO_DEVICE {
     int RecheckIRQStatusCnt;
     A_UINT32 RecvStateFlags;
 	void *pTarget;
+    /* scatter support for reading rx bundles into the per-message buffers */
+    HIF_DEVICE_SCATTER_SUPPORT_INFO RxScatterInfo;
+    A_BOOL RxScatterEnabled;
+    int RxLookAheadDepthAvg;
 };
 
 #define LOCK_HIF_DEV(device)    A_MUTEX_LOCK(&(device)->Lock);
@@ -612,6 +612,39 @@ static A_STATUS HIFDevProcessRecvHeader(HIF_SDIO_DEVICE *pDev,
     return status;
 }
 
+/**
+ * HIFDevAllocRxScatterReq() - get a scatter request for an rx bundle
+ * @pDev: SDIO HIF device
+ *
+ * The HIF layer drops its scatter requests when the SDIO function is
+ * disabled, so an empty free list after a power cycle is answered by
+ * asking it for a fresh set once.
+ *
+ * Return: scatter request, or NULL if the bundle has to be bounced
+ */
+static HIF_SCATTER_REQ *HIFDevAllocRxScatterReq(HIF_SDIO_DEVICE *pDev)
+{
+    HIF_SCATTER_REQ *pReq;
+
+    if (!pDev->RxScatterEnabled)
+        return NULL;
+
+    pReq = pDev->RxScatterInfo.pAllocateReqFunc(pDev->HIFDevice);
+    if (pReq != NULL)
+        return pReq;
+
+    if (HIFConfigureDevice(pDev->HIFDevice,
+            HIF_CONFIGURE_QUERY_SCATTER_REQUEST_SUPPORT,
+            &pDev->RxScatterInfo,
+            sizeof(pDev->RxScatterInfo)) != A_OK) {
+        AR_DEBUG_PRINTF(ATH_DEBUG_WARN,
+                ("%s: scatter support gone, bouncing rx bundles\n", __func__));
+        pDev->RxScatterEnabled = FALSE;
+        return NULL;
+    }
+    return pDev->RxScatterInfo.pAllocateReqFunc(pDev->HIFDevice);
+}
+
 static A_STATUS HIFDevIssueRecvPacketBundle(HIF_SDIO_DEVICE *pDev,
         HTC_PACKET_QUEUE *pRecvPktQueue,
         HTC_PACKET_QUEUE *pSyncCompletionQueue,
@@ -621,9 +654,11 @@ static A_STATUS HIFDevIssueRecvPacketBundle(HIF_SDIO_DEVICE *pDev,
 { A_STATUS status = A_OK;
     int i, totalLength = 0;
     unsigned char    *pBundleBuffer = NULL;
-    HTC_PACKET *pPacket, *pPacketRxBundle;
+    HTC_PACKET *pPacket, *pPacketRxBundle = NULL;
     HTC_TARGET *target = NULL;
     A_UINT32 paddedLength;
+    HIF_SCATTER_REQ *pScatterReq;
+    int maxMessages;
 
     int bundleSpaceRemaining = 0;
     target = (HTC_TARGET *)pDev->pTarget;
@@ -634,22 +669,33 @@ static A_STATUS HIFDevIssueRecvPacketBundle(HIF_SDIO_DEVICE *pDev,
         return A_ERROR;
     }
 
-    if((HTC_PACKET_QUEUE_DEPTH(pRecvPktQueue) - HTC_MAX_MSG_PER_BUNDLE_RX) > 0){
-        PartialBundle = TRUE;
-        AR_DEBUG_PRINTF(ATH_DEBUG_WARN, ("%s, partial bundle detected num: %d, %d \n",
-                __FUNCTION__, HTC_PACKET_QUEUE_DEPTH(pRecvPktQueue),  HTC_MAX_MSG_PER_BUNDLE_RX));
+    /* when the HIF can scatter, each message is read straight into its own
+     * rx netbuf; otherwise the bundle lands in a bundle buffer and is copied
+     * out message by message */
+    pScatterReq = HIFDevAllocRxScatterReq(pDev);
+    if (pScatterReq) {
+        bundleSpaceRemaining = pDev->RxScatterInfo.MaxTransferSizePerScatterReq;
+        maxMessages = adf_os_min(pDev->RxScatterInfo.MaxScatterEntries,
+                                 HTC_MAX_MSG_PER_BUNDLE_RX);
+    } else {
+        bundleSpaceRemaining = HTC_MAX_MSG_PER_BUNDLE_RX * target->TargetCreditSize;
+        maxMessages = HTC_MAX_MSG_PER_BUNDLE_RX;
+        pPacketRxBundle = AllocateHTCBundleRxPacket(target);
+        if (!pPacketRxBundle) {
+            AR_DEBUG_PRINTF(ATH_DEBUG_ERR, ("%s: pPacketRxBundle is NULL \n",
+                __FUNCTION__));
+            return A_NO_MEMORY;
+        }
+        pBundleBuffer = pPacketRxBundle->pBuffer;
     }
 
-    bundleSpaceRemaining = HTC_MAX_MSG_PER_BUNDLE_RX * target->TargetCreditSize;
-    pPacketRxBundle = AllocateHTCBundleRxPacket(target);
-    if (!pPacketRxBundle) {
-        AR_DEBUG_PRINTF(ATH_DEBUG_ERR, ("%s: pPacketRxBundle is NULL \n",
-            __FUNCTION__));
-        return A_NO_MEMORY;
+    if((HTC_PACKET_QUEUE_DEPTH(pRecvPktQueue) - maxMessages) > 0){
+        PartialBundle = TRUE;
+        AR_DEBUG_PRINTF(ATH_DEBUG_WARN, ("%s, partial bundle detected num: %d, %d \n",
+                __FUNCTION__, HTC_PACKET_QUEUE_DEPTH(pRecvPktQueue), maxMessages));
     }
-    pBundleBuffer = pPacketRxBundle->pBuffer;
 
-    for(i = 0; !HTC_QUEUE_EMPTY(pRecvPktQueue) && i < HTC_MAX_MSG_PER_BUNDLE_RX; i++){
+    for(i = 0; !HTC_QUEUE_EMPTY(pRecvPktQueue) && i < maxMessages; i++){
         pPacket = HTC_PACKET_DEQUEUE(pRecvPktQueue);
         if (pPacket == NULL)
             break;
@@ -659,7 +705,7 @@ static A_STATUS HIFDevIssueRecvPacketBundle(HIF_SDIO_DEVICE *pDev,
         else
             paddedLength = DEV_CALC_RECV_PADDED_LEN(pDev, pPacket->ActualLength);
 
-        if((bundleSpaceRemaining - paddedLength) < 0){
+        if((int)paddedLength > bundleSpaceRemaining){
             /* exceeds what we can transfer, put the packet back */
             HTC_PACKET_ENQUEUE_TO_HEAD(pRecvPktQueue, pPacket);
             break;
@@ -671,10 +717,26 @@ static A_STATUS HIFDevIssueRecvPacketBundle(HIF_SDIO_DEVICE *pDev,
         }
         pPacket->PktInfo.AsRx.HTCRxFlags |= HTC_RX_PKT_PART_OF_BUNDLE;
 
+        if (pScatterReq) {
+            /* the rx buffer was sized for the padded length, including
+             * the extra block of the last bundled message */
+            pScatterReq->ScatterList[i].pBuffer = pPacket->pBuffer;
+            pScatterReq->ScatterList[i].Length = paddedLength;
+        }
+
         HTC_PACKET_ENQUEUE(pSyncCompletionQueue, pPacket);
 
         totalLength += paddedLength;
     }
+
+    if (i == 0) {
+        /* nothing fitted, let the caller fetch the head packet on its own */
+        if (pScatterReq)
+            pDev->RxScatterInfo.pFreeReqFunc(pDev->HIFDevice, pScatterReq);
+        else
+            FreeHTCBundleRxPacket(target, pPacketRxBundle);
+        return A_OK;
+    }
 #if DEBUG_BUNDLE
     adf_os_print("Recv bundle count %d, length %d.\n",
        HTC_PACKET_QUEUE_DEPTH(pSyncCompletionQueue), totalLength);
@@ -685,25 +747,42 @@ static A_STATUS HIFDevIssueRecvPacketBundle(HIF_SDIO_DEVICE *pDev,
         target->rx_bundle_stats[HTC_PACKET_QUEUE_DEPTH(pSyncCompletionQueue) - 1]++;
 #endif
 
-
+    if (pScatterReq) {
+        pScatterReq->Address = pDev->MailBoxInfo.MboxAddresses[(int)MailBoxIndex];
+        pScatterReq->Request = HIF_RD_SYNC_BLOCK_FIX;
+        pScatterReq->TotalLength = totalLength;
+        pScatterReq->ValidScatterEntries = i;
+        pScatterReq->CompletionRoutine = NULL;
+        pScatterReq->Context = pDev;
+        status = pDev->RxScatterInfo.pReadWriteScatterFunc(pDev->HIFDevice,
+                                                           pScatterReq);
+        pDev->RxScatterInfo.pFreeReqFunc(pDev->HIFDevice, pScatterReq);
+    } else {
 #ifdef HIF_SYNC_READ
-    status = HIFSyncRead(pDev->HIFDevice,
-                pDev->MailBoxInfo.MboxAddresses[(int)MailBoxIndex],
-                pBundleBuffer,
-                totalLength,
-                HIF_RD_SYNC_BLOCK_FIX,
-                NULL);
+        status = HIFSyncRead(pDev->HIFDevice,
+                    pDev->MailBoxInfo.MboxAddresses[(int)MailBoxIndex],
+                    pBundleBuffer,
+                    totalLength,
+                    HIF_RD_SYNC_BLOCK_FIX,
+                    NULL);
 #else
-    status = HIFReadWrite(pDev->HIFDevice,
-                pDev->MailBoxInfo.MboxAddresses[(int)MailBoxIndex],
-                pBundleBuffer,
-                totalLength,
-                HIF_RD_SYNC_BLOCK_FIX,
-                NULL);
+        status = HIFReadWrite(pDev->HIFDevice,
+                    pDev->MailBoxInfo.MboxAddresses[(int)MailBoxIndex],
+                    pBundleBuffer,
+                    totalLength,
+                    HIF_RD_SYNC_BLOCK_FIX,
+                    NULL);
 #endif
+    }
 
     if(status != A_OK){
         AR_DEBUG_PRINTF(ATH_DEBUG_ERR, ("%s, HIFSend Failed status:%d \n",__FUNCTION__, status));
+    }else if (pScatterReq) {
+        *pNumPacketsFetched = i;
+#if defined(DEBUG_HL_LOGGING) && defined(CONFIG_HL_SUPPORT)
+        target->rx_bundle_scatter++;
+        target->rx_bundle_bytes_not_copied += totalLength;
+#endif
     }else{
         unsigned char *pBuffer = pBundleBuffer;
         *pNumPacketsFetched = i;
@@ -715,11 +794,44 @@ static A_STATUS HIFDevIssueRecvPacketBundle(HIF_SDIO_DEVICE *pDev,
             A_MEMCPY(pPacket->pBuffer, pBuffer, paddedLength);
             pBuffer += paddedLength;
         }HTC_PACKET_QUEUE_ITERATE_END;
+#if defined(DEBUG_HL_LOGGING) && defined(CONFIG_HL_SUPPORT)
+        target->rx_bundle_bounce++;
+#endif
     }
     /* free bundle space under Sync mode */
-    FreeHTCBundleRxPacket(target, pPacketRxBundle);
+    if (pPacketRxBundle)
+        FreeHTCBundleRxPacket(target, pPacketRxBundle);
     return status;
 }
+
+/**
+ * HIFDevRxBundleBudget() - bundles to pull before returning to the DSR
+ * @pDev: SDIO HIF device
+ * @Depth: messages announced by the lookaheads just processed
+ *
+ * A deep lookahead means the target has a backlog that is cheapest to drain
+ * bundle after bundle off the trailer lookaheads; a shallow one means the
+ * messages trickle in and the DSR is better off re-reading the interrupt
+ * status so the other sources and tx get serviced in between.
+ *
+ * Return: number of bundles this pass of the pending handler may fetch
+ */
+static int HIFDevRxBundleBudget(HIF_SDIO_DEVICE *pDev, int Depth)
+{
+    int depth;
+
+    /* running average over the last eight reports */
+    pDev->RxLookAheadDepthAvg +=
+        ((Depth << HIF_SDIO_RX_DEPTH_AVG_SHIFT) -
+         pDev->RxLookAheadDepthAvg) / 8;
+    depth = pDev->RxLookAheadDepthAvg >> HIF_SDIO_RX_DEPTH_AVG_SHIFT;
+
+    return HIF_SDIO_RX_BUNDLES_PER_IRQ_MIN +
+        (adf_os_min(depth, HTC_MAX_MSG_PER_BUNDLE_RX) *
+         (HIF_SDIO_RX_BUNDLES_PER_IRQ_MAX - HIF_SDIO_RX_BUNDLES_PER_IRQ_MIN)) /
+        HTC_MAX_MSG_PER_BUNDLE_RX;
+}
+
 A_STATUS HIFDevRecvMessagePendingHandler(HIF_SDIO_DEVICE *pDev,
         A_UINT8 MailBoxIndex,
         A_UINT32 MsgLookAheads[],
@@ -736,6 +848,7 @@ A_STATUS HIFDevRecvMessagePendingHandler(HIF_SDIO_DEVICE *pDev,
     A_BOOL partialBundle;
     HTC_ENDPOINT_ID id;
     int totalFetched = 0;
+    int bundles = 0, budget;
 
     HTC_TARGET *target = NULL;
 
@@ -804,6 +917,8 @@ A_STATUS HIFDevRecvMessagePendingHandler(HIF_SDIO_DEVICE *pDev,
             break;
         }
         totalFetched += HTC_PACKET_QUEUE_DEPTH(&recvPktQueue);
+        budget = HIFDevRxBundleBudget(pDev,
+                HTC_PACKET_QUEUE_DEPTH(&recvPktQueue));
 
         /* we've got packet buffers for all we can currently fetch,
          * this count is not valid anymore  */
@@ -919,6 +1034,15 @@ A_STATUS HIFDevRecvMessagePendingHandler(HIF_SDIO_DEVICE *pDev,
             /* no more look aheads */
             break;
         }
+        if (++bundles >= budget) {
+            /* leave the rest to the DSR, it picks the lookahead up again
+             * from the interrupt status after servicing the other sources */
+            pDev->RecheckIRQStatusCnt++;
+#if defined(DEBUG_HL_LOGGING) && defined(CONFIG_HL_SUPPORT)
+            target->rx_bundle_budget_yields++;
+#endif
+            break;
+        }
         /* check whether other OS contexts have queued any WMI command/data for WLAN.
          * This check is needed only if WLAN Tx and Rx happens in same thread context */
         A_CHECK_DRV_TX();
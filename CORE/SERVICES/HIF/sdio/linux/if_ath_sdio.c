@@ -117,6 +117,13 @@ static inline void *hif_get_virt_ramdump_mem(unsigned long *size)
 	size_t length = 0;
 	int flags = GFP_KERNEL;
 
+	/* The ram dump is streamed to a collector instead of being buffered */
+	if (ol_ramdump_stream_enabled()) {
+		if (size != NULL)
+			*size = 0;
+		return NULL;
+	}
+
 	length = DRAM_SIZE + IRAM_SIZE + AXI_SIZE;
 
 	if (size != NULL)
@@ -226,6 +233,10 @@ ath_hif_sdio_probe(void *context, void *hif_handle)
 
     ol_sc->hif_hdl = hif_handle;
 
+    if (ol_ramdump_stream_init()) {
+        VOS_TRACE(VOS_MODULE_ID_HIF, VOS_TRACE_LEVEL_ERROR,
+            "%s: Failed to init RAM dump stream", __func__);
+    }
     /* Get RAM dump memory address and size */
     ol_sc->ramdump_base = hif_get_virt_ramdump_mem(&ol_sc->ramdump_size);
     if (ol_sc->ramdump_base == NULL || !ol_sc->ramdump_size) {
@@ -320,6 +331,11 @@ ath_hif_sdio_remove(void *context, void *hif_handle)
         hdd_wlan_shutdown();
     } else {
         __hdd_wlan_exit();
+        /*
+         * Driver unload, remove the ram dump stream. The SSR path above
+         * leaves it open so collectors can still read the dump.
+         */
+        ol_ramdump_stream_deinit();
     }
     if (sc && sc->ol_sc){
        hif_deinit_adf_ctx(sc->ol_sc);
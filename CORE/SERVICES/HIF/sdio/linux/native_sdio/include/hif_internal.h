@@ -68,6 +68,19 @@ typedef struct bus_request {
     struct _HIF_SCATTER_REQ_PRIV *pScatterReq;      /* this request is a scatter request */
 } BUS_REQUEST;
 
+/* batch sizes are binned by power of two, the last bin takes the rest */
+#define HIF_ASYNC_BATCH_HIST_BINS          7
+
+struct hif_async_batch_stats {
+    A_UINT32 batches;                /* host claims by the async task */
+    A_UINT32 requests;               /* requests carried by those claims */
+    A_UINT32 claims_skipped;         /* wakeups that found the queue drained */
+    A_UINT32 max_batch;
+    A_UINT32 hist[HIF_ASYNC_BATCH_HIST_BINS];
+    A_UINT64 claim_us_total;         /* time the host was held for batches */
+    A_UINT32 claim_us_max;
+};
+
 #ifdef HIF_MBOX_SLEEP_WAR
 typedef enum {
     HIF_MBOX_UNKNOWN_STATE,
@@ -86,6 +99,7 @@ struct hif_device {
     struct completion async_completion;          /* thread completion */
     BUS_REQUEST   *asyncreq;                    /* request for async tasklet */
     BUS_REQUEST *taskreq;                       /*  async tasklet data */
+    struct hif_async_batch_stats async_stats;   /* async task batching */
 #ifdef TX_COMPLETION_THREAD
     struct task_struct *tx_completion_task;
     struct semaphore sem_tx_completion;
@@ -39,6 +39,7 @@
 #include "vos_api.h"
 #include "wma_api.h"
 #include "hif_internal.h"
+#include "hif_msg_based.h"
 #include "adf_os_time.h"
 /* by default setup a bounce buffer for the data packets, if the underlying host controller driver
    does not use DMA you may be able to skip this step and save the memory allocation and transfer time */
@@ -143,7 +144,14 @@ static int Func0_CMD52ReadByte(struct mmc_card *card, unsigned int address, unsi
 int reset_sdio_on_unload = 0;
 module_param(reset_sdio_on_unload, int, 0644);
 
-A_UINT32 nohifscattersupport = 1;
+unsigned int nohifscattersupport;
+module_param(nohifscattersupport, uint, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+MODULE_PARM_DESC(nohifscattersupport, "Set as 1 to read rx bundles through a bounce buffer instead of scatter requests");
+
+/* requests the async task carries per host claim, 0 takes the whole queue */
+unsigned int hif_async_batch_max = 16;
+module_param(hif_async_batch_max, uint, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+MODULE_PARM_DESC(hif_async_batch_max, "Max bus requests issued per SDIO host claim");
 
 A_UINT32 forcedriverstrength = 1; /* force driver strength to type D */
 
@@ -952,13 +960,70 @@ static inline void hif_stop_tx_completion_thread(HIF_DEVICE *device)
 }
 #endif
 
+/**
+ * hif_async_take_batch() - Detach the next batch of queued requests
+ * @device:    device handle.
+ * @count:     set to the number of requests detached.
+ *
+ * Return: first request of the batch, linked through inusenext.
+ */
+static BUS_REQUEST *hif_async_take_batch(HIF_DEVICE *device, int *count)
+{
+    unsigned long flags;
+    BUS_REQUEST *head, *last = NULL, *request;
+    int max = hif_async_batch_max ? hif_async_batch_max : BUS_REQUEST_MAX_NUM;
+    int n = 0;
+
+    spin_lock_irqsave(&device->asynclock, flags);
+    head = device->asyncreq;
+    for (request = head; request != NULL && n < max; n++) {
+        last = request;
+        request = request->inusenext;
+    }
+    if (last != NULL)
+        last->inusenext = NULL;
+    device->asyncreq = request;
+    spin_unlock_irqrestore(&device->asynclock, flags);
+
+    *count = n;
+    return head;
+}
+
+/**
+ * hif_async_batch_account() - Record one batch in the async statistics
+ * @device:    device handle.
+ * @count:     requests carried by the batch.
+ * @claimed:   time the host was claimed.
+ *
+ * Return: None.
+ */
+static void hif_async_batch_account(HIF_DEVICE *device, int count,
+                                    ktime_t claimed)
+{
+    struct hif_async_batch_stats *stats = &device->async_stats;
+    A_UINT32 held = (A_UINT32)ktime_us_delta(ktime_get(), claimed);
+    int bin = fls(count) - 1;
+
+    if (bin >= HIF_ASYNC_BATCH_HIST_BINS)
+        bin = HIF_ASYNC_BATCH_HIST_BINS - 1;
+    stats->hist[bin]++;
+    stats->batches++;
+    stats->requests += count;
+    if (count > stats->max_batch)
+        stats->max_batch = count;
+    stats->claim_us_total += held;
+    if (held > stats->claim_us_max)
+        stats->claim_us_max = held;
+}
+
 /* thread to serialize all requests, both sync and async */
 static int async_task(void *param)
  {
     HIF_DEVICE *device;
-    BUS_REQUEST *request;
+    BUS_REQUEST *request, *next, *batch;
     A_STATUS status;
-    unsigned long flags;
+    ktime_t claimed;
+    int count;
 
     device = (HIF_DEVICE *)param;
     AR_DEBUG_PRINTF(ATH_DEBUG_TRACE, ("AR6000: async task\n"));
@@ -982,18 +1047,21 @@ static int async_task(void *param)
             continue;
         }
 #endif
-        /* we want to hold the host over multiple cmds if possible, but holding the host blocks card interrupts */
+        /* every queued request ups the semaphore, a batch consumes several
+         * of them at once so the wakeups left over find nothing to do and
+         * must not claim the host for it */
+        batch = hif_async_take_batch(device, &count);
+        if (batch == NULL) {
+            device->async_stats.claims_skipped++;
+            continue;
+        }
+
+        /* hold the host over the whole batch, but not longer: holding the
+         * host blocks card interrupts */
         sdio_claim_host(device->func);
-        spin_lock_irqsave(&device->asynclock, flags);
-        /* pull the request to work on */
-        while (device->asyncreq != NULL) {
-            request = device->asyncreq;
-            if (request->inusenext != NULL) {
-                device->asyncreq = request->inusenext;
-            } else {
-                device->asyncreq = NULL;
-            }
-            spin_unlock_irqrestore(&device->asynclock, flags);
+        claimed = ktime_get();
+        for (request = batch; request != NULL; request = next) {
+            next = request->inusenext;
             AR_DEBUG_PRINTF(ATH_DEBUG_TRACE, ("AR6000: async_task processing req: 0x%lX\n", (unsigned long)request));
 #ifdef HIF_MBOX_SLEEP_WAR
             /* write request pending for mailbox(1-3),
@@ -1014,23 +1082,22 @@ static int async_task(void *param)
                      * executes it synchronously, note, no need to free the request since scatter requests
                      * are maintained on a separate list */
                 status = DoHifReadWriteScatter(device,request);
+                continue;
+            }
+
+                /* call HIFReadWrite in sync mode to do the work */
+            status = __HIFReadWrite(device, request->address, request->buffer,
+                                  request->length, request->request & ~HIF_SYNCHRONOUS, NULL);
+            request->status = status;
+            if (request->request & HIF_ASYNCHRONOUS) {
+                hif_free_bus_request(device, request);
             } else {
-                    /* call HIFReadWrite in sync mode to do the work */
-                status = __HIFReadWrite(device, request->address, request->buffer,
-                                      request->length, request->request & ~HIF_SYNCHRONOUS, NULL);
-                if (request->request & HIF_ASYNCHRONOUS) {
-                    request->status = status;
-                    hif_free_bus_request(device, request);
-                } else {
-                    AR_DEBUG_PRINTF(ATH_DEBUG_TRACE, ("AR6000: async_task upping req: 0x%lX\n", (unsigned long)request));
-                    request->status = status;
-                    up(&request->sem_req);
-                }
+                AR_DEBUG_PRINTF(ATH_DEBUG_TRACE, ("AR6000: async_task upping req: 0x%lX\n", (unsigned long)request));
+                up(&request->sem_req);
             }
-            spin_lock_irqsave(&device->asynclock, flags);
         }
-        spin_unlock_irqrestore(&device->asynclock, flags);
         sdio_release_host(device->func);
+        hif_async_batch_account(device, count, claimed);
     }
 
     complete_and_exit(&device->async_completion, 0);
@@ -2680,6 +2747,34 @@ void HIFDumpCCCR(HIF_DEVICE *hif_device)
    printk("\n");
 }
 
+/**
+ * HIFDumpInfo() - Print the async task batching statistics
+ * @hif_device: HIF device handle
+ *
+ * Return: None
+ */
+void HIFDumpInfo(HIF_DEVICE *hif_device)
+{
+    struct hif_async_batch_stats *stats;
+    int i;
+
+    if (!hif_device)
+        return;
+
+    stats = &hif_device->async_stats;
+    AR_DEBUG_PRINTF(ATH_DEBUG_ANY,
+        ("SDIO async: batches %u requests %u claims skipped %u max batch %u\n",
+         stats->batches, stats->requests,
+         stats->claims_skipped, stats->max_batch));
+    AR_DEBUG_PRINTF(ATH_DEBUG_ANY,
+        ("SDIO async: host held %llu us total, %u us max\n",
+         (unsigned long long)stats->claim_us_total, stats->claim_us_max));
+    for (i = 0; i < HIF_ASYNC_BATCH_HIST_BINS; i++)
+        AR_DEBUG_PRINTF(ATH_DEBUG_ANY,
+            ("  batch >= %3d: %u\n",
+             1 << i, stats->hist[i]));
+}
+
 void HIFsuspendwow(HIF_DEVICE *hif_device)
 {
     printk(KERN_INFO "HIFsuspendwow TODO\n");
@@ -82,8 +82,8 @@ static HIF_SCATTER_REQ *AllocScatterReq(HIF_DEVICE *device)
     return NULL;
 }
 
-    /* called by async task to perform the operation synchronously using direct MMC APIs  */
-A_STATUS DoHifReadWriteScatter(HIF_DEVICE *device, BUS_REQUEST *busrequest)
+    /* issue a scatter request with direct MMC APIs, the caller holds the host */
+static A_STATUS HifIssueScatter(HIF_DEVICE *device, HIF_SCATTER_REQ_PRIV *pReqPriv)
 {
     int                     i;
     A_UINT8                 rw;
@@ -91,18 +91,10 @@ A_STATUS DoHifReadWriteScatter(HIF_DEVICE *device, BUS_REQUEST *busrequest)
     struct mmc_request      mmcreq;
     struct mmc_command      cmd;
     struct mmc_data         data;
-    HIF_SCATTER_REQ_PRIV   *pReqPriv;
     HIF_SCATTER_REQ        *pReq;
     A_STATUS                status = A_OK;
     struct                  scatterlist *pSg;
 
-    ENTER();
-
-    pReqPriv = busrequest->pScatterReq;
-
-    if (pReqPriv == NULL)
-        return A_ERROR;
-
     pReq = pReqPriv->pHifScatterReq;
 
     memset(&mmcreq, 0, sizeof(struct mmc_request));
@@ -191,6 +183,26 @@ A_STATUS DoHifReadWriteScatter(HIF_DEVICE *device, BUS_REQUEST *busrequest)
         /* set completion status, fail or success */
     pReq->CompletionStatus = status;
 
+    return status;
+}
+
+    /* called by async task to perform the operation synchronously using direct MMC APIs  */
+A_STATUS DoHifReadWriteScatter(HIF_DEVICE *device, BUS_REQUEST *busrequest)
+{
+    HIF_SCATTER_REQ_PRIV   *pReqPriv;
+    HIF_SCATTER_REQ        *pReq;
+    A_STATUS                status;
+
+    ENTER();
+
+    pReqPriv = busrequest->pScatterReq;
+
+    if (pReqPriv == NULL)
+        return A_ERROR;
+
+    pReq = pReqPriv->pHifScatterReq;
+    status = HifIssueScatter(device, pReqPriv);
+
     if (pReq->Request & HIF_ASYNCHRONOUS) {
         AR_DEBUG_PRINTF(ATH_DEBUG_SCATTER, ("HIF-SCATTER: async_task completion routine req: 0x%lX (%d)\n",(unsigned long)busrequest, status));
             /* complete the request */
@@ -251,6 +263,17 @@ static A_STATUS HifReadWriteScatter(HIF_DEVICE *device, HIF_SCATTER_REQ *pReq)
             break;
         }
 
+#ifdef HIF_SYNC_READ
+        if (request & HIF_SYNCHRONOUS) {
+            /* like HIFSyncRead, run it in the caller's context instead of
+             * handing it to the async I/O thread and sleeping on it */
+            sdio_claim_host(device->func);
+            status = HifIssueScatter(device, pReqPriv);
+            sdio_release_host(device->func);
+            break;
+        }
+#endif
+
             /* add bus request to the async list for the async I/O thread to process */
         AddToAsyncList(device, pReqPriv->busrequest);
 
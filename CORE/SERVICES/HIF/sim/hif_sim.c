@@ -0,0 +1,2117 @@
+/*
+ * Copyright (c) 2016 The Linux Foundation. All rights reserved.
+ *
+ * Previously licensed under the ISC license by Qualcomm Atheros, Inc.
+ *
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/*
+ * This file was originally distributed by Qualcomm Atheros, Inc.
+ * under proprietary terms before Copyright ownership was assigned
+ * to the Linux Foundation.
+ */
+
+/*
+ * Message based HIF on top of an emulated target.
+ *
+ * Every transfer posted by HTC lands in a per-pipe ring. A single ordered
+ * work item plays the role of the target: it drains the rings at the
+ * configured wire rate, completes the transfers back to HTC, returns the
+ * HTC credits they consumed and answers what it understands:
+ *   - BMI: GET_TARGET_INFO reports a Rome 2.1, word sized memory and
+ *     register writes are kept for later reads, image downloads are
+ *     accepted and dropped. The firmware images are still requested, so
+ *     files of any content must be installed under the usual names.
+ *   - HTC: READY_EX, CONNECT_SERVICE and SETUP_COMPLETE(_EX)
+ *   - WMI: SERVICE_READY after setup complete, READY in answer to INIT,
+ *     and HTT peer map/unmap for PEER_CREATE/PEER_DELETE. Every other
+ *     command is accepted without a reply.
+ *   - HTT: VERSION_CONF, tx completion of every TX_FRM, and in-order rx
+ *     indications of ethernet frames from the last peer created when
+ *     hif_sim_htt_rx_len is set. The host needs gReorderOffloadSupported
+ *     for those.
+ *   - endpoint ping: echo, no-echo, rx counters and continuous rx
+ *
+ * The target follows the HTT rx ring bus addresses with phys_to_virt(),
+ * so the host must be cache coherent and must not sit behind an IOMMU.
+ */
+#include <linux/module.h>
+#include <linux/workqueue.h>
+#include <linux/ktime.h>
+#include <linux/vmalloc.h>
+#include <linux/debugfs.h>
+#include <linux/uaccess.h>
+#include <linux/io.h>
+#include <linux/if_ether.h>
+#include <linux/in.h>
+#include "adf_net_types.h"
+#include <adf_nbuf.h>
+#include <athdefs.h>
+#include "a_types.h"
+#include "a_osapi.h"
+#include <hif.h>
+#include <hif_msg_based.h>
+#include <htc.h>
+#include <htc_packet.h>
+#include <htc_services.h>
+#include "bmi_msg.h"
+#include "ol_fw.h"
+#include <ol_if_athvar.h>
+#include "vos_api.h"
+#include "epping_main.h"
+#include "epping_test.h"
+#include "wmi.h"
+#include "wmi_version.h"
+#include "htt.h"
+#include "rx_desc.h"
+#include <if_sim.h>
+#define ATH_MODULE_NAME hif
+#include <a_debug.h>
+
+#ifdef WLAN_DEBUG
+ATH_DEBUG_INSTANTIATE_MODULE_VAR(hif,
+				 "hif",
+				 "Emulated Host Interface",
+				 ATH_DEBUG_MASK_DEFAULTS | ATH_DEBUG_INFO,
+				 0,
+				 NULL);
+#endif
+
+#define HIF_SIM_PIPE_TX_CTRL        0
+#define HIF_SIM_PIPE_RX_CTRL        1
+#define HIF_SIM_PIPE_TX_DATA        2
+#define HIF_SIM_PIPE_RX_DATA        3
+#define HIF_SIM_TX_PIPE_MAX         2
+#define HIF_SIM_TX_PIPE_IDX(pipe)   ((pipe) >> 1)
+
+#define HIF_SIM_MAX_QUEUE_DEPTH     512
+#define HIF_SIM_MAX_MSG_LEN         (HTC_HDR_LENGTH + HTC_MAX_PAYLOAD_LENGTH)
+/* transfers handled per pass of the target work before it yields */
+#define HIF_SIM_WORK_BUDGET         64
+/* largest burst the wire rate limiter lets through at once, in bytes */
+#define HIF_SIM_WIRE_BURST          (64 * 1024)
+#define HIF_SIM_MEM_WORDS           128
+#define HIF_SIM_STATS_BUF_LEN       1024
+
+#define HIF_SIM_MAX_PEERS           32
+#define HIF_SIM_INVALID_PEER        0xffff
+/* msdu ids carried by one HTT tx completion indication */
+#define HIF_SIM_TX_COMPL_MAX        64
+/* msdus carried by one HTT in-order rx indication */
+#define HIF_SIM_RX_IND_MSDUS        16
+/* time before an empty host rx ring is looked at again */
+#define HIF_SIM_RX_RETRY_US         1000
+/* rx_msdu_start decap_format of an ethernet II frame */
+#define HIF_SIM_RX_DECAP_ETH2       3
+#define HIF_SIM_IP_HDR_LEN          20
+#define HIF_SIM_UDP_HDR_LEN         8
+#define HIF_SIM_RX_MIN_LEN \
+	(ETH_HLEN + HIF_SIM_IP_HDR_LEN + HIF_SIM_UDP_HDR_LEN)
+#define HIF_SIM_FW_BUILD_VERS       0x5100
+
+/* use credit flow control over HTC */
+unsigned int htc_credit_flow = 1;
+module_param(htc_credit_flow, uint, 0644);
+
+/* HTC credits and credit size advertised in the emulated READY message */
+static unsigned int hif_sim_credits = 32;
+module_param(hif_sim_credits, uint, 0644);
+static unsigned int hif_sim_credit_size = 1664;
+module_param(hif_sim_credit_size, uint, 0644);
+
+/* transfers each tx pipe accepts before HIFSend_head pushes back */
+static unsigned int hif_sim_queue_depth = 128;
+module_param(hif_sim_queue_depth, uint, 0644);
+
+/* emulated bus rate in Mbps shared by tx and rx, 0 is unlimited */
+static unsigned int hif_sim_rate_mbps;
+module_param(hif_sim_rate_mbps, uint, 0644);
+
+/* minimum time between HIFSend_head and the send completion */
+static unsigned int hif_sim_latency_us;
+module_param(hif_sim_latency_us, uint, 0644);
+
+/*
+ * length of the UDP frames indicated through HTT rx, 0 disables rx. A new
+ * value takes effect with the next message the host sends.
+ */
+static unsigned int hif_sim_htt_rx_len;
+module_param(hif_sim_htt_rx_len, uint, 0644);
+
+/* MAC address reported in WMI_READY_EVENTID and used as rx destination */
+static const A_UINT8 hif_sim_mac_addr[ETH_ALEN] = {
+	0x00, 0x03, 0x7f, 0x5e, 0x00, 0x01 };
+/* IPv4 source and destination of the generated rx frames */
+static const A_UINT8 hif_sim_rx_ip[2][4] = {
+	{ 192, 168, 1, 2 }, { 192, 168, 1, 1 } };
+
+struct hif_sim_xfer {
+	adf_nbuf_t nbuf;
+	unsigned int transfer_id;
+	unsigned int nbytes;
+	ktime_t queued;
+};
+
+struct hif_sim_tx_pipe {
+	struct hif_sim_xfer ring[HIF_SIM_MAX_QUEUE_DEPTH];
+	unsigned int head;
+	unsigned int count;
+	unsigned int depth;
+	bool stalled;
+};
+
+/* target side view of an HTC endpoint */
+struct hif_sim_ep {
+	a_uint16_t service_id;
+	bool credit_flow;
+	unsigned int credits_owed;
+};
+
+struct hif_sim_mem_word {
+	A_UINT32 address;
+	A_UINT32 value;
+};
+
+struct hif_sim_peer {
+	bool valid;
+	A_UINT8 vdev_id;
+	A_UINT8 mac_addr[ETH_ALEN];
+};
+
+/* host rx ring as described by HTT_H2T_MSG_TYPE_RX_RING_CFG */
+struct hif_sim_rx_ring {
+	bool valid;
+	A_UINT32 *paddrs;
+	A_UINT32 *alloc_idx;
+	unsigned int size_mask;
+	unsigned int rd_idx;
+	unsigned int buf_size;
+	/* offsets from the start of an rx buffer, in bytes */
+	unsigned int attn_offset;
+	unsigned int mpdu_start_offset;
+	unsigned int msdu_start_offset;
+	unsigned int msdu_end_offset;
+	unsigned int payload_offset;
+};
+
+struct hif_sim_stats {
+	u64 tx_msgs;
+	u64 tx_bytes;
+	u64 tx_queue_full;
+	u64 rx_msgs;
+	u64 rx_bytes;
+	u64 rx_alloc_fail;
+	u64 credits_returned;
+	u64 credit_reports;
+	u64 ctrl_msgs;
+	u64 epping_echo;
+	u64 epping_cont_rx;
+	u64 unhandled;
+	u64 bmi_msgs;
+	u64 wmi_cmds;
+	u64 wmi_events;
+	u64 htt_tx_compl;
+	u64 htt_rx_msdus;
+	u64 htt_rx_ring_empty;
+	u64 tx_lat_sum_us;
+	u32 tx_lat_max_us;
+};
+
+typedef struct _HIF_DEVICE_SIM {
+	struct hif_sim_softc *sc;
+	void *claimed_context;
+	MSG_BASED_HIF_CALLBACKS htc_callbacks;
+
+	/* protects the tx rings and the running flag */
+	spinlock_t tx_lock;
+	struct hif_sim_tx_pipe tx_pipes[HIF_SIM_TX_PIPE_MAX];
+	bool running;
+
+	struct workqueue_struct *wq;
+	struct delayed_work target_work;
+
+	/* emulated target state, only touched by target_work */
+	bool ready_pending;
+	bool setup_done;
+	A_UINT8 next_ep;
+	struct hif_sim_ep eps[ENDPOINT_MAX];
+	A_UINT32 epping_rx_cnt;
+	bool cont_rx;
+	A_UINT8 cont_rx_ep;
+	A_UINT16 cont_rx_len;
+	A_UINT16 cont_rx_flags;
+	A_UINT32 cont_rx_seq;
+	s64 wire_budget;
+	ktime_t wire_stamp;
+	A_UINT8 *tgt_buf;
+	A_UINT8 wmi_ep;
+	A_UINT8 htt_ep;
+	struct hif_sim_peer peers[HIF_SIM_MAX_PEERS];
+	A_UINT16 rx_peer_id;
+	A_UINT16 rx_seq;
+	struct hif_sim_rx_ring rx_ring;
+	A_UINT16 tx_compl_ids[HIF_SIM_TX_COMPL_MAX];
+	int tx_compl_cnt;
+
+	/* target memory and registers, protected by sc->target_lock */
+	struct hif_sim_mem_word mem[HIF_SIM_MEM_WORDS];
+	int mem_cnt;
+
+	struct hif_sim_stats stats;
+	struct dentry *stats_file;
+} HIF_DEVICE_SIM;
+
+OSDRV_CALLBACKS osDrvcallback;
+
+static inline unsigned int hif_sim_credits_for(unsigned int len)
+{
+	unsigned int credits;
+
+	if (len <= hif_sim_credit_size)
+		return 1;
+	credits = len / hif_sim_credit_size;
+	if (len % hif_sim_credit_size)
+		credits++;
+	return credits;
+}
+
+/**
+ * hif_sim_wire_refill() - top up the emulated bus byte budget
+ * @device: emulated HIF device
+ *
+ * The budget grows with the time elapsed since the last refill at
+ * hif_sim_rate_mbps and is capped at HIF_SIM_WIRE_BURST.
+ *
+ * Return: none
+ */
+static void hif_sim_wire_refill(HIF_DEVICE_SIM *device)
+{
+	ktime_t now = ktime_get();
+	s64 elapsed_ns;
+
+	if (!hif_sim_rate_mbps)
+		return;
+
+	elapsed_ns = ktime_to_ns(ktime_sub(now, device->wire_stamp));
+	device->wire_stamp = now;
+	device->wire_budget += div_s64(elapsed_ns * hif_sim_rate_mbps, 8000);
+	if (device->wire_budget > HIF_SIM_WIRE_BURST)
+		device->wire_budget = HIF_SIM_WIRE_BURST;
+}
+
+/**
+ * hif_sim_wire_wait_us() - time until the bus can carry @len bytes
+ * @device: emulated HIF device
+ * @len: transfer length
+ *
+ * Return: 0 if the transfer may go now, else the wait in microseconds
+ */
+static unsigned int hif_sim_wire_wait_us(HIF_DEVICE_SIM *device,
+					 unsigned int len)
+{
+	s64 missing;
+
+	if (!hif_sim_rate_mbps || device->wire_budget >= len)
+		return 0;
+
+	missing = len - device->wire_budget;
+	return (unsigned int)div_s64(missing * 8, hif_sim_rate_mbps) + 1;
+}
+
+static inline void hif_sim_wire_consume(HIF_DEVICE_SIM *device,
+					unsigned int len)
+{
+	if (hif_sim_rate_mbps)
+		device->wire_budget -= len;
+}
+
+static adf_nbuf_t hif_sim_alloc_rx(HIF_DEVICE_SIM *device, A_UINT8 ep,
+				   A_UINT8 flags, A_UINT8 trailer_len,
+				   unsigned int payload_len)
+{
+	adf_nbuf_t nbuf;
+	HTC_FRAME_HDR *hdr;
+
+	nbuf = adf_nbuf_alloc(NULL, HTC_HDR_LENGTH + payload_len, 0, 4, FALSE);
+	if (!nbuf) {
+		device->stats.rx_alloc_fail++;
+		return NULL;
+	}
+	adf_nbuf_put_tail(nbuf, HTC_HDR_LENGTH + payload_len);
+
+	hdr = (HTC_FRAME_HDR *)adf_nbuf_data(nbuf);
+	HTC_WRITE32(hdr, SM(payload_len, HTC_FRAME_HDR_PAYLOADLEN) |
+		    SM(flags, HTC_FRAME_HDR_FLAGS) |
+		    SM(ep, HTC_FRAME_HDR_ENDPOINTID));
+	HTC_WRITE32((A_UINT32 *)hdr + 1,
+		    SM(trailer_len, HTC_FRAME_HDR_CONTROLBYTES0));
+
+	return nbuf;
+}
+
+static void hif_sim_indicate_rx(HIF_DEVICE_SIM *device, A_UINT8 ep,
+				adf_nbuf_t nbuf)
+{
+	A_UINT8 pipe = HIF_SIM_PIPE_RX_DATA;
+
+	if (ep == ENDPOINT_0 || device->eps[ep].service_id == WMI_CONTROL_SVC)
+		pipe = HIF_SIM_PIPE_RX_CTRL;
+
+	device->stats.rx_msgs++;
+	device->stats.rx_bytes += adf_nbuf_len(nbuf);
+	hif_sim_wire_consume(device, adf_nbuf_len(nbuf));
+
+	if (device->htc_callbacks.rxCompletionHandler)
+		device->htc_callbacks.rxCompletionHandler(
+				device->htc_callbacks.Context, nbuf, pipe);
+	else
+		adf_nbuf_free(nbuf);
+}
+
+static void hif_sim_send_ready(HIF_DEVICE_SIM *device)
+{
+	HTC_READY_EX_MSG *ready;
+	adf_nbuf_t nbuf;
+
+	nbuf = hif_sim_alloc_rx(device, ENDPOINT_0, 0, 0, sizeof(*ready));
+	if (!nbuf)
+		return;
+
+	ready = (HTC_READY_EX_MSG *)(adf_nbuf_data(nbuf) + HTC_HDR_LENGTH);
+	A_MEMZERO(ready, sizeof(*ready));
+	HTC_SET_FIELD(&ready->Version2_0_Info, HTC_READY_MSG, MESSAGEID,
+		      HTC_MSG_READY_ID);
+	HTC_SET_FIELD(&ready->Version2_0_Info, HTC_READY_MSG, CREDITCOUNT,
+		      hif_sim_credits);
+	HTC_SET_FIELD(&ready->Version2_0_Info, HTC_READY_MSG, CREDITSIZE,
+		      hif_sim_credit_size);
+	HTC_SET_FIELD(&ready->Version2_0_Info, HTC_READY_MSG, MAXENDPOINTS,
+		      ENDPOINT_MAX);
+	HTC_SET_FIELD(ready, HTC_READY_EX_MSG, HTCVERSION, HTC_VERSION_2P1);
+	HTC_SET_FIELD(ready, HTC_READY_EX_MSG, MAXMSGSPERHTCBUNDLE, 1);
+
+	hif_sim_indicate_rx(device, ENDPOINT_0, nbuf);
+}
+
+static void hif_sim_target_connect(HIF_DEVICE_SIM *device,
+				   HTC_CONNECT_SERVICE_MSG *msg)
+{
+	HTC_CONNECT_SERVICE_RESPONSE_MSG *rsp;
+	a_uint16_t service_id, conn_flags;
+	A_UINT8 status = HTC_SERVICE_SUCCESS;
+	A_UINT8 ep = ENDPOINT_0;
+	adf_nbuf_t nbuf;
+
+	service_id = HTC_GET_FIELD(msg, HTC_CONNECT_SERVICE_MSG, SERVICE_ID);
+	conn_flags = HTC_GET_FIELD(msg, HTC_CONNECT_SERVICE_MSG,
+				   CONNECTIONFLAGS);
+
+	if (device->next_ep >= ENDPOINT_MAX) {
+		status = HTC_SERVICE_NO_RESOURCES;
+	} else {
+		ep = device->next_ep++;
+		device->eps[ep].service_id = service_id;
+		device->eps[ep].credit_flow = !(conn_flags &
+				HTC_CONNECT_FLAGS_DISABLE_CREDIT_FLOW_CTRL);
+		device->eps[ep].credits_owed = 0;
+		if (service_id == WMI_CONTROL_SVC)
+			device->wmi_ep = ep;
+		else if (service_id == HTT_DATA_MSG_SVC)
+			device->htt_ep = ep;
+	}
+
+	AR_DEBUG_PRINTF(ATH_DEBUG_INFO,
+		("hif_sim: connect svc 0x%x -> ep %d status %d\n",
+		 service_id, ep, status));
+
+	nbuf = hif_sim_alloc_rx(device, ENDPOINT_0, 0, 0, sizeof(*rsp));
+	if (!nbuf)
+		return;
+
+	rsp = (HTC_CONNECT_SERVICE_RESPONSE_MSG *)
+		(adf_nbuf_data(nbuf) + HTC_HDR_LENGTH);
+	A_MEMZERO(rsp, sizeof(*rsp));
+	HTC_SET_FIELD(rsp, HTC_CONNECT_SERVICE_RESPONSE_MSG, MESSAGEID,
+		      HTC_MSG_CONNECT_SERVICE_RESPONSE_ID);
+	HTC_SET_FIELD(rsp, HTC_CONNECT_SERVICE_RESPONSE_MSG, SERVICEID,
+		      service_id);
+	HTC_SET_FIELD(rsp, HTC_CONNECT_SERVICE_RESPONSE_MSG, STATUS, status);
+	HTC_SET_FIELD(rsp, HTC_CONNECT_SERVICE_RESPONSE_MSG, ENDPOINTID, ep);
+	HTC_SET_FIELD(rsp, HTC_CONNECT_SERVICE_RESPONSE_MSG, MAXMSGSIZE,
+		      hif_sim_credit_size);
+
+	hif_sim_indicate_rx(device, ENDPOINT_0, nbuf);
+}
+
+static adf_nbuf_t hif_sim_wmi_alloc_event(HIF_DEVICE_SIM *device,
+					  A_UINT32 event_id, unsigned int len,
+					  A_UINT8 **event)
+{
+	A_UINT8 *hdr;
+	adf_nbuf_t nbuf;
+
+	nbuf = hif_sim_alloc_rx(device, device->wmi_ep, 0, 0,
+				sizeof(WMI_CMD_HDR) + len);
+	if (!nbuf)
+		return NULL;
+
+	hdr = adf_nbuf_data(nbuf) + HTC_HDR_LENGTH;
+	A_MEMZERO(hdr, sizeof(WMI_CMD_HDR) + len);
+	WMI_SET_FIELD(hdr, WMI_CMD_HDR, COMMANDID, event_id);
+	*event = hdr + sizeof(WMI_CMD_HDR);
+
+	device->stats.wmi_events++;
+	return nbuf;
+}
+
+/**
+ * hif_sim_wmi_service_ready() - advertise the emulated target to WMA
+ * @device: emulated HIF device
+ *
+ * The target asks for no host memory and only advertises full rx
+ * reorder offload, which the in-order rx indications rely on.
+ *
+ * Return: none
+ */
+static void hif_sim_wmi_service_ready(HIF_DEVICE_SIM *device)
+{
+	wmi_service_ready_event_fixed_param *ev;
+	HAL_REG_CAPABILITIES *reg;
+	A_UINT32 *bitmap;
+	A_UINT8 *buf;
+	adf_nbuf_t nbuf;
+
+	nbuf = hif_sim_wmi_alloc_event(device, WMI_SERVICE_READY_EVENTID,
+				       sizeof(*ev) + sizeof(*reg) +
+				       WMI_TLV_HDR_SIZE +
+				       WMI_SERVICE_BM_SIZE * sizeof(A_UINT32) +
+				       2 * WMI_TLV_HDR_SIZE, &buf);
+	if (!nbuf)
+		return;
+
+	ev = (wmi_service_ready_event_fixed_param *)buf;
+	WMITLV_SET_HDR(&ev->tlv_header,
+		       WMITLV_TAG_STRUC_wmi_service_ready_event_fixed_param,
+		       WMITLV_GET_STRUCT_TLVLEN(
+				wmi_service_ready_event_fixed_param));
+	ev->fw_build_vers = HIF_SIM_FW_BUILD_VERS;
+	ev->fw_abi_vers.abi_version_0 = WMI_ABI_VERSION_0;
+	ev->fw_abi_vers.abi_version_1 = WMI_ABI_VERSION_1;
+	ev->fw_abi_vers.abi_version_ns_0 = WMI_ABI_VERSION_NS_0;
+	ev->fw_abi_vers.abi_version_ns_1 = WMI_ABI_VERSION_NS_1;
+	ev->fw_abi_vers.abi_version_ns_2 = WMI_ABI_VERSION_NS_2;
+	ev->fw_abi_vers.abi_version_ns_3 = WMI_ABI_VERSION_NS_3;
+	ev->phy_capability = WMI_11NAG_CAPABILITY;
+	ev->num_rf_chains = 1;
+	ev->ht_cap_info = WMI_HT_CAP_ENABLED | WMI_HT_CAP_HT20_SGI;
+	ev->txrx_chainmask = 0x01010101;
+
+	reg = (HAL_REG_CAPABILITIES *)(ev + 1);
+	WMITLV_SET_HDR(&reg->tlv_header,
+		       WMITLV_TAG_STRUC_HAL_REG_CAPABILITIES,
+		       WMITLV_GET_STRUCT_TLVLEN(HAL_REG_CAPABILITIES));
+	reg->wireless_modes = REGDMN_MODE_11A | REGDMN_MODE_11G |
+			      REGDMN_MODE_11NG_HT20 | REGDMN_MODE_11NA_HT20;
+	reg->low_2ghz_chan = 2312;
+	reg->high_2ghz_chan = 2732;
+	reg->low_5ghz_chan = 4920;
+	reg->high_5ghz_chan = 5825;
+
+	buf = (A_UINT8 *)(reg + 1);
+	WMITLV_SET_HDR(buf, WMITLV_TAG_ARRAY_UINT32,
+		       (WMI_SERVICE_BM_SIZE * sizeof(A_UINT32)));
+	bitmap = (A_UINT32 *)(buf + WMI_TLV_HDR_SIZE);
+	WMI_SERVICE_ENABLE(bitmap, WMI_SERVICE_RX_FULL_REORDER);
+
+	/* no mem_reqs and no wlan_dbs_hw_mode_list */
+	buf = (A_UINT8 *)(bitmap + WMI_SERVICE_BM_SIZE);
+	WMITLV_SET_HDR(buf, WMITLV_TAG_ARRAY_STRUC, 0);
+	buf += WMI_TLV_HDR_SIZE;
+	WMITLV_SET_HDR(buf, WMITLV_TAG_ARRAY_UINT32, 0);
+
+	AR_DEBUG_PRINTF(ATH_DEBUG_INFO, ("hif_sim: service ready\n"));
+	hif_sim_indicate_rx(device, device->wmi_ep, nbuf);
+}
+
+static void hif_sim_wmi_ready(HIF_DEVICE_SIM *device,
+			      wmi_init_cmd_fixed_param *cmd)
+{
+	wmi_ready_event_fixed_param *ev;
+	adf_nbuf_t nbuf;
+
+	nbuf = hif_sim_wmi_alloc_event(device, WMI_READY_EVENTID, sizeof(*ev),
+				       (A_UINT8 **)&ev);
+	if (!nbuf)
+		return;
+
+	WMITLV_SET_HDR(&ev->tlv_header,
+		       WMITLV_TAG_STRUC_wmi_ready_event_fixed_param,
+		       WMITLV_GET_STRUCT_TLVLEN(wmi_ready_event_fixed_param));
+	/* agree to whatever the host settled on */
+	A_MEMCPY(&ev->fw_abi_vers, &cmd->host_abi_vers,
+		 sizeof(ev->fw_abi_vers));
+	WMI_CHAR_ARRAY_TO_MAC_ADDR(hif_sim_mac_addr, &ev->mac_addr);
+	ev->status = WLAN_INIT_STATUS_SUCCESS;
+
+	AR_DEBUG_PRINTF(ATH_DEBUG_INFO, ("hif_sim: ready\n"));
+	hif_sim_indicate_rx(device, device->wmi_ep, nbuf);
+}
+
+static adf_nbuf_t hif_sim_htt_alloc_msg(HIF_DEVICE_SIM *device,
+					A_UINT8 msg_type, unsigned int len,
+					A_UINT32 **msg_word)
+{
+	adf_nbuf_t nbuf;
+
+	nbuf = hif_sim_alloc_rx(device, device->htt_ep, 0, 0, len);
+	if (!nbuf)
+		return NULL;
+
+	*msg_word = (A_UINT32 *)(adf_nbuf_data(nbuf) + HTC_HDR_LENGTH);
+	A_MEMZERO(*msg_word, len);
+	HTT_T2H_MSG_TYPE_SET(**msg_word, msg_type);
+	return nbuf;
+}
+
+static void hif_sim_htt_peer_map(HIF_DEVICE_SIM *device, A_UINT16 peer_id,
+				 bool map)
+{
+	struct hif_sim_peer *peer = &device->peers[peer_id];
+	A_UINT32 *msg_word;
+	adf_nbuf_t nbuf;
+
+	if (device->htt_ep == ENDPOINT_0)
+		return;
+
+	if (map) {
+		nbuf = hif_sim_htt_alloc_msg(device, HTT_T2H_MSG_TYPE_PEER_MAP,
+					     HTT_RX_PEER_MAP_BYTES, &msg_word);
+		if (!nbuf)
+			return;
+		HTT_RX_PEER_MAP_VDEV_ID_SET(*msg_word, peer->vdev_id);
+		HTT_RX_PEER_MAP_PEER_ID_SET(*msg_word, peer_id);
+		A_MEMCPY((A_UINT8 *)msg_word + HTT_RX_PEER_MAP_MAC_ADDR_OFFSET,
+			 peer->mac_addr, ETH_ALEN);
+	} else {
+		nbuf = hif_sim_htt_alloc_msg(device,
+					     HTT_T2H_MSG_TYPE_PEER_UNMAP,
+					     HTT_RX_PEER_UNMAP_BYTES,
+					     &msg_word);
+		if (!nbuf)
+			return;
+		HTT_RX_PEER_UNMAP_PEER_ID_SET(*msg_word, peer_id);
+	}
+
+	hif_sim_indicate_rx(device, device->htt_ep, nbuf);
+}
+
+static void hif_sim_wmi_peer_create(HIF_DEVICE_SIM *device,
+				    wmi_peer_create_cmd_fixed_param *cmd)
+{
+	struct hif_sim_peer *peer;
+	A_UINT16 peer_id;
+
+	for (peer_id = 0; peer_id < HIF_SIM_MAX_PEERS; peer_id++) {
+		if (!device->peers[peer_id].valid)
+			break;
+	}
+	if (peer_id == HIF_SIM_MAX_PEERS) {
+		AR_DEBUG_PRINTF(ATH_DEBUG_ERR,
+			("hif_sim: no peer id left for vdev %d\n",
+			 cmd->vdev_id));
+		return;
+	}
+
+	peer = &device->peers[peer_id];
+	peer->valid = true;
+	peer->vdev_id = cmd->vdev_id;
+	WMI_MAC_ADDR_TO_CHAR_ARRAY(&cmd->peer_macaddr, peer->mac_addr);
+	device->rx_peer_id = peer_id;
+
+	hif_sim_htt_peer_map(device, peer_id, true);
+}
+
+static void hif_sim_wmi_peer_delete(HIF_DEVICE_SIM *device,
+				    wmi_peer_delete_cmd_fixed_param *cmd)
+{
+	A_UINT8 mac_addr[ETH_ALEN];
+	struct hif_sim_peer *peer;
+	A_UINT16 peer_id;
+
+	WMI_MAC_ADDR_TO_CHAR_ARRAY(&cmd->peer_macaddr, mac_addr);
+	for (peer_id = 0; peer_id < HIF_SIM_MAX_PEERS; peer_id++) {
+		peer = &device->peers[peer_id];
+		if (peer->valid && peer->vdev_id == cmd->vdev_id &&
+		    !A_MEMCMP(peer->mac_addr, mac_addr, ETH_ALEN))
+			break;
+	}
+	if (peer_id == HIF_SIM_MAX_PEERS)
+		return;
+
+	peer->valid = false;
+	if (device->rx_peer_id == peer_id)
+		device->rx_peer_id = HIF_SIM_INVALID_PEER;
+
+	hif_sim_htt_peer_map(device, peer_id, false);
+}
+
+static void hif_sim_target_wmi(HIF_DEVICE_SIM *device, A_UINT8 *msg,
+			       unsigned int len)
+{
+	A_UINT32 cmd_id;
+
+	if (len < sizeof(WMI_CMD_HDR)) {
+		device->stats.unhandled++;
+		return;
+	}
+
+	cmd_id = WMI_GET_FIELD(msg, WMI_CMD_HDR, COMMANDID);
+	msg += sizeof(WMI_CMD_HDR);
+	len -= sizeof(WMI_CMD_HDR);
+	device->stats.wmi_cmds++;
+
+	switch (cmd_id) {
+	case WMI_INIT_CMDID:
+		if (len >= sizeof(wmi_init_cmd_fixed_param))
+			hif_sim_wmi_ready(device,
+					  (wmi_init_cmd_fixed_param *)msg);
+		break;
+	case WMI_PEER_CREATE_CMDID:
+		if (len >= sizeof(wmi_peer_create_cmd_fixed_param))
+			hif_sim_wmi_peer_create(device,
+				(wmi_peer_create_cmd_fixed_param *)msg);
+		break;
+	case WMI_PEER_DELETE_CMDID:
+		if (len >= sizeof(wmi_peer_delete_cmd_fixed_param))
+			hif_sim_wmi_peer_delete(device,
+				(wmi_peer_delete_cmd_fixed_param *)msg);
+		break;
+	default:
+		/* configuration the emulated target has no use for */
+		break;
+	}
+}
+
+static void hif_sim_htt_version_conf(HIF_DEVICE_SIM *device)
+{
+	A_UINT32 *msg_word;
+	adf_nbuf_t nbuf;
+
+	nbuf = hif_sim_htt_alloc_msg(device, HTT_T2H_MSG_TYPE_VERSION_CONF,
+				     HTT_VER_CONF_BYTES, &msg_word);
+	if (!nbuf)
+		return;
+
+	HTT_VER_CONF_MAJOR_SET(*msg_word, HTT_CURRENT_VERSION_MAJOR);
+	HTT_VER_CONF_MINOR_SET(*msg_word, HTT_CURRENT_VERSION_MINOR);
+	hif_sim_indicate_rx(device, device->htt_ep, nbuf);
+}
+
+static void hif_sim_htt_rx_ring_cfg(HIF_DEVICE_SIM *device,
+				    A_UINT32 *msg_word)
+{
+	struct hif_sim_rx_ring *ring = &device->rx_ring;
+	unsigned int size;
+
+	A_MEMZERO(ring, sizeof(*ring));
+
+	msg_word++;
+	ring->alloc_idx = phys_to_virt(
+		HTT_RX_RING_CFG_IDX_SHADOW_REG_PADDR_GET(*msg_word));
+	msg_word++;
+	ring->paddrs = phys_to_virt(HTT_RX_RING_CFG_BASE_PADDR_GET(*msg_word));
+	msg_word++;
+	size = HTT_RX_RING_CFG_LEN_GET(*msg_word);
+	ring->buf_size = HTT_RX_RING_CFG_BUF_SZ_GET(*msg_word);
+	msg_word += 2;
+	ring->payload_offset =
+		HTT_RX_RING_CFG_OFFSET_MSDU_PAYLD_GET(*msg_word) << 2;
+	msg_word += 2;
+	ring->mpdu_start_offset =
+		HTT_RX_RING_CFG_OFFSET_MPDU_START_GET(*msg_word) << 2;
+	msg_word++;
+	ring->msdu_start_offset =
+		HTT_RX_RING_CFG_OFFSET_MSDU_START_GET(*msg_word) << 2;
+	ring->msdu_end_offset =
+		HTT_RX_RING_CFG_OFFSET_MSDU_END_GET(*msg_word) << 2;
+	msg_word++;
+	ring->attn_offset = HTT_RX_RING_CFG_OFFSET_RX_ATTN_GET(*msg_word) << 2;
+
+	if (!size || (size & (size - 1)) ||
+	    ring->buf_size < ring->payload_offset + HIF_SIM_RX_MIN_LEN) {
+		AR_DEBUG_PRINTF(ATH_DEBUG_ERR,
+			("hif_sim: unusable rx ring, %u x %u bytes\n",
+			 size, ring->buf_size));
+		return;
+	}
+
+	/* the host fills the ring from index 0 before configuring it */
+	ring->size_mask = size - 1;
+	ring->valid = true;
+}
+
+/**
+ * hif_sim_htt_tx_compl_flush() - complete the batched tx msdus to HTT
+ * @device: emulated HIF device
+ *
+ * Return: none
+ */
+static void hif_sim_htt_tx_compl_flush(HIF_DEVICE_SIM *device)
+{
+	struct htt_tx_compl_ind_base *compl;
+	int num = device->tx_compl_cnt;
+	A_UINT32 *msg_word;
+	adf_nbuf_t nbuf;
+
+	if (!num)
+		return;
+	device->tx_compl_cnt = 0;
+
+	/* an odd id count is padded with an invalid id */
+	nbuf = hif_sim_htt_alloc_msg(device, HTT_T2H_MSG_TYPE_TX_COMPL_IND,
+				     sizeof(A_UINT32) +
+				     roundup(num, 2) * sizeof(A_UINT16),
+				     &msg_word);
+	if (!nbuf)
+		return;
+
+	HTT_TX_COMPL_IND_STATUS_SET(*msg_word, HTT_TX_COMPL_IND_STAT_OK);
+	HTT_TX_COMPL_IND_TID_INV_SET(*msg_word, 1);
+	HTT_TX_COMPL_IND_NUM_SET(*msg_word, num);
+	compl = (struct htt_tx_compl_ind_base *)msg_word;
+	A_MEMCPY(compl->payload, device->tx_compl_ids,
+		 num * sizeof(A_UINT16));
+	if (num & 0x1)
+		compl->payload[num] = HTT_TX_COMPL_INV_MSDU_ID;
+
+	device->stats.htt_tx_compl += num;
+	hif_sim_indicate_rx(device, device->htt_ep, nbuf);
+}
+
+static void hif_sim_target_htt(HIF_DEVICE_SIM *device, A_UINT8 *msg,
+			       unsigned int len)
+{
+	A_UINT32 *msg_word = (A_UINT32 *)msg;
+
+	if (len < sizeof(A_UINT32)) {
+		device->stats.unhandled++;
+		return;
+	}
+
+	switch (HTT_H2T_MSG_TYPE_GET(*msg_word)) {
+	case HTT_H2T_MSG_TYPE_VERSION_REQ:
+		hif_sim_htt_version_conf(device);
+		break;
+	case HTT_H2T_MSG_TYPE_RX_RING_CFG:
+		if (len < HTT_RX_RING_CFG_BYTES(1) ||
+		    HTT_RX_RING_CFG_NUM_RINGS_GET(*msg_word) != 1) {
+			device->stats.unhandled++;
+			break;
+		}
+		hif_sim_htt_rx_ring_cfg(device, msg_word);
+		break;
+	case HTT_H2T_MSG_TYPE_TX_FRM:
+		if (len < HTT_TX_DESC_FRM_ID_OFFSET_BYTES + sizeof(A_UINT32)) {
+			device->stats.unhandled++;
+			break;
+		}
+		device->tx_compl_ids[device->tx_compl_cnt++] =
+			HTT_TX_DESC_FRM_ID_GET(
+				msg_word[HTT_TX_DESC_FRM_ID_OFFSET_DWORD]);
+		if (device->tx_compl_cnt == HIF_SIM_TX_COMPL_MAX)
+			hif_sim_htt_tx_compl_flush(device);
+		break;
+	default:
+		/* configuration the emulated target has no use for */
+		break;
+	}
+}
+
+static inline bool hif_sim_htt_rx_active(HIF_DEVICE_SIM *device)
+{
+	return hif_sim_htt_rx_len && device->rx_ring.valid &&
+	       device->rx_peer_id != HIF_SIM_INVALID_PEER;
+}
+
+static A_UINT16 hif_sim_ip_csum(const A_UINT8 *hdr, unsigned int len)
+{
+	A_UINT32 sum = 0;
+	unsigned int i;
+
+	for (i = 0; i < len; i += 2)
+		sum += (hdr[i] << 8) | hdr[i + 1];
+	while (sum >> 16)
+		sum = (sum & 0xffff) + (sum >> 16);
+	return ~sum & 0xffff;
+}
+
+/**
+ * hif_sim_htt_rx_fill() - write an rx descriptor and frame to a host buffer
+ * @device: emulated HIF device
+ * @buf: host rx buffer, descriptor first
+ * @len: ethernet frame length
+ * @peer: transmitter of the frame
+ *
+ * The frame is an IPv4/UDP datagram to the discard port; the UDP
+ * payload is left as the host posted it.
+ *
+ * Return: none
+ */
+static void hif_sim_htt_rx_fill(HIF_DEVICE_SIM *device, A_UINT8 *buf,
+				unsigned int len, struct hif_sim_peer *peer)
+{
+	struct hif_sim_rx_ring *ring = &device->rx_ring;
+	struct rx_attention *attn;
+	struct rx_mpdu_start *mpdu_start;
+	struct rx_msdu_start *msdu_start;
+	struct rx_msdu_end *msdu_end;
+	unsigned int ip_len = len - ETH_HLEN;
+	A_UINT8 *frame, *ip, *udp;
+	A_UINT16 csum;
+
+	A_MEMZERO(buf, ring->payload_offset);
+	attn = (struct rx_attention *)(buf + ring->attn_offset);
+	attn->first_mpdu = 1;
+	attn->last_mpdu = 1;
+	attn->directed = 1;
+	attn->msdu_done = 1;
+	mpdu_start = (struct rx_mpdu_start *)(buf + ring->mpdu_start_offset);
+	mpdu_start->seq_num = device->rx_seq++ & 0xfff;
+	msdu_start = (struct rx_msdu_start *)(buf + ring->msdu_start_offset);
+	msdu_start->msdu_length = len;
+	msdu_start->decap_format = HIF_SIM_RX_DECAP_ETH2;
+	msdu_start->ipv4_proto = 1;
+	msdu_start->udp_proto = 1;
+	msdu_end = (struct rx_msdu_end *)(buf + ring->msdu_end_offset);
+	msdu_end->first_msdu = 1;
+	msdu_end->last_msdu = 1;
+
+	frame = buf + ring->payload_offset;
+	A_MEMCPY(frame, hif_sim_mac_addr, ETH_ALEN);
+	A_MEMCPY(frame + ETH_ALEN, peer->mac_addr, ETH_ALEN);
+	frame[2 * ETH_ALEN] = ETH_P_IP >> 8;
+	frame[2 * ETH_ALEN + 1] = ETH_P_IP & 0xff;
+
+	ip = frame + ETH_HLEN;
+	A_MEMZERO(ip, HIF_SIM_IP_HDR_LEN + HIF_SIM_UDP_HDR_LEN);
+	ip[0] = 0x45;
+	ip[2] = ip_len >> 8;
+	ip[3] = ip_len & 0xff;
+	ip[8] = 64;
+	ip[9] = IPPROTO_UDP;
+	A_MEMCPY(ip + 12, hif_sim_rx_ip[0], 4);
+	A_MEMCPY(ip + 16, hif_sim_rx_ip[1], 4);
+	csum = hif_sim_ip_csum(ip, HIF_SIM_IP_HDR_LEN);
+	ip[10] = csum >> 8;
+	ip[11] = csum & 0xff;
+
+	udp = ip + HIF_SIM_IP_HDR_LEN;
+	udp[1] = 9;
+	udp[3] = 9;
+	udp[4] = (ip_len - HIF_SIM_IP_HDR_LEN) >> 8;
+	udp[5] = (ip_len - HIF_SIM_IP_HDR_LEN) & 0xff;
+}
+
+/**
+ * hif_sim_htt_rx() - deliver frames through the host rx ring
+ * @device: emulated HIF device
+ * @budget: msdus allowed in this pass
+ * @wait_us: set when the rate limiter or an empty ring stops rx
+ *
+ * Buffers are taken from the ring in the order the host posted them
+ * and indicated in batches of HIF_SIM_RX_IND_MSDUS, tid 0.
+ *
+ * Return: none
+ */
+static void hif_sim_htt_rx(HIF_DEVICE_SIM *device, int budget,
+			   unsigned int *wait_us)
+{
+	struct hif_sim_rx_ring *ring = &device->rx_ring;
+	struct hif_sim_peer *peer;
+	A_UINT32 *msg_word, paddr;
+	unsigned int len, avail, cnt, i;
+	adf_nbuf_t nbuf;
+
+	while (hif_sim_htt_rx_active(device) && budget > 0) {
+		len = clamp_t(unsigned int, hif_sim_htt_rx_len,
+			      HIF_SIM_RX_MIN_LEN,
+			      min_t(unsigned int, ETH_FRAME_LEN,
+				    ring->buf_size - ring->payload_offset));
+		avail = (ACCESS_ONCE(*ring->alloc_idx) - ring->rd_idx) &
+			ring->size_mask;
+		/* the host writes the ring entries before its alloc index */
+		smp_rmb();
+		if (!avail) {
+			device->stats.htt_rx_ring_empty++;
+			*wait_us = HIF_SIM_RX_RETRY_US;
+			return;
+		}
+		cnt = min_t(unsigned int, avail, HIF_SIM_RX_IND_MSDUS);
+		cnt = min_t(unsigned int, cnt, budget);
+
+		*wait_us = hif_sim_wire_wait_us(device, cnt * len);
+		if (*wait_us)
+			return;
+
+		nbuf = hif_sim_htt_alloc_msg(device,
+				HTT_T2H_MSG_TYPE_RX_IN_ORD_PADDR_IND,
+				HTT_RX_IN_ORD_PADDR_IND_HDR_BYTES +
+				cnt * HTT_RX_IN_ORD_PADDR_IND_MSDU_BYTES,
+				&msg_word);
+		if (!nbuf)
+			return;
+
+		peer = &device->peers[device->rx_peer_id];
+		HTT_RX_IN_ORD_PADDR_IND_EXT_TID_SET(*msg_word, 0);
+		HTT_RX_IN_ORD_PADDR_IND_PEER_ID_SET(*msg_word,
+						    device->rx_peer_id);
+		msg_word++;
+		HTT_RX_IN_ORD_PADDR_IND_VAP_ID_SET(*msg_word, peer->vdev_id);
+		HTT_RX_IN_ORD_PADDR_IND_MSDU_CNT_SET(*msg_word, cnt);
+		msg_word++;
+
+		for (i = 0; i < cnt; i++) {
+			paddr = ring->paddrs[ring->rd_idx];
+			ring->rd_idx = (ring->rd_idx + 1) & ring->size_mask;
+			hif_sim_htt_rx_fill(device, phys_to_virt(paddr), len,
+					    peer);
+			hif_sim_wire_consume(device, len);
+
+			HTT_RX_IN_ORD_PADDR_IND_PADDR_SET(*msg_word, paddr);
+			msg_word++;
+			HTT_RX_IN_ORD_PADDR_IND_MSDU_LEN_SET(*msg_word, len);
+			msg_word++;
+		}
+
+		device->stats.htt_rx_msdus += cnt;
+		budget -= cnt;
+		hif_sim_indicate_rx(device, device->htt_ep, nbuf);
+	}
+}
+
+static void hif_sim_target_ctrl(HIF_DEVICE_SIM *device, A_UINT8 *msg,
+				unsigned int len)
+{
+	A_UINT32 setup_flags;
+	int i;
+
+	device->stats.ctrl_msgs++;
+
+	if (len < sizeof(HTC_UNKNOWN_MSG)) {
+		device->stats.unhandled++;
+		return;
+	}
+
+	switch (HTC_GET_FIELD(msg, HTC_UNKNOWN_MSG, MESSAGEID)) {
+	case HTC_MSG_CONNECT_SERVICE_ID:
+		if (len < sizeof(HTC_CONNECT_SERVICE_MSG)) {
+			device->stats.unhandled++;
+			break;
+		}
+		hif_sim_target_connect(device, (HTC_CONNECT_SERVICE_MSG *)msg);
+		break;
+	case HTC_MSG_SETUP_COMPLETE_EX_ID:
+		if (len >= sizeof(HTC_SETUP_COMPLETE_EX_MSG)) {
+			setup_flags = HTC_GET_FIELD(msg,
+					HTC_SETUP_COMPLETE_EX_MSG, SETUPFLAGS);
+			if (setup_flags &
+			    HTC_SETUP_COMPLETE_FLAGS_DISABLE_TX_CREDIT_FLOW) {
+				for (i = 0; i < ENDPOINT_MAX; i++)
+					device->eps[i].credit_flow = false;
+			}
+		}
+		/* fall through */
+	case HTC_MSG_SETUP_COMPLETE_ID:
+		device->setup_done = true;
+		AR_DEBUG_PRINTF(ATH_DEBUG_INFO, ("hif_sim: setup complete\n"));
+		if (device->wmi_ep != ENDPOINT_0)
+			hif_sim_wmi_service_ready(device);
+		break;
+	default:
+		device->stats.unhandled++;
+		break;
+	}
+}
+
+static A_UINT8 hif_sim_epping_stream_ep(HIF_DEVICE_SIM *device,
+					A_UINT8 stream, A_UINT8 rx_ep)
+{
+	a_uint16_t service_id;
+	int i;
+
+	if (stream > (WMI_DATA_VO_SVC - WMI_DATA_BE_SVC))
+		return rx_ep;
+
+	service_id = WMI_DATA_BE_SVC + stream;
+	for (i = ENDPOINT_1; i < device->next_ep; i++) {
+		if (device->eps[i].service_id == service_id)
+			return i;
+	}
+	return rx_ep;
+}
+
+static void hif_sim_epping_echo(HIF_DEVICE_SIM *device, A_UINT8 rx_ep,
+				A_UINT8 *payload, unsigned int len)
+{
+	EPPING_HEADER *hdr = (EPPING_HEADER *)(payload + EPPING_ALIGNMENT_PAD);
+	A_UINT8 ep;
+	adf_nbuf_t nbuf;
+
+	hdr->StreamEchoSent_t = hdr->StreamEcho_h;
+	hdr->StreamRecv_t = hdr->StreamNo_h;
+	ep = hif_sim_epping_stream_ep(device, hdr->StreamEcho_h, rx_ep);
+
+	nbuf = hif_sim_alloc_rx(device, ep, 0, 0, len);
+	if (!nbuf)
+		return;
+	A_MEMCPY(adf_nbuf_data(nbuf) + HTC_HDR_LENGTH, payload, len);
+
+	device->stats.epping_echo++;
+	hif_sim_indicate_rx(device, ep, nbuf);
+}
+
+static void hif_sim_target_epping(HIF_DEVICE_SIM *device, A_UINT8 ep,
+				  A_UINT8 *payload, unsigned int len)
+{
+	EPPING_HEADER *hdr;
+	EPPING_CONT_RX_PARAMS *params;
+
+	if (len < EPPING_ALIGNMENT_PAD + sizeof(EPPING_HEADER)) {
+		device->stats.unhandled++;
+		return;
+	}
+
+	hdr = (EPPING_HEADER *)(payload + EPPING_ALIGNMENT_PAD);
+	if (!IS_EPPING_PACKET(hdr)) {
+		device->stats.unhandled++;
+		return;
+	}
+
+	device->epping_rx_cnt++;
+
+	switch (hdr->Cmd_h) {
+	case EPPING_CMD_ECHO_PACKET:
+		hif_sim_epping_echo(device, ep, payload, len);
+		break;
+	case EPPING_CMD_RESET_RECV_CNT:
+		device->epping_rx_cnt = 0;
+		break;
+	case EPPING_CMD_CAPTURE_RECV_CNT:
+		A_MEMCPY(hdr->CmdBuffer_t, &device->epping_rx_cnt,
+			 sizeof(device->epping_rx_cnt));
+		hif_sim_epping_echo(device, ep, payload, len);
+		break;
+	case EPPING_CMD_CONT_RX_START:
+		params = (EPPING_CONT_RX_PARAMS *)hdr->CmdBuffer_h;
+		device->cont_rx_len = max_t(A_UINT16, params->PacketLength,
+					    sizeof(EPPING_HEADER));
+		device->cont_rx_len = min_t(A_UINT16, device->cont_rx_len,
+			hif_sim_credit_size - HTC_HDR_LENGTH -
+			EPPING_ALIGNMENT_PAD);
+		device->cont_rx_flags = params->Flags;
+		device->cont_rx_ep = ep;
+		device->cont_rx_seq = 0;
+		device->cont_rx = true;
+		break;
+	case EPPING_CMD_CONT_RX_STOP:
+		device->cont_rx = false;
+		hif_sim_epping_echo(device, ep, payload, len);
+		break;
+	case EPPING_CMD_NO_ECHO:
+	default:
+		break;
+	}
+}
+
+/**
+ * hif_sim_target_recv() - hand a host message to the emulated target
+ * @device: emulated HIF device
+ * @buf: linear copy of the message, HTC header included
+ * @len: bytes in @buf
+ *
+ * The credits the message consumed on the host are owed back whether or
+ * not the target understood it.
+ *
+ * Return: none
+ */
+static void hif_sim_target_recv(HIF_DEVICE_SIM *device, A_UINT8 *buf,
+				 unsigned int len)
+{
+	HTC_FRAME_HDR *hdr = (HTC_FRAME_HDR *)buf;
+	A_UINT8 ep;
+	unsigned int payload_len;
+
+	if (len < HTC_HDR_LENGTH) {
+		device->stats.unhandled++;
+		return;
+	}
+
+	ep = HTC_GET_FIELD(hdr, HTC_FRAME_HDR, ENDPOINTID);
+	payload_len = HTC_GET_FIELD(hdr, HTC_FRAME_HDR, PAYLOADLEN);
+	if (ep >= ENDPOINT_MAX || payload_len + HTC_HDR_LENGTH > len) {
+		device->stats.unhandled++;
+		return;
+	}
+
+	if (device->eps[ep].credit_flow)
+		device->eps[ep].credits_owed +=
+			hif_sim_credits_for(payload_len + HTC_HDR_LENGTH);
+
+	if (ep == ENDPOINT_0)
+		hif_sim_target_ctrl(device, buf + HTC_HDR_LENGTH, payload_len);
+	else if (WLAN_IS_EPPING_ENABLED(vos_get_conparam()))
+		hif_sim_target_epping(device, ep, buf + HTC_HDR_LENGTH,
+				      payload_len);
+	else if (ep == device->wmi_ep)
+		hif_sim_target_wmi(device, buf + HTC_HDR_LENGTH, payload_len);
+	else if (ep == device->htt_ep)
+		hif_sim_target_htt(device, buf + HTC_HDR_LENGTH, payload_len);
+	else
+		device->stats.unhandled++;
+}
+
+/**
+ * hif_sim_send_credit_report() - return owed credits in one EP0 trailer
+ * @device: emulated HIF device
+ *
+ * Return: none
+ */
+static void hif_sim_send_credit_report(HIF_DEVICE_SIM *device)
+{
+	HTC_CREDIT_REPORT rpt[ENDPOINT_MAX * 2];
+	HTC_RECORD_HDR *rec;
+	unsigned int credits;
+	int i, n = 0;
+	A_UINT8 trailer_len;
+	adf_nbuf_t nbuf;
+
+	A_MEMZERO(rpt, sizeof(rpt));
+	for (i = ENDPOINT_1; i < ENDPOINT_MAX && n < ARRAY_SIZE(rpt); i++) {
+		/* the credit field is 8 bits, split large returns */
+		while (device->eps[i].credits_owed && n < ARRAY_SIZE(rpt)) {
+			credits = min_t(unsigned int,
+					device->eps[i].credits_owed, 0xff);
+			HTC_SET_FIELD(&rpt[n], HTC_CREDIT_REPORT, ENDPOINTID, i);
+			HTC_SET_FIELD(&rpt[n], HTC_CREDIT_REPORT, CREDITS,
+				      credits);
+			device->eps[i].credits_owed -= credits;
+			device->stats.credits_returned += credits;
+			n++;
+		}
+	}
+	if (!n)
+		return;
+
+	trailer_len = sizeof(HTC_RECORD_HDR) + n * sizeof(HTC_CREDIT_REPORT);
+	nbuf = hif_sim_alloc_rx(device, ENDPOINT_0, HTC_FLAGS_RECV_TRAILER,
+				trailer_len, trailer_len);
+	if (!nbuf)
+		return;
+
+	rec = (HTC_RECORD_HDR *)(adf_nbuf_data(nbuf) + HTC_HDR_LENGTH);
+	A_MEMZERO(rec, sizeof(*rec));
+	HTC_SET_FIELD(rec, HTC_RECORD_HDR, RECORDID, HTC_RECORD_CREDITS);
+	HTC_SET_FIELD(rec, HTC_RECORD_HDR, LENGTH,
+		      n * sizeof(HTC_CREDIT_REPORT));
+	A_MEMCPY(rec + 1, rpt, n * sizeof(HTC_CREDIT_REPORT));
+
+	device->stats.credit_reports++;
+	hif_sim_indicate_rx(device, ENDPOINT_0, nbuf);
+}
+
+/**
+ * hif_sim_cont_rx() - generate endpoint ping continuous rx traffic
+ * @device: emulated HIF device
+ * @budget: frames allowed in this pass
+ * @wait_us: set to the bus wait when the rate limiter stops generation
+ *
+ * Frames carry Cmd_h 0, as the firmware mboxping app does.
+ *
+ * Return: none
+ */
+static void hif_sim_cont_rx(HIF_DEVICE_SIM *device, int budget,
+			    unsigned int *wait_us)
+{
+	unsigned int len = EPPING_ALIGNMENT_PAD + device->cont_rx_len;
+	EPPING_HEADER *hdr;
+	A_UINT8 *payload;
+	adf_nbuf_t nbuf;
+
+	while (device->cont_rx && budget-- > 0) {
+		*wait_us = hif_sim_wire_wait_us(device, HTC_HDR_LENGTH + len);
+		if (*wait_us)
+			return;
+
+		nbuf = hif_sim_alloc_rx(device, device->cont_rx_ep, 0, 0, len);
+		if (!nbuf)
+			return;
+
+		payload = adf_nbuf_data(nbuf) + HTC_HDR_LENGTH;
+		if (!(device->cont_rx_flags & EPPING_CONT_RX_NO_DATA_FILL))
+			A_MEMZERO(payload, len);
+		hdr = (EPPING_HEADER *)(payload + EPPING_ALIGNMENT_PAD);
+		A_MEMZERO(hdr, sizeof(*hdr));
+		A_MEMSET(hdr->_HCIRsvd, EPPING_RSVD_FILL,
+			 sizeof(hdr->_HCIRsvd));
+		A_MEMSET(hdr->_rsvd, EPPING_RSVD_FILL, sizeof(hdr->_rsvd));
+		SET_EPPING_PACKET_MAGIC(hdr);
+		hdr->SeqNo = device->cont_rx_seq++;
+		hdr->DataLength = device->cont_rx_len - sizeof(*hdr);
+
+		device->stats.epping_cont_rx++;
+		hif_sim_indicate_rx(device, device->cont_rx_ep, nbuf);
+	}
+}
+
+static unsigned int hif_sim_linearize(adf_nbuf_t nbuf, unsigned int nbytes,
+				      A_UINT8 *dst)
+{
+	int i, frag_count, frag_len;
+	unsigned int copied = 0;
+
+	nbytes = min_t(unsigned int, nbytes, HIF_SIM_MAX_MSG_LEN);
+	frag_count = adf_nbuf_get_num_frags(nbuf);
+	for (i = 0; i < frag_count && copied < nbytes; i++) {
+		frag_len = min_t(unsigned int, adf_nbuf_get_frag_len(nbuf, i),
+				 nbytes - copied);
+		A_MEMCPY(dst + copied, adf_nbuf_get_frag_vaddr(nbuf, i),
+			 frag_len);
+		copied += frag_len;
+	}
+	return copied;
+}
+
+/**
+ * hif_sim_tx_dequeue() - take the next transfer the bus may carry
+ * @device: emulated HIF device
+ * @idx: tx pipe index
+ * @xfer: filled with the dequeued transfer
+ * @wait_us: set when the head transfer has to wait for latency or rate
+ * @resume: set when the pipe drained below half of its depth after
+ *          HIFSend_head had to turn a transfer away
+ *
+ * Return: true if @xfer was filled
+ */
+static bool hif_sim_tx_dequeue(HIF_DEVICE_SIM *device, int idx,
+			       struct hif_sim_xfer *xfer,
+			       unsigned int *wait_us, bool *resume)
+{
+	struct hif_sim_tx_pipe *pipe = &device->tx_pipes[idx];
+	struct hif_sim_xfer *head;
+	s64 age_us;
+	bool ret = false;
+
+	spin_lock_bh(&device->tx_lock);
+	if (!pipe->count)
+		goto out;
+
+	head = &pipe->ring[pipe->head];
+	if (hif_sim_latency_us) {
+		age_us = ktime_us_delta(ktime_get(), head->queued);
+		if (age_us < hif_sim_latency_us) {
+			*wait_us = hif_sim_latency_us - age_us;
+			goto out;
+		}
+	}
+	*wait_us = hif_sim_wire_wait_us(device, head->nbytes);
+	if (*wait_us)
+		goto out;
+
+	*xfer = *head;
+	head->nbuf = NULL;
+	pipe->head = (pipe->head + 1) % HIF_SIM_MAX_QUEUE_DEPTH;
+	pipe->count--;
+	if (pipe->stalled && pipe->count <= pipe->depth / 2) {
+		pipe->stalled = false;
+		*resume = true;
+	}
+	ret = true;
+out:
+	spin_unlock_bh(&device->tx_lock);
+	return ret;
+}
+
+static void hif_sim_tx_complete(HIF_DEVICE_SIM *device,
+				struct hif_sim_xfer *xfer)
+{
+	u32 lat_us = (u32)ktime_us_delta(ktime_get(), xfer->queued);
+
+	device->stats.tx_msgs++;
+	device->stats.tx_bytes += xfer->nbytes;
+	device->stats.tx_lat_sum_us += lat_us;
+	if (lat_us > device->stats.tx_lat_max_us)
+		device->stats.tx_lat_max_us = lat_us;
+
+	if (device->htc_callbacks.txCompletionHandler)
+		device->htc_callbacks.txCompletionHandler(
+				device->htc_callbacks.Context,
+				xfer->nbuf, xfer->transfer_id);
+}
+
+static void hif_sim_target_work(struct work_struct *work)
+{
+	HIF_DEVICE_SIM *device = container_of(to_delayed_work(work),
+					      HIF_DEVICE_SIM, target_work);
+	static const A_UINT8 tx_pipes[HIF_SIM_TX_PIPE_MAX] = {
+		HIF_SIM_PIPE_TX_CTRL, HIF_SIM_PIPE_TX_DATA };
+	struct hif_sim_xfer xfer;
+	unsigned int len, wait_us = 0, pipe_wait;
+	int budget = HIF_SIM_WORK_BUDGET;
+	bool resume, pending = false;
+	int i;
+
+	spin_lock_bh(&device->tx_lock);
+	if (!device->running) {
+		spin_unlock_bh(&device->tx_lock);
+		return;
+	}
+	spin_unlock_bh(&device->tx_lock);
+
+	/* completions and indications run in bh context like a real bus */
+	local_bh_disable();
+
+	if (device->ready_pending) {
+		device->ready_pending = false;
+		hif_sim_send_ready(device);
+	}
+
+	hif_sim_wire_refill(device);
+
+	/* control pipe first so WMI/HTC traffic is not starved by data */
+	for (i = 0; i < HIF_SIM_TX_PIPE_MAX; i++) {
+		pipe_wait = 0;
+		while (budget > 0) {
+			resume = false;
+			if (!hif_sim_tx_dequeue(device, i, &xfer, &pipe_wait,
+						&resume))
+				break;
+			budget--;
+			hif_sim_wire_consume(device, xfer.nbytes);
+
+			len = hif_sim_linearize(xfer.nbuf, xfer.nbytes,
+						device->tgt_buf);
+			hif_sim_tx_complete(device, &xfer);
+			hif_sim_target_recv(device, device->tgt_buf, len);
+
+			if (resume &&
+			    device->htc_callbacks.txResourceAvailHandler)
+				device->htc_callbacks.txResourceAvailHandler(
+					device->htc_callbacks.Context,
+					tx_pipes[i]);
+		}
+		if (pipe_wait && (!wait_us || pipe_wait < wait_us))
+			wait_us = pipe_wait;
+	}
+
+	/* tx completions go out before the credits of the same frames */
+	hif_sim_htt_tx_compl_flush(device);
+	hif_sim_send_credit_report(device);
+
+	pipe_wait = 0;
+	hif_sim_cont_rx(device, budget, &pipe_wait);
+	if (pipe_wait && (!wait_us || pipe_wait < wait_us))
+		wait_us = pipe_wait;
+
+	pipe_wait = 0;
+	hif_sim_htt_rx(device, budget, &pipe_wait);
+	if (pipe_wait && (!wait_us || pipe_wait < wait_us))
+		wait_us = pipe_wait;
+
+	local_bh_enable();
+
+	spin_lock_bh(&device->tx_lock);
+	for (i = 0; i < HIF_SIM_TX_PIPE_MAX; i++)
+		pending |= device->tx_pipes[i].count != 0;
+	pending |= device->cont_rx || hif_sim_htt_rx_active(device);
+	if (device->running && pending)
+		queue_delayed_work(device->wq, &device->target_work,
+				   wait_us ? usecs_to_jiffies(wait_us) : 0);
+	spin_unlock_bh(&device->tx_lock);
+}
+
+/**
+ * hif_sim_tx_flush() - complete every transfer still queued to the target
+ * @device: emulated HIF device
+ *
+ * Must be called with the target work stopped.
+ *
+ * Return: none
+ */
+static void hif_sim_tx_flush(HIF_DEVICE_SIM *device)
+{
+	struct hif_sim_tx_pipe *pipe;
+	struct hif_sim_xfer xfer;
+	int i;
+
+	for (i = 0; i < HIF_SIM_TX_PIPE_MAX; i++) {
+		pipe = &device->tx_pipes[i];
+		spin_lock_bh(&device->tx_lock);
+		while (pipe->count) {
+			xfer = pipe->ring[pipe->head];
+			pipe->ring[pipe->head].nbuf = NULL;
+			pipe->head = (pipe->head + 1) % HIF_SIM_MAX_QUEUE_DEPTH;
+			pipe->count--;
+			spin_unlock_bh(&device->tx_lock);
+
+			local_bh_disable();
+			hif_sim_tx_complete(device, &xfer);
+			local_bh_enable();
+
+			spin_lock_bh(&device->tx_lock);
+		}
+		pipe->stalled = false;
+		spin_unlock_bh(&device->tx_lock);
+	}
+}
+
+static void hif_sim_stop(HIF_DEVICE_SIM *device)
+{
+	spin_lock_bh(&device->tx_lock);
+	device->running = false;
+	spin_unlock_bh(&device->tx_lock);
+
+	cancel_delayed_work_sync(&device->target_work);
+	hif_sim_tx_flush(device);
+
+	/* the host frees its rx ring once the target is stopped */
+	device->rx_ring.valid = false;
+}
+
+static int hif_sim_stats_print(HIF_DEVICE_SIM *device, char *buf, int len)
+{
+	struct hif_sim_stats *stats = &device->stats;
+	int pos = 0;
+
+	pos += scnprintf(buf + pos, len - pos,
+			 "tx: msgs %llu bytes %llu queue_full %llu\n",
+			 stats->tx_msgs, stats->tx_bytes, stats->tx_queue_full);
+	pos += scnprintf(buf + pos, len - pos,
+			 "tx latency: avg %llu us max %u us\n",
+			 stats->tx_msgs ?
+			 div64_u64(stats->tx_lat_sum_us, stats->tx_msgs) : 0,
+			 stats->tx_lat_max_us);
+	pos += scnprintf(buf + pos, len - pos,
+			 "rx: msgs %llu bytes %llu alloc_fail %llu\n",
+			 stats->rx_msgs, stats->rx_bytes, stats->rx_alloc_fail);
+	pos += scnprintf(buf + pos, len - pos,
+			 "credits: returned %llu reports %llu\n",
+			 stats->credits_returned, stats->credit_reports);
+	pos += scnprintf(buf + pos, len - pos,
+			 "target: ctrl %llu echo %llu cont_rx %llu unhandled %llu\n",
+			 stats->ctrl_msgs, stats->epping_echo,
+			 stats->epping_cont_rx, stats->unhandled);
+	pos += scnprintf(buf + pos, len - pos,
+			 "bmi: msgs %llu\n", stats->bmi_msgs);
+	pos += scnprintf(buf + pos, len - pos,
+			 "wmi: cmds %llu events %llu\n",
+			 stats->wmi_cmds, stats->wmi_events);
+	pos += scnprintf(buf + pos, len - pos,
+			 "htt: tx_compl %llu rx_msdus %llu rx_ring_empty %llu\n",
+			 stats->htt_tx_compl, stats->htt_rx_msdus,
+			 stats->htt_rx_ring_empty);
+	pos += scnprintf(buf + pos, len - pos,
+			 "config: credits %u x %u depth %u rate %u Mbps latency %u us\n",
+			 hif_sim_credits, hif_sim_credit_size,
+			 device->tx_pipes[0].depth, hif_sim_rate_mbps,
+			 hif_sim_latency_us);
+	return pos;
+}
+
+static ssize_t hif_sim_stats_read(struct file *file, char __user *user_buf,
+				  size_t count, loff_t *ppos)
+{
+	HIF_DEVICE_SIM *device = file->private_data;
+	char *buf;
+	ssize_t ret;
+	int len;
+
+	buf = adf_os_mem_alloc(NULL, HIF_SIM_STATS_BUF_LEN);
+	if (!buf)
+		return -ENOMEM;
+
+	len = hif_sim_stats_print(device, buf, HIF_SIM_STATS_BUF_LEN);
+	ret = simple_read_from_buffer(user_buf, count, ppos, buf, len);
+	adf_os_mem_free(buf);
+	return ret;
+}
+
+static ssize_t hif_sim_stats_write(struct file *file,
+				   const char __user *user_buf,
+				   size_t count, loff_t *ppos)
+{
+	HIF_DEVICE_SIM *device = file->private_data;
+
+	/* any write clears the counters */
+	A_MEMZERO(&device->stats, sizeof(device->stats));
+	return count;
+}
+
+static const struct file_operations fops_hif_sim_stats = {
+	.read = hif_sim_stats_read,
+	.write = hif_sim_stats_write,
+	.open = simple_open,
+	.owner = THIS_MODULE,
+	.llseek = default_llseek,
+};
+
+HIF_DEVICE *hif_sim_device_create(struct hif_sim_softc *sc)
+{
+	HIF_DEVICE_SIM *device;
+	int i;
+
+	AR_DEBUG_PRINTF(ATH_DEBUG_TRC, ("+%s\n", __func__));
+
+	device = vmalloc(sizeof(*device));
+	if (!device)
+		return NULL;
+	A_MEMZERO(device, sizeof(*device));
+
+	device->tgt_buf = adf_os_mem_alloc(NULL, HIF_SIM_MAX_MSG_LEN);
+	if (!device->tgt_buf)
+		goto err_free;
+
+	device->wq = alloc_ordered_workqueue("hif_sim", 0);
+	if (!device->wq)
+		goto err_free;
+
+	device->sc = sc;
+	spin_lock_init(&device->tx_lock);
+	INIT_DELAYED_WORK(&device->target_work, hif_sim_target_work);
+	for (i = 0; i < HIF_SIM_TX_PIPE_MAX; i++)
+		device->tx_pipes[i].depth = clamp_t(unsigned int,
+				hif_sim_queue_depth, 1,
+				HIF_SIM_MAX_QUEUE_DEPTH);
+
+	device->stats_file = debugfs_create_file("hif_sim_stats",
+						 S_IRUSR | S_IWUSR, NULL,
+						 device, &fops_hif_sim_stats);
+
+	AR_DEBUG_PRINTF(ATH_DEBUG_TRC, ("-%s\n", __func__));
+	return (HIF_DEVICE *)device;
+
+err_free:
+	if (device->tgt_buf)
+		adf_os_mem_free(device->tgt_buf);
+	vfree(device);
+	return NULL;
+}
+
+void hif_sim_device_destroy(HIF_DEVICE *hif_device)
+{
+	HIF_DEVICE_SIM *device = (HIF_DEVICE_SIM *)hif_device;
+
+	if (!device)
+		return;
+
+	hif_sim_stop(device);
+	debugfs_remove(device->stats_file);
+	destroy_workqueue(device->wq);
+	adf_os_mem_free(device->tgt_buf);
+	vfree(device);
+}
+
+/* Send the entire buffer */
+A_STATUS HIFSend(HIF_DEVICE *hif_device, a_uint8_t pipe, adf_nbuf_t hdr_buf,
+		 adf_nbuf_t netbuf)
+{
+	return HIFSend_head(hif_device, pipe, 0, adf_nbuf_len(netbuf), netbuf);
+}
+
+A_STATUS
+HIFSend_head(HIF_DEVICE *hif_device,
+	     a_uint8_t pipe, unsigned int transfer_id, unsigned int nbytes,
+	     adf_nbuf_t nbuf)
+{
+	HIF_DEVICE_SIM *device = (HIF_DEVICE_SIM *)hif_device;
+	struct hif_sim_tx_pipe *tx_pipe;
+	struct hif_sim_xfer *xfer;
+
+	if (pipe != HIF_SIM_PIPE_TX_CTRL && pipe != HIF_SIM_PIPE_TX_DATA)
+		return A_EINVAL;
+
+	tx_pipe = &device->tx_pipes[HIF_SIM_TX_PIPE_IDX(pipe)];
+
+	spin_lock_bh(&device->tx_lock);
+	if (!device->running) {
+		spin_unlock_bh(&device->tx_lock);
+		return A_ERROR;
+	}
+	if (tx_pipe->count >= tx_pipe->depth) {
+		tx_pipe->stalled = true;
+		device->stats.tx_queue_full++;
+		spin_unlock_bh(&device->tx_lock);
+		return A_NO_RESOURCE;
+	}
+
+	xfer = &tx_pipe->ring[(tx_pipe->head + tx_pipe->count) %
+			      HIF_SIM_MAX_QUEUE_DEPTH];
+	xfer->nbuf = nbuf;
+	xfer->transfer_id = transfer_id;
+	xfer->nbytes = nbytes;
+	xfer->queued = ktime_get();
+	tx_pipe->count++;
+	queue_delayed_work(device->wq, &device->target_work, 0);
+	spin_unlock_bh(&device->tx_lock);
+
+	return A_OK;
+}
+
+a_uint16_t HIFGetFreeQueueNumber(HIF_DEVICE *hifDevice, a_uint8_t PipeID)
+{
+	HIF_DEVICE_SIM *device = (HIF_DEVICE_SIM *)hifDevice;
+	struct hif_sim_tx_pipe *pipe;
+
+	if (PipeID != HIF_SIM_PIPE_TX_CTRL && PipeID != HIF_SIM_PIPE_TX_DATA)
+		return 0;
+
+	pipe = &device->tx_pipes[HIF_SIM_TX_PIPE_IDX(PipeID)];
+	return pipe->depth - pipe->count;
+}
+
+a_uint16_t HIFGetMaxQueueNumber(HIF_DEVICE *hifDevice, a_uint8_t PipeID)
+{
+	HIF_DEVICE_SIM *device = (HIF_DEVICE_SIM *)hifDevice;
+
+	if (PipeID != HIF_SIM_PIPE_TX_CTRL && PipeID != HIF_SIM_PIPE_TX_DATA)
+		return 0;
+
+	return device->tx_pipes[HIF_SIM_TX_PIPE_IDX(PipeID)].depth;
+}
+
+void HIFPostInit(HIF_DEVICE *hifDevice, void *unused,
+		 MSG_BASED_HIF_CALLBACKS *callbacks)
+{
+	HIF_DEVICE_SIM *device = (HIF_DEVICE_SIM *)hifDevice;
+
+	A_MEMCPY(&device->htc_callbacks, callbacks,
+		 sizeof(MSG_BASED_HIF_CALLBACKS));
+}
+
+void HIFDetachHTC(HIF_DEVICE *hifDevice)
+{
+	HIF_DEVICE_SIM *device = (HIF_DEVICE_SIM *)hifDevice;
+
+	hif_sim_stop(device);
+
+	A_MEMZERO(&device->htc_callbacks, sizeof(MSG_BASED_HIF_CALLBACKS));
+}
+
+A_STATUS HIFStart(HIF_DEVICE *hifDevice)
+{
+	HIF_DEVICE_SIM *device = (HIF_DEVICE_SIM *)hifDevice;
+
+	AR_DEBUG_PRINTF(ATH_DEBUG_TRC, ("+%s\n", __func__));
+
+	/* target "boots": forget the previous HTC session */
+	A_MEMZERO(device->eps, sizeof(device->eps));
+	device->next_ep = ENDPOINT_1;
+	device->setup_done = false;
+	device->cont_rx = false;
+	device->epping_rx_cnt = 0;
+	device->wmi_ep = ENDPOINT_0;
+	device->htt_ep = ENDPOINT_0;
+	A_MEMZERO(device->peers, sizeof(device->peers));
+	device->rx_peer_id = HIF_SIM_INVALID_PEER;
+	device->rx_seq = 0;
+	A_MEMZERO(&device->rx_ring, sizeof(device->rx_ring));
+	device->tx_compl_cnt = 0;
+	device->wire_budget = 0;
+	device->wire_stamp = ktime_get();
+	device->ready_pending = true;
+
+	spin_lock_bh(&device->tx_lock);
+	device->running = true;
+	queue_delayed_work(device->wq, &device->target_work, 0);
+	spin_unlock_bh(&device->tx_lock);
+
+	AR_DEBUG_PRINTF(ATH_DEBUG_TRC, ("-%s\n", __func__));
+	return A_OK;
+}
+
+void HIFStop(HIF_DEVICE *hifDevice)
+{
+	HIF_DEVICE_SIM *device = (HIF_DEVICE_SIM *)hifDevice;
+
+	AR_DEBUG_PRINTF(ATH_DEBUG_TRC, ("+%s\n", __func__));
+
+	hif_sim_stop(device);
+
+	AR_DEBUG_PRINTF(ATH_DEBUG_TRC, ("-%s\n", __func__));
+}
+
+void HIFGetDefaultPipe(HIF_DEVICE *hifDevice, a_uint8_t *ULPipe,
+		       a_uint8_t *DLPipe)
+{
+	*ULPipe = HIF_SIM_PIPE_TX_CTRL;
+	*DLPipe = HIF_SIM_PIPE_RX_CTRL;
+}
+
+int
+HIFMapServiceToPipe(HIF_DEVICE *hif_device, a_uint16_t ServiceId,
+		    a_uint8_t *ULPipe, a_uint8_t *DLPipe, int *ul_is_polled,
+		    int *dl_is_polled)
+{
+	switch (ServiceId) {
+	case HTC_CTRL_RSVD_SVC:
+	case WMI_CONTROL_SVC:
+		*ULPipe = HIF_SIM_PIPE_TX_CTRL;
+		*DLPipe = HIF_SIM_PIPE_RX_CTRL;
+		break;
+	default:
+		*ULPipe = HIF_SIM_PIPE_TX_DATA;
+		*DLPipe = HIF_SIM_PIPE_RX_DATA;
+		break;
+	}
+
+	*ul_is_polled = 0;
+	*dl_is_polled = 0;
+
+	return A_OK;
+}
+
+/*
+ * Target memory is a small write-back table shared by BMI and diag
+ * accesses; words that were never written read as zero.
+ */
+static A_UINT32 hif_sim_mem_read(HIF_DEVICE_SIM *device, A_UINT32 address)
+{
+	A_UINT32 value = 0;
+	int i;
+
+	adf_os_spin_lock_bh(&device->sc->target_lock);
+	for (i = 0; i < device->mem_cnt; i++) {
+		if (device->mem[i].address == address) {
+			value = device->mem[i].value;
+			break;
+		}
+	}
+	adf_os_spin_unlock_bh(&device->sc->target_lock);
+
+	return value;
+}
+
+static A_STATUS hif_sim_mem_write(HIF_DEVICE_SIM *device, A_UINT32 address,
+				  A_UINT32 value)
+{
+	A_STATUS status = A_OK;
+	int i;
+
+	adf_os_spin_lock_bh(&device->sc->target_lock);
+	for (i = 0; i < device->mem_cnt; i++) {
+		if (device->mem[i].address == address)
+			break;
+	}
+	if (i < HIF_SIM_MEM_WORDS) {
+		device->mem[i].address = address;
+		device->mem[i].value = value;
+		if (i == device->mem_cnt)
+			device->mem_cnt++;
+	} else {
+		status = A_NO_MEMORY;
+	}
+	adf_os_spin_unlock_bh(&device->sc->target_lock);
+
+	return status;
+}
+
+/*
+ * BMI commands are answered synchronously. Word sized memory and register
+ * writes go to the target memory table, larger writes and compressed
+ * streams are image downloads and are dropped, EXECUTE does nothing.
+ */
+A_STATUS HIFExchangeBMIMsg(HIF_DEVICE *hif_device,
+			   A_UINT8 *pSendMessage,
+			   A_UINT32 Length,
+			   A_UINT8 *pResponseMessage,
+			   A_UINT32 *pResponseLength, A_UINT32 TimeoutMS)
+{
+	HIF_DEVICE_SIM *device = (HIF_DEVICE_SIM *)hif_device;
+	struct bmi_target_info info;
+	A_UINT32 args[4] = { 0 };
+	A_UINT32 i, value;
+	A_STATUS status = A_OK;
+
+	if (Length < sizeof(args[0]))
+		return A_EINVAL;
+	A_MEMCPY(args, pSendMessage, min_t(A_UINT32, Length, sizeof(args)));
+	device->stats.bmi_msgs++;
+
+	switch (args[0]) {
+	case BMI_WRITE_MEMORY:
+		if (Length == 4 * sizeof(A_UINT32) && args[2] == sizeof(value))
+			status = hif_sim_mem_write(device, args[1], args[3]);
+		break;
+	case BMI_WRITE_SOC_REGISTER:
+		if (Length >= 3 * sizeof(A_UINT32))
+			status = hif_sim_mem_write(device, args[1], args[2]);
+		break;
+	default:
+		break;
+	}
+
+	if (!pResponseMessage || !pResponseLength)
+		return status;
+
+	switch (args[0]) {
+	case BMI_GET_TARGET_INFO:
+		info.target_info_byte_count = sizeof(info);
+		info.target_ver = AR6320_REV2_1_VERSION;
+		info.target_type = TARGET_TYPE_AR6320;
+		*pResponseLength = min_t(A_UINT32, *pResponseLength,
+					 sizeof(info));
+		A_MEMCPY(pResponseMessage, &info, *pResponseLength);
+		break;
+	case BMI_READ_MEMORY:
+		A_MEMZERO(pResponseMessage, *pResponseLength);
+		for (i = 0; i + sizeof(value) <= *pResponseLength;
+		     i += sizeof(value)) {
+			value = hif_sim_mem_read(device, args[1] + i);
+			A_MEMCPY(pResponseMessage + i, &value, sizeof(value));
+		}
+		break;
+	case BMI_READ_SOC_REGISTER:
+		A_MEMZERO(pResponseMessage, *pResponseLength);
+		if (*pResponseLength >= sizeof(value)) {
+			value = hif_sim_mem_read(device, args[1]);
+			A_MEMCPY(pResponseMessage, &value, sizeof(value));
+		}
+		break;
+	default:
+		A_MEMZERO(pResponseMessage, *pResponseLength);
+		break;
+	}
+
+	return status;
+}
+
+A_STATUS HIFConfigureDevice(HIF_DEVICE *hif, HIF_DEVICE_CONFIG_OPCODE opcode,
+			    void *config, A_UINT32 configLen)
+{
+	A_STATUS status = A_OK;
+	HIF_DEVICE_SIM *device = (HIF_DEVICE_SIM *)hif;
+
+	switch (opcode) {
+
+	case HIF_DEVICE_GET_OS_DEVICE:
+		{
+			HIF_DEVICE_OS_DEVICE_INFO *info = config;
+			info->pOSDevice = device->sc->dev;
+		}
+		break;
+	case HIF_DEVICE_GET_MBOX_BLOCK_SIZE:
+		/* provide fake block sizes for mailboxes to satisfy upper layer
+		 * software
+		 */
+		((A_UINT32 *) config)[0] = 16;
+		((A_UINT32 *) config)[1] = 16;
+		((A_UINT32 *) config)[2] = 16;
+		((A_UINT32 *) config)[3] = 16;
+		break;
+	default:
+		status = A_ENOTSUP;
+		break;
+
+	}
+
+	return status;
+}
+
+A_STATUS hifWaitForPendingRecv(HIF_DEVICE *device)
+{
+	return A_OK;
+}
+
+A_STATUS HIFDiagReadAccess(HIF_DEVICE *hifDevice, A_UINT32 address,
+			   A_UINT32 *data)
+{
+	*data = hif_sim_mem_read((HIF_DEVICE_SIM *)hifDevice, address);
+	return A_OK;
+}
+
+A_STATUS HIFDiagWriteAccess(HIF_DEVICE *hifDevice, A_UINT32 address,
+			    A_UINT32 data)
+{
+	return hif_sim_mem_write((HIF_DEVICE_SIM *)hifDevice, address, data);
+}
+
+void HIFShutDownDevice(HIF_DEVICE *hif)
+{
+	HIF_DEVICE_SIM *device = (HIF_DEVICE_SIM *)hif;
+
+	AR_DEBUG_PRINTF(ATH_DEBUG_TRC, ("+%s\n", __func__));
+
+	if (NULL == hif) {
+		AR_DEBUG_PRINTF(ATH_DEBUG_TRC, ("full shutdown\n"));
+		/* this is a full driver shutdown */
+	} else {
+		/* perform any actions to shutdown specific device */
+		hif_sim_stop(device);
+	}
+
+	AR_DEBUG_PRINTF(ATH_DEBUG_TRC, ("-%s\n", __func__));
+}
+
+void HIFReleaseDevice(HIF_DEVICE *hif)
+{
+	HIF_DEVICE_SIM *device = (HIF_DEVICE_SIM *)hif;
+
+	AR_DEBUG_PRINTF(ATH_DEBUG_TRC, ("+%s\n", __func__));
+	device->claimed_context = NULL;
+	AR_DEBUG_PRINTF(ATH_DEBUG_TRC, ("-%s\n", __func__));
+}
+
+void HIFClaimDevice(HIF_DEVICE *hif, void *claimedContext)
+{
+	HIF_DEVICE_SIM *device = (HIF_DEVICE_SIM *)hif;
+	device->claimed_context = claimedContext;
+}
+
+A_STATUS HIFInit(OSDRV_CALLBACKS *callbacks)
+{
+	AR_DEBUG_PRINTF(ATH_DEBUG_TRC, ("+HIFInit\n"));
+
+	A_MEMZERO(&osDrvcallback, sizeof(osDrvcallback));
+
+	A_REGISTER_MODULE_DEBUG_INFO(hif);
+
+	osDrvcallback.deviceInsertedHandler = callbacks->deviceInsertedHandler;
+	osDrvcallback.deviceRemovedHandler = callbacks->deviceRemovedHandler;
+	osDrvcallback.deviceSuspendHandler = callbacks->deviceSuspendHandler;
+	osDrvcallback.deviceResumeHandler = callbacks->deviceResumeHandler;
+	osDrvcallback.deviceWakeupHandler = callbacks->deviceWakeupHandler;
+	osDrvcallback.context = callbacks->context;
+	AR_DEBUG_PRINTF(ATH_DEBUG_TRC, ("-HIFInit\n"));
+	return A_OK;
+}
+
+#ifdef ATH_BUS_PM
+void HIFDeviceSuspend(HIF_DEVICE *dev)
+{
+	HIF_DEVICE_SIM *device = (HIF_DEVICE_SIM *)dev;
+
+	AR_DEBUG_PRINTF(ATH_DEBUG_TRC, ("+%s\n", __func__));
+	if (osDrvcallback.deviceSuspendHandler)
+		osDrvcallback.deviceSuspendHandler(device->claimed_context);
+	AR_DEBUG_PRINTF(ATH_DEBUG_TRC, ("-%s\n", __func__));
+}
+
+void HIFDeviceResume(HIF_DEVICE *dev)
+{
+	HIF_DEVICE_SIM *device = (HIF_DEVICE_SIM *)dev;
+
+	AR_DEBUG_PRINTF(ATH_DEBUG_TRC, ("+%s\n", __func__));
+	if (osDrvcallback.deviceResumeHandler)
+		osDrvcallback.deviceResumeHandler(device->claimed_context);
+	AR_DEBUG_PRINTF(ATH_DEBUG_TRC, ("-%s\n", __func__));
+}
+#endif
+
+void HIFDumpInfo(HIF_DEVICE *hif)
+{
+	HIF_DEVICE_SIM *device = (HIF_DEVICE_SIM *)hif;
+	char *buf;
+
+	buf = adf_os_mem_alloc(NULL, HIF_SIM_STATS_BUF_LEN);
+	if (!buf)
+		return;
+
+	hif_sim_stats_print(device, buf, HIF_SIM_STATS_BUF_LEN);
+	pr_info("hif_sim:\n%s", buf);
+	adf_os_mem_free(buf);
+}
+
+void HIFDump(HIF_DEVICE *hif_device, u_int8_t cmd_id, bool start)
+{
+}
+
+void HIFFlushSurpriseRemove(HIF_DEVICE *hif_device)
+{
+}
+
+A_STATUS
+HIFDiagReadMem(HIF_DEVICE *hif_device, A_UINT32 address, A_UINT8 *data,
+	       int nbytes)
+{
+	A_STATUS status = EOK;
+
+	if ((address & 0x3) || ((uintptr_t)data & 0x3)) {
+		return (-EIO);
+	}
+
+	while ((nbytes >= 4) &&
+			(A_OK == (status = HIFDiagReadAccess(hif_device, address,
+					   (A_UINT32*)data)))) {
+
+		nbytes -= sizeof(A_UINT32);
+		address += sizeof(A_UINT32);
+		data   += sizeof(A_UINT32);
+
+	}
+	return status;
+}
+
+A_STATUS
+HIFDiagWriteMem(HIF_DEVICE *hif_device, A_UINT32 address, A_UINT8 *data, int nbytes)
+{
+	A_STATUS status = EOK;
+
+	if ((address & 0x3) || ((uintptr_t)data & 0x3)) {
+		return (-EIO);
+	}
+
+	while ((nbytes >= 4) &&
+			(A_OK == (status = HIFDiagWriteAccess(hif_device, address,
+					   *((A_UINT32*)data))))) {
+
+		nbytes -= sizeof(A_UINT32);
+		address += sizeof(A_UINT32);
+		data   += sizeof(A_UINT32);
+
+	}
+	return status;
+}
+
+void *hif_get_targetdef(HIF_DEVICE *hif_device)
+{
+	HIF_DEVICE_SIM *device = (HIF_DEVICE_SIM *)hif_device;
+
+	return device->sc->targetdef;
+}
+
+void HIFSendCompleteCheck(HIF_DEVICE *hif_device, a_uint8_t pipe, int force)
+{
+}
+
+void HIFCancelDeferredTargetSleep(HIF_DEVICE *hif_device)
+{
+}
+
+void HIFsuspendwow(HIF_DEVICE *hif_device)
+{
+}
+
+/**
+ * hif_is_80211_fw_wow_required() - API to check if target suspend is needed
+ *
+ * The emulated target has no wlan firmware to put into WoW.
+ *
+ * Return: bool
+ */
+bool hif_is_80211_fw_wow_required(void)
+{
+	return false;
+}
@@ -0,0 +1,286 @@
+/*
+ * Copyright (c) 2016 The Linux Foundation. All rights reserved.
+ *
+ * Previously licensed under the ISC license by Qualcomm Atheros, Inc.
+ *
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/*
+ * This file was originally distributed by Qualcomm Atheros, Inc.
+ * under proprietary terms before Copyright ownership was assigned
+ * to the Linux Foundation.
+ */
+
+#include <linux/slab.h>
+#include <linux/interrupt.h>
+#include <linux/platform_device.h>
+#include <linux/dma-mapping.h>
+#include "if_sim.h"
+#include "bmi_msg.h"		/* TARGET_TYPE_ */
+#include "ol_fw.h"
+#include <osapi_linux.h>
+#include "vos_api.h"
+#include "wma_api.h"
+#include "wlan_hdd_main.h"
+#include "epping_main.h"
+
+#ifndef REMOVE_PKT_LOG
+#include "ol_txrx_types.h"
+#include "pktlog_ac_api.h"
+#include "pktlog_ac.h"
+#endif
+
+#define HIF_SIM_DEVICE_NAME "hif_sim"
+
+/* there is no bus to enumerate, the single emulated target is created
+ * when the driver registers and removed when it unregisters
+ */
+static struct hif_sim_softc *sim_sc;
+
+static int
+hif_sim_configure(struct hif_sim_softc *sc, hif_handle_t *hif_hdl)
+{
+	sc->hif_device = hif_sim_device_create(sc);
+	if (!sc->hif_device) {
+		pr_err("ath: %s: Target create failed.\n", __func__);
+		return -ENOMEM;
+	}
+
+	if (athdiag_procfs_init(sc) != 0) {
+		pr_err("athdiag_procfs_init failed\n");
+		hif_sim_device_destroy(sc->hif_device);
+		sc->hif_device = NULL;
+		return A_ERROR;
+	}
+	*hif_hdl = sc->hif_device;
+	return 0;
+}
+
+static int hif_sim_probe(struct platform_device *pdev)
+{
+	int ret = 0;
+	struct hif_sim_softc *sc;
+	struct ol_softc *ol_sc;
+
+	pr_info("hif_sim_probe\n");
+
+	sc = A_MALLOC(sizeof(*sc));
+	if (!sc) {
+		ret = -ENOMEM;
+		goto err_alloc;
+	}
+
+	OS_MEMZERO(sc, sizeof(*sc));
+	sc->pdev = pdev;
+	sc->dev = &pdev->dev;
+
+	/*
+	 * HTT carries 32 bit bus addresses and the emulated target follows
+	 * them into host memory, keep the rx ring and its buffers below 4GB
+	 */
+	pdev->dev.coherent_dma_mask = DMA_BIT_MASK(32);
+	pdev->dev.dma_mask = &pdev->dev.coherent_dma_mask;
+
+	sc->aps_osdev.bdev = pdev;
+	sc->aps_osdev.device = &pdev->dev;
+	sc->aps_osdev.bc.bc_bustype = HAL_BUS_TYPE_AHB;
+
+	adf_os_spinlock_init(&sc->target_lock);
+
+	ol_sc = A_MALLOC(sizeof(*ol_sc));
+	if (!ol_sc) {
+		ret = -ENOMEM;
+		goto err_attach;
+	}
+	OS_MEMZERO(ol_sc, sizeof(*ol_sc));
+	ol_sc->sc_osdev = &sc->aps_osdev;
+	ol_sc->hif_sc = (void *)sc;
+	sc->ol_sc = ol_sc;
+
+	ret = hif_sim_configure(sc, &ol_sc->hif_hdl);
+	if (ret)
+		goto err_config;
+
+	ol_sc->enableuartprint = 1;
+	ol_sc->enablefwlog = 0;
+	ol_sc->enablesinglebinary = FALSE;
+	ol_sc->max_no_of_peers = 1;
+
+	init_waitqueue_head(&ol_sc->sc_osdev->event_queue);
+
+	ret = hif_init_adf_ctx(ol_sc);
+	if (ret == 0)
+		ret = hdd_wlan_startup(&pdev->dev, ol_sc);
+	if (ret) {
+		hif_sim_device_destroy(sc->hif_device);
+		athdiag_procfs_remove();
+		goto err_config;
+	}
+	atomic_set(&sc->hdd_removed, -1);
+
+	sim_sc = sc;
+	return 0;
+
+err_config:
+	hif_deinit_adf_ctx(ol_sc);
+	A_FREE(ol_sc);
+err_attach:
+	A_FREE(sc);
+err_alloc:
+	return ret;
+}
+
+static void hif_sim_remove(void)
+{
+	struct hif_sim_softc *sc = sim_sc;
+	struct ol_softc *scn;
+
+	if (!sc)
+		return;
+
+	pr_info("Try to remove hif_sim!\n");
+	vos_set_shutdown_in_progress(VOS_MODULE_ID_HIF, TRUE);
+	scn = sc->ol_sc;
+
+	if (atomic_inc_and_test(&sc->hdd_removed)) {
+#ifndef REMOVE_PKT_LOG
+		if (vos_get_conparam() != VOS_FTM_MODE &&
+			!WLAN_IS_EPPING_ENABLED(vos_get_conparam()))
+			pktlogmod_exit(scn);
+#endif
+		__hdd_wlan_exit();
+		pr_info("Exit HDD wlan... done by %s\n", __func__);
+	}
+
+	hif_sim_device_destroy(sc->hif_device);
+	athdiag_procfs_remove();
+	vos_set_shutdown_in_progress(VOS_MODULE_ID_HIF, FALSE);
+	hif_deinit_adf_ctx(scn);
+	A_FREE(scn);
+	A_FREE(sc);
+	sim_sc = NULL;
+}
+
+int hif_init_adf_ctx(void *ol_sc)
+{
+	adf_os_device_t adf_ctx;
+	v_CONTEXT_t pVosContext = NULL;
+	struct ol_softc *sc = (struct ol_softc *)ol_sc;
+	struct hif_sim_softc *hif_sc = (struct hif_sim_softc *)sc->hif_sc;
+
+	pVosContext = vos_get_global_context(VOS_MODULE_ID_SYS, NULL);
+	if(pVosContext == NULL)
+		return -EFAULT;
+
+	adf_ctx = vos_mem_malloc(sizeof(*adf_ctx));
+	if (!adf_ctx)
+		return -ENOMEM;
+	vos_mem_zero(adf_ctx, sizeof(*adf_ctx));
+	adf_ctx->drv = &hif_sc->aps_osdev;
+	adf_ctx->drv_hdl = hif_sc->aps_osdev.bdev;
+	adf_ctx->dev = hif_sc->aps_osdev.device;
+	sc->adf_dev = adf_ctx;
+	((VosContextType*)(pVosContext))->adf_ctx = adf_ctx;
+	return 0;
+}
+
+void hif_deinit_adf_ctx(void *ol_sc)
+{
+	struct ol_softc *sc = (struct ol_softc *)ol_sc;
+
+	if (sc == NULL)
+		return;
+	if (sc->adf_dev) {
+		v_CONTEXT_t pVosContext = NULL;
+
+		pVosContext = vos_get_global_context(VOS_MODULE_ID_SYS, NULL);
+		vos_mem_free(sc->adf_dev);
+		sc->adf_dev = NULL;
+		if (pVosContext)
+			((VosContextType*)(pVosContext))->adf_ctx = NULL;
+	}
+}
+
+static struct platform_device *hif_sim_pdev;
+
+int hif_register_driver(void)
+{
+	int status;
+
+	hif_sim_pdev = platform_device_register_simple(HIF_SIM_DEVICE_NAME,
+						       -1, NULL, 0);
+	if (IS_ERR(hif_sim_pdev)) {
+		status = PTR_ERR(hif_sim_pdev);
+		hif_sim_pdev = NULL;
+		pr_err("%s: failed to create %s device (%d)\n", __func__,
+		       HIF_SIM_DEVICE_NAME, status);
+		return status;
+	}
+
+	status = hif_sim_probe(hif_sim_pdev);
+	if (status) {
+		platform_device_unregister(hif_sim_pdev);
+		hif_sim_pdev = NULL;
+		return -1;
+	}
+
+	return 0;
+}
+
+void hif_unregister_driver(void)
+{
+	if (!hif_sim_pdev)
+		return;
+
+	pr_info("Try to unregister hif_driver\n");
+	hif_sim_remove();
+	platform_device_unregister(hif_sim_pdev);
+	hif_sim_pdev = NULL;
+	pr_info("hif_unregister_driver!!!!!!\n");
+}
+
+/* Function to set the TXRX handle in the ol_sc context */
+void hif_init_pdev_txrx_handle(void *ol_sc, void *txrx_handle)
+{
+	struct ol_softc *sc = (struct ol_softc *)ol_sc;
+	sc->pdev_txrx_handle = txrx_handle;
+}
+
+void hif_disable_isr(void *ol_sc)
+{
+	/* no interrupts on the emulated bus */
+}
+
+/* Function to reset SoC */
+void hif_reset_soc(void *ol_sc)
+{
+	/* nothing to reset, HIFStart boots the emulated target again */
+}
+
+void hif_get_hw_info(void *ol_sc, u32 *version, u32 *revision)
+{
+	/* the emulated target has no register tables to attach */
+	*version = ((struct ol_softc *)ol_sc)->target_version;
+	*revision = ((struct ol_softc *)ol_sc)->target_revision;
+}
+
+void hif_set_fw_info(void *ol_sc, u32 target_fw_version)
+{
+	((struct ol_softc *)ol_sc)->target_fw_version = target_fw_version;
+}
+
+MODULE_LICENSE("Dual BSD/GPL");
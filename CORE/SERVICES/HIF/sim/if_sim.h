@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2016 The Linux Foundation. All rights reserved.
+ *
+ * Previously licensed under the ISC license by Qualcomm Atheros, Inc.
+ *
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/*
+ * This file was originally distributed by Qualcomm Atheros, Inc.
+ * under proprietary terms before Copyright ownership was assigned
+ * to the Linux Foundation.
+ */
+
+/*
+ * Emulated target HIF backend.
+ *
+ * There is no bus and no firmware behind this HIF: a host memory model
+ * of the target answers BMI, the HTC control handshake and the endpoint
+ * ping protocol, returns HTC credits and completes transfers at a
+ * configurable rate. It lets the host stack from HTC upwards be loaded
+ * and benchmarked on any Linux machine.
+ */
+#ifndef __ATH_SIM_H__
+#define __ATH_SIM_H__
+
+#include <linux/version.h>
+#include <linux/semaphore.h>
+#include <linux/interrupt.h>
+#include <linux/platform_device.h>
+
+/*
+ * There may be some pending tx frames during platform suspend.
+ * Suspend operation should be delayed until those tx frames are
+ * transfered from the host to target. This macro specifies how
+ * long suspend thread has to sleep before checking pending tx
+ * frame count.
+ */
+#define OL_ATH_TX_DRAIN_WAIT_DELAY     50	/* ms */
+/*
+ * Wait time (in unit of OL_ATH_TX_DRAIN_WAIT_DELAY) for pending
+ * tx frame completion before suspend.
+ */
+#define OL_ATH_TX_DRAIN_WAIT_CNT       10
+
+#define ATH_DBG_DEFAULT   0
+#include <osdep.h>
+#include <ol_if_athvar.h>
+#include <athdefs.h>
+#include "osapi_linux.h"
+#include "hif.h"
+
+struct hif_sim_softc {
+	/* For efficiency, should be first in struct */
+	struct device *dev;
+	struct platform_device *pdev;
+	struct _NIC_DEV aps_osdev;
+	struct ol_softc *ol_sc;
+	/*
+	 * Guard changes to Target HW state and to software
+	 * structures that track hardware state.
+	 */
+	adf_os_spinlock_t target_lock;
+
+	HIF_DEVICE *hif_device;
+
+	u16 devid;
+	struct targetdef_s *targetdef;
+	struct hostdef_s *hostdef;
+	atomic_t hdd_removed;
+};
+
+/* The emulated target has no diag window to expose through procfs */
+static inline int athdiag_procfs_init(void *scn) { return 0; }
+static inline void athdiag_procfs_remove(void) { return; }
+
+/* Create and destroy the emulated target behind a HIF device */
+HIF_DEVICE *hif_sim_device_create(struct hif_sim_softc *sc);
+void hif_sim_device_destroy(HIF_DEVICE *hif_device);
+
+/*These functions are exposed to HDD*/
+int hif_register_driver(void);
+void hif_unregister_driver(void);
+int hif_init_adf_ctx(void *ol_sc);
+void hif_init_pdev_txrx_handle(void *ol_sc, void *txrx_handle);
+void hif_disable_isr(void *ol_sc);
+void hif_reset_soc(void *ol_sc);
+void hif_deinit_adf_ctx(void *ol_sc);
+
+void hif_get_hw_info(void *ol_sc, u32 *version, u32 *revision);
+void hif_set_fw_info(void *ol_sc, u32 target_fw_version);
+#endif /* __ATH_SIM_H__ */
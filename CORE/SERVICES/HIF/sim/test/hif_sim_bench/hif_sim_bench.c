@@ -0,0 +1,956 @@
+/*
+ * Copyright (c) 2016 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/*
+ * Emulated target benchmark harness
+ *
+ * Builds hif_sim.c against userspace stubs and drives it the way BMI,
+ * HTC, WMA and the HTT host do: word sized BMI and diag accesses, the
+ * HTC READY/CONNECT/SETUP_COMPLETE handshake, WMI SERVICE_READY and
+ * READY, HTT version, rx ring and peer setup, then HTT tx frames and
+ * in-order rx. Both WMI events go through wmitlv_check_and_pad_event_tlvs()
+ * as WMA would see them. The harness checks that
+ *   - every tx msdu id is completed exactly once and every HTC credit
+ *     spent comes back,
+ *   - rx buffers are indicated in the order they were posted, from the
+ *     mapped peer, with a descriptor and an IPv4/UDP frame the host can
+ *     use, and nothing is indicated once the peer is deleted,
+ *   - no network buffer is leaked,
+ * and reports tx completion and rx rates on stderr. The target work runs
+ * on the calling thread whenever it is pending, so the rates are those of
+ * the emulation itself. See hif_sim_bench.sh.
+ *
+ * Usage:
+ *   hif_sim_bench [-v] -r <seed> <runs>
+ *
+ * Each run brings the target up from scratch with the credit count, tx
+ * queue depth, rx ring size and rx frame length drawn from the seed.
+ */
+
+#include "hif_sim.c"
+#include <time.h>
+
+#define SIM_DMA_ARENA_SIZE  (4 << 20)
+#define SIM_TX_MSDUS        50000
+#define SIM_RX_MSDUS        50000
+#define SIM_MSDU_IDS        1024
+#define SIM_TX_DESC_BYTES   16
+#define SIM_RX_BUF_SIZE     1920
+#define SIM_MAX_RX_MSGS     4096
+/* passes of the target work without progress before a run is failed */
+#define SIM_STALL_PASSES    10000
+
+/* the HTT host rx descriptor, see struct htt_host_rx_desc_base */
+struct sim_rx_desc {
+    A_UINT32 fw_desc;
+    struct rx_attention attention;
+    struct rx_frag_info frag_info;
+    struct rx_mpdu_start mpdu_start;
+    struct rx_msdu_start msdu_start;
+    struct rx_msdu_end msdu_end;
+    struct rx_mpdu_end mpdu_end;
+    struct rx_ppdu_start ppdu_start;
+    struct rx_ppdu_end ppdu_end;
+    char rx_hdr_status[64];
+};
+
+struct sim_host {
+    HIF_DEVICE *hif;
+    HIF_DEVICE_SIM *device;
+    struct hif_sim_softc sc;
+    int errors;
+
+    /* messages from the target, handled after each pass of its work */
+    adf_nbuf_t rx_msgs[SIM_MAX_RX_MSGS];
+    int rx_msg_cnt;
+
+    /* HTC */
+    bool htc_ready;
+    int credits;
+    A_UINT8 wmi_ep;
+    A_UINT8 htt_ep;
+    unsigned long credits_spent;
+    unsigned long credits_back;
+
+    /* WMI */
+    bool service_ready;
+    bool wmi_ready;
+    A_UINT8 mac_addr[ETH_ALEN];
+    wmi_abi_version abi;
+
+    /* HTT */
+    bool version_conf;
+    A_UINT8 peer_mac[ETH_ALEN];
+    A_UINT16 peer_id;
+    bool peer_mapped;
+
+    /* tx */
+    bool msdu_inflight[SIM_MSDU_IDS];
+    A_UINT16 free_ids[SIM_MSDU_IDS];
+    int free_cnt;
+    unsigned long tx_sent;
+    unsigned long tx_done;
+
+    /* rx ring, one slot always empty like the HTT host keeps it */
+    A_UINT32 *ring;
+    A_UINT32 *alloc_idx;
+    A_UINT32 ring_paddr;
+    A_UINT32 alloc_idx_paddr;
+    A_UINT32 bufs_paddr;
+    unsigned int ring_size;
+    unsigned int sw_rd_idx;
+    A_UINT32 *popped;
+    unsigned int popped_cnt;
+    unsigned int rx_len;
+    unsigned long rx_msdus;
+    A_UINT16 rx_seq;
+};
+
+int sim_verbose;
+int sim_con_mode;
+unsigned long sim_nbuf_outstanding;
+uint8_t *sim_dma_arena;
+static unsigned int sim_dma_used;
+static uint32_t rnd_state;
+static struct timespec tx_time, rx_time;
+static unsigned long tx_total, rx_total;
+
+static uint32_t rnd(void)
+{
+    rnd_state ^= rnd_state << 13;
+    rnd_state ^= rnd_state >> 17;
+    rnd_state ^= rnd_state << 5;
+    return rnd_state;
+}
+
+static void timespec_add_since(struct timespec *acc,
+                               const struct timespec *start)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    acc->tv_sec += now.tv_sec - start->tv_sec;
+    acc->tv_nsec += now.tv_nsec - start->tv_nsec;
+    if (acc->tv_nsec < 0) {
+        acc->tv_nsec += 1000000000L;
+        acc->tv_sec--;
+    } else if (acc->tv_nsec >= 1000000000L) {
+        acc->tv_nsec -= 1000000000L;
+        acc->tv_sec++;
+    }
+}
+
+#define SIM_CHECK(host, cond, ...) do {                               \
+        if (!(cond)) {                                                \
+            (host)->errors++;                                         \
+            fprintf(stderr, "hif_sim_bench: " __VA_ARGS__);           \
+            fprintf(stderr, "\n");                                    \
+        }                                                             \
+    } while (0)
+
+static void *sim_dma_alloc(unsigned int size, A_UINT32 *paddr)
+{
+    void *vaddr;
+
+    size = roundup(size, 8);
+    if (sim_dma_used + size > SIM_DMA_ARENA_SIZE)
+        return NULL;
+    vaddr = sim_dma_arena + sim_dma_used;
+    *paddr = SIM_DMA_BASE + sim_dma_used;
+    sim_dma_used += size;
+    return vaddr;
+}
+
+static A_STATUS sim_htc_tx_done(void *ctx, adf_nbuf_t nbuf, unsigned int id)
+{
+    adf_nbuf_free(nbuf);
+    return A_OK;
+}
+
+static A_STATUS sim_htc_rx(void *ctx, adf_nbuf_t nbuf, a_uint8_t pipe)
+{
+    struct sim_host *host = ctx;
+
+    if (host->rx_msg_cnt == SIM_MAX_RX_MSGS) {
+        SIM_CHECK(host, 0, "too many messages in one pass");
+        adf_nbuf_free(nbuf);
+        return A_OK;
+    }
+    host->rx_msgs[host->rx_msg_cnt++] = nbuf;
+    return A_OK;
+}
+
+static void sim_run_pass(struct sim_host *host);
+
+/* send an HTC message, running the target while the pipe is full */
+static void sim_send(struct sim_host *host, A_UINT8 ep, const void *payload,
+                     unsigned int len)
+{
+    A_UINT8 ul, dl;
+    int ul_polled, dl_polled, stall = 0;
+    adf_nbuf_t nbuf;
+    A_UINT8 *hdr;
+
+    HIFMapServiceToPipe(host->hif, ep == ENDPOINT_0 ? HTC_CTRL_RSVD_SVC :
+                        host->device->eps[ep].service_id, &ul, &dl,
+                        &ul_polled, &dl_polled);
+
+    nbuf = adf_nbuf_alloc(NULL, HTC_HDR_LENGTH + len, 0, 4, FALSE);
+    hdr = adf_nbuf_put_tail(nbuf, HTC_HDR_LENGTH + len);
+    memset(hdr, 0, HTC_HDR_LENGTH);
+    HTC_SET_FIELD(hdr, HTC_FRAME_HDR, ENDPOINTID, ep);
+    HTC_SET_FIELD(hdr, HTC_FRAME_HDR, PAYLOADLEN, len);
+    memcpy(hdr + HTC_HDR_LENGTH, payload, len);
+
+    if (ep != ENDPOINT_0)
+        host->credits_spent += hif_sim_credits_for(HTC_HDR_LENGTH + len);
+
+    while (HIFSend_head(host->hif, ul, 0, HTC_HDR_LENGTH + len, nbuf) ==
+           A_NO_RESOURCE) {
+        if (++stall > SIM_STALL_PASSES) {
+            SIM_CHECK(host, 0, "tx pipe %d never drains", ul);
+            adf_nbuf_free(nbuf);
+            return;
+        }
+        sim_run_pass(host);
+    }
+}
+
+static void sim_wmi_send(struct sim_host *host, A_UINT32 cmd_id,
+                         const void *cmd, unsigned int len)
+{
+    A_UINT8 buf[sizeof(WMI_CMD_HDR) + 64];
+
+    memset(buf, 0, sizeof(WMI_CMD_HDR));
+    WMI_SET_FIELD(buf, WMI_CMD_HDR, COMMANDID, cmd_id);
+    memcpy(buf + sizeof(WMI_CMD_HDR), cmd, len);
+    sim_send(host, host->wmi_ep, buf, sizeof(WMI_CMD_HDR) + len);
+}
+
+static void sim_htc_ctrl(struct sim_host *host, A_UINT8 *msg,
+                         unsigned int len)
+{
+    A_UINT16 svc;
+    A_UINT8 ep;
+
+    switch (HTC_GET_FIELD(msg, HTC_UNKNOWN_MSG, MESSAGEID)) {
+    case HTC_MSG_READY_ID:
+        host->htc_ready = true;
+        host->credits = HTC_GET_FIELD(msg, HTC_READY_MSG, CREDITCOUNT);
+        SIM_CHECK(host, host->credits == hif_sim_credits,
+                  "READY with %d credits", host->credits);
+        break;
+    case HTC_MSG_CONNECT_SERVICE_RESPONSE_ID:
+        svc = HTC_GET_FIELD(msg, HTC_CONNECT_SERVICE_RESPONSE_MSG,
+                            SERVICEID);
+        ep = HTC_GET_FIELD(msg, HTC_CONNECT_SERVICE_RESPONSE_MSG,
+                           ENDPOINTID);
+        SIM_CHECK(host, HTC_GET_FIELD(msg, HTC_CONNECT_SERVICE_RESPONSE_MSG,
+                                      STATUS) == HTC_SERVICE_SUCCESS,
+                  "connect of service 0x%x failed", svc);
+        if (svc == WMI_CONTROL_SVC)
+            host->wmi_ep = ep;
+        else if (svc == HTT_DATA_MSG_SVC)
+            host->htt_ep = ep;
+        break;
+    default:
+        SIM_CHECK(host, 0, "unexpected HTC control message %d",
+                  HTC_GET_FIELD(msg, HTC_UNKNOWN_MSG, MESSAGEID));
+        break;
+    }
+}
+
+static void sim_wmi_service_ready(struct sim_host *host, void *tlvs)
+{
+    WMI_SERVICE_READY_EVENTID_param_tlvs *param = tlvs;
+    wmi_init_cmd_fixed_param init;
+
+    SIM_CHECK(host, param->fixed_param && param->hal_reg_capabilities &&
+              param->wmi_service_bitmap, "SERVICE_READY misses a TLV");
+    if (host->errors)
+        return;
+    SIM_CHECK(host, WMI_SERVICE_IS_ENABLED(param->wmi_service_bitmap,
+                                           WMI_SERVICE_RX_FULL_REORDER),
+              "SERVICE_READY without rx full reorder");
+    SIM_CHECK(host, param->fixed_param->num_mem_reqs == 0,
+              "SERVICE_READY asks for host memory");
+    SIM_CHECK(host, param->hal_reg_capabilities->low_2ghz_chan &&
+              param->hal_reg_capabilities->high_5ghz_chan,
+              "SERVICE_READY without channel ranges");
+    host->service_ready = true;
+
+    memset(&init, 0, sizeof(init));
+    WMITLV_SET_HDR(&init.tlv_header,
+                   WMITLV_TAG_STRUC_wmi_init_cmd_fixed_param,
+                   WMITLV_GET_STRUCT_TLVLEN(wmi_init_cmd_fixed_param));
+    host->abi.abi_version_0 = WMI_ABI_VERSION_0;
+    host->abi.abi_version_1 = WMI_ABI_VERSION_1;
+    host->abi.abi_version_ns_0 = WMI_ABI_VERSION_NS_0;
+    host->abi.abi_version_ns_1 = WMI_ABI_VERSION_NS_1;
+    host->abi.abi_version_ns_2 = WMI_ABI_VERSION_NS_2;
+    host->abi.abi_version_ns_3 = WMI_ABI_VERSION_NS_3;
+    init.host_abi_vers = host->abi;
+    sim_wmi_send(host, WMI_INIT_CMDID, &init, sizeof(init));
+}
+
+static void sim_wmi_ready(struct sim_host *host, void *tlvs)
+{
+    WMI_READY_EVENTID_param_tlvs *param = tlvs;
+
+    SIM_CHECK(host, param->fixed_param, "READY misses its fixed param");
+    if (host->errors)
+        return;
+    SIM_CHECK(host, param->fixed_param->status == WLAN_INIT_STATUS_SUCCESS,
+              "READY status %d", param->fixed_param->status);
+    SIM_CHECK(host, !memcmp(&param->fixed_param->fw_abi_vers, &host->abi,
+                            sizeof(host->abi)),
+              "READY does not echo the host abi version");
+    WMI_MAC_ADDR_TO_CHAR_ARRAY(&param->fixed_param->mac_addr,
+                               host->mac_addr);
+    host->wmi_ready = true;
+}
+
+static void sim_wmi_event(struct sim_host *host, A_UINT8 *msg,
+                          unsigned int len)
+{
+    A_UINT32 event_id = WMI_GET_FIELD(msg, WMI_CMD_HDR, COMMANDID);
+    void *tlvs = NULL;
+
+    if (wmitlv_check_and_pad_event_tlvs(NULL, msg + sizeof(WMI_CMD_HDR),
+                                        len - sizeof(WMI_CMD_HDR), event_id,
+                                        &tlvs)) {
+        SIM_CHECK(host, 0, "WMI event 0x%x fails the TLV check", event_id);
+        return;
+    }
+
+    switch (event_id) {
+    case WMI_SERVICE_READY_EVENTID:
+        SIM_CHECK(host, !host->service_ready, "second SERVICE_READY");
+        sim_wmi_service_ready(host, tlvs);
+        break;
+    case WMI_READY_EVENTID:
+        SIM_CHECK(host, host->service_ready && !host->wmi_ready,
+                  "READY out of order");
+        sim_wmi_ready(host, tlvs);
+        break;
+    default:
+        SIM_CHECK(host, 0, "unexpected WMI event 0x%x", event_id);
+        break;
+    }
+    wmitlv_free_allocated_event_tlvs(event_id, &tlvs);
+}
+
+static void sim_htt_tx_compl(struct sim_host *host, A_UINT32 *msg_word,
+                             unsigned int len)
+{
+    struct htt_tx_compl_ind_base *compl = (void *)msg_word;
+    int num = HTT_TX_COMPL_IND_NUM_GET(*msg_word);
+    A_UINT16 id;
+    int i;
+
+    SIM_CHECK(host, HTT_TX_COMPL_IND_STATUS_GET(*msg_word) ==
+              HTT_TX_COMPL_IND_STAT_OK, "tx completion status");
+    SIM_CHECK(host, len == 4 + 2 * roundup(num, 2),
+              "tx completion of %d ids is %u bytes", num, len);
+    if (num & 0x1)
+        SIM_CHECK(host, compl->payload[num] == HTT_TX_COMPL_INV_MSDU_ID,
+                  "odd tx completion not padded");
+
+    for (i = 0; i < num; i++) {
+        id = compl->payload[i];
+        if (id >= SIM_MSDU_IDS || !host->msdu_inflight[id]) {
+            SIM_CHECK(host, 0, "msdu %u completed but not in flight", id);
+            continue;
+        }
+        host->msdu_inflight[id] = false;
+        host->free_ids[host->free_cnt++] = id;
+        host->tx_done++;
+    }
+}
+
+static A_UINT16 sim_csum(const A_UINT8 *p, unsigned int len)
+{
+    A_UINT32 sum = 0;
+    unsigned int i;
+
+    for (i = 0; i < len; i += 2)
+        sum += (p[i] << 8) | p[i + 1];
+    while (sum >> 16)
+        sum = (sum & 0xffff) + (sum >> 16);
+    return sum;
+}
+
+static void sim_check_rx_msdu(struct sim_host *host, A_UINT8 *buf,
+                              unsigned int len)
+{
+    struct sim_rx_desc *desc = (struct sim_rx_desc *)buf;
+    A_UINT8 *frame = buf + host->device->rx_ring.payload_offset;
+    A_UINT8 *ip = frame + ETH_HLEN;
+
+    SIM_CHECK(host, len == host->rx_len, "msdu of %u bytes, want %u",
+              len, host->rx_len);
+    SIM_CHECK(host, desc->attention.msdu_done &&
+              desc->attention.first_mpdu && desc->attention.last_mpdu &&
+              desc->msdu_end.first_msdu && desc->msdu_end.last_msdu,
+              "rx descriptor flags");
+    SIM_CHECK(host, desc->msdu_start.msdu_length == len &&
+              desc->msdu_start.decap_format == HIF_SIM_RX_DECAP_ETH2 &&
+              desc->msdu_start.ipv4_proto && desc->msdu_start.udp_proto,
+              "rx msdu_start");
+    SIM_CHECK(host, desc->mpdu_start.seq_num == (host->rx_seq & 0xfff),
+              "rx seq %u, want %u", desc->mpdu_start.seq_num,
+              host->rx_seq & 0xfff);
+    host->rx_seq++;
+
+    SIM_CHECK(host, !memcmp(frame, host->mac_addr, ETH_ALEN) &&
+              !memcmp(frame + ETH_ALEN, host->peer_mac, ETH_ALEN),
+              "rx frame addresses");
+    SIM_CHECK(host, frame[12] == 0x08 && frame[13] == 0x00 &&
+              ip[0] == 0x45 && ip[9] == IPPROTO_UDP,
+              "rx frame is not IPv4/UDP");
+    SIM_CHECK(host, sim_csum(ip, HIF_SIM_IP_HDR_LEN) == 0xffff,
+              "rx IPv4 checksum");
+    SIM_CHECK(host, ((ip[2] << 8) | ip[3]) == len - ETH_HLEN &&
+              ((ip[24] << 8) | ip[25]) == len - ETH_HLEN - HIF_SIM_IP_HDR_LEN,
+              "rx IPv4/UDP lengths");
+}
+
+static void sim_htt_rx_ind(struct sim_host *host, A_UINT32 *msg_word,
+                           unsigned int len)
+{
+    unsigned int cnt, i, mask = host->ring_size - 1;
+    A_UINT32 paddr, msdu_len;
+
+    SIM_CHECK(host, host->peer_mapped, "rx indication without a peer");
+    SIM_CHECK(host, HTT_RX_IN_ORD_PADDR_IND_PEER_ID_GET(*msg_word) ==
+              host->peer_id, "rx indication from peer %u",
+              HTT_RX_IN_ORD_PADDR_IND_PEER_ID_GET(*msg_word));
+    msg_word++;
+    cnt = HTT_RX_IN_ORD_PADDR_IND_MSDU_CNT_GET(*msg_word);
+    SIM_CHECK(host, HTT_RX_IN_ORD_PADDR_IND_VAP_ID_GET(*msg_word) == 0,
+              "rx indication vdev");
+    SIM_CHECK(host, cnt && len == HTT_RX_IN_ORD_PADDR_IND_HDR_BYTES +
+              cnt * HTT_RX_IN_ORD_PADDR_IND_MSDU_BYTES,
+              "rx indication of %u msdus is %u bytes", cnt, len);
+    if (host->errors)
+        return;
+    msg_word++;
+
+    for (i = 0; i < cnt; i++) {
+        paddr = HTT_RX_IN_ORD_PADDR_IND_PADDR_GET(*msg_word);
+        msg_word++;
+        msdu_len = HTT_RX_IN_ORD_PADDR_IND_MSDU_LEN_GET(*msg_word);
+        msg_word++;
+
+        if (host->sw_rd_idx == *host->alloc_idx ||
+            paddr != host->ring[host->sw_rd_idx]) {
+            SIM_CHECK(host, 0, "rx buffer 0x%x out of order", paddr);
+            return;
+        }
+        host->sw_rd_idx = (host->sw_rd_idx + 1) & mask;
+        sim_check_rx_msdu(host, phys_to_virt(paddr), msdu_len);
+        host->popped[host->popped_cnt++] = paddr;
+        host->rx_msdus++;
+    }
+}
+
+static void sim_htt_msg(struct sim_host *host, A_UINT8 *msg, unsigned int len)
+{
+    A_UINT32 *msg_word = (A_UINT32 *)msg;
+    A_UINT8 mac[ETH_ALEN];
+
+    switch (HTT_T2H_MSG_TYPE_GET(*msg_word)) {
+    case HTT_T2H_MSG_TYPE_VERSION_CONF:
+        SIM_CHECK(host, HTT_VER_CONF_MAJOR_GET(*msg_word) ==
+                  HTT_CURRENT_VERSION_MAJOR, "HTT major version");
+        host->version_conf = true;
+        break;
+    case HTT_T2H_MSG_TYPE_PEER_MAP:
+        memcpy(mac, msg + HTT_RX_PEER_MAP_MAC_ADDR_OFFSET, ETH_ALEN);
+        SIM_CHECK(host, !host->peer_mapped &&
+                  HTT_RX_PEER_MAP_VDEV_ID_GET(*msg_word) == 0 &&
+                  !memcmp(mac, host->peer_mac, ETH_ALEN),
+                  "unexpected peer map");
+        host->peer_id = HTT_RX_PEER_MAP_PEER_ID_GET(*msg_word);
+        host->peer_mapped = true;
+        break;
+    case HTT_T2H_MSG_TYPE_PEER_UNMAP:
+        SIM_CHECK(host, host->peer_mapped &&
+                  HTT_RX_PEER_UNMAP_PEER_ID_GET(*msg_word) == host->peer_id,
+                  "unexpected peer unmap");
+        host->peer_mapped = false;
+        break;
+    case HTT_T2H_MSG_TYPE_TX_COMPL_IND:
+        sim_htt_tx_compl(host, msg_word, len);
+        break;
+    case HTT_T2H_MSG_TYPE_RX_IN_ORD_PADDR_IND:
+        sim_htt_rx_ind(host, msg_word, len);
+        break;
+    default:
+        SIM_CHECK(host, 0, "unexpected HTT message %d",
+                  HTT_T2H_MSG_TYPE_GET(*msg_word));
+        break;
+    }
+}
+
+static void sim_credit_trailer(struct sim_host *host, A_UINT8 *trailer,
+                               unsigned int len)
+{
+    HTC_CREDIT_REPORT *rpt;
+    unsigned int rec_len, i;
+
+    SIM_CHECK(host, len >= sizeof(HTC_RECORD_HDR) &&
+              HTC_GET_FIELD(trailer, HTC_RECORD_HDR, RECORDID) ==
+              HTC_RECORD_CREDITS, "unexpected trailer");
+    if (host->errors)
+        return;
+    rec_len = HTC_GET_FIELD(trailer, HTC_RECORD_HDR, LENGTH);
+    SIM_CHECK(host, sizeof(HTC_RECORD_HDR) + rec_len == len,
+              "credit record of %u bytes in a %u byte trailer", rec_len, len);
+    rpt = (HTC_CREDIT_REPORT *)(trailer + sizeof(HTC_RECORD_HDR));
+    for (i = 0; i < rec_len / sizeof(*rpt); i++) {
+        host->credits_back += HTC_GET_FIELD(&rpt[i], HTC_CREDIT_REPORT,
+                                            CREDITS);
+        host->credits += HTC_GET_FIELD(&rpt[i], HTC_CREDIT_REPORT, CREDITS);
+    }
+}
+
+static void sim_handle_msg(struct sim_host *host, adf_nbuf_t nbuf)
+{
+    A_UINT8 *hdr = adf_nbuf_data(nbuf);
+    A_UINT8 *payload = hdr + HTC_HDR_LENGTH;
+    unsigned int len, trailer_len;
+    A_UINT8 ep;
+
+    ep = HTC_GET_FIELD(hdr, HTC_FRAME_HDR, ENDPOINTID);
+    len = HTC_GET_FIELD(hdr, HTC_FRAME_HDR, PAYLOADLEN);
+    SIM_CHECK(host, HTC_HDR_LENGTH + len == adf_nbuf_len(nbuf),
+              "HTC payload of %u bytes in a %u byte buffer", len,
+              adf_nbuf_len(nbuf));
+    if (host->errors)
+        return;
+
+    if (HTC_GET_FIELD(hdr, HTC_FRAME_HDR, FLAGS) & HTC_FLAGS_RECV_TRAILER) {
+        trailer_len = HTC_GET_FIELD(hdr, HTC_FRAME_HDR, CONTROLBYTES0);
+        SIM_CHECK(host, trailer_len <= len, "trailer longer than payload");
+        if (host->errors)
+            return;
+        len -= trailer_len;
+        sim_credit_trailer(host, payload + len, trailer_len);
+    }
+    if (!len)
+        return;
+
+    if (ep == ENDPOINT_0)
+        sim_htc_ctrl(host, payload, len);
+    else if (ep == host->wmi_ep)
+        sim_wmi_event(host, payload, len);
+    else if (ep == host->htt_ep)
+        sim_htt_msg(host, payload, len);
+    else
+        SIM_CHECK(host, 0, "message on unknown endpoint %d", ep);
+}
+
+static void sim_run_pass(struct sim_host *host)
+{
+    struct delayed_work *work = &host->device->target_work;
+    int i;
+
+    if (work->pending) {
+        work->pending = false;
+        work->work.func(&work->work);
+    }
+
+    for (i = 0; i < host->rx_msg_cnt; i++) {
+        if (!host->errors)
+            sim_handle_msg(host, host->rx_msgs[i]);
+        adf_nbuf_free(host->rx_msgs[i]);
+    }
+    host->rx_msg_cnt = 0;
+}
+
+/* run the target until @cond holds */
+#define SIM_RUN_UNTIL(host, cond, what) do {                          \
+        int __passes = 0;                                             \
+        while (!(host)->errors && !(cond)) {                          \
+            if (++__passes > SIM_STALL_PASSES) {                      \
+                SIM_CHECK(host, 0, "stalled waiting for %s", what);   \
+                break;                                                \
+            }                                                         \
+            sim_run_pass(host);                                       \
+        }                                                             \
+    } while (0)
+
+static void sim_bmi(struct sim_host *host)
+{
+    A_UINT32 cmd[4], rsp[2], len;
+    struct bmi_target_info info;
+    A_UINT32 value;
+
+    cmd[0] = BMI_GET_TARGET_INFO;
+    len = sizeof(info);
+    HIFExchangeBMIMsg(host->hif, (A_UINT8 *)cmd, sizeof(cmd[0]),
+                      (A_UINT8 *)&info, &len, 0);
+    SIM_CHECK(host, info.target_type == TARGET_TYPE_AR6320 &&
+              info.target_ver == AR6320_REV2_1_VERSION, "target info");
+
+    /* a word sized write is kept, an image chunk is dropped */
+    cmd[0] = BMI_WRITE_MEMORY;
+    cmd[1] = 0x400800;
+    cmd[2] = 4;
+    cmd[3] = 0x1234;
+    HIFExchangeBMIMsg(host->hif, (A_UINT8 *)cmd, sizeof(cmd), NULL, NULL, 0);
+    cmd[1] = 0x400804;
+    HIFExchangeBMIMsg(host->hif, (A_UINT8 *)cmd, sizeof(cmd) - 1, NULL,
+                      NULL, 0);
+    cmd[0] = BMI_READ_MEMORY;
+    cmd[1] = 0x400800;
+    cmd[2] = len = sizeof(rsp);
+    HIFExchangeBMIMsg(host->hif, (A_UINT8 *)cmd, 3 * sizeof(cmd[0]),
+                      (A_UINT8 *)rsp, &len, 0);
+    SIM_CHECK(host, rsp[0] == 0x1234 && rsp[1] == 0, "BMI memory %x %x",
+              rsp[0], rsp[1]);
+
+    cmd[0] = BMI_WRITE_SOC_REGISTER;
+    cmd[1] = 0x80000;
+    cmd[2] = 0x5678;
+    HIFExchangeBMIMsg(host->hif, (A_UINT8 *)cmd, 3 * sizeof(cmd[0]), NULL,
+                      NULL, 0);
+    cmd[0] = BMI_READ_SOC_REGISTER;
+    len = sizeof(rsp[0]);
+    HIFExchangeBMIMsg(host->hif, (A_UINT8 *)cmd, 2 * sizeof(cmd[0]),
+                      (A_UINT8 *)rsp, &len, 0);
+    HIFDiagReadAccess(host->hif, 0x400800, &value);
+    SIM_CHECK(host, rsp[0] == 0x5678 && value == 0x1234,
+              "BMI register %x, diag %x", rsp[0], value);
+}
+
+static void sim_htc_setup(struct sim_host *host)
+{
+    A_UINT32 msg[3];
+
+    SIM_RUN_UNTIL(host, host->htc_ready, "HTC ready");
+
+    memset(msg, 0, sizeof(msg));
+    HTC_SET_FIELD(msg, HTC_CONNECT_SERVICE_MSG, MESSAGEID,
+                  HTC_MSG_CONNECT_SERVICE_ID);
+    HTC_SET_FIELD(msg, HTC_CONNECT_SERVICE_MSG, SERVICE_ID, WMI_CONTROL_SVC);
+    sim_send(host, ENDPOINT_0, msg, sizeof(HTC_CONNECT_SERVICE_MSG));
+    HTC_SET_FIELD(msg, HTC_CONNECT_SERVICE_MSG, SERVICE_ID,
+                  HTT_DATA_MSG_SVC);
+    sim_send(host, ENDPOINT_0, msg, sizeof(HTC_CONNECT_SERVICE_MSG));
+    SIM_RUN_UNTIL(host, host->wmi_ep && host->htt_ep, "service connects");
+
+    memset(msg, 0, sizeof(msg));
+    HTC_SET_FIELD(msg, HTC_SETUP_COMPLETE_EX_MSG, MESSAGEID,
+                  HTC_MSG_SETUP_COMPLETE_EX_ID);
+    sim_send(host, ENDPOINT_0, msg, sizeof(HTC_SETUP_COMPLETE_EX_MSG));
+}
+
+static void sim_htt_setup(struct sim_host *host)
+{
+    A_UINT32 msg[HTT_RX_RING_CFG_BYTES(1) / sizeof(A_UINT32)];
+    A_UINT32 *msg_word = msg;
+    A_UINT8 *bufs;
+    unsigned int i;
+
+    memset(msg, 0, sizeof(msg));
+    HTT_H2T_MSG_TYPE_SET(msg[0], HTT_H2T_MSG_TYPE_VERSION_REQ);
+    sim_send(host, host->htt_ep, msg, sizeof(A_UINT32));
+    SIM_RUN_UNTIL(host, host->version_conf, "HTT version");
+
+    host->ring = sim_dma_alloc(host->ring_size * sizeof(A_UINT32),
+                               &host->ring_paddr);
+    host->alloc_idx = sim_dma_alloc(sizeof(A_UINT32),
+                                    &host->alloc_idx_paddr);
+    bufs = sim_dma_alloc(host->ring_size * SIM_RX_BUF_SIZE,
+                         &host->bufs_paddr);
+    host->popped = calloc(host->ring_size, sizeof(A_UINT32));
+    if (!host->ring || !host->alloc_idx || !bufs || !host->popped) {
+        SIM_CHECK(host, 0, "rx ring of %u does not fit", host->ring_size);
+        return;
+    }
+    for (i = 0; i < host->ring_size - 1; i++)
+        host->ring[i] = host->bufs_paddr + i * SIM_RX_BUF_SIZE;
+    *host->alloc_idx = host->ring_size - 1;
+    host->sw_rd_idx = 0;
+
+    HTT_H2T_MSG_TYPE_SET(*msg_word, HTT_H2T_MSG_TYPE_RX_RING_CFG);
+    HTT_RX_RING_CFG_NUM_RINGS_SET(*msg_word, 1);
+    msg_word++;
+    HTT_RX_RING_CFG_IDX_SHADOW_REG_PADDR_SET(*msg_word,
+                                             host->alloc_idx_paddr);
+    msg_word++;
+    HTT_RX_RING_CFG_BASE_PADDR_SET(*msg_word, host->ring_paddr);
+    msg_word++;
+    HTT_RX_RING_CFG_LEN_SET(*msg_word, host->ring_size);
+    HTT_RX_RING_CFG_BUF_SZ_SET(*msg_word, SIM_RX_BUF_SIZE);
+    msg_word++;
+    HTT_RX_RING_CFG_ENABLED_MSDU_PAYLD_SET(*msg_word, 1);
+    msg_word++;
+    HTT_RX_RING_CFG_OFFSET_802_11_HDR_SET(*msg_word,
+            offsetof(struct sim_rx_desc, rx_hdr_status) >> 2);
+    HTT_RX_RING_CFG_OFFSET_MSDU_PAYLD_SET(*msg_word,
+            sizeof(struct sim_rx_desc) >> 2);
+    msg_word++;
+    HTT_RX_RING_CFG_OFFSET_PPDU_START_SET(*msg_word,
+            offsetof(struct sim_rx_desc, ppdu_start) >> 2);
+    HTT_RX_RING_CFG_OFFSET_PPDU_END_SET(*msg_word,
+            offsetof(struct sim_rx_desc, ppdu_end) >> 2);
+    msg_word++;
+    HTT_RX_RING_CFG_OFFSET_MPDU_START_SET(*msg_word,
+            offsetof(struct sim_rx_desc, mpdu_start) >> 2);
+    HTT_RX_RING_CFG_OFFSET_MPDU_END_SET(*msg_word,
+            offsetof(struct sim_rx_desc, mpdu_end) >> 2);
+    msg_word++;
+    HTT_RX_RING_CFG_OFFSET_MSDU_START_SET(*msg_word,
+            offsetof(struct sim_rx_desc, msdu_start) >> 2);
+    HTT_RX_RING_CFG_OFFSET_MSDU_END_SET(*msg_word,
+            offsetof(struct sim_rx_desc, msdu_end) >> 2);
+    msg_word++;
+    HTT_RX_RING_CFG_OFFSET_RX_ATTN_SET(*msg_word,
+            offsetof(struct sim_rx_desc, attention) >> 2);
+    HTT_RX_RING_CFG_OFFSET_FRAG_INFO_SET(*msg_word,
+            offsetof(struct sim_rx_desc, frag_info) >> 2);
+    sim_send(host, host->htt_ep, msg, sizeof(msg));
+}
+
+static void sim_peer(struct sim_host *host, bool create)
+{
+    wmi_peer_create_cmd_fixed_param cmd;
+
+    memset(&cmd, 0, sizeof(cmd));
+    WMI_CHAR_ARRAY_TO_MAC_ADDR(host->peer_mac, &cmd.peer_macaddr);
+    if (create) {
+        WMITLV_SET_HDR(&cmd.tlv_header,
+                       WMITLV_TAG_STRUC_wmi_peer_create_cmd_fixed_param,
+                       WMITLV_GET_STRUCT_TLVLEN(
+                           wmi_peer_create_cmd_fixed_param));
+        sim_wmi_send(host, WMI_PEER_CREATE_CMDID, &cmd, sizeof(cmd));
+        SIM_RUN_UNTIL(host, host->peer_mapped, "peer map");
+    } else {
+        WMITLV_SET_HDR(&cmd.tlv_header,
+                       WMITLV_TAG_STRUC_wmi_peer_delete_cmd_fixed_param,
+                       WMITLV_GET_STRUCT_TLVLEN(
+                           wmi_peer_delete_cmd_fixed_param));
+        sim_wmi_send(host, WMI_PEER_DELETE_CMDID, &cmd,
+                     sizeof(wmi_peer_delete_cmd_fixed_param));
+        SIM_RUN_UNTIL(host, !host->peer_mapped, "peer unmap");
+    }
+}
+
+static void sim_tx(struct sim_host *host)
+{
+    A_UINT32 desc[SIM_TX_DESC_BYTES / sizeof(A_UINT32)];
+    unsigned int need = hif_sim_credits_for(HTC_HDR_LENGTH + sizeof(desc));
+    struct timespec start;
+    int batch, stall = 0;
+    unsigned long done;
+    A_UINT16 id;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    while (!host->errors && host->tx_done < SIM_TX_MSDUS) {
+        /* a burst as ol_tx_ll would send it, bounded by ids and credits */
+        batch = 1 + rnd() % 64;
+        while (batch-- && host->free_cnt && host->credits >= need &&
+               host->tx_sent < SIM_TX_MSDUS) {
+            id = host->free_ids[--host->free_cnt];
+            host->msdu_inflight[id] = true;
+            memset(desc, 0, sizeof(desc));
+            HTT_H2T_MSG_TYPE_SET(desc[0], HTT_H2T_MSG_TYPE_TX_FRM);
+            HTT_TX_DESC_FRM_ID_SET(desc[HTT_TX_DESC_FRM_ID_OFFSET_DWORD], id);
+            host->credits -= need;
+            sim_send(host, host->htt_ep, desc, sizeof(desc));
+            host->tx_sent++;
+        }
+        done = host->tx_done;
+        sim_run_pass(host);
+        stall = host->tx_done == done ? stall + 1 : 0;
+        SIM_CHECK(host, stall < SIM_STALL_PASSES,
+                  "tx stalled with %lu of %lu done", host->tx_done,
+                  host->tx_sent);
+    }
+    timespec_add_since(&tx_time, &start);
+    tx_total += host->tx_done;
+
+    /* wait for the credits of the last frames */
+    SIM_RUN_UNTIL(host, host->credits_back == host->credits_spent,
+                  "credits");
+}
+
+static void sim_rx_refill(struct sim_host *host)
+{
+    unsigned int mask = host->ring_size - 1;
+    unsigned int n, idx;
+
+    /* return a random part of the popped buffers, sometimes none */
+    n = rnd() % (host->popped_cnt + 1);
+    while (n--) {
+        idx = *host->alloc_idx;
+        host->ring[idx] = host->popped[0];
+        memmove(host->popped, host->popped + 1,
+                --host->popped_cnt * sizeof(A_UINT32));
+        *host->alloc_idx = (idx + 1) & mask;
+    }
+}
+
+static void sim_rx(struct sim_host *host)
+{
+    struct timespec start;
+    unsigned long msdus;
+    int stall = 0;
+
+    host->rx_len = clamp_t(unsigned int, host->rx_len, HIF_SIM_RX_MIN_LEN,
+                           min_t(unsigned int, ETH_FRAME_LEN,
+                                 SIM_RX_BUF_SIZE - sizeof(struct sim_rx_desc)));
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    while (!host->errors && host->rx_msdus < SIM_RX_MSDUS) {
+        msdus = host->rx_msdus;
+        sim_run_pass(host);
+        sim_rx_refill(host);
+        stall = host->rx_msdus == msdus ? stall + 1 : 0;
+        SIM_CHECK(host, stall < SIM_STALL_PASSES,
+                  "rx stalled after %lu msdus", host->rx_msdus);
+    }
+    timespec_add_since(&rx_time, &start);
+    rx_total += host->rx_msdus;
+}
+
+static int sim_run(uint32_t seed)
+{
+    wmi_pdev_set_param_cmd_fixed_param param;
+    MSG_BASED_HIF_CALLBACKS cb;
+    struct sim_host *host;
+    int i, errors;
+
+    host = calloc(1, sizeof(*host));
+    rnd_state = seed ? seed : 1;
+    sim_dma_used = 0;
+
+    hif_sim_credits = 4 + rnd() % 61;
+    hif_sim_queue_depth = 1 + rnd() % 128;
+    hif_sim_htt_rx_len = 0;
+    host->ring_size = 16 << (rnd() % 6);
+    host->rx_len = HIF_SIM_RX_MIN_LEN + rnd() % 1600;
+    for (i = 0; i < ETH_ALEN; i++)
+        host->peer_mac[i] = rnd();
+    host->peer_mac[0] &= ~0x1;
+    for (i = 0; i < SIM_MSDU_IDS; i++)
+        host->free_ids[host->free_cnt++] = i;
+
+    host->hif = hif_sim_device_create(&host->sc);
+    host->device = (HIF_DEVICE_SIM *)host->hif;
+    memset(&cb, 0, sizeof(cb));
+    cb.Context = host;
+    cb.txCompletionHandler = sim_htc_tx_done;
+    cb.rxCompletionHandler = sim_htc_rx;
+    HIFPostInit(host->hif, NULL, &cb);
+
+    sim_bmi(host);
+    HIFStart(host->hif);
+    sim_htc_setup(host);
+    SIM_RUN_UNTIL(host, host->wmi_ready, "WMI ready");
+    sim_htt_setup(host);
+    sim_peer(host, true);
+
+    if (!host->errors)
+        sim_tx(host);
+
+    /* rx starts with the next message the target gets */
+    hif_sim_htt_rx_len = host->rx_len;
+    if (!host->errors) {
+        memset(&param, 0, sizeof(param));
+        WMITLV_SET_HDR(&param.tlv_header,
+                       WMITLV_TAG_STRUC_wmi_pdev_set_param_cmd_fixed_param,
+                       WMITLV_GET_STRUCT_TLVLEN(
+                           wmi_pdev_set_param_cmd_fixed_param));
+        sim_wmi_send(host, WMI_PDEV_SET_PARAM_CMDID, &param, sizeof(param));
+        sim_rx(host);
+    }
+
+    if (!host->errors) {
+        sim_peer(host, false);
+        /* a few more passes must not indicate anything */
+        for (i = 0; i < 16; i++)
+            sim_run_pass(host);
+        SIM_CHECK(host, !host->device->target_work.pending,
+                  "target still busy without a peer");
+    }
+
+    if (sim_verbose) {
+        char buf[HIF_SIM_STATS_BUF_LEN];
+
+        hif_sim_stats_print(host->device, buf, sizeof(buf));
+        fprintf(stderr, "seed %u: credits %u depth %u ring %u len %u\n%s",
+                seed, hif_sim_credits, hif_sim_queue_depth, host->ring_size,
+                host->rx_len, buf);
+    }
+
+    HIFStop(host->hif);
+    sim_run_pass(host);
+    hif_sim_device_destroy(host->hif);
+    SIM_CHECK(host, sim_nbuf_outstanding == 0, "%lu buffers leaked",
+              sim_nbuf_outstanding);
+
+    printf("seed %u: tx %lu rx %lu credits %lu/%lu errors %d\n", seed,
+           host->tx_done, host->rx_msdus, host->credits_back,
+           host->credits_spent, host->errors);
+    errors = host->errors;
+    free(host->popped);
+    free(host);
+    return errors;
+}
+
+static double msdus_per_sec(unsigned long msdus, const struct timespec *t)
+{
+    double sec = t->tv_sec + t->tv_nsec / 1e9;
+
+    return sec > 0 ? msdus / sec : 0;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t seed;
+    int runs, r, errors = 0;
+
+    if (argc > 1 && !strcmp(argv[1], "-v")) {
+        sim_verbose = 1;
+        argc--;
+        argv++;
+    }
+    if (argc != 4 || strcmp(argv[1], "-r")) {
+        fprintf(stderr, "usage: hif_sim_bench [-v] -r <seed> <runs>\n");
+        return 2;
+    }
+    seed = strtoul(argv[2], NULL, 0);
+    runs = atoi(argv[3]);
+
+    sim_dma_arena = malloc(SIM_DMA_ARENA_SIZE);
+    if (!sim_dma_arena)
+        return 2;
+
+    for (r = 0; r < runs; r++)
+        errors += sim_run(seed + r) ? 1 : 0;
+
+    printf("%d runs, %d failed\n", runs, errors);
+    fprintf(stderr, "hif_sim_bench: tx %.0f msdus/s, rx %.0f msdus/s\n",
+            msdus_per_sec(tx_total, &tx_time),
+            msdus_per_sec(rx_total, &rx_time));
+    free(sim_dma_arena);
+    return errors ? 1 : 0;
+}
@@ -0,0 +1,31 @@
+#!/bin/sh
+#
+# Build the emulated target benchmark harness against hif_sim.c and
+# wmi_tlv_helper.c from the working tree, bring the target up over BMI,
+# HTC, WMI and HTT once per run and fail if the target breaks any of the
+# checks the harness makes as host.
+#
+# usage: hif_sim_bench.sh [<seed> [<runs>]]
+
+set -e
+
+HERE=$(cd "$(dirname "$0")" && pwd)
+SIM=$HERE/../..
+CORE=$SIM/../../..
+CC=${CC:-cc}
+# the HTC and WMI field accessors pun buffers, as in the kernel build
+CFLAGS="-O2 -Wall -fno-strict-aliasing"
+INC="-I$HERE/stubs -I$SIM -I$CORE/SERVICES/COMMON -I$CORE/CLD_TXRX/HTT
+     -I$CORE/EPPING/inc"
+
+OUT=$(mktemp -d)
+trap 'rm -rf "$OUT"' EXIT
+
+# wmi_tlv_helper.c includes wmi_tlv_platform.c relative to its own
+# directory, so build from copies of both.
+cp "$CORE/SERVICES/WMI/wmi_tlv_helper.c" \
+   "$CORE/SERVICES/WMI/wmi_tlv_platform.c" "$OUT/"
+
+$CC $CFLAGS $INC -o "$OUT/hif_sim_bench" \
+    "$OUT/wmi_tlv_helper.c" "$HERE/hif_sim_bench.c"
+"$OUT/hif_sim_bench" -r ${1:-1} ${2:-20}
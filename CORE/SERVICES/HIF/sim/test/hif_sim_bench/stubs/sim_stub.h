@@ -0,0 +1,308 @@
+/*
+ * Copyright (c) 2016 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/*
+ * Userspace stand-ins for the kernel, ADF, VOS and driver declarations
+ * that hif_sim.c and wmi_tlv_helper.c use. Every kernel and driver header
+ * they include that cannot be built outside the kernel resolves to this
+ * file when building the emulated target benchmark harness; the HTC, BMI,
+ * WMI, HTT and endpoint ping protocol headers are the real ones.
+ *
+ * The harness is single threaded: the target work item only runs when the
+ * harness calls sim_run_work(), so the locks are no-ops and queueing work
+ * just marks it pending. Bus addresses are offsets into one arena that the
+ * harness hands out with sim_dma_alloc().
+ */
+#ifndef __SIM_STUB_H
+#define __SIM_STUB_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <errno.h>
+#include <time.h>
+#include <sys/types.h>
+#include "a_types.h"
+#include "a_osapi.h"
+
+typedef uint8_t u8;
+typedef uint16_t u16;
+typedef uint32_t u32;
+typedef unsigned long long u64;
+typedef long long s64;
+typedef uint8_t u_int8_t;
+typedef uint16_t u_int16_t;
+typedef uint32_t u_int32_t;
+typedef uint8_t a_uint8_t;
+typedef uint16_t a_uint16_t;
+typedef uint32_t a_uint32_t;
+typedef int atomic_t;
+
+#ifndef TRUE
+#define TRUE  1
+#define FALSE 0
+#endif
+#ifndef EOK
+#define EOK 0
+#endif
+
+#define __user
+#define __iomem
+#define likely(x)   __builtin_expect(!!(x), 1)
+#define unlikely(x) __builtin_expect(!!(x), 0)
+
+#define LINUX_VERSION_CODE KERNEL_VERSION(4, 4, 0)
+#define KERNEL_VERSION(a, b, c) (((a) << 16) + ((b) << 8) + (c))
+
+#ifndef container_of
+#define container_of(ptr, type, member) \
+    ((type *)((char *)(ptr) - offsetof(type, member)))
+#endif
+#define ARRAY_SIZE(a) (sizeof(a) / sizeof((a)[0]))
+#define roundup(x, y) ((((x) + ((y) - 1)) / (y)) * (y))
+#define min_t(type, a, b) ((type)(a) < (type)(b) ? (type)(a) : (type)(b))
+#define max_t(type, a, b) ((type)(a) > (type)(b) ? (type)(a) : (type)(b))
+#define clamp_t(type, v, lo, hi) min_t(type, max_t(type, v, lo), hi)
+#define div_s64(a, b)   ((s64)(a) / (s64)(b))
+#define div64_u64(a, b) ((u64)(a) / (u64)(b))
+#define ACCESS_ONCE(x) (*(volatile __typeof__(x) *)&(x))
+#define smp_rmb() __atomic_thread_fence(__ATOMIC_ACQUIRE)
+
+#define pr_info(...) printf(__VA_ARGS__)
+#define A_ASSERT(expr) do {                                           \
+        if (!(expr)) {                                                \
+            fprintf(stderr, "assert %s:%d\n", __FILE__, __LINE__);    \
+            abort();                                                  \
+        }                                                             \
+    } while (0)
+
+static inline int scnprintf(char *buf, size_t size, const char *fmt, ...)
+    __attribute__((format(printf, 3, 4)));
+static inline int scnprintf(char *buf, size_t size, const char *fmt, ...)
+{
+    va_list ap;
+    int n;
+
+    if (!size)
+        return 0;
+    va_start(ap, fmt);
+    n = vsnprintf(buf, size, fmt, ap);
+    va_end(ap);
+    return n < (int)size ? n : (int)size - 1;
+}
+
+/* module parameters and debugfs */
+#define module_param(name, type, perm)
+#define THIS_MODULE NULL
+#define S_IRUSR 0400
+#define S_IWUSR 0200
+
+struct file {
+    void *private_data;
+};
+struct file_operations {
+    ssize_t (*read)(struct file *, char *, size_t, loff_t *);
+    ssize_t (*write)(struct file *, const char *, size_t, loff_t *);
+    int (*open)(void *, struct file *);
+    void *owner;
+    loff_t (*llseek)(struct file *, loff_t, int);
+};
+struct dentry;
+#define simple_open NULL
+#define default_llseek NULL
+#define simple_read_from_buffer(ubuf, count, ppos, buf, len) \
+    ((ssize_t)min_t(size_t, count, len))
+static inline struct dentry *debugfs_create_file(const char *name, int mode,
+        struct dentry *parent, void *data, const struct file_operations *fops)
+{
+    return NULL;
+}
+static inline void debugfs_remove(struct dentry *dentry) { }
+
+/* memory */
+#define vmalloc(size) malloc(size)
+#define vfree(p)      free(p)
+#define adf_os_mem_alloc(osdev, size) malloc(size)
+#define adf_os_mem_free(p)            free(p)
+#define OS_MALLOC(os, n, flags) malloc(n)
+#define OS_MEMCPY memcpy
+#define OS_MEMZERO(p, n) memset(p, 0, n)
+#define OS_MEMMOVE memmove
+
+/* the arena behind the emulated bus addresses */
+extern uint8_t *sim_dma_arena;
+#define SIM_DMA_BASE 0x10000000u
+static inline void *phys_to_virt(uint32_t paddr)
+{
+    return sim_dma_arena + (paddr - SIM_DMA_BASE);
+}
+
+/* time */
+typedef s64 ktime_t;
+static inline ktime_t ktime_get(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (s64)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+#define ktime_sub(a, b)      ((a) - (b))
+#define ktime_to_ns(t)       (t)
+#define ktime_us_delta(a, b) (((a) - (b)) / 1000)
+#define usecs_to_jiffies(us) (us)
+
+/* locks, the harness runs everything on one thread */
+typedef int spinlock_t;
+typedef int adf_os_spinlock_t;
+#define spin_lock_init(l)          (*(l) = 0)
+#define spin_lock_bh(l)            ((void)(l))
+#define spin_unlock_bh(l)          ((void)(l))
+#define adf_os_spinlock_init(l)    (*(l) = 0)
+#define adf_os_spin_lock_bh(l)     ((void)(l))
+#define adf_os_spin_unlock_bh(l)   ((void)(l))
+#define local_bh_disable()         do { } while (0)
+#define local_bh_enable()          do { } while (0)
+
+/* work items run when the harness calls sim_run_work() */
+struct work_struct {
+    void (*func)(struct work_struct *work);
+};
+struct delayed_work {
+    struct work_struct work;
+    bool pending;
+    unsigned long delay_us;
+};
+struct workqueue_struct {
+    int unused;
+};
+#define INIT_DELAYED_WORK(dw, fn) \
+    do { (dw)->work.func = (fn); (dw)->pending = false; } while (0)
+#define to_delayed_work(w) container_of(w, struct delayed_work, work)
+static inline struct workqueue_struct *alloc_ordered_workqueue(
+        const char *name, int flags)
+{
+    return calloc(1, sizeof(struct workqueue_struct));
+}
+#define destroy_workqueue(wq) free(wq)
+static inline bool queue_delayed_work(struct workqueue_struct *wq,
+                                      struct delayed_work *dw,
+                                      unsigned long delay)
+{
+    if (dw->pending)
+        return false;
+    dw->pending = true;
+    dw->delay_us = delay;
+    return true;
+}
+static inline bool cancel_delayed_work_sync(struct delayed_work *dw)
+{
+    bool pending = dw->pending;
+
+    dw->pending = false;
+    return pending;
+}
+
+/* platform device, only what if_sim.h declares */
+struct device {
+    int unused;
+};
+struct platform_device {
+    struct device dev;
+};
+struct _NIC_DEV {
+    int unused;
+};
+struct ol_softc;
+struct targetdef_s;
+struct hostdef_s;
+
+/* network buffers: one linear fragment, HTC header included */
+typedef struct sim_nbuf {
+    uint8_t *head;
+    uint8_t *data;
+    unsigned int len;
+    unsigned int size;
+} *adf_nbuf_t;
+
+extern unsigned long sim_nbuf_outstanding;
+
+static inline adf_nbuf_t adf_nbuf_alloc(void *osdev, unsigned int size,
+                                        int reserve, int align, int prio)
+{
+    adf_nbuf_t nbuf = malloc(sizeof(*nbuf));
+
+    if (!nbuf)
+        return NULL;
+    nbuf->head = malloc(size + reserve);
+    if (!nbuf->head) {
+        free(nbuf);
+        return NULL;
+    }
+    nbuf->data = nbuf->head + reserve;
+    nbuf->len = 0;
+    nbuf->size = size;
+    sim_nbuf_outstanding++;
+    return nbuf;
+}
+static inline void adf_nbuf_free(adf_nbuf_t nbuf)
+{
+    sim_nbuf_outstanding--;
+    free(nbuf->head);
+    free(nbuf);
+}
+static inline uint8_t *adf_nbuf_put_tail(adf_nbuf_t nbuf, unsigned int len)
+{
+    uint8_t *tail = nbuf->data + nbuf->len;
+
+    nbuf->len += len;
+    return tail;
+}
+#define adf_nbuf_data(nbuf)               ((nbuf)->data)
+#define adf_nbuf_len(nbuf)                ((nbuf)->len)
+#define adf_nbuf_get_num_frags(nbuf)      1
+#define adf_nbuf_get_frag_len(nbuf, i)    ((nbuf)->len)
+#define adf_nbuf_get_frag_vaddr(nbuf, i)  ((nbuf)->data)
+
+/* VOS and endpoint ping mode */
+#define WLAN_EPPING_ENABLE_BIT (1 << 8)
+#define WLAN_IS_EPPING_ENABLED(x) ((x) & WLAN_EPPING_ENABLE_BIT)
+extern int sim_con_mode;
+#define vos_get_conparam() sim_con_mode
+
+/* firmware versions from ol_fw.h */
+#define AR6320_REV2_1_VERSION 0x5010000
+
+/* debug prints */
+extern int sim_verbose;
+#define ATH_DEBUG_ERR  (1 << 0)
+#define ATH_DEBUG_WARN (1 << 1)
+#define ATH_DEBUG_INFO (1 << 2)
+#define ATH_DEBUG_TRC  (1 << 3)
+#define AR_DEBUG_PRINTF(mask, args) \
+    do { if (sim_verbose > 1 || ((mask) & ATH_DEBUG_ERR)) printf args; } while (0)
+#define A_REGISTER_MODULE_DEBUG_INFO(name) do { } while (0)
+
+/* wmi_tlv_helper.c, its validation errors are shown with -v */
+#define adf_os_print(...) \
+    do { if (sim_verbose) fprintf(stderr, __VA_ARGS__); } while (0)
+
+#endif /* __SIM_STUB_H */
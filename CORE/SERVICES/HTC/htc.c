@@ -386,16 +386,17 @@ A_STATUS HTCSetupTargetBufferAssignments(HTC_TARGET *target)
          * space through the Ethernet interface.
          * For credit allocation, in SDIO bus case, only BE service is
          * used for tx/rx perf testing so that all credits are given
-         * to BE service. In PCIe and USB bus case, endpoint ping uses both
-         * BE and BK services to stress the bus so that the total credits
-         * are equally distributed to BE and BK services.
+         * to BE service. In PCIe, USB and emulated bus case, endpoint
+         * ping uses both BE and BK services to stress the bus so that
+         * the total credits are equally distributed to BE and BK
+         * services.
          */
 #if !defined(HIF_USB)
         pEntry++;
         pEntry->ServiceID = WMI_DATA_BE_SVC;
         pEntry->CreditAllocation = credits;
 #endif
- #if defined(HIF_PCI) || defined(HIF_USB)
+ #if defined(HIF_PCI) || defined(HIF_USB) || defined(HIF_SIM)
         pEntry->ServiceID = WMI_DATA_BE_SVC;
         pEntry->CreditAllocation = (credits >> 1);
 
@@ -986,6 +987,11 @@ void HTCDumpBundleStats(HTC_HANDLE HTCHandle)
                 ("%10d:%10d(%2d%s)\n",(i+1), target->rx_bundle_stats[i],
                 ((target->rx_bundle_stats[i]*100)/total), "%"));
         }
+        AR_DEBUG_PRINTF(ATH_DEBUG_ANY,
+            ("Scatter reads: %u bounce reads: %u bytes not copied: %u "
+             "budget yields: %u\n", target->rx_bundle_scatter,
+             target->rx_bundle_bounce, target->rx_bundle_bytes_not_copied,
+             target->rx_bundle_budget_yields));
     }
 
 
@@ -1005,6 +1011,9 @@ void HTCDumpBundleStats(HTC_HANDLE HTCHandle)
                 ((target->tx_bundle_stats[i]*100)/total), "%"));
         }
     }
+#if defined(HIF_USB) || defined(HIF_SDIO)
+    HIFDumpInfo(target->hif_dev);
+#endif
 }
 
 void HTCClearBundleStats (HTC_HANDLE HTCHandle)
@@ -1013,6 +1022,10 @@ void HTCClearBundleStats (HTC_HANDLE HTCHandle)
 
     adf_os_mem_zero(&target->rx_bundle_stats, sizeof(target->rx_bundle_stats));
     adf_os_mem_zero(&target->tx_bundle_stats, sizeof(target->tx_bundle_stats));
+    target->rx_bundle_scatter = 0;
+    target->rx_bundle_bounce = 0;
+    target->rx_bundle_bytes_not_copied = 0;
+    target->rx_bundle_budget_yields = 0;
 }
 #endif
 
@@ -206,6 +206,10 @@ typedef struct _HTC_TARGET {
 #if defined(DEBUG_HL_LOGGING) && defined(CONFIG_HL_SUPPORT)
     A_UINT32                    rx_bundle_stats[HTC_MAX_MSG_PER_BUNDLE_RX];
     A_UINT32                    tx_bundle_stats[HTC_MAX_MSG_PER_BUNDLE_TX];
+    A_UINT32                    rx_bundle_scatter;
+    A_UINT32                    rx_bundle_bounce;
+    A_UINT32                    rx_bundle_bytes_not_copied;
+    A_UINT32                    rx_bundle_budget_yields;
 #endif
     /*
     * This flag is from the mboxping tool. It indicates that we cannot drop it.
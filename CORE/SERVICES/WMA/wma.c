@@ -74,6 +74,7 @@
 
 #include "adf_nbuf.h"
 #include "adf_os_types.h"
+#include "adf_os_time.h"
 #include "ol_txrx_api.h"
 #include "vos_memory.h"
 #include "ol_txrx_types.h"
@@ -330,6 +331,9 @@ static struct index_vht_data_rate_type vht_mcs_nss2[] =
 
 void wma_send_msg(tp_wma_handle wma_handle, u_int16_t msg_type,
 				void *body_ptr, u_int32_t body_val);
+static void wma_send_msg_by_priority(tp_wma_handle wma_handle,
+		u_int16_t msg_type, void *body_ptr, u_int32_t body_val,
+		int is_high_priority);
 
 #ifdef QCA_IBSS_SUPPORT
 static void wma_data_tx_ack_comp_hdlr(void *wma_context,
@@ -421,6 +425,7 @@ static VOS_STATUS wma_stop_scan(tp_wma_handle wma_handle,
 		tAbortScanParams *abort_scan_req);
 
 static void wma_set_sap_keepalive(tp_wma_handle wma, u_int8_t vdev_id);
+static void wma_stats_snapshot_del_peer(tp_wma_handle wma, uint8_t *macaddr);
 static int wma_smps_force_mode_callback(WMA_HANDLE handle, uint8_t *event_buf,
 				uint32_t len);
 
@@ -1694,6 +1699,7 @@ void wma_remove_peer(tp_wma_handle wma, u_int8_t *bssid,
 	wmi_unified_peer_delete_send(wma->wmi_handle, peer_addr, vdev_id);
 
 peer_detach:
+	wma_stats_snapshot_del_peer(wma, peer_addr);
 	if (peer)
 		ol_txrx_peer_detach(peer);
 	wma->interfaces[vdev_id].peer_count--;
@@ -3329,6 +3335,351 @@ static void wma_handle_sta_rssi(uint32_t num_peer_stats,
 
 
 
+/**
+ * wma_stats_snapshot_init() - set up the vdev/peer stats snapshot area
+ * @wma: wma handle
+ *
+ * Return: VOS_STATUS_SUCCESS or VOS_STATUS_E_NOMEM
+ */
+static VOS_STATUS wma_stats_snapshot_init(tp_wma_handle wma)
+{
+	int i;
+
+	wma->vdev_stats_snapshot = vos_mem_malloc(
+			sizeof(*wma->vdev_stats_snapshot) * wma->max_bssid);
+	if (!wma->vdev_stats_snapshot) {
+		WMA_LOGE("%s: failed to allocate vdev stats snapshot",
+			 __func__);
+		return VOS_STATUS_E_NOMEM;
+	}
+	vos_mem_zero(wma->vdev_stats_snapshot,
+		     sizeof(*wma->vdev_stats_snapshot) * wma->max_bssid);
+	for (i = 0; i < wma->max_bssid; i++)
+		seqlock_init(&wma->vdev_stats_snapshot[i].lock);
+
+	wma->num_peer_stats_snapshot = wma->wlan_resource_config.num_peers;
+	wma->peer_stats_snapshot_drops = 0;
+	if (!wma->num_peer_stats_snapshot)
+		return VOS_STATUS_SUCCESS;
+	wma->peer_stats_snapshot = vos_mem_malloc(
+			sizeof(*wma->peer_stats_snapshot) *
+			wma->num_peer_stats_snapshot);
+	if (!wma->peer_stats_snapshot) {
+		WMA_LOGE("%s: failed to allocate peer stats snapshot",
+			 __func__);
+		vos_mem_free(wma->vdev_stats_snapshot);
+		wma->vdev_stats_snapshot = NULL;
+		return VOS_STATUS_E_NOMEM;
+	}
+	vos_mem_zero(wma->peer_stats_snapshot,
+		     sizeof(*wma->peer_stats_snapshot) *
+		     wma->num_peer_stats_snapshot);
+	for (i = 0; i < wma->num_peer_stats_snapshot; i++)
+		seqlock_init(&wma->peer_stats_snapshot[i].lock);
+
+	return VOS_STATUS_SUCCESS;
+}
+
+/**
+ * wma_stats_snapshot_deinit() - free the vdev/peer stats snapshot area
+ * @wma: wma handle
+ *
+ * Return: none
+ */
+static void wma_stats_snapshot_deinit(tp_wma_handle wma)
+{
+	vos_mem_free(wma->vdev_stats_snapshot);
+	wma->vdev_stats_snapshot = NULL;
+	vos_mem_free(wma->peer_stats_snapshot);
+	wma->peer_stats_snapshot = NULL;
+	wma->num_peer_stats_snapshot = 0;
+}
+
+/**
+ * wma_stats_snapshot_find_peer() - look up the snapshot entry of a peer
+ * @wma: wma handle
+ * @macaddr: peer mac address
+ * @alloc: claim a free entry if the peer is not tracked yet
+ *
+ * Entries are only claimed from the MC thread and removal only clears
+ * ->valid under the entry seqlock, so the table is scanned without a lock.
+ * A peer that finds the table full is counted in peer_stats_snapshot_drops.
+ *
+ * Return: snapshot entry or NULL
+ */
+static struct wma_peer_stats_snapshot *
+wma_stats_snapshot_find_peer(tp_wma_handle wma, uint8_t *macaddr, bool alloc)
+{
+	struct wma_peer_stats_snapshot *entry, *free_entry = NULL;
+	int i;
+
+	for (i = 0; i < wma->num_peer_stats_snapshot; i++) {
+		entry = &wma->peer_stats_snapshot[i];
+		if (!entry->valid) {
+			if (!free_entry)
+				free_entry = entry;
+			continue;
+		}
+		if (vos_mem_compare(entry->macaddr, macaddr, ETH_ALEN))
+			return entry;
+	}
+
+	if (!alloc)
+		return NULL;
+	if (!free_entry) {
+		wma->peer_stats_snapshot_drops++;
+		return NULL;
+	}
+
+	write_seqlock_bh(&free_entry->lock);
+	vos_mem_copy(free_entry->macaddr, macaddr, ETH_ALEN);
+	free_entry->version = 0;
+	free_entry->valid = true;
+	write_sequnlock_bh(&free_entry->lock);
+
+	return free_entry;
+}
+
+/**
+ * wma_stats_snapshot_del_peer() - drop a peer from the stats snapshot
+ * @wma: wma handle
+ * @macaddr: peer mac address
+ *
+ * Return: none
+ */
+static void wma_stats_snapshot_del_peer(tp_wma_handle wma, uint8_t *macaddr)
+{
+	struct wma_peer_stats_snapshot *entry;
+
+	entry = wma_stats_snapshot_find_peer(wma, macaddr, false);
+	if (!entry)
+		return;
+
+	write_seqlock_bh(&entry->lock);
+	entry->valid = false;
+	write_sequnlock_bh(&entry->lock);
+}
+
+/**
+ * wma_stats_snapshot_update_vdev() - record vdev stats in the snapshot
+ * @wma: wma handle
+ * @vdev_stats: vdev stats from the firmware stats event
+ *
+ * Return: none
+ */
+static void wma_stats_snapshot_update_vdev(tp_wma_handle wma,
+					   wmi_vdev_stats *vdev_stats)
+{
+	struct wma_vdev_stats_snapshot *snap;
+
+	if (!wma->vdev_stats_snapshot ||
+	    vdev_stats->vdev_id >= wma->max_bssid)
+		return;
+
+	snap = &wma->vdev_stats_snapshot[vdev_stats->vdev_id];
+	write_seqlock_bh(&snap->lock);
+	vos_mem_copy(&snap->stats, vdev_stats, sizeof(snap->stats));
+	snap->update_us = adf_os_get_monotonic_us();
+	snap->version++;
+	write_sequnlock_bh(&snap->lock);
+}
+
+/**
+ * wma_stats_snapshot_update_peer() - record peer stats in the snapshot
+ * @wma: wma handle
+ * @peer_stats: peer stats from the firmware stats event
+ *
+ * The host datapath counters of the peer are copied on the same update,
+ * so readers of the snapshot never need to take the txrx pdev lock.
+ *
+ * Return: none
+ */
+static void wma_stats_snapshot_update_peer(tp_wma_handle wma,
+					   wmi_peer_stats *peer_stats)
+{
+	struct wma_peer_stats_snapshot *snap;
+	ol_txrx_pdev_handle pdev;
+	ol_txrx_peer_handle peer = NULL;
+	uint8_t macaddr[ETH_ALEN], peer_id, vdev_id;
+#ifdef QCA_ENABLE_OL_TXRX_PEER_STATS
+	ol_txrx_peer_stats_t txrx;
+	bool txrx_valid = false;
+#endif
+
+	WMI_MAC_ADDR_TO_CHAR_ARRAY(&peer_stats->peer_macaddr, macaddr);
+	pdev = vos_get_context(VOS_MODULE_ID_TXRX, wma->vos_context);
+	if (pdev)
+		peer = ol_txrx_find_peer_by_addr(pdev, macaddr, &peer_id);
+	if (peer)
+		vdev_id = peer->vdev->vdev_id;
+	else if (!wma_find_vdev_by_bssid(wma, macaddr, &vdev_id))
+		return;
+
+#ifdef QCA_ENABLE_OL_TXRX_PEER_STATS
+	if (peer && ol_txrx_peer_stats_copy(pdev, peer, &txrx) == A_OK)
+		txrx_valid = true;
+#endif
+
+	snap = wma_stats_snapshot_find_peer(wma, macaddr, true);
+	if (!snap) {
+		WMA_LOGD("%s: no free stats snapshot entry for %pM",
+			 __func__, macaddr);
+		return;
+	}
+
+	write_seqlock_bh(&snap->lock);
+	snap->vdev_id = vdev_id;
+	snap->rssi = peer_stats->peer_rssi;
+	snap->tx_rate = peer_stats->peer_tx_rate;
+	snap->rx_rate = peer_stats->peer_rx_rate;
+#ifdef QCA_ENABLE_OL_TXRX_PEER_STATS
+	if (txrx_valid)
+		snap->txrx = txrx;
+#endif
+	snap->update_us = adf_os_get_monotonic_us();
+	snap->version++;
+	write_sequnlock_bh(&snap->lock);
+}
+
+/**
+ * wma_stats_snapshot_update_chain_rssi() - record per chain rssi
+ * @wma: wma handle
+ * @rssi_stats: per chain rssi stats from the firmware stats event
+ *
+ * Return: none
+ */
+static void wma_stats_snapshot_update_chain_rssi(tp_wma_handle wma,
+						 wmi_rssi_stats *rssi_stats)
+{
+	struct wma_peer_stats_snapshot *snap;
+	uint8_t macaddr[ETH_ALEN];
+
+	if (rssi_stats->vdev_id >= wma->max_bssid)
+		return;
+
+	WMI_MAC_ADDR_TO_CHAR_ARRAY(&rssi_stats->peer_macaddr, macaddr);
+	snap = wma_stats_snapshot_find_peer(wma, macaddr, true);
+	if (!snap)
+		return;
+
+	write_seqlock_bh(&snap->lock);
+	snap->vdev_id = rssi_stats->vdev_id;
+	vos_mem_copy(snap->rssi_avg_beacon, rssi_stats->rssi_avg_beacon,
+		     sizeof(snap->rssi_avg_beacon));
+	vos_mem_copy(snap->rssi_avg_data, rssi_stats->rssi_avg_data,
+		     sizeof(snap->rssi_avg_data));
+	snap->update_us = adf_os_get_monotonic_us();
+	snap->version++;
+	write_sequnlock_bh(&snap->lock);
+}
+
+/**
+ * wma_stats_snapshot_dump() - print the vdev/peer stats snapshot
+ * @buf: output buffer
+ * @len: size of @buf
+ *
+ * Readers never block the writers: every entry is copied out under its
+ * seqlock and the copy is retried if an update raced with it.
+ *
+ * Return: number of bytes written to @buf
+ */
+int wma_stats_snapshot_dump(char *buf, int len)
+{
+	void *vos_context = vos_get_global_context(VOS_MODULE_ID_WDA, NULL);
+	tp_wma_handle wma_handle = (tp_wma_handle) vos_get_context(
+					VOS_MODULE_ID_WDA, vos_context);
+	struct wma_vdev_stats_snapshot *vsnap;
+	struct wma_peer_stats_snapshot *psnap, peer;
+	wmi_vdev_stats vdev;
+	uint32_t version;
+	uint64_t update_us, now_us;
+	unsigned int seq;
+	int i, ret = 0;
+
+	if (NULL == wma_handle || NULL == wma_handle->vdev_stats_snapshot) {
+		WMA_LOGE("%s: wma_handle is NULL", __func__);
+		return 0;
+	}
+
+	now_us = adf_os_get_monotonic_us();
+	ret += scnprintf(buf + ret, len - ret, "push_period_ms %u\n",
+			 wma_handle->fw_stats_push_period);
+	ret += scnprintf(buf + ret, len - ret,
+			 "peer_entries %u peer_drops %u\n",
+			 wma_handle->num_peer_stats_snapshot,
+			 wma_handle->peer_stats_snapshot_drops);
+
+	for (i = 0; i < wma_handle->max_bssid; i++) {
+		vsnap = &wma_handle->vdev_stats_snapshot[i];
+		do {
+			seq = read_seqbegin(&vsnap->lock);
+			version = vsnap->version;
+			update_us = vsnap->update_us;
+			vdev = vsnap->stats;
+		} while (read_seqretry(&vsnap->lock, seq));
+
+		if (!version)
+			continue;
+
+		ret += scnprintf(buf + ret, len - ret,
+			"vdev %d ver %u age_ms %llu bcn_snr %d dat_snr %d "
+			"tx %u/%u/%u/%u fail %u/%u/%u/%u rx %u rx_err %u "
+			"rx_discard %u ack_fail %u rts %u/%u\n",
+			i, version, (now_us - update_us) / 1000,
+			vdev.vdev_snr.bcn_snr, vdev.vdev_snr.dat_snr,
+			vdev.tx_frm_cnt[0], vdev.tx_frm_cnt[1],
+			vdev.tx_frm_cnt[2], vdev.tx_frm_cnt[3],
+			vdev.fail_cnt[0], vdev.fail_cnt[1],
+			vdev.fail_cnt[2], vdev.fail_cnt[3],
+			vdev.rx_frm_cnt, vdev.rx_err_cnt,
+			vdev.rx_discard_cnt, vdev.ack_fail_cnt,
+			vdev.rts_succ_cnt, vdev.rts_fail_cnt);
+	}
+
+	for (i = 0; i < wma_handle->num_peer_stats_snapshot; i++) {
+		psnap = &wma_handle->peer_stats_snapshot[i];
+		do {
+			seq = read_seqbegin(&psnap->lock);
+			peer.valid = psnap->valid;
+			peer.vdev_id = psnap->vdev_id;
+			vos_mem_copy(peer.macaddr, psnap->macaddr, ETH_ALEN);
+			peer.version = psnap->version;
+			peer.update_us = psnap->update_us;
+			peer.rssi = psnap->rssi;
+			peer.tx_rate = psnap->tx_rate;
+			peer.rx_rate = psnap->rx_rate;
+			vos_mem_copy(peer.rssi_avg_beacon,
+				     psnap->rssi_avg_beacon,
+				     sizeof(peer.rssi_avg_beacon));
+			vos_mem_copy(peer.rssi_avg_data, psnap->rssi_avg_data,
+				     sizeof(peer.rssi_avg_data));
+#ifdef QCA_ENABLE_OL_TXRX_PEER_STATS
+			peer.txrx = psnap->txrx;
+#endif
+		} while (read_seqretry(&psnap->lock, seq));
+
+		if (!peer.valid || !peer.version)
+			continue;
+
+		ret += scnprintf(buf + ret, len - ret,
+			"peer %pM vdev %d ver %u age_ms %llu rssi %u "
+			"tx_rate %u rx_rate %u chain_rssi %d/%d data %d/%d\n",
+			peer.macaddr, peer.vdev_id, peer.version,
+			(now_us - peer.update_us) / 1000, peer.rssi,
+			peer.tx_rate, peer.rx_rate,
+			peer.rssi_avg_beacon[0], peer.rssi_avg_beacon[1],
+			peer.rssi_avg_data[0], peer.rssi_avg_data[1]);
+#ifdef QCA_ENABLE_OL_TXRX_PEER_STATS
+		ret += scnprintf(buf + ret, len - ret,
+			"    txrx tx_ucast %u/%u rx_ucast %u/%u\n",
+			peer.txrx.tx.frms.ucast, peer.txrx.tx.bytes.ucast,
+			peer.txrx.rx.frms.ucast, peer.txrx.rx.bytes.ucast);
+#endif
+	}
+
+	return ret;
+}
+
 static void wma_fw_stats_ind(tp_wma_handle wma, u_int8_t *buf)
 {
 	wmi_stats_event_fixed_param *event = (wmi_stats_event_fixed_param *)buf;
@@ -3357,12 +3708,17 @@ static void wma_fw_stats_ind(tp_wma_handle wma, u_int8_t *buf)
 	if (event->num_vdev_stats > 0) {
 		for (i = 0; i < event->num_vdev_stats; i++) {
 			vdev_stats = (wmi_vdev_stats *)temp;
+			wma_stats_snapshot_update_vdev(wma, vdev_stats);
 			wma_update_vdev_stats(wma, vdev_stats);
 			temp += sizeof(wmi_vdev_stats);
 		}
 	}
 
 	if (event->num_peer_stats > 0) {
+		peer_stats = (wmi_peer_stats *)temp;
+		for (i = 0; i < event->num_peer_stats; i++)
+			wma_stats_snapshot_update_peer(wma, &peer_stats[i]);
+
 		if (wma->get_sta_rssi == TRUE) {
 			wma_handle_sta_rssi(event->num_peer_stats,
 						(wmi_peer_stats *)temp,
@@ -3395,6 +3751,8 @@ static void wma_fw_stats_ind(tp_wma_handle wma, u_int8_t *buf)
 			for (i = 0; i < rssi_event->num_per_chain_rssi_stats;
 									i++) {
 				rssi_stats = (wmi_rssi_stats *)temp;
+				wma_stats_snapshot_update_chain_rssi(wma,
+								rssi_stats);
 				wma_update_rssi_stats(wma, rssi_stats);
 				temp += sizeof(wmi_rssi_stats);
 			}
@@ -6696,8 +7054,9 @@ static int wma_roam_synch_event_handler(void *handle, u_int8_t *event, u_int32_t
 		vos_mem_copy(pRoamOffloadSynchInd->replay_ctr, key->replay_counter,
 				SIR_REPLAY_CTR_LEN);
 	}
-	wma_send_msg(wma, WDA_ROAM_OFFLOAD_SYNCH_IND,
-			(void *) pRoamOffloadSynchInd, 0);
+	/* Handoff interruption time depends on this, skip the mgmt rx backlog */
+	wma_send_msg_by_priority(wma, WDA_ROAM_OFFLOAD_SYNCH_IND,
+			(void *) pRoamOffloadSynchInd, 0, HIGH_PRIORITY);
 	return 0;
 }
 #endif
@@ -7409,6 +7768,7 @@ VOS_STATUS WDA_open(v_VOID_t *vos_context, v_VOID_t *os_ctx,
 	}
 
 	WMA_LOGA("WMA --> wmi_unified_attach - success");
+	wmi_unified_set_event_prio(wmi_handle, mac_params->wmi_rx_event_prio);
 
 	/* Save the WMI & HTC handle */
 	wma_handle->wmi_handle = wmi_handle;
@@ -7432,6 +7792,7 @@ VOS_STATUS WDA_open(v_VOID_t *vos_context, v_VOID_t *os_ctx,
 	wma_handle->tx_chain_mask_cck = mac_params->tx_chain_mask_cck;
 	wma_handle->self_gen_frm_pwr = mac_params->self_gen_frm_pwr;
 	wma_handle->max_mgmt_tx_fail_count = mac_params->max_mgmt_tx_fail_count;
+	wma_handle->fw_stats_push_period = mac_params->fw_stats_push_period;
 	/* Allocate cfg handle */
 
 	/* RX Full reorder should enable for PCIe, ROME3.X project only now
@@ -7537,6 +7898,11 @@ VOS_STATUS WDA_open(v_VOID_t *vos_context, v_VOID_t *os_ctx,
 	}
 	vos_mem_zero(wma_handle->interfaces, sizeof(struct wma_txrx_node) *
 					wma_handle->max_bssid);
+	vos_status = wma_stats_snapshot_init(wma_handle);
+	if (vos_status != VOS_STATUS_SUCCESS) {
+		vos_mem_free(wma_handle->interfaces);
+		goto err_scn_context;
+	}
 	/* Register the debug print event handler */
 	wmi_unified_register_event_handler(wma_handle->wmi_handle,
 					   WMI_DEBUG_PRINT_EVENTID,
@@ -7602,6 +7968,7 @@ VOS_STATUS WDA_open(v_VOID_t *vos_context, v_VOID_t *os_ctx,
 	INIT_LIST_HEAD(&wma_handle->vdev_resp_queue);
 	adf_os_spinlock_init(&wma_handle->vdev_respq_lock);
 	adf_os_spinlock_init(&wma_handle->vdev_detach_lock);
+	adf_os_spinlock_init(&wma_handle->tsf_req_lock);
 	adf_os_spinlock_init(&wma_handle->roam_preauth_lock);
 #ifdef WLAN_FEATURE_ROAM_OFFLOAD
 	adf_os_spinlock_init(&wma_handle->roam_synch_lock);
@@ -7774,6 +8141,7 @@ VOS_STATUS WDA_open(v_VOID_t *vos_context, v_VOID_t *os_ctx,
 err_dbglog_init:
 	adf_os_spinlock_destroy(&wma_handle->vdev_respq_lock);
 	adf_os_spinlock_destroy(&wma_handle->vdev_detach_lock);
+	adf_os_spinlock_destroy(&wma_handle->tsf_req_lock);
 	adf_os_spinlock_destroy(&wma_handle->roam_preauth_lock);
 #ifdef WLAN_FEATURE_ROAM_OFFLOAD
 	adf_os_spinlock_destroy(&wma_handle->roam_synch_lock);
@@ -7781,6 +8149,7 @@ err_dbglog_init:
 err_event_init:
 	wmi_unified_unregister_event_handler(wma_handle->wmi_handle,
 					     WMI_DEBUG_PRINT_EVENTID);
+	wma_stats_snapshot_deinit(wma_handle);
 	vos_mem_free(wma_handle->interfaces);
 err_scn_context:
 	wma_dfs_detach(wma_handle->dfs_ic);
@@ -7861,13 +8230,19 @@ end:
 	return vos_status;
 }
 
-/* function   : wma_send_msg
- * Description :
- * Args       :
- * Returns    :
+/**
+ * wma_send_msg_by_priority() - post a message to PE on the given lane
+ * @wma_handle: wma handle
+ * @msg_type: message type
+ * @body_ptr: message body, freed here if posting fails
+ * @body_val: message value
+ * @is_high_priority: HIGH_PRIORITY to bypass regular PE messages
+ *
+ * Return: None
  */
-void wma_send_msg(tp_wma_handle wma_handle, u_int16_t msg_type,
-				void *body_ptr, u_int32_t body_val)
+static void wma_send_msg_by_priority(tp_wma_handle wma_handle,
+		u_int16_t msg_type, void *body_ptr, u_int32_t body_val,
+		int is_high_priority)
 {
 	tSirMsgQ msg = {0} ;
 	tANI_U32 status = VOS_STATUS_SUCCESS ;
@@ -7876,13 +8251,52 @@ void wma_send_msg(tp_wma_handle wma_handle, u_int16_t msg_type,
 	msg.type        = msg_type;
 	msg.bodyval     = body_val;
 	msg.bodyptr     = body_ptr;
-	status = limPostMsgApi(pMac, &msg);
+	if (is_high_priority)
+		status = lim_post_msg_high_pri(pMac, &msg);
+	else
+		status = limPostMsgApi(pMac, &msg);
 	if (VOS_STATUS_SUCCESS != status) {
 		if(NULL != body_ptr)
 			vos_mem_free(body_ptr);
 		VOS_ASSERT(0) ;
 	}
-	return ;
+}
+
+/* function   : wma_send_msg
+ * Description :
+ * Args       :
+ * Returns    :
+ */
+void wma_send_msg(tp_wma_handle wma_handle, u_int16_t msg_type,
+				void *body_ptr, u_int32_t body_val)
+{
+	wma_send_msg_by_priority(wma_handle, msg_type, body_ptr, body_val,
+				 LOW_PRIORITY);
+}
+
+/**
+ * wma_send_scan_event() - post a scan event to PE
+ * @wma_handle: wma handle
+ * @scan_event: event to post, freed on failure
+ *
+ * With WLAN_FEATURE_MGMT_RX_BATCH the beacons and probe responses of the
+ * scan may still wait in a TL shim batch. Post them first, so that PE
+ * has the frames of the last channel before it handles the event.
+ *
+ * Return: none
+ */
+static void wma_send_scan_event(tp_wma_handle wma_handle,
+				tSirScanOffloadEvent *scan_event)
+{
+#ifdef WLAN_FEATURE_MGMT_RX_BATCH
+	u_int32_t num_frames;
+
+	num_frames = WLANTL_MgmtRxBatchFlush(wma_handle->vos_context);
+	WMA_LOGD("%s: scan id %u event %u freq %u, %u batched frames posted ahead",
+		 __func__, scan_event->scanId, scan_event->event,
+		 scan_event->chanFreq, num_frames);
+#endif
+	wma_send_msg(wma_handle, WDA_RX_SCAN_EVENT, (void *)scan_event, 0);
 }
 
 /* function   : wma_get_txrx_vdev_type
@@ -9717,7 +10131,87 @@ VOS_STATUS WDA_GetSnr(tAniGetSnrReq *psnr_req)
 	return VOS_STATUS_SUCCESS;
 }
 
+/**
+ * wma_tsf_req_expire() - drop tsf requests whose report never came
+ * @intr: interface of the vdev
+ * @now: current monotonic time in us
+ *
+ * Caller holds tsf_req_lock.
+ *
+ * Return: none
+ */
+static void wma_tsf_req_expire(struct wma_txrx_node *intr, u_int64_t now)
+{
+	while (intr->tsf_req_cnt &&
+	       now - intr->tsf_req[intr->tsf_req_head].req_us >
+	       WMA_TSF_REQ_TIMEOUT_US) {
+		intr->tsf_req_head = (intr->tsf_req_head + 1) % WMA_TSF_REQ_MAX;
+		intr->tsf_req_cnt--;
+	}
+}
+
 #ifdef WLAN_FEATURE_TSF
+/**
+ * wma_tsf_req_push() - queue a tsf request until its report comes
+ * @wma_handle: wma handler
+ * @vdev_id: vdev id
+ * @type: enum stsf_req_type of the request
+ *
+ * The report event carries nothing to tell a capture from a read, but
+ * the firmware answers the requests of a vdev in the order they were
+ * sent, so wma_vdev_tsf_handler() pairs each report with the oldest
+ * queued request.
+ *
+ * Return: VOS_STATUS_E_BUSY if too many requests are outstanding
+ */
+static VOS_STATUS wma_tsf_req_push(tp_wma_handle wma_handle,
+				   uint32_t vdev_id, u_int8_t type)
+{
+	struct wma_txrx_node *intr;
+	struct wma_tsf_req *req;
+	u_int64_t now = adf_os_get_monotonic_us();
+
+	if (vdev_id >= wma_handle->max_bssid) {
+		WMA_LOGE("%s: invalid vdev_id %u", __func__, vdev_id);
+		return VOS_STATUS_E_INVAL;
+	}
+	intr = &wma_handle->interfaces[vdev_id];
+
+	adf_os_spin_lock_bh(&wma_handle->tsf_req_lock);
+	wma_tsf_req_expire(intr, now);
+	if (intr->tsf_req_cnt == WMA_TSF_REQ_MAX) {
+		adf_os_spin_unlock_bh(&wma_handle->tsf_req_lock);
+		WMA_LOGE("%s: vdev %u has too many tsf requests outstanding",
+			 __func__, vdev_id);
+		return VOS_STATUS_E_BUSY;
+	}
+	req = &intr->tsf_req[(intr->tsf_req_head + intr->tsf_req_cnt) %
+			     WMA_TSF_REQ_MAX];
+	req->type = type;
+	req->req_us = now;
+	intr->tsf_req_cnt++;
+	adf_os_spin_unlock_bh(&wma_handle->tsf_req_lock);
+
+	return VOS_STATUS_SUCCESS;
+}
+
+/**
+ * wma_tsf_req_cancel() - unqueue the last request, it was not sent
+ * @wma_handle: wma handler
+ * @vdev_id: vdev id
+ *
+ * Return: none
+ */
+static void wma_tsf_req_cancel(tp_wma_handle wma_handle, uint32_t vdev_id)
+{
+	struct wma_txrx_node *intr = &wma_handle->interfaces[vdev_id];
+
+	adf_os_spin_lock_bh(&wma_handle->tsf_req_lock);
+	if (intr->tsf_req_cnt)
+		intr->tsf_req_cnt--;
+	adf_os_spin_unlock_bh(&wma_handle->tsf_req_lock);
+}
+
 /**
  * wma_capture_tsf() - send wmi to fw to capture tsf
  *
@@ -9753,10 +10247,15 @@ static VOS_STATUS wma_capture_tsf(tp_wma_handle wma_handle, uint32_t vdev_id)
 		WMITLV_GET_STRUCT_TLVLEN(
 		wmi_vdev_tsf_tstamp_action_cmd_fixed_param));
 
+	vos_status = wma_tsf_req_push(wma_handle, vdev_id, TSF_REQ_CAPTURE);
+	if (vos_status != VOS_STATUS_SUCCESS)
+		goto error;
+
 	status = wmi_unified_cmd_send(wma_handle->wmi_handle, buf,
 				len, WMI_VDEV_TSF_TSTAMP_ACTION_CMDID);
 	if (status != EOK) {
 		WMA_LOGE("wmi_unified_cmd_send returned Error %d", status);
+		wma_tsf_req_cancel(wma_handle, vdev_id);
 		vos_status = VOS_STATUS_E_FAILURE;
 		goto error;
 	}
@@ -9821,6 +10320,60 @@ error:
 		wmi_buf_free(buf);
 	return vos_status;
 }
+
+/**
+ * wma_read_tsf() - send wmi to fw to report the current tsf
+ *
+ * @wma_handle: wma handler
+ * @vdev_id: vdev id
+ *
+ * Unlike a capture this does not toggle the GPIO. The host time of the
+ * request is kept so the report can be paired with it for TSF to host
+ * clock correlation.
+ *
+ * Return: wmi send state
+ */
+static VOS_STATUS wma_read_tsf(tp_wma_handle wma_handle, uint32_t vdev_id)
+{
+	VOS_STATUS vos_status;
+	wmi_buf_t buf;
+	wmi_vdev_tsf_tstamp_action_cmd_fixed_param *cmd;
+	int status;
+	int len = sizeof(*cmd);
+
+	buf = wmi_buf_alloc(wma_handle->wmi_handle, len);
+	if (!buf) {
+		WMA_LOGP("%s: failed to allocate memory for read tsf cmd",
+			 __func__);
+		return VOS_STATUS_E_NOMEM;
+	}
+
+	cmd = (wmi_vdev_tsf_tstamp_action_cmd_fixed_param *) wmi_buf_data(buf);
+	cmd->vdev_id = vdev_id;
+	cmd->tsf_action = TSF_TSTAMP_READ_VALUE;
+
+	WMITLV_SET_HDR(&cmd->tlv_header,
+		WMITLV_TAG_STRUC_wmi_vdev_tsf_tstamp_action_cmd_fixed_param,
+		WMITLV_GET_STRUCT_TLVLEN(
+		wmi_vdev_tsf_tstamp_action_cmd_fixed_param));
+
+	vos_status = wma_tsf_req_push(wma_handle, vdev_id, TSF_REQ_READ);
+	if (vos_status != VOS_STATUS_SUCCESS) {
+		wmi_buf_free(buf);
+		return vos_status;
+	}
+
+	status = wmi_unified_cmd_send(wma_handle->wmi_handle, buf,
+				len, WMI_VDEV_TSF_TSTAMP_ACTION_CMDID);
+	if (status != EOK) {
+		WMA_LOGE("wmi_unified_cmd_send returned Error %d", status);
+		wma_tsf_req_cancel(wma_handle, vdev_id);
+		wmi_buf_free(buf);
+		return VOS_STATUS_E_FAILURE;
+	}
+
+	return VOS_STATUS_SUCCESS;
+}
 #else
 static VOS_STATUS wma_capture_tsf(tp_wma_handle wma_handle, uint32_t vdev_id)
 {
@@ -9831,6 +10384,11 @@ static VOS_STATUS wma_reset_tsf_gpio(tp_wma_handle wma_handle, uint32_t vdev_id)
 {
     return VOS_STATUS_SUCCESS;
 }
+
+static VOS_STATUS wma_read_tsf(tp_wma_handle wma_handle, uint32_t vdev_id)
+{
+    return VOS_STATUS_SUCCESS;
+}
 #endif
 
 /* function   : wma_start_scan
@@ -9958,7 +10516,7 @@ error1:
                 scan_event->reasonCode = eSIR_SME_SCAN_FAILED;
                 scan_event->p2pScanType = scan_req->p2pScanType;
                 scan_event->sessionId = scan_req->sessionId;
-                wma_send_msg(wma_handle, WDA_RX_SCAN_EVENT, (void *) scan_event, 0) ;
+                wma_send_scan_event(wma_handle, scan_event);
         }
 	return vos_status;
 }
@@ -14749,6 +15307,9 @@ static void wma_process_cli_set_cmd(tp_wma_handle wma,
 		case GEN_PARAM_RESET_TSF_GPIO:
 			ret = wma_reset_tsf_gpio(wma, privcmd->param_value);
 			break;
+		case GEN_PARAM_READ_TSF:
+			ret = wma_read_tsf(wma, privcmd->param_value);
+			break;
 #ifdef CONFIG_ATH_PCIE_ACCESS_DEBUG
 		case GEN_PARAM_DUMP_PCIE_ACCESS_LOG:
 			HTCDump(wma->htc_handle, PCIE_DUMP, false);
@@ -31679,7 +32240,7 @@ static int wma_scan_event_callback(WMA_HANDLE handle, u_int8_t *data,
 			WMA_LOGE("Scan id not matched for SCAN COMPLETE event");
         }
 
-	wma_send_msg(wma_handle, WDA_RX_SCAN_EVENT, (void *) scan_event, 0) ;
+	wma_send_scan_event(wma_handle, scan_event);
 	return 0;
 }
 
@@ -32117,8 +32678,7 @@ static int wma_nlo_scan_cmp_evt_handler(void *handle, u_int8_t *event,
 		scan_event->reasonCode = eSIR_SME_SUCCESS;
 		scan_event->event = SIR_SCAN_EVENT_COMPLETED;
 		scan_event->sessionId = nlo_event->vdev_id;
-		wma_send_msg(wma, WDA_RX_SCAN_EVENT,
-			     (void *) scan_event, 0);
+		wma_send_scan_event(wma, scan_event);
 	} else {
 		WMA_LOGE("Memory allocation failed for tSirScanOffloadEvent");
 	}
@@ -32803,6 +33363,36 @@ static int wma_sap_ofl_del_sta_handler(void *handle, u_int8_t *data,
 }
 #endif /* SAP_AUTH_OFFLOAD */
 
+/**
+ * wma_tsf_req_pop() - find the request a tsf report answers
+ * @wma: wma handle
+ * @ptsf: the report, req_type and host_req_us are filled in
+ *
+ * Return: none
+ */
+static void wma_tsf_req_pop(tp_wma_handle wma, struct stsf *ptsf)
+{
+	struct wma_txrx_node *intr;
+	struct wma_tsf_req *req;
+
+	ptsf->req_type = TSF_REQ_UNKNOWN;
+	ptsf->host_req_us = 0;
+	if (!wma || ptsf->vdev_id >= wma->max_bssid)
+		return;
+	intr = &wma->interfaces[ptsf->vdev_id];
+
+	adf_os_spin_lock_bh(&wma->tsf_req_lock);
+	wma_tsf_req_expire(intr, ptsf->host_rsp_us);
+	if (intr->tsf_req_cnt) {
+		req = &intr->tsf_req[intr->tsf_req_head];
+		ptsf->req_type = req->type;
+		ptsf->host_req_us = req->req_us;
+		intr->tsf_req_head = (intr->tsf_req_head + 1) % WMA_TSF_REQ_MAX;
+		intr->tsf_req_cnt--;
+	}
+	adf_os_spin_unlock_bh(&wma->tsf_req_lock);
+}
+
 /**
  * wma_vdev_tsf_handler() - handle tsf event indicated by FW
  *
@@ -32815,10 +33405,12 @@ static int wma_sap_ofl_del_sta_handler(void *handle, u_int8_t *data,
 static int wma_vdev_tsf_handler(void *handle, uint8_t *data,
 				uint32_t data_len)
 {
+	tp_wma_handle wma = (tp_wma_handle)handle;
 	vos_msg_t vos_msg = {0};
 	WMI_VDEV_TSF_REPORT_EVENTID_param_tlvs *param_buf;
 	wmi_vdev_tsf_report_event_fixed_param *tsf_event;
 	struct stsf *ptsf;
+	uint64_t host_rsp_us = adf_os_get_monotonic_us();
 
 	if (data == NULL) {
 		WMA_LOGE("%s: invalid pointer", __func__);
@@ -32836,10 +33428,13 @@ static int wma_vdev_tsf_handler(void *handle, uint8_t *data,
 	ptsf->vdev_id = tsf_event->vdev_id;
 	ptsf->tsf_low = tsf_event->tsf_low;
 	ptsf->tsf_high = tsf_event->tsf_high;
+	ptsf->host_rsp_us = host_rsp_us;
+	wma_tsf_req_pop(wma, ptsf);
 
 	WMA_LOGD("%s: receive WMI_VDEV_TSF_REPORT_EVENTID ", __func__);
-	WMA_LOGD("%s: vdev_id = %u,tsf_low =%u, tsf_high = %u", __func__,
-			 ptsf->vdev_id, ptsf->tsf_low, ptsf->tsf_high);
+	WMA_LOGD("%s: vdev_id = %u,tsf_low =%u, tsf_high = %u, req %u", __func__,
+			 ptsf->vdev_id, ptsf->tsf_low, ptsf->tsf_high,
+			 ptsf->req_type);
 
 	vos_msg.type = eWNI_SME_TSF_EVENT;
 	vos_msg.bodyptr = ptsf;
@@ -32962,6 +33557,35 @@ int wma_scpc_event_handler(void *handle, u_int8_t *event_buf, u_int32_t len)
 }
 #endif
 
+/**
+ * wma_set_fw_stats_push_period() - enable periodic firmware stats events
+ * @wma_handle: wma handle
+ *
+ * With a non zero gFwStatsPushPeriod the firmware sends pdev, vdev and
+ * peer stats on its own and the snapshot stays current without requests.
+ *
+ * Return: none
+ */
+static void wma_set_fw_stats_push_period(tp_wma_handle wma_handle)
+{
+	uint32_t period = wma_handle->fw_stats_push_period;
+
+	if (!period)
+		return;
+
+	if (wmi_unified_pdev_set_param(wma_handle->wmi_handle,
+			WMI_PDEV_PARAM_PDEV_STATS_UPDATE_PERIOD, period) ||
+	    wmi_unified_pdev_set_param(wma_handle->wmi_handle,
+			WMI_PDEV_PARAM_VDEV_STATS_UPDATE_PERIOD, period) ||
+	    wmi_unified_pdev_set_param(wma_handle->wmi_handle,
+			WMI_PDEV_PARAM_PEER_STATS_UPDATE_PERIOD, period)) {
+		WMA_LOGE("%s: failed to set stats update period %u",
+			 __func__, period);
+		return;
+	}
+	WMA_LOGD("%s: fw stats push period %u ms", __func__, period);
+}
+
 /* function   : wma_start
  * Description :
  * Args       :
@@ -33255,6 +33879,8 @@ VOS_STATUS wma_start(v_VOID_t *vos_ctx)
 		goto end;
 	}
 
+	wma_set_fw_stats_push_period(wma_handle);
+
 end:
 	WMA_LOGD("%s: Exit", __func__);
 	return vos_status;
@@ -33419,6 +34045,7 @@ VOS_STATUS wma_wmi_service_close(v_VOID_t *vos_ctx)
 		}
 	}
 
+	wma_stats_snapshot_deinit(wma_handle);
 	vos_mem_free(wma_handle->interfaces);
 	/* free the wma_handle */
 	vos_free_context(wma_handle->vos_context, VOS_MODULE_ID_WDA, wma_handle);
@@ -37546,3 +38173,43 @@ VOS_STATUS wma_set_tx_power_scale_decr_db(uint8_t vdev_id, int value)
 
 	return ret;
 }
+
+/**
+ * wma_display_wmi_rx_event_stats() - display WMI rx event queue and param
+ *                                    buffer stats
+ *
+ * Return: none
+ */
+void wma_display_wmi_rx_event_stats(void)
+{
+	void *vos_context = vos_get_global_context(VOS_MODULE_ID_WDA, NULL);
+	tp_wma_handle wma_handle = (tp_wma_handle) vos_get_context(
+					VOS_MODULE_ID_WDA, vos_context);
+
+	if (NULL == wma_handle || NULL == wma_handle->wmi_handle) {
+		WMA_LOGE("%s: wma_handle is NULL", __func__);
+		return;
+	}
+
+	wmi_unified_display_rx_event_stats(wma_handle->wmi_handle);
+}
+
+/**
+ * wma_clear_wmi_rx_event_stats() - clear WMI rx event queue and param
+ *                                  buffer stats
+ *
+ * Return: none
+ */
+void wma_clear_wmi_rx_event_stats(void)
+{
+	void *vos_context = vos_get_global_context(VOS_MODULE_ID_WDA, NULL);
+	tp_wma_handle wma_handle = (tp_wma_handle) vos_get_context(
+					VOS_MODULE_ID_WDA, vos_context);
+
+	if (NULL == wma_handle || NULL == wma_handle->wmi_handle) {
+		WMA_LOGE("%s: wma_handle is NULL", __func__);
+		return;
+	}
+
+	wmi_unified_clear_rx_event_stats(wma_handle->wmi_handle);
+}
@@ -70,6 +70,7 @@
 #include "ol_txrx_types.h"
 #include "wlan_qct_wda.h"
 #include <linux/workqueue.h>
+#include <linux/seqlock.h>
 #include "ol_defines.h"
 #include "limTypes.h"
 
@@ -567,6 +568,66 @@ typedef struct {
 	tANI_U8 ssidHidden;
 } vdev_restart_params_t;
 
+/**
+ * struct wma_vdev_stats_snapshot - last firmware stats seen for a vdev
+ * @lock: seqlock; written from the MC thread, read lock-free
+ * @version: incremented on every update, 0 means never updated
+ * @update_us: monotonic time of the last update
+ * @stats: copy of the last wmi_vdev_stats reported by the firmware
+ */
+struct wma_vdev_stats_snapshot {
+	seqlock_t lock;
+	uint32_t version;
+	uint64_t update_us;
+	wmi_vdev_stats stats;
+};
+
+/**
+ * struct wma_peer_stats_snapshot - last firmware/host stats seen for a peer
+ * @lock: seqlock; written from the MC thread, read lock-free
+ * @valid: entry is in use
+ * @vdev_id: vdev the peer belongs to
+ * @macaddr: peer mac address
+ * @version: incremented on every update
+ * @update_us: monotonic time of the last update
+ * @rssi: last rssi reported in wmi_peer_stats
+ * @tx_rate: last tx data rate (kbps)
+ * @rx_rate: last rx data rate (kbps)
+ * @rssi_avg_beacon: per chain beacon rssi
+ * @rssi_avg_data: per chain data rssi
+ * @txrx: host datapath counters copied on the same update
+ */
+struct wma_peer_stats_snapshot {
+	seqlock_t lock;
+	bool valid;
+	uint8_t vdev_id;
+	uint8_t macaddr[ETH_ALEN];
+	uint32_t version;
+	uint64_t update_us;
+	uint32_t rssi;
+	uint32_t tx_rate;
+	uint32_t rx_rate;
+	int32_t rssi_avg_beacon[WMI_MAX_CHAINS];
+	int32_t rssi_avg_data[WMI_MAX_CHAINS];
+#ifdef QCA_ENABLE_OL_TXRX_PEER_STATS
+	ol_txrx_peer_stats_t txrx;
+#endif
+};
+
+#define WMA_TSF_REQ_MAX 4
+/* a report that has not come after this long is not coming */
+#define WMA_TSF_REQ_TIMEOUT_US 1000000
+
+/**
+ * struct wma_tsf_req - a tsf request waiting for its report
+ * @type: enum stsf_req_type of the request
+ * @req_us: monotonic time the request was sent at
+ */
+struct wma_tsf_req {
+	u_int8_t type;
+	u_int64_t req_us;
+};
+
 struct wma_txrx_node {
 	u_int8_t addr[ETH_ALEN];
 	u_int8_t bssid[ETH_ALEN];
@@ -643,6 +704,10 @@ struct wma_txrx_node {
 
 	uint8_t wep_default_key_idx;
 	bool is_vdev_valid;
+	/* outstanding TSF requests, answered by the firmware in order */
+	struct wma_tsf_req tsf_req[WMA_TSF_REQ_MAX];
+	u_int8_t tsf_req_head;
+	u_int8_t tsf_req_cnt;
 
 };
 
@@ -780,6 +845,8 @@ typedef struct wma_handle {
 	struct list_head vdev_resp_queue;
 	adf_os_spinlock_t vdev_respq_lock;
         adf_os_spinlock_t vdev_detach_lock;
+	/* protects the tsf_req queue of every interface */
+	adf_os_spinlock_t tsf_req_lock;
 	u_int32_t ht_cap_info;
 #ifdef WLAN_FEATURE_11AC
 	u_int32_t vht_cap_info;
@@ -921,6 +988,13 @@ typedef struct wma_handle {
 	uint32_t wow_wakeup_disable_mask;
 	uint16_t max_mgmt_tx_fail_count;
 	uint32_t ccmp_replays_attack_cnt;
+	uint32_t fw_stats_push_period;
+	struct wma_vdev_stats_snapshot *vdev_stats_snapshot;
+	/* one entry per peer the target is configured for */
+	struct wma_peer_stats_snapshot *peer_stats_snapshot;
+	uint32_t num_peer_stats_snapshot;
+	/* peer updates dropped because every entry was in use */
+	uint32_t peer_stats_snapshot_drops;
 
 	struct wma_runtime_pm_context runtime_context;
 	uint32_t fine_time_measurement_cap;
@@ -0,0 +1 @@
+#include "wmi_stub.h"
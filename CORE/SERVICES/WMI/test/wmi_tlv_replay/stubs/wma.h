@@ -0,0 +1,3 @@
+#include "wmi_stub.h"
+#include "wmi_unified.h"
+#include "wmi_tlv_helper.h"
@@ -0,0 +1,2 @@
+#include "wmi_stub.h"
+#include "wmi_unified.h"
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2016 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/*
+ * Userspace stand-ins for the OS, ADF and driver declarations that
+ * wmi_tlv_helper.c and the WMI interface headers use. Every driver
+ * header they include resolves to this file when building the WMI TLV
+ * replay harness.
+ */
+#ifndef __WMI_STUB_H
+#define __WMI_STUB_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef uint8_t A_UINT8;
+typedef uint16_t A_UINT16;
+typedef uint32_t A_UINT32;
+typedef uint64_t A_UINT64;
+typedef int8_t A_INT8;
+typedef int16_t A_INT16;
+typedef int32_t A_INT32;
+typedef int64_t A_INT64;
+typedef char A_CHAR;
+typedef unsigned char A_UCHAR;
+typedef int A_BOOL;
+
+#ifndef TRUE
+#define TRUE 1
+#define FALSE 0
+#endif
+
+#define A_COMPILE_TIME_ASSERT(name, pred) \
+    typedef char name[(pred) ? 1 : -1]
+
+#define roundup(x, y) ((((x) + ((y) - 1)) / (y)) * (y))
+
+#define OS_MEMCPY memcpy
+#define OS_MEMZERO(p, n) memset(p, 0, n)
+#define OS_MEMMOVE memmove
+#define OS_MALLOC(os, n, flags) malloc(n)
+#define adf_os_mem_free free
+
+/* Validation errors are expected for the corrupted buffers, keep them
+ * out of the output that is compared between revisions. */
+extern int wmi_replay_verbose;
+#define adf_os_print(...) \
+    do { if (wmi_replay_verbose) fprintf(stderr, __VA_ARGS__); } while (0)
+
+#endif /* __WMI_STUB_H */
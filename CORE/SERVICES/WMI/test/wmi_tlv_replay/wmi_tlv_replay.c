@@ -0,0 +1,408 @@
+/*
+ * Copyright (c) 2016 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/*
+ * WMI TLV replay harness
+ *
+ * Feeds WMI event buffers through wmitlv_check_and_pad_event_tlvs() and
+ * command buffers through wmitlv_check_command_tlv_params() from a
+ * userspace build of wmi_tlv_helper.c, and prints the result of every
+ * check along with a digest of the parsed event, so two revisions of the
+ * TLV validation code can be compared. See wmi_tlv_replay.sh, which
+ * builds the working tree and a git revision and diffs their output.
+ *
+ * Usage:
+ *   wmi_tlv_replay [-v] -r <seed> <runs>   replay generated messages
+ *   wmi_tlv_replay [-v] -f <capture>       replay captured messages
+ *   wmi_tlv_replay -w <seed> <runs>        print generated messages as
+ *                                          a capture
+ *
+ * A capture holds one message per line, the WMI id followed by the TLV
+ * buffer that follows the WMI_CMD_HDR, e.g. from a hex dump of the
+ * event nbuf in wmi_control_rx():
+ *
+ *   evt <id> <TLV buffer in hex>
+ *   cmd <id> <TLV buffer in hex>
+ *
+ * Generated messages follow the TLV definitions in wmi_tlv_defs.h, and
+ * some are changed the way older or newer firmware would send them:
+ * shorter or longer structures, missing trailing TLVs, a cut off last
+ * TLV, a wrong tag or an unknown id. Every message is checked
+ * WMI_REPLAY_REPEAT times and the time spent in the checks is reported
+ * on stderr.
+ */
+
+#include "wmi_stub.h"
+#include "wmi_unified.h"
+#include "wmi_tlv_helper.h"
+#include "wmi_tlv_defs.h"
+#include <time.h>
+
+#define WMI_REPLAY_MAX_LEN 4096
+#define WMI_REPLAY_REPEAT  8
+#define WMI_REPLAY_N(a) ((int)(sizeof(a) / sizeof((a)[0])))
+
+int wmi_replay_verbose;
+
+struct wmi_replay_tlv {
+    A_UINT32 tag;
+    A_UINT32 struct_size;
+    A_UINT32 var_len;
+    A_UINT32 arr_size;
+};
+
+struct wmi_replay_msg {
+    A_UINT32 id;
+    const char *name;
+    int num_tlvs;
+    const struct wmi_replay_tlv *tlvs;
+};
+
+#define WMITLV_OP_REPLAY_DESC_macro(param_ptr, param_len, wmi_cmd_event_id, elem_tlv_tag, elem_struc_type, elem_name, var_len, arr_size) \
+    { elem_tlv_tag, sizeof(elem_struc_type), var_len, arr_size },
+
+#define WMI_REPLAY_MSG(id) \
+    { id, #id, WMITLV_GET_TAG_NUM_TLV_ATTRIB(id), \
+      (const struct wmi_replay_tlv []) { WMITLV_TABLE(id, REPLAY_DESC, NULL, 0) } },
+
+static const struct wmi_replay_msg evt_msgs[] = {
+    WMITLV_ALL_EVT_LIST(WMI_REPLAY_MSG)
+};
+
+static const struct wmi_replay_msg cmd_msgs[] = {
+    WMITLV_ALL_CMD_LIST(WMI_REPLAY_MSG)
+};
+
+static A_UINT32 rnd_state;
+static struct timespec check_time;
+static A_UINT32 msg_buf[WMI_REPLAY_MAX_LEN / sizeof(A_UINT32)];
+
+static A_UINT32 rnd(void)
+{
+    rnd_state ^= rnd_state << 13;
+    rnd_state ^= rnd_state >> 17;
+    rnd_state ^= rnd_state << 5;
+    return rnd_state;
+}
+
+static void timespec_add_since(struct timespec *acc,
+                               const struct timespec *start)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    acc->tv_sec += now.tv_sec - start->tv_sec;
+    acc->tv_nsec += now.tv_nsec - start->tv_nsec;
+    if (acc->tv_nsec < 0) {
+        acc->tv_nsec += 1000000000L;
+        acc->tv_sec--;
+    } else if (acc->tv_nsec >= 1000000000L) {
+        acc->tv_nsec -= 1000000000L;
+        acc->tv_sec++;
+    }
+}
+
+static const struct wmi_replay_msg *find_msg(const struct wmi_replay_msg *msgs,
+                                             int num, A_UINT32 id)
+{
+    int i;
+
+    for (i = 0; i < num; i++) {
+        if (msgs[i].id == id)
+            return &msgs[i];
+    }
+    return NULL;
+}
+
+static A_UINT32 digest_add(A_UINT32 h, const void *p, A_UINT32 len)
+{
+    const A_UINT8 *b = p;
+
+    while (len--) {
+        h ^= *b++;
+        h *= 16777619;
+    }
+    return h;
+}
+
+/*
+ * Digest of the parsed event: for every TLV the element count, whether
+ * it was padded into a new buffer or where it points into the event
+ * buffer, and the element data as the event handlers would see it.
+ */
+static A_UINT32 event_digest(const struct wmi_replay_msg *m,
+                             const void *param_buf)
+{
+    const wmitlv_cmd_param_info *info = param_buf;
+    A_UINT32 h = 2166136261U;
+    A_UINT32 where;
+    int i;
+
+    for (i = 0; i < m->num_tlvs; i++) {
+        if (info[i].tlv_ptr == NULL)
+            where = 0;
+        else if (info[i].buf_is_allocated)
+            where = 1;
+        else
+            where = 2 + (A_UINT32)((A_UINT8 *)info[i].tlv_ptr -
+                                   (A_UINT8 *)msg_buf);
+        h = digest_add(h, &where, sizeof(where));
+        h = digest_add(h, &info[i].num_elements,
+                       sizeof(info[i].num_elements));
+        h = digest_add(h, &info[i].buf_is_allocated,
+                       sizeof(info[i].buf_is_allocated));
+        if (info[i].tlv_ptr != NULL)
+            h = digest_add(h, info[i].tlv_ptr,
+                           info[i].num_elements * m->tlvs[i].struct_size);
+    }
+    return h;
+}
+
+static void check_msg(int n, int is_evt, A_UINT32 id, A_UINT32 len)
+{
+    const struct wmi_replay_msg *m;
+    struct timespec start;
+    void *param_buf = NULL;
+    A_UINT32 h = 0;
+    int i, ret = 0;
+
+    m = is_evt ? find_msg(evt_msgs, WMI_REPLAY_N(evt_msgs), id) :
+                 find_msg(cmd_msgs, WMI_REPLAY_N(cmd_msgs), id);
+
+    for (i = 0; i < WMI_REPLAY_REPEAT; i++) {
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        if (is_evt) {
+            ret = wmitlv_check_and_pad_event_tlvs(NULL, msg_buf, len, id,
+                                                  &param_buf);
+        } else {
+            ret = wmitlv_check_command_tlv_params(NULL, msg_buf, len, id);
+        }
+        timespec_add_since(&check_time, &start);
+        if (i == 0 && ret == 0 && is_evt && m != NULL)
+            h = event_digest(m, param_buf);
+        if (is_evt && ret == 0)
+            wmitlv_free_allocated_event_tlvs(id, &param_buf);
+    }
+
+    if (m != NULL)
+        printf("%d %s %s len %u ret %d tlvs %08x\n", n,
+               is_evt ? "evt" : "cmd", m->name, len, ret, h);
+    else
+        printf("%d %s 0x%x len %u ret %d tlvs %08x\n", n,
+               is_evt ? "evt" : "cmd", id, len, ret, h);
+}
+
+static int is_array_tag(A_UINT32 tag)
+{
+    return (tag >= WMITLV_TAG_FIRST_ARRAY_ENUM) &&
+           (tag <= WMITLV_TAG_LAST_ARRAY_ENUM);
+}
+
+static void fill_random(A_UINT8 *p, A_UINT32 len)
+{
+    while (len--)
+        *p++ = (A_UINT8)rnd();
+}
+
+/*
+ * Build the TLV buffer of @m in msg_buf. @size_diff is added to the
+ * structure size of TLV @victim, like a firmware built against an older
+ * or newer definition would send it, and @bad_tag replaces its tag.
+ */
+static A_UINT32 gen_tlvs(const struct wmi_replay_msg *m, int num_tlvs,
+                         int victim, int size_diff, int bad_tag)
+{
+    A_UINT8 *buf = (A_UINT8 *)msg_buf;
+    const struct wmi_replay_tlv *t;
+    A_UINT32 pos = 0, body, elem, num, j;
+    A_UINT32 tag;
+    int i, diff;
+
+    for (i = 0; i < num_tlvs; i++) {
+        t = &m->tlvs[i];
+        diff = (i == victim) ? size_diff : 0;
+        elem = t->struct_size;
+        tag = (i == victim && bad_tag) ? t->tag + 1 : t->tag;
+
+        if (!is_array_tag(t->tag)) {
+            body = t->struct_size - WMI_TLV_HDR_SIZE;
+            if (diff < 0 && (A_UINT32)-diff > body)
+                diff = -(int)body;
+            body += diff;
+        } else if (t->var_len == WMITLV_SIZE_FIX) {
+            body = t->arr_size * t->struct_size;
+            if (t->tag == WMITLV_TAG_ARRAY_BYTE)
+                body = roundup(body, sizeof(A_UINT32));
+            if (diff < 0 && (A_UINT32)-diff > body)
+                diff = -(int)body;
+            body += diff;
+        } else {
+            num = (rnd() % 4) ? rnd() % 4 : rnd() % 24;
+            if (t->tag == WMITLV_TAG_ARRAY_STRUC) {
+                /* Inner structures carry their own TLV header */
+                if (diff < 0 && (A_UINT32)-diff >= elem)
+                    diff = WMI_TLV_HDR_SIZE - (int)elem;
+                elem += diff;
+            }
+            body = num * elem;
+            if (t->tag == WMITLV_TAG_ARRAY_BYTE)
+                body = roundup(body, sizeof(A_UINT32));
+        }
+        if (pos + WMI_TLV_HDR_SIZE + body > sizeof(msg_buf))
+            break;
+
+        fill_random(buf + pos + WMI_TLV_HDR_SIZE, body);
+        WMITLV_SET_HDR(buf + pos, tag, body);
+        if (t->tag == WMITLV_TAG_ARRAY_STRUC && body) {
+            for (j = 0; j + elem <= body; j += elem) {
+                WMITLV_SET_HDR(buf + pos + WMI_TLV_HDR_SIZE + j, 0,
+                               (elem - WMI_TLV_HDR_SIZE));
+            }
+        }
+        pos += WMI_TLV_HDR_SIZE + body;
+    }
+    return pos;
+}
+
+static A_UINT32 gen_msg(const struct wmi_replay_msg *m, A_UINT32 *id)
+{
+    int mode = rnd() % 16;
+    int num_tlvs = m->num_tlvs;
+    int victim = num_tlvs ? rnd() % num_tlvs : 0;
+    int size_diff = 0;
+    A_UINT32 len;
+
+    *id = m->id;
+    if (mode >= 8 && mode <= 10)
+        size_diff = -4 * (1 + rnd() % 4);
+    else if (mode == 11 || mode == 12)
+        size_diff = 4 * (1 + rnd() % 4);
+    else if (mode == 13)
+        num_tlvs = rnd() % (num_tlvs + 1);
+    else if (mode == 15 && !(rnd() % 4))
+        *id = ((rnd() % 0x40) << 12) | (rnd() % 0x40);
+
+    len = gen_tlvs(m, num_tlvs, victim, size_diff, mode == 15);
+    if (mode == 14 && len > WMI_TLV_HDR_SIZE)
+        len -= 1 + rnd() % (len - WMI_TLV_HDR_SIZE);
+    return len;
+}
+
+static void write_capture(int is_evt, A_UINT32 id, A_UINT32 len)
+{
+    const A_UINT8 *buf = (const A_UINT8 *)msg_buf;
+    A_UINT32 i;
+
+    printf("%s 0x%x ", is_evt ? "evt" : "cmd", id);
+    for (i = 0; i < len; i++)
+        printf("%02x", buf[i]);
+    printf("\n");
+}
+
+static int replay_random(A_UINT32 seed, int runs, int write)
+{
+    const struct wmi_replay_msg *m;
+    A_UINT32 id, len;
+    int r, is_evt;
+
+    rnd_state = seed ? seed : 1;
+    for (r = 0; r < runs; r++) {
+        /* The host validates every event it receives, but commands only
+         * in debug builds. */
+        is_evt = rnd() % 8;
+        if (is_evt)
+            m = &evt_msgs[rnd() % WMI_REPLAY_N(evt_msgs)];
+        else
+            m = &cmd_msgs[rnd() % WMI_REPLAY_N(cmd_msgs)];
+        memset(msg_buf, 0, sizeof(msg_buf));
+        len = gen_msg(m, &id);
+        if (write)
+            write_capture(is_evt, id, len);
+        else
+            check_msg(r, is_evt, id, len);
+    }
+    return 0;
+}
+
+static A_UINT32 hex_decode(const char *s, A_UINT8 *buf, A_UINT32 max)
+{
+    unsigned int v;
+    A_UINT32 n = 0;
+
+    while (*s && n < max) {
+        if (sscanf(s, "%2x", &v) != 1)
+            break;
+        buf[n++] = (A_UINT8)v;
+        s += 2;
+    }
+    return n;
+}
+
+static int replay_capture(const char *path)
+{
+    static char line[2 * WMI_REPLAY_MAX_LEN + 64];
+    FILE *f = fopen(path, "r");
+    char kind[4], *hex;
+    unsigned int id;
+    A_UINT32 len;
+    int n = 0, off;
+
+    if (f == NULL) {
+        perror(path);
+        return 1;
+    }
+    while (fgets(line, sizeof(line), f)) {
+        if (sscanf(line, "%3s %i %n", kind, &id, &off) != 2 ||
+            (strcmp(kind, "evt") && strcmp(kind, "cmd")))
+            continue;
+        hex = line + off;
+        hex[strcspn(hex, " \r\n")] = '\0';
+        memset(msg_buf, 0, sizeof(msg_buf));
+        len = hex_decode(hex, (A_UINT8 *)msg_buf, sizeof(msg_buf));
+        check_msg(n++, !strcmp(kind, "evt"), id, len);
+    }
+    fclose(f);
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    int ret;
+
+    if (argc > 1 && !strcmp(argv[1], "-v")) {
+        wmi_replay_verbose = 1;
+        argc--;
+        argv++;
+    }
+    if (argc == 4 && !strcmp(argv[1], "-r"))
+        ret = replay_random(strtoul(argv[2], NULL, 0), atoi(argv[3]), 0);
+    else if (argc == 4 && !strcmp(argv[1], "-w"))
+        return replay_random(strtoul(argv[2], NULL, 0), atoi(argv[3]), 1);
+    else if (argc == 3 && !strcmp(argv[1], "-f"))
+        ret = replay_capture(argv[2]);
+    else {
+        fprintf(stderr, "usage: wmi_tlv_replay [-v] -r <seed> <runs>\n"
+                        "       wmi_tlv_replay [-v] -f <capture>\n"
+                        "       wmi_tlv_replay -w <seed> <runs>\n");
+        return 2;
+    }
+
+    fprintf(stderr, "wmi_tlv_replay: check %ld.%06ld s\n",
+            (long)check_time.tv_sec, check_time.tv_nsec / 1000);
+    return ret;
+}
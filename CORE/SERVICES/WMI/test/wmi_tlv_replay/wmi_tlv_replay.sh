@@ -0,0 +1,48 @@
+#!/bin/sh
+#
+# Build the WMI TLV replay harness against wmi_tlv_helper.c from the
+# working tree and from a git revision, replay the same WMI messages
+# through both and fail if any check returns a different result or
+# parses an event differently.
+#
+# usage: wmi_tlv_replay.sh [<rev> [<seed> [<runs>]]]
+#        wmi_tlv_replay.sh -f <capture> [<rev>]
+
+set -e
+
+HERE=$(cd "$(dirname "$0")" && pwd)
+WMI=$HERE/../..
+CC=${CC:-cc}
+CFLAGS="-O2 -Wall"
+
+if [ "$1" = "-f" ]; then
+    ARGS="-f $2"
+    REV=${3:-HEAD}
+else
+    REV=${1:-HEAD}
+    ARGS="-r ${2:-1} ${3:-100000}"
+fi
+
+OUT=$(mktemp -d)
+trap 'rm -rf "$OUT"' EXIT
+
+# wmi_tlv_helper.c includes wmi_tlv_platform.c relative to its own
+# directory, so build from copies of both.
+mkdir "$OUT/new" "$OUT/old"
+cp "$WMI/wmi_tlv_helper.c" "$WMI/wmi_tlv_platform.c" "$OUT/new/"
+(cd "$WMI" && git show "$REV:./wmi_tlv_helper.c" > "$OUT/old/wmi_tlv_helper.c" &&
+              git show "$REV:./wmi_tlv_platform.c" > "$OUT/old/wmi_tlv_platform.c")
+
+for t in old new; do
+    $CC $CFLAGS -I"$OUT/$t" -I"$HERE/stubs" -I"$WMI/../COMMON" \
+        -o "$OUT/$t/wmi_tlv_replay" \
+        "$OUT/$t/wmi_tlv_helper.c" "$HERE/wmi_tlv_replay.c"
+    echo "$t:" >&2
+    "$OUT/$t/wmi_tlv_replay" $ARGS > "$OUT/$t.txt"
+done
+
+if ! diff -u "$OUT/old.txt" "$OUT/new.txt"; then
+    echo "wmi_tlv_replay: TLV checks differ from $REV" >&2
+    exit 1
+fi
+echo "wmi_tlv_replay: $(wc -l < "$OUT/new.txt") messages match $REV"
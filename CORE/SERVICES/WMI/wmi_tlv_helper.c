@@ -61,6 +61,54 @@ A_UINT32 evtAttrList[] =
         WMITLV_ALL_EVT_LIST(WMITLV_GET_CMD_EVT_ATTRB_LIST)
     };
 
+/*
+ * Build time index of the attribute lists above. The position of the ATTRB0
+ * word of every command/event is generated as an enum constant, laid out the
+ * same way as cmdAttrList/evtAttrList (one ATTRB0 word followed by one ATTRB1
+ * word per TLV), and stored in a table indexed by the WMI group and the
+ * sequence number within the group. Entries hold (position + 1) so that 0
+ * marks an id without TLV definitions.
+ */
+#define WMITLV_IDX_NUM_GRPS 0x40
+#define WMITLV_IDX_NUM_SEQS 0x40
+
+#define WMITLV_IDX_GRP(id) (((id) >> 12) & 0xFFF)
+#define WMITLV_IDX_SEQ(id) ((id) & 0xFFF)
+
+#define WMITLV_CMD_ATTRB_POS_ENUM(id) \
+        WMITLV_CMD_ATTRB_POS_##id, \
+        WMITLV_CMD_ATTRB_LAST_##id = WMITLV_CMD_ATTRB_POS_##id + WMITLV_GET_TAG_NUM_TLV_ATTRIB(id),
+
+#define WMITLV_EVT_ATTRB_POS_ENUM(id) \
+        WMITLV_EVT_ATTRB_POS_##id, \
+        WMITLV_EVT_ATTRB_LAST_##id = WMITLV_EVT_ATTRB_POS_##id + WMITLV_GET_TAG_NUM_TLV_ATTRIB(id),
+
+enum {
+    WMITLV_ALL_CMD_LIST(WMITLV_CMD_ATTRB_POS_ENUM)
+    WMITLV_CMD_ATTRB_LIST_LEN
+};
+
+enum {
+    WMITLV_ALL_EVT_LIST(WMITLV_EVT_ATTRB_POS_ENUM)
+    WMITLV_EVT_ATTRB_LIST_LEN
+};
+
+#define WMITLV_SET_CMD_ATTRB_IDX(id) \
+        [WMITLV_IDX_GRP(id)][WMITLV_IDX_SEQ(id)] = WMITLV_CMD_ATTRB_POS_##id + 1,
+
+#define WMITLV_SET_EVT_ATTRB_IDX(id) \
+        [WMITLV_IDX_GRP(id)][WMITLV_IDX_SEQ(id)] = WMITLV_EVT_ATTRB_POS_##id + 1,
+
+static const A_UINT16 cmdAttrIdx[WMITLV_IDX_NUM_GRPS][WMITLV_IDX_NUM_SEQS] =
+    {
+        WMITLV_ALL_CMD_LIST(WMITLV_SET_CMD_ATTRB_IDX)
+    };
+
+static const A_UINT16 evtAttrIdx[WMITLV_IDX_NUM_GRPS][WMITLV_IDX_NUM_SEQS] =
+    {
+        WMITLV_ALL_EVT_LIST(WMITLV_SET_EVT_ATTRB_IDX)
+    };
+
 
 #ifdef NO_DYNAMIC_MEM_ALLOC
 static wmitlv_cmd_param_info *g_WmiStaticCmdParamInfoBuf = NULL;
@@ -91,63 +139,98 @@ wmitlv_set_static_param_tlv_buf(void *param_tlv_buf, A_UINT32 max_tlvs_accomodat
 }
 
 /*
- * WMI TLV Helper functions to find the attributes of the Command/Event TLVs.
- * Return 0 if success. Return >=1 if failure.
+ * WMI TLV Helper function to find the attribute words of a Command/Event.
+ * Returns a pointer to the ATTRB0 word of the command/event, followed by one
+ * ATTRB1 word per TLV. Returns NULL if there are no TLV definitions for it.
  */
-A_UINT32 wmitlv_get_attributes(A_UINT32 is_cmd_id, A_UINT32 cmd_event_id, A_UINT32 curr_tlv_order, wmitlv_attributes_struc* tlv_attr_ptr)
+static const A_UINT32 *
+wmitlv_find_attrib_list(A_UINT32 is_cmd_id, A_UINT32 cmd_event_id)
 {
-    A_UINT32 i, base_index, num_tlvs, num_entries;
-    A_UINT32 *pAttrArrayList;
+    A_UINT32 id = WMITLV_GET_CMDID(cmd_event_id);
+    A_UINT32 grp = WMITLV_IDX_GRP(id);
+    A_UINT32 seq = WMITLV_IDX_SEQ(id);
+    const A_UINT32 *pAttrArrayList;
+    A_UINT16 pos;
+
+    if ((grp >= WMITLV_IDX_NUM_GRPS) || (seq >= WMITLV_IDX_NUM_SEQS))
+    {
+        return NULL;
+    }
 
     if (is_cmd_id)
     {
+        pos = cmdAttrIdx[grp][seq];
         pAttrArrayList = &cmdAttrList[0];
-        num_entries = (sizeof(cmdAttrList)/sizeof(A_UINT32));
     }
     else
     {
+        pos = evtAttrIdx[grp][seq];
         pAttrArrayList = &evtAttrList[0];
-        num_entries = (sizeof(evtAttrList)/sizeof(A_UINT32));
     }
 
-    for (i = 0; i < num_entries; i++)
+    if (pos == 0)
     {
-        num_tlvs = WMITLV_GET_NUM_TLVS(pAttrArrayList[i]);
-        if (WMITLV_GET_CMDID(cmd_event_id) == WMITLV_GET_CMDID(pAttrArrayList[i]))
-        {
-            tlv_attr_ptr->cmd_num_tlv = num_tlvs;
-            /* Return success from here when only number of TLVS for this command/event is required */
-            if (curr_tlv_order == WMITLV_GET_ATTRIB_NUM_TLVS)
-            {
-                wmi_tlv_print_verbose("%s: WMI TLV attribute definitions for %s:0x%x found; num_of_tlvs:%d\n",
-                               __func__, (is_cmd_id ? "Cmd" : "Evt"), cmd_event_id, num_tlvs);
-                return 0;
-            }
+        return NULL;
+    }
 
-            /* Return failure if tlv_order is more than the expected number of TLVs */
-            if (curr_tlv_order >= num_tlvs)
-            {
-                wmi_tlv_print_error("%s: ERROR: TLV order %d greater than num_of_tlvs:%d for %s:0x%x\n",
-                               __func__, curr_tlv_order, num_tlvs, (is_cmd_id ? "Cmd" : "Evt"), cmd_event_id);
-                return 1;
-            }
+    return &pAttrArrayList[pos - 1];
+}
 
-            base_index = i + 1; // index to first TLV attributes
-            wmi_tlv_print_verbose("%s: WMI TLV attributes for %s:0x%x tlv[%d]:0x%x\n",
-                           __func__, (is_cmd_id ? "Cmd" : "Evt"), cmd_event_id, curr_tlv_order, pAttrArrayList[(base_index+curr_tlv_order)]);
-            tlv_attr_ptr->tag_order = curr_tlv_order;
-            tlv_attr_ptr->tag_id = WMITLV_GET_TAGID(pAttrArrayList[(base_index+curr_tlv_order)]);
-            tlv_attr_ptr->tag_struct_size = WMITLV_GET_TAG_STRUCT_SIZE(pAttrArrayList[(base_index+curr_tlv_order)]);
-            tlv_attr_ptr->tag_varied_size = WMITLV_GET_TAG_VARIED(pAttrArrayList[(base_index+curr_tlv_order)]);
-            tlv_attr_ptr->tag_array_size = WMITLV_GET_TAG_ARRAY_SIZE(pAttrArrayList[(base_index+curr_tlv_order)]);
-            return 0;
-        }
-        i += num_tlvs;
+/*
+ * WMI TLV Helper function to decode the attributes of the TLV with order
+ * "curr_tlv_order" from the attribute words found by wmitlv_find_attrib_list.
+ * Return 0 if success. Return >=1 if failure.
+ */
+static A_UINT32
+wmitlv_decode_attributes(const A_UINT32 *pAttrs, A_UINT32 is_cmd_id, A_UINT32 cmd_event_id, A_UINT32 curr_tlv_order, wmitlv_attributes_struc* tlv_attr_ptr)
+{
+    A_UINT32 num_tlvs = WMITLV_GET_NUM_TLVS(pAttrs[0]);
+    A_UINT32 attrib;
+
+    tlv_attr_ptr->cmd_num_tlv = num_tlvs;
+    /* Return success from here when only number of TLVS for this command/event is required */
+    if (curr_tlv_order == WMITLV_GET_ATTRIB_NUM_TLVS)
+    {
+        wmi_tlv_print_verbose("%s: WMI TLV attribute definitions for %s:0x%x found; num_of_tlvs:%d\n",
+                       __func__, (is_cmd_id ? "Cmd" : "Evt"), cmd_event_id, num_tlvs);
+        return 0;
     }
 
-    wmi_tlv_print_error("%s: ERROR: Didn't found WMI TLV attribute definitions for %s:0x%x\n",
-                   __func__, (is_cmd_id ? "Cmd" : "Evt"), cmd_event_id);
-    return 1;
+    /* Return failure if tlv_order is more than the expected number of TLVs */
+    if (curr_tlv_order >= num_tlvs)
+    {
+        wmi_tlv_print_error("%s: ERROR: TLV order %d greater than num_of_tlvs:%d for %s:0x%x\n",
+                       __func__, curr_tlv_order, num_tlvs, (is_cmd_id ? "Cmd" : "Evt"), cmd_event_id);
+        return 1;
+    }
+
+    attrib = pAttrs[1 + curr_tlv_order]; // first TLV attributes follow ATTRB0
+    wmi_tlv_print_verbose("%s: WMI TLV attributes for %s:0x%x tlv[%d]:0x%x\n",
+                   __func__, (is_cmd_id ? "Cmd" : "Evt"), cmd_event_id, curr_tlv_order, attrib);
+    tlv_attr_ptr->tag_order = curr_tlv_order;
+    tlv_attr_ptr->tag_id = WMITLV_GET_TAGID(attrib);
+    tlv_attr_ptr->tag_struct_size = WMITLV_GET_TAG_STRUCT_SIZE(attrib);
+    tlv_attr_ptr->tag_varied_size = WMITLV_GET_TAG_VARIED(attrib);
+    tlv_attr_ptr->tag_array_size = WMITLV_GET_TAG_ARRAY_SIZE(attrib);
+    return 0;
+}
+
+/*
+ * WMI TLV Helper functions to find the attributes of the Command/Event TLVs.
+ * Return 0 if success. Return >=1 if failure.
+ */
+A_UINT32 wmitlv_get_attributes(A_UINT32 is_cmd_id, A_UINT32 cmd_event_id, A_UINT32 curr_tlv_order, wmitlv_attributes_struc* tlv_attr_ptr)
+{
+    const A_UINT32 *pAttrs = wmitlv_find_attrib_list(is_cmd_id, cmd_event_id);
+
+    if (pAttrs == NULL)
+    {
+        wmi_tlv_print_error("%s: ERROR: Didn't found WMI TLV attribute definitions for %s:0x%x\n",
+                       __func__, (is_cmd_id ? "Cmd" : "Evt"), cmd_event_id);
+        return 1;
+    }
+
+    return wmitlv_decode_attributes(pAttrs, is_cmd_id, cmd_event_id, curr_tlv_order, tlv_attr_ptr);
 }
 
 /*
@@ -160,13 +243,16 @@ wmitlv_check_tlv_params(
     void *os_handle, void *param_struc_ptr, A_UINT32 param_buf_len, A_UINT32 is_cmd_id, A_UINT32 wmi_cmd_event_id)
 {
     wmitlv_attributes_struc attr_struct_ptr;
+    const A_UINT32 *pAttrs;
     A_UINT32 buf_idx = 0;
     A_UINT32 tlv_index = 0;
     A_UINT8 *buf_ptr = (unsigned char *)param_struc_ptr;
     A_UINT32  expected_num_tlvs, expected_tlv_len;
 
     /* Get the number of TLVs for this command/event */
-    if (wmitlv_get_attributes(is_cmd_id, wmi_cmd_event_id, WMITLV_GET_ATTRIB_NUM_TLVS, &attr_struct_ptr) != 0)
+    pAttrs = wmitlv_find_attrib_list(is_cmd_id, wmi_cmd_event_id);
+    if ((pAttrs == NULL) ||
+        (wmitlv_decode_attributes(pAttrs, is_cmd_id, wmi_cmd_event_id, WMITLV_GET_ATTRIB_NUM_TLVS, &attr_struct_ptr) != 0))
     {
         wmi_tlv_print_error("%s: ERROR: Couldn't get expected number of TLVs for Cmd=%d\n",
                            __func__, wmi_cmd_event_id);
@@ -192,7 +278,7 @@ wmitlv_check_tlv_params(
 
         /* Get the attributes of the TLV with the given order in "tlv_index" */
         wmi_tlv_OS_MEMZERO(&attr_struct_ptr,sizeof(wmitlv_attributes_struc));
-        if (wmitlv_get_attributes(is_cmd_id, wmi_cmd_event_id, tlv_index, &attr_struct_ptr) != 0)
+        if (wmitlv_decode_attributes(pAttrs, is_cmd_id, wmi_cmd_event_id, tlv_index, &attr_struct_ptr) != 0)
         {
             wmi_tlv_print_error("%s: ERROR: No TLV attributes found for Cmd=%d Tag_order=%d\n",
                                __func__, wmi_cmd_event_id, tlv_index);
@@ -357,16 +443,22 @@ wmitlv_check_command_tlv_params(
 }
 
 
+static void wmitlv_free_allocated_tlvs(A_UINT32 is_cmd_id, A_UINT32 cmd_event_id, void *param_tlv_buf, void **wmi_cmd_struct_ptr);
+
 /*
  * Helper Function to vaidate the TLV's coming for an event/command and also pads data to TLV's if necessary
+ * When "param_tlv_buf" is given and is large enough, the base structure of format wmi_cmd_event_id##_param_tlvs
+ * is built in it instead of being allocated. When "num_allocs" is given, it is incremented for every allocation made.
  * Return 0 if success.
               <0 if failure.
  */
 static int
 wmitlv_check_and_pad_tlvs(
-    void *os_handle, void *param_struc_ptr, A_UINT32 param_buf_len, A_UINT32 is_cmd_id, A_UINT32 wmi_cmd_event_id, void **wmi_cmd_struct_ptr)
+    void *os_handle, void *param_struc_ptr, A_UINT32 param_buf_len, A_UINT32 is_cmd_id, A_UINT32 wmi_cmd_event_id,
+    void *param_tlv_buf, A_UINT32 param_tlv_buf_len, A_UINT32 *num_allocs, void **wmi_cmd_struct_ptr)
 {
     wmitlv_attributes_struc attr_struct_ptr;
+    const A_UINT32 *pAttrs;
     A_UINT32 buf_idx = 0;
     A_UINT32 tlv_index = 0;
     A_UINT32 num_of_elems = 0;
@@ -377,7 +469,9 @@ wmitlv_check_and_pad_tlvs(
     A_UINT32 len_wmi_cmd_struct_buf;
 
     /* Get the number of TLVs for this command/event */
-    if (wmitlv_get_attributes(is_cmd_id, wmi_cmd_event_id, WMITLV_GET_ATTRIB_NUM_TLVS, &attr_struct_ptr) != 0)
+    pAttrs = wmitlv_find_attrib_list(is_cmd_id, wmi_cmd_event_id);
+    if ((pAttrs == NULL) ||
+        (wmitlv_decode_attributes(pAttrs, is_cmd_id, wmi_cmd_event_id, WMITLV_GET_ATTRIB_NUM_TLVS, &attr_struct_ptr) != 0))
     {
         wmi_tlv_print_error("%s: ERROR: Couldn't get expected number of TLVs for Cmd=%d\n",
                            __func__, wmi_cmd_event_id);
@@ -388,8 +482,20 @@ wmitlv_check_and_pad_tlvs(
     /* Create base structure of format wmi_cmd_event_id##_param_tlvs */
     len_wmi_cmd_struct_buf = attr_struct_ptr.cmd_num_tlv * sizeof(wmitlv_cmd_param_info);
 #ifndef NO_DYNAMIC_MEM_ALLOC
-    /* Dynamic memory allocation supported */
-    wmi_tlv_os_mem_alloc(os_handle, *wmi_cmd_struct_ptr, len_wmi_cmd_struct_buf);
+    if ((param_tlv_buf != NULL) && (len_wmi_cmd_struct_buf <= param_tlv_buf_len))
+    {
+        /* Caller provided buffer is large enough, parse in place */
+        *wmi_cmd_struct_ptr = param_tlv_buf;
+    }
+    else
+    {
+        /* Dynamic memory allocation supported */
+        wmi_tlv_os_mem_alloc(os_handle, *wmi_cmd_struct_ptr, len_wmi_cmd_struct_buf);
+        if (num_allocs != NULL)
+        {
+            (*num_allocs)++;
+        }
+    }
 #else
     /* Dynamic memory allocation is not supported. Use the buffer g_WmiStaticCmdParamInfoBuf, which should be set using wmi_tlv_set_static_param_tlv_buf(),
             for base structure of format wmi_cmd_event_id##_param_tlvs */
@@ -422,7 +528,7 @@ wmitlv_check_and_pad_tlvs(
 
         /* Get the attributes of the TLV with the given order in "tlv_index" */
         wmi_tlv_OS_MEMZERO(&attr_struct_ptr,sizeof(wmitlv_attributes_struc));
-        if (wmitlv_get_attributes(is_cmd_id, wmi_cmd_event_id, tlv_index, &attr_struct_ptr) != 0)
+        if (wmitlv_decode_attributes(pAttrs, is_cmd_id, wmi_cmd_event_id, tlv_index, &attr_struct_ptr) != 0)
         {
             wmi_tlv_print_error("%s: ERROR: No TLV attributes found for Cmd=%d Tag_order=%d\n",
                                __func__, wmi_cmd_event_id, tlv_index);
@@ -534,6 +640,10 @@ wmitlv_check_and_pad_tlvs(
                        __func__, (num_of_elems * attr_struct_ptr.tag_struct_size), curr_tlv_tag);
                 goto Error_wmitlv_check_and_pad_tlvs;
             }
+            if (num_allocs != NULL)
+            {
+                (*num_allocs)++;
+            }
 
             wmi_tlv_OS_MEMZERO(new_tlv_buf, (num_of_elems * attr_struct_ptr.tag_struct_size));
             tlv_buf_ptr = (A_UINT8 *)new_tlv_buf;
@@ -673,6 +783,10 @@ wmitlv_check_and_pad_tlvs(
                        __func__, (curr_tlv_len-tlv_size_diff), curr_tlv_tag);
                 goto Error_wmitlv_check_and_pad_tlvs;
             }
+            if (num_allocs != NULL)
+            {
+                (*num_allocs)++;
+            }
 
             wmi_tlv_OS_MEMZERO(new_tlv_buf, (curr_tlv_len-tlv_size_diff));
             wmi_tlv_OS_MEMCPY(new_tlv_buf, (void*)buf_ptr, curr_tlv_len);
@@ -713,12 +827,7 @@ wmitlv_check_and_pad_tlvs(
 
     return(0);
 Error_wmitlv_check_and_pad_tlvs:
-    if (is_cmd_id) {
-        wmitlv_free_allocated_command_tlvs(wmi_cmd_event_id, wmi_cmd_struct_ptr);
-    }
-    else {
-        wmitlv_free_allocated_event_tlvs(wmi_cmd_event_id, wmi_cmd_struct_ptr);
-    }
+    wmitlv_free_allocated_tlvs(is_cmd_id, wmi_cmd_event_id, param_tlv_buf, wmi_cmd_struct_ptr);
     *wmi_cmd_struct_ptr = NULL;
     return(-1);
 }
@@ -733,7 +842,25 @@ wmitlv_check_and_pad_event_tlvs(
     void *os_handle, void *param_struc_ptr, A_UINT32 param_buf_len, A_UINT32 wmi_cmd_event_id, void **wmi_cmd_struct_ptr)
 {
     A_UINT32 is_cmd_id = 0;
-    return(wmitlv_check_and_pad_tlvs(os_handle,param_struc_ptr,param_buf_len,is_cmd_id,wmi_cmd_event_id,wmi_cmd_struct_ptr));
+    return(wmitlv_check_and_pad_tlvs(os_handle,param_struc_ptr,param_buf_len,is_cmd_id,wmi_cmd_event_id,NULL,0,NULL,wmi_cmd_struct_ptr));
+}
+
+/*
+ * Helper Function to validate and pad(if necessary) for incoming WMI Event TLVs, parsing the TLVs in place into the
+ * caller provided "param_tlv_buf". Memory is only allocated if the buffer is too small for the event or if a TLV has
+ * to be padded; "num_allocs" (if not NULL) is incremented for every allocation. The result has to be released with
+ * wmitlv_free_prealloc_event_tlvs().
+ * Return 0 if success.
+              <0 if failure.
+ */
+int
+wmitlv_check_and_pad_event_tlvs_prealloc(
+    void *os_handle, void *param_struc_ptr, A_UINT32 param_buf_len, A_UINT32 wmi_cmd_event_id,
+    void *param_tlv_buf, A_UINT32 param_tlv_buf_len, A_UINT32 *num_allocs, void **wmi_cmd_struct_ptr)
+{
+    A_UINT32 is_cmd_id = 0;
+    return(wmitlv_check_and_pad_tlvs(os_handle,param_struc_ptr,param_buf_len,is_cmd_id,wmi_cmd_event_id,
+                                     param_tlv_buf,param_tlv_buf_len,num_allocs,wmi_cmd_struct_ptr));
 }
 
 /*
@@ -746,14 +873,14 @@ wmitlv_check_and_pad_command_tlvs(
     void *os_handle, void *param_struc_ptr, A_UINT32 param_buf_len, A_UINT32 wmi_cmd_event_id, void **wmi_cmd_struct_ptr)
 {
     A_UINT32 is_cmd_id = 1;
-    return(wmitlv_check_and_pad_tlvs(os_handle,param_struc_ptr,param_buf_len,is_cmd_id,wmi_cmd_event_id,wmi_cmd_struct_ptr));
+    return(wmitlv_check_and_pad_tlvs(os_handle,param_struc_ptr,param_buf_len,is_cmd_id,wmi_cmd_event_id,NULL,0,NULL,wmi_cmd_struct_ptr));
 }
 
 /*
  * Helper Function to free any allocated buffers for WMI Event/Command TLV processing
  * Return None
  */
-static void wmitlv_free_allocated_tlvs(A_UINT32 is_cmd_id, A_UINT32 cmd_event_id, void **wmi_cmd_struct_ptr)
+static void wmitlv_free_allocated_tlvs(A_UINT32 is_cmd_id, A_UINT32 cmd_event_id, void *param_tlv_buf, void **wmi_cmd_struct_ptr)
 {
     void *ptr = *wmi_cmd_struct_ptr;
 
@@ -800,7 +927,11 @@ static void wmitlv_free_allocated_tlvs(A_UINT32 is_cmd_id, A_UINT32 cmd_event_id
         }
     }
 
-    wmi_tlv_os_mem_free(*wmi_cmd_struct_ptr);
+    /* The base structure is only freed if it was not built in a caller provided buffer */
+    if (*wmi_cmd_struct_ptr != param_tlv_buf)
+    {
+        wmi_tlv_os_mem_free(*wmi_cmd_struct_ptr);
+    }
     *wmi_cmd_struct_ptr = NULL;
 #endif
 
@@ -813,7 +944,7 @@ static void wmitlv_free_allocated_tlvs(A_UINT32 is_cmd_id, A_UINT32 cmd_event_id
  */
 void wmitlv_free_allocated_command_tlvs(A_UINT32 cmd_event_id, void **wmi_cmd_struct_ptr)
 {
-    wmitlv_free_allocated_tlvs(1, cmd_event_id, wmi_cmd_struct_ptr);
+    wmitlv_free_allocated_tlvs(1, cmd_event_id, NULL, wmi_cmd_struct_ptr);
 }
 
 /*
@@ -822,7 +953,17 @@ void wmitlv_free_allocated_command_tlvs(A_UINT32 cmd_event_id, void **wmi_cmd_st
  */
 void wmitlv_free_allocated_event_tlvs(A_UINT32 cmd_event_id, void **wmi_cmd_struct_ptr)
 {
-    wmitlv_free_allocated_tlvs(0, cmd_event_id, wmi_cmd_struct_ptr);
+    wmitlv_free_allocated_tlvs(0, cmd_event_id, NULL, wmi_cmd_struct_ptr);
+}
+
+/*
+ * Helper Function to free any allocated buffers for WMI Event TLVs parsed by
+ * wmitlv_check_and_pad_event_tlvs_prealloc() into "param_tlv_buf"
+ * Return None
+ */
+void wmitlv_free_prealloc_event_tlvs(A_UINT32 cmd_event_id, void *param_tlv_buf, void **wmi_cmd_struct_ptr)
+{
+    wmitlv_free_allocated_tlvs(0, cmd_event_id, param_tlv_buf, wmi_cmd_struct_ptr);
 }
 
 /*
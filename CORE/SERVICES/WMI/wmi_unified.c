@@ -1049,6 +1049,163 @@ end:
 }
 #endif /* 0 */
 
+/**
+ * wmi_check_and_pad_event() - validate and parse the TLVs of a WMI event
+ * @wmi_handle: handle to WMI
+ * @ctx: context the event is processed in
+ * @id: WMI event id
+ * @data: event TLVs
+ * @len: length of @data
+ * @wmi_cmd_struct_ptr: filled with the parsed param_tlvs structure
+ *
+ * The TLVs are parsed in place into the param buffer of @ctx, so memory is
+ * only allocated when a TLV needs padding. The result has to be released
+ * with wmi_free_event_tlvs().
+ *
+ * Return: 0 on success, negative value on failure.
+ */
+static int wmi_check_and_pad_event(struct wmi_unified *wmi_handle,
+				   enum wmi_rx_ctx ctx, u_int32_t id,
+				   u_int8_t *data, u_int32_t len,
+				   void **wmi_cmd_struct_ptr)
+{
+	struct wmi_rx_param_stats *stats = &wmi_handle->rx_param_stats[ctx];
+	u_int32_t allocs = stats->allocs;
+	int ret;
+
+	stats->events++;
+	ret = wmitlv_check_and_pad_event_tlvs_prealloc(wmi_handle->scn_handle,
+					data, len, id,
+					&wmi_handle->rx_param_buf[ctx],
+					sizeof(wmi_handle->rx_param_buf[ctx]),
+					&stats->allocs, wmi_cmd_struct_ptr);
+	if (stats->allocs != allocs)
+		stats->misses++;
+	return ret;
+}
+
+/**
+ * wmi_free_event_tlvs() - release an event parsed by wmi_check_and_pad_event
+ * @wmi_handle: handle to WMI
+ * @ctx: context the event was processed in
+ * @id: WMI event id
+ * @wmi_cmd_struct_ptr: parsed param_tlvs structure
+ *
+ * Return: none
+ */
+static void wmi_free_event_tlvs(struct wmi_unified *wmi_handle,
+				enum wmi_rx_ctx ctx, u_int32_t id,
+				void **wmi_cmd_struct_ptr)
+{
+	wmitlv_free_prealloc_event_tlvs(id, &wmi_handle->rx_param_buf[ctx],
+					wmi_cmd_struct_ptr);
+}
+
+/**
+ * wmi_rx_event_get_class() - get the priority class of a WMI event
+ * @wmi_handle: handle to WMI
+ * @id: WMI event id
+ *
+ * Must be called with eventq_lock held.
+ *
+ * Return: priority class the event is queued with
+ */
+static enum wmi_rx_event_class
+wmi_rx_event_get_class(struct wmi_unified *wmi_handle, u_int32_t id)
+{
+	u_int32_t i;
+
+	for (i = 0; i < wmi_handle->num_event_class_map; i++) {
+		if (wmi_handle->event_class_map[i].event_id == id)
+			return wmi_handle->event_class_map[i].evt_class;
+	}
+	return WMI_RX_EVENT_CLASS_NORMAL;
+}
+
+/**
+ * wmi_rx_event_enqueue() - queue a WMI event for the rx work
+ * @wmi_handle: handle to WMI
+ * @evt_buf: event buffer, still starting with the WMI header
+ * @id: WMI event id
+ *
+ * Return: none
+ */
+static void wmi_rx_event_enqueue(struct wmi_unified *wmi_handle,
+				 wmi_buf_t evt_buf, u_int32_t id)
+{
+	enum wmi_rx_event_class evt_class;
+	struct wmi_rx_event_class_stats *stats;
+
+	adf_nbuf_set_timestamp(evt_buf);
+
+	adf_os_spin_lock_bh(&wmi_handle->eventq_lock);
+	evt_class = wmi_rx_event_get_class(wmi_handle, id);
+	adf_nbuf_queue_add(&wmi_handle->event_queue[evt_class], evt_buf);
+	stats = &wmi_handle->rx_event_stats[evt_class];
+	stats->queued++;
+	if (++stats->depth > stats->max_depth)
+		stats->max_depth = stats->depth;
+	adf_os_spin_unlock_bh(&wmi_handle->eventq_lock);
+
+	if (wmi_handle->rx_event_wq)
+		queue_work(wmi_handle->rx_event_wq, &wmi_handle->rx_event_work);
+	else
+		schedule_work(&wmi_handle->rx_event_work);
+}
+
+/**
+ * wmi_rx_event_dequeue() - take the next WMI event for the rx work
+ * @wmi_handle: handle to WMI
+ * @evt_class: filled with the priority class of the event
+ *
+ * Events of a higher priority class are always returned first.
+ *
+ * Return: event buffer, or NULL if no event is queued
+ */
+static wmi_buf_t wmi_rx_event_dequeue(struct wmi_unified *wmi_handle,
+				      enum wmi_rx_event_class *evt_class)
+{
+	wmi_buf_t buf = NULL;
+	int i;
+
+	adf_os_spin_lock_bh(&wmi_handle->eventq_lock);
+	for (i = 0; i < WMI_RX_EVENT_CLASS_MAX; i++) {
+		buf = adf_nbuf_queue_remove(&wmi_handle->event_queue[i]);
+		if (buf) {
+			wmi_handle->rx_event_stats[i].depth--;
+			*evt_class = i;
+			break;
+		}
+	}
+	adf_os_spin_unlock_bh(&wmi_handle->eventq_lock);
+	return buf;
+}
+
+/**
+ * wmi_rx_event_update_latency() - account the queueing latency of an event
+ * @wmi_handle: handle to WMI
+ * @evt_class: priority class the event was queued with
+ * @evt_buf: event buffer, still starting with the WMI header
+ *
+ * Return: none
+ */
+static void wmi_rx_event_update_latency(struct wmi_unified *wmi_handle,
+					enum wmi_rx_event_class evt_class,
+					wmi_buf_t evt_buf)
+{
+	struct wmi_rx_event_class_stats *stats =
+				&wmi_handle->rx_event_stats[evt_class];
+	u_int32_t latency_us = adf_nbuf_get_timedelta_us(evt_buf);
+
+	stats->processed++;
+	stats->total_latency_us += latency_us;
+	if (latency_us > stats->max_latency_us) {
+		stats->max_latency_us = latency_us;
+		stats->max_latency_id = WMI_GET_FIELD(adf_nbuf_data(evt_buf),
+						      WMI_CMD_HDR, COMMANDID);
+	}
+}
+
 /*
  * Temporarily added to support older WMI events. We should move all events to unified
  * when the target is ready to support it.
@@ -1075,9 +1232,8 @@ void wmi_control_rx(void *ctx, HTC_PACKET *htc_packet)
 
 		data = adf_nbuf_data(evt_buf);
 		len = adf_nbuf_len(evt_buf);
-		tlv_ok_status = wmitlv_check_and_pad_event_tlvs(
-					wmi_handle->scn_handle,
-					data, len, id,
+		tlv_ok_status = wmi_check_and_pad_event(wmi_handle,
+					WMI_RX_CTX_TASKLET, id, data, len,
 					&wmi_cmd_struct_ptr);
 		if (tlv_ok_status != 0) {
 			WMA_LOGE("Error: id=0x%x, wmitlv_check_and_pad_tlvs ret=%d",
@@ -1087,14 +1243,15 @@ void wmi_control_rx(void *ctx, HTC_PACKET *htc_packet)
 
 		idx = wmi_unified_get_event_handler_ix(wmi_handle, id);
 		if (idx == -1) {
-			wmitlv_free_allocated_event_tlvs(id,
-				&wmi_cmd_struct_ptr);
+			wmi_free_event_tlvs(wmi_handle, WMI_RX_CTX_TASKLET,
+					    id, &wmi_cmd_struct_ptr);
 			adf_nbuf_free(evt_buf);
 			return;
 		}
 		wmi_handle->event_handler[idx](wmi_handle->scn_handle,
 			       wmi_cmd_struct_ptr, len);
-		wmitlv_free_allocated_event_tlvs(id, &wmi_cmd_struct_ptr);
+		wmi_free_event_tlvs(wmi_handle, WMI_RX_CTX_TASKLET, id,
+				    &wmi_cmd_struct_ptr);
 		adf_nbuf_free(evt_buf);
 		return;
 	}
@@ -1108,10 +1265,7 @@ void wmi_control_rx(void *ctx, HTC_PACKET *htc_packet)
 	WMI_RX_EVENT_RECORD(id, ((u_int8_t *)data + 4));
 	adf_os_spin_unlock_bh(&wmi_handle->wmi_record_lock);
 #endif
-	adf_os_spin_lock_bh(&wmi_handle->eventq_lock);
-	adf_nbuf_queue_add(&wmi_handle->event_queue, evt_buf);
-	adf_os_spin_unlock_bh(&wmi_handle->eventq_lock);
-	schedule_work(&wmi_handle->rx_event_work);
+	wmi_rx_event_enqueue(wmi_handle, evt_buf, id);
 }
 
 void __wmi_control_rx(struct wmi_unified *wmi_handle, wmi_buf_t evt_buf)
@@ -1131,9 +1285,9 @@ void __wmi_control_rx(struct wmi_unified *wmi_handle, wmi_buf_t evt_buf)
 	len = adf_nbuf_len(evt_buf);
 
 	/* Validate and pad(if necessary) the TLVs */
-	tlv_ok_status = wmitlv_check_and_pad_event_tlvs(wmi_handle->scn_handle,
-							data, len, id,
-							&wmi_cmd_struct_ptr);
+	tlv_ok_status = wmi_check_and_pad_event(wmi_handle, WMI_RX_CTX_WORK,
+						id, data, len,
+						&wmi_cmd_struct_ptr);
 	if (tlv_ok_status != 0) {
 			pr_err("%s: Error: id=0x%d, wmitlv_check_and_pad_tlvs ret=%d\n",
 				__func__, id, tlv_ok_status);
@@ -1190,7 +1344,8 @@ void __wmi_control_rx(struct wmi_unified *wmi_handle, wmi_buf_t evt_buf)
 		break;
 	}
 end:
-	wmitlv_free_allocated_event_tlvs(id, &wmi_cmd_struct_ptr);
+	wmi_free_event_tlvs(wmi_handle, WMI_RX_CTX_WORK, id,
+			    &wmi_cmd_struct_ptr);
 	adf_nbuf_free(evt_buf);
 }
 
@@ -1198,19 +1353,180 @@ void __wmi_rx_event_work(struct work_struct *work)
 {
 	struct wmi_unified *wmi = container_of(work, struct wmi_unified,
 					       rx_event_work);
+	enum wmi_rx_event_class evt_class;
 	wmi_buf_t buf;
 
-	adf_os_spin_lock_bh(&wmi->eventq_lock);
-	buf = adf_nbuf_queue_remove(&wmi->event_queue);
-	adf_os_spin_unlock_bh(&wmi->eventq_lock);
-	while (buf) {
+	while ((buf = wmi_rx_event_dequeue(wmi, &evt_class)) != NULL) {
+		wmi_rx_event_update_latency(wmi, evt_class, buf);
 		__wmi_control_rx(wmi, buf);
-		adf_os_spin_lock_bh(&wmi->eventq_lock);
-		buf = adf_nbuf_queue_remove(&wmi->event_queue);
-		adf_os_spin_unlock_bh(&wmi->eventq_lock);
 	}
 }
 
+/*
+ * Events a vdev state machine consumes in sequence. The firmware sends them
+ * in order for a vdev, so they must share one class: a VDEV_STOPPED in a
+ * higher class than the VDEV_START_RESP before it would overtake it.
+ */
+static const WMI_EVT_ID wmi_vdev_state_events[] = {
+	WMI_VDEV_START_RESP_EVENTID,
+	WMI_VDEV_STOPPED_EVENTID,
+	WMI_VDEV_DELETE_RESP_EVENTID,
+};
+
+static const WMI_EVT_ID wmi_roam_events[] = {
+	WMI_ROAM_SYNCH_EVENTID,
+	WMI_ROAM_EVENTID,
+};
+
+/**
+ * wmi_set_event_class_locked() - map one WMI event to a priority class
+ * @wmi_handle: handle to WMI
+ * @event_id: WMI event id
+ * @evt_class: priority class of the event
+ *
+ * Must be called with eventq_lock held.
+ *
+ * Return: 0 on success, -ENOMEM if the class map is full
+ */
+static int wmi_set_event_class_locked(struct wmi_unified *wmi_handle,
+				      WMI_EVT_ID event_id,
+				      enum wmi_rx_event_class evt_class)
+{
+	u_int32_t i;
+
+	for (i = 0; i < wmi_handle->num_event_class_map; i++) {
+		if (wmi_handle->event_class_map[i].event_id == event_id)
+			break;
+	}
+	if (i < wmi_handle->num_event_class_map) {
+		wmi_handle->event_class_map[i].evt_class = evt_class;
+	} else if (i < WMI_RX_EVENT_CLASS_MAP_MAX) {
+		wmi_handle->event_class_map[i].event_id = event_id;
+		wmi_handle->event_class_map[i].evt_class = evt_class;
+		wmi_handle->num_event_class_map++;
+	} else {
+		return -ENOMEM;
+	}
+	return 0;
+}
+
+int wmi_unified_set_event_class(wmi_unified_t wmi_handle, WMI_EVT_ID event_id,
+				enum wmi_rx_event_class evt_class)
+{
+	u_int32_t i;
+	bool vdev_state = false;
+	int ret = 0;
+
+	if (evt_class >= WMI_RX_EVENT_CLASS_MAX)
+		return -EINVAL;
+
+	for (i = 0; i < ARRAY_SIZE(wmi_vdev_state_events); i++) {
+		if (wmi_vdev_state_events[i] == event_id)
+			vdev_state = true;
+	}
+
+	adf_os_spin_lock_bh(&wmi_handle->eventq_lock);
+	if (vdev_state) {
+		for (i = 0; !ret && i < ARRAY_SIZE(wmi_vdev_state_events); i++)
+			ret = wmi_set_event_class_locked(wmi_handle,
+						wmi_vdev_state_events[i],
+						evt_class);
+	} else {
+		ret = wmi_set_event_class_locked(wmi_handle, event_id,
+						 evt_class);
+	}
+	adf_os_spin_unlock_bh(&wmi_handle->eventq_lock);
+
+	if (ret)
+		pr_err("%s: no room to map event 0x%x to class %d\n",
+		       __func__, event_id, evt_class);
+	return ret;
+}
+
+void wmi_unified_set_event_prio(wmi_unified_t wmi_handle, u_int32_t groups)
+{
+	u_int32_t i;
+
+	/* drop the previous mapping, unmapped events are NORMAL */
+	adf_os_spin_lock_bh(&wmi_handle->eventq_lock);
+	wmi_handle->num_event_class_map = 0;
+	adf_os_spin_unlock_bh(&wmi_handle->eventq_lock);
+
+	if (groups & WMI_RX_EVENT_PRIO_ROAM) {
+		for (i = 0; i < ARRAY_SIZE(wmi_roam_events); i++)
+			wmi_unified_set_event_class(wmi_handle,
+						    wmi_roam_events[i],
+						    WMI_RX_EVENT_CLASS_HIGH);
+	}
+	if (groups & WMI_RX_EVENT_PRIO_VDEV)
+		wmi_unified_set_event_class(wmi_handle,
+					    WMI_VDEV_STOPPED_EVENTID,
+					    WMI_RX_EVENT_CLASS_HIGH);
+}
+
+/**
+ * wmi_rx_event_stats_print() - print the WMI rx event queue stats
+ * @wmi_handle: handle to WMI
+ * @level: trace level to print at
+ *
+ * Return: none
+ */
+static void wmi_rx_event_stats_print(wmi_unified_t wmi_handle,
+				     VOS_TRACE_LEVEL level)
+{
+	struct wmi_rx_event_class_stats *stats;
+	struct wmi_rx_param_stats *param_stats;
+	u_int64_t avg_latency_us;
+	int i;
+
+	for (i = 0; i < WMI_RX_EVENT_CLASS_MAX; i++) {
+		stats = &wmi_handle->rx_event_stats[i];
+		avg_latency_us = stats->total_latency_us;
+		if (stats->processed)
+			do_div(avg_latency_us, stats->processed);
+		VOS_TRACE(VOS_MODULE_ID_WDA, level,
+			  "WMI rx class %d: queued %u processed %u depth %u max depth %u avg latency %llu us max latency %u us (event 0x%x)",
+			  i, stats->queued, stats->processed, stats->depth,
+			  stats->max_depth, avg_latency_us,
+			  stats->max_latency_us, stats->max_latency_id);
+	}
+	for (i = 0; i < WMI_RX_CTX_MAX; i++) {
+		param_stats = &wmi_handle->rx_param_stats[i];
+		VOS_TRACE(VOS_MODULE_ID_WDA, level,
+			  "WMI rx param buf %s: events %u hits %u misses %u allocs %u",
+			  i == WMI_RX_CTX_TASKLET ? "tasklet" : "work",
+			  param_stats->events,
+			  param_stats->events - param_stats->misses,
+			  param_stats->misses, param_stats->allocs);
+	}
+}
+
+void wmi_unified_display_rx_event_stats(wmi_unified_t wmi_handle)
+{
+	wmi_rx_event_stats_print(wmi_handle, VOS_TRACE_LEVEL_ERROR);
+}
+
+void wmi_unified_clear_rx_event_stats(wmi_unified_t wmi_handle)
+{
+	struct wmi_rx_event_class_stats *stats;
+	int i;
+
+	adf_os_spin_lock_bh(&wmi_handle->eventq_lock);
+	for (i = 0; i < WMI_RX_EVENT_CLASS_MAX; i++) {
+		stats = &wmi_handle->rx_event_stats[i];
+		stats->queued = 0;
+		stats->max_depth = stats->depth;
+		stats->processed = 0;
+		stats->total_latency_us = 0;
+		stats->max_latency_us = 0;
+		stats->max_latency_id = 0;
+	}
+	adf_os_spin_unlock_bh(&wmi_handle->eventq_lock);
+	/* Only updated by their own rx context, a racing event is lost */
+	OS_MEMZERO(wmi_handle->rx_param_stats,
+		   sizeof(wmi_handle->rx_param_stats));
+}
+
 void wmi_rx_event_work(struct work_struct *work)
 {
 	vos_ssr_protect(__func__);
@@ -1224,6 +1540,8 @@ void *
 wmi_unified_attach(ol_scn_t scn_handle, wma_wow_tx_complete_cbk func)
 {
     struct wmi_unified *wmi_handle;
+    int i;
+
     wmi_handle = (struct wmi_unified *)OS_MALLOC(NULL, sizeof(struct wmi_unified), GFP_ATOMIC);
     if (wmi_handle == NULL) {
         printk("allocation of wmi handle failed %zu \n", sizeof(struct wmi_unified));
@@ -1237,8 +1555,15 @@ wmi_unified_attach(ol_scn_t scn_handle, wma_wow_tx_complete_cbk func)
     adf_os_atomic_init(&wmi_handle->runtime_pm_inprogress);
 #endif
     adf_os_spinlock_init(&wmi_handle->eventq_lock);
-    adf_nbuf_queue_init(&wmi_handle->event_queue);
+    for (i = 0; i < WMI_RX_EVENT_CLASS_MAX; i++)
+        adf_nbuf_queue_init(&wmi_handle->event_queue[i]);
     vos_init_work(&wmi_handle->rx_event_work, wmi_rx_event_work);
+    /* Keep event processing off the shared system workqueue */
+    wmi_handle->rx_event_wq = alloc_ordered_workqueue("wmi_rx_event",
+                                                      WQ_HIGHPRI);
+    if (!wmi_handle->rx_event_wq)
+        pr_err("%s: failed to create WMI rx workqueue, using system workqueue\n",
+               __func__);
 #ifdef WMI_INTERFACE_EVENT_LOGGING
     adf_os_spinlock_init(&wmi_handle->wmi_record_lock);
 #endif
@@ -1250,12 +1575,18 @@ void
 wmi_unified_detach(struct wmi_unified* wmi_handle)
 {
 	wmi_buf_t buf;
+	int i;
 
 	vos_flush_work(&wmi_handle->rx_event_work);
-	buf = adf_nbuf_queue_remove(&wmi_handle->event_queue);
-	while (buf) {
-		adf_nbuf_free(buf);
-		buf = adf_nbuf_queue_remove(&wmi_handle->event_queue);
+	if (wmi_handle->rx_event_wq)
+		destroy_workqueue(wmi_handle->rx_event_wq);
+	wmi_rx_event_stats_print(wmi_handle, VOS_TRACE_LEVEL_DEBUG);
+	for (i = 0; i < WMI_RX_EVENT_CLASS_MAX; i++) {
+		buf = adf_nbuf_queue_remove(&wmi_handle->event_queue[i]);
+		while (buf) {
+			adf_nbuf_free(buf);
+			buf = adf_nbuf_queue_remove(&wmi_handle->event_queue[i]);
+		}
 	}
 
 	OS_FREE(wmi_handle);
@@ -1276,15 +1607,19 @@ void
 wmi_unified_remove_work(struct wmi_unified* wmi_handle)
 {
 	wmi_buf_t buf;
+	int i;
 
 	VOS_TRACE( VOS_MODULE_ID_WDA, VOS_TRACE_LEVEL_INFO,
 		"Enter: %s", __func__);
 	vos_flush_work(&wmi_handle->rx_event_work);
 	adf_os_spin_lock_bh(&wmi_handle->eventq_lock);
-	buf = adf_nbuf_queue_remove(&wmi_handle->event_queue);
-	while (buf) {
-		adf_nbuf_free(buf);
-		buf = adf_nbuf_queue_remove(&wmi_handle->event_queue);
+	for (i = 0; i < WMI_RX_EVENT_CLASS_MAX; i++) {
+		buf = adf_nbuf_queue_remove(&wmi_handle->event_queue[i]);
+		while (buf) {
+			adf_nbuf_free(buf);
+			buf = adf_nbuf_queue_remove(&wmi_handle->event_queue[i]);
+		}
+		wmi_handle->rx_event_stats[i].depth = 0;
 	}
 	adf_os_spin_unlock_bh(&wmi_handle->eventq_lock);
 	VOS_TRACE( VOS_MODULE_ID_WDA, VOS_TRACE_LEVEL_INFO,
@@ -35,6 +35,7 @@
 #include "a_types.h"
 #include "wmi.h"
 #include "wmi_unified.h"
+#include "wmi_unified_api.h"
 #include "adf_os_atomic.h"
 
 #define WMI_UNIFIED_MAX_EVENT 0x100
@@ -66,9 +67,54 @@ struct fwdebug {
        struct sk_buff_head fwlog_queue;
        struct completion fwlog_completion;
        A_BOOL fwlog_open;
+       A_UINT32 fwlog_records;      /* buffers queued for the reader */
+       A_UINT32 fwlog_fw_dropped;   /* buffers dropped by the firmware */
+       A_UINT32 fwlog_host_dropped; /* buffers dropped before being read */
 };
 #endif /* WLAN_OPEN_SOURCE */
 
+/*
+ * Large enough for the param_tlvs structure of any WMI event, so that events
+ * can be parsed in place without allocating the structure.
+ */
+#define WMI_EVT_PARAM_TLVS_MEMBER(id) \
+	WMITLV_TYPEDEF_STRUCT_PARAMS_TLVS(id) id##_param;
+
+typedef union {
+	WMITLV_ALL_EVT_LIST(WMI_EVT_PARAM_TLVS_MEMBER)
+} wmi_evt_param_tlvs_buf;
+
+/* Contexts WMI events are processed in, each with its own param buffer */
+enum wmi_rx_ctx {
+	WMI_RX_CTX_TASKLET,
+	WMI_RX_CTX_WORK,
+	WMI_RX_CTX_MAX,
+};
+
+/* Max number of events mapped to a non default priority class */
+#define WMI_RX_EVENT_CLASS_MAP_MAX 16
+
+struct wmi_rx_event_class_map {
+	WMI_EVT_ID event_id;
+	enum wmi_rx_event_class evt_class;
+};
+
+struct wmi_rx_event_class_stats {
+	u_int32_t queued;           /* events queued */
+	u_int32_t depth;            /* events currently queued */
+	u_int32_t max_depth;        /* high watermark of depth */
+	u_int32_t processed;        /* events taken off the queue */
+	u_int64_t total_latency_us; /* queued to processing, all events */
+	u_int32_t max_latency_us;   /* queued to processing, worst event */
+	WMI_EVT_ID max_latency_id;  /* event with the worst latency */
+};
+
+struct wmi_rx_param_stats {
+	u_int32_t events; /* events parsed */
+	u_int32_t misses; /* events that needed an allocation */
+	u_int32_t allocs; /* allocations made while parsing them */
+};
+
 struct wmi_unified {
 	ol_scn_t scn_handle; /* handle to device */
 	adf_os_atomic_t pending_cmds;
@@ -79,8 +125,12 @@ struct wmi_unified {
 	u_int32_t max_event_idx;
 	void *htc_handle;
 	adf_os_spinlock_t eventq_lock;
-	adf_nbuf_queue_t event_queue;
+	adf_nbuf_queue_t event_queue[WMI_RX_EVENT_CLASS_MAX];
 	struct work_struct rx_event_work;
+	struct workqueue_struct *rx_event_wq;
+	struct wmi_rx_event_class_map event_class_map[WMI_RX_EVENT_CLASS_MAP_MAX];
+	u_int32_t num_event_class_map;
+	struct wmi_rx_event_class_stats rx_event_stats[WMI_RX_EVENT_CLASS_MAX];
 #ifdef WLAN_OPEN_SOURCE
        struct fwdebug dbglog;
        struct dentry *debugfs_phy;
@@ -97,5 +147,7 @@ struct wmi_unified {
 	bool tgt_force_assert_enable;
 	A_BOOL tag_crash_inject;
 	void (*wma_wow_tx_complete_cbk)(ol_scn_t scn_handle);
+	wmi_evt_param_tlvs_buf rx_param_buf[WMI_RX_CTX_MAX];
+	struct wmi_rx_param_stats rx_param_stats[WMI_RX_CTX_MAX];
 };
 #endif
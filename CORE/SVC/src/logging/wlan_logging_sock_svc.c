@@ -89,6 +89,11 @@ static uint8_t grx_count;
 #define HOST_LOG_PER_PKT_STATS     0x002
 #define HOST_LOG_FW_FLUSH_COMPLETE 0x003
 
+/* Wake the logger thread once this fraction of the buffers is filled */
+#define LOGGER_WAKE_THRESHOLD_DIV  4
+/* Upper bound on how long the first filled buffer waits to be sent */
+#define LOGGER_MAX_WAIT_MS         100
+
 #define DIAG_TYPE_LOGS   1
 #define PTT_MSG_DIAG_CMDS_TYPE   0x5050
 struct log_msg {
@@ -98,10 +103,16 @@ struct log_msg {
 	/* indicates the current filled log length in logbuf */
 	unsigned int filled_length;
 	/*
-	 * Buf to hold the log msg
+	 * Netlink skb the log is written into, so that it can be handed
+	 * to the netlink layer without copying.
+	 */
+	struct sk_buff *skb;
+	/*
+	 * Buf to hold the log msg, points at the tAniNlHdr wmsg field
+	 * of skb
 	 * tAniHdr + log
 	 */
-	char logbuf[MAX_LOGMSG_LENGTH];
+	char *logbuf;
 };
 
 /**
@@ -153,6 +164,11 @@ struct wlan_logging {
 	bool exit;
 	/* Holds number of dropped logs*/
 	unsigned int drop_count;
+	/* Number of buffers in filled_list and its high watermark */
+	unsigned int filled_count;
+	unsigned int filled_hwm;
+	/* filled_count at which the logger thread is woken up */
+	unsigned int wake_threshold;
 	/* current logbuf to which the log will be filled to */
 	struct log_msg *pcur_node;
 	/* Event flag used for wakeup and post indication*/
@@ -288,6 +304,23 @@ static void clear_default_logtoapp_log_level(void)
 			VOS_FALSE);
 }
 
+/**
+ * wlan_logmsg_attach_skb() - attach a netlink skb to a log buffer
+ * @plog_msg: log buffer
+ * @skb: skb of at least MAX_LOGMSG_LENGTH bytes
+ *
+ * Logs are formatted straight into the payload area of @skb so that the
+ * logger thread only has to prepend the netlink header before sending.
+ *
+ * Return: None
+ */
+static void wlan_logmsg_attach_skb(struct log_msg *plog_msg,
+				   struct sk_buff *skb)
+{
+	plog_msg->skb = skb;
+	plog_msg->logbuf = (char *)skb->data + offsetof(tAniNlHdr, wmsg);
+}
+
 /* Need to call this with spin_lock acquired */
 static int wlan_queue_logmsg_for_app(void)
 {
@@ -302,6 +335,8 @@ static int wlan_queue_logmsg_for_app(void)
 			gwlan_logging.pcur_node->filled_length;
 	list_add_tail(&gwlan_logging.pcur_node->node,
 			&gwlan_logging.filled_list);
+	if (++gwlan_logging.filled_count > gwlan_logging.filled_hwm)
+		gwlan_logging.filled_hwm = gwlan_logging.filled_count;
 
 	if (!list_empty(&gwlan_logging.free_list)) {
 		/* Get buffer from free list */
@@ -316,6 +351,7 @@ static int wlan_queue_logmsg_for_app(void)
 		gwlan_logging.pcur_node =
 			(struct log_msg *)(gwlan_logging.filled_list.next);
 		++gwlan_logging.drop_count;
+		--gwlan_logging.filled_count;
 		list_del_init(gwlan_logging.filled_list.next);
 		ret = 1;
 	}
@@ -325,7 +361,21 @@ static int wlan_queue_logmsg_for_app(void)
 	return ret;
 }
 
-
+/**
+ * wlan_log_to_user() - queue a host log line for the cnss logger
+ * @log_level: trace level of the line
+ * @to_be_sent: formatted line
+ * @length: length of @to_be_sent
+ *
+ * Lines arrive here already formatted by vos_trace_msg() and the other
+ * trace helpers, and the cnss logger daemon reads them as
+ * ANI_NL_MSG_LOG text, so they are kept as text and written once into
+ * the netlink skb of the current buffer. Binary records with format IDs
+ * would need every producer to hand over its format and arguments, and
+ * a reader outside this tree that understands them.
+ *
+ * Return: 0 on success, -EIO if the logging service is not set up
+ */
 int wlan_log_to_user(VOS_TRACE_LEVEL log_level, char *to_be_sent, int length)
 {
 	/* Add the current time stamp */
@@ -335,6 +385,8 @@ int wlan_log_to_user(VOS_TRACE_LEVEL log_level, char *to_be_sent, int length)
 	int total_log_len;
 	unsigned int *pfilled_length;
 	bool wake_up_thread = false;
+	bool threshold_reached = false;
+	bool first_filled = false;
 	unsigned long flags;
 	struct timeval tv;
 	struct rtc_time tm;
@@ -420,15 +472,24 @@ int wlan_log_to_user(VOS_TRACE_LEVEL log_level, char *to_be_sent, int length)
 		ptr[*pfilled_length] = '\n';
 		*pfilled_length += 1;
 
+		threshold_reached = gwlan_logging.filled_count >=
+					gwlan_logging.wake_threshold;
+		first_filled = gwlan_logging.filled_count == 1;
 		spin_unlock_irqrestore(&gwlan_logging.spin_lock, flags);
 
 		/* Wakeup logger thread */
-		if ((true == wake_up_thread)) {
+		if ((true == wake_up_thread) &&
+		    ((true == threshold_reached) || (true == first_filled))) {
 			/* If there is logger app registered wakeup the logging
 			 * thread (or) if always multicasting of host messages
-			 * is enabled, wake up the logging thread
+			 * is enabled, wake up the logging thread. Filled
+			 * buffers are batched until the wake threshold, the
+			 * first one only makes the thread arm its
+			 * LOGGER_MAX_WAIT_MS timeout.
 			 */
-			set_bit(HOST_LOG_DRIVER_MSG, &gwlan_logging.eventFlag);
+			if (true == threshold_reached)
+				set_bit(HOST_LOG_DRIVER_MSG,
+					&gwlan_logging.eventFlag);
 			wake_up_interruptible(&gwlan_logging.wait_queue);
 		}
 
@@ -588,6 +649,7 @@ static int send_filled_buffers_to_user(void)
 	int tot_msg_len;
 	tAniNlHdr *wnl;
 	struct sk_buff *skb = NULL;
+	struct sk_buff *new_skb;
 	struct nlmsghdr *nlh;
 	static int nlmsg_seq;
 	unsigned long flags;
@@ -596,8 +658,12 @@ static int send_filled_buffers_to_user(void)
 	while (!list_empty(&gwlan_logging.filled_list)
 		&& !gwlan_logging.exit) {
 
-		skb = dev_alloc_skb(MAX_LOGMSG_LENGTH);
-		if (skb == NULL) {
+		/*
+		 * The filled buffer's skb is sent as is, so get a
+		 * replacement for it before taking the buffer off the list.
+		 */
+		new_skb = dev_alloc_skb(MAX_LOGMSG_LENGTH);
+		if (new_skb == NULL) {
 			if (!rate_limit) {
 				pr_err("%s: dev_alloc_skb() failed for msg size[%d] drop count = %u\n",
 					__func__, MAX_LOGMSG_LENGTH,
@@ -614,12 +680,15 @@ static int send_filled_buffers_to_user(void)
 		plog_msg = (struct log_msg *)
 			(gwlan_logging.filled_list.next);
 		list_del_init(gwlan_logging.filled_list.next);
+		--gwlan_logging.filled_count;
 		spin_unlock_irqrestore(&gwlan_logging.spin_lock, flags);
 		/* 4 extra bytes for the radio idx */
 		payload_len = plog_msg->filled_length +
 			sizeof(wnl->radio) + sizeof(tAniHdr);
 
 		tot_msg_len = NLMSG_SPACE(payload_len);
+		/* the payload is already in place, this only adds headers */
+		skb = plog_msg->skb;
 		nlh = nlmsg_put(skb, 0, nlmsg_seq++,
 				ANI_NL_MSG_LOG, payload_len,
 				NLM_F_REQUEST);
@@ -633,7 +702,7 @@ static int send_filled_buffers_to_user(void)
 				++gwlan_logging.drop_count);
 			pr_err("%s: nlmsg_put() failed for msg size[%d]\n",
 				__func__, tot_msg_len);
-			dev_kfree_skb(skb);
+			dev_kfree_skb(new_skb);
 			skb = NULL;
 			ret = -EINVAL;
 			continue;
@@ -641,10 +710,8 @@ static int send_filled_buffers_to_user(void)
 
 		wnl = (tAniNlHdr *) nlh;
 		wnl->radio = plog_msg->radio;
-		memcpy(&wnl->wmsg, plog_msg->logbuf,
-				plog_msg->filled_length +
-				sizeof(tAniHdr));
 
+		wlan_logmsg_attach_skb(plog_msg, new_skb);
 		spin_lock_irqsave(&gwlan_logging.spin_lock, flags);
 		list_add_tail(&plog_msg->node,
 				&gwlan_logging.free_list);
@@ -653,8 +720,9 @@ static int send_filled_buffers_to_user(void)
 		ret = nl_srv_bcast(skb);
 		/* print every 64th drop count */
 		if (ret < 0 && (!(gwlan_logging.drop_count % 0x40))) {
-			pr_err("%s: Send Failed %d drop_count = %u\n",
-				__func__, ret, ++gwlan_logging.drop_count);
+			pr_err("%s: Send Failed %d drop_count = %u filled_hwm = %u\n",
+				__func__, ret, ++gwlan_logging.drop_count,
+				gwlan_logging.filled_hwm);
 			skb = NULL;
 		} else {
 			skb = NULL;
@@ -726,6 +794,9 @@ static int wlan_logging_thread(void *Arg)
 	int ret_wait_status = 0;
 	int ret = 0;
 	unsigned long flags;
+	unsigned long deadline = 0;
+	bool deadline_armed = false;
+	bool driver_msg;
 
 	set_user_nice(current, -2);
 
@@ -734,15 +805,43 @@ static int wlan_logging_thread(void *Arg)
 #endif
 
 	while (!gwlan_logging.exit) {
-		ret_wait_status = wait_event_interruptible(
-		    gwlan_logging.wait_queue,
-		    (!list_empty(&gwlan_logging.filled_list)
-		  || test_bit(HOST_LOG_DRIVER_MSG, &gwlan_logging.eventFlag)
-		  || test_bit(HOST_LOG_PER_PKT_STATS,
-		     &gwlan_logging.eventFlag)
-		  || test_bit(HOST_LOG_FW_FLUSH_COMPLETE,
-		     &gwlan_logging.eventFlag)
-		  || gwlan_logging.exit));
+		/*
+		 * Log producers wake this thread when the first buffer is
+		 * filled and again once wake_threshold buffers are filled.
+		 * Only while filled buffers are pending is the wait bounded,
+		 * so that they are sent within LOGGER_MAX_WAIT_MS of the
+		 * first one. An idle logger sleeps until it is woken up.
+		 */
+		if (!list_empty(&gwlan_logging.filled_list)) {
+			if (!deadline_armed) {
+				deadline = jiffies +
+					msecs_to_jiffies(LOGGER_MAX_WAIT_MS);
+				deadline_armed = true;
+			}
+			ret_wait_status = wait_event_interruptible_timeout(
+			    gwlan_logging.wait_queue,
+			    (test_bit(HOST_LOG_DRIVER_MSG,
+			     &gwlan_logging.eventFlag)
+			  || test_bit(HOST_LOG_PER_PKT_STATS,
+			     &gwlan_logging.eventFlag)
+			  || test_bit(HOST_LOG_FW_FLUSH_COMPLETE,
+			     &gwlan_logging.eventFlag)
+			  || gwlan_logging.exit),
+			    time_before(jiffies, deadline) ?
+				deadline - jiffies : 0);
+		} else {
+			deadline_armed = false;
+			ret_wait_status = wait_event_interruptible(
+			    gwlan_logging.wait_queue,
+			    (!list_empty(&gwlan_logging.filled_list)
+			  || test_bit(HOST_LOG_DRIVER_MSG,
+			     &gwlan_logging.eventFlag)
+			  || test_bit(HOST_LOG_PER_PKT_STATS,
+			     &gwlan_logging.eventFlag)
+			  || test_bit(HOST_LOG_FW_FLUSH_COMPLETE,
+			     &gwlan_logging.eventFlag)
+			  || gwlan_logging.exit));
+		}
 
 		if (ret_wait_status == -ERESTARTSYS) {
 			pr_err("%s: wait_event_interruptible returned -ERESTARTSYS",
@@ -754,13 +853,16 @@ static int wlan_logging_thread(void *Arg)
 			break;
 		}
 
-		if (test_and_clear_bit(HOST_LOG_DRIVER_MSG,
-				       &gwlan_logging.eventFlag)) {
+		driver_msg = test_and_clear_bit(HOST_LOG_DRIVER_MSG,
+						&gwlan_logging.eventFlag);
+		if (driver_msg || (deadline_armed &&
+				   !time_before(jiffies, deadline))) {
+			deadline_armed = false;
 			ret = send_filled_buffers_to_user();
 			if (-ENOMEM == ret) {
 				msleep(200);
 			}
-			if (WLAN_LOG_INDICATOR_HOST_ONLY ==
+			if (driver_msg && WLAN_LOG_INDICATOR_HOST_ONLY ==
 						 vos_get_log_indicator()) {
 				send_flush_completion_to_user();
 			}
@@ -872,6 +974,7 @@ int wlan_logging_sock_activate_svc(int log_fe_to_console, int num_buf)
 {
 	int i, j, pkt_stats_size;
 	unsigned long irq_flag;
+	struct sk_buff *skb;
 
 
 	gapp_pid = INVALID_PID;
@@ -885,12 +988,25 @@ int wlan_logging_sock_activate_svc(int log_fe_to_console, int num_buf)
 
 	vos_mem_zero(gplog_msg, (num_buf * sizeof(struct log_msg)));
 
+	for (i = 0; i < num_buf; i++) {
+		skb = dev_alloc_skb(MAX_LOGMSG_LENGTH);
+		if (!skb) {
+			pr_err("%s: Could not allocate log skb\n", __func__);
+			goto err0;
+		}
+		wlan_logmsg_attach_skb(&gplog_msg[i], skb);
+	}
+
 	gwlan_logging.log_fe_to_console = !!log_fe_to_console;
 	gwlan_logging.num_buf = num_buf;
 
 	spin_lock_irqsave(&gwlan_logging.spin_lock, irq_flag);
 	INIT_LIST_HEAD(&gwlan_logging.free_list);
 	INIT_LIST_HEAD(&gwlan_logging.filled_list);
+	gwlan_logging.filled_count = 0;
+	gwlan_logging.filled_hwm = 0;
+	gwlan_logging.wake_threshold =
+		max(num_buf / LOGGER_WAKE_THRESHOLD_DIV, 1);
 
 	for (i = 0; i < num_buf; i++) {
 		list_add(&gplog_msg[i].node, &gwlan_logging.free_list);
@@ -977,6 +1093,11 @@ err1:
 	spin_lock_irqsave(&gwlan_logging.spin_lock, irq_flag);
 	gwlan_logging.pcur_node = NULL;
 	spin_unlock_irqrestore(&gwlan_logging.spin_lock, irq_flag);
+err0:
+	for (i = 0; i < num_buf; i++) {
+		if (gplog_msg[i].skb)
+			dev_kfree_skb(gplog_msg[i].skb);
+	}
 	vfree(gplog_msg);
 	gplog_msg = NULL;
 	return -ENOMEM;
@@ -1007,6 +1128,13 @@ int wlan_logging_sock_deactivate_svc(void)
 	spin_lock_irqsave(&gwlan_logging.spin_lock, irq_flag);
 	gwlan_logging.pcur_node = NULL;
 	spin_unlock_irqrestore(&gwlan_logging.spin_lock, irq_flag);
+	pr_info("%s: drop_count = %u filled_hwm = %u/%d\n", __func__,
+		gwlan_logging.drop_count, gwlan_logging.filled_hwm,
+		gwlan_logging.num_buf);
+	for (i = 0; i < gwlan_logging.num_buf; i++) {
+		if (gplog_msg[i].skb)
+			dev_kfree_skb(gplog_msg[i].skb);
+	}
 	vfree(gplog_msg);
 	gplog_msg = NULL;
 
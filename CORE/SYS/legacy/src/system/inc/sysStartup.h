@@ -50,6 +50,10 @@
 extern void sysMACCleanup(void *);
 extern tSirRetStatus sysBbtProcessMessageCore(struct sAniSirGlobal *, tpSirMsgQ,
                                                tANI_U32, tANI_U32);
+#ifdef WLAN_FEATURE_MGMT_RX_BATCH
+extern tSirRetStatus sysBbtProcessBatchedFrame(struct sAniSirGlobal *, tpSirMsgQ,
+                                               tANI_U32, tANI_U32);
+#endif
 
 
 # endif /* __SYSSTARTUP_H */
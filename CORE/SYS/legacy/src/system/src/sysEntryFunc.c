@@ -108,11 +108,13 @@ sysInitGlobals(tpAniSirGlobal pMac)
  * @param pMsg message pointer
  * @param tANI_U32 type
  * @param tANI_U32 sub type
+ * @param tANI_BOOLEAN inPeCtx - hand frames to LIM directly instead of
+ *                               posting them to the PE queue
  * @return None
  */
-tSirRetStatus
-sysBbtProcessMessageCore(tpAniSirGlobal pMac, tpSirMsgQ pMsg, tANI_U32 type,
-                         tANI_U32 subType)
+static tSirRetStatus
+sysBbtProcessFrame(tpAniSirGlobal pMac, tpSirMsgQ pMsg, tANI_U32 type,
+                   tANI_U32 subType, tANI_BOOLEAN inPeCtx)
 {
     tANI_U32 framecount;
     tSirRetStatus ret;
@@ -190,8 +192,17 @@ sysBbtProcessMessageCore(tpAniSirGlobal pMac, tpSirMsgQ pMsg, tANI_U32 type,
                        pMac->sys.gSysFrameCount[type][subType]);
             }
 
-            //Post the message to PE Queue
-            ret = (tSirRetStatus) limPostMsgApi(pMac, pMsg);
+            /*
+             * Post the message to PE Queue. Frames of a batch are already
+             * being processed from the PE queue, so give them to LIM now.
+             */
+            if (inPeCtx)
+            {
+                limMessageProcessor(pMac, pMsg);
+                ret = eSIR_SUCCESS;
+            }
+            else
+                ret = (tSirRetStatus) limPostMsgApi(pMac, pMsg);
             if (ret != eSIR_SUCCESS)
             {
                 /* Print only one debug failure out of 512 failure messages */
@@ -235,6 +246,39 @@ fail:
     return eSIR_FAILURE;
 }
 
+tSirRetStatus
+sysBbtProcessMessageCore(tpAniSirGlobal pMac, tpSirMsgQ pMsg, tANI_U32 type,
+                         tANI_U32 subType)
+{
+    return sysBbtProcessFrame(pMac, pMsg, type, subType, eANI_BOOLEAN_FALSE);
+}
+
+#ifdef WLAN_FEATURE_MGMT_RX_BATCH
+// ---------------------------------------------------------------------------
+/**
+ * sysBbtProcessBatchedFrame
+ *
+ * FUNCTION:
+ * Process one management frame of a batch received on the PE queue
+ *
+ * LOGIC:
+ * Same checks as sysBbtProcessMessageCore, but the frame goes to LIM
+ * without another trip through the PE queue.
+ *
+ * @param tpAniSirGlobal A pointer to MAC params instance
+ * @param pMsg message pointer
+ * @param tANI_U32 type
+ * @param tANI_U32 sub type
+ * @return None
+ */
+tSirRetStatus
+sysBbtProcessBatchedFrame(tpAniSirGlobal pMac, tpSirMsgQ pMsg, tANI_U32 type,
+                          tANI_U32 subType)
+{
+    return sysBbtProcessFrame(pMac, pMsg, type, subType, eANI_BOOLEAN_TRUE);
+}
+#endif /* WLAN_FEATURE_MGMT_RX_BATCH */
+
 
 void sysLog(tpAniSirGlobal pMac, tANI_U32 loglevel, const char *pString,...)
 {
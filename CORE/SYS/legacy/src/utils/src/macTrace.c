@@ -1011,6 +1011,7 @@ tANI_U8* macTraceGetLimMsgString(tANI_U16 limMsg)
 	{
 	CASE_RETURN_STRING(SIR_LIM_RETRY_INTERRUPT_MSG);
 	CASE_RETURN_STRING(SIR_BB_XPORT_MGMT_MSG );
+	CASE_RETURN_STRING(SIR_BB_XPORT_MGMT_BATCH_MSG);
 	CASE_RETURN_STRING(SIR_LIM_INV_KEY_INTERRUPT_MSG );
 	CASE_RETURN_STRING(SIR_LIM_KEY_ID_INTERRUPT_MSG );
 	CASE_RETURN_STRING(SIR_LIM_REPLAY_THRES_INTERRUPT_MSG );
@@ -541,6 +541,65 @@ typedef void (*WLANTL_TxFlowControlCBType)(void *adapterCtxt,
 typedef VOS_STATUS (*WLANTL_MgmtFrmRxCBType)( v_PVOID_t  pvosGCtx,
                                               v_PVOID_t  vosBuff);
 
+#ifdef WLAN_FEATURE_MGMT_RX_BATCH
+/* Number of frames held by one chunk of a management frame batch */
+#define WLANTL_MGMT_RX_BATCH_CHUNK_SIZE  16
+
+/*----------------------------------------------------------------------------
+
+  DESCRIPTION
+    One chunk of a management frame batch. Chunks are linked in the order
+    the frames were received; uHead is the next frame to hand out.
+
+----------------------------------------------------------------------------*/
+typedef struct sWLANTL_MgmtRxBatchChunk
+{
+  struct sWLANTL_MgmtRxBatchChunk *next;
+  v_U16_t                          uCount;
+  v_U16_t                          uHead;
+  vos_pkt_t                       *frames[WLANTL_MGMT_RX_BATCH_CHUNK_SIZE];
+} WLANTL_MgmtRxBatchChunkType;
+
+/*----------------------------------------------------------------------------
+
+  DESCRIPTION
+    A batch of received management frames handed to PE in one message.
+    The receiver walks it with WLANTL_MgmtRxBatchNext() and releases it
+    with WLANTL_MgmtRxBatchFree().
+
+----------------------------------------------------------------------------*/
+typedef struct
+{
+  WLANTL_MgmtRxBatchChunkType *first;
+  WLANTL_MgmtRxBatchChunkType *last;
+  v_U32_t                      uNumFrames;
+} WLANTL_MgmtRxBatchType;
+
+/*----------------------------------------------------------------------------
+
+  DESCRIPTION
+    Type of the batched receive callback registered with TL for PE.
+
+    TL collects received beacons and probe responses and delivers them to
+    the registered callback as one batch. The callback owns the batch only
+    when it returns VOS_STATUS_SUCCESS. On failure it must leave the batch
+    alone; TL releases it.
+
+  PARAMETERS
+
+    IN
+    pvosGCtx:       pointer to the global vos context; a handle to TL's
+                    control block can be extracted from its context
+    pBatch:         batch of vOSS buffers containing the received frames
+
+  RETURN VALUE
+    The result code associated with performing the operation
+
+----------------------------------------------------------------------------*/
+typedef VOS_STATUS (*WLANTL_MgmtFrmRxBatchCBType)( v_PVOID_t  pvosGCtx,
+                                       WLANTL_MgmtRxBatchType *pBatch);
+#endif /* WLAN_FEATURE_MGMT_RX_BATCH */
+
 
 /*----------------------------------------------------------------------------
     INTERACTION WITH HAL
@@ -1419,6 +1478,115 @@ WLANTL_DeRegisterMgmtFrmClient
   v_PVOID_t               pvosGCtx
 );
 
+#ifdef WLAN_FEATURE_MGMT_RX_BATCH
+/*==========================================================================
+
+  FUNCTION    WLANTL_RegisterMgmtFrmBatchClient
+
+  DESCRIPTION
+    Called by PE to receive beacons and probe responses in batches. Other
+    management frames keep going to the client registered with
+    WLANTL_RegisterMgmtFrmClient, which must be registered first.
+
+  DEPENDENCIES
+    TL must be initialized before this API can be called.
+
+  PARAMETERS
+
+    IN
+    pvosGCtx:           pointer to the global vos context; a handle to
+                        TL's control block can be extracted from its context
+    pfnTlMgmtFrmRxBatch: pointer to the receive processing routine for
+                        batches of management frames
+
+  RETURN VALUE
+    The result code associated with performing the operation
+
+    VOS_STATUS_E_FAILURE: TL shim context is not available
+    VOS_STATUS_SUCCESS:  Everything is good :)
+
+  SIDE EFFECTS
+    Cleared again by WLANTL_DeRegisterMgmtFrmClient.
+
+============================================================================*/
+VOS_STATUS
+WLANTL_RegisterMgmtFrmBatchClient
+(
+  v_PVOID_t                    pvosGCtx,
+  WLANTL_MgmtFrmRxBatchCBType  pfnTlMgmtFrmRxBatch
+);
+
+/*==========================================================================
+
+  FUNCTION    WLANTL_MgmtRxBatchNext
+
+  DESCRIPTION
+    Take the next frame out of a management frame batch, in receive order.
+    The caller owns the returned frame.
+
+  PARAMETERS
+
+    IN
+    pBatch:             batch received by the batched receive callback
+
+  RETURN VALUE
+    The next frame, or NULL once the batch is empty
+
+============================================================================*/
+vos_pkt_t *
+WLANTL_MgmtRxBatchNext
+(
+  WLANTL_MgmtRxBatchType *pBatch
+);
+
+/*==========================================================================
+
+  FUNCTION    WLANTL_MgmtRxBatchFree
+
+  DESCRIPTION
+    Return any frames still held by a management frame batch and free it.
+
+  PARAMETERS
+
+    IN
+    pBatch:             batch received by the batched receive callback
+
+  RETURN VALUE
+    None
+
+============================================================================*/
+v_VOID_t
+WLANTL_MgmtRxBatchFree
+(
+  WLANTL_MgmtRxBatchType *pBatch
+);
+
+/*==========================================================================
+
+  FUNCTION    WLANTL_MgmtRxBatchFlush
+
+  DESCRIPTION
+    Post the pending batch of beacons and probe responses to PE now.
+    Called by WMA before it posts a scan event to PE, so that the frames
+    received on the last channel of a scan are in the PE queue ahead of
+    the event.
+
+  PARAMETERS
+
+    IN
+    pvosGCtx:           pointer to the global vos context
+
+  RETURN VALUE
+    Number of frames posted
+
+============================================================================*/
+v_U32_t
+WLANTL_MgmtRxBatchFlush
+(
+  v_PVOID_t pvosGCtx
+);
+#endif /* WLAN_FEATURE_MGMT_RX_BATCH */
+
 /*==========================================================================
 
   FUNCTION    WLANTL_TxMgmtFrm
@@ -2942,4 +3110,17 @@ VOS_STATUS WLANTL_RegisterOCBPeer(void *vos_ctx, uint8_t *mac_addr,
 void WLANTL_display_datapath_stats(void *vos_ctx, uint16_t bitmap);
 void WLANTL_clear_datapath_stats(void *vos_ctx, uint16_t bitmap);
 
+#ifdef WLAN_FEATURE_MGMT_RX_BATCH
+void WLANTL_display_mgmt_rx_batch_stats(void *vos_ctx);
+void WLANTL_clear_mgmt_rx_batch_stats(void *vos_ctx);
+#else
+static inline void WLANTL_display_mgmt_rx_batch_stats(void *vos_ctx)
+{
+}
+
+static inline void WLANTL_clear_mgmt_rx_batch_stats(void *vos_ctx)
+{
+}
+#endif /* WLAN_FEATURE_MGMT_RX_BATCH */
+
 #endif /* #ifndef WLAN_QCT_WLANTL_H */
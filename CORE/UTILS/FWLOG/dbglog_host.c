@@ -54,6 +54,7 @@
 #define CLD_DEBUGFS_DIR          "cld"
 #endif
 #define DEBUGFS_BLOCK_NAME       "dbglog_block"
+#define DEBUGFS_STATS_NAME       "dbglog_stats"
 
 #define ATH_MODULE_NAME fwlog
 #include <a_debug.h>
@@ -1949,12 +1950,22 @@ dbglog_print_raw_data(A_UINT32 *buffer, A_UINT32 length)
 }
 
 #ifdef WLAN_OPEN_SOURCE
+/*
+ * Queue an undecoded firmware log buffer for the dbglog_block reader.
+ * Once the queue is full the oldest record is evicted and its skb is
+ * reused, so a slow reader costs no allocations; evictions are counted
+ * in fwlog_host_dropped. tools/dbglog_decode formats the records.
+ *
+ * Debug events are delivered from the single WMI event context, so one
+ * queue sees no cross-CPU contention and keeps the records in firmware
+ * order; per-CPU queues would only make the reader merge them again.
+ */
 static int
 dbglog_debugfs_raw_data(wmi_unified_t wmi_handle, const u_int8_t *buf, A_UINT32 length, A_UINT32 dropped)
 {
     struct fwdebug *fwlog = (struct fwdebug *)&wmi_handle->dbglog;
     struct dbglog_slot *slot;
-    struct sk_buff *skb;
+    struct sk_buff *skb = NULL;
     size_t slot_len;
 
     if (WARN_ON(length > ATH6KL_FWLOG_PAYLOAD_SIZE))
@@ -1962,9 +1973,26 @@ dbglog_debugfs_raw_data(wmi_unified_t wmi_handle, const u_int8_t *buf, A_UINT32
 
     slot_len = sizeof(*slot) + ATH6KL_FWLOG_PAYLOAD_SIZE;
 
-    skb = alloc_skb(slot_len, GFP_KERNEL);
-    if (!skb)
-        return -ENOMEM;
+    spin_lock_bh(&fwlog->fwlog_queue.lock);
+    fwlog->fwlog_fw_dropped += dropped;
+    if (skb_queue_len(&fwlog->fwlog_queue) >= ATH6KL_FWLOG_MAX_ENTRIES) {
+        /* drop oldest entry and recycle its buffer */
+        skb = __skb_dequeue(&fwlog->fwlog_queue);
+        fwlog->fwlog_host_dropped++;
+    }
+    spin_unlock_bh(&fwlog->fwlog_queue.lock);
+
+    if (skb) {
+        skb_trim(skb, 0);
+    } else {
+        skb = alloc_skb(slot_len, GFP_KERNEL);
+        if (!skb) {
+            spin_lock_bh(&fwlog->fwlog_queue.lock);
+            fwlog->fwlog_host_dropped++;
+            spin_unlock_bh(&fwlog->fwlog_queue.lock);
+            return -ENOMEM;
+        }
+    }
 
     slot = (struct dbglog_slot *) skb_put(skb, slot_len);
     slot->diag_type = (A_UINT32)DIAG_TYPE_FW_DEBUG_MSG;
@@ -1976,20 +2004,14 @@ dbglog_debugfs_raw_data(wmi_unified_t wmi_handle, const u_int8_t *buf, A_UINT32
     /* Need to pad each record to fixed length ATH6KL_FWLOG_PAYLOAD_SIZE */
     memset(slot->payload + length, 0, ATH6KL_FWLOG_PAYLOAD_SIZE - length);
 
-    spin_lock(&fwlog->fwlog_queue.lock);
+    spin_lock_bh(&fwlog->fwlog_queue.lock);
 
     __skb_queue_tail(&fwlog->fwlog_queue, skb);
+    fwlog->fwlog_records++;
 
     complete(&fwlog->fwlog_completion);
 
-    /* drop oldest entries */
-    while (skb_queue_len(&fwlog->fwlog_queue) >
-           ATH6KL_FWLOG_MAX_ENTRIES) {
-        skb = __skb_dequeue(&fwlog->fwlog_queue);
-        kfree_skb(skb);
-    }
-
-    spin_unlock(&fwlog->fwlog_queue.lock);
+    spin_unlock_bh(&fwlog->fwlog_queue.lock);
 
     return TRUE;
 }
@@ -4308,6 +4330,37 @@ static const struct file_operations fops_dbglog_block = {
     .llseek = default_llseek,
 };
 
+static ssize_t dbglog_stats_read(struct file *file,
+                                 char __user *user_buf,
+                                 size_t count,
+                                 loff_t *ppos)
+{
+    struct fwdebug *fwlog = file->private_data;
+    A_UINT32 records, fw_dropped, host_dropped, queued;
+    char buf[160];
+    int len;
+
+    spin_lock_bh(&fwlog->fwlog_queue.lock);
+    records = fwlog->fwlog_records;
+    fw_dropped = fwlog->fwlog_fw_dropped;
+    host_dropped = fwlog->fwlog_host_dropped;
+    queued = skb_queue_len(&fwlog->fwlog_queue);
+    spin_unlock_bh(&fwlog->fwlog_queue.lock);
+
+    len = scnprintf(buf, sizeof(buf),
+                    "records: %u\nqueued: %u\nfw_dropped: %u\nhost_dropped: %u\n",
+                    records, queued, fw_dropped, host_dropped);
+
+    return simple_read_from_buffer(user_buf, count, ppos, buf, len);
+}
+
+static const struct file_operations fops_dbglog_stats = {
+    .open = simple_open,
+    .read = dbglog_stats_read,
+    .owner = THIS_MODULE,
+    .llseek = default_llseek,
+};
+
 int dbglog_debugfs_init(wmi_unified_t wmi_handle)
 {
 
@@ -4317,6 +4370,8 @@ int dbglog_debugfs_init(wmi_unified_t wmi_handle)
 
     debugfs_create_file(DEBUGFS_BLOCK_NAME, S_IRUSR, wmi_handle->debugfs_phy, &wmi_handle->dbglog,
                             &fops_dbglog_block);
+    debugfs_create_file(DEBUGFS_STATS_NAME, S_IRUSR, wmi_handle->debugfs_phy, &wmi_handle->dbglog,
+                            &fops_dbglog_stats);
 
     return TRUE;
 }
@@ -4551,6 +4606,9 @@ dbglog_init(wmi_unified_t wmi_handle)
 #ifdef WLAN_OPEN_SOURCE
     /* Initialize the fw debug log queue */
     skb_queue_head_init(&wmi_handle->dbglog.fwlog_queue);
+    wmi_handle->dbglog.fwlog_records = 0;
+    wmi_handle->dbglog.fwlog_fw_dropped = 0;
+    wmi_handle->dbglog.fwlog_host_dropped = 0;
     init_completion(&wmi_handle->dbglog.fwlog_completion);
 
     /* Initialize debugfs */
@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2016 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/*
+ * Firmware log decoder
+ *
+ * Formats the undecoded records the driver queues for the dbglog_block
+ * debugfs file when dbglog_process_type is DBGLOG_PROCESS_POOL_RAW, so
+ * the string lookups and printing that DBGLOG_PROCESS_DEFAULT does in the
+ * WMI event handler happen in userspace instead. Each record is a
+ * struct dbglog_slot padded to ATH6KL_FWLOG_PAYLOAD_SIZE bytes of
+ * payload; the payload is the firmware debug buffer without its leading
+ * dropped count. Module and message names come from the DBG_MSG_ARR
+ * table in dbglog_host.c, see dbglog_decode.sh.
+ *
+ * Usage:
+ *   dbglog_decode [<file>]    decode a capture or the debugfs file;
+ *                             reads stdin when no file is given
+ *
+ * Lines match the DBGLOG_PROCESS_DEFAULT output of
+ * dbglog_default_print_handler().
+ */
+
+#include "dbglog_decode.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#define DBGLOG_DECODE_RECLEN \
+    (sizeof(struct dbglog_slot) + ATH6KL_FWLOG_PAYLOAD_SIZE)
+#define DBGLOG_DECODE_BATCH 32
+
+static const char *
+dbglog_decode_msg(A_UINT32 moduleid, A_UINT32 debugid)
+{
+    static char unknown_str[64];
+
+    if (moduleid < WLAN_MODULE_ID_MAX && debugid < MAX_DBG_MSGS) {
+        char *str = DBG_MSG_ARR[moduleid][debugid];
+        if (str && str[0] != '\0') {
+            return str;
+        }
+    }
+
+    snprintf(unknown_str, sizeof(unknown_str),
+            "UNKNOWN %u:%u",
+            moduleid, debugid);
+
+    return unknown_str;
+}
+
+static void
+dbglog_decode_slot(const struct dbglog_slot *slot)
+{
+    const A_UINT32 *buffer = (const A_UINT32 *)slot->payload;
+    A_UINT32 length = slot->length;
+    A_UINT32 count = 0;
+    A_UINT32 timestamp, debugid, moduleid, numargs, vapid, i;
+
+    if (length > ATH6KL_FWLOG_PAYLOAD_SIZE) {
+        fprintf(stderr, "dbglog_decode: bad record length %u\n", length);
+        return;
+    }
+    if (slot->dropped) {
+        printf(DBGLOG_PRINT_PREFIX "%u log buffers are dropped\n",
+               slot->dropped);
+    }
+
+    length >>= 2;
+    while ((count + 2) < length) {
+        timestamp = DBGLOG_GET_TIME_STAMP(buffer[count]);
+        debugid = DBGLOG_GET_DBGID(buffer[count + 1]);
+        moduleid = DBGLOG_GET_MODULEID(buffer[count + 1]);
+        vapid = DBGLOG_GET_VDEVID(buffer[count + 1]);
+        numargs = DBGLOG_GET_NUMARGS(buffer[count + 1]);
+
+        if ((count + 2 + numargs) > length || moduleid >= WLAN_MODULE_ID_MAX)
+            return;
+
+        if (vapid < DBGLOG_MAX_VDEVID) {
+            printf(DBGLOG_PRINT_PREFIX "[%u] vap-%u %s ( ", timestamp, vapid,
+                   dbglog_decode_msg(moduleid, debugid));
+        } else {
+            printf(DBGLOG_PRINT_PREFIX "[%u] %s ( ", timestamp,
+                   dbglog_decode_msg(moduleid, debugid));
+        }
+        for (i = 0; i < numargs; i++) {
+            printf("%#x%s", buffer[count + 2 + i],
+                   (i + 1) < numargs ? ", " : "");
+        }
+        printf(" )\n");
+
+        count += numargs + 2; /* 32 bit Time stamp + 32 bit Dbg header*/
+    }
+}
+
+int main(int argc, char **argv)
+{
+    static A_UINT8 buf[DBGLOG_DECODE_BATCH * DBGLOG_DECODE_RECLEN];
+    size_t have = 0, off;
+    ssize_t n;
+    int fd = 0;
+
+    if (argc > 2) {
+        fprintf(stderr, "usage: dbglog_decode [<file>]\n");
+        return 2;
+    }
+    if (argc == 2 && (fd = open(argv[1], O_RDONLY)) < 0) {
+        fprintf(stderr, "dbglog_decode: %s: %s\n", argv[1], strerror(errno));
+        return 1;
+    }
+
+    /*
+     * dbglog_block hands out whole records only, a regular file or a
+     * pipe may split them, so carry any partial record over.
+     */
+    for (;;) {
+        n = read(fd, buf + have, sizeof(buf) - have);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n < 0) {
+            fprintf(stderr, "dbglog_decode: read: %s\n", strerror(errno));
+            return 1;
+        }
+        if (n == 0)
+            break;
+        have += n;
+
+        for (off = 0; have - off >= DBGLOG_DECODE_RECLEN;
+             off += DBGLOG_DECODE_RECLEN) {
+            dbglog_decode_slot((const struct dbglog_slot *)(buf + off));
+        }
+        memmove(buf, buf + off, have - off);
+        have -= off;
+        fflush(stdout);
+    }
+
+    if (have)
+        fprintf(stderr, "dbglog_decode: %zu trailing bytes ignored\n", have);
+    return 0;
+}
@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2016 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/*
+ * Userspace view of the firmware log headers shared with the driver, so
+ * the decoder and the DBG_MSG_ARR table taken from dbglog_host.c build
+ * without the kernel headers.
+ */
+
+#ifndef _DBGLOG_DECODE_H_
+#define _DBGLOG_DECODE_H_
+
+#include <stdint.h>
+#include <sys/types.h>
+
+typedef uint8_t  A_UINT8;
+typedef uint16_t A_UINT16;
+typedef uint32_t A_UINT32;
+typedef int32_t  A_INT32;
+typedef uint64_t A_UINT64;
+typedef int      A_BOOL;
+
+#define __packed __attribute__((packed))
+
+#include "wlan_module_ids.h"
+#include "dbglog_host.h"
+
+extern char *DBG_MSG_ARR[WLAN_MODULE_ID_MAX][MAX_DBG_MSGS];
+
+#endif /* _DBGLOG_DECODE_H_ */
@@ -0,0 +1,31 @@
+#!/bin/sh
+#
+# Build the firmware log decoder with the DBG_MSG_ARR message table from
+# the driver's dbglog_host.c and decode a dbglog_block capture, or the
+# live debugfs file when no capture is given. Switch the driver to
+# DBGLOG_PROCESS_POOL_RAW first so dbglog_block is filled, e.g.
+# "iwpriv wlan0 dl_type 2".
+#
+# usage: dbglog_decode.sh [<capture>]
+
+set -e
+
+HERE=$(cd "$(dirname "$0")" && pwd)
+FWLOG=$HERE/../..
+COMMON=$FWLOG/../../SERVICES/COMMON
+CC=${CC:-cc}
+CFLAGS="-O2 -Wall"
+IN=${1:-/sys/kernel/debug/cld/dbglog_block}
+
+OUT=$(mktemp -d)
+trap 'rm -rf "$OUT"' EXIT
+
+{
+    echo '#include "dbglog_decode.h"'
+    echo '#define DBG_STRING(id) [id] = #id'
+    awk '/^char \* DBG_MSG_ARR/,/^};/' "$FWLOG/dbglog_host.c"
+} > "$OUT/dbglog_msg.c"
+
+$CC $CFLAGS -I"$HERE" -I"$COMMON" -o "$OUT/dbglog_decode" \
+    "$HERE/dbglog_decode.c" "$OUT/dbglog_msg.c"
+"$OUT/dbglog_decode" "$IN"
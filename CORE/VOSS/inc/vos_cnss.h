@@ -28,6 +28,7 @@
 #include "vos_status.h"
 #ifdef CONFIG_CNSS
 #include <net/cnss.h>
+#include <linux/pm_runtime.h>
 #endif
 
 #if defined(WLAN_OPEN_SOURCE) && !defined(CONFIG_CNSS)
@@ -165,6 +166,11 @@ static inline void vos_runtime_init(struct device *dev, int auto_delay)
 {
 	return;
 }
+static inline void vos_runtime_set_autosuspend_delay(struct device *dev,
+						     int auto_delay)
+{
+	return;
+}
 static inline void vos_runtime_exit(struct device *dev) { return; }
 static inline int vos_set_wlan_unsafe_channel(u16 *unsafe_ch_list,
 					u16 ch_count)
@@ -503,6 +509,22 @@ static inline void vos_runtime_init(struct device *dev, int auto_delay)
 	cnss_runtime_init(dev, auto_delay);
 }
 
+/**
+ * vos_runtime_set_autosuspend_delay() - change the runtime PM delay
+ * @dev: device set up with vos_runtime_init()
+ * @auto_delay: new autosuspend delay, ms
+ *
+ * The platform driver has no call for this, cnss_runtime_init() programs
+ * the delay through the runtime PM core, so do the same here.
+ *
+ * Return: void
+ */
+static inline void vos_runtime_set_autosuspend_delay(struct device *dev,
+						     int auto_delay)
+{
+	pm_runtime_set_autosuspend_delay(dev, auto_delay);
+}
+
 static inline void vos_runtime_exit(struct device *dev)
 {
 	cnss_runtime_exit(dev);
@@ -165,4 +165,19 @@ static inline VOS_STATUS vos_mq_post_message(VOS_MQ_ID msg_queue_id,
 						LOW_PRIORITY);
 }
 
+/**
+ * vos_mq_dump_mc_stats() - dump depth, batching and dwell time statistics
+ * of the MC thread message queues
+ *
+ * Return: None
+ */
+void vos_mq_dump_mc_stats(void);
+
+/**
+ * vos_mq_clear_mc_stats() - clear the MC thread message queue statistics
+ *
+ * Return: None
+ */
+void vos_mq_clear_mc_stats(void);
+
 #endif // if !defined __VOS_MQ_H
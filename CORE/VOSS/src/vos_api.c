@@ -74,6 +74,7 @@
 #include "sapApi.h"
 #include "vos_trace.h"
 #include "adf_trace.h"
+#include "adf_os_time.h"
 
 
 
@@ -86,6 +87,8 @@
 #include "if_usb.h"
 #elif defined(HIF_SDIO)
 #include "if_ath_sdio.h"
+#elif defined(HIF_SIM)
+#include "if_sim.h"
 #endif
 #include "vos_utils.h"
 #include "wlan_logging_sock_svc.h"
@@ -231,6 +234,9 @@ static inline void vos_runtime_pm_config(struct ol_softc *scn,
 {
 	scn->enable_runtime_pm = pHddCtx->cfg_ini->runtime_pm;
 	scn->runtime_pm_delay = pHddCtx->cfg_ini->runtime_pm_delay;
+	scn->runtime_pm_governor = pHddCtx->cfg_ini->runtime_pm_governor;
+	scn->runtime_pm_delay_min = pHddCtx->cfg_ini->runtime_pm_delay_min;
+	scn->runtime_pm_delay_max = pHddCtx->cfg_ini->runtime_pm_delay_max;
 }
 #else
 static inline void vos_runtime_pm_config(struct ol_softc *scn,
@@ -639,6 +645,9 @@ VOS_STATUS vos_open( v_CONTEXT_t *pVosContext, v_SIZE_t hddContextSize )
     macOpenParms.self_gen_frm_pwr = pHddCtx->cfg_ini->self_gen_frm_pwr;
     macOpenParms.max_mgmt_tx_fail_count =
                      pHddCtx->cfg_ini->max_mgmt_tx_fail_count;
+    macOpenParms.fw_stats_push_period =
+                     pHddCtx->cfg_ini->fw_stats_push_period;
+    macOpenParms.wmi_rx_event_prio = pHddCtx->cfg_ini->wmi_rx_event_prio;
 
 #ifdef WLAN_FEATURE_LPSS
     macOpenParms.is_lpass_enabled = pHddCtx->cfg_ini->enablelpasssupport;
@@ -674,7 +683,7 @@ VOS_STATUS vos_open( v_CONTEXT_t *pVosContext, v_SIZE_t hddContextSize )
                 "%s: HTCHandle is null!", __func__);
       goto err_wda_close;
    }
-   if (HTCWaitTarget(HTCHandle)) {
+   if (ol_wait_for_htc_target(scn, HTCHandle)) {
       VOS_TRACE( VOS_MODULE_ID_VOSS, VOS_TRACE_LEVEL_FATAL,
                 "%s: Failed to complete BMI phase", __func__);
            goto err_wda_close;
@@ -927,7 +936,9 @@ VOS_STATUS vos_preStart( v_CONTEXT_t vosContext )
       VOS_ASSERT( 0 );
       return VOS_STATUS_E_FAILURE;
    }
+   ol_boot_phase_start(scn, OL_BOOT_PHASE_WMI_READY);
    vStatus = wma_wait_for_ready_event(gpVosContext->pWDAContext);
+   ol_boot_phase_end(scn, OL_BOOT_PHASE_WMI_READY);
    if (!VOS_IS_STATUS_SUCCESS(vStatus))
    {
       VOS_TRACE(VOS_MODULE_ID_SYS, VOS_TRACE_LEVEL_FATAL,
@@ -938,6 +949,7 @@ VOS_STATUS vos_preStart( v_CONTEXT_t vosContext )
       VOS_ASSERT( 0 );
       return VOS_STATUS_E_FAILURE;
    }
+   ol_boot_timing_report(scn);
 
    HTCSetTargetToSleep(scn);
 
@@ -1959,13 +1971,21 @@ VOS_STATUS vos_mq_post_message_by_priority(VOS_MQ_ID msgQueueId,
   vos_mem_copy( (v_VOID_t*)pMsgWrapper->pVosMsg,
                 (v_VOID_t*)pMsg, sizeof(vos_msg_t));
 
-  if (is_high_priority)
-      vos_mq_put_front(pTargetMq, pMsgWrapper);
-  else
+  pMsgWrapper->postTimeUs = adf_os_get_monotonic_us();
+
+  if (is_high_priority) {
+      atomic_inc(&gpVosContext->vosSched.mcHiPrioPending);
+      vos_mq_put_hi_prio(pTargetMq, pMsgWrapper);
+  } else {
       vos_mq_put(pTargetMq, pMsgWrapper);
+  }
 
-  set_bit(MC_POST_EVENT, &gpVosContext->vosSched.mcEventFlag);
-  wake_up_interruptible(&gpVosContext->vosSched.mcWaitQueue);
+  /*
+   * The MC thread drains every queue after it consumes MC_POST_EVENT, so
+   * only the poster that raises the event needs to wake it up.
+   */
+  if (!test_and_set_bit(MC_POST_EVENT, &gpVosContext->vosSched.mcEventFlag))
+      wake_up_interruptible(&gpVosContext->vosSched.mcWaitQueue);
 
   return VOS_STATUS_SUCCESS;
 
@@ -52,6 +52,19 @@
   Type declarations
   ------------------------------------------------------------------------*/
 
+/**
+ * vos_mq_inc_depth() - account for a message added to a queue
+ * @mq: message queue, caller holds the queue lock
+ *
+ * Return: None
+ */
+static inline void vos_mq_inc_depth(pVosMqType mq)
+{
+	mq->stats.depth++;
+	if (mq->stats.depth > mq->stats.max_depth)
+		mq->stats.max_depth = mq->stats.depth;
+}
+
 /*-------------------------------------------------------------------------
   Function declarations and documenation
   ------------------------------------------------------------------------*/
@@ -92,6 +105,9 @@ __inline VOS_STATUS vos_mq_init(pVosMqType pMq)
   ** Now initialize the List data structure
   */
   INIT_LIST_HEAD(&pMq->mqList);
+  INIT_LIST_HEAD(&pMq->mqHiList);
+
+  vos_mem_zero(&pMq->stats, sizeof(pMq->stats));
 
   return VOS_STATUS_SUCCESS;
 
@@ -157,6 +173,7 @@ __inline void vos_mq_put(pVosMqType pMq, pVosMsgWrapper pMsgWrapper)
   spin_lock_irqsave(&pMq->mqLock, flags);
 
   list_add_tail(&pMsgWrapper->msgNode, &pMq->mqList);
+  vos_mq_inc_depth(pMq);
 
   spin_unlock_irqrestore(&pMq->mqLock, flags);
 
@@ -183,6 +200,34 @@ void vos_mq_put_front(pVosMqType mq, pVosMsgWrapper msg_wrapper)
 
 	spin_lock_irqsave(&mq->mqLock, flags);
 	list_add(&msg_wrapper->msgNode, &mq->mqList);
+	vos_mq_inc_depth(mq);
+	spin_unlock_irqrestore(&mq->mqLock, flags);
+}
+
+/**
+ * vos_mq_put_hi_prio() - adds a message to the high priority lane
+ * @mq: message queue
+ * @msg_wrapper: message wrapper
+ *
+ * Messages on the high priority lane are dispatched in FIFO order ahead
+ * of everything queued on the regular lane of the same message queue.
+ *
+ * Return: None
+ */
+void vos_mq_put_hi_prio(pVosMqType mq, pVosMsgWrapper msg_wrapper)
+{
+	unsigned long flags;
+
+	if ((mq == NULL) || (msg_wrapper == NULL)) {
+		VOS_TRACE(VOS_MODULE_ID_VOSS, VOS_TRACE_LEVEL_ERROR,
+			"%s: NULL pointer passed", __func__);
+		return;
+	}
+
+	spin_lock_irqsave(&mq->mqLock, flags);
+	list_add_tail(&msg_wrapper->msgNode, &mq->mqHiList);
+	vos_mq_inc_depth(mq);
+	mq->stats.hi_prio_posted++;
 	spin_unlock_irqrestore(&mq->mqLock, flags);
 }
 
@@ -218,7 +263,14 @@ __inline pVosMsgWrapper vos_mq_get(pVosMqType pMq)
 
   spin_lock_irqsave(&pMq->mqLock, flags);
 
-  if( list_empty(&pMq->mqList) )
+  if (!list_empty(&pMq->mqHiList))
+  {
+    listptr = pMq->mqHiList.next;
+    pMsgWrapper = (pVosMsgWrapper)list_entry(listptr, VosMsgWrapper, msgNode);
+    list_del(listptr);
+    pMq->stats.depth--;
+  }
+  else if( list_empty(&pMq->mqList) )
   {
     VOS_TRACE(VOS_MODULE_ID_VOSS, VOS_TRACE_LEVEL_WARN,
              "%s: VOS Message Queue is empty",__func__);
@@ -228,6 +280,7 @@ __inline pVosMsgWrapper vos_mq_get(pVosMqType pMq)
     listptr = pMq->mqList.next;
     pMsgWrapper = (pVosMsgWrapper)list_entry(listptr, VosMsgWrapper, msgNode);
     list_del(pMq->mqList.next);
+    pMq->stats.depth--;
   }
 
   spin_unlock_irqrestore(&pMq->mqLock, flags);
@@ -236,6 +289,99 @@ __inline pVosMsgWrapper vos_mq_get(pVosMqType pMq)
 
 } /* vos_mq_get() */
 
+/**
+ * vos_mq_get_hi_prio() - get a message from the high priority lane
+ * @mq: message queue
+ *
+ * Return: message wrapper, or NULL if the high priority lane is empty
+ */
+pVosMsgWrapper vos_mq_get_hi_prio(pVosMqType mq)
+{
+	pVosMsgWrapper msg_wrapper = NULL;
+	unsigned long flags;
+
+	if (mq == NULL) {
+		VOS_TRACE(VOS_MODULE_ID_VOSS, VOS_TRACE_LEVEL_ERROR,
+			"%s: NULL pointer passed", __func__);
+		return NULL;
+	}
+
+	spin_lock_irqsave(&mq->mqLock, flags);
+	if (!list_empty(&mq->mqHiList)) {
+		msg_wrapper = list_first_entry(&mq->mqHiList, VosMsgWrapper,
+					       msgNode);
+		list_del(&msg_wrapper->msgNode);
+		mq->stats.depth--;
+	}
+	spin_unlock_irqrestore(&mq->mqLock, flags);
+
+	return msg_wrapper;
+}
+
+/**
+ * vos_mq_get_batch() - move up to @max_msgs regular messages to @batch
+ * @mq: message queue
+ * @batch: caller owned list head the messages are appended to
+ * @max_msgs: maximum number of messages to dequeue
+ *
+ * Takes the queue lock once for the whole batch. The high priority lane
+ * is not touched; callers drain it with vos_mq_get_hi_prio() first.
+ *
+ * Return: number of messages moved to @batch
+ */
+uint32_t vos_mq_get_batch(pVosMqType mq, struct list_head *batch,
+			  uint32_t max_msgs)
+{
+	struct list_head *node;
+	uint32_t count = 0;
+	unsigned long flags;
+
+	if ((mq == NULL) || (batch == NULL)) {
+		VOS_TRACE(VOS_MODULE_ID_VOSS, VOS_TRACE_LEVEL_ERROR,
+			"%s: NULL pointer passed", __func__);
+		return 0;
+	}
+
+	spin_lock_irqsave(&mq->mqLock, flags);
+	while ((count < max_msgs) && !list_empty(&mq->mqList)) {
+		node = mq->mqList.next;
+		list_move_tail(node, batch);
+		count++;
+	}
+	mq->stats.depth -= count;
+	spin_unlock_irqrestore(&mq->mqLock, flags);
+
+	return count;
+}
+
+/**
+ * vos_mq_return_batch() - put unprocessed batch messages back on the queue
+ * @mq: message queue the batch was taken from
+ * @batch: remaining messages, in dispatch order
+ *
+ * The messages are put back at the head of the regular lane so that their
+ * relative order with messages posted in the meantime is preserved.
+ *
+ * Return: None
+ */
+void vos_mq_return_batch(pVosMqType mq, struct list_head *batch)
+{
+	struct list_head *node;
+	uint32_t count = 0;
+	unsigned long flags;
+
+	if ((mq == NULL) || (batch == NULL) || list_empty(batch))
+		return;
+
+	list_for_each(node, batch)
+		count++;
+
+	spin_lock_irqsave(&mq->mqLock, flags);
+	list_splice_init(batch, &mq->mqList);
+	mq->stats.depth += count;
+	spin_unlock_irqrestore(&mq->mqLock, flags);
+}
+
 
 /*---------------------------------------------------------------------------
 
@@ -266,7 +412,8 @@ __inline v_BOOL_t vos_is_mq_empty(pVosMqType pMq)
   }
 
   spin_lock_irqsave(&pMq->mqLock, flags);
-  state = list_empty(&pMq->mqList)?VOS_TRUE:VOS_FALSE;
+  state = (list_empty(&pMq->mqList) && list_empty(&pMq->mqHiList)) ?
+          VOS_TRUE : VOS_FALSE;
   spin_unlock_irqrestore(&pMq->mqLock, flags);
 
   return state;
@@ -60,6 +60,7 @@
 #include <linux/cpu.h>
 #include <linux/topology.h>
 #include "vos_cnss.h"
+#include "adf_os_time.h"
 
 /*---------------------------------------------------------------------------
  * Preprocessor Definitions and Constants
@@ -537,6 +538,7 @@ vos_sched_open
 
   init_waitqueue_head(&pSchedContext->mcWaitQueue);
   pSchedContext->mcEventFlag = 0;
+  atomic_set(&pSchedContext->mcHiPrioPending, 0);
 
 #ifdef QCA_CONFIG_SMP
   init_waitqueue_head(&pSchedContext->tlshimRxWaitQueue);
@@ -703,6 +705,294 @@ VOS_STATUS vos_watchdog_open
                "%s: VOSS Watchdog Thread has started",__func__);
   return VOS_STATUS_SUCCESS;
 } /* vos_watchdog_open() */
+/**
+ * vos_mc_mq_by_order() - get MC message queue by dispatch order
+ * @sched_ctx: scheduler context
+ * @order: dispatch order, 0 being served first
+ *
+ * Return: message queue, or NULL if @order is out of range
+ */
+static pVosMqType vos_mc_mq_by_order(pVosSchedContext sched_ctx, int order)
+{
+	switch (order) {
+	case 0:
+		return &sched_ctx->sysMcMq;
+	case 1:
+		return &sched_ctx->wdaMcMq;
+	case 2:
+		return &sched_ctx->peMcMq;
+	case 3:
+		return &sched_ctx->smeMcMq;
+	case 4:
+		return &sched_ctx->tlMcMq;
+	default:
+		return NULL;
+	}
+}
+
+/**
+ * vos_mc_mq_name() - printable name of an MC message queue
+ * @sched_ctx: scheduler context
+ * @mq: message queue
+ *
+ * Return: queue name
+ */
+static const char *vos_mc_mq_name(pVosSchedContext sched_ctx, pVosMqType mq)
+{
+	if (mq == &sched_ctx->sysMcMq)
+		return "SYS";
+	if (mq == &sched_ctx->wdaMcMq)
+		return "WDA";
+	if (mq == &sched_ctx->peMcMq)
+		return "PE";
+	if (mq == &sched_ctx->smeMcMq)
+		return "SME";
+	if (mq == &sched_ctx->tlMcMq)
+		return "TL";
+	return "UNKNOWN";
+}
+
+/**
+ * vos_mc_next_mq() - get the first MC message queue with pending messages
+ * @sched_ctx: scheduler context
+ *
+ * Return: message queue, or NULL if all MC queues are empty
+ */
+static pVosMqType vos_mc_next_mq(pVosSchedContext sched_ctx)
+{
+	pVosMqType mq;
+	int order;
+
+	for (order = 0; (mq = vos_mc_mq_by_order(sched_ctx, order)); order++) {
+		if (!vos_is_mq_empty(mq))
+			return mq;
+	}
+
+	return NULL;
+}
+
+/**
+ * vos_mc_mq_batch_size() - regular messages taken from a queue per lock
+ * @sched_ctx: scheduler context
+ * @mq: message queue
+ *
+ * Only the PE queue sees floods of beacon/probe indications, so only its
+ * regular lane is batched. Every other queue keeps one message per pass.
+ *
+ * Return: maximum number of messages to dequeue at once
+ */
+static uint32_t vos_mc_mq_batch_size(pVosSchedContext sched_ctx,
+				     pVosMqType mq)
+{
+	return (mq == &sched_ctx->peMcMq) ? VOS_MC_MQ_BATCH_SIZE : 1;
+}
+
+/**
+ * vos_mc_mq_preempted() - check if a batch has to be handed back
+ * @sched_ctx: scheduler context
+ * @mq: queue the batch was taken from
+ *
+ * One message per pass always restarted from the SYS queue, so a message
+ * posted to an earlier queue, or to a high priority lane, was served next.
+ * Yielding the batch in that case keeps the same dispatch order.
+ *
+ * Return: true if the rest of the batch must go back to @mq
+ */
+static bool vos_mc_mq_preempted(pVosSchedContext sched_ctx, pVosMqType mq)
+{
+	pVosMqType prev;
+	int order;
+
+	if (atomic_read(&sched_ctx->mcHiPrioPending) > 0)
+		return true;
+
+	for (order = 0; (prev = vos_mc_mq_by_order(sched_ctx, order)) &&
+	     prev != mq; order++) {
+		if (!vos_is_mq_empty(prev))
+			return true;
+	}
+
+	return false;
+}
+
+/**
+ * vos_mc_update_dwell_stats() - account the dwell time of a message
+ * @sched_ctx: scheduler context
+ * @mq: message queue the message was posted to
+ * @msg_wrapper: message about to be dispatched
+ *
+ * Return: None
+ */
+static void vos_mc_update_dwell_stats(pVosSchedContext sched_ctx,
+				      pVosMqType mq,
+				      pVosMsgWrapper msg_wrapper)
+{
+	struct vos_mq_stats *stats = &mq->stats;
+	uint64_t now = adf_os_get_monotonic_us();
+	uint32_t dwell_us;
+	int bucket;
+
+	dwell_us = (now > msg_wrapper->postTimeUs) ?
+		   (uint32_t)(now - msg_wrapper->postTimeUs) : 0;
+
+	if (dwell_us < 1000)
+		bucket = VOS_MQ_LAT_1MS;
+	else if (dwell_us < 5000)
+		bucket = VOS_MQ_LAT_5MS;
+	else if (dwell_us < 20000)
+		bucket = VOS_MQ_LAT_20MS;
+	else if (dwell_us < 100000)
+		bucket = VOS_MQ_LAT_100MS;
+	else if (dwell_us < 500000)
+		bucket = VOS_MQ_LAT_500MS;
+	else
+		bucket = VOS_MQ_LAT_MAX;
+
+	stats->dispatched++;
+	stats->latency_hist[bucket]++;
+
+	if (dwell_us > stats->max_dwell_us) {
+		stats->max_dwell_us = dwell_us;
+		stats->max_dwell_msg_type = msg_wrapper->pVosMsg->type;
+	}
+
+	if (dwell_us >= VOS_MC_MQ_DWELL_WARN_US)
+		VOS_TRACE(VOS_MODULE_ID_VOSS, VOS_TRACE_LEVEL_WARN,
+			  "%s: %s msg 0x%x waited %u us, depth %u",
+			  __func__, vos_mc_mq_name(sched_ctx, mq),
+			  msg_wrapper->pVosMsg->type, dwell_us, stats->depth);
+}
+
+/**
+ * vos_mc_dispatch_msg() - hand a message to the module owning its queue
+ * @sched_ctx: scheduler context
+ * @mq: message queue the message was taken from
+ * @msg_wrapper: message to dispatch
+ *
+ * The message wrapper is returned to the core once the module is done.
+ *
+ * Return: None
+ */
+static void vos_mc_dispatch_msg(pVosSchedContext sched_ctx, pVosMqType mq,
+				pVosMsgWrapper msg_wrapper)
+{
+	tpAniSirGlobal mac_ctx;
+	VOS_STATUS status = VOS_STATUS_SUCCESS;
+
+	vos_mc_update_dwell_stats(sched_ctx, mq, msg_wrapper);
+
+	if (mq == &sched_ctx->sysMcMq) {
+		status = sysMcProcessMsg(sched_ctx->pVContext,
+					 msg_wrapper->pVosMsg);
+	} else if (mq == &sched_ctx->wdaMcMq) {
+		status = WDA_McProcessMsg(sched_ctx->pVContext,
+					  msg_wrapper->pVosMsg);
+	} else if (mq == &sched_ctx->peMcMq) {
+		/* Need some optimization*/
+		mac_ctx = vos_get_context(VOS_MODULE_ID_PE,
+					  sched_ctx->pVContext);
+		if (NULL == mac_ctx) {
+			VOS_TRACE(VOS_MODULE_ID_VOSS, VOS_TRACE_LEVEL_INFO,
+				  "MAC Context not ready yet");
+		} else if (eSIR_SUCCESS != peProcessMessages(mac_ctx,
+				(tSirMsgQ *)msg_wrapper->pVosMsg)) {
+			status = VOS_STATUS_E_FAILURE;
+		}
+	} else if (mq == &sched_ctx->smeMcMq) {
+		/* Need some optimization*/
+		mac_ctx = vos_get_context(VOS_MODULE_ID_SME,
+					  sched_ctx->pVContext);
+		if (NULL == mac_ctx)
+			VOS_TRACE(VOS_MODULE_ID_VOSS, VOS_TRACE_LEVEL_INFO,
+				  "MAC Context not ready yet");
+		else
+			status = sme_ProcessMsg((tHalHandle)mac_ctx,
+						msg_wrapper->pVosMsg);
+	} else if (mq == &sched_ctx->tlMcMq) {
+		status = WLANTL_McProcessMsg(sched_ctx->pVContext,
+					     msg_wrapper->pVosMsg);
+	}
+
+	if (!VOS_IS_STATUS_SUCCESS(status))
+		VOS_TRACE(VOS_MODULE_ID_VOSS, VOS_TRACE_LEVEL_ERROR,
+			  "%s: Issue Processing %s message", __func__,
+			  vos_mc_mq_name(sched_ctx, mq));
+
+	/* return message to the Core */
+	vos_core_return_msg(sched_ctx->pVContext, msg_wrapper);
+}
+
+/**
+ * vos_mq_dump_mc_stats() - dump MC message queue statistics
+ *
+ * Return: None
+ */
+void vos_mq_dump_mc_stats(void)
+{
+	struct vos_mq_stats *stats;
+	pVosMqType mq;
+	int order;
+
+	if (gpVosSchedContext == NULL)
+		return;
+
+	VOS_TRACE(VOS_MODULE_ID_VOSS, VOS_TRACE_LEVEL_ERROR,
+		  "MC thread high priority pending %d",
+		  atomic_read(&gpVosSchedContext->mcHiPrioPending));
+	for (order = 0; (mq = vos_mc_mq_by_order(gpVosSchedContext, order));
+	     order++) {
+		stats = &mq->stats;
+		VOS_TRACE(VOS_MODULE_ID_VOSS, VOS_TRACE_LEVEL_ERROR,
+			  "%s: depth %u max %u hi %u dispatched %u batches %u preempted %u",
+			  vos_mc_mq_name(gpVosSchedContext, mq), stats->depth,
+			  stats->max_depth, stats->hi_prio_posted,
+			  stats->dispatched, stats->batches, stats->preempted);
+		VOS_TRACE(VOS_MODULE_ID_VOSS, VOS_TRACE_LEVEL_ERROR,
+			  "%s: dwell <1ms %u <5ms %u <20ms %u <100ms %u <500ms %u >=500ms %u max %u us (msg 0x%x)",
+			  vos_mc_mq_name(gpVosSchedContext, mq),
+			  stats->latency_hist[VOS_MQ_LAT_1MS],
+			  stats->latency_hist[VOS_MQ_LAT_5MS],
+			  stats->latency_hist[VOS_MQ_LAT_20MS],
+			  stats->latency_hist[VOS_MQ_LAT_100MS],
+			  stats->latency_hist[VOS_MQ_LAT_500MS],
+			  stats->latency_hist[VOS_MQ_LAT_MAX],
+			  stats->max_dwell_us, stats->max_dwell_msg_type);
+	}
+}
+
+/**
+ * vos_mq_clear_mc_stats() - clear MC message queue statistics
+ *
+ * The current queue depth is kept since it reflects queued messages.
+ *
+ * Return: None
+ */
+void vos_mq_clear_mc_stats(void)
+{
+	struct vos_mq_stats *stats;
+	pVosMqType mq;
+	unsigned long flags;
+	int order;
+
+	if (gpVosSchedContext == NULL)
+		return;
+
+	for (order = 0; (mq = vos_mc_mq_by_order(gpVosSchedContext, order));
+	     order++) {
+		stats = &mq->stats;
+		spin_lock_irqsave(&mq->mqLock, flags);
+		stats->max_depth = stats->depth;
+		stats->hi_prio_posted = 0;
+		spin_unlock_irqrestore(&mq->mqLock, flags);
+		stats->dispatched = 0;
+		stats->batches = 0;
+		stats->preempted = 0;
+		vos_mem_zero(stats->latency_hist, sizeof(stats->latency_hist));
+		stats->max_dwell_us = 0;
+		stats->max_dwell_msg_type = 0;
+	}
+}
+
 /*---------------------------------------------------------------------------
   \brief VosMcThread() - The VOSS Main Controller thread
   The \a VosMcThread() is the VOSS main controller thread:
@@ -718,9 +1008,8 @@ VosMCThread
 {
   pVosSchedContext pSchedContext = (pVosSchedContext)Arg;
   pVosMsgWrapper pMsgWrapper     = NULL;
-  tpAniSirGlobal pMacContext     = NULL;
-  tSirRetStatus macStatus        = eSIR_SUCCESS;
-  VOS_STATUS vStatus             = VOS_STATUS_SUCCESS;
+  pVosMqType pMq                 = NULL;
+  struct list_head batch;
   int retWaitStatus              = 0;
   v_BOOL_t shutdown              = VOS_FALSE;
   hdd_context_t *pHddCtx         = NULL;
@@ -773,7 +1062,11 @@ VosMCThread
          "%s: wait_event_interruptible returned -ERESTARTSYS", __func__);
       VOS_BUG(0);
     }
-    clear_bit(MC_POST_EVENT, &pSchedContext->mcEventFlag);
+    /*
+     * Fully ordered against the queue checks below, posters rely on this
+     * to skip the wake up while MC_POST_EVENT is still pending.
+     */
+    test_and_clear_bit(MC_POST_EVENT, &pSchedContext->mcEventFlag);
 
     while(1)
     {
@@ -794,148 +1087,42 @@ VosMCThread
         break;
       }
 
-      // Check the SYS queue first
-      if (!vos_is_mq_empty(&pSchedContext->sysMcMq))
-      {
-        // Service the SYS message queue
-        VOS_TRACE(VOS_MODULE_ID_VOSS, VOS_TRACE_LEVEL_INFO,
-                  "%s: Servicing the VOS SYS MC Message queue",__func__);
-        pMsgWrapper = vos_mq_get(&pSchedContext->sysMcMq);
-        if (pMsgWrapper == NULL)
-        {
-           VOS_TRACE(VOS_MODULE_ID_VOSS, VOS_TRACE_LEVEL_ERROR,
-              "%s: pMsgWrapper is NULL", __func__);
-           VOS_ASSERT(0);
-           break;
-        }
-        vStatus = sysMcProcessMsg(pSchedContext->pVContext,
-           pMsgWrapper->pVosMsg);
-        if (!VOS_IS_STATUS_SUCCESS(vStatus))
-        {
-           VOS_TRACE( VOS_MODULE_ID_VOSS, VOS_TRACE_LEVEL_ERROR,
-                     "%s: Issue Processing SYS message",__func__);
-        }
-        //return message to the Core
-        vos_core_return_msg(pSchedContext->pVContext, pMsgWrapper);
-        continue;
-      }
-      // Check the WDA queue
-      if (!vos_is_mq_empty(&pSchedContext->wdaMcMq))
-      {
-        // Service the WDA message queue
-        VOS_TRACE(VOS_MODULE_ID_VOSS, VOS_TRACE_LEVEL_INFO,
-                 "%s: Servicing the VOS WDA MC Message queue",__func__);
-        pMsgWrapper = vos_mq_get(&pSchedContext->wdaMcMq);
-        if (pMsgWrapper == NULL)
-        {
-           VOS_TRACE(VOS_MODULE_ID_VOSS, VOS_TRACE_LEVEL_ERROR,
-              "%s: pMsgWrapper is NULL", __func__);
-           VOS_ASSERT(0);
-           break;
-        }
-        vStatus = WDA_McProcessMsg( pSchedContext->pVContext, pMsgWrapper->pVosMsg);
-        if (!VOS_IS_STATUS_SUCCESS(vStatus))
-        {
-           VOS_TRACE( VOS_MODULE_ID_VOSS, VOS_TRACE_LEVEL_ERROR,
-                     "%s: Issue Processing WDA message",__func__);
-        }
-        // return message to the Core
-        vos_core_return_msg(pSchedContext->pVContext, pMsgWrapper);
-        continue;
-      }
-      // Check the PE queue
-      if (!vos_is_mq_empty(&pSchedContext->peMcMq))
+      /*
+       * Serve the queues in SYS, WDA, PE, SME, TL order. Within a queue
+       * the high priority lane goes ahead of the regular one.
+       */
+      pMq = vos_mc_next_mq(pSchedContext);
+      if (pMq != NULL)
       {
-        // Service the PE message queue
-        VOS_TRACE(VOS_MODULE_ID_VOSS, VOS_TRACE_LEVEL_INFO,
-                  "%s: Servicing the VOS PE MC Message queue",__func__);
-        pMsgWrapper = vos_mq_get(&pSchedContext->peMcMq);
-        if (NULL == pMsgWrapper)
-        {
-           VOS_TRACE(VOS_MODULE_ID_VOSS, VOS_TRACE_LEVEL_ERROR,
-              "%s: pMsgWrapper is NULL", __func__);
-           VOS_ASSERT(0);
-           break;
-        }
-
-        /* Need some optimization*/
-        pMacContext = vos_get_context(VOS_MODULE_ID_PE, pSchedContext->pVContext);
-        if (NULL == pMacContext)
+        pMsgWrapper = vos_mq_get_hi_prio(pMq);
+        if (pMsgWrapper != NULL)
         {
-           VOS_TRACE(VOS_MODULE_ID_VOSS, VOS_TRACE_LEVEL_INFO,
-                     "MAC Context not ready yet");
-           vos_core_return_msg(pSchedContext->pVContext, pMsgWrapper);
-           continue;
+          atomic_dec(&pSchedContext->mcHiPrioPending);
+          vos_mc_dispatch_msg(pSchedContext, pMq, pMsgWrapper);
+          continue;
         }
 
-        macStatus = peProcessMessages( pMacContext, (tSirMsgQ*)pMsgWrapper->pVosMsg);
-        if (eSIR_SUCCESS != macStatus)
-        {
-          VOS_TRACE( VOS_MODULE_ID_VOSS, VOS_TRACE_LEVEL_ERROR,
-                     "%s: Issue Processing PE message",__func__);
-        }
-        // return message to the Core
-        vos_core_return_msg(pSchedContext->pVContext, pMsgWrapper);
-        continue;
-      }
-      /** Check the SME queue **/
-      if (!vos_is_mq_empty(&pSchedContext->smeMcMq))
-      {
-        /* Service the SME message queue */
-        VOS_TRACE(VOS_MODULE_ID_VOSS, VOS_TRACE_LEVEL_INFO,
-                  "%s: Servicing the VOS SME MC Message queue",__func__);
-        pMsgWrapper = vos_mq_get(&pSchedContext->smeMcMq);
-        if (NULL == pMsgWrapper)
-        {
-           VOS_TRACE(VOS_MODULE_ID_VOSS, VOS_TRACE_LEVEL_ERROR,
-               "%s: pMsgWrapper is NULL", __func__);
-           VOS_ASSERT(0);
-           break;
-        }
+        INIT_LIST_HEAD(&batch);
+        if (!vos_mq_get_batch(pMq, &batch,
+                              vos_mc_mq_batch_size(pSchedContext, pMq)))
+          continue;
+        pMq->stats.batches++;
 
-        /* Need some optimization*/
-        pMacContext = vos_get_context(VOS_MODULE_ID_SME, pSchedContext->pVContext);
-        if (NULL == pMacContext)
+        while (!list_empty(&batch))
         {
-           VOS_TRACE(VOS_MODULE_ID_VOSS, VOS_TRACE_LEVEL_INFO,
-                     "MAC Context not ready yet");
-           vos_core_return_msg(pSchedContext->pVContext, pMsgWrapper);
-           continue;
-        }
+          pMsgWrapper = list_first_entry(&batch, VosMsgWrapper, msgNode);
+          list_del(&pMsgWrapper->msgNode);
+          vos_mc_dispatch_msg(pSchedContext, pMq, pMsgWrapper);
 
-        vStatus = sme_ProcessMsg( (tHalHandle)pMacContext, pMsgWrapper->pVosMsg);
-        if (!VOS_IS_STATUS_SUCCESS(vStatus))
-        {
-          VOS_TRACE( VOS_MODULE_ID_VOSS, VOS_TRACE_LEVEL_ERROR,
-                     "%s: Issue Processing SME message",__func__);
-        }
-        // return message to the Core
-        vos_core_return_msg(pSchedContext->pVContext, pMsgWrapper);
-        continue;
-      }
-      /** Check the TL queue **/
-      if (!vos_is_mq_empty(&pSchedContext->tlMcMq))
-      {
-        // Service the TL message queue
-        VOS_TRACE(VOS_MODULE_ID_VOSS, VOS_TRACE_LEVEL_INFO,
-                  ("Servicing the VOS TL MC Message queue"));
-        pMsgWrapper = vos_mq_get(&pSchedContext->tlMcMq);
-        if (pMsgWrapper == NULL)
-        {
-           VOS_TRACE(VOS_MODULE_ID_VOSS, VOS_TRACE_LEVEL_ERROR,
-              "%s: pMsgWrapper is NULL", __func__);
-           VOS_ASSERT(0);
-           break;
-        }
-        vStatus = WLANTL_McProcessMsg( pSchedContext->pVContext,
-            pMsgWrapper->pVosMsg);
-        if (!VOS_IS_STATUS_SUCCESS(vStatus))
-        {
-          VOS_TRACE( VOS_MODULE_ID_VOSS, VOS_TRACE_LEVEL_ERROR,
-                     "%s: Issue Processing TL message",__func__);
+          if (!list_empty(&batch) &&
+              (vos_mc_mq_preempted(pSchedContext, pMq) ||
+               test_bit(MC_SHUTDOWN_EVENT, &pSchedContext->mcEventFlag)))
+          {
+            pMq->stats.preempted++;
+            vos_mq_return_batch(pMq, &batch);
+            break;
+          }
         }
-        // return message to the Core
-        vos_core_return_msg(pSchedContext->pVContext, pMsgWrapper);
         continue;
       }
       /* Check for any Suspend Indication */
@@ -996,6 +1183,7 @@ static void vos_wd_detect_thread_stuck(void)
 		hddLog(LOGE, FL("MC Thread Stuck!!!"));
 
 		vos_dump_stack(gpVosSchedContext->McThread);
+		vos_mq_dump_mc_stats();
 		vos_flush_logs(WLAN_LOG_TYPE_FATAL,
 			       WLAN_LOG_INDICATOR_HOST_ONLY,
 			       WLAN_LOG_REASON_THREAD_STUCK,
@@ -1811,6 +1999,9 @@ void vos_sched_flush_mc_mqs ( pVosSchedContext pSchedContext )
     WLANTL_McFreeMsg(pSchedContext->pVContext, pMsgWrapper->pVosMsg);
     vos_core_return_msg(pSchedContext->pVContext, pMsgWrapper);
   }
+
+  /* High priority lanes were drained along with the regular ones */
+  atomic_set(&pSchedContext->mcHiPrioPending, 0);
 } /* vos_sched_flush_mc_mqs() */
 
 /*-------------------------------------------------------------------------
@@ -113,6 +113,65 @@
 typedef void (*vos_tlshim_cb) (void *context, void *rxpkt, u_int16_t staid);
 #endif
 
+/*
+** Maximum number of messages the MC thread pulls off the PE message queue
+** under a single lock acquisition.
+*/
+#define VOS_MC_MQ_BATCH_SIZE 8
+
+/*
+** Dwell (post to dispatch) time above which the MC thread reports a
+** message as stalled.
+*/
+#define VOS_MC_MQ_DWELL_WARN_US (500 * 1000)
+
+/**
+ * enum vos_mq_latency_bucket - buckets of the message dwell time histogram
+ * @VOS_MQ_LAT_1MS: dispatched within 1 ms of being posted
+ * @VOS_MQ_LAT_5MS: dispatched within 5 ms
+ * @VOS_MQ_LAT_20MS: dispatched within 20 ms
+ * @VOS_MQ_LAT_100MS: dispatched within 100 ms
+ * @VOS_MQ_LAT_500MS: dispatched within 500 ms
+ * @VOS_MQ_LAT_MAX: dispatched after 500 ms or more
+ * @VOS_MQ_LAT_BUCKETS: number of buckets
+ */
+enum vos_mq_latency_bucket {
+	VOS_MQ_LAT_1MS,
+	VOS_MQ_LAT_5MS,
+	VOS_MQ_LAT_20MS,
+	VOS_MQ_LAT_100MS,
+	VOS_MQ_LAT_500MS,
+	VOS_MQ_LAT_MAX,
+	VOS_MQ_LAT_BUCKETS
+};
+
+/**
+ * struct vos_mq_stats - per message queue statistics
+ * @depth: number of messages currently queued
+ * @max_depth: high watermark of @depth
+ * @hi_prio_posted: messages posted on the high priority lane
+ * @dispatched: messages dispatched by the MC thread
+ * @batches: number of batch dequeues
+ * @preempted: batches cut short by a high priority message
+ * @latency_hist: dwell time histogram, see enum vos_mq_latency_bucket
+ * @max_dwell_us: longest dwell time seen
+ * @max_dwell_msg_type: message type that saw @max_dwell_us
+ *
+ * @depth and @max_depth are updated under the queue lock, everything else
+ * is only written from the MC thread.
+ */
+struct vos_mq_stats {
+	uint32_t depth;
+	uint32_t max_depth;
+	uint32_t hi_prio_posted;
+	uint32_t dispatched;
+	uint32_t batches;
+	uint32_t preempted;
+	uint32_t latency_hist[VOS_MQ_LAT_BUCKETS];
+	uint32_t max_dwell_us;
+	uint16_t max_dwell_msg_type;
+};
+
 /*
 ** vOSS Message queue definition.
 */
@@ -124,6 +183,11 @@ typedef struct _VosMqType
   /* List of vOS Messages waiting on this queue */
   struct list_head  mqList;
 
+  /* High priority lane, always drained ahead of mqList */
+  struct list_head  mqHiList;
+
+  struct vos_mq_stats stats;
+
 } VosMqType, *pVosMqType;
 
 #ifdef QCA_CONFIG_SMP
@@ -197,6 +261,9 @@ typedef struct _VosSchedContext
 
    /* lock to make sure that McThread and TxThread Suspend/resume mechanism is in sync*/
    spinlock_t McThreadLock;
+
+   /* Messages queued on the high priority lane of any MC queue */
+   atomic_t mcHiPrioPending;
 #ifdef QCA_CONFIG_SMP
    spinlock_t TlshimRxThreadLock;
 
@@ -304,6 +371,9 @@ typedef struct _VosMsgWrapper
    /* the Vos message it is associated to */
    vos_msg_t    *pVosMsg;
 
+   /* Time the message was posted, used for dwell time accounting */
+   uint64_t     postTimeUs;
+
 } VosMsgWrapper, *pVosMsgWrapper;
 
 /**
@@ -633,7 +703,12 @@ VOS_STATUS vos_mq_init(pVosMqType pMq);
 void vos_mq_deinit(pVosMqType pMq);
 void vos_mq_put(pVosMqType pMq, pVosMsgWrapper pMsgWrapper);
 void vos_mq_put_front(pVosMqType mq, pVosMsgWrapper msg_wrapper);
+void vos_mq_put_hi_prio(pVosMqType mq, pVosMsgWrapper msg_wrapper);
 pVosMsgWrapper vos_mq_get(pVosMqType pMq);
+pVosMsgWrapper vos_mq_get_hi_prio(pVosMqType mq);
+uint32_t vos_mq_get_batch(pVosMqType mq, struct list_head *batch,
+			  uint32_t max_msgs);
+void vos_mq_return_batch(pVosMqType mq, struct list_head *batch);
 v_BOOL_t vos_is_mq_empty(pVosMqType pMq);
 pVosSchedContext get_vos_sched_ctxt(void);
 pVosWatchdogContext get_vos_watchdog_ctxt(void);